@@ -81,12 +81,13 @@ extern "C" {
 // *****************************************************************************
 /* TIME System Service Configuration Options */
 #define SYS_TIME_INDEX_0                            (0)
-#define SYS_TIME_MAX_TIMERS                         (25)
+#define SYS_TIME_MAX_TIMERS                         (48)
 #define SYS_TIME_HW_COUNTER_WIDTH                   (32)
 #define SYS_TIME_HW_COUNTER_PERIOD                  (4294967295U)
 #define SYS_TIME_HW_COUNTER_HALF_PERIOD             (SYS_TIME_HW_COUNTER_PERIOD>>1)
 #define SYS_TIME_CPU_CLOCK_FREQUENCY                (200000000)
 #define SYS_TIME_COMPARE_UPDATE_EXECUTION_CYCLES    (232)
+#define SYS_TIME_WHEEL_TICK_SHIFT                   (9U)
 
 #define SYS_CONSOLE_INDEX_0                       0
 
@@ -131,10 +132,33 @@ extern "C" {
 #define DRV_RF215_TX_COMMAND_EXECUTION_CYCLES 1400U
 
 
+/* PCRC Service Configuration Options */
+/* Comment out to use byte-wise tables (smaller flash footprint, slower) */
+#define SRV_PCRC_SLICING_ENABLE
+
+/* Queue Service Configuration Options */
+/* Priorities below SRV_QUEUE_PRIORITY_LEVELS are appended in constant time */
+#define SRV_QUEUE_PRIORITY_LEVELS             8U
+/* Queues above SRV_QUEUE_INFO_NUMBER have no statistics and are searched */
+#define SRV_QUEUE_INFO_NUMBER                 32U
+
+/* Storage Service Configuration Options */
+/* Delay to group storage changes in a single User Signature write. Changes
+   are only in RAM meanwhile: a power loss or an external reset loses up to
+   this much configuration (resets through the reset handler flush it first).
+   Boot and firmware upgrade information are not delayed. A shorter delay
+   loses less and wears the User Signature more */
+#define SRV_STORAGE_WRITE_DELAY_MS            1000U
+
+/* Firmware Upgrade Service Configuration Options */
+/* Pages written between checkpoints of the upgrade progress */
+#define SRV_FU_CHECKPOINT_PAGES               64U
+
 /* USI Service Common Configuration Options */
 #define SRV_USI_INSTANCES_NUMBER              1U
 #define SRV_USI_USART_CONNECTIONS             1U
 #define SRV_USI_CDC_CONNECTIONS               0U
+#define SRV_USI_USART_DMA_CONNECTIONS         0U
 #define SRV_USI_MSG_POOL_SIZE                 5U
 
 /* PLC PHY Driver Configuration Options */
@@ -162,6 +186,10 @@ extern "C" {
 #define DRV_PLC_PHY_HOST_DESC                 "PIC32CX2051MTG128"
 #define DRV_PLC_PHY_HOST_MODEL                3U
 #define DRV_PLC_PHY_HOST_BAND                 DRV_PLC_PHY_PROFILE
+/* Received frames kept until reported. DRV_PLC_PHY_Tasks stores at most one
+   frame before and one after the data indications, so 2 is the maximum */
+#define DRV_PLC_PHY_RX_RING_SIZE              2U
+#define DRV_PLC_PHY_PIB_QUEUE_SIZE            4U
 
 
 
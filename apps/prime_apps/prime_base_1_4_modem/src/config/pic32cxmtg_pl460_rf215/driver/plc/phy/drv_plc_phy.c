@@ -222,6 +222,9 @@ void DRV_PLC_PHY_ExceptionCallbackRegister(
 
 void DRV_PLC_PHY_Tasks( SYS_MODULE_OBJ object )
 {
+    /* Report transmissions lost in a PLC transceiver restart */
+    DRV_PLC_PHY_ResetTxCfmTask();
+
     if (gDrvPlcPhyObj.status == SYS_STATUS_READY)
     {
         /* Run PLC communication task */
@@ -265,3 +268,13 @@ void DRV_PLC_PHY_EnableTX( const DRV_HANDLE handle, bool enable )
         gDrvPlcPhyObj.plcHal->setTxEnable(enable);
     }
 }
+
+uint32_t DRV_PLC_PHY_RxOverrunCountGet( const DRV_HANDLE handle )
+{
+    if((handle != DRV_HANDLE_INVALID) && (handle == 0U))
+    {
+        return gDrvPlcPhyObj.rxOverrunCount;
+    }
+
+    return 0;
+}
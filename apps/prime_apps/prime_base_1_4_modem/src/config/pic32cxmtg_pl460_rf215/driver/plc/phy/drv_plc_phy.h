@@ -302,6 +302,54 @@ typedef void ( *DRV_PLC_PHY_DATA_IND_CALLBACK )( DRV_PLC_PHY_RECEPTION_OBJ *indO
 
 typedef void ( *DRV_PLC_PHY_EXCEPTION_CALLBACK )( DRV_PLC_PHY_EXCEPTION exception, uintptr_t context );
 
+// *****************************************************************************
+/* PLC Driver PIB Request Event Handler Function Pointer
+
+  Summary:
+    Pointer to a PLC Driver PIB Request Event handler function.
+
+  Description:
+    This data type defines the required function signature for the PLC driver
+    PIB request event handling callback function. The function is passed to
+    DRV_PLC_PHY_PIBGetRequest or DRV_PLC_PHY_PIBSetRequest and it is called
+    from DRV_PLC_PHY_Tasks once all the PIB objects of the request have been
+    processed.
+
+  Parameters:
+    pibObjs - Pointer to the array of PIB objects of the request.
+
+    numPibs - Number of PIB objects in the array.
+
+    result  - True if all the PIB objects were accessed successfully.
+
+    context - Value identifying the context of the application that made the
+              request.
+
+  Returns:
+    None.
+
+  Example:
+    <code>
+    void APP_MyPibEventHandler( DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs,
+                                bool result, uintptr_t context )
+    {
+        MY_APP_DATA_STRUCT* pAppData = (MY_APP_DATA_STRUCT*) context;
+
+        if (result == true)
+        {
+            pAppData->pibReady = true;
+        }
+    }
+    </code>
+
+  Remarks:
+    The PIB objects and the buffers they point to belong to the driver from
+    the request until this function is called.
+
+*/
+
+typedef void ( *DRV_PLC_PHY_PIB_CALLBACK )( DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs, bool result, uintptr_t context );
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: DRV_PLC_PHY Driver System Interface Routines
@@ -535,7 +583,9 @@ void DRV_PLC_PHY_TxRequest(const DRV_HANDLE handle, DRV_PLC_PHY_TRANSMISSION_OBJ
     information base (PIB).
 
   Description:
-    This routine gets PLC data information from the PLC transceiver.
+    This routine gets PLC data information from the PLC transceiver. It
+    blocks until the response is received. See DRV_PLC_PHY_PIBGetRequest
+    for the non-blocking version.
 
   Precondition:
     DRV_PLC_PHY_Open must have been called to obtain a valid opened device
@@ -563,7 +613,9 @@ void DRV_PLC_PHY_TxRequest(const DRV_HANDLE handle, DRV_PLC_PHY_TRANSMISSION_OBJ
     </code>
 
   Remarks:
-    None.
+    The access of a queued request in progress, if any, is finished first.
+    PLC_ID_TIME_REF_ID is read at once instead, so it can be read with
+    interrupts disabled.
 */
 bool DRV_PLC_PHY_PIBGet(const DRV_HANDLE handle, DRV_PLC_PHY_PIB_OBJ *pibObj);
 
@@ -576,7 +628,9 @@ bool DRV_PLC_PHY_PIBGet(const DRV_HANDLE handle, DRV_PLC_PHY_PIB_OBJ *pibObj);
     base (PIB).
 
   Description:
-    This routine sets PLC data information to the PLC transceiver.
+    This routine sets PLC data information to the PLC transceiver. It
+    blocks until the guard time of the PIB has elapsed. See
+    DRV_PLC_PHY_PIBSetRequest for the non-blocking version.
 
   Precondition:
     DRV_PLC_PHY_Open must have been called to obtain a valid opened device
@@ -617,6 +671,127 @@ bool DRV_PLC_PHY_PIBGet(const DRV_HANDLE handle, DRV_PLC_PHY_PIB_OBJ *pibObj);
 */
 bool DRV_PLC_PHY_PIBSet(const DRV_HANDLE handle, DRV_PLC_PHY_PIB_OBJ *pibObj);
 
+// *****************************************************************************
+/* Function:
+    bool DRV_PLC_PHY_PIBGetRequest( const DRV_HANDLE handle,
+        DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs,
+        const DRV_PLC_PHY_PIB_CALLBACK callback, uintptr_t context )
+
+  Summary:
+    Queues a request to get several PIBs from PLC transceiver, without
+    blocking.
+
+  Description:
+    This routine queues the request and returns immediately. The PIB objects
+    are read from DRV_PLC_PHY_Tasks, without waiting for the responses of the
+    PLC transceiver, and the callback is called when all of them have been
+    read. PIBs of ADC, DAC or fuses areas placed consecutively in memory,
+    and also consecutive in the array, are read in a single SPI access. PHY
+    parameters take one SPI access each.
+
+  Precondition:
+    DRV_PLC_PHY_Open must have been called to obtain a valid opened device
+    handle.
+    DRV_PLC_PHY_PIB_OBJ array must be configured before the request.
+
+  Parameters:
+    handle   - A valid open-instance handle, returned from the driver's open
+               routine.
+    pibObjs  - Pointer to the array of PIB objects to get. It must remain
+               valid until the callback is called.
+    numPibs  - Number of PIB objects in the array.
+    callback - Pointer to the function to be called when the request is done.
+    context  - The value of this parameter will be passed back to the client
+               in the callback.
+
+  Returns:
+    True if the request has been queued. False if the handle or the
+    parameters are not valid or if the request queue is full.
+
+  Example:
+    <code>
+    DRV_PLC_PHY_PIB_OBJ pibObjs[2];
+    uint16_t rxPaySymbols;
+    uint16_t txPaySymbols;
+
+    pibObjs[0].pData = (uint8_t *)&rxPaySymbols;
+    pibObjs[0].length = 2;
+    pibObjs[0].id = PLC_ID_RX_PAY_SYMBOLS;
+    pibObjs[1].pData = (uint8_t *)&txPaySymbols;
+    pibObjs[1].length = 2;
+    pibObjs[1].id = PLC_ID_TX_PAY_SYMBOLS;
+
+    DRV_PLC_PHY_PIBGetRequest(handle, pibObjs, 2, APP_MyPibEventHandler, 0);
+    </code>
+
+  Remarks:
+    Requests are processed in order, DRV_PLC_PHY_PIB_QUEUE_SIZE requests can
+    be queued at the same time. Requests still queued when the PLC
+    transceiver is restarted are completed with error.
+*/
+bool DRV_PLC_PHY_PIBGetRequest(const DRV_HANDLE handle, DRV_PLC_PHY_PIB_OBJ *pibObjs,
+    uint8_t numPibs, const DRV_PLC_PHY_PIB_CALLBACK callback, uintptr_t context);
+
+// *****************************************************************************
+/* Function:
+    bool DRV_PLC_PHY_PIBSetRequest( const DRV_HANDLE handle,
+        DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs,
+        const DRV_PLC_PHY_PIB_CALLBACK callback, uintptr_t context )
+
+  Summary:
+    Queues a request to set several PIBs to PLC transceiver, without
+    blocking.
+
+  Description:
+    This routine queues the request and returns immediately. The PIB objects
+    are written from DRV_PLC_PHY_Tasks, one SPI access each, waiting the
+    guard time required by every PIB without blocking. The callback is called
+    when all of them have been written.
+
+  Precondition:
+    DRV_PLC_PHY_Open must have been called to obtain a valid opened device
+    handle.
+    DRV_PLC_PHY_PIB_OBJ array must be configured before the request.
+
+  Parameters:
+    handle   - A valid open-instance handle, returned from the driver's open
+               routine.
+    pibObjs  - Pointer to the array of PIB objects to set. It must remain
+               valid until the callback is called.
+    numPibs  - Number of PIB objects in the array.
+    callback - Pointer to the function to be called when the request is done.
+    context  - The value of this parameter will be passed back to the client
+               in the callback.
+
+  Returns:
+    True if the request has been queued. False if the handle or the
+    parameters are not valid or if the request queue is full.
+
+  Example:
+    <code>
+    DRV_PLC_PHY_PIB_OBJ pibObjs[2];
+    uint8_t autoMode = 0;
+    uint8_t impedance = VLO_STATE;
+
+    pibObjs[0].pData = &autoMode;
+    pibObjs[0].length = 1;
+    pibObjs[0].id = PLC_ID_CFG_AUTODETECT_IMPEDANCE;
+    pibObjs[1].pData = &impedance;
+    pibObjs[1].length = 1;
+    pibObjs[1].id = PLC_ID_CFG_IMPEDANCE;
+
+    DRV_PLC_PHY_PIBSetRequest(handle, pibObjs, 2, APP_MyPibEventHandler, 0);
+    </code>
+
+  Remarks:
+    A transmission requested while a PIB write guard time is running is
+    kept by the driver and sent from DRV_PLC_PHY_Tasks when it expires,
+    before the next PIB of the queue. Only one transmission is kept: a
+    second one waits for the guard time.
+*/
+bool DRV_PLC_PHY_PIBSetRequest(const DRV_HANDLE handle, DRV_PLC_PHY_PIB_OBJ *pibObjs,
+    uint8_t numPibs, const DRV_PLC_PHY_PIB_CALLBACK callback, uintptr_t context);
+
 // *****************************************************************************
 /* Function:
     void DRV_PLC_PHY_TxCfmCallbackRegister(
@@ -832,6 +1007,8 @@ void DRV_PLC_PHY_ExceptionCallbackRegister(
 
   Remarks:
     See plib_pio.h for more details.
+    The handler only signals the event. The PLC transceiver is read through
+    SPI from DRV_PLC_PHY_Tasks.
 
   Example:
     <code>
@@ -971,6 +1148,53 @@ void DRV_PLC_PHY_Tasks( SYS_MODULE_OBJ object );
 
 void DRV_PLC_PHY_EnableTX( const DRV_HANDLE handle, bool enable );
 
+/***************************************************************************
+  Function:
+    uint32_t DRV_PLC_PHY_RxOverrunCountGet( const DRV_HANDLE handle )
+
+  Summary:
+    Gets the number of received frames discarded by the driver.
+
+  Description:
+    Received frames are read from the PLC transceiver in DRV_PLC_PHY_Tasks
+    and kept in a ring of DRV_PLC_PHY_RX_RING_SIZE frames until they are
+    reported through the data indication callback. This function returns
+    how many frames have been discarded, either because the ring was full
+    or because data and parameters of a frame were not read together
+    (the PLC transceiver only keeps the last received frame).
+
+    The ring is filled from DRV_PLC_PHY_Tasks only, which reads at most one
+    frame before and one after notifying the upper layers, so a ring of 2
+    frames is enough and larger values are rejected at build time. Frames
+    overwritten in the PLC transceiver are not seen by the driver: no frame
+    is lost as long as DRV_PLC_PHY_Tasks is called
+    again, including the time spent in the data indication callbacks, within
+    the air time of the shortest frame (8.8 ms for one symbol in DBPSK_C
+    type A). Longer stalls of the application loop lose frames.
+
+  Precondition:
+    DRV_PLC_PHY_Open must have been called to obtain a valid opened device
+    handle.
+
+  Parameters:
+    handle - A valid open-instance handle, returned from the driver's open
+             routine.
+
+  Returns:
+    Number of discarded frames since the PLC transceiver was started.
+
+  Example:
+    <code>
+    DRV_HANDLE handle;
+    uint32_t rxOverrun;
+
+    rxOverrun = DRV_PLC_PHY_RxOverrunCountGet(handle);
+    </code>
+
+  ***************************************************************************/
+
+uint32_t DRV_PLC_PHY_RxOverrunCountGet( const DRV_HANDLE handle );
+
 #ifdef __cplusplus
 }
 #endif
@@ -48,6 +48,7 @@ Microchip or any third party.
 #include <string.h>
 #include "configuration.h"
 #include "system/system.h"
+#include "system/time/sys_time.h"
 #include "driver/plc/phy/drv_plc_phy.h"
 #include "driver/plc/common/drv_plc_hal.h"
 #include "driver/plc/common/drv_plc_boot.h"
@@ -59,14 +60,21 @@ Microchip or any third party.
 // *****************************************************************************
 // *****************************************************************************
 
+/* Frames are only stored from DRV_PLC_PHY_Tasks, one before and one after
+ * the data indications: more slots would never be used */
+#if (DRV_PLC_PHY_RX_RING_SIZE < 1U) || (DRV_PLC_PHY_RX_RING_SIZE > 2U)
+#error "DRV_PLC_PHY_RX_RING_SIZE must be 1 or 2"
+#endif
+
 /* This is the driver instance object array. */
 static DRV_PLC_PHY_OBJ *gPlcPhyObj;
 
 /* Buffer definition to communicate with PLC */
 static CACHE_ALIGN uint8_t sDataInfo[CACHE_ALIGNED_SIZE_GET(PLC_STATUS_LENGTH)];
 static CACHE_ALIGN uint8_t sDataTx[CACHE_ALIGNED_SIZE_GET((PLC_TX_PAR_SIZE + PLC_DATA_PKT_SIZE))];
-static CACHE_ALIGN uint8_t sDataRxPar[CACHE_ALIGNED_SIZE_GET(PLC_RX_PAR_SIZE)];
-static CACHE_ALIGN uint8_t sDataRxDat[CACHE_ALIGNED_SIZE_GET(PLC_DATA_PKT_SIZE)];
+static CACHE_ALIGN uint8_t sDataRxPar[DRV_PLC_PHY_RX_RING_SIZE][CACHE_ALIGNED_SIZE_GET(PLC_RX_PAR_SIZE)];
+static CACHE_ALIGN uint8_t sDataRxDat[DRV_PLC_PHY_RX_RING_SIZE][CACHE_ALIGNED_SIZE_GET(PLC_DATA_PKT_SIZE)];
+static uint16_t sDataRxLength[DRV_PLC_PHY_RX_RING_SIZE];
 static CACHE_ALIGN uint8_t sDataTxCfm[2][CACHE_ALIGNED_SIZE_GET(PLC_CMF_PKT_SIZE)];
 static CACHE_ALIGN uint8_t sDataReg[CACHE_ALIGNED_SIZE_GET(PLC_REG_PKT_SIZE)];
 
@@ -196,11 +204,11 @@ static void lDRV_PLC_PHY_COMM_TxCfmEvent(DRV_PLC_PHY_TRANSMISSION_CFM_OBJ *pCfmO
     pCfmObj->bufferId = (DRV_PLC_PHY_BUFFER_ID)*pSrc;
 }
 
-static void lDRV_PLC_PHY_COMM_RxEvent(DRV_PLC_PHY_RECEPTION_OBJ *pRxObj)
+static void lDRV_PLC_PHY_COMM_RxEvent(DRV_PLC_PHY_RECEPTION_OBJ *pRxObj, uint8_t idx)
 {
     uint8_t *pSrc;
 
-    pSrc = sDataRxPar;
+    pSrc = sDataRxPar[idx];
 
     /* Parse parameters of reception event */
     pRxObj->evmHeaderAcum = (uint32_t)*pSrc++;
@@ -238,7 +246,7 @@ static void lDRV_PLC_PHY_COMM_RxEvent(DRV_PLC_PHY_RECEPTION_OBJ *pRxObj)
     }
 
     /* Set data content pointer */
-    pRxObj->pReceivedData = sDataRxDat;
+    pRxObj->pReceivedData = sDataRxDat[idx];
 }
 
 static bool lDRV_PLC_PHY_COMM_CheckComm(DRV_PLC_HAL_INFO *info)
@@ -304,10 +312,12 @@ static bool lDRV_PLC_PHY_COMM_CheckComm(DRV_PLC_HAL_INFO *info)
         }
 
         /* Check if there is any tx_cfm pending to be reported */
-        if ((gPlcPhyObj->state[0] == DRV_PLC_PHY_STATE_WAITING_TX_CFM) ||
-                (gPlcPhyObj->state[1] == DRV_PLC_PHY_STATE_WAITING_TX_CFM))
+        for (uint8_t idx = 0; idx < NUM_TX_BUFFERS; idx++)
         {
-            gPlcPhyObj->evResetTxCfm = true;
+            if (gPlcPhyObj->state[idx] == DRV_PLC_PHY_STATE_WAITING_TX_CFM)
+            {
+                gPlcPhyObj->evResetTxCfm[idx] = true;
+            }
         }
     }
 
@@ -402,6 +412,537 @@ static void lDRV_PLC_PHY_COMM_GetEventsInfo(DRV_PLC_PHY_EVENTS_OBJ *eventsObj)
     eventsObj->regRspLength += ((uint16_t)*pData++) << 8;
 }
 
+static uint8_t lDRV_PLC_PHY_COMM_RxRingFreeSlot(void)
+{
+    uint32_t idx;
+
+    idx = (uint32_t)gPlcPhyObj->rxRingFirst + gPlcPhyObj->rxRingNum;
+    if (idx >= DRV_PLC_PHY_RX_RING_SIZE)
+    {
+        idx -= DRV_PLC_PHY_RX_RING_SIZE;
+    }
+
+    return (uint8_t)idx;
+}
+
+static bool lDRV_PLC_PHY_COMM_RxParMatch(uint8_t idx)
+{
+    uint8_t *pSrc;
+    uint16_t dataLength;
+
+    /* Data length of the parameters must match the data read before, as
+       both are stored in the PLC device for the last frame only */
+    pSrc = &sDataRxPar[idx][PLC_RX_PAR_DATA_LEN_OFFSET];
+    dataLength = (uint16_t)*pSrc++;
+    dataLength += (uint16_t)*pSrc << 8;
+
+    return (dataLength == sDataRxLength[idx]);
+}
+
+static void lDRV_PLC_PHY_COMM_ServiceEvents(void)
+{
+    DRV_PLC_PHY_EVENTS_OBJ evObj;
+    uint8_t rxIdx;
+
+    if (gPlcPhyObj->evPending == false)
+    {
+        return;
+    }
+
+    /* Clear before reading events, so a new interrupt is not missed */
+    gPlcPhyObj->evPending = false;
+
+    /* Time guard */
+    gPlcPhyObj->plcHal->delay(20);
+
+    /* Get PLC events information */
+    lDRV_PLC_PHY_COMM_GetEventsInfo(&evObj);
+
+    /* Check confirmation of the transmission event */
+    if (evObj.evCfm[0])
+    {
+        lDRV_PLC_PHY_COMM_SpiReadCmd(TX0_CFM_ID, sDataTxCfm[0], (uint16_t)PLC_CMF_PKT_SIZE);
+        /* update event flag */
+        gPlcPhyObj->evTxCfm[0] = true;
+        /* Update PLC state: idle */
+        gPlcPhyObj->state[0] = DRV_PLC_PHY_STATE_IDLE;
+    }
+
+    if (evObj.evCfm[1])
+    {
+        lDRV_PLC_PHY_COMM_SpiReadCmd(TX1_CFM_ID, sDataTxCfm[1], PLC_CMF_PKT_SIZE);
+        /* update event flag */
+        gPlcPhyObj->evTxCfm[1] = true;
+        /* Update PLC state: idle */
+        gPlcPhyObj->state[1] = DRV_PLC_PHY_STATE_IDLE;
+    }
+
+    /* Received frames are stored in the first free slot of the ring */
+    rxIdx = lDRV_PLC_PHY_COMM_RxRingFreeSlot();
+
+    /* Parameters of a frame whose data was read in a previous call. Handled
+       first, as the data of a new frame may have been signaled afterwards */
+    if (evObj.evRxPar && gPlcPhyObj->evRxDat)
+    {
+        lDRV_PLC_PHY_COMM_SpiReadCmd(RX_PAR_ID, sDataRxPar[rxIdx], (uint16_t)PLC_RX_PAR_SIZE - 4U);
+        gPlcPhyObj->evRxDat = false;
+        if (lDRV_PLC_PHY_COMM_RxParMatch(rxIdx))
+        {
+            /* Frame complete: queue it to be reported */
+            gPlcPhyObj->rxRingNum++;
+            evObj.evRxPar = false;
+            rxIdx = lDRV_PLC_PHY_COMM_RxRingFreeSlot();
+        }
+        else
+        {
+            /* Parameters of a later frame: previous data is lost */
+            gPlcPhyObj->rxOverrunCount++;
+        }
+    }
+
+    /* Check received new data event (First event in RX) */
+    if (evObj.evRxDat)
+    {
+        if (gPlcPhyObj->evRxDat)
+        {
+            /* Parameters of previous data were not received: overwrite it */
+            gPlcPhyObj->rxOverrunCount++;
+            gPlcPhyObj->evRxDat = false;
+        }
+
+        if (gPlcPhyObj->rxRingNum >= DRV_PLC_PHY_RX_RING_SIZE)
+        {
+            /* No room: discard the whole frame */
+            gPlcPhyObj->rxOverrunCount++;
+            gPlcPhyObj->rxDropping = true;
+        }
+        else
+        {
+            lDRV_PLC_PHY_COMM_SpiReadCmd(RX_DAT_ID, sDataRxDat[rxIdx], evObj.rcvDataLength);
+            sDataRxLength[rxIdx] = evObj.rcvDataLength;
+            /* update event flag */
+            gPlcPhyObj->evRxDat = true;
+            gPlcPhyObj->rxDropping = false;
+        }
+    }
+
+    /* Check received new parameters event (Second event in RX) */
+    if (evObj.evRxPar)
+    {
+        if (gPlcPhyObj->evRxDat)
+        {
+            lDRV_PLC_PHY_COMM_SpiReadCmd(RX_PAR_ID, sDataRxPar[rxIdx], (uint16_t)PLC_RX_PAR_SIZE - 4U);
+            if (lDRV_PLC_PHY_COMM_RxParMatch(rxIdx))
+            {
+                /* Frame complete: queue it to be reported */
+                gPlcPhyObj->evRxDat = false;
+                gPlcPhyObj->rxRingNum++;
+            }
+            else
+            {
+                /* Parameters of an earlier frame, whose data is lost. Wait
+                   for the parameters of the data just read */
+                gPlcPhyObj->rxOverrunCount++;
+            }
+        }
+        else
+        {
+            /* Parameters without data: frame already counted if discarded */
+            if (gPlcPhyObj->rxDropping == false)
+            {
+                gPlcPhyObj->rxOverrunCount++;
+            }
+
+            gPlcPhyObj->rxDropping = false;
+        }
+    }
+
+    /* Check register info event */
+    if (evObj.evReg)
+    {
+        lDRV_PLC_PHY_COMM_SpiReadCmd(REG_INFO_ID, sDataReg, evObj.regRspLength);
+        /* update event flag */
+        gPlcPhyObj->evRegRspLength = evObj.regRspLength;
+    }
+
+    /* Time guard */
+    gPlcPhyObj->plcHal->delay(20);
+}
+
+static bool lDRV_PLC_PHY_COMM_GetHostInfo(DRV_PLC_PHY_PIB_OBJ *pibObj)
+{
+    uint32_t value;
+    bool result = true;
+
+    /* Get HOST information */
+    switch(pibObj->id)
+    {
+        case PLC_ID_HOST_DESCRIPTION_ID:
+        {
+            const char *hostDesc = DRV_PLC_PHY_HOST_DESC;
+            (void) memcpy((void *)pibObj->pData, (const void *)hostDesc, strlen(DRV_PLC_PHY_HOST_DESC));
+            break;
+        }
+
+        case PLC_ID_HOST_MODEL_ID:
+            value = DRV_PLC_PHY_HOST_MODEL;
+            pibObj->pData[0] = (uint8_t)value;
+            pibObj->pData[1] = (uint8_t)(value >> 8);
+            break;
+
+        case PLC_ID_HOST_PHY_ID:
+            value = DRV_PLC_PHY_HOST_PHY;
+            pibObj->pData[0] = (uint8_t)value;
+            pibObj->pData[1] = (uint8_t)(value >> 8);
+            pibObj->pData[2] = (uint8_t)(value >> 16);
+            pibObj->pData[3] = (uint8_t)(value >> 24);
+            break;
+
+        case PLC_ID_HOST_PRODUCT_ID:
+            value = DRV_PLC_PHY_HOST_PRODUCT;
+            pibObj->pData[0] = (uint8_t)value;
+            pibObj->pData[1] = (uint8_t)(value >> 8);
+            break;
+
+        case PLC_ID_HOST_VERSION_ID:
+            value = DRV_PLC_PHY_HOST_VERSION;
+            pibObj->pData[0] = (uint8_t)value;
+            pibObj->pData[1] = (uint8_t)(value >> 8);
+            pibObj->pData[2] = (uint8_t)(value >> 16);
+            pibObj->pData[3] = (uint8_t)(value >> 24);
+            break;
+
+        case PLC_ID_HOST_BAND_ID:
+            value = DRV_PLC_PHY_HOST_BAND;
+            pibObj->pData[0] = (uint8_t)value;
+            break;
+
+        default:
+            result = false;
+            break;
+    }
+
+    return result;
+}
+
+static void lDRV_PLC_PHY_COMM_TxSend(uint8_t bufIdx, uint16_t size)
+{
+    /* Send TX message */
+    if (bufIdx == (uint8_t)(TX_BUFFER_0))
+    {
+        lDRV_PLC_PHY_COMM_SpiWriteCmd(TX0_PAR_ID, sDataTx, size);
+    }
+    else
+    {
+        lDRV_PLC_PHY_COMM_SpiWriteCmd(TX1_PAR_ID, sDataTx, size);
+    }
+
+    /* Time guard */
+    gPlcPhyObj->plcHal->delay(20);
+}
+
+static void lDRV_PLC_PHY_COMM_PibEnd(bool result)
+{
+    gPlcPhyObj->pibState = DRV_PLC_PHY_PIB_STATE_IDLE;
+    gPlcPhyObj->pibResult = result;
+
+    if (gPlcPhyObj->pibQueued)
+    {
+        /* Update progress of the first request of the queue */
+        gPlcPhyObj->pibQueueIdx += gPlcPhyObj->pibNum;
+        if (result == false)
+        {
+            gPlcPhyObj->pibQueueResult = false;
+        }
+    }
+}
+
+static void lDRV_PLC_PHY_COMM_PibStartGet(DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs)
+{
+    DRV_PLC_PHY_PIB_OBJ *pibObj = pibObjs;
+    uint8_t *pDst;
+    uint32_t address;
+    uint16_t length;
+    uint16_t cmdLength;
+
+    if (pibObj->id == PLC_ID_TIME_REF_ID)
+    {
+        /* Send PIB information request */
+        lDRV_PLC_PHY_COMM_SpiReadCmd(STATUS_ID, pibObj->pData, pibObj->length);
+        lDRV_PLC_PHY_COMM_PibEnd(true);
+        return;
+    }
+
+    if (((uint16_t)pibObj->id & DRV_PLC_PHY_REG_ID_MASK) == 0U)
+    {
+        /* Get HOST information */
+        lDRV_PLC_PHY_COMM_PibEnd(lDRV_PLC_PHY_COMM_GetHostInfo(pibObj));
+        return;
+    }
+
+    /* Get address offset */
+    address = lDRV_PLC_PHY_COMM_GetPibBaseAddress(pibObj->id);
+    if (address == 0U)
+    {
+        lDRV_PLC_PHY_COMM_PibEnd(false);
+        return;
+    }
+    address += (uint16_t)pibObj->id & DRV_PLC_PHY_REG_OFFSET_MASK;
+
+    /* Merge following PIBs placed just after this one in a single access.
+       Only for register areas: PHY parameters are resolved one by one */
+    length = pibObj->length;
+    while ((gPlcPhyObj->pibNum < numPibs) && (((uint16_t)pibObj->id & DRV_PLC_PHY_REG_MASK) == 0U))
+    {
+        DRV_PLC_PHY_PIB_OBJ *pibNext = &pibObjs[gPlcPhyObj->pibNum];
+        uint32_t addressNext;
+
+        if ((((uint16_t)pibNext->id & DRV_PLC_PHY_REG_ID_MASK) == 0U) ||
+                (((uint16_t)pibNext->id & DRV_PLC_PHY_REG_MASK) != 0U))
+        {
+            break;
+        }
+
+        addressNext = lDRV_PLC_PHY_COMM_GetPibBaseAddress(pibNext->id);
+        addressNext += (uint16_t)pibNext->id & DRV_PLC_PHY_REG_OFFSET_MASK;
+        if ((addressNext != (address + length)) ||
+                (((uint32_t)length + pibNext->length) > DRV_PLC_PHY_REG_LEN_MASK))
+        {
+            break;
+        }
+
+        length += pibNext->length;
+        gPlcPhyObj->pibNum++;
+    }
+
+    /* Set CMD and length */
+    cmdLength = (uint16_t)DRV_PLC_PHY_CMD_READ | (length & DRV_PLC_PHY_REG_LEN_MASK);
+
+    /* Build command */
+    pDst = sDataReg;
+
+    *pDst++ = (uint8_t)(address >> 24);
+    *pDst++ = (uint8_t)(address >> 16);
+    *pDst++ = (uint8_t)(address >> 8);
+    *pDst++ = (uint8_t)(address);
+    *pDst++ = (uint8_t)(cmdLength >> 8);
+    *pDst++ = (uint8_t)(cmdLength);
+
+    /* Send PIB information request */
+    gPlcPhyObj->evRegRspLength = 0;
+    lDRV_PLC_PHY_COMM_SpiWriteCmd(REG_INFO_ID, sDataReg, 8U);
+
+    /* The response is read when servicing PLC events */
+    gPlcPhyObj->pibState = DRV_PLC_PHY_PIB_STATE_WAITING_RSP;
+    gPlcPhyObj->pibTimeRef = SYS_TIME_CounterGet();
+    gPlcPhyObj->pibTimeCount = SYS_TIME_USToCount(PLC_REG_RSP_TIMEOUT_US);
+}
+
+static void lDRV_PLC_PHY_COMM_PibStartSet(DRV_PLC_PHY_PIB_OBJ *pibObj)
+{
+    uint8_t *pDst;
+    uint8_t *pSrc;
+    uint32_t address;
+    uint16_t offset;
+    uint16_t cmdLength;
+
+    if (((uint16_t)pibObj->id & DRV_PLC_PHY_REG_ID_MASK) == 0U)
+    {
+        lDRV_PLC_PHY_COMM_PibEnd(false);
+        return;
+    }
+
+    offset = (uint16_t)pibObj->id & DRV_PLC_PHY_REG_OFFSET_MASK;
+
+    /* Get base address */
+    address = lDRV_PLC_PHY_COMM_GetPibBaseAddress(pibObj->id);
+    if (address == 0U)
+    {
+        lDRV_PLC_PHY_COMM_PibEnd(false);
+        return;
+    }
+    address += offset;
+
+    /* Set CMD and length */
+    cmdLength = (uint16_t)DRV_PLC_PHY_CMD_WRITE | (pibObj->length & DRV_PLC_PHY_REG_LEN_MASK);
+
+    /* Build command */
+    pDst = sDataReg;
+
+    *pDst++ = (uint8_t)(address >> 24);
+    *pDst++ = (uint8_t)(address >> 16);
+    *pDst++ = (uint8_t)(address >> 8);
+    *pDst++ = (uint8_t)(address);
+    *pDst++ = (uint8_t)(cmdLength >> 8);
+    *pDst++ = (uint8_t)(cmdLength);
+
+    pSrc = pibObj->pData;
+    if (pibObj->length == 4U)
+    {
+        *pDst++ = *pSrc++;
+        *pDst++ = *pSrc++;
+        *pDst++ = *pSrc++;
+        *pDst++ = *pSrc++;
+    }
+    else if (pibObj->length == 2U)
+    {
+        *pDst++ = *pSrc++;
+        *pDst++ = *pSrc++;
+    }
+    else
+    {
+        (void) memcpy(pDst, pSrc, pibObj->length);
+    }
+
+    /* Send PIB information request */
+    lDRV_PLC_PHY_COMM_SpiWriteCmd(REG_INFO_ID, sDataReg, 6U + pibObj->length);
+
+    /* Guard time to ensure writing operation completion */
+    gPlcPhyObj->pibState = DRV_PLC_PHY_PIB_STATE_WAITING_GUARD;
+    gPlcPhyObj->pibResult = true;
+    gPlcPhyObj->pibTimeRef = SYS_TIME_CounterGet();
+    gPlcPhyObj->pibTimeCount = SYS_TIME_USToCount(lDRV_PLC_PHY_COMM_GetDelayUs(pibObj->id));
+}
+
+static void lDRV_PLC_PHY_COMM_PibStart(DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs,
+    bool set, bool queued)
+{
+    gPlcPhyObj->pibObjs = pibObjs;
+    gPlcPhyObj->pibNum = 1;
+    gPlcPhyObj->pibQueued = queued;
+
+    if (set)
+    {
+        lDRV_PLC_PHY_COMM_PibStartSet(pibObjs);
+    }
+    else
+    {
+        lDRV_PLC_PHY_COMM_PibStartGet(pibObjs, numPibs);
+    }
+}
+
+static void lDRV_PLC_PHY_COMM_PibPoll(void)
+{
+    uint32_t elapsed;
+
+    if (gPlcPhyObj->pibState == DRV_PLC_PHY_PIB_STATE_IDLE)
+    {
+        return;
+    }
+
+    lDRV_PLC_PHY_COMM_ServiceEvents();
+
+    elapsed = SYS_TIME_CounterGet() - gPlcPhyObj->pibTimeRef;
+
+    if (gPlcPhyObj->pibState == DRV_PLC_PHY_PIB_STATE_WAITING_RSP)
+    {
+        if (gPlcPhyObj->evRegRspLength != 0U)
+        {
+            uint8_t *pSrc = sDataReg;
+
+            /* copy Register info in data pointers */
+            for (uint8_t idx = 0; idx < gPlcPhyObj->pibNum; idx++)
+            {
+                DRV_PLC_PHY_PIB_OBJ *pibObj = &gPlcPhyObj->pibObjs[idx];
+
+                (void) memcpy(pibObj->pData, pSrc, pibObj->length);
+                pSrc += pibObj->length;
+            }
+
+            /* Reset length of the register response */
+            gPlcPhyObj->evRegRspLength = 0;
+            lDRV_PLC_PHY_COMM_PibEnd(true);
+        }
+        else if (elapsed > gPlcPhyObj->pibTimeCount)
+        {
+            /* Didn't came the expected response */
+            lDRV_PLC_PHY_COMM_PibEnd(false);
+        }
+        else
+        {
+            /* Keep waiting */
+        }
+    }
+    else if (elapsed >= gPlcPhyObj->pibTimeCount)
+    {
+        /* Guard time elapsed */
+        lDRV_PLC_PHY_COMM_PibEnd(true);
+
+        if (gPlcPhyObj->txDeferred)
+        {
+            /* Transmission requested during the guard time, sent before
+             * the next PIB access */
+            gPlcPhyObj->txDeferred = false;
+            lDRV_PLC_PHY_COMM_TxSend(gPlcPhyObj->txDeferredIdx, gPlcPhyObj->txDeferredSize);
+        }
+    }
+    else
+    {
+        /* Keep waiting */
+    }
+}
+
+static void lDRV_PLC_PHY_COMM_PibWait(void)
+{
+    while (gPlcPhyObj->pibState != DRV_PLC_PHY_PIB_STATE_IDLE)
+    {
+        lDRV_PLC_PHY_COMM_PibPoll();
+    }
+}
+
+static bool lDRV_PLC_PHY_COMM_PibAccess(DRV_PLC_PHY_PIB_OBJ *pibObj, bool set)
+{
+    if ((set == false) && (pibObj->id == PLC_ID_TIME_REF_ID))
+    {
+        /* Time reference is read from the status, without waiting for the
+         * access in progress: it is read with interrupts masked to sync
+         * timers, so the response of a queued access would never come */
+        lDRV_PLC_PHY_COMM_SpiReadCmd(STATUS_ID, pibObj->pData, pibObj->length);
+        return true;
+    }
+
+    /* Finish the access in progress, if any */
+    lDRV_PLC_PHY_COMM_PibWait();
+
+    lDRV_PLC_PHY_COMM_PibStart(pibObj, 1, set, false);
+    lDRV_PLC_PHY_COMM_PibWait();
+
+    return gPlcPhyObj->pibResult;
+}
+
+static void lDRV_PLC_PHY_COMM_PibTask(void)
+{
+    lDRV_PLC_PHY_COMM_PibPoll();
+
+    while ((gPlcPhyObj->pibState == DRV_PLC_PHY_PIB_STATE_IDLE) &&
+            (gPlcPhyObj->pibQueueNum > 0U))
+    {
+        DRV_PLC_PHY_PIB_REQUEST request = gPlcPhyObj->pibQueue[gPlcPhyObj->pibQueueFirst];
+        bool result;
+
+        if (gPlcPhyObj->pibQueueIdx < request.numPibs)
+        {
+            /* Start access to next PIB object(s) of the request */
+            lDRV_PLC_PHY_COMM_PibStart(&request.pibObjs[gPlcPhyObj->pibQueueIdx],
+                    request.numPibs - gPlcPhyObj->pibQueueIdx, request.set, true);
+            continue;
+        }
+
+        /* Request done: release it before reporting, so it can be reused */
+        result = gPlcPhyObj->pibQueueResult;
+        gPlcPhyObj->pibQueueIdx = 0;
+        gPlcPhyObj->pibQueueResult = true;
+        if (++gPlcPhyObj->pibQueueFirst == DRV_PLC_PHY_PIB_QUEUE_SIZE)
+        {
+            gPlcPhyObj->pibQueueFirst = 0;
+        }
+
+        gPlcPhyObj->pibQueueNum--;
+
+        request.callback(request.pibObjs, request.numPibs, result, request.context);
+    }
+}
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: DRV_PLC_PHY Common Interface Implementation
@@ -409,6 +950,8 @@ static void lDRV_PLC_PHY_COMM_GetEventsInfo(DRV_PLC_PHY_EVENTS_OBJ *eventsObj)
 // *****************************************************************************
 void DRV_PLC_PHY_Init(DRV_PLC_PHY_OBJ *plcPhyObj)
 {
+    uint8_t pibQueueNum;
+
     gPlcPhyObj = plcPhyObj;
 
     /* Clear information about PLC events */
@@ -417,7 +960,38 @@ void DRV_PLC_PHY_Init(DRV_PLC_PHY_OBJ *plcPhyObj)
     gPlcPhyObj->evRxPar = false;
     gPlcPhyObj->evRxDat = false;
     gPlcPhyObj->evRegRspLength = 0;
-    gPlcPhyObj->evResetTxCfm = false;
+    gPlcPhyObj->evResetTxCfm[0] = false;
+    gPlcPhyObj->evResetTxCfm[1] = false;
+    gPlcPhyObj->evPending = false;
+
+    /* Clear reception ring */
+    gPlcPhyObj->rxRingFirst = 0;
+    gPlcPhyObj->rxRingNum = 0;
+    gPlcPhyObj->rxDropping = false;
+    gPlcPhyObj->rxOverrunCount = 0;
+
+    /* Clear PIB requests. Requests queued before the PLC transceiver was
+     * restarted are completed with error (new requests from the callbacks
+     * are kept) */
+    gPlcPhyObj->pibState = DRV_PLC_PHY_PIB_STATE_IDLE;
+    gPlcPhyObj->pibQueueIdx = 0;
+    gPlcPhyObj->pibQueueResult = true;
+    gPlcPhyObj->txDeferred = false;
+    pibQueueNum = gPlcPhyObj->pibQueueNum;
+    while (pibQueueNum > 0U)
+    {
+        DRV_PLC_PHY_PIB_REQUEST request = gPlcPhyObj->pibQueue[gPlcPhyObj->pibQueueFirst];
+
+        if (++gPlcPhyObj->pibQueueFirst == DRV_PLC_PHY_PIB_QUEUE_SIZE)
+        {
+            gPlcPhyObj->pibQueueFirst = 0;
+        }
+
+        gPlcPhyObj->pibQueueNum--;
+        pibQueueNum--;
+
+        request.callback(request.pibObjs, request.numPibs, false, request.context);
+    }
 
     /* Enable external interrupt from PLC */
     gPlcPhyObj->plcHal->enableExtInt(true);
@@ -425,52 +999,73 @@ void DRV_PLC_PHY_Init(DRV_PLC_PHY_OBJ *plcPhyObj)
 
 void DRV_PLC_PHY_Task(void)
 {
+    DRV_PLC_PHY_TRANSMISSION_CFM_OBJ cfmObj[NUM_TX_BUFFERS];
+    bool cfmReport[NUM_TX_BUFFERS];
+    uint8_t cfmFirst;
+
+    /* Read PLC events signaled by the external interrupt */
+    lDRV_PLC_PHY_COMM_ServiceEvents();
+
     /* Check event flags */
-    for (uint8_t idx = 0; idx < 2U; idx++)
+    for (uint8_t idx = 0; idx < NUM_TX_BUFFERS; idx++)
     {
-        if ((gPlcPhyObj->evTxCfm[idx]) || (gPlcPhyObj->evResetTxCfm))
-        {
-            DRV_PLC_PHY_TRANSMISSION_CFM_OBJ cfmObj;
+        cfmReport[idx] = false;
 
+        if (gPlcPhyObj->evTxCfm[idx])
+        {
             /* Reset event flag */
             gPlcPhyObj->evTxCfm[idx] = false;
+            cfmReport[idx] = true;
 
-            if (gPlcPhyObj->evResetTxCfm)
-            {
-                gPlcPhyObj->evResetTxCfm = false;
-                gPlcPhyObj->state[idx] = DRV_PLC_PHY_STATE_IDLE;
+            lDRV_PLC_PHY_COMM_TxCfmEvent(&cfmObj[idx], idx);
+        }
+    }
 
-                cfmObj.bufferId = (DRV_PLC_PHY_BUFFER_ID)idx;
-                cfmObj.rmsCalc = 0;
-                cfmObj.timeIni = 0;
-                cfmObj.result = DRV_PLC_PHY_TX_RESULT_NO_TX;
-            } else {
-                lDRV_PLC_PHY_COMM_TxCfmEvent(&cfmObj, idx);
-            }
+    /* Report confirmations in order of transmission time, as both buffers
+     * can be confirmed in the same task */
+    cfmFirst = 0;
+    if (cfmReport[0] && cfmReport[1] && ((int32_t)(cfmObj[1].timeIni - cfmObj[0].timeIni) < 0))
+    {
+        cfmFirst = 1;
+    }
 
-            if (gPlcPhyObj->txCfmCallback != NULL)
-            {
-                /* Report to upper layer */
-                gPlcPhyObj->txCfmCallback(&cfmObj, gPlcPhyObj->contextCfm);
-            }
+    for (uint8_t num = 0; num < NUM_TX_BUFFERS; num++)
+    {
+        uint8_t idx = cfmFirst ^ num;
+
+        if (cfmReport[idx] && (gPlcPhyObj->txCfmCallback != NULL))
+        {
+            /* Report to upper layer */
+            gPlcPhyObj->txCfmCallback(&cfmObj[idx], gPlcPhyObj->contextCfm);
         }
     }
 
-    if (gPlcPhyObj->evRxPar && gPlcPhyObj->evRxDat)
+    /* Report received frames in order */
+    while (gPlcPhyObj->rxRingNum > 0U)
     {
         DRV_PLC_PHY_RECEPTION_OBJ rxObj;
 
-        /* Reset event flags */
-        gPlcPhyObj->evRxPar = false;
-        gPlcPhyObj->evRxDat = false;
-
-        lDRV_PLC_PHY_COMM_RxEvent(&rxObj);
+        lDRV_PLC_PHY_COMM_RxEvent(&rxObj, gPlcPhyObj->rxRingFirst);
         if (gPlcPhyObj->dataIndCallback != NULL)
         {
             /* Report to upper layer */
             gPlcPhyObj->dataIndCallback(&rxObj, gPlcPhyObj->contextInd);
         }
+
+        /* Release the slot once the upper layer is done with the data */
+        if (++gPlcPhyObj->rxRingFirst == DRV_PLC_PHY_RX_RING_SIZE)
+        {
+            gPlcPhyObj->rxRingFirst = 0;
+        }
+
+        gPlcPhyObj->rxRingNum--;
     }
+
+    /* Store frames received while upper layers were being notified */
+    lDRV_PLC_PHY_COMM_ServiceEvents();
+
+    /* Process queued PIB requests */
+    lDRV_PLC_PHY_COMM_PibTask();
 }
 
 void DRV_PLC_PHY_TxRequest(const DRV_HANDLE handle, DRV_PLC_PHY_TRANSMISSION_OBJ *transmitObj)
@@ -478,6 +1073,10 @@ void DRV_PLC_PHY_TxRequest(const DRV_HANDLE handle, DRV_PLC_PHY_TRANSMISSION_OBJ
     DRV_PLC_PHY_TRANSMISSION_CFM_OBJ cfmObj;
     uint8_t bufIdx = (uint8_t) transmitObj->bufferId;
 
+    /* Confirmations reported from this function refer to the request */
+    cfmObj.bufferId = transmitObj->bufferId;
+    cfmObj.frameType = transmitObj->frameType;
+
     if (bufIdx > (uint8_t)(TX_BUFFER_1))
     {
         /* Invalid buffer. */
@@ -513,6 +1112,12 @@ void DRV_PLC_PHY_TxRequest(const DRV_HANDLE handle, DRV_PLC_PHY_TRANSMISSION_OBJ
     {
         size_t size;
 
+        if (gPlcPhyObj->txDeferred)
+        {
+            /* Single transmission buffer: send the deferred one first */
+            lDRV_PLC_PHY_COMM_PibWait();
+        }
+
         size = lDRV_PLC_PHY_COMM_TxStringify(transmitObj);
 
         if (size > 0U)
@@ -523,18 +1128,18 @@ void DRV_PLC_PHY_TxRequest(const DRV_HANDLE handle, DRV_PLC_PHY_TRANSMISSION_OBJ
                 gPlcPhyObj->state[bufIdx] = DRV_PLC_PHY_STATE_WAITING_TX_CFM;
             }
 
-            /* Send TX message */
-            if (bufIdx == (uint8_t)(TX_BUFFER_0))
+            if (gPlcPhyObj->pibState == DRV_PLC_PHY_PIB_STATE_WAITING_GUARD)
             {
-                lDRV_PLC_PHY_COMM_SpiWriteCmd(TX0_PAR_ID, sDataTx, (uint16_t)size);
+                /* PLC transceiver not ready until PIB write guard time
+                 * elapses: sent from the tasks */
+                gPlcPhyObj->txDeferred = true;
+                gPlcPhyObj->txDeferredIdx = bufIdx;
+                gPlcPhyObj->txDeferredSize = (uint16_t)size;
             }
             else
             {
-                lDRV_PLC_PHY_COMM_SpiWriteCmd(TX1_PAR_ID, sDataTx, (uint16_t)size);
+                lDRV_PLC_PHY_COMM_TxSend(bufIdx, (uint16_t)size);
             }
-
-            /* Time guard */
-            gPlcPhyObj->plcHal->delay(20);
         }
         else
         {
@@ -563,123 +1168,46 @@ void DRV_PLC_PHY_TxRequest(const DRV_HANDLE handle, DRV_PLC_PHY_TRANSMISSION_OBJ
     }
 }
 
-bool DRV_PLC_PHY_PIBGet(const DRV_HANDLE handle, DRV_PLC_PHY_PIB_OBJ *pibObj)
+void DRV_PLC_PHY_ResetTxCfmTask(void)
 {
-    if((handle != DRV_HANDLE_INVALID) && (handle == 0U))
+    /* Transmissions in progress when the PLC transceiver was restarted are
+     * confirmed once each, whatever the driver status, so that they are
+     * reported before any transmission after the restart */
+    if (gPlcPhyObj == NULL)
     {
-        if (pibObj->id == PLC_ID_TIME_REF_ID)
-        {
-            /* Send PIB information request */
-            lDRV_PLC_PHY_COMM_SpiReadCmd(STATUS_ID, pibObj->pData, pibObj->length);
-            return true;
-        }
-        else if (((uint16_t)pibObj->id & DRV_PLC_PHY_REG_ID_MASK) != 0U)
-        {
-            uint8_t *pDst;
-            uint32_t address;
-            uint16_t offset;
-            uint16_t secureCnt;
-            uint16_t cmdLength;
-
-            offset = (uint16_t)pibObj->id & DRV_PLC_PHY_REG_OFFSET_MASK;
-
-            /* Get address offset */
-            address = lDRV_PLC_PHY_COMM_GetPibBaseAddress(pibObj->id);
-            if (address == 0U)
-            {
-                return false;
-            }
-            address += offset;
-
-            /* Set CMD and length */
-            cmdLength = (uint16_t)DRV_PLC_PHY_CMD_READ | (pibObj->length & DRV_PLC_PHY_REG_LEN_MASK);
+        /* Not started yet: nothing transmitted */
+        return;
+    }
 
-            /* Build command */
-            pDst = sDataReg;
+    for (uint8_t idx = 0; idx < NUM_TX_BUFFERS; idx++)
+    {
+        if (gPlcPhyObj->evResetTxCfm[idx])
+        {
+            DRV_PLC_PHY_TRANSMISSION_CFM_OBJ cfmObj;
 
-            *pDst++ = (uint8_t)(address >> 24);
-            *pDst++ = (uint8_t)(address >> 16);
-            *pDst++ = (uint8_t)(address >> 8);
-            *pDst++ = (uint8_t)(address);
-            *pDst++ = (uint8_t)(cmdLength >> 8);
-            *pDst++ = (uint8_t)(cmdLength);
+            gPlcPhyObj->evResetTxCfm[idx] = false;
+            gPlcPhyObj->state[idx] = DRV_PLC_PHY_STATE_IDLE;
 
-            /* Send PIB information request */
-            lDRV_PLC_PHY_COMM_SpiWriteCmd(REG_INFO_ID, sDataReg, 8U);
+            cfmObj.bufferId = (DRV_PLC_PHY_BUFFER_ID)idx;
+            cfmObj.rmsCalc = 0;
+            cfmObj.timeIni = 0;
+            cfmObj.frameType = FRAME_TYPE_A;
+            cfmObj.result = DRV_PLC_PHY_TX_RESULT_NO_TX;
 
-            /* Wait to the response : Check length of the register response */
-            secureCnt = 0xFFFF;
-            while (gPlcPhyObj->evRegRspLength == 0U)
+            if (gPlcPhyObj->txCfmCallback != NULL)
             {
-                if ((secureCnt--) == 0U)
-                {
-                    /* Didn't came the expected response */
-                    return false;
-                }
+                /* Report to upper layer */
+                gPlcPhyObj->txCfmCallback(&cfmObj, gPlcPhyObj->contextCfm);
             }
-
-            /* copy Register info in data pointer */
-            (void) memcpy(pibObj->pData, sDataReg, pibObj->length);
-            /* Reset length of the register response */
-            gPlcPhyObj->evRegRspLength = 0;
-
-            return true;
         }
-        else
-        {
-            uint32_t value;
-            bool result = true;
-
-            /* Get HOST information */
-            switch(pibObj->id)
-            {
-                case PLC_ID_HOST_DESCRIPTION_ID:
-                {
-                    const char *hostDesc = DRV_PLC_PHY_HOST_DESC;
-                    (void) memcpy((void *)pibObj->pData, (const void *)hostDesc, strlen(DRV_PLC_PHY_HOST_DESC));
-                    break;
-                }
-
-                case PLC_ID_HOST_MODEL_ID:
-                    value = DRV_PLC_PHY_HOST_MODEL;
-                    pibObj->pData[0] = (uint8_t)value;
-                    pibObj->pData[1] = (uint8_t)(value >> 8);
-                    break;
-
-                case PLC_ID_HOST_PHY_ID:
-                    value = DRV_PLC_PHY_HOST_PHY;
-                    pibObj->pData[0] = (uint8_t)value;
-                    pibObj->pData[1] = (uint8_t)(value >> 8);
-                    pibObj->pData[2] = (uint8_t)(value >> 16);
-                    pibObj->pData[3] = (uint8_t)(value >> 24);
-                    break;
-
-                case PLC_ID_HOST_PRODUCT_ID:
-                    value = DRV_PLC_PHY_HOST_PRODUCT;
-                    pibObj->pData[0] = (uint8_t)value;
-                    pibObj->pData[1] = (uint8_t)(value >> 8);
-                    break;
-
-                case PLC_ID_HOST_VERSION_ID:
-                    value = DRV_PLC_PHY_HOST_VERSION;
-                    pibObj->pData[0] = (uint8_t)value;
-                    pibObj->pData[1] = (uint8_t)(value >> 8);
-                    pibObj->pData[2] = (uint8_t)(value >> 16);
-                    pibObj->pData[3] = (uint8_t)(value >> 24);
-                    break;
-
-                case PLC_ID_HOST_BAND_ID:
-                    value = DRV_PLC_PHY_HOST_BAND;
-                    pibObj->pData[0] = (uint8_t)value;
-                    break;
-
-                default:
-                    result = false;
-                    break;
-            }
+    }
+}
 
-            return result;
-        }
+bool DRV_PLC_PHY_PIBGet(const DRV_HANDLE handle, DRV_PLC_PHY_PIB_OBJ *pibObj)
+{
+    if((handle != DRV_HANDLE_INVALID) && (handle == 0U))
+    {
+        return lDRV_PLC_PHY_COMM_PibAccess(pibObj, false);
     }
     else
     {
@@ -691,65 +1219,58 @@ bool DRV_PLC_PHY_PIBSet(const DRV_HANDLE handle, DRV_PLC_PHY_PIB_OBJ *pibObj)
 {
     if((handle != DRV_HANDLE_INVALID) && (handle == 0U))
     {
-        if (((uint16_t)pibObj->id & DRV_PLC_PHY_REG_ID_MASK) != 0U)
-        {
-            uint8_t *pDst;
-            uint8_t *pSrc;
-            uint32_t address;
-            uint16_t offset;
-            uint16_t delay;
-            uint16_t cmdLength;
+        return lDRV_PLC_PHY_COMM_PibAccess(pibObj, true);
+    }
 
-            offset = (uint16_t)pibObj->id & DRV_PLC_PHY_REG_OFFSET_MASK;
+    return false;
+}
 
-            /* Get base address */
-            address = lDRV_PLC_PHY_COMM_GetPibBaseAddress(pibObj->id);
-            if (address == 0U)
-            {
-                return false;
-            }
-            address += offset;
+static bool lDRV_PLC_PHY_COMM_PibRequest(DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs,
+    const DRV_PLC_PHY_PIB_CALLBACK callback, uintptr_t context, bool set)
+{
+    DRV_PLC_PHY_PIB_REQUEST *pRequest;
+    uint32_t idx;
 
-            /* Set CMD and length */
-            cmdLength = (uint16_t)DRV_PLC_PHY_CMD_WRITE | (pibObj->length & DRV_PLC_PHY_REG_LEN_MASK);
+    if ((pibObjs == NULL) || (numPibs == 0U) || (callback == NULL) ||
+            (gPlcPhyObj->pibQueueNum >= DRV_PLC_PHY_PIB_QUEUE_SIZE))
+    {
+        return false;
+    }
 
-            /* Build command */
-            pDst = sDataReg;
+    idx = (uint32_t)gPlcPhyObj->pibQueueFirst + gPlcPhyObj->pibQueueNum;
+    if (idx >= DRV_PLC_PHY_PIB_QUEUE_SIZE)
+    {
+        idx -= DRV_PLC_PHY_PIB_QUEUE_SIZE;
+    }
 
-            *pDst++ = (uint8_t)(address >> 24);
-            *pDst++ = (uint8_t)(address >> 16);
-            *pDst++ = (uint8_t)(address >> 8);
-            *pDst++ = (uint8_t)(address);
-            *pDst++ = (uint8_t)(cmdLength >> 8);
-            *pDst++ = (uint8_t)(cmdLength);
+    pRequest = &gPlcPhyObj->pibQueue[idx];
+    pRequest->pibObjs = pibObjs;
+    pRequest->numPibs = numPibs;
+    pRequest->callback = callback;
+    pRequest->context = context;
+    pRequest->set = set;
+    gPlcPhyObj->pibQueueNum++;
 
-            pSrc = pibObj->pData;
-            if (pibObj->length == 4U)
-            {
-                *pDst++ = *pSrc++;
-                *pDst++ = *pSrc++;
-                *pDst++ = *pSrc++;
-                *pDst++ = *pSrc++;
-            }
-            else if (pibObj->length == 2U)
-            {
-                *pDst++ = *pSrc++;
-                *pDst++ = *pSrc++;
-            }
-            else
-            {
-                (void) memcpy(pDst, pSrc, pibObj->length);
-            }
+    return true;
+}
 
-            /* Send PIB information request */
-            lDRV_PLC_PHY_COMM_SpiWriteCmd(REG_INFO_ID, sDataReg, 6U + pibObj->length);
+bool DRV_PLC_PHY_PIBGetRequest(const DRV_HANDLE handle, DRV_PLC_PHY_PIB_OBJ *pibObjs,
+    uint8_t numPibs, const DRV_PLC_PHY_PIB_CALLBACK callback, uintptr_t context)
+{
+    if((handle != DRV_HANDLE_INVALID) && (handle == 0U))
+    {
+        return lDRV_PLC_PHY_COMM_PibRequest(pibObjs, numPibs, callback, context, false);
+    }
 
-            /* Guard delay to ensure writing operation completion. */
-            delay = lDRV_PLC_PHY_COMM_GetDelayUs(pibObj->id);
-            gPlcPhyObj->plcHal->delay(delay);
+    return false;
+}
 
-            return true;
-        }
+bool DRV_PLC_PHY_PIBSetRequest(const DRV_HANDLE handle, DRV_PLC_PHY_PIB_OBJ *pibObjs,
+    uint8_t numPibs, const DRV_PLC_PHY_PIB_CALLBACK callback, uintptr_t context)
+{
+    if((handle != DRV_HANDLE_INVALID) && (handle == 0U))
+    {
+        return lDRV_PLC_PHY_COMM_PibRequest(pibObjs, numPibs, callback, context, true);
     }
 
     return false;
@@ -762,59 +1283,8 @@ void DRV_PLC_PHY_ExternalInterruptHandler(PIO_PIN pin, uintptr_t context)
 
     if ((gPlcPhyObj != NULL) && (pin == (PIO_PIN)gPlcPhyObj->plcHal->plcPlib->extIntPin))
     {
-        DRV_PLC_PHY_EVENTS_OBJ evObj;
-
-        /* Time guard */
-        gPlcPhyObj->plcHal->delay(20);
-
-        /* Get PLC events information */
-        lDRV_PLC_PHY_COMM_GetEventsInfo(&evObj);
-
-        /* Check confirmation of the transmission event */
-        if (evObj.evCfm[0])
-        {
-            lDRV_PLC_PHY_COMM_SpiReadCmd(TX0_CFM_ID, sDataTxCfm[0], (uint16_t)PLC_CMF_PKT_SIZE);
-            /* update event flag */
-            gPlcPhyObj->evTxCfm[0] = true;
-            /* Update PLC state: idle */
-            gPlcPhyObj->state[0] = DRV_PLC_PHY_STATE_IDLE;
-        }
-
-        if (evObj.evCfm[1])
-        {
-            lDRV_PLC_PHY_COMM_SpiReadCmd(TX1_CFM_ID, sDataTxCfm[1], PLC_CMF_PKT_SIZE);
-            /* update event flag */
-            gPlcPhyObj->evTxCfm[1] = true;
-            /* Update PLC state: idle */
-            gPlcPhyObj->state[1] = DRV_PLC_PHY_STATE_IDLE;
-        }
-
-        /* Check received new data event (First event in RX) */
-        if (evObj.evRxDat)
-        {
-            lDRV_PLC_PHY_COMM_SpiReadCmd(RX_DAT_ID, sDataRxDat, evObj.rcvDataLength);
-            /* update event flag */
-            gPlcPhyObj->evRxDat = true;
-        }
-
-        /* Check received new parameters event (Second event in RX) */
-        if (evObj.evRxPar)
-        {
-            lDRV_PLC_PHY_COMM_SpiReadCmd(RX_PAR_ID, sDataRxPar, (uint16_t)PLC_RX_PAR_SIZE - 4U);
-            /* update event flag */
-            gPlcPhyObj->evRxPar = true;
-        }
-
-        /* Check register info event */
-        if (evObj.evReg)
-        {
-            lDRV_PLC_PHY_COMM_SpiReadCmd(REG_INFO_ID, sDataReg, evObj.regRspLength);
-            /* update event flag */
-            gPlcPhyObj->evRegRspLength = evObj.regRspLength;
-        }
-
-        /* Time guard */
-        gPlcPhyObj->plcHal->delay(20);
+        /* PLC events are read over SPI from DRV_PLC_PHY_Task */
+        gPlcPhyObj->evPending = true;
     }
 
     /* PORT Interrupt Status Clear */
@@ -47,6 +47,7 @@ Microchip or any third party.
 // Section: Included Files
 // *****************************************************************************
 // *****************************************************************************
+#include "configuration.h"
 #include "system/system.h"
 #include "driver/plc/phy/drv_plc_phy.h"
 #include "driver/plc/phy/drv_plc_phy_definitions.h"
@@ -103,6 +104,58 @@ typedef enum
     DRV_PLC_PHY_STATE_ERROR,
 }DRV_PLC_PHY_STATE;
 
+// *****************************************************************************
+/* DRV_PLC_PHY PIB Access State
+
+  Summary:
+    Defines the status of the PIB access in progress.
+
+  Description:
+    This enumeration defines the status of the PIB access in progress.
+
+  Remarks:
+    None.
+*/
+
+typedef enum
+{
+    DRV_PLC_PHY_PIB_STATE_IDLE,
+    DRV_PLC_PHY_PIB_STATE_WAITING_RSP,
+    DRV_PLC_PHY_PIB_STATE_WAITING_GUARD,
+}DRV_PLC_PHY_PIB_STATE;
+
+// *****************************************************************************
+/* DRV_PLC_PHY PIB Request Object
+
+  Summary:
+    Object used to keep a queued PIB request.
+
+  Description:
+    None.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    /* Array of PIB objects, owned by the client until the callback */
+    DRV_PLC_PHY_PIB_OBJ             *pibObjs;
+
+    /* Client callback */
+    DRV_PLC_PHY_PIB_CALLBACK        callback;
+
+    /* Client context */
+    uintptr_t                       context;
+
+    /* Number of PIB objects */
+    uint8_t                         numPibs;
+
+    /* Set (true) or get (false) request */
+    bool                            set;
+
+} DRV_PLC_PHY_PIB_REQUEST;
+
 // *****************************************************************************
 /* PLC Driver Instance Object
 
@@ -186,8 +239,55 @@ typedef struct
     /* Event detection flag: length of the response with register content */
     volatile uint16_t               evRegRspLength;
 
-    /* Event detection flag: reset waiting tx cfm */
-    volatile bool                   evResetTxCfm;
+    /* Event detection flag: reset waiting tx cfm (one per TX buffer) */
+    volatile bool                   evResetTxCfm[2];
+
+    /* Event detection flag: PLC external interrupt pending to be serviced */
+    volatile bool                   evPending;
+
+    /* Reception ring: index of the oldest received frame */
+    uint8_t                         rxRingFirst;
+
+    /* Reception ring: number of received frames pending to be reported */
+    uint8_t                         rxRingNum;
+
+    /* Reception ring was full when data of current frame was received */
+    bool                            rxDropping;
+
+    /* Number of received frames discarded by the driver */
+    uint32_t                        rxOverrunCount;
+
+    /* PIB access: state */
+    DRV_PLC_PHY_PIB_STATE           pibState;
+
+    /* PIB access: PIB objects covered by the access in progress */
+    DRV_PLC_PHY_PIB_OBJ             *pibObjs;
+    uint8_t                         pibNum;
+
+    /* PIB access: it belongs to the first request of the queue */
+    bool                            pibQueued;
+
+    /* PIB access: result of the last access */
+    bool                            pibResult;
+
+    /* PIB access: time reference and timeout/guard time (SYS_TIME counts) */
+    uint32_t                        pibTimeRef;
+    uint32_t                        pibTimeCount;
+
+    /* PIB request queue */
+    DRV_PLC_PHY_PIB_REQUEST         pibQueue[DRV_PLC_PHY_PIB_QUEUE_SIZE];
+    uint8_t                         pibQueueFirst;
+    uint8_t                         pibQueueNum;
+
+    /* First request of the queue: next PIB object and result */
+    uint8_t                         pibQueueIdx;
+    bool                            pibQueueResult;
+
+    /* Transmission requested during a PIB write guard time, kept in the
+       transmission buffer until the guard time elapses */
+    bool                            txDeferred;
+    uint8_t                         txDeferredIdx;
+    uint16_t                        txDeferredSize;
 
 } DRV_PLC_PHY_OBJ;
 
@@ -62,6 +62,12 @@ Microchip or any third party.
 #define PLC_CMF_PKT_SIZE      (uint16_t)(sizeof(DRV_PLC_PHY_TRANSMISSION_CFM_OBJ))
 #define PLC_REG_PKT_SIZE      PLC_DATA_PKT_SIZE
 
+/* Offset of data length field in reception parameters */
+#define PLC_RX_PAR_DATA_LEN_OFFSET                 16U
+
+/* Timeout waiting for a register response */
+#define PLC_REG_RSP_TIMEOUT_US                     5000U
+
 /* Number of transmission buffers */
 #define NUM_TX_BUFFERS                             2U
 
@@ -153,5 +159,6 @@ typedef enum {
 
 void DRV_PLC_PHY_Init(DRV_PLC_PHY_OBJ *plcPhyObj);
 void DRV_PLC_PHY_Task(void);
+void DRV_PLC_PHY_ResetTxCfmTask(void);
 
 #endif //#ifndef DRV_PLC_PHY_LOCAL_COMM_H
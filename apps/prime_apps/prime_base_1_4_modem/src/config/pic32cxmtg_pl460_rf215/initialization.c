@@ -299,6 +299,8 @@ static const SRV_USI_USART_INTERFACE srvUsi0InitDataFLEXCOM7 = {
     .readCallbackRegister = (USI_USART_PLIB_READ_CALLBACK_REG)FLEXCOM7_USART_ReadCallbackRegister,
     .readData = (USI_USART_PLIB_WRRD)FLEXCOM7_USART_Read,
     .writeData = (USI_USART_PLIB_WRRD)FLEXCOM7_USART_Write,
+    .writeCountGet = FLEXCOM7_USART_WriteCountGet,
+    .writeFreeBufferCountGet = FLEXCOM7_USART_WriteFreeBufferCountGet,
     .intSource = FLEXCOM7_IRQn,
 };
 
@@ -69,8 +69,8 @@
 #define FLEXCOM7_USART_READ_BUFFER_SIZE             1024U
 #define FLEXCOM7_USART_9BIT_READ_BUFFER_SIZE        (1024U >> 1U)
 
-#define FLEXCOM7_USART_WRITE_BUFFER_SIZE            1024U
-#define FLEXCOM7_USART_9BIT_WRITE_BUFFER_SIZE       (1024U >> 1U)
+#define FLEXCOM7_USART_WRITE_BUFFER_SIZE            2048U
+#define FLEXCOM7_USART_9BIT_WRITE_BUFFER_SIZE       (2048U >> 1U)
 
 volatile static uint8_t FLEXCOM7_USART_ReadBuffer[FLEXCOM7_USART_READ_BUFFER_SIZE];
 volatile static uint8_t FLEXCOM7_USART_WriteBuffer[FLEXCOM7_USART_WRITE_BUFFER_SIZE];
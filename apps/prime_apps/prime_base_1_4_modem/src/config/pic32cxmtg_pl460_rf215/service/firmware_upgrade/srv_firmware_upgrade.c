@@ -71,6 +71,15 @@ Microchip or any third party.
 #define MEMORY_WRITE_SIZE       (uint32_t)(512)
 #define MAX_BUFFER_READ_SIZE    (uint32_t)(1024)
 
+/* Maximum size of the bitmap of written pages (same as the PRIME stack) */
+#define SRV_FU_BITMAP_SIZE      (uint32_t)(1024)
+
+/* Polynomial of PCRC_CRC32 (not reflected, no final XOR) */
+#define SRV_FU_CRC32_POLYNOMIAL 0x04C11DB7UL
+
+/* Size of the bitmap of erased sectors */
+#define SRV_FU_ERASE_BITMAP_SIZE  (((PRIME_FU_MEM_SIZE / DRV_MEMORY_DEVICE_ERASE_SIZE) + 7U) >> 3)
+
 
 // *****************************************************************************
 // *****************************************************************************
@@ -92,6 +101,32 @@ static CACHE_ALIGN uint8_t pMemWrite[MEMORY_WRITE_SIZE];
 
 static CACHE_ALIGN uint8_t pBuffInput[MAX_BUFFER_READ_SIZE];
 
+/* Pages to write: one is written while the next one is received */
+static CACHE_ALIGN SRV_FU_WRITE_BUFFER writeBuffer[SRV_FU_WRITE_BUFFERS];
+
+/* Buffer being written and number of buffers with data */
+static uint8_t writeIndex;
+static uint8_t writeCount;
+
+/* Image address following the last page written */
+static uint32_t writeNextAddress;
+
+/* Sectors of the FU region erased since start (1 bit per sector) */
+static uint8_t eraseBitmap[SRV_FU_ERASE_BITMAP_SIZE];
+
+/* Sectors kept from the upgrade resumed after reset (1 bit per sector) */
+static uint8_t keptBitmap[SRV_FU_ERASE_BITMAP_SIZE];
+
+/* Last sector erased in advance */
+static uint32_t eraseAheadSector;
+
+/* Read and CRC requests waiting for the writes to finish */
+static bool readPending;
+static uint32_t readPendingAddress;
+static uint8_t *readPendingBuffer;
+static uint16_t readPendingSize;
+static bool crcPending;
+
 static CACHE_ALIGN SRV_FU_MEM_INFO memInfo;
 
 static SRV_FU_INFO fuData;
@@ -106,6 +141,33 @@ static uint32_t crcRemainingSize;
 
 static uint32_t calculatedCrc;
 
+/* Pages written in memory (1 bit per page) */
+static uint8_t pagesBitmap[SRV_FU_BITMAP_SIZE];
+
+/* Number of pages written in memory */
+static uint32_t rxPages;
+
+/* Upgrade progress kept in storage, and pages written since last saved */
+static SRV_STORAGE_FU_INFO_CONFIG fuCheckpoint;
+static uint32_t checkpointPages;
+
+/* CRC of the pages written in order from the start of the image */
+static uint32_t crcSeqValue;
+static uint32_t crcSeqEnd;
+
+/* CRC of the pages written out of order, each one shifted to its position in
+   the image */
+static uint32_t crcPagesValue;
+
+/* Number of bytes of the written pages */
+static uint32_t crcPagesSize;
+
+/* CRC of written pages can be used instead of reading the image */
+static bool crcPagesValid;
+
+/* x^(8 * 2^n) modulo CRC32 polynomial, to shift a CRC by 2^n bytes */
+static uint32_t crcShiftTable[32];
+
 
 
 // *****************************************************************************
@@ -114,6 +176,511 @@ static uint32_t calculatedCrc;
 // *****************************************************************************
 // *****************************************************************************
 
+static uint32_t lSRV_FU_CrcMultiply(uint32_t a, uint32_t b)
+{
+    uint32_t product = 0;
+    uint32_t bit;
+
+    /* Polynomial product modulo CRC32 polynomial */
+    for (bit = 0x80000000UL; bit != 0U; bit >>= 1)
+    {
+        if ((product & 0x80000000UL) != 0U)
+        {
+            product = (product << 1) ^ SRV_FU_CRC32_POLYNOMIAL;
+        }
+        else
+        {
+            product <<= 1;
+        }
+
+        if ((a & bit) != 0U)
+        {
+            product ^= b;
+        }
+    }
+
+    return product;
+}
+
+static uint32_t lSRV_FU_CrcShift(uint32_t crc, uint32_t numBytes)
+{
+    uint8_t index = 0;
+
+    /* CRC of the same data followed by numBytes zeros */
+    while ((numBytes != 0U) && (crc != 0U))
+    {
+        if ((numBytes & 1U) != 0U)
+        {
+            crc = lSRV_FU_CrcMultiply(crc, crcShiftTable[index]);
+        }
+
+        numBytes >>= 1;
+        index++;
+    }
+
+    return crc;
+}
+
+static uint32_t lSRV_FU_GetNumPages(void)
+{
+    if (fuData.pageSize == 0U)
+    {
+        return 0;
+    }
+
+    return (fuData.imageSize + fuData.pageSize - 1U) / fuData.pageSize;
+}
+
+static uint8_t *lSRV_FU_GetMemoryData(uint32_t address)
+{
+    /* The FU region is in the internal flash (SEFC0), mapped in the address
+     * space: SEFC0_Read also reads it with a memcpy. It is read here directly
+     * because DRV_MEMORY only reads asynchronously, with a single command
+     * queued. Reading while a page is written or a sector erased is safe: the
+     * code runs from the same flash during those commands */
+    return (uint8_t *)(DRV_MEMORY_DEVICE_START_ADDRESS + memInfo.startAdressFuRegion + address);
+}
+
+static bool lSRV_FU_GetPage(uint32_t address, uint16_t size, uint32_t *page)
+{
+    uint32_t pageSize;
+
+    if ((fuData.pageSize == 0U) || (address >= fuData.imageSize) ||
+        ((address % fuData.pageSize) != 0U))
+    {
+        return false;
+    }
+
+    /* Pages must be complete (except last one) */
+    pageSize = fuData.imageSize - address;
+    if (pageSize > fuData.pageSize)
+    {
+        pageSize = fuData.pageSize;
+    }
+
+    *page = address / fuData.pageSize;
+
+    return ((size == pageSize) && (*page < (SRV_FU_BITMAP_SIZE << 3)));
+}
+
+static bool lSRV_FU_PageWritten(uint32_t page)
+{
+    return ((pagesBitmap[page >> 3] & (1U << (page & 7U))) != 0U);
+}
+
+static uint32_t lSRV_FU_FindPage(uint32_t page, uint32_t numPages, bool written)
+{
+    uint8_t skipByte = (written == true) ? 0x00U : 0xFFU;
+
+    /* First page from the given one that is written (or not written) */
+    while (page < numPages)
+    {
+        if (((page & 7U) == 0U) && (pagesBitmap[page >> 3] == skipByte))
+        {
+            page += 8U;
+        }
+        else if (lSRV_FU_PageWritten(page) == written)
+        {
+            break;
+        }
+        else
+        {
+            page++;
+        }
+    }
+
+    return (page < numPages) ? page : numPages;
+}
+
+static void lSRV_FU_SaveCheckpoint(void)
+{
+    uint32_t numPages = lSRV_FU_GetNumPages();
+    uint32_t page = 0;
+    uint32_t start;
+    uint16_t length;
+    uint16_t index;
+    uint16_t shortest;
+
+    fuCheckpoint.numRanges = 0;
+
+    while (page < numPages)
+    {
+        /* Next range of written pages */
+        start = lSRV_FU_FindPage(page, numPages, true);
+        page = lSRV_FU_FindPage(start, numPages, false);
+        length = (uint16_t)(page - start);
+
+        if (length == 0U)
+        {
+            break;
+        }
+
+        if (fuCheckpoint.numRanges < SRV_STORAGE_FU_INFO_RANGES)
+        {
+            index = fuCheckpoint.numRanges;
+            fuCheckpoint.numRanges++;
+        }
+        else
+        {
+            /* No space left: keep the longest ranges */
+            index = 0;
+            for (shortest = 1; shortest < SRV_STORAGE_FU_INFO_RANGES; shortest++)
+            {
+                if (fuCheckpoint.rangeLength[shortest] < fuCheckpoint.rangeLength[index])
+                {
+                    index = shortest;
+                }
+            }
+
+            if (fuCheckpoint.rangeLength[index] >= length)
+            {
+                continue;
+            }
+        }
+
+        fuCheckpoint.rangeStart[index] = (uint16_t)start;
+        fuCheckpoint.rangeLength[index] = length;
+    }
+
+    checkpointPages = 0;
+
+    /* Written to User Signature by the storage service */
+    (void) SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE_FU_INFO, (uint8_t)sizeof(fuCheckpoint), &fuCheckpoint);
+}
+
+static void lSRV_FU_ClearCheckpoint(void)
+{
+    SRV_STORAGE_FU_INFO_CONFIG fuInfo;
+
+    if ((SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE_FU_INFO, (uint8_t)sizeof(fuInfo), &fuInfo) == true) &&
+        (fuInfo.cfgKey == SRV_STORAGE_FU_INFO_CFG_KEY))
+    {
+        fuInfo.cfgKey = 0;
+        (void) SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE_FU_INFO, (uint8_t)sizeof(fuInfo), &fuInfo);
+    }
+}
+
+static void lSRV_FU_PageAdd(uint32_t address, uint8_t *buffer, uint16_t size)
+{
+    uint32_t page;
+    uint32_t crc;
+
+    if (lSRV_FU_GetPage(address, size, &page) == false)
+    {
+        /* Pages must be aligned to be combined in the CRC */
+        crcPagesValid = false;
+        return;
+    }
+
+    if (lSRV_FU_PageWritten(page) == true)
+    {
+        /* Page retransmitted, already included */
+        return;
+    }
+
+    if (crcPagesValid == true)
+    {
+        if (address == crcSeqEnd)
+        {
+            /* Page in order: continue the CRC */
+            crcSeqValue = SRV_PCRC_GetValue(buffer, size, PCRC_HT_GENERIC, PCRC_CRC32, crcSeqValue);
+            crcSeqEnd += size;
+        }
+        else
+        {
+            /* CRC of the page followed by the rest of the image as zeros.
+             * Image CRC is the XOR of all of them */
+            crc = SRV_PCRC_GetValue(buffer, size, PCRC_HT_GENERIC, PCRC_CRC32, 0);
+            crcPagesValue ^= lSRV_FU_CrcShift(crc, fuData.imageSize - address - size);
+        }
+
+        crcPagesSize += size;
+    }
+
+    /* CRC of the first page written, to check the image in memory on resume */
+    if (page <= fuCheckpoint.crcPage)
+    {
+        fuCheckpoint.crcPage = (uint16_t)page;
+        fuCheckpoint.crcValue = SRV_PCRC_GetValue(buffer, size, PCRC_HT_GENERIC, PCRC_CRC32, 0);
+    }
+
+    pagesBitmap[page >> 3] |= (uint8_t)(1U << (page & 7U));
+    rxPages++;
+
+    /* Save progress every few pages, and when the image is complete */
+    checkpointPages++;
+    if ((checkpointPages >= SRV_FU_CHECKPOINT_PAGES) || (rxPages == lSRV_FU_GetNumPages()))
+    {
+        lSRV_FU_SaveCheckpoint();
+    }
+}
+
+static bool lSRV_FU_SectorErased(uint32_t sector)
+{
+    return ((eraseBitmap[sector >> 3] & (1U << (sector & 7U))) != 0U);
+}
+
+static void lSRV_FU_SetSectorErased(uint32_t sector)
+{
+    eraseBitmap[sector >> 3] |= (uint8_t)(1U << (sector & 7U));
+}
+
+static bool lSRV_FU_SectorKept(uint32_t sector)
+{
+    return ((keptBitmap[sector >> 3] & (1U << (sector & 7U))) != 0U);
+}
+
+static void lSRV_FU_GetSectorPages(uint32_t sector, uint32_t *page, uint32_t *endPage)
+{
+    uint32_t numPages = lSRV_FU_GetNumPages();
+    uint32_t address;
+
+    /* Pages with at least one byte in the sector */
+    address = ((memInfo.eraseBlockStart + sector) * memInfo.eraseBlockSize) - memInfo.startAdressFuRegion;
+    *page = address / fuData.pageSize;
+    *endPage = (address + memInfo.eraseBlockSize + fuData.pageSize - 1U) / fuData.pageSize;
+
+    if (*endPage > numPages)
+    {
+        *endPage = numPages;
+    }
+}
+
+static bool lSRV_FU_SectorComplete(uint32_t sector)
+{
+    uint32_t page, endPage;
+
+    lSRV_FU_GetSectorPages(sector, &page, &endPage);
+
+    for (; page < endPage; page++)
+    {
+        if (lSRV_FU_PageWritten(page) == false)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool lSRV_FU_LoadCheckpoint(void)
+{
+    SRV_STORAGE_FU_INFO_CONFIG fuInfo;
+    uint32_t numPages = lSRV_FU_GetNumPages();
+    uint32_t page, endPage;
+    uint32_t sector, lastSector;
+    uint32_t address, size;
+    uint16_t index;
+
+    if (SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE_FU_INFO, (uint8_t)sizeof(fuInfo), &fuInfo) == false)
+    {
+        return false;
+    }
+
+    /* Same image as the upgrade in progress before reset */
+    if ((fuInfo.cfgKey != SRV_STORAGE_FU_INFO_CFG_KEY) ||
+        (fuInfo.imageSize != fuCheckpoint.imageSize) ||
+        (fuInfo.signLength != fuCheckpoint.signLength) ||
+        (fuInfo.signAlgorithm != fuCheckpoint.signAlgorithm) ||
+        (fuInfo.pageSize != fuCheckpoint.pageSize) ||
+        (fuInfo.numRanges > SRV_STORAGE_FU_INFO_RANGES) ||
+        (fuInfo.crcPage >= numPages) ||
+        (numPages > (SRV_FU_BITMAP_SIZE << 3)))
+    {
+        return false;
+    }
+
+    /* Same data in memory as the page written before reset */
+    address = fuInfo.crcPage * fuData.pageSize;
+    size = fuData.imageSize - address;
+    if (size > fuData.pageSize)
+    {
+        size = fuData.pageSize;
+    }
+
+    if (SRV_PCRC_GetValue(lSRV_FU_GetMemoryData(address), size,
+        PCRC_HT_GENERIC, PCRC_CRC32, 0) != fuInfo.crcValue)
+    {
+        return false;
+    }
+
+    fuCheckpoint.crcPage = fuInfo.crcPage;
+    fuCheckpoint.crcValue = fuInfo.crcValue;
+
+    for (index = 0; index < fuInfo.numRanges; index++)
+    {
+        page = fuInfo.rangeStart[index];
+        endPage = page + fuInfo.rangeLength[index];
+
+        if ((fuInfo.rangeLength[index] == 0U) || (endPage > numPages))
+        {
+            continue;
+        }
+
+        for (; page < endPage; page++)
+        {
+            if (lSRV_FU_PageWritten(page) == false)
+            {
+                pagesBitmap[page >> 3] |= (uint8_t)(1U << (page & 7U));
+                rxPages++;
+            }
+        }
+    }
+
+    /* Pages not in the checkpoint may have been written before reset. Only
+     * sectors with all their pages in the checkpoint are kept */
+    lastSector = ((memInfo.startAdressFuRegion + fuData.imageSize - 1U) / memInfo.eraseBlockSize) - memInfo.eraseBlockStart;
+
+    for (sector = 0; sector <= lastSector; sector++)
+    {
+        if (lSRV_FU_SectorComplete(sector) == true)
+        {
+            keptBitmap[sector >> 3] |= (uint8_t)(1U << (sector & 7U));
+            lSRV_FU_SetSectorErased(sector);
+        }
+    }
+
+    /* The other sectors are erased again, and their pages received again.
+     * The part of a page in a kept sector is not written again */
+    for (sector = 0; sector <= lastSector; sector++)
+    {
+        if (lSRV_FU_SectorKept(sector) == true)
+        {
+            continue;
+        }
+
+        lSRV_FU_GetSectorPages(sector, &page, &endPage);
+        for (; page < endPage; page++)
+        {
+            if (lSRV_FU_PageWritten(page) == true)
+            {
+                pagesBitmap[page >> 3] &= (uint8_t)~(1U << (page & 7U));
+                rxPages--;
+            }
+        }
+    }
+
+    return (rxPages > 0U);
+}
+
+static bool lSRV_FU_DiscardSector(uint32_t sector)
+{
+    uint32_t page, endPage;
+    uint32_t firstPage;
+    bool discarded = false;
+
+    /* Sector erased again before the next write in it, and its pages
+     * received again */
+    eraseBitmap[sector >> 3] &= (uint8_t)~(1U << (sector & 7U));
+
+    lSRV_FU_GetSectorPages(sector, &firstPage, &endPage);
+    for (page = firstPage; page < endPage; page++)
+    {
+        if (lSRV_FU_PageWritten(page) == true)
+        {
+            pagesBitmap[page >> 3] &= (uint8_t)~(1U << (page & 7U));
+            rxPages--;
+            discarded = true;
+        }
+    }
+
+    if (discarded == true)
+    {
+        /* Pages cannot be removed from the CRC, the image is read */
+        crcPagesValid = false;
+        if ((fuCheckpoint.crcPage >= firstPage) && (fuCheckpoint.crcPage < endPage))
+        {
+            fuCheckpoint.crcPage = 0xFFFFU;
+        }
+    }
+
+    /* Caller saves the checkpoint once for all the sectors discarded */
+    return discarded;
+}
+
+static void lSRV_FU_PageChanged(uint32_t address, uint16_t size)
+{
+    uint32_t sector, lastSector;
+    bool discarded = false;
+
+    sector = ((memInfo.startAdressFuRegion + address) / memInfo.eraseBlockSize) - memInfo.eraseBlockStart;
+    lastSector = ((memInfo.startAdressFuRegion + address + size - 1U) / memInfo.eraseBlockSize) - memInfo.eraseBlockStart;
+
+    if ((lSRV_FU_SectorKept(sector) == true) || (lSRV_FU_SectorKept(lastSector) == true))
+    {
+        uint32_t kept;
+
+        /* The checkpoint only identifies the image by its size, page size and
+         * signature: memory holds another image, so no kept sector is valid */
+        for (kept = 0; kept < memInfo.numFuRegionEraseBlocks; kept++)
+        {
+            if (lSRV_FU_SectorKept(kept) == true)
+            {
+                keptBitmap[kept >> 3] &= (uint8_t)~(1U << (kept & 7U));
+                discarded |= lSRV_FU_DiscardSector(kept);
+            }
+        }
+    }
+
+    /* Page is programmed again once its sectors are erased */
+    discarded |= lSRV_FU_DiscardSector(sector);
+    if (lastSector != sector)
+    {
+        discarded |= lSRV_FU_DiscardSector(lastSector);
+    }
+
+    if (discarded == true)
+    {
+        lSRV_FU_SaveCheckpoint();
+    }
+}
+
+static void lSRV_FU_WriteBufferEnd(bool success)
+{
+    SRV_FU_WRITE_BUFFER *wrBuf = &writeBuffer[writeIndex];
+
+    /* A page not written is reported with error, so the PRIME stack sends it
+     * again */
+    if (success == true)
+    {
+        lSRV_FU_PageAdd(wrBuf->address, wrBuf->data, wrBuf->size);
+        writeNextAddress = wrBuf->address + wrBuf->size;
+    }
+
+    writeIndex = (writeIndex + 1U) % SRV_FU_WRITE_BUFFERS;
+    writeCount--;
+
+    /* Each page is reported once it is written in memory (or cannot be
+     * written), with its own result. Buffer is already free for the next
+     * page */
+    if (SRV_FU_MemTransferCallback != NULL)
+    {
+        SRV_FU_MemTransferCallback(SRV_FU_MEM_TRANSFER_CMD_WRITE,
+            (success == true) ? SRV_FU_MEM_TRANSFER_OK : SRV_FU_MEM_TRANSFER_ERROR);
+    }
+}
+
+static void lSRV_FU_EraseSector(uint32_t sector, bool onDemand)
+{
+    DRV_MEMORY_AsyncErase(memInfo.memoryHandle, &memInfo.eraseHandle,
+        memInfo.eraseBlockStart + sector, 1);
+
+    if (DRV_MEMORY_COMMAND_HANDLE_INVALID == memInfo.eraseHandle)
+    {
+        if (onDemand == true)
+        {
+            /* Page cannot be written */
+            lSRV_FU_WriteBufferEnd(false);
+        }
+
+        return;
+    }
+
+    memInfo.eraseSector = sector;
+    memInfo.eraseOnDemand = onDemand;
+    memInfo.state = SRV_FU_MEM_STATE_ERASE_SECTOR;
+}
+
 static void lSRV_FU_TransferHandler
 (
     DRV_MEMORY_EVENT event,
@@ -137,8 +704,27 @@ static void lSRV_FU_TransferHandler
             break;
     }
 
+
     if (commandHandle == mInfo->eraseHandle)
     {
+        if (transferResult == SRV_FU_MEM_TRANSFER_OK)
+        {
+            lSRV_FU_SetSectorErased(memInfo.eraseSector);
+        }
+
+        if (memInfo.state == SRV_FU_MEM_STATE_ERASE_SECTOR)
+        {
+            if ((transferResult != SRV_FU_MEM_TRANSFER_OK) && (memInfo.eraseOnDemand == true))
+            {
+                /* Page cannot be written */
+                lSRV_FU_WriteBufferEnd(false);
+            }
+
+            /* Continue with pending writes, not callback */
+            memInfo.state = SRV_FU_MEM_STATE_WRITE_ONE_BLOCK;
+            return;
+        }
+
         memInfo.state = SRV_FU_MEM_STATE_CMD_WAIT;
         transferCmd = SRV_FU_MEM_TRANSFER_CMD_ERASE;
     }
@@ -158,17 +744,20 @@ static void lSRV_FU_TransferHandler
     }
     else if (commandHandle == mInfo->writeHandle)
     {
-        if (transferResult == SRV_FU_MEM_TRANSFER_OK)
-        {
-            /* Continue with next transfer, not callback */
-            memInfo.state = SRV_FU_MEM_STATE_WRITE_ONE_BLOCK;
-            return;
-        }
-        else
+        if (transferResult != SRV_FU_MEM_TRANSFER_OK)
         {
-            memInfo.state = SRV_FU_MEM_STATE_CMD_WAIT;
-            transferCmd = SRV_FU_MEM_TRANSFER_CMD_WRITE;
+            /* Block may be partially programmed */
+            if (lSRV_FU_DiscardSector((memInfo.retrieveAddress / memInfo.eraseBlockSize) - memInfo.eraseBlockStart) == true)
+            {
+                lSRV_FU_SaveCheckpoint();
+            }
+
+            lSRV_FU_WriteBufferEnd(false);
         }
+
+        /* Continue with next transfer, not callback */
+        memInfo.state = SRV_FU_MEM_STATE_WRITE_ONE_BLOCK;
+        return;
     }
     else
     {
@@ -182,15 +771,123 @@ static void lSRV_FU_TransferHandler
     }
 }
 
-static void lSRV_FU_EraseFuRegion(void)
+static void lSRV_FU_ReadStart(uint32_t address, uint8_t *buffer, uint16_t size)
 {
+	uint32_t readAddress;
+	uint32_t blockStart, nBlock;
 
-    DRV_MEMORY_AsyncErase(memInfo.memoryHandle, &memInfo.eraseHandle,
-        memInfo.eraseBlockStart, memInfo.numFuRegionEraseBlocks);
+	readAddress = memInfo.startAdressFuRegion + address;
 
-	memInfo.state = SRV_FU_MEM_STATE_ERASE_FLASH;
+	blockStart = readAddress / memInfo.readPageSize;
+	nBlock = size / memInfo.readPageSize;
+
+	DRV_MEMORY_AsyncRead(memInfo.memoryHandle, &memInfo.readHandle, (void *) buffer, blockStart, nBlock);
+
+	memInfo.state = SRV_FU_MEM_STATE_READ_MEMORY;
 }
 
+static void lSRV_FU_CrcStart(void)
+{
+	uint32_t blockStart, nBlock;
+    uint32_t bytesPagesRead;
+
+    if ((crcPagesValid == true) && (crcPagesSize == fuData.imageSize))
+    {
+        /* All pages written: no need to read the image */
+        calculatedCrc = lSRV_FU_CrcShift(crcSeqValue, fuData.imageSize - crcSeqEnd) ^ crcPagesValue;
+        crcState = SRV_FU_CRC_READY;
+        memInfo.state = SRV_FU_CALCULATE_CRC_BLOCK;
+        return;
+    }
+
+	crcState = SRV_FU_CRC_WAIT_READ_BLOCK;
+
+	crcReadAddress = memInfo.startAdressFuRegion;
+    crcRemainingSize = fuData.imageSize;
+
+	if (crcRemainingSize < MAX_BUFFER_READ_SIZE)
+    {
+        crcSize = crcRemainingSize;
+    }
+    else
+    {
+        crcSize = MAX_BUFFER_READ_SIZE;
+    }
+
+    blockStart = crcReadAddress / memInfo.readPageSize;
+	nBlock = crcSize / memInfo.readPageSize;
+
+    bytesPagesRead = nBlock * memInfo.readPageSize;
+    /* Aling CRC size with the readPageSize */
+    if (crcSize > bytesPagesRead)
+    {
+        if (((nBlock + 1U) * memInfo.readPageSize) <= MAX_BUFFER_READ_SIZE)
+        {
+            nBlock++;
+        }
+        else
+        {
+            /* Cannot read everything, we reduced the size of the Crc calculated
+            this time */
+            crcSize = bytesPagesRead;
+        }
+    }
+
+	DRV_MEMORY_AsyncRead(memInfo.memoryHandle, &memInfo.readHandle, pBuffInput, blockStart, nBlock);
+
+	crcReadAddress += crcSize;
+    crcRemainingSize -= crcSize;
+
+    memInfo.state = SRV_FU_CALCULATE_CRC_BLOCK;
+
+    /* CRC Initial */
+    calculatedCrc = 0;
+}
+
+static bool lSRV_FU_WriteBusy(void)
+{
+    return ((writeCount > 0U) ||
+            (memInfo.state == SRV_FU_MEM_STATE_WRITE_ONE_BLOCK) ||
+            (memInfo.state == SRV_FU_MEM_STATE_WRITE_WAIT_END) ||
+            (memInfo.state == SRV_FU_MEM_STATE_ERASE_SECTOR));
+}
+
+static void lSRV_FU_WriteIdle(void)
+{
+    uint32_t sector;
+
+    memInfo.state = SRV_FU_MEM_STATE_CMD_WAIT;
+
+    /* Requests received while writing */
+    if (readPending == true)
+    {
+        readPending = false;
+        lSRV_FU_ReadStart(readPendingAddress, readPendingBuffer, readPendingSize);
+        return;
+    }
+
+    if (crcPending == true)
+    {
+        crcPending = false;
+        lSRV_FU_CrcStart();
+        return;
+    }
+
+    /* Erase the next sector while the next page is received */
+    if (writeNextAddress < fuData.imageSize)
+    {
+        sector = ((memInfo.startAdressFuRegion + writeNextAddress) / memInfo.eraseBlockSize) - memInfo.eraseBlockStart;
+
+        if ((sector < memInfo.numFuRegionEraseBlocks) && (sector != eraseAheadSector) &&
+            (lSRV_FU_SectorErased(sector) == false))
+        {
+            eraseAheadSector = sector;
+            lSRV_FU_EraseSector(sector, false);
+        }
+    }
+}
+
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Firmware Upgrade Service Interface Implementation
@@ -199,21 +896,32 @@ static void lSRV_FU_EraseFuRegion(void)
 
 void SRV_FU_Initialize(void)
 {
+    uint8_t index;
+
 	SRV_FU_CrcCallback = NULL;
 	SRV_FU_ImageVerifyCallback = NULL;
 	SRV_FU_ResultCallback = NULL;
 	SRV_FU_SwapCallback = NULL;
     SRV_FU_MemTransferCallback = NULL;
 
+
     memInfo.startAdressFuRegion = 0;
     memInfo.sizeFuRegion = PRIME_FU_MEM_SIZE;
 
 	memInfo.state = SRV_FU_MEM_STATE_OPEN_DRIVER;
+
+    /* x^8, x^16, x^32, ... modulo CRC32 polynomial */
+    crcShiftTable[0] = 0x100UL;
+    for (index = 1; index < 32U; index++)
+    {
+        crcShiftTable[index] = lSRV_FU_CrcMultiply(crcShiftTable[index - 1U], crcShiftTable[index - 1U]);
+    }
+
+    crcPagesValid = false;
 }
 
 void SRV_FU_Tasks(void)
 {
-
    /* Check the Firmware upgrade's current state. */
     switch ( memInfo.state )
     {
@@ -243,6 +951,13 @@ void SRV_FU_Tasks(void)
 			memInfo.eraseBlockStart = (memInfo.startAdressFuRegion / nvmGeometry->geometryTable[SYS_MEDIA_GEOMETRY_TABLE_ERASE_ENTRY].blockSize);
 
             memInfo.numFuRegionEraseBlocks = (memInfo.sizeFuRegion / nvmGeometry->geometryTable[SYS_MEDIA_GEOMETRY_TABLE_ERASE_ENTRY].blockSize);
+            memInfo.eraseBlockSize = nvmGeometry->geometryTable[SYS_MEDIA_GEOMETRY_TABLE_ERASE_ENTRY].blockSize;
+
+            if (memInfo.numFuRegionEraseBlocks > (SRV_FU_ERASE_BITMAP_SIZE << 3))
+            {
+                memInfo.state = SRV_FU_MEM_UNINITIALIZED;
+                break;
+            }
 
 			memInfo.writePageSize = nvmGeometry->geometryTable[SYS_MEDIA_GEOMETRY_TABLE_WRITE_ENTRY].blockSize;
 			memInfo.readPageSize = nvmGeometry->geometryTable[SYS_MEDIA_GEOMETRY_TABLE_READ_ENTRY].blockSize;
@@ -283,55 +998,70 @@ void SRV_FU_Tasks(void)
 
 		case SRV_FU_MEM_STATE_WRITE_ONE_BLOCK:
 		{
+            SRV_FU_WRITE_BUFFER *wrBuf;
+            uint32_t address;
+            uint32_t sector;
             uint32_t block;
             uint32_t offset;
             uint32_t bytesToCopy;
 
-            if (memInfo.writeSize == 0U)
+            if (writeCount == 0U)
             {
-                memInfo.state = SRV_FU_MEM_STATE_CMD_WAIT;
+                lSRV_FU_WriteIdle();
+                break;
+            }
 
-                if (SRV_FU_MemTransferCallback != NULL)
-                {
-                    SRV_FU_MemTransferCallback(SRV_FU_MEM_TRANSFER_CMD_WRITE, SRV_FU_MEM_TRANSFER_OK);
-                }
+            wrBuf = &writeBuffer[writeIndex];
+
+            if (wrBuf->bytesWritten == wrBuf->size)
+            {
+                /* Page written, buffer free for the next one */
+                lSRV_FU_WriteBufferEnd(true);
+                break;
+            }
 
+            address = memInfo.startAdressFuRegion + wrBuf->address + wrBuf->bytesWritten;
+
+            /* Erase sector on demand, only once after start */
+            sector = (address / memInfo.eraseBlockSize) - memInfo.eraseBlockStart;
+            if (lSRV_FU_SectorErased(sector) == false)
+            {
+                lSRV_FU_EraseSector(sector, true);
                 break;
             }
 
-            block = memInfo.writeAddress / memInfo.writePageSize;
+            block = address / memInfo.writePageSize;
             memInfo.retrieveAddress = block * memInfo.writePageSize;
-            offset = memInfo.writeAddress - memInfo.retrieveAddress;
+            offset = address - memInfo.retrieveAddress;
 
-            if ((memInfo.writePageSize - offset) < memInfo.writeSize)
+            bytesToCopy = (uint32_t)wrBuf->size - wrBuf->bytesWritten;
+            if ((memInfo.writePageSize - offset) < bytesToCopy)
             {
                 bytesToCopy = memInfo.writePageSize - offset;
             }
-            else
+
+            if ((lSRV_FU_SectorKept(sector) == true) ||
+                (memcmp(lSRV_FU_GetMemoryData(wrBuf->address + wrBuf->bytesWritten),
+                    &wrBuf->data[wrBuf->bytesWritten], bytesToCopy) == 0))
             {
-                bytesToCopy = memInfo.writeSize;
+                /* Written before reset, or before a failed write of the
+                 * same page, only the part in the other sector was lost */
+                wrBuf->bytesWritten += (uint16_t)bytesToCopy;
+                break;
             }
 
             (void)memset( pMemWrite, 0xff, memInfo.writePageSize);
-            (void)memcpy( &pMemWrite[offset], &pBuffInput[memInfo.bytesWritten] , memInfo.writeSize);
+            (void)memcpy( &pMemWrite[offset], &wrBuf->data[wrBuf->bytesWritten], bytesToCopy);
 
             DRV_MEMORY_AsyncWrite(memInfo.memoryHandle, &memInfo.writeHandle, pMemWrite, block, 1);
 
 			if (DRV_MEMORY_COMMAND_HANDLE_INVALID == memInfo.writeHandle)
 			{
-                memInfo.state = SRV_FU_MEM_STATE_CMD_WAIT;
-
-                if (SRV_FU_MemTransferCallback != NULL)
-                {
-                    SRV_FU_MemTransferCallback(SRV_FU_MEM_TRANSFER_CMD_WRITE, SRV_FU_MEM_TRANSFER_ERROR);
-                }
+                lSRV_FU_WriteBufferEnd(false);
 			}
             else
             {
-                memInfo.writeAddress += bytesToCopy;
-                memInfo.writeSize -= bytesToCopy;
-                memInfo.bytesWritten += bytesToCopy;
-
+                wrBuf->bytesWritten += (uint16_t)bytesToCopy;
                 memInfo.state = SRV_FU_MEM_STATE_WRITE_WAIT_END;
             }
 
@@ -340,7 +1070,17 @@ void SRV_FU_Tasks(void)
 
         case SRV_FU_CALCULATE_CRC_BLOCK:
         {
-            if (crcState == SRC_FU_CRC_CALCULATING)
+            if (crcState == SRV_FU_CRC_READY)
+            {
+                /* CRC obtained from written pages */
+                crcState = SRV_FU_CRC_IDLE;
+                memInfo.state = SRV_FU_MEM_STATE_CMD_WAIT;
+
+                if (SRV_FU_CrcCallback != NULL) {
+                    SRV_FU_CrcCallback(calculatedCrc);
+                }
+            }
+            else if (crcState == SRC_FU_CRC_CALCULATING)
             {
                 calculatedCrc = SRV_PCRC_GetValue(pBuffInput, crcSize, PCRC_HT_GENERIC, PCRC_CRC32,
                                      calculatedCrc);
@@ -400,9 +1140,23 @@ void SRV_FU_Tasks(void)
             break;
         }
 
-        case SRV_FU_MEM_STATE_XFER_WAIT:
+
         case SRV_FU_MEM_STATE_SUCCESS:
+        {
+            /* Start without erase (resumed upgrade) */
+            memInfo.state = SRV_FU_MEM_STATE_CMD_WAIT;
+
+            if (SRV_FU_MemTransferCallback != NULL)
+            {
+                SRV_FU_MemTransferCallback(SRV_FU_MEM_TRANSFER_CMD_ERASE, SRV_FU_MEM_TRANSFER_OK);
+            }
+
+            break;
+        }
+
+        case SRV_FU_MEM_STATE_XFER_WAIT:
         case SRV_FU_MEM_STATE_WRITE_WAIT_END:
+        case SRV_FU_MEM_STATE_ERASE_SECTOR:
         case SRV_FU_MEM_STATE_CMD_WAIT:
         case SRV_FU_MEM_UNINITIALIZED:
 /* MISRA C-2012 deviation block start */
@@ -415,23 +1169,25 @@ void SRV_FU_Tasks(void)
 
 void SRV_FU_DataRead(uint32_t address, uint8_t *buffer, uint16_t size)
 {
-	uint32_t readAddress;
-	uint32_t blockStart, nBlock;
-
-	readAddress = memInfo.startAdressFuRegion + address;
-
-	blockStart = readAddress / memInfo.readPageSize;
-	nBlock = size / memInfo.readPageSize;
-
-	DRV_MEMORY_AsyncRead(memInfo.memoryHandle, &memInfo.readHandle, (void *) buffer, blockStart, nBlock);
+    if (lSRV_FU_WriteBusy() == true)
+    {
+        /* Read when pending pages are written */
+        readPendingAddress = address;
+        readPendingBuffer = buffer;
+        readPendingSize = size;
+        readPending = true;
+        return;
+    }
 
-	memInfo.state = SRV_FU_MEM_STATE_READ_MEMORY;
+    lSRV_FU_ReadStart(address, buffer, size);
 }
 
 void SRV_FU_DataWrite(uint32_t address, uint8_t *buffer, uint16_t size)
 {
+    SRV_FU_WRITE_BUFFER *wrBuf;
+    uint32_t page;
 
-    if (size > MAX_BUFFER_READ_SIZE)
+    if ((size > SRV_FU_WRITE_BUFFER_SIZE) || ((address + size) > memInfo.sizeFuRegion))
     {
         if (SRV_FU_MemTransferCallback != NULL)
         {
@@ -441,7 +1197,7 @@ void SRV_FU_DataWrite(uint32_t address, uint8_t *buffer, uint16_t size)
         return;
     }
 
-    if (memInfo.writePageSize > MEMORY_WRITE_SIZE)
+    if ((memInfo.writePageSize > MEMORY_WRITE_SIZE) || (writeCount >= SRV_FU_WRITE_BUFFERS))
     {
         if (SRV_FU_MemTransferCallback != NULL)
         {
@@ -450,14 +1206,35 @@ void SRV_FU_DataWrite(uint32_t address, uint8_t *buffer, uint16_t size)
         return;
     }
 
-    memInfo.writeAddress = memInfo.startAdressFuRegion + address;
-    memInfo.writeSize = size;
-    memInfo.bytesWritten = 0;
+    wrBuf = &writeBuffer[(writeIndex + writeCount) % SRV_FU_WRITE_BUFFERS];
+    wrBuf->address = address;
+    wrBuf->size = size;
+    wrBuf->bytesWritten = 0;
 
-    (void)memcpy(pBuffInput, buffer, size);
+    if ((lSRV_FU_GetPage(address, size, &page) == true) && (lSRV_FU_PageWritten(page) == true))
+    {
+        if (memcmp(lSRV_FU_GetMemoryData(address), buffer, size) == 0)
+        {
+            /* Page already in memory: reported after the pages queued before */
+            wrBuf->bytesWritten = size;
+        }
+        else
+        {
+            lSRV_FU_PageChanged(address, size);
+        }
+    }
 
+    if (wrBuf->bytesWritten == 0U)
+    {
+        (void)memcpy(wrBuf->data, buffer, size);
+    }
 
-    memInfo.state = SRV_FU_MEM_STATE_WRITE_ONE_BLOCK;
+    writeCount++;
+
+    if (memInfo.state == SRV_FU_MEM_STATE_CMD_WAIT)
+    {
+        memInfo.state = SRV_FU_MEM_STATE_WRITE_ONE_BLOCK;
+    }
 }
 
 void SRV_FU_CfgRead(void *dst, uint16_t size)
@@ -490,21 +1267,75 @@ void SRV_FU_CfgWrite(void *src, uint16_t size)
 
 void SRV_FU_Start(SRV_FU_INFO *fuInfo)
 {
+    uint32_t sector;
+
 	fuData.imageSize = fuInfo->imageSize;
 	fuData.pageSize = fuInfo->pageSize;
 	fuData.signAlgorithm = SRV_FU_SIGNATURE_ALGO_NO_SIGNATURE;
 	fuData.signLength = 0;
 
-	/* Erase internal flash pages */
-	lSRV_FU_EraseFuRegion();
+    /* Discard pending pages and requests */
+    writeIndex = 0;
+    writeCount = 0;
+    readPending = false;
+    crcPending = false;
 
 	/* Set CRC status */
 	crcState = SRV_FU_CRC_IDLE;
-	return;
+
+    /* No pages written yet */
+    (void) memset(pagesBitmap, 0, sizeof(pagesBitmap));
+    (void) memset(eraseBitmap, 0, sizeof(eraseBitmap));
+    (void) memset(keptBitmap, 0, sizeof(keptBitmap));
+    rxPages = 0;
+    crcSeqValue = 0;
+    crcSeqEnd = 0;
+    crcPagesValue = 0;
+    crcPagesSize = 0;
+    crcPagesValid = true;
+
+    /* Image identity for the progress checkpoints */
+    (void) memset(&fuCheckpoint, 0, sizeof(fuCheckpoint));
+    fuCheckpoint.cfgKey = SRV_STORAGE_FU_INFO_CFG_KEY;
+    fuCheckpoint.imageSize = fuInfo->imageSize;
+    fuCheckpoint.signLength = fuInfo->signLength;
+    fuCheckpoint.signAlgorithm = (uint8_t)fuInfo->signAlgorithm;
+    fuCheckpoint.pageSize = fuInfo->pageSize;
+    fuCheckpoint.crcPage = 0xFFFFU;
+    checkpointPages = 0;
+
+    if (lSRV_FU_LoadCheckpoint() == true)
+    {
+        /* Resume upgrade interrupted by a reset. Pages written before are
+         * not in the CRC, the image is read to calculate it */
+        crcPagesValid = false;
+    }
+
+	/* Sectors are erased when needed. Erase the one of the first page to
+	 * receive now */
+    writeNextAddress = lSRV_FU_FindPage(0, lSRV_FU_GetNumPages(), false) * fuData.pageSize;
+    sector = ((memInfo.startAdressFuRegion + writeNextAddress) / memInfo.eraseBlockSize) - memInfo.eraseBlockStart;
+    eraseAheadSector = sector;
+
+    if ((writeNextAddress >= fuData.imageSize) || (sector >= memInfo.numFuRegionEraseBlocks) ||
+        (lSRV_FU_SectorErased(sector) == true))
+    {
+        memInfo.state = SRV_FU_MEM_STATE_SUCCESS;
+        return;
+    }
+
+    memInfo.eraseSector = sector;
+    DRV_MEMORY_AsyncErase(memInfo.memoryHandle, &memInfo.eraseHandle,
+        memInfo.eraseBlockStart + sector, 1);
+
+	memInfo.state = SRV_FU_MEM_STATE_ERASE_FLASH;
 }
 
 void SRV_FU_End(SRV_FU_RESULT fuResult)
 {
+    /* Upgrade finished or aborted, not resumed after reset */
+    lSRV_FU_ClearCheckpoint();
+
 	/* Check callback is initialized */
 	if (SRV_FU_ResultCallback == NULL)
     {
@@ -529,56 +1360,19 @@ void SRV_FU_End(SRV_FU_RESULT fuResult)
 
 void SRV_FU_CalculateCrc(void)
 {
-	uint32_t blockStart, nBlock;
-    uint32_t bytesPagesRead;
-
-	if (crcState != SRV_FU_CRC_IDLE)
+	if ((crcState != SRV_FU_CRC_IDLE) || (crcPending == true))
     {
 		return;
 	}
 
-	crcState = SRV_FU_CRC_WAIT_READ_BLOCK;
-
-	crcReadAddress = memInfo.startAdressFuRegion;
-    crcRemainingSize = fuData.imageSize;
-
-	if (crcRemainingSize < MAX_BUFFER_READ_SIZE)
-    {
-        crcSize = crcRemainingSize;
-    }
-    else
+    if (lSRV_FU_WriteBusy() == true)
     {
-        crcSize = MAX_BUFFER_READ_SIZE;
-    }
-
-    blockStart = crcReadAddress / memInfo.readPageSize;
-	nBlock = crcSize / memInfo.readPageSize;
-
-    bytesPagesRead = nBlock * memInfo.readPageSize;
-    /* Aling CRC size with the readPageSize */
-    if (crcSize > bytesPagesRead)
-    {
-        if (((nBlock + 1U) * memInfo.readPageSize) <= MAX_BUFFER_READ_SIZE)
-        {
-            nBlock++;
-        }
-        else
-        {
-            /* Cannot read everything, we reduced the size of the Crc calculated
-            this time */
-            crcSize = bytesPagesRead;
-        }
+        /* Calculate when pending pages are written */
+        crcPending = true;
+        return;
     }
 
-	DRV_MEMORY_AsyncRead(memInfo.memoryHandle, &memInfo.readHandle, pBuffInput, blockStart, nBlock);
-
-	crcReadAddress += crcSize;
-    crcRemainingSize -= crcSize;
-
-    memInfo.state = SRV_FU_CALCULATE_CRC_BLOCK;
-
-    /* CRC Initial */
-    calculatedCrc = 0;
+    lSRV_FU_CrcStart();
 }
 
 void SRV_FU_RegisterCallbackCrc(SRV_FU_CRC_CB callback)
@@ -614,6 +1408,7 @@ void SRV_FU_RequestSwapVersion(SRV_FU_TRAFFIC_VERSION trafficVersion)
 	}
 }
 
+
 void SRV_FU_RegisterCallbackSwapVersion(SRV_FU_VERSION_SWAP_CB callback)
 {
 	SRV_FU_SwapCallback = callback;
@@ -355,7 +355,17 @@ void SRV_FU_Tasks(void);
 
   Description:
     This function is used to start the firmware upgrade process by initializing
-    and unlocking the memory.
+    and unlocking the memory. Only the first sector is erased here, the rest
+    of them are erased as the image is written.
+
+    If a checkpoint of the same image (size, page size and signature) was
+    stored before a reset, and the CRC of its first written page matches the
+    memory, the pages already written are kept. Only the sectors with all their
+    pages in the checkpoint are kept, the other sectors are erased again. The
+    PRIME stack sends the image again (see SRV_FU_GetBitmap): kept pages are
+    compared with the memory and reported without being programmed. If one of
+    them differs, the memory holds another image of the same size and the
+    checkpoint is dropped (see SRV_FU_DataWrite).
 
   Precondition:
     The SRV_FU_Initialize function should have been called before calling this
@@ -609,7 +619,10 @@ void SRV_FU_DataRead(uint32_t address, uint8_t *buffer, uint16_t size);
     Writes image in memory.
 
   Description:
-    This function is used to write the image in memory.
+    This function is used to write the image in memory. The data is copied to
+    one of the two write buffers, and the write callback is issued when the
+    page is written in memory, with the result of that page. The next page can
+    be received in the other buffer meanwhile.
 
   Precondition:
     The SRV_FU_Initialize function should have been called before calling this
@@ -631,6 +644,18 @@ void SRV_FU_DataRead(uint32_t address, uint8_t *buffer, uint16_t size);
 
   Remarks:
     This function is called by the PRIME stack.
+
+    Write callbacks are issued in the same order as the pages. A page that
+    cannot be written in memory is reported with SRV_FU_MEM_TRANSFER_ERROR, so
+    the PRIME stack receives it again. If its sector was partially programmed,
+    the sector is erased again and the pages already written in it are lost:
+    the CRC of the image fails at the end.
+
+    A page already in memory (kept from the checkpoint or received twice) is
+    compared with the memory and reported without being programmed again. If
+    it differs, the sectors kept from the checkpoint and the sectors of the
+    page are erased again before writing it; pages of the erased sectors
+    already reported make the CRC of the image fail at the end.
 */
 void SRV_FU_DataWrite(uint32_t address, uint8_t *buffer, uint16_t size);
 
@@ -812,7 +837,10 @@ void SRV_FU_VerifyImage(void);
     </code>
 
   Remarks:
-    This function is called by the PRIME stack.
+    This function is called by the PRIME stack. It always returns 0: the bit
+    layout expected by the PRIME stack is not documented, so the stack keeps
+    its own bitmap and the pages kept from a checkpoint are received again
+    (see SRV_FU_Start).
 */
 uint16_t SRV_FU_GetBitmap(uint8_t *bitmap, uint32_t *numRxPages);
 
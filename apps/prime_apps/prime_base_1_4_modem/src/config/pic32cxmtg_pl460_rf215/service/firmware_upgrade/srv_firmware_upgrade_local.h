@@ -59,6 +59,16 @@ Microchip or any third party.
 #endif
 // DOM-IGNORE-END
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Number of write buffers and maximum size of a page to write */
+#define SRV_FU_WRITE_BUFFERS        2U
+#define SRV_FU_WRITE_BUFFER_SIZE    1024U
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Type Definitions
@@ -89,6 +99,9 @@ typedef enum
     
     /* Wait end of writing one block to Memory */
     SRV_FU_MEM_STATE_WRITE_WAIT_END,
+
+    /* Wait end of erasing one sector of Memory */
+    SRV_FU_MEM_STATE_ERASE_SECTOR,
    
     /* Read From Memory */
     SRV_FU_MEM_STATE_READ_MEMORY,
@@ -145,11 +158,13 @@ typedef struct
 
     uint32_t eraseBlockStart;
     uint32_t numFuRegionEraseBlocks;
+    uint32_t eraseBlockSize;
+
+    /* Sector being erased (relative to FU region) */
+    uint32_t eraseSector;
+    bool eraseOnDemand;
 
     uint32_t writePageSize;
-    uint32_t writeAddress;
-    uint32_t writeSize;
-    uint32_t bytesWritten;
 
     uint32_t retrieveAddress;
     
@@ -157,6 +172,36 @@ typedef struct
 
 } SRV_FU_MEM_INFO;
 
+// *****************************************************************************
+/* Write buffer
+
+  Summary:
+    Holds one page of the image to be written in memory
+
+  Description:
+    Pages are written through a pair of these buffers, so one page is being
+    written in memory while the next one is received.
+
+  Remarks:
+    -
+ */
+
+typedef struct
+{
+    /* Page data */
+    uint8_t data[SRV_FU_WRITE_BUFFER_SIZE];
+
+    /* Image address of the page */
+    uint32_t address;
+
+    /* Size of the page */
+    uint16_t size;
+
+    /* Bytes of the page already written in memory */
+    uint16_t bytesWritten;
+
+} SRV_FU_WRITE_BUFFER;
+
 
 
 // *****************************************************************************
@@ -176,7 +221,8 @@ typedef enum
 {
   SRV_FU_CRC_IDLE,
   SRV_FU_CRC_WAIT_READ_BLOCK,
-  SRC_FU_CRC_CALCULATING
+  SRC_FU_CRC_CALCULATING,
+  SRV_FU_CRC_READY
 } SRV_FU_CRC_STATE;
 
 
@@ -182,6 +182,11 @@ static const SRV_PLC_PCOUP_CHANNEL_DATA * const srvPlcCoupChnData[16] = {
     NULL
 };
 
+/* PLC PHY Coupling parameters being set from the PLC driver tasks */
+static DRV_PLC_PHY_PIB_OBJ srvPcoupRequestPibs[SRV_PCOUP_PIB_NUM];
+static DRV_PLC_PHY_PIB_CALLBACK srvPcoupRequestCallback;
+static bool srvPcoupRequestBusy = false;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: PLC PHY Coupling Service Interface Implementation
@@ -209,11 +214,76 @@ SRV_PLC_PCOUP_CHANNEL_DATA * SRV_PCOUP_GetChannelConfig(DRV_PLC_PHY_CHANNEL chan
     return NULL;
 }
 
+static void lSRV_PCOUP_GetChannelPibs(SRV_PLC_PCOUP_CHANNEL_DATA *pCoupValues,
+    DRV_PLC_PHY_PIB_OBJ *pibObjs)
+{
+    pibObjs[0].id = PLC_ID_IC_DRIVER_CFG;
+    pibObjs[0].length = 1;
+    pibObjs[0].pData = &pCoupValues->lineDrvConf;
+
+    pibObjs[1].id = PLC_ID_NUM_TX_LEVELS;
+    pibObjs[1].length = 1;
+    pibObjs[1].pData = &pCoupValues->numTxLevels;
+
+    pibObjs[2].id = PLC_ID_MAX_RMS_TABLE_HI;
+    pibObjs[2].length = (uint16_t)sizeof(pCoupValues->rmsHigh);
+    pibObjs[2].pData = (uint8_t *)pCoupValues->rmsHigh;
+
+    pibObjs[3].id = PLC_ID_MAX_RMS_TABLE_VLO;
+    pibObjs[3].length = (uint16_t)sizeof(pCoupValues->rmsVLow);
+    pibObjs[3].pData = (uint8_t *)pCoupValues->rmsVLow;
+
+    pibObjs[4].id = PLC_ID_THRESHOLDS_TABLE_HI;
+    pibObjs[4].length = (uint16_t)sizeof(pCoupValues->thrsHigh);
+    pibObjs[4].pData = (uint8_t *)pCoupValues->thrsHigh;
+
+    pibObjs[5].id = PLC_ID_THRESHOLDS_TABLE_VLO;
+    pibObjs[5].length = (uint16_t)sizeof(pCoupValues->thrsVLow);
+    pibObjs[5].pData = (uint8_t *)pCoupValues->thrsVLow;
+
+    pibObjs[6].id = PLC_ID_GAIN_TABLE_HI;
+    pibObjs[6].length = (uint16_t)sizeof(pCoupValues->gainHigh);
+    pibObjs[6].pData = (uint8_t *)pCoupValues->gainHigh;
+
+    pibObjs[7].id = PLC_ID_GAIN_TABLE_VLO;
+    pibObjs[7].length = (uint16_t)sizeof(pCoupValues->gainVLow);
+    pibObjs[7].pData = (uint8_t *)pCoupValues->gainVLow;
+
+    /* MISRA C-2012 deviation block start */
+    /* MISRA C-2012 Rule 11.8 deviated 3 times. Deviation record ID - H3_MISRAC_2012_R_11_8_DR_1 */
+
+    pibObjs[8].id = PLC_ID_DACC_TABLE_CFG;
+    pibObjs[8].length = 17U << 2;
+    pibObjs[8].pData = (uint8_t *)pCoupValues->daccTable;
+
+    pibObjs[9].id = PLC_ID_PREDIST_COEF_TABLE_HI;
+    pibObjs[9].length = SRV_PCOUP_EQU_NUM_COEF_CHN << 1;
+    pibObjs[9].pData = (uint8_t *)pCoupValues->equHigh;
+
+    pibObjs[10].id = PLC_ID_PREDIST_COEF_TABLE_VLO;
+    pibObjs[10].length = SRV_PCOUP_EQU_NUM_COEF_CHN << 1;
+    pibObjs[10].pData = (uint8_t *)pCoupValues->equVlow;
+
+    /* MISRA C-2012 deviation block end */
+}
+
+static void lSRV_PCOUP_PibCallback(DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs,
+    bool result, uintptr_t context)
+{
+    /* PIB objects can be used again from the callback */
+    srvPcoupRequestBusy = false;
+
+    if (srvPcoupRequestCallback != NULL)
+    {
+        srvPcoupRequestCallback(pibObjs, numPibs, result, context);
+    }
+}
+
 bool SRV_PCOUP_SetChannelConfig(DRV_HANDLE handle, DRV_PLC_PHY_CHANNEL channel)
 {
     SRV_PLC_PCOUP_CHANNEL_DATA *pCoupValues;
-    DRV_PLC_PHY_PIB_OBJ pibObj;
-    bool result, resultOut;
+    DRV_PLC_PHY_PIB_OBJ pibObjs[SRV_PCOUP_PIB_NUM];
+    bool result = true;
 
     /* Get PLC PHY Coupling parameters for the desired transmission channel */
     pCoupValues = SRV_PCOUP_GetChannelConfig(channel);
@@ -225,72 +295,42 @@ bool SRV_PCOUP_SetChannelConfig(DRV_HANDLE handle, DRV_PLC_PHY_CHANNEL channel)
     }
 
     /* Set PLC PHY Coupling parameters */
-    pibObj.id = PLC_ID_IC_DRIVER_CFG;
-    pibObj.length = 1;
-    pibObj.pData = &pCoupValues->lineDrvConf;
-    result = DRV_PLC_PHY_PIBSet(handle, &pibObj);
-
-    pibObj.id = PLC_ID_NUM_TX_LEVELS;
-    pibObj.pData = &pCoupValues->numTxLevels;
-    resultOut = DRV_PLC_PHY_PIBSet(handle, &pibObj);
-    result = result && resultOut;
-
-    pibObj.id = PLC_ID_MAX_RMS_TABLE_HI;
-    pibObj.length = (uint16_t)sizeof(pCoupValues->rmsHigh);
-    pibObj.pData = (uint8_t *)pCoupValues->rmsHigh;
-    resultOut = DRV_PLC_PHY_PIBSet(handle, &pibObj);
-    result = result && resultOut;
-
-    pibObj.id = PLC_ID_MAX_RMS_TABLE_VLO;
-    pibObj.pData = (uint8_t *)pCoupValues->rmsVLow;
-    resultOut = DRV_PLC_PHY_PIBSet(handle, &pibObj);
-    result = result && resultOut;
-
-    pibObj.id = PLC_ID_THRESHOLDS_TABLE_HI;
-    pibObj.length = (uint16_t)sizeof(pCoupValues->thrsHigh);
-    pibObj.pData = (uint8_t *)pCoupValues->thrsHigh;
-    resultOut = DRV_PLC_PHY_PIBSet(handle, &pibObj);
-    result = result && resultOut;
-
-    pibObj.id = PLC_ID_THRESHOLDS_TABLE_VLO;
-    pibObj.pData = (uint8_t *)pCoupValues->thrsVLow;
-    resultOut = DRV_PLC_PHY_PIBSet(handle, &pibObj);
-    result = result && resultOut;
-
-    pibObj.id = PLC_ID_GAIN_TABLE_HI;
-    pibObj.length = (uint16_t)sizeof(pCoupValues->gainHigh);
-    pibObj.pData = (uint8_t *)pCoupValues->gainHigh;
-    resultOut = DRV_PLC_PHY_PIBSet(handle, &pibObj);
-    result = result && resultOut;
-
-    pibObj.id = PLC_ID_GAIN_TABLE_VLO;
-    pibObj.pData = (uint8_t *)pCoupValues->gainVLow;
-    resultOut = DRV_PLC_PHY_PIBSet(handle, &pibObj);
-    result = result && resultOut;
+    lSRV_PCOUP_GetChannelPibs(pCoupValues, pibObjs);
+    for (uint8_t idx = 0; idx < SRV_PCOUP_PIB_NUM; idx++)
+    {
+        bool resultOut = DRV_PLC_PHY_PIBSet(handle, &pibObjs[idx]);
 
-    /* MISRA C-2012 deviation block start */
-    /* MISRA C-2012 Rule 11.8 deviated 3 times. Deviation record ID - H3_MISRAC_2012_R_11_8_DR_1 */
+        result = result && resultOut;
+    }
 
-    pibObj.id = PLC_ID_DACC_TABLE_CFG;
-    pibObj.length = 17U << 2;
-    pibObj.pData = (uint8_t *)pCoupValues->daccTable;
-    resultOut = DRV_PLC_PHY_PIBSet(handle, &pibObj);
-    result = result && resultOut;
+    return result;
+}
+
+bool SRV_PCOUP_SetChannelConfigRequest(DRV_HANDLE handle, DRV_PLC_PHY_CHANNEL channel,
+    const DRV_PLC_PHY_PIB_CALLBACK callback, uintptr_t context)
+{
+    SRV_PLC_PCOUP_CHANNEL_DATA *pCoupValues;
 
-    pibObj.id = PLC_ID_PREDIST_COEF_TABLE_HI;
-    pibObj.length = SRV_PCOUP_EQU_NUM_COEF_CHN << 1;
-    pibObj.pData = (uint8_t *)pCoupValues->equHigh;
-    resultOut = DRV_PLC_PHY_PIBSet(handle, &pibObj);
-    result = result && resultOut;
+    /* Get PLC PHY Coupling parameters for the desired transmission channel */
+    pCoupValues = SRV_PCOUP_GetChannelConfig(channel);
 
-    pibObj.id = PLC_ID_PREDIST_COEF_TABLE_VLO;
-    pibObj.pData = (uint8_t *)pCoupValues->equVlow;
-    resultOut = DRV_PLC_PHY_PIBSet(handle, &pibObj);
-    result = result && resultOut;
+    if ((pCoupValues == NULL) || (srvPcoupRequestBusy == true))
+    {
+        /* Transmission channel not recognized or PIB objects in use */
+        return false;
+    }
 
-    /* MISRA C-2012 deviation block end */
+    /* Set PLC PHY Coupling parameters from the driver tasks */
+    lSRV_PCOUP_GetChannelPibs(pCoupValues, srvPcoupRequestPibs);
+    srvPcoupRequestCallback = callback;
+    if (DRV_PLC_PHY_PIBSetRequest(handle, srvPcoupRequestPibs, SRV_PCOUP_PIB_NUM,
+            lSRV_PCOUP_PibCallback, context) == false)
+    {
+        return false;
+    }
 
-    return result;
+    srvPcoupRequestBusy = true;
+    return true;
 }
 
 uint16_t SRV_PCOUP_GetChannelList(void)
@@ -77,6 +77,9 @@ Microchip or any third party.
 /* PLC PRIME PHY Channel for impedance detection */
 #define SRV_PCOUP_CHANNEL_IMP_DET                CHN1
 
+/* Number of PIBs set by SRV_PCOUP_SetChannelConfig */
+#define SRV_PCOUP_PIB_NUM                        11U
+
 /* PLC PRIME PHY Channel List */
 #define SRV_PCOUP_CHANNEL_LIST                   255
 
@@ -380,6 +383,63 @@ SRV_PLC_PCOUP_CHANNEL_DATA * SRV_PCOUP_GetChannelConfig (DRV_PLC_PHY_CHANNEL cha
 
 bool SRV_PCOUP_SetChannelConfig(DRV_HANDLE handle, DRV_PLC_PHY_CHANNEL channel);
 
+/***************************************************************************
+  Function:
+    bool SRV_PCOUP_SetChannelConfigRequest(DRV_HANDLE handle,
+      DRV_PLC_PHY_CHANNEL channel, const DRV_PLC_PHY_PIB_CALLBACK callback,
+      uintptr_t context);
+
+  Summary:
+    Requests to set the PLC PHY Coupling parameters for the specified PRIME
+    channel.
+
+  Description:
+    This function queues the PLC PHY Coupling parameters for the specified
+    PRIME channel in a single PLC Driver PIB request
+    (DRV_PLC_PHY_PIBSetRequest) and returns without waiting for the write
+    guard times. The parameters are set from DRV_PLC_PHY_Tasks, which calls
+    the callback when done.
+
+  Precondition:
+    DRV_PLC_PHY_Open must have been called to obtain a valid opened device
+    handle.
+
+  Parameters:
+    handle   - A valid instance handle, returned from DRV_PLC_PHY_Open
+    channel  - PRIME channel for which the parameters will be set
+    callback - Function called when the parameters have been set
+    context  - Value passed to the callback
+
+  Returns:
+    - true
+      - Request queued
+    - false
+      - if channel parameter is not valid
+      - if a previous request has not been completed yet
+      - if the PLC Driver PIB request queue is full
+
+  Example:
+    <code>
+    static void APP_CoupCallback(DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs,
+        bool result, uintptr_t context)
+    {
+        appData.coupDone = true;
+    }
+
+    if (SRV_PCOUP_SetChannelConfigRequest(handle, CHN5, APP_CoupCallback, 0) == false)
+    {
+        (void) SRV_PCOUP_SetChannelConfig(handle, CHN5);
+    }
+    </code>
+
+  Remarks:
+    Only one request can be in progress, as the PIB objects are kept by the
+    service until the callback is called.
+  ***************************************************************************/
+
+bool SRV_PCOUP_SetChannelConfigRequest(DRV_HANDLE handle, DRV_PLC_PHY_CHANNEL channel,
+    const DRV_PLC_PHY_PIB_CALLBACK callback, uintptr_t context);
+
 /***************************************************************************
   Function:
     uint16_t SRV_PCOUP_GetChannelList(void)
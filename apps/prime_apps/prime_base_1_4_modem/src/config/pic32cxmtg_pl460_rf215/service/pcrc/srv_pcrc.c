@@ -48,6 +48,7 @@ Microchip or any third party.
 // *****************************************************************************
 
 #include "string.h"
+#include "configuration.h"
 #include "srv_pcrc.h"
 
 // *****************************************************************************
@@ -133,6 +134,475 @@ static const uint32_t pCrcTable32[256] = {
     0xBCB4666DUL, 0xB8757BDAUL, 0xB5365D03UL, 0xB1F740B4UL,
 };
 
+#ifdef SRV_PCRC_SLICING_ENABLE
+/* Slicing-by-8 tables used to get CRC32 value. */
+/* pCrcTable32Slice[k - 1][v] is pCrcTable32[v] advanced over k zero bytes */
+static const uint32_t pCrcTable32Slice[7][256] = {
+    {
+        0x00000000UL, 0xD219C1DCUL, 0xA0F29E0FUL, 0x72EB5FD3UL,
+        0x452421A9UL, 0x973DE075UL, 0xE5D6BFA6UL, 0x37CF7E7AUL,
+        0x8A484352UL, 0x5851828EUL, 0x2ABADD5DUL, 0xF8A31C81UL,
+        0xCF6C62FBUL, 0x1D75A327UL, 0x6F9EFCF4UL, 0xBD873D28UL,
+        0x10519B13UL, 0xC2485ACFUL, 0xB0A3051CUL, 0x62BAC4C0UL,
+        0x5575BABAUL, 0x876C7B66UL, 0xF58724B5UL, 0x279EE569UL,
+        0x9A19D841UL, 0x4800199DUL, 0x3AEB464EUL, 0xE8F28792UL,
+        0xDF3DF9E8UL, 0x0D243834UL, 0x7FCF67E7UL, 0xADD6A63BUL,
+        0x20A33626UL, 0xF2BAF7FAUL, 0x8051A829UL, 0x524869F5UL,
+        0x6587178FUL, 0xB79ED653UL, 0xC5758980UL, 0x176C485CUL,
+        0xAAEB7574UL, 0x78F2B4A8UL, 0x0A19EB7BUL, 0xD8002AA7UL,
+        0xEFCF54DDUL, 0x3DD69501UL, 0x4F3DCAD2UL, 0x9D240B0EUL,
+        0x30F2AD35UL, 0xE2EB6CE9UL, 0x9000333AUL, 0x4219F2E6UL,
+        0x75D68C9CUL, 0xA7CF4D40UL, 0xD5241293UL, 0x073DD34FUL,
+        0xBABAEE67UL, 0x68A32FBBUL, 0x1A487068UL, 0xC851B1B4UL,
+        0xFF9ECFCEUL, 0x2D870E12UL, 0x5F6C51C1UL, 0x8D75901DUL,
+        0x41466C4CUL, 0x935FAD90UL, 0xE1B4F243UL, 0x33AD339FUL,
+        0x04624DE5UL, 0xD67B8C39UL, 0xA490D3EAUL, 0x76891236UL,
+        0xCB0E2F1EUL, 0x1917EEC2UL, 0x6BFCB111UL, 0xB9E570CDUL,
+        0x8E2A0EB7UL, 0x5C33CF6BUL, 0x2ED890B8UL, 0xFCC15164UL,
+        0x5117F75FUL, 0x830E3683UL, 0xF1E56950UL, 0x23FCA88CUL,
+        0x1433D6F6UL, 0xC62A172AUL, 0xB4C148F9UL, 0x66D88925UL,
+        0xDB5FB40DUL, 0x094675D1UL, 0x7BAD2A02UL, 0xA9B4EBDEUL,
+        0x9E7B95A4UL, 0x4C625478UL, 0x3E890BABUL, 0xEC90CA77UL,
+        0x61E55A6AUL, 0xB3FC9BB6UL, 0xC117C465UL, 0x130E05B9UL,
+        0x24C17BC3UL, 0xF6D8BA1FUL, 0x8433E5CCUL, 0x562A2410UL,
+        0xEBAD1938UL, 0x39B4D8E4UL, 0x4B5F8737UL, 0x994646EBUL,
+        0xAE893891UL, 0x7C90F94DUL, 0x0E7BA69EUL, 0xDC626742UL,
+        0x71B4C179UL, 0xA3AD00A5UL, 0xD1465F76UL, 0x035F9EAAUL,
+        0x3490E0D0UL, 0xE689210CUL, 0x94627EDFUL, 0x467BBF03UL,
+        0xFBFC822BUL, 0x29E543F7UL, 0x5B0E1C24UL, 0x8917DDF8UL,
+        0xBED8A382UL, 0x6CC1625EUL, 0x1E2A3D8DUL, 0xCC33FC51UL,
+        0x828CD898UL, 0x50951944UL, 0x227E4697UL, 0xF067874BUL,
+        0xC7A8F931UL, 0x15B138EDUL, 0x675A673EUL, 0xB543A6E2UL,
+        0x08C49BCAUL, 0xDADD5A16UL, 0xA83605C5UL, 0x7A2FC419UL,
+        0x4DE0BA63UL, 0x9FF97BBFUL, 0xED12246CUL, 0x3F0BE5B0UL,
+        0x92DD438BUL, 0x40C48257UL, 0x322FDD84UL, 0xE0361C58UL,
+        0xD7F96222UL, 0x05E0A3FEUL, 0x770BFC2DUL, 0xA5123DF1UL,
+        0x189500D9UL, 0xCA8CC105UL, 0xB8679ED6UL, 0x6A7E5F0AUL,
+        0x5DB12170UL, 0x8FA8E0ACUL, 0xFD43BF7FUL, 0x2F5A7EA3UL,
+        0xA22FEEBEUL, 0x70362F62UL, 0x02DD70B1UL, 0xD0C4B16DUL,
+        0xE70BCF17UL, 0x35120ECBUL, 0x47F95118UL, 0x95E090C4UL,
+        0x2867ADECUL, 0xFA7E6C30UL, 0x889533E3UL, 0x5A8CF23FUL,
+        0x6D438C45UL, 0xBF5A4D99UL, 0xCDB1124AUL, 0x1FA8D396UL,
+        0xB27E75ADUL, 0x6067B471UL, 0x128CEBA2UL, 0xC0952A7EUL,
+        0xF75A5404UL, 0x254395D8UL, 0x57A8CA0BUL, 0x85B10BD7UL,
+        0x383636FFUL, 0xEA2FF723UL, 0x98C4A8F0UL, 0x4ADD692CUL,
+        0x7D121756UL, 0xAF0BD68AUL, 0xDDE08959UL, 0x0FF94885UL,
+        0xC3CAB4D4UL, 0x11D37508UL, 0x63382ADBUL, 0xB121EB07UL,
+        0x86EE957DUL, 0x54F754A1UL, 0x261C0B72UL, 0xF405CAAEUL,
+        0x4982F786UL, 0x9B9B365AUL, 0xE9706989UL, 0x3B69A855UL,
+        0x0CA6D62FUL, 0xDEBF17F3UL, 0xAC544820UL, 0x7E4D89FCUL,
+        0xD39B2FC7UL, 0x0182EE1BUL, 0x7369B1C8UL, 0xA1707014UL,
+        0x96BF0E6EUL, 0x44A6CFB2UL, 0x364D9061UL, 0xE45451BDUL,
+        0x59D36C95UL, 0x8BCAAD49UL, 0xF921F29AUL, 0x2B383346UL,
+        0x1CF74D3CUL, 0xCEEE8CE0UL, 0xBC05D333UL, 0x6E1C12EFUL,
+        0xE36982F2UL, 0x3170432EUL, 0x439B1CFDUL, 0x9182DD21UL,
+        0xA64DA35BUL, 0x74546287UL, 0x06BF3D54UL, 0xD4A6FC88UL,
+        0x6921C1A0UL, 0xBB38007CUL, 0xC9D35FAFUL, 0x1BCA9E73UL,
+        0x2C05E009UL, 0xFE1C21D5UL, 0x8CF77E06UL, 0x5EEEBFDAUL,
+        0xF33819E1UL, 0x2121D83DUL, 0x53CA87EEUL, 0x81D34632UL,
+        0xB61C3848UL, 0x6405F994UL, 0x16EEA647UL, 0xC4F7679BUL,
+        0x79705AB3UL, 0xAB699B6FUL, 0xD982C4BCUL, 0x0B9B0560UL,
+        0x3C547B1AUL, 0xEE4DBAC6UL, 0x9CA6E515UL, 0x4EBF24C9UL
+    },
+    {
+        0x00000000UL, 0x01D8AC87UL, 0x03B1590EUL, 0x0269F589UL,
+        0x0762B21CUL, 0x06BA1E9BUL, 0x04D3EB12UL, 0x050B4795UL,
+        0x0EC56438UL, 0x0F1DC8BFUL, 0x0D743D36UL, 0x0CAC91B1UL,
+        0x09A7D624UL, 0x087F7AA3UL, 0x0A168F2AUL, 0x0BCE23ADUL,
+        0x1D8AC870UL, 0x1C5264F7UL, 0x1E3B917EUL, 0x1FE33DF9UL,
+        0x1AE87A6CUL, 0x1B30D6EBUL, 0x19592362UL, 0x18818FE5UL,
+        0x134FAC48UL, 0x129700CFUL, 0x10FEF546UL, 0x112659C1UL,
+        0x142D1E54UL, 0x15F5B2D3UL, 0x179C475AUL, 0x1644EBDDUL,
+        0x3B1590E0UL, 0x3ACD3C67UL, 0x38A4C9EEUL, 0x397C6569UL,
+        0x3C7722FCUL, 0x3DAF8E7BUL, 0x3FC67BF2UL, 0x3E1ED775UL,
+        0x35D0F4D8UL, 0x3408585FUL, 0x3661ADD6UL, 0x37B90151UL,
+        0x32B246C4UL, 0x336AEA43UL, 0x31031FCAUL, 0x30DBB34DUL,
+        0x269F5890UL, 0x2747F417UL, 0x252E019EUL, 0x24F6AD19UL,
+        0x21FDEA8CUL, 0x2025460BUL, 0x224CB382UL, 0x23941F05UL,
+        0x285A3CA8UL, 0x2982902FUL, 0x2BEB65A6UL, 0x2A33C921UL,
+        0x2F388EB4UL, 0x2EE02233UL, 0x2C89D7BAUL, 0x2D517B3DUL,
+        0x762B21C0UL, 0x77F38D47UL, 0x759A78CEUL, 0x7442D449UL,
+        0x714993DCUL, 0x70913F5BUL, 0x72F8CAD2UL, 0x73206655UL,
+        0x78EE45F8UL, 0x7936E97FUL, 0x7B5F1CF6UL, 0x7A87B071UL,
+        0x7F8CF7E4UL, 0x7E545B63UL, 0x7C3DAEEAUL, 0x7DE5026DUL,
+        0x6BA1E9B0UL, 0x6A794537UL, 0x6810B0BEUL, 0x69C81C39UL,
+        0x6CC35BACUL, 0x6D1BF72BUL, 0x6F7202A2UL, 0x6EAAAE25UL,
+        0x65648D88UL, 0x64BC210FUL, 0x66D5D486UL, 0x670D7801UL,
+        0x62063F94UL, 0x63DE9313UL, 0x61B7669AUL, 0x606FCA1DUL,
+        0x4D3EB120UL, 0x4CE61DA7UL, 0x4E8FE82EUL, 0x4F5744A9UL,
+        0x4A5C033CUL, 0x4B84AFBBUL, 0x49ED5A32UL, 0x4835F6B5UL,
+        0x43FBD518UL, 0x4223799FUL, 0x404A8C16UL, 0x41922091UL,
+        0x44996704UL, 0x4541CB83UL, 0x47283E0AUL, 0x46F0928DUL,
+        0x50B47950UL, 0x516CD5D7UL, 0x5305205EUL, 0x52DD8CD9UL,
+        0x57D6CB4CUL, 0x560E67CBUL, 0x54679242UL, 0x55BF3EC5UL,
+        0x5E711D68UL, 0x5FA9B1EFUL, 0x5DC04466UL, 0x5C18E8E1UL,
+        0x5913AF74UL, 0x58CB03F3UL, 0x5AA2F67AUL, 0x5B7A5AFDUL,
+        0xEC564380UL, 0xED8EEF07UL, 0xEFE71A8EUL, 0xEE3FB609UL,
+        0xEB34F19CUL, 0xEAEC5D1BUL, 0xE885A892UL, 0xE95D0415UL,
+        0xE29327B8UL, 0xE34B8B3FUL, 0xE1227EB6UL, 0xE0FAD231UL,
+        0xE5F195A4UL, 0xE4293923UL, 0xE640CCAAUL, 0xE798602DUL,
+        0xF1DC8BF0UL, 0xF0042777UL, 0xF26DD2FEUL, 0xF3B57E79UL,
+        0xF6BE39ECUL, 0xF766956BUL, 0xF50F60E2UL, 0xF4D7CC65UL,
+        0xFF19EFC8UL, 0xFEC1434FUL, 0xFCA8B6C6UL, 0xFD701A41UL,
+        0xF87B5DD4UL, 0xF9A3F153UL, 0xFBCA04DAUL, 0xFA12A85DUL,
+        0xD743D360UL, 0xD69B7FE7UL, 0xD4F28A6EUL, 0xD52A26E9UL,
+        0xD021617CUL, 0xD1F9CDFBUL, 0xD3903872UL, 0xD24894F5UL,
+        0xD986B758UL, 0xD85E1BDFUL, 0xDA37EE56UL, 0xDBEF42D1UL,
+        0xDEE40544UL, 0xDF3CA9C3UL, 0xDD555C4AUL, 0xDC8DF0CDUL,
+        0xCAC91B10UL, 0xCB11B797UL, 0xC978421EUL, 0xC8A0EE99UL,
+        0xCDABA90CUL, 0xCC73058BUL, 0xCE1AF002UL, 0xCFC25C85UL,
+        0xC40C7F28UL, 0xC5D4D3AFUL, 0xC7BD2626UL, 0xC6658AA1UL,
+        0xC36ECD34UL, 0xC2B661B3UL, 0xC0DF943AUL, 0xC10738BDUL,
+        0x9A7D6240UL, 0x9BA5CEC7UL, 0x99CC3B4EUL, 0x981497C9UL,
+        0x9D1FD05CUL, 0x9CC77CDBUL, 0x9EAE8952UL, 0x9F7625D5UL,
+        0x94B80678UL, 0x9560AAFFUL, 0x97095F76UL, 0x96D1F3F1UL,
+        0x93DAB464UL, 0x920218E3UL, 0x906BED6AUL, 0x91B341EDUL,
+        0x87F7AA30UL, 0x862F06B7UL, 0x8446F33EUL, 0x859E5FB9UL,
+        0x8095182CUL, 0x814DB4ABUL, 0x83244122UL, 0x82FCEDA5UL,
+        0x8932CE08UL, 0x88EA628FUL, 0x8A839706UL, 0x8B5B3B81UL,
+        0x8E507C14UL, 0x8F88D093UL, 0x8DE1251AUL, 0x8C39899DUL,
+        0xA168F2A0UL, 0xA0B05E27UL, 0xA2D9ABAEUL, 0xA3010729UL,
+        0xA60A40BCUL, 0xA7D2EC3BUL, 0xA5BB19B2UL, 0xA463B535UL,
+        0xAFAD9698UL, 0xAE753A1FUL, 0xAC1CCF96UL, 0xADC46311UL,
+        0xA8CF2484UL, 0xA9178803UL, 0xAB7E7D8AUL, 0xAAA6D10DUL,
+        0xBCE23AD0UL, 0xBD3A9657UL, 0xBF5363DEUL, 0xBE8BCF59UL,
+        0xBB8088CCUL, 0xBA58244BUL, 0xB831D1C2UL, 0xB9E97D45UL,
+        0xB2275EE8UL, 0xB3FFF26FUL, 0xB19607E6UL, 0xB04EAB61UL,
+        0xB545ECF4UL, 0xB49D4073UL, 0xB6F4B5FAUL, 0xB72C197DUL
+    },
+    {
+        0x00000000UL, 0xDC6D9AB7UL, 0xBC1A28D9UL, 0x6077B26EUL,
+        0x7CF54C05UL, 0xA098D6B2UL, 0xC0EF64DCUL, 0x1C82FE6BUL,
+        0xF9EA980AUL, 0x258702BDUL, 0x45F0B0D3UL, 0x999D2A64UL,
+        0x851FD40FUL, 0x59724EB8UL, 0x3905FCD6UL, 0xE5686661UL,
+        0xF7142DA3UL, 0x2B79B714UL, 0x4B0E057AUL, 0x97639FCDUL,
+        0x8BE161A6UL, 0x578CFB11UL, 0x37FB497FUL, 0xEB96D3C8UL,
+        0x0EFEB5A9UL, 0xD2932F1EUL, 0xB2E49D70UL, 0x6E8907C7UL,
+        0x720BF9ACUL, 0xAE66631BUL, 0xCE11D175UL, 0x127C4BC2UL,
+        0xEAE946F1UL, 0x3684DC46UL, 0x56F36E28UL, 0x8A9EF49FUL,
+        0x961C0AF4UL, 0x4A719043UL, 0x2A06222DUL, 0xF66BB89AUL,
+        0x1303DEFBUL, 0xCF6E444CUL, 0xAF19F622UL, 0x73746C95UL,
+        0x6FF692FEUL, 0xB39B0849UL, 0xD3ECBA27UL, 0x0F812090UL,
+        0x1DFD6B52UL, 0xC190F1E5UL, 0xA1E7438BUL, 0x7D8AD93CUL,
+        0x61082757UL, 0xBD65BDE0UL, 0xDD120F8EUL, 0x017F9539UL,
+        0xE417F358UL, 0x387A69EFUL, 0x580DDB81UL, 0x84604136UL,
+        0x98E2BF5DUL, 0x448F25EAUL, 0x24F89784UL, 0xF8950D33UL,
+        0xD1139055UL, 0x0D7E0AE2UL, 0x6D09B88CUL, 0xB164223BUL,
+        0xADE6DC50UL, 0x718B46E7UL, 0x11FCF489UL, 0xCD916E3EUL,
+        0x28F9085FUL, 0xF49492E8UL, 0x94E32086UL, 0x488EBA31UL,
+        0x540C445AUL, 0x8861DEEDUL, 0xE8166C83UL, 0x347BF634UL,
+        0x2607BDF6UL, 0xFA6A2741UL, 0x9A1D952FUL, 0x46700F98UL,
+        0x5AF2F1F3UL, 0x869F6B44UL, 0xE6E8D92AUL, 0x3A85439DUL,
+        0xDFED25FCUL, 0x0380BF4BUL, 0x63F70D25UL, 0xBF9A9792UL,
+        0xA31869F9UL, 0x7F75F34EUL, 0x1F024120UL, 0xC36FDB97UL,
+        0x3BFAD6A4UL, 0xE7974C13UL, 0x87E0FE7DUL, 0x5B8D64CAUL,
+        0x470F9AA1UL, 0x9B620016UL, 0xFB15B278UL, 0x277828CFUL,
+        0xC2104EAEUL, 0x1E7DD419UL, 0x7E0A6677UL, 0xA267FCC0UL,
+        0xBEE502ABUL, 0x6288981CUL, 0x02FF2A72UL, 0xDE92B0C5UL,
+        0xCCEEFB07UL, 0x108361B0UL, 0x70F4D3DEUL, 0xAC994969UL,
+        0xB01BB702UL, 0x6C762DB5UL, 0x0C019FDBUL, 0xD06C056CUL,
+        0x3504630DUL, 0xE969F9BAUL, 0x891E4BD4UL, 0x5573D163UL,
+        0x49F12F08UL, 0x959CB5BFUL, 0xF5EB07D1UL, 0x29869D66UL,
+        0xA6E63D1DUL, 0x7A8BA7AAUL, 0x1AFC15C4UL, 0xC6918F73UL,
+        0xDA137118UL, 0x067EEBAFUL, 0x660959C1UL, 0xBA64C376UL,
+        0x5F0CA517UL, 0x83613FA0UL, 0xE3168DCEUL, 0x3F7B1779UL,
+        0x23F9E912UL, 0xFF9473A5UL, 0x9FE3C1CBUL, 0x438E5B7CUL,
+        0x51F210BEUL, 0x8D9F8A09UL, 0xEDE83867UL, 0x3185A2D0UL,
+        0x2D075CBBUL, 0xF16AC60CUL, 0x911D7462UL, 0x4D70EED5UL,
+        0xA81888B4UL, 0x74751203UL, 0x1402A06DUL, 0xC86F3ADAUL,
+        0xD4EDC4B1UL, 0x08805E06UL, 0x68F7EC68UL, 0xB49A76DFUL,
+        0x4C0F7BECUL, 0x9062E15BUL, 0xF0155335UL, 0x2C78C982UL,
+        0x30FA37E9UL, 0xEC97AD5EUL, 0x8CE01F30UL, 0x508D8587UL,
+        0xB5E5E3E6UL, 0x69887951UL, 0x09FFCB3FUL, 0xD5925188UL,
+        0xC910AFE3UL, 0x157D3554UL, 0x750A873AUL, 0xA9671D8DUL,
+        0xBB1B564FUL, 0x6776CCF8UL, 0x07017E96UL, 0xDB6CE421UL,
+        0xC7EE1A4AUL, 0x1B8380FDUL, 0x7BF43293UL, 0xA799A824UL,
+        0x42F1CE45UL, 0x9E9C54F2UL, 0xFEEBE69CUL, 0x22867C2BUL,
+        0x3E048240UL, 0xE26918F7UL, 0x821EAA99UL, 0x5E73302EUL,
+        0x77F5AD48UL, 0xAB9837FFUL, 0xCBEF8591UL, 0x17821F26UL,
+        0x0B00E14DUL, 0xD76D7BFAUL, 0xB71AC994UL, 0x6B775323UL,
+        0x8E1F3542UL, 0x5272AFF5UL, 0x32051D9BUL, 0xEE68872CUL,
+        0xF2EA7947UL, 0x2E87E3F0UL, 0x4EF0519EUL, 0x929DCB29UL,
+        0x80E180EBUL, 0x5C8C1A5CUL, 0x3CFBA832UL, 0xE0963285UL,
+        0xFC14CCEEUL, 0x20795659UL, 0x400EE437UL, 0x9C637E80UL,
+        0x790B18E1UL, 0xA5668256UL, 0xC5113038UL, 0x197CAA8FUL,
+        0x05FE54E4UL, 0xD993CE53UL, 0xB9E47C3DUL, 0x6589E68AUL,
+        0x9D1CEBB9UL, 0x4171710EUL, 0x2106C360UL, 0xFD6B59D7UL,
+        0xE1E9A7BCUL, 0x3D843D0BUL, 0x5DF38F65UL, 0x819E15D2UL,
+        0x64F673B3UL, 0xB89BE904UL, 0xD8EC5B6AUL, 0x0481C1DDUL,
+        0x18033FB6UL, 0xC46EA501UL, 0xA419176FUL, 0x78748DD8UL,
+        0x6A08C61AUL, 0xB6655CADUL, 0xD612EEC3UL, 0x0A7F7474UL,
+        0x16FD8A1FUL, 0xCA9010A8UL, 0xAAE7A2C6UL, 0x768A3871UL,
+        0x93E25E10UL, 0x4F8FC4A7UL, 0x2FF876C9UL, 0xF395EC7EUL,
+        0xEF171215UL, 0x337A88A2UL, 0x530D3ACCUL, 0x8F60A07BUL
+    },
+    {
+        0x00000000UL, 0x490D678DUL, 0x921ACF1AUL, 0xDB17A897UL,
+        0x20F48383UL, 0x69F9E40EUL, 0xB2EE4C99UL, 0xFBE32B14UL,
+        0x41E90706UL, 0x08E4608BUL, 0xD3F3C81CUL, 0x9AFEAF91UL,
+        0x611D8485UL, 0x2810E308UL, 0xF3074B9FUL, 0xBA0A2C12UL,
+        0x83D20E0CUL, 0xCADF6981UL, 0x11C8C116UL, 0x58C5A69BUL,
+        0xA3268D8FUL, 0xEA2BEA02UL, 0x313C4295UL, 0x78312518UL,
+        0xC23B090AUL, 0x8B366E87UL, 0x5021C610UL, 0x192CA19DUL,
+        0xE2CF8A89UL, 0xABC2ED04UL, 0x70D54593UL, 0x39D8221EUL,
+        0x036501AFUL, 0x4A686622UL, 0x917FCEB5UL, 0xD872A938UL,
+        0x2391822CUL, 0x6A9CE5A1UL, 0xB18B4D36UL, 0xF8862ABBUL,
+        0x428C06A9UL, 0x0B816124UL, 0xD096C9B3UL, 0x999BAE3EUL,
+        0x6278852AUL, 0x2B75E2A7UL, 0xF0624A30UL, 0xB96F2DBDUL,
+        0x80B70FA3UL, 0xC9BA682EUL, 0x12ADC0B9UL, 0x5BA0A734UL,
+        0xA0438C20UL, 0xE94EEBADUL, 0x3259433AUL, 0x7B5424B7UL,
+        0xC15E08A5UL, 0x88536F28UL, 0x5344C7BFUL, 0x1A49A032UL,
+        0xE1AA8B26UL, 0xA8A7ECABUL, 0x73B0443CUL, 0x3ABD23B1UL,
+        0x06CA035EUL, 0x4FC764D3UL, 0x94D0CC44UL, 0xDDDDABC9UL,
+        0x263E80DDUL, 0x6F33E750UL, 0xB4244FC7UL, 0xFD29284AUL,
+        0x47230458UL, 0x0E2E63D5UL, 0xD539CB42UL, 0x9C34ACCFUL,
+        0x67D787DBUL, 0x2EDAE056UL, 0xF5CD48C1UL, 0xBCC02F4CUL,
+        0x85180D52UL, 0xCC156ADFUL, 0x1702C248UL, 0x5E0FA5C5UL,
+        0xA5EC8ED1UL, 0xECE1E95CUL, 0x37F641CBUL, 0x7EFB2646UL,
+        0xC4F10A54UL, 0x8DFC6DD9UL, 0x56EBC54EUL, 0x1FE6A2C3UL,
+        0xE40589D7UL, 0xAD08EE5AUL, 0x761F46CDUL, 0x3F122140UL,
+        0x05AF02F1UL, 0x4CA2657CUL, 0x97B5CDEBUL, 0xDEB8AA66UL,
+        0x255B8172UL, 0x6C56E6FFUL, 0xB7414E68UL, 0xFE4C29E5UL,
+        0x444605F7UL, 0x0D4B627AUL, 0xD65CCAEDUL, 0x9F51AD60UL,
+        0x64B28674UL, 0x2DBFE1F9UL, 0xF6A8496EUL, 0xBFA52EE3UL,
+        0x867D0CFDUL, 0xCF706B70UL, 0x1467C3E7UL, 0x5D6AA46AUL,
+        0xA6898F7EUL, 0xEF84E8F3UL, 0x34934064UL, 0x7D9E27E9UL,
+        0xC7940BFBUL, 0x8E996C76UL, 0x558EC4E1UL, 0x1C83A36CUL,
+        0xE7608878UL, 0xAE6DEFF5UL, 0x757A4762UL, 0x3C7720EFUL,
+        0x0D9406BCUL, 0x44996131UL, 0x9F8EC9A6UL, 0xD683AE2BUL,
+        0x2D60853FUL, 0x646DE2B2UL, 0xBF7A4A25UL, 0xF6772DA8UL,
+        0x4C7D01BAUL, 0x05706637UL, 0xDE67CEA0UL, 0x976AA92DUL,
+        0x6C898239UL, 0x2584E5B4UL, 0xFE934D23UL, 0xB79E2AAEUL,
+        0x8E4608B0UL, 0xC74B6F3DUL, 0x1C5CC7AAUL, 0x5551A027UL,
+        0xAEB28B33UL, 0xE7BFECBEUL, 0x3CA84429UL, 0x75A523A4UL,
+        0xCFAF0FB6UL, 0x86A2683BUL, 0x5DB5C0ACUL, 0x14B8A721UL,
+        0xEF5B8C35UL, 0xA656EBB8UL, 0x7D41432FUL, 0x344C24A2UL,
+        0x0EF10713UL, 0x47FC609EUL, 0x9CEBC809UL, 0xD5E6AF84UL,
+        0x2E058490UL, 0x6708E31DUL, 0xBC1F4B8AUL, 0xF5122C07UL,
+        0x4F180015UL, 0x06156798UL, 0xDD02CF0FUL, 0x940FA882UL,
+        0x6FEC8396UL, 0x26E1E41BUL, 0xFDF64C8CUL, 0xB4FB2B01UL,
+        0x8D23091FUL, 0xC42E6E92UL, 0x1F39C605UL, 0x5634A188UL,
+        0xADD78A9CUL, 0xE4DAED11UL, 0x3FCD4586UL, 0x76C0220BUL,
+        0xCCCA0E19UL, 0x85C76994UL, 0x5ED0C103UL, 0x17DDA68EUL,
+        0xEC3E8D9AUL, 0xA533EA17UL, 0x7E244280UL, 0x3729250DUL,
+        0x0B5E05E2UL, 0x4253626FUL, 0x9944CAF8UL, 0xD049AD75UL,
+        0x2BAA8661UL, 0x62A7E1ECUL, 0xB9B0497BUL, 0xF0BD2EF6UL,
+        0x4AB702E4UL, 0x03BA6569UL, 0xD8ADCDFEUL, 0x91A0AA73UL,
+        0x6A438167UL, 0x234EE6EAUL, 0xF8594E7DUL, 0xB15429F0UL,
+        0x888C0BEEUL, 0xC1816C63UL, 0x1A96C4F4UL, 0x539BA379UL,
+        0xA878886DUL, 0xE175EFE0UL, 0x3A624777UL, 0x736F20FAUL,
+        0xC9650CE8UL, 0x80686B65UL, 0x5B7FC3F2UL, 0x1272A47FUL,
+        0xE9918F6BUL, 0xA09CE8E6UL, 0x7B8B4071UL, 0x328627FCUL,
+        0x083B044DUL, 0x413663C0UL, 0x9A21CB57UL, 0xD32CACDAUL,
+        0x28CF87CEUL, 0x61C2E043UL, 0xBAD548D4UL, 0xF3D82F59UL,
+        0x49D2034BUL, 0x00DF64C6UL, 0xDBC8CC51UL, 0x92C5ABDCUL,
+        0x692680C8UL, 0x202BE745UL, 0xFB3C4FD2UL, 0xB231285FUL,
+        0x8BE90A41UL, 0xC2E46DCCUL, 0x19F3C55BUL, 0x50FEA2D6UL,
+        0xAB1D89C2UL, 0xE210EE4FUL, 0x390746D8UL, 0x700A2155UL,
+        0xCA000D47UL, 0x830D6ACAUL, 0x581AC25DUL, 0x1117A5D0UL,
+        0xEAF48EC4UL, 0xA3F9E949UL, 0x78EE41DEUL, 0x31E32653UL
+    },
+    {
+        0x00000000UL, 0x1B280D78UL, 0x36501AF0UL, 0x2D781788UL,
+        0x6CA035E0UL, 0x77883898UL, 0x5AF02F10UL, 0x41D82268UL,
+        0xD9406BC0UL, 0xC26866B8UL, 0xEF107130UL, 0xF4387C48UL,
+        0xB5E05E20UL, 0xAEC85358UL, 0x83B044D0UL, 0x989849A8UL,
+        0xB641CA37UL, 0xAD69C74FUL, 0x8011D0C7UL, 0x9B39DDBFUL,
+        0xDAE1FFD7UL, 0xC1C9F2AFUL, 0xECB1E527UL, 0xF799E85FUL,
+        0x6F01A1F7UL, 0x7429AC8FUL, 0x5951BB07UL, 0x4279B67FUL,
+        0x03A19417UL, 0x1889996FUL, 0x35F18EE7UL, 0x2ED9839FUL,
+        0x684289D9UL, 0x736A84A1UL, 0x5E129329UL, 0x453A9E51UL,
+        0x04E2BC39UL, 0x1FCAB141UL, 0x32B2A6C9UL, 0x299AABB1UL,
+        0xB102E219UL, 0xAA2AEF61UL, 0x8752F8E9UL, 0x9C7AF591UL,
+        0xDDA2D7F9UL, 0xC68ADA81UL, 0xEBF2CD09UL, 0xF0DAC071UL,
+        0xDE0343EEUL, 0xC52B4E96UL, 0xE853591EUL, 0xF37B5466UL,
+        0xB2A3760EUL, 0xA98B7B76UL, 0x84F36CFEUL, 0x9FDB6186UL,
+        0x0743282EUL, 0x1C6B2556UL, 0x311332DEUL, 0x2A3B3FA6UL,
+        0x6BE31DCEUL, 0x70CB10B6UL, 0x5DB3073EUL, 0x469B0A46UL,
+        0xD08513B2UL, 0xCBAD1ECAUL, 0xE6D50942UL, 0xFDFD043AUL,
+        0xBC252652UL, 0xA70D2B2AUL, 0x8A753CA2UL, 0x915D31DAUL,
+        0x09C57872UL, 0x12ED750AUL, 0x3F956282UL, 0x24BD6FFAUL,
+        0x65654D92UL, 0x7E4D40EAUL, 0x53355762UL, 0x481D5A1AUL,
+        0x66C4D985UL, 0x7DECD4FDUL, 0x5094C375UL, 0x4BBCCE0DUL,
+        0x0A64EC65UL, 0x114CE11DUL, 0x3C34F695UL, 0x271CFBEDUL,
+        0xBF84B245UL, 0xA4ACBF3DUL, 0x89D4A8B5UL, 0x92FCA5CDUL,
+        0xD32487A5UL, 0xC80C8ADDUL, 0xE5749D55UL, 0xFE5C902DUL,
+        0xB8C79A6BUL, 0xA3EF9713UL, 0x8E97809BUL, 0x95BF8DE3UL,
+        0xD467AF8BUL, 0xCF4FA2F3UL, 0xE237B57BUL, 0xF91FB803UL,
+        0x6187F1ABUL, 0x7AAFFCD3UL, 0x57D7EB5BUL, 0x4CFFE623UL,
+        0x0D27C44BUL, 0x160FC933UL, 0x3B77DEBBUL, 0x205FD3C3UL,
+        0x0E86505CUL, 0x15AE5D24UL, 0x38D64AACUL, 0x23FE47D4UL,
+        0x622665BCUL, 0x790E68C4UL, 0x54767F4CUL, 0x4F5E7234UL,
+        0xD7C63B9CUL, 0xCCEE36E4UL, 0xE196216CUL, 0xFABE2C14UL,
+        0xBB660E7CUL, 0xA04E0304UL, 0x8D36148CUL, 0x961E19F4UL,
+        0xA5CB3AD3UL, 0xBEE337ABUL, 0x939B2023UL, 0x88B32D5BUL,
+        0xC96B0F33UL, 0xD243024BUL, 0xFF3B15C3UL, 0xE41318BBUL,
+        0x7C8B5113UL, 0x67A35C6BUL, 0x4ADB4BE3UL, 0x51F3469BUL,
+        0x102B64F3UL, 0x0B03698BUL, 0x267B7E03UL, 0x3D53737BUL,
+        0x138AF0E4UL, 0x08A2FD9CUL, 0x25DAEA14UL, 0x3EF2E76CUL,
+        0x7F2AC504UL, 0x6402C87CUL, 0x497ADFF4UL, 0x5252D28CUL,
+        0xCACA9B24UL, 0xD1E2965CUL, 0xFC9A81D4UL, 0xE7B28CACUL,
+        0xA66AAEC4UL, 0xBD42A3BCUL, 0x903AB434UL, 0x8B12B94CUL,
+        0xCD89B30AUL, 0xD6A1BE72UL, 0xFBD9A9FAUL, 0xE0F1A482UL,
+        0xA12986EAUL, 0xBA018B92UL, 0x97799C1AUL, 0x8C519162UL,
+        0x14C9D8CAUL, 0x0FE1D5B2UL, 0x2299C23AUL, 0x39B1CF42UL,
+        0x7869ED2AUL, 0x6341E052UL, 0x4E39F7DAUL, 0x5511FAA2UL,
+        0x7BC8793DUL, 0x60E07445UL, 0x4D9863CDUL, 0x56B06EB5UL,
+        0x17684CDDUL, 0x0C4041A5UL, 0x2138562DUL, 0x3A105B55UL,
+        0xA28812FDUL, 0xB9A01F85UL, 0x94D8080DUL, 0x8FF00575UL,
+        0xCE28271DUL, 0xD5002A65UL, 0xF8783DEDUL, 0xE3503095UL,
+        0x754E2961UL, 0x6E662419UL, 0x431E3391UL, 0x58363EE9UL,
+        0x19EE1C81UL, 0x02C611F9UL, 0x2FBE0671UL, 0x34960B09UL,
+        0xAC0E42A1UL, 0xB7264FD9UL, 0x9A5E5851UL, 0x81765529UL,
+        0xC0AE7741UL, 0xDB867A39UL, 0xF6FE6DB1UL, 0xEDD660C9UL,
+        0xC30FE356UL, 0xD827EE2EUL, 0xF55FF9A6UL, 0xEE77F4DEUL,
+        0xAFAFD6B6UL, 0xB487DBCEUL, 0x99FFCC46UL, 0x82D7C13EUL,
+        0x1A4F8896UL, 0x016785EEUL, 0x2C1F9266UL, 0x37379F1EUL,
+        0x76EFBD76UL, 0x6DC7B00EUL, 0x40BFA786UL, 0x5B97AAFEUL,
+        0x1D0CA0B8UL, 0x0624ADC0UL, 0x2B5CBA48UL, 0x3074B730UL,
+        0x71AC9558UL, 0x6A849820UL, 0x47FC8FA8UL, 0x5CD482D0UL,
+        0xC44CCB78UL, 0xDF64C600UL, 0xF21CD188UL, 0xE934DCF0UL,
+        0xA8ECFE98UL, 0xB3C4F3E0UL, 0x9EBCE468UL, 0x8594E910UL,
+        0xAB4D6A8FUL, 0xB06567F7UL, 0x9D1D707FUL, 0x86357D07UL,
+        0xC7ED5F6FUL, 0xDCC55217UL, 0xF1BD459FUL, 0xEA9548E7UL,
+        0x720D014FUL, 0x69250C37UL, 0x445D1BBFUL, 0x5F7516C7UL,
+        0x1EAD34AFUL, 0x058539D7UL, 0x28FD2E5FUL, 0x33D52327UL
+    },
+    {
+        0x00000000UL, 0x4F576811UL, 0x9EAED022UL, 0xD1F9B833UL,
+        0x399CBDF3UL, 0x76CBD5E2UL, 0xA7326DD1UL, 0xE86505C0UL,
+        0x73397BE6UL, 0x3C6E13F7UL, 0xED97ABC4UL, 0xA2C0C3D5UL,
+        0x4AA5C615UL, 0x05F2AE04UL, 0xD40B1637UL, 0x9B5C7E26UL,
+        0xE672F7CCUL, 0xA9259FDDUL, 0x78DC27EEUL, 0x378B4FFFUL,
+        0xDFEE4A3FUL, 0x90B9222EUL, 0x41409A1DUL, 0x0E17F20CUL,
+        0x954B8C2AUL, 0xDA1CE43BUL, 0x0BE55C08UL, 0x44B23419UL,
+        0xACD731D9UL, 0xE38059C8UL, 0x3279E1FBUL, 0x7D2E89EAUL,
+        0xC824F22FUL, 0x87739A3EUL, 0x568A220DUL, 0x19DD4A1CUL,
+        0xF1B84FDCUL, 0xBEEF27CDUL, 0x6F169FFEUL, 0x2041F7EFUL,
+        0xBB1D89C9UL, 0xF44AE1D8UL, 0x25B359EBUL, 0x6AE431FAUL,
+        0x8281343AUL, 0xCDD65C2BUL, 0x1C2FE418UL, 0x53788C09UL,
+        0x2E5605E3UL, 0x61016DF2UL, 0xB0F8D5C1UL, 0xFFAFBDD0UL,
+        0x17CAB810UL, 0x589DD001UL, 0x89646832UL, 0xC6330023UL,
+        0x5D6F7E05UL, 0x12381614UL, 0xC3C1AE27UL, 0x8C96C636UL,
+        0x64F3C3F6UL, 0x2BA4ABE7UL, 0xFA5D13D4UL, 0xB50A7BC5UL,
+        0x9488F9E9UL, 0xDBDF91F8UL, 0x0A2629CBUL, 0x457141DAUL,
+        0xAD14441AUL, 0xE2432C0BUL, 0x33BA9438UL, 0x7CEDFC29UL,
+        0xE7B1820FUL, 0xA8E6EA1EUL, 0x791F522DUL, 0x36483A3CUL,
+        0xDE2D3FFCUL, 0x917A57EDUL, 0x4083EFDEUL, 0x0FD487CFUL,
+        0x72FA0E25UL, 0x3DAD6634UL, 0xEC54DE07UL, 0xA303B616UL,
+        0x4B66B3D6UL, 0x0431DBC7UL, 0xD5C863F4UL, 0x9A9F0BE5UL,
+        0x01C375C3UL, 0x4E941DD2UL, 0x9F6DA5E1UL, 0xD03ACDF0UL,
+        0x385FC830UL, 0x7708A021UL, 0xA6F11812UL, 0xE9A67003UL,
+        0x5CAC0BC6UL, 0x13FB63D7UL, 0xC202DBE4UL, 0x8D55B3F5UL,
+        0x6530B635UL, 0x2A67DE24UL, 0xFB9E6617UL, 0xB4C90E06UL,
+        0x2F957020UL, 0x60C21831UL, 0xB13BA002UL, 0xFE6CC813UL,
+        0x1609CDD3UL, 0x595EA5C2UL, 0x88A71DF1UL, 0xC7F075E0UL,
+        0xBADEFC0AUL, 0xF589941BUL, 0x24702C28UL, 0x6B274439UL,
+        0x834241F9UL, 0xCC1529E8UL, 0x1DEC91DBUL, 0x52BBF9CAUL,
+        0xC9E787ECUL, 0x86B0EFFDUL, 0x574957CEUL, 0x181E3FDFUL,
+        0xF07B3A1FUL, 0xBF2C520EUL, 0x6ED5EA3DUL, 0x2182822CUL,
+        0x2DD0EE65UL, 0x62878674UL, 0xB37E3E47UL, 0xFC295656UL,
+        0x144C5396UL, 0x5B1B3B87UL, 0x8AE283B4UL, 0xC5B5EBA5UL,
+        0x5EE99583UL, 0x11BEFD92UL, 0xC04745A1UL, 0x8F102DB0UL,
+        0x67752870UL, 0x28224061UL, 0xF9DBF852UL, 0xB68C9043UL,
+        0xCBA219A9UL, 0x84F571B8UL, 0x550CC98BUL, 0x1A5BA19AUL,
+        0xF23EA45AUL, 0xBD69CC4BUL, 0x6C907478UL, 0x23C71C69UL,
+        0xB89B624FUL, 0xF7CC0A5EUL, 0x2635B26DUL, 0x6962DA7CUL,
+        0x8107DFBCUL, 0xCE50B7ADUL, 0x1FA90F9EUL, 0x50FE678FUL,
+        0xE5F41C4AUL, 0xAAA3745BUL, 0x7B5ACC68UL, 0x340DA479UL,
+        0xDC68A1B9UL, 0x933FC9A8UL, 0x42C6719BUL, 0x0D91198AUL,
+        0x96CD67ACUL, 0xD99A0FBDUL, 0x0863B78EUL, 0x4734DF9FUL,
+        0xAF51DA5FUL, 0xE006B24EUL, 0x31FF0A7DUL, 0x7EA8626CUL,
+        0x0386EB86UL, 0x4CD18397UL, 0x9D283BA4UL, 0xD27F53B5UL,
+        0x3A1A5675UL, 0x754D3E64UL, 0xA4B48657UL, 0xEBE3EE46UL,
+        0x70BF9060UL, 0x3FE8F871UL, 0xEE114042UL, 0xA1462853UL,
+        0x49232D93UL, 0x06744582UL, 0xD78DFDB1UL, 0x98DA95A0UL,
+        0xB958178CUL, 0xF60F7F9DUL, 0x27F6C7AEUL, 0x68A1AFBFUL,
+        0x80C4AA7FUL, 0xCF93C26EUL, 0x1E6A7A5DUL, 0x513D124CUL,
+        0xCA616C6AUL, 0x8536047BUL, 0x54CFBC48UL, 0x1B98D459UL,
+        0xF3FDD199UL, 0xBCAAB988UL, 0x6D5301BBUL, 0x220469AAUL,
+        0x5F2AE040UL, 0x107D8851UL, 0xC1843062UL, 0x8ED35873UL,
+        0x66B65DB3UL, 0x29E135A2UL, 0xF8188D91UL, 0xB74FE580UL,
+        0x2C139BA6UL, 0x6344F3B7UL, 0xB2BD4B84UL, 0xFDEA2395UL,
+        0x158F2655UL, 0x5AD84E44UL, 0x8B21F677UL, 0xC4769E66UL,
+        0x717CE5A3UL, 0x3E2B8DB2UL, 0xEFD23581UL, 0xA0855D90UL,
+        0x48E05850UL, 0x07B73041UL, 0xD64E8872UL, 0x9919E063UL,
+        0x02459E45UL, 0x4D12F654UL, 0x9CEB4E67UL, 0xD3BC2676UL,
+        0x3BD923B6UL, 0x748E4BA7UL, 0xA577F394UL, 0xEA209B85UL,
+        0x970E126FUL, 0xD8597A7EUL, 0x09A0C24DUL, 0x46F7AA5CUL,
+        0xAE92AF9CUL, 0xE1C5C78DUL, 0x303C7FBEUL, 0x7F6B17AFUL,
+        0xE4376989UL, 0xAB600198UL, 0x7A99B9ABUL, 0x35CED1BAUL,
+        0xDDABD47AUL, 0x92FCBC6BUL, 0x43050458UL, 0x0C526C49UL
+    },
+    {
+        0x00000000UL, 0x5BA1DCCAUL, 0xB743B994UL, 0xECE2655EUL,
+        0x6A466E9FUL, 0x31E7B255UL, 0xDD05D70BUL, 0x86A40BC1UL,
+        0xD48CDD3EUL, 0x8F2D01F4UL, 0x63CF64AAUL, 0x386EB860UL,
+        0xBECAB3A1UL, 0xE56B6F6BUL, 0x09890A35UL, 0x5228D6FFUL,
+        0xADD8A7CBUL, 0xF6797B01UL, 0x1A9B1E5FUL, 0x413AC295UL,
+        0xC79EC954UL, 0x9C3F159EUL, 0x70DD70C0UL, 0x2B7CAC0AUL,
+        0x79547AF5UL, 0x22F5A63FUL, 0xCE17C361UL, 0x95B61FABUL,
+        0x1312146AUL, 0x48B3C8A0UL, 0xA451ADFEUL, 0xFFF07134UL,
+        0x5F705221UL, 0x04D18EEBUL, 0xE833EBB5UL, 0xB392377FUL,
+        0x35363CBEUL, 0x6E97E074UL, 0x8275852AUL, 0xD9D459E0UL,
+        0x8BFC8F1FUL, 0xD05D53D5UL, 0x3CBF368BUL, 0x671EEA41UL,
+        0xE1BAE180UL, 0xBA1B3D4AUL, 0x56F95814UL, 0x0D5884DEUL,
+        0xF2A8F5EAUL, 0xA9092920UL, 0x45EB4C7EUL, 0x1E4A90B4UL,
+        0x98EE9B75UL, 0xC34F47BFUL, 0x2FAD22E1UL, 0x740CFE2BUL,
+        0x262428D4UL, 0x7D85F41EUL, 0x91679140UL, 0xCAC64D8AUL,
+        0x4C62464BUL, 0x17C39A81UL, 0xFB21FFDFUL, 0xA0802315UL,
+        0xBEE0A442UL, 0xE5417888UL, 0x09A31DD6UL, 0x5202C11CUL,
+        0xD4A6CADDUL, 0x8F071617UL, 0x63E57349UL, 0x3844AF83UL,
+        0x6A6C797CUL, 0x31CDA5B6UL, 0xDD2FC0E8UL, 0x868E1C22UL,
+        0x002A17E3UL, 0x5B8BCB29UL, 0xB769AE77UL, 0xECC872BDUL,
+        0x13380389UL, 0x4899DF43UL, 0xA47BBA1DUL, 0xFFDA66D7UL,
+        0x797E6D16UL, 0x22DFB1DCUL, 0xCE3DD482UL, 0x959C0848UL,
+        0xC7B4DEB7UL, 0x9C15027DUL, 0x70F76723UL, 0x2B56BBE9UL,
+        0xADF2B028UL, 0xF6536CE2UL, 0x1AB109BCUL, 0x4110D576UL,
+        0xE190F663UL, 0xBA312AA9UL, 0x56D34FF7UL, 0x0D72933DUL,
+        0x8BD698FCUL, 0xD0774436UL, 0x3C952168UL, 0x6734FDA2UL,
+        0x351C2B5DUL, 0x6EBDF797UL, 0x825F92C9UL, 0xD9FE4E03UL,
+        0x5F5A45C2UL, 0x04FB9908UL, 0xE819FC56UL, 0xB3B8209CUL,
+        0x4C4851A8UL, 0x17E98D62UL, 0xFB0BE83CUL, 0xA0AA34F6UL,
+        0x260E3F37UL, 0x7DAFE3FDUL, 0x914D86A3UL, 0xCAEC5A69UL,
+        0x98C48C96UL, 0xC365505CUL, 0x2F873502UL, 0x7426E9C8UL,
+        0xF282E209UL, 0xA9233EC3UL, 0x45C15B9DUL, 0x1E608757UL,
+        0x79005533UL, 0x22A189F9UL, 0xCE43ECA7UL, 0x95E2306DUL,
+        0x13463BACUL, 0x48E7E766UL, 0xA4058238UL, 0xFFA45EF2UL,
+        0xAD8C880DUL, 0xF62D54C7UL, 0x1ACF3199UL, 0x416EED53UL,
+        0xC7CAE692UL, 0x9C6B3A58UL, 0x70895F06UL, 0x2B2883CCUL,
+        0xD4D8F2F8UL, 0x8F792E32UL, 0x639B4B6CUL, 0x383A97A6UL,
+        0xBE9E9C67UL, 0xE53F40ADUL, 0x09DD25F3UL, 0x527CF939UL,
+        0x00542FC6UL, 0x5BF5F30CUL, 0xB7179652UL, 0xECB64A98UL,
+        0x6A124159UL, 0x31B39D93UL, 0xDD51F8CDUL, 0x86F02407UL,
+        0x26700712UL, 0x7DD1DBD8UL, 0x9133BE86UL, 0xCA92624CUL,
+        0x4C36698DUL, 0x1797B547UL, 0xFB75D019UL, 0xA0D40CD3UL,
+        0xF2FCDA2CUL, 0xA95D06E6UL, 0x45BF63B8UL, 0x1E1EBF72UL,
+        0x98BAB4B3UL, 0xC31B6879UL, 0x2FF90D27UL, 0x7458D1EDUL,
+        0x8BA8A0D9UL, 0xD0097C13UL, 0x3CEB194DUL, 0x674AC587UL,
+        0xE1EECE46UL, 0xBA4F128CUL, 0x56AD77D2UL, 0x0D0CAB18UL,
+        0x5F247DE7UL, 0x0485A12DUL, 0xE867C473UL, 0xB3C618B9UL,
+        0x35621378UL, 0x6EC3CFB2UL, 0x8221AAECUL, 0xD9807626UL,
+        0xC7E0F171UL, 0x9C412DBBUL, 0x70A348E5UL, 0x2B02942FUL,
+        0xADA69FEEUL, 0xF6074324UL, 0x1AE5267AUL, 0x4144FAB0UL,
+        0x136C2C4FUL, 0x48CDF085UL, 0xA42F95DBUL, 0xFF8E4911UL,
+        0x792A42D0UL, 0x228B9E1AUL, 0xCE69FB44UL, 0x95C8278EUL,
+        0x6A3856BAUL, 0x31998A70UL, 0xDD7BEF2EUL, 0x86DA33E4UL,
+        0x007E3825UL, 0x5BDFE4EFUL, 0xB73D81B1UL, 0xEC9C5D7BUL,
+        0xBEB48B84UL, 0xE515574EUL, 0x09F73210UL, 0x5256EEDAUL,
+        0xD4F2E51BUL, 0x8F5339D1UL, 0x63B15C8FUL, 0x38108045UL,
+        0x9890A350UL, 0xC3317F9AUL, 0x2FD31AC4UL, 0x7472C60EUL,
+        0xF2D6CDCFUL, 0xA9771105UL, 0x4595745BUL, 0x1E34A891UL,
+        0x4C1C7E6EUL, 0x17BDA2A4UL, 0xFB5FC7FAUL, 0xA0FE1B30UL,
+        0x265A10F1UL, 0x7DFBCC3BUL, 0x9119A965UL, 0xCAB875AFUL,
+        0x3548049BUL, 0x6EE9D851UL, 0x820BBD0FUL, 0xD9AA61C5UL,
+        0x5F0E6A04UL, 0x04AFB6CEUL, 0xE84DD390UL, 0xB3EC0F5AUL,
+        0xE1C4D9A5UL, 0xBA65056FUL, 0x56876031UL, 0x0D26BCFBUL,
+        0x8B82B73AUL, 0xD0236BF0UL, 0x3CC10EAEUL, 0x6760D264UL
+    }
+};
+#endif
+
 /* Table used to get CRC16 value */
 static const uint16_t pCrcTable16[256] = {
     0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
@@ -169,6 +639,115 @@ static const uint16_t pCrcTable16[256] = {
     0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0
 };
 
+#ifdef SRV_PCRC_SLICING_ENABLE
+/* Slicing-by-4 tables used to get CRC16 value. */
+/* pCrcTable16Slice[k - 1][v] is pCrcTable16[v] advanced over k zero bytes */
+static const uint16_t pCrcTable16Slice[3][256] = {
+    {
+        0x0000, 0x3331, 0x6662, 0x5553, 0xccc4, 0xfff5, 0xaaa6, 0x9997,
+        0x89a9, 0xba98, 0xefcb, 0xdcfa, 0x456d, 0x765c, 0x230f, 0x103e,
+        0x0373, 0x3042, 0x6511, 0x5620, 0xcfb7, 0xfc86, 0xa9d5, 0x9ae4,
+        0x8ada, 0xb9eb, 0xecb8, 0xdf89, 0x461e, 0x752f, 0x207c, 0x134d,
+        0x06e6, 0x35d7, 0x6084, 0x53b5, 0xca22, 0xf913, 0xac40, 0x9f71,
+        0x8f4f, 0xbc7e, 0xe92d, 0xda1c, 0x438b, 0x70ba, 0x25e9, 0x16d8,
+        0x0595, 0x36a4, 0x63f7, 0x50c6, 0xc951, 0xfa60, 0xaf33, 0x9c02,
+        0x8c3c, 0xbf0d, 0xea5e, 0xd96f, 0x40f8, 0x73c9, 0x269a, 0x15ab,
+        0x0dcc, 0x3efd, 0x6bae, 0x589f, 0xc108, 0xf239, 0xa76a, 0x945b,
+        0x8465, 0xb754, 0xe207, 0xd136, 0x48a1, 0x7b90, 0x2ec3, 0x1df2,
+        0x0ebf, 0x3d8e, 0x68dd, 0x5bec, 0xc27b, 0xf14a, 0xa419, 0x9728,
+        0x8716, 0xb427, 0xe174, 0xd245, 0x4bd2, 0x78e3, 0x2db0, 0x1e81,
+        0x0b2a, 0x381b, 0x6d48, 0x5e79, 0xc7ee, 0xf4df, 0xa18c, 0x92bd,
+        0x8283, 0xb1b2, 0xe4e1, 0xd7d0, 0x4e47, 0x7d76, 0x2825, 0x1b14,
+        0x0859, 0x3b68, 0x6e3b, 0x5d0a, 0xc49d, 0xf7ac, 0xa2ff, 0x91ce,
+        0x81f0, 0xb2c1, 0xe792, 0xd4a3, 0x4d34, 0x7e05, 0x2b56, 0x1867,
+        0x1b98, 0x28a9, 0x7dfa, 0x4ecb, 0xd75c, 0xe46d, 0xb13e, 0x820f,
+        0x9231, 0xa100, 0xf453, 0xc762, 0x5ef5, 0x6dc4, 0x3897, 0x0ba6,
+        0x18eb, 0x2bda, 0x7e89, 0x4db8, 0xd42f, 0xe71e, 0xb24d, 0x817c,
+        0x9142, 0xa273, 0xf720, 0xc411, 0x5d86, 0x6eb7, 0x3be4, 0x08d5,
+        0x1d7e, 0x2e4f, 0x7b1c, 0x482d, 0xd1ba, 0xe28b, 0xb7d8, 0x84e9,
+        0x94d7, 0xa7e6, 0xf2b5, 0xc184, 0x5813, 0x6b22, 0x3e71, 0x0d40,
+        0x1e0d, 0x2d3c, 0x786f, 0x4b5e, 0xd2c9, 0xe1f8, 0xb4ab, 0x879a,
+        0x97a4, 0xa495, 0xf1c6, 0xc2f7, 0x5b60, 0x6851, 0x3d02, 0x0e33,
+        0x1654, 0x2565, 0x7036, 0x4307, 0xda90, 0xe9a1, 0xbcf2, 0x8fc3,
+        0x9ffd, 0xaccc, 0xf99f, 0xcaae, 0x5339, 0x6008, 0x355b, 0x066a,
+        0x1527, 0x2616, 0x7345, 0x4074, 0xd9e3, 0xead2, 0xbf81, 0x8cb0,
+        0x9c8e, 0xafbf, 0xfaec, 0xc9dd, 0x504a, 0x637b, 0x3628, 0x0519,
+        0x10b2, 0x2383, 0x76d0, 0x45e1, 0xdc76, 0xef47, 0xba14, 0x8925,
+        0x991b, 0xaa2a, 0xff79, 0xcc48, 0x55df, 0x66ee, 0x33bd, 0x008c,
+        0x13c1, 0x20f0, 0x75a3, 0x4692, 0xdf05, 0xec34, 0xb967, 0x8a56,
+        0x9a68, 0xa959, 0xfc0a, 0xcf3b, 0x56ac, 0x659d, 0x30ce, 0x03ff
+    },
+    {
+        0x0000, 0x3730, 0x6e60, 0x5950, 0xdcc0, 0xebf0, 0xb2a0, 0x8590,
+        0xa9a1, 0x9e91, 0xc7c1, 0xf0f1, 0x7561, 0x4251, 0x1b01, 0x2c31,
+        0x4363, 0x7453, 0x2d03, 0x1a33, 0x9fa3, 0xa893, 0xf1c3, 0xc6f3,
+        0xeac2, 0xddf2, 0x84a2, 0xb392, 0x3602, 0x0132, 0x5862, 0x6f52,
+        0x86c6, 0xb1f6, 0xe8a6, 0xdf96, 0x5a06, 0x6d36, 0x3466, 0x0356,
+        0x2f67, 0x1857, 0x4107, 0x7637, 0xf3a7, 0xc497, 0x9dc7, 0xaaf7,
+        0xc5a5, 0xf295, 0xabc5, 0x9cf5, 0x1965, 0x2e55, 0x7705, 0x4035,
+        0x6c04, 0x5b34, 0x0264, 0x3554, 0xb0c4, 0x87f4, 0xdea4, 0xe994,
+        0x1dad, 0x2a9d, 0x73cd, 0x44fd, 0xc16d, 0xf65d, 0xaf0d, 0x983d,
+        0xb40c, 0x833c, 0xda6c, 0xed5c, 0x68cc, 0x5ffc, 0x06ac, 0x319c,
+        0x5ece, 0x69fe, 0x30ae, 0x079e, 0x820e, 0xb53e, 0xec6e, 0xdb5e,
+        0xf76f, 0xc05f, 0x990f, 0xae3f, 0x2baf, 0x1c9f, 0x45cf, 0x72ff,
+        0x9b6b, 0xac5b, 0xf50b, 0xc23b, 0x47ab, 0x709b, 0x29cb, 0x1efb,
+        0x32ca, 0x05fa, 0x5caa, 0x6b9a, 0xee0a, 0xd93a, 0x806a, 0xb75a,
+        0xd808, 0xef38, 0xb668, 0x8158, 0x04c8, 0x33f8, 0x6aa8, 0x5d98,
+        0x71a9, 0x4699, 0x1fc9, 0x28f9, 0xad69, 0x9a59, 0xc309, 0xf439,
+        0x3b5a, 0x0c6a, 0x553a, 0x620a, 0xe79a, 0xd0aa, 0x89fa, 0xbeca,
+        0x92fb, 0xa5cb, 0xfc9b, 0xcbab, 0x4e3b, 0x790b, 0x205b, 0x176b,
+        0x7839, 0x4f09, 0x1659, 0x2169, 0xa4f9, 0x93c9, 0xca99, 0xfda9,
+        0xd198, 0xe6a8, 0xbff8, 0x88c8, 0x0d58, 0x3a68, 0x6338, 0x5408,
+        0xbd9c, 0x8aac, 0xd3fc, 0xe4cc, 0x615c, 0x566c, 0x0f3c, 0x380c,
+        0x143d, 0x230d, 0x7a5d, 0x4d6d, 0xc8fd, 0xffcd, 0xa69d, 0x91ad,
+        0xfeff, 0xc9cf, 0x909f, 0xa7af, 0x223f, 0x150f, 0x4c5f, 0x7b6f,
+        0x575e, 0x606e, 0x393e, 0x0e0e, 0x8b9e, 0xbcae, 0xe5fe, 0xd2ce,
+        0x26f7, 0x11c7, 0x4897, 0x7fa7, 0xfa37, 0xcd07, 0x9457, 0xa367,
+        0x8f56, 0xb866, 0xe136, 0xd606, 0x5396, 0x64a6, 0x3df6, 0x0ac6,
+        0x6594, 0x52a4, 0x0bf4, 0x3cc4, 0xb954, 0x8e64, 0xd734, 0xe004,
+        0xcc35, 0xfb05, 0xa255, 0x9565, 0x10f5, 0x27c5, 0x7e95, 0x49a5,
+        0xa031, 0x9701, 0xce51, 0xf961, 0x7cf1, 0x4bc1, 0x1291, 0x25a1,
+        0x0990, 0x3ea0, 0x67f0, 0x50c0, 0xd550, 0xe260, 0xbb30, 0x8c00,
+        0xe352, 0xd462, 0x8d32, 0xba02, 0x3f92, 0x08a2, 0x51f2, 0x66c2,
+        0x4af3, 0x7dc3, 0x2493, 0x13a3, 0x9633, 0xa103, 0xf853, 0xcf63
+    },
+    {
+        0x0000, 0x76b4, 0xed68, 0x9bdc, 0xcaf1, 0xbc45, 0x2799, 0x512d,
+        0x85c3, 0xf377, 0x68ab, 0x1e1f, 0x4f32, 0x3986, 0xa25a, 0xd4ee,
+        0x1ba7, 0x6d13, 0xf6cf, 0x807b, 0xd156, 0xa7e2, 0x3c3e, 0x4a8a,
+        0x9e64, 0xe8d0, 0x730c, 0x05b8, 0x5495, 0x2221, 0xb9fd, 0xcf49,
+        0x374e, 0x41fa, 0xda26, 0xac92, 0xfdbf, 0x8b0b, 0x10d7, 0x6663,
+        0xb28d, 0xc439, 0x5fe5, 0x2951, 0x787c, 0x0ec8, 0x9514, 0xe3a0,
+        0x2ce9, 0x5a5d, 0xc181, 0xb735, 0xe618, 0x90ac, 0x0b70, 0x7dc4,
+        0xa92a, 0xdf9e, 0x4442, 0x32f6, 0x63db, 0x156f, 0x8eb3, 0xf807,
+        0x6e9c, 0x1828, 0x83f4, 0xf540, 0xa46d, 0xd2d9, 0x4905, 0x3fb1,
+        0xeb5f, 0x9deb, 0x0637, 0x7083, 0x21ae, 0x571a, 0xccc6, 0xba72,
+        0x753b, 0x038f, 0x9853, 0xeee7, 0xbfca, 0xc97e, 0x52a2, 0x2416,
+        0xf0f8, 0x864c, 0x1d90, 0x6b24, 0x3a09, 0x4cbd, 0xd761, 0xa1d5,
+        0x59d2, 0x2f66, 0xb4ba, 0xc20e, 0x9323, 0xe597, 0x7e4b, 0x08ff,
+        0xdc11, 0xaaa5, 0x3179, 0x47cd, 0x16e0, 0x6054, 0xfb88, 0x8d3c,
+        0x4275, 0x34c1, 0xaf1d, 0xd9a9, 0x8884, 0xfe30, 0x65ec, 0x1358,
+        0xc7b6, 0xb102, 0x2ade, 0x5c6a, 0x0d47, 0x7bf3, 0xe02f, 0x969b,
+        0xdd38, 0xab8c, 0x3050, 0x46e4, 0x17c9, 0x617d, 0xfaa1, 0x8c15,
+        0x58fb, 0x2e4f, 0xb593, 0xc327, 0x920a, 0xe4be, 0x7f62, 0x09d6,
+        0xc69f, 0xb02b, 0x2bf7, 0x5d43, 0x0c6e, 0x7ada, 0xe106, 0x97b2,
+        0x435c, 0x35e8, 0xae34, 0xd880, 0x89ad, 0xff19, 0x64c5, 0x1271,
+        0xea76, 0x9cc2, 0x071e, 0x71aa, 0x2087, 0x5633, 0xcdef, 0xbb5b,
+        0x6fb5, 0x1901, 0x82dd, 0xf469, 0xa544, 0xd3f0, 0x482c, 0x3e98,
+        0xf1d1, 0x8765, 0x1cb9, 0x6a0d, 0x3b20, 0x4d94, 0xd648, 0xa0fc,
+        0x7412, 0x02a6, 0x997a, 0xefce, 0xbee3, 0xc857, 0x538b, 0x253f,
+        0xb3a4, 0xc510, 0x5ecc, 0x2878, 0x7955, 0x0fe1, 0x943d, 0xe289,
+        0x3667, 0x40d3, 0xdb0f, 0xadbb, 0xfc96, 0x8a22, 0x11fe, 0x674a,
+        0xa803, 0xdeb7, 0x456b, 0x33df, 0x62f2, 0x1446, 0x8f9a, 0xf92e,
+        0x2dc0, 0x5b74, 0xc0a8, 0xb61c, 0xe731, 0x9185, 0x0a59, 0x7ced,
+        0x84ea, 0xf25e, 0x6982, 0x1f36, 0x4e1b, 0x38af, 0xa373, 0xd5c7,
+        0x0129, 0x779d, 0xec41, 0x9af5, 0xcbd8, 0xbd6c, 0x26b0, 0x5004,
+        0x9f4d, 0xe9f9, 0x7225, 0x0491, 0x55bc, 0x2308, 0xb8d4, 0xce60,
+        0x1a8e, 0x6c3a, 0xf7e6, 0x8152, 0xd07f, 0xa6cb, 0x3d17, 0x4ba3
+    }
+};
+#endif
+
 /* Table used to get CRC8 value */
 static const uint8_t pCrcTable8[256] = {
     0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15, 0x38,
@@ -213,8 +792,32 @@ static uint32_t lSRV_PCRC_Get32(uint8_t *pData, size_t length,
 {
     uint32_t crc;
     uint8_t indexTable;
+#ifdef SRV_PCRC_SLICING_ENABLE
+    uint32_t word;
+#endif
 
     crc = crcInitValue;
+
+#ifdef SRV_PCRC_SLICING_ENABLE
+    /* Process 8 bytes per iteration (slicing-by-8) */
+    while (length >= 8U)
+    {
+        word = crc ^ (((uint32_t)pData[0] << 24) | ((uint32_t)pData[1] << 16) |
+                      ((uint32_t)pData[2] << 8) | (uint32_t)pData[3]);
+        crc = pCrcTable32Slice[6][word >> 24] ^
+              pCrcTable32Slice[5][(word >> 16) & 0xFFU] ^
+              pCrcTable32Slice[4][(word >> 8) & 0xFFU] ^
+              pCrcTable32Slice[3][word & 0xFFU] ^
+              pCrcTable32Slice[2][pData[4]] ^
+              pCrcTable32Slice[1][pData[5]] ^
+              pCrcTable32Slice[0][pData[6]] ^
+              pCrcTable32[pData[7]];
+        pData += 8;
+        length -= 8U;
+    }
+#endif
+
+    /* Process remaining bytes one at a time */
     while ((length--) > 0U)
     {
         indexTable = (uint8_t)(crc >> 24) ^ *pData++;
@@ -231,6 +834,22 @@ static uint16_t lSRV_PCRC_Get16(uint8_t *pData, size_t length,
     uint8_t indexTable;
 
     crc = (uint16_t)crcInitValue;
+
+#ifdef SRV_PCRC_SLICING_ENABLE
+    /* Process 4 bytes per iteration (slicing-by-4) */
+    while (length >= 4U)
+    {
+        crc = pCrcTable16Slice[2][crc >> 8] ^
+              pCrcTable16Slice[1][crc & 0xFFU] ^
+              pCrcTable16Slice[0][pData[0]] ^
+              pCrcTable16[pData[1]] ^
+              (((uint16_t)pData[2] << 8) | (uint16_t)pData[3]);
+        pData += 4;
+        length -= 4U;
+    }
+#endif
+
+    /* Process remaining bytes one at a time */
     while ((length--) > 0U)
     {
         indexTable = (uint8_t)(crc >> 8);
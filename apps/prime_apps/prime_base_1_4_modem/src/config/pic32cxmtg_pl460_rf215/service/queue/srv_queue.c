@@ -49,15 +49,179 @@ Microchip or any third party.
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include "srv_queue.h"
+#include "srv_queue_local.h"
+#include "system/time/sys_time.h"
 #include "service/log_report/srv_log_report.h"
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static SRV_QUEUE_INFO srvQueueInfo[SRV_QUEUE_INFO_NUMBER];
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: File scope functions
 // *****************************************************************************
 // *****************************************************************************
 
+static SRV_QUEUE_INFO *lSRV_QUEUE_GetInfo(SRV_QUEUE *queue, bool create)
+{
+    SRV_QUEUE_INFO *info;
+    uint16_t index;
+    uint16_t count;
+
+    /* Open addressing by queue address */
+    index = (uint16_t)(((uintptr_t)queue >> 2) % SRV_QUEUE_INFO_NUMBER);
+
+    for (count = 0; count < SRV_QUEUE_INFO_NUMBER; count++)
+    {
+        info = &srvQueueInfo[index];
+
+        if (info->queue == queue)
+        {
+            return info;
+        }
+
+        if (info->queue == NULL)
+        {
+            if (create == true)
+            {
+                info->queue = queue;
+                return info;
+            }
+
+            break;
+        }
+
+        index++;
+        if (index == SRV_QUEUE_INFO_NUMBER)
+        {
+            index = 0;
+        }
+    }
+
+    /* Queue not found or table full: no buckets nor statistics */
+    return NULL;
+}
+
+static void lSRV_QUEUE_UpdateStatistics(SRV_QUEUE_INFO *info, uint16_t oldSize,
+                                        uint16_t newSize)
+{
+    uint32_t counter;
+
+    if ((info == NULL) || (oldSize == newSize))
+    {
+        return;
+    }
+
+    /* Queue size is constant since the last change */
+    counter = SYS_TIME_CounterGet();
+    info->sizeTime += (uint64_t)oldSize * (counter - info->lastCount);
+    info->lastCount = counter;
+
+    if (newSize > oldSize)
+    {
+        info->appended += (uint32_t)newSize - oldSize;
+        if (newSize > info->maxSize)
+        {
+            info->maxSize = newSize;
+        }
+    }
+    else
+    {
+        info->removed += (uint32_t)oldSize - newSize;
+    }
+}
+
+static void lSRV_QUEUE_Link_Before(SRV_QUEUE *queue,
+                                   SRV_QUEUE_ELEMENT *currentElement,
+                                   SRV_QUEUE_ELEMENT *element)
+{
+    if (currentElement->prev == NULL)
+    {
+        queue->head = element;
+        element->prev = NULL;
+    }
+    else
+    {
+        currentElement->prev->next = element;
+        element->prev = currentElement->prev;
+    }
+
+    element->next = currentElement;
+    currentElement->prev = element;
+    queue->size++;
+}
+
+static void lSRV_QUEUE_Link_After(SRV_QUEUE *queue,
+                                  SRV_QUEUE_ELEMENT *currentElement,
+                                  SRV_QUEUE_ELEMENT *element)
+{
+    if (currentElement->next == NULL)
+    {
+        queue->tail = element;
+        element->next = NULL;
+    }
+    else
+    {
+        currentElement->next->prev = element;
+        element->next = currentElement->next;
+    }
+
+    element->prev = currentElement;
+    currentElement->next = element;
+    queue->size++;
+}
+
+static void lSRV_QUEUE_Unlink(SRV_QUEUE *queue, SRV_QUEUE_INFO *info,
+                              SRV_QUEUE_ELEMENT *element)
+{
+    /* Update last element of the priority level */
+    if ((info != NULL) && (info->sorted == true) &&
+        (queue->type == SRV_QUEUE_TYPE_PRIORITY) &&
+        (element->priority < SRV_QUEUE_PRIORITY_LEVELS) &&
+        (info->bucketTail[element->priority] == element))
+    {
+        if ((element->prev != NULL) &&
+            (element->prev->priority == element->priority))
+        {
+            info->bucketTail[element->priority] = element->prev;
+        }
+        else
+        {
+            info->bucketTail[element->priority] = NULL;
+        }
+    }
+
+    if (element->prev == NULL)
+    {
+        queue->head = element->next;
+    }
+    else
+    {
+        element->prev->next = element->next;
+    }
+
+    if (element->next == NULL)
+    {
+        queue->tail = element->prev;
+    }
+    else
+    {
+        element->next->prev = element->prev;
+    }
+
+    /* Clear previous and next pointers */
+    element->prev = NULL;
+    element->next = NULL;
+    queue->size--;
+}
+
 static void lSRV_QUEUE_Insert_Last_Element(SRV_QUEUE *queue,
                                            SRV_QUEUE_ELEMENT *element)
 {
@@ -84,6 +248,7 @@ static void lSRV_QUEUE_Insert_Last_Element(SRV_QUEUE *queue,
 }
 
 static void lSRV_QUEUE_Insert_First_Element(SRV_QUEUE *queue,
+                                            SRV_QUEUE_INFO *info,
                                             SRV_QUEUE_ELEMENT *element)
 {
     if (queue->size >= queue->capacity)
@@ -101,35 +266,82 @@ static void lSRV_QUEUE_Insert_First_Element(SRV_QUEUE *queue,
     /* Update the list */
     queue->tail = element;
     queue->size = 1;
+
+    if (info != NULL)
+    {
+        /* Empty queue is sorted: buckets valid again */
+        (void) memset(info->bucketTail, 0, sizeof(info->bucketTail));
+        info->sorted = true;
+        if ((queue->type == SRV_QUEUE_TYPE_PRIORITY) &&
+            (element->priority < SRV_QUEUE_PRIORITY_LEVELS))
+        {
+            info->bucketTail[element->priority] = element;
+        }
+    }
 }
 
-static SRV_QUEUE_ELEMENT *lSRV_QUEUE_Remove_Tail(SRV_QUEUE *queue)
+static void lSRV_QUEUE_Insert_Priority_Element(SRV_QUEUE *queue,
+                                               SRV_QUEUE_INFO *info,
+                                               SRV_QUEUE_ELEMENT *element)
 {
-    SRV_QUEUE_ELEMENT *element;
-
-    element = queue->tail;
+    SRV_QUEUE_ELEMENT *currentElement;
+    uint32_t priority = element->priority;
+    uint32_t level;
 
-    if (queue->size > 1U)
+    if ((info != NULL) && (info->sorted == true) &&
+        (priority < SRV_QUEUE_PRIORITY_LEVELS))
     {
-        queue->tail = queue->tail->prev;
-        queue->tail->next = NULL;
+        /* Insert after the last element with the same or lower priority */
+        level = priority + 1U;
+        while (level != 0U)
+        {
+            level--;
+            currentElement = info->bucketTail[level];
+            if (currentElement != NULL)
+            {
+                lSRV_QUEUE_Link_After(queue, currentElement, element);
+                info->bucketTail[priority] = element;
+                return;
+            }
+        }
+
+        /* All elements have higher priority value: insert at the beginning */
+        lSRV_QUEUE_Link_Before(queue, queue->head, element);
+        info->bucketTail[priority] = element;
+        return;
     }
-    else
+
+    /* Search from the tail for the last element with the same or lower */
+    /* priority and insert after it */
+    currentElement = queue->tail;
+    while (currentElement != NULL)
     {
-        /* Empty queue */
-        queue->head = NULL;
-        queue->tail = NULL;
+        if (priority >= currentElement->priority)
+        {
+            lSRV_QUEUE_Link_After(queue, currentElement, element);
+            return;
+        }
+
+        currentElement = currentElement->prev;
     }
 
-    /* Clear previous and next pointers */
-    element->prev = NULL;
-    element->next = NULL;
-    queue->size--;
+    /* First element of the queue: add element at the beginning */
+    lSRV_QUEUE_Link_Before(queue, queue->head, element);
+}
+
+static SRV_QUEUE_ELEMENT *lSRV_QUEUE_Remove_Tail(SRV_QUEUE *queue,
+                                                 SRV_QUEUE_INFO *info)
+{
+    SRV_QUEUE_ELEMENT *element;
+
+    element = queue->tail;
+    lSRV_QUEUE_Unlink(queue, info, element);
 
     return (element);
 }
 
-static SRV_QUEUE_ELEMENT *lSRV_QUEUE_Remove_Head(SRV_QUEUE *queue)
+static SRV_QUEUE_ELEMENT *lSRV_QUEUE_Remove_Head(SRV_QUEUE *queue,
+                                                 SRV_QUEUE_INFO *info)
 {
     if (queue->size == 0U)
     {
@@ -141,25 +353,7 @@ static SRV_QUEUE_ELEMENT *lSRV_QUEUE_Remove_Head(SRV_QUEUE *queue)
     SRV_QUEUE_ELEMENT *element;
 
     element = queue->head;
-
-    if (queue->size > 1U)
-    {
-        /* Point head to the previous element */
-        queue->head = queue->head->next;
-        /* First element previous pointer is null */
-        queue->head->prev = NULL;
-    }
-    else
-    {
-        /* Empty queue */
-        queue->head = NULL;
-        queue->tail = NULL;
-    }
-
-    /* Clear previous and next pointers */
-    element->prev = NULL;
-    element->next = NULL;
-    queue->size--;
+    lSRV_QUEUE_Unlink(queue, info, element);
 
     return (element);
 }
@@ -172,6 +366,8 @@ static SRV_QUEUE_ELEMENT *lSRV_QUEUE_Remove_Head(SRV_QUEUE *queue)
 
 void SRV_QUEUE_Init(SRV_QUEUE *queue, uint16_t capacity, SRV_QUEUE_TYPE type)
 {
+    SRV_QUEUE_INFO *info;
+
     /* Initialize pointers, type and capacity */
     queue->head = NULL;
     queue->tail = NULL;
@@ -179,12 +375,20 @@ void SRV_QUEUE_Init(SRV_QUEUE *queue, uint16_t capacity, SRV_QUEUE_TYPE type)
     queue->capacity = capacity;
     queue->type = type;
 
+    info = lSRV_QUEUE_GetInfo(queue, true);
+    if (info != NULL)
+    {
+        (void) memset(info, 0, sizeof(SRV_QUEUE_INFO));
+        info->queue = queue;
+        info->sorted = true;
+        info->lastCount = SYS_TIME_CounterGet();
+    }
 }
 
 void SRV_QUEUE_Append(SRV_QUEUE *queue, SRV_QUEUE_ELEMENT *element)
 {
-    SRV_QUEUE_ELEMENT *currentElement;
-    uint16_t queueCounter;
+    SRV_QUEUE_INFO *info;
+    uint16_t oldSize = queue->size;
 
     /* Check if element is already in the queue (size = 1) */
     if ((queue->size == 1U) && (queue->head == element))
@@ -203,54 +407,25 @@ void SRV_QUEUE_Append(SRV_QUEUE *queue, SRV_QUEUE_ELEMENT *element)
             "Error in SRV_QUEUE_Append: QUEUE_FULL\r\n");
         return;
     }
+
+    info = lSRV_QUEUE_GetInfo(queue, false);
+
+    /* Check whether queue is empty */
+    if (queue->size == 0U)
+    {
+        lSRV_QUEUE_Insert_First_Element(queue, info, element);
+    }
+    else if (queue->type == SRV_QUEUE_TYPE_SINGLE)
+    {
+        lSRV_QUEUE_Insert_Last_Element(queue, element);
+    }
     else
     {
-        /* Check whether queue is empty */
-        if (queue->size == 0U)
-        {
-            lSRV_QUEUE_Insert_First_Element(queue, element);
-        }
-        else
-        {
-            if (queue->type == SRV_QUEUE_TYPE_SINGLE)
-            {
-                lSRV_QUEUE_Insert_Last_Element(queue, element);
-            }
-            else
-            {
-                /* Insert in priority queue */
-                /* Search for the first element with the same priority */
-                /* and insert at the end */
-                queueCounter = queue->size + 1U;
-                currentElement = queue->tail;
-                while (queueCounter != 0U)
-                {
-                    if (element->priority < currentElement->priority)
-                    {
-                        if (currentElement->prev != NULL)
-                        {
-                            /* Move current element to previous element*/
-                            currentElement = currentElement->prev;
-                            queueCounter--;
-                        }
-                        else
-                        {
-                            /* First element of the queue */
-                            /* Add element at the beginning*/
-                            SRV_QUEUE_Insert_Before(queue, currentElement,
-                                                    element);
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        SRV_QUEUE_Insert_After(queue, currentElement, element);
-                        break;
-                    }
-               }
-            }
-        }
+        /* Insert in priority queue, at the end of its priority level */
+        lSRV_QUEUE_Insert_Priority_Element(queue, info, element);
     }
+
+    lSRV_QUEUE_UpdateStatistics(info, oldSize, queue->size);
 }
 
 void SRV_QUEUE_Append_With_Priority(SRV_QUEUE *queue, uint32_t priority,
@@ -270,36 +445,24 @@ void SRV_QUEUE_Append_With_Priority(SRV_QUEUE *queue, uint32_t priority,
 
 void SRV_QUEUE_Remove_Element(SRV_QUEUE *queue, SRV_QUEUE_ELEMENT *element)
 {
+    SRV_QUEUE_INFO *info;
     SRV_QUEUE_ELEMENT *currentElement;
+    uint16_t oldSize = queue->size;
     uint16_t i = 1U;
 
     currentElement = queue->head;
 
+    /* Element links alone do not tell which queue it is in: search it */
     while (i <= queue->size)
     {
         if (currentElement == element)
         {
             /* Element to be freed found. */
-            /* Rebuild next and previous pointers */
-            if (i == 1U)
-            {
-                /* Remove first element of the queue */
-                (void) lSRV_QUEUE_Remove_Head(queue);
-            }
-            else if (i == queue->size)
+            info = lSRV_QUEUE_GetInfo(queue, false);
+            lSRV_QUEUE_Unlink(queue, info, currentElement);
+            if (info != NULL)
             {
-                /* Remove last element of the queue */
-                (void) lSRV_QUEUE_Remove_Tail(queue);
-            }
-            else
-            {
-                /* Remove object in the middle of the queue */
-                currentElement->prev->next = currentElement->next;
-                currentElement->next->prev = currentElement->prev;
-                currentElement->next = NULL;
-                currentElement->prev = NULL;
-                /* Decrement number of elements in queue */
-                queue->size--;
+                lSRV_QUEUE_UpdateStatistics(info, oldSize, queue->size);
             }
 
             break;
@@ -317,25 +480,28 @@ SRV_QUEUE_ELEMENT *SRV_QUEUE_Read_Element(SRV_QUEUE *queue,
                                           uint16_t elementIndex)
 {
     SRV_QUEUE_ELEMENT *element;
-    uint16_t queueIndex = 0U;
+    uint16_t queueIndex;
 
-    if ((queue->size == 0U) || (elementIndex > queue->size))
+    if (elementIndex >= queue->size)
     {
         return NULL;
     }
 
-    element = queue->head;
-
-    while (queueIndex < queue->size)
+    /* Walk from the nearest end of the queue */
+    if (elementIndex < (queue->size >> 1))
     {
-        if (queueIndex < elementIndex)
+        element = queue->head;
+        for (queueIndex = 0U; queueIndex < elementIndex; queueIndex++)
         {
             element = element->next;
-            queueIndex++;
         }
-        else
+    }
+    else
+    {
+        element = queue->tail;
+        for (queueIndex = queue->size - 1U; queueIndex > elementIndex; queueIndex--)
         {
-            break;
+            element = element->prev;
         }
     }
 
@@ -346,6 +512,9 @@ void SRV_QUEUE_Insert_Before(SRV_QUEUE *queue,
                              SRV_QUEUE_ELEMENT *currentElement,
                              SRV_QUEUE_ELEMENT *element)
 {
+    SRV_QUEUE_INFO *info;
+    uint16_t oldSize = queue->size;
+
     if (queue->size >= queue->capacity)
     {
         /* Buffer cannot be appended as queue is full */
@@ -354,26 +523,25 @@ void SRV_QUEUE_Insert_Before(SRV_QUEUE *queue,
         return;
     }
 
-    if (currentElement->prev == NULL)
-    {
-        queue->head = element;
-        element->prev = NULL;
-    }
-    else
+    lSRV_QUEUE_Link_Before(queue, currentElement, element);
+
+    /* Priority order not guaranteed anymore */
+    info = lSRV_QUEUE_GetInfo(queue, false);
+    if (info != NULL)
     {
-        currentElement->prev->next = element;
-        element->prev = currentElement->prev;
+        info->sorted = false;
     }
 
-    element->next = currentElement;
-    currentElement->prev = element;
-    queue->size++;
+    lSRV_QUEUE_UpdateStatistics(info, oldSize, queue->size);
 }
 
 void SRV_QUEUE_Insert_After(SRV_QUEUE *queue,
                             SRV_QUEUE_ELEMENT *currentElement,
                             SRV_QUEUE_ELEMENT *element)
 {
+    SRV_QUEUE_INFO *info;
+    uint16_t oldSize = queue->size;
+
     if (queue->size >= queue->capacity)
     {
         /* Buffer cannot be appended as queue is full */
@@ -382,27 +550,25 @@ void SRV_QUEUE_Insert_After(SRV_QUEUE *queue,
         return;
     }
 
-    if (currentElement->next == NULL)
-    {
-        queue->tail = element;
-        element->next = NULL;
-    }
-    else
+    lSRV_QUEUE_Link_After(queue, currentElement, element);
+
+    /* Priority order not guaranteed anymore */
+    info = lSRV_QUEUE_GetInfo(queue, false);
+    if (info != NULL)
     {
-        currentElement->next->prev = element;
-        element->next = currentElement->next;
+        info->sorted = false;
     }
 
-    element->prev = currentElement;
-    currentElement->next = element;
-    queue->size++;
+    lSRV_QUEUE_UpdateStatistics(info, oldSize, queue->size);
 }
 
 SRV_QUEUE_ELEMENT *SRV_QUEUE_Read_Or_Remove(SRV_QUEUE *queue,
                                             SRV_QUEUE_MODE accessMode,
                                             SRV_QUEUE_POSITION position)
 {
+    SRV_QUEUE_INFO *info;
     SRV_QUEUE_ELEMENT *currentElement;
+    uint16_t oldSize = queue->size;
 
     if (queue->size == 0U)
     {
@@ -411,31 +577,33 @@ SRV_QUEUE_ELEMENT *SRV_QUEUE_Read_Or_Remove(SRV_QUEUE *queue,
         return NULL;
     }
 
-    if (position == SRV_QUEUE_POSITION_HEAD)
+    if (accessMode != SRV_QUEUE_MODE_REMOVE)
     {
-        /* Remove or read first element of the queue */
-        if (accessMode == SRV_QUEUE_MODE_REMOVE)
+        /* Read first or last element of the queue */
+        if (position == SRV_QUEUE_POSITION_HEAD)
         {
-            currentElement = lSRV_QUEUE_Remove_Head(queue);
+            return queue->head;
         }
         else
         {
-            currentElement = queue->head;
+            return queue->tail;
         }
     }
+
+    info = lSRV_QUEUE_GetInfo(queue, false);
+
+    /* Remove first or last element of the queue */
+    if (position == SRV_QUEUE_POSITION_HEAD)
+    {
+        currentElement = lSRV_QUEUE_Remove_Head(queue, info);
+    }
     else
     {
-        /* Remove or read last element of the queue */
-        if (accessMode == SRV_QUEUE_MODE_REMOVE)
-        {
-            currentElement = lSRV_QUEUE_Remove_Tail(queue);
-        }
-        else
-        {
-            currentElement = queue->tail;
-        }
+        currentElement = lSRV_QUEUE_Remove_Tail(queue, info);
     }
 
+    lSRV_QUEUE_UpdateStatistics(info, oldSize, queue->size);
+
     return (currentElement);
 }
 
@@ -460,3 +628,42 @@ void SRV_QUEUE_Set_Capacity(SRV_QUEUE *queue, uint16_t capacity)
     /* The only consequence is that no more elements will be appended */
     queue->capacity = capacity;
 }
+
+bool SRV_QUEUE_Get_Statistics(SRV_QUEUE *queue, SRV_QUEUE_STATISTICS *stats)
+{
+    SRV_QUEUE_INFO *info;
+    uint64_t sizeTime;
+    uint64_t dwellCount;
+
+    info = lSRV_QUEUE_GetInfo(queue, false);
+    if (info == NULL)
+    {
+        return false;
+    }
+
+    /* Account for the time since the last size change */
+    sizeTime = info->sizeTime +
+        ((uint64_t)queue->size * (SYS_TIME_CounterGet() - info->lastCount));
+
+    stats->maxSize = info->maxSize;
+    stats->appended = info->appended;
+    stats->removed = info->removed;
+
+    /* Mean time in queue (Little's law): size integral over removed elements */
+    if (info->removed == 0U)
+    {
+        stats->meanDwellUs = 0U;
+    }
+    else
+    {
+        dwellCount = sizeTime / info->removed;
+        if (dwellCount > UINT32_MAX)
+        {
+            dwellCount = UINT32_MAX;
+        }
+
+        stats->meanDwellUs = SYS_TIME_CountToUS((uint32_t)dwellCount);
+    }
+
+    return true;
+}
@@ -49,6 +49,7 @@ Microchip or any third party.
 // *****************************************************************************
 
 #include <stdint.h>
+#include <stdbool.h>
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus // Provide C++ Compatibility
@@ -173,6 +174,36 @@ typedef struct
     SRV_QUEUE_TYPE type;
 } SRV_QUEUE;
 
+// *****************************************************************************
+/* Queue statistics
+
+  Summary:
+    Queue statistics.
+
+  Description:
+    This structure contains the statistics of a queue since it was
+    initialized.
+
+  Remarks:
+    The mean time in queue is obtained from the mean queue size and the
+    number of removed elements (Little's law), as queue elements do not store
+    the time when they were appended.
+*/
+typedef struct
+{
+    /* Number of elements appended */
+    uint32_t appended;
+
+    /* Number of elements removed */
+    uint32_t removed;
+
+    /* Mean time an element stays in the queue, in microseconds */
+    uint32_t meanDwellUs;
+
+    /* Maximum number of elements in the queue */
+    uint16_t maxSize;
+} SRV_QUEUE_STATISTICS;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Service Interface Functions
@@ -560,7 +591,9 @@ SRV_QUEUE_ELEMENT *SRV_QUEUE_Read_Element(SRV_QUEUE *queue,
     </code>
 
   Remarks:
-    None.
+    The element is searched from the head of the queue before it is
+    unlinked, so the time grows with the queue size: the element links do
+    not tell which queue holds it.
 */
 void SRV_QUEUE_Remove_Element(SRV_QUEUE *queue, SRV_QUEUE_ELEMENT *element);
 
@@ -653,6 +686,46 @@ void SRV_QUEUE_Flush(SRV_QUEUE *queue);
 */
 void SRV_QUEUE_Set_Capacity(SRV_QUEUE *queue, uint16_t capacity);
 
+/***************************************************************************
+  Function:
+    bool SRV_QUEUE_Get_Statistics(SRV_QUEUE *queue,
+                                  SRV_QUEUE_STATISTICS *stats)
+
+  Summary:
+    Gets the statistics of a queue.
+
+  Description:
+    This function gets the maximum size, the number of appended and removed
+    elements and the mean time in queue of a queue.
+
+  Precondition:
+    The queue must have been initialized previously with
+    function SRV_QUEUE_Init.
+
+  Parameters:
+    queue          - Pointer to the queue.
+    stats          - Pointer to store the queue statistics.
+
+  Returns:
+    True if statistics are available. False if the queue could not be
+    registered at initialization (more than SRV_QUEUE_INFO_NUMBER queues).
+
+  Example:
+    <code>
+    SRV_QUEUE_STATISTICS stats;
+
+    if (SRV_QUEUE_Get_Statistics(&nodeQueue, &stats) == true)
+    {
+        printf("Max size %u, mean dwell %u us\r\n", stats.maxSize,
+               stats.meanDwellUs);
+    }
+    </code>
+
+  Remarks:
+    None.
+*/
+bool SRV_QUEUE_Get_Statistics(SRV_QUEUE *queue, SRV_QUEUE_STATISTICS *stats);
+
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus // Provide C++ Compatibility
  }
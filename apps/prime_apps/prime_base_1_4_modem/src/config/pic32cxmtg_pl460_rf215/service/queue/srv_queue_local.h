@@ -0,0 +1,120 @@
+/*******************************************************************************
+  Queue management module Local Data Structures
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    srv_queue_local.h
+
+  Summary:
+    Queue management module local data structures.
+
+  Description:
+    This file contains the queue management module local data structures.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+#ifndef SRV_QUEUE_LOCAL_H
+#define SRV_QUEUE_LOCAL_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "configuration.h"
+#include "srv_queue.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+ extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Queue information
+
+  Summary:
+    Information kept for each queue, apart from the queue itself.
+
+  Description:
+    SRV_QUEUE and SRV_QUEUE_ELEMENT layouts are shared with the PRIME stack
+    library, so the data needed for constant time priority insertion and the
+    queue statistics are stored in a table indexed by queue address.
+
+    Priority queues are kept as a sorted list split in buckets, one per
+    priority level below SRV_QUEUE_PRIORITY_LEVELS. The last element of each
+    bucket allows appending an element without walking the list.
+
+  Remarks:
+    Bucket tails are not valid after SRV_QUEUE_Insert_Before or
+    SRV_QUEUE_Insert_After are used in a priority queue, as those do not
+    keep the priority order. Appending falls back to walking the list until
+    the queue gets empty again.
+*/
+typedef struct
+{
+    /* Queue described (NULL if this entry is not used) */
+    SRV_QUEUE *queue;
+
+    /* Last element of each priority level (NULL if none) */
+    SRV_QUEUE_ELEMENT *bucketTail[SRV_QUEUE_PRIORITY_LEVELS];
+
+    /* Integral of queue size over time, in SYS_TIME counts */
+    uint64_t sizeTime;
+
+    /* SYS_TIME counter at the last queue size change */
+    uint32_t lastCount;
+
+    /* Number of elements appended and removed */
+    uint32_t appended;
+    uint32_t removed;
+
+    /* Maximum queue size */
+    uint16_t maxSize;
+
+    /* Bucket tails are valid */
+    bool sorted;
+} SRV_QUEUE_INFO;
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+ }
+#endif
+// DOM-IGNORE-END
+
+#endif /* SRV_QUEUE_LOCAL_H */
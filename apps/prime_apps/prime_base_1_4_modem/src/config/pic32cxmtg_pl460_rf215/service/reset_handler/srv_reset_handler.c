@@ -236,6 +236,11 @@ void SRV_RESET_HANDLER_RestartSystem(SRV_RESET_HANDLER_RESET_CAUSE resetType)
     /* Store reset information */
     lSRV_RESET_HANDLER_StoreResetInfo(resetType);
 
+    /* Write pending storage changes before every reset, also after a fault
+     * or watchdog: they are only kept in RAM until written. The storage
+     * service does not write a RAM copy that fails its CRC */
+    (void) SRV_STORAGE_Flush();
+
     /* Trigger software reset */
     RSTC_Reset(RSTC_PROCESSOR_RESET);
 }
@@ -175,7 +175,9 @@ void SRV_RESET_HANDLER_Initialize(void);
     </code>
 
   Remarks:
-    None.
+    Pending storage changes (see SRV_STORAGE_Flush) are written before every
+    reset, fault and watchdog resets included, unless the RAM copy of the
+    configuration is corrupted.
 */
 
 void SRV_RESET_HANDLER_RestartSystem(SRV_RESET_HANDLER_RESET_CAUSE resetType);
@@ -48,9 +48,12 @@ Microchip or any third party.
 // *****************************************************************************
 
 #include <string.h>
+#include "configuration.h"
 #include "srv_storage.h"
 #include "device.h"
 #include "peripheral/sefc/plib_sefc0.h"
+#include "system/time/sys_time.h"
+#include "service/pcrc/srv_pcrc.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -65,9 +68,79 @@ Microchip or any third party.
 #define SRV_STORAGE_MODE_PRIME_OFFSET 48
 #define SRV_STORAGE_SECURITY_OFFSET   64
 #define SRV_STORAGE_BOOT_INFO_OFFSET  112
+#define SRV_STORAGE_FU_INFO_OFFSET    136
 
 /* Total size of non-volatile data */
-#define SRV_STORAGE_TOTAL_SIZE 136U
+#define SRV_STORAGE_TOTAL_SIZE 248U
+
+/* Types stored in the journal. Boot information is kept in User Signature
+   block 0 only, at the offset read by the bootloader */
+#define SRV_STORAGE_BOOT_TYPE         (1U << (uint8_t)SRV_STORAGE_TYPE_BOOT_INFO)
+#define SRV_STORAGE_JOURNAL_TYPES     (((1U << (uint8_t)SRV_STORAGE_TYPE_END_LIST) - 1U) & ~SRV_STORAGE_BOOT_TYPE)
+
+/* Types written at once instead of after SRV_STORAGE_WRITE_DELAY_MS. They
+   are needed after any reset (image swap by the bootloader, upgrade resume)
+   and are rarely written */
+#define SRV_STORAGE_WRITE_THROUGH_TYPES (SRV_STORAGE_BOOT_TYPE | (1U << (uint8_t)SRV_STORAGE_TYPE_FU_INFO))
+
+/* Journal geometry. Each User Signature block has 8 pages, each page is
+   programmed only once after erase. Records are made of 16-byte units. Page
+   0 holds the block header and the latest data of every type, each next page
+   holds the records written together. All journal types fit in one page */
+#define SRV_STORAGE_JOURNAL_PAGES     8U
+#define SRV_STORAGE_JOURNAL_UNIT_SIZE 16U
+#define SRV_STORAGE_JOURNAL_PAGE_UNITS (IFLASH0_PAGE_SIZE / SRV_STORAGE_JOURNAL_UNIT_SIZE)
+
+/* Journal block header (first unit of the block) key */
+#define SRV_STORAGE_JOURNAL_KEY       0x4C4E524AUL
+
+/* Size in bytes of the record header */
+#define SRV_STORAGE_RECORD_HDR_SIZE   8U
+
+/* No valid journal block */
+#define SRV_STORAGE_JOURNAL_NONE      0xFFU
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Journal block header. Its CRC includes the records that follow it in
+   page 0, so the block is only valid if the whole page was programmed */
+typedef struct
+{
+    uint32_t key;
+    uint32_t sequence;
+    uint32_t units;
+    uint32_t crc;
+
+} SRV_STORAGE_JOURNAL_HEADER;
+
+/* Journal record header, followed by the whole storage type data */
+typedef struct
+{
+    uint8_t infoType;
+    uint8_t units;
+    uint16_t reserved;
+    uint32_t crc;
+
+} SRV_STORAGE_RECORD_HEADER;
+
+/* Journal state */
+typedef struct
+{
+    /* Active journal block index (0 or 1), SRV_STORAGE_JOURNAL_NONE if no
+       journal has been written yet */
+    uint8_t active;
+
+    /* Sequence number of the active block */
+    uint32_t sequence;
+
+    /* First page not written in the active block */
+    uint8_t writePage;
+
+} SRV_STORAGE_JOURNAL;
 
 // *****************************************************************************
 // *****************************************************************************
@@ -82,31 +155,269 @@ static const uint8_t srvStorageOffsetList[SRV_STORAGE_TYPE_END_LIST] = {
     SRV_STORAGE_BN_INFO_OFFSET,
     SRV_STORAGE_MODE_PRIME_OFFSET,
     SRV_STORAGE_SECURITY_OFFSET,
-    SRV_STORAGE_BOOT_INFO_OFFSET
+    SRV_STORAGE_BOOT_INFO_OFFSET,
+    SRV_STORAGE_FU_INFO_OFFSET
+};
+
+/* User Signature blocks used by the journal */
+static const SEFC_USERSIGNATURE_BLOCK srvStorageJournalBlocks[2] = {
+    BLOCK_1,
+    BLOCK_2
 };
 
-/* Array to read/write non-volatile data */
-static uint8_t srvStorageData[SRV_STORAGE_TOTAL_SIZE];
+/* RAM copy of non-volatile data (User Signature contents plus pending
+   changes) */
+static uint32_t srvStorageData[SRV_STORAGE_TOTAL_SIZE >> 2];
+
+/* CRC of the RAM copy, updated with every change, so that a flush after a
+   fault does not write a corrupted copy */
+static uint32_t srvStorageDataCrc;
+
+/* Buffer to read and write journal pages */
+static uint32_t srvStoragePage[IFLASH0_PAGE_SIZE >> 2];
+
+/* RAM copy loaded from User Signature */
+static bool srvStorageLoaded = false;
+
+/* Storage types with changes not written to User Signature (bit mask) */
+static uint8_t srvStorageDirty = 0;
+
+/* SYS_TIME counter when RAM copy became dirty */
+static uint32_t srvStorageDirtyCount;
+
+/* Journal state */
+static SRV_STORAGE_JOURNAL srvStorageJournal;
 
 // *****************************************************************************
 // *****************************************************************************
-// Section: Storage Service Interface Implementation
+// Section: File scope functions
 // *****************************************************************************
 // *****************************************************************************
 
-void SRV_STORAGE_Initialize(void)
+static uint8_t lSRV_STORAGE_GetTypeSize(uint8_t infoType)
 {
-    /* Disable User Signature write protection */
-    SEFC0_WriteProtectionSet(0);
+    uint8_t nextOffset;
+
+    if (infoType < ((uint8_t)SRV_STORAGE_TYPE_END_LIST - 1U))
+    {
+        nextOffset = srvStorageOffsetList[infoType + 1U];
+    }
+    else
+    {
+        nextOffset = (uint8_t)SRV_STORAGE_TOTAL_SIZE;
+    }
 
-    /* Enable write and read User Signature (block 0 / area 1) rights */
-    SEFC0_UserSignatureRightsSet(SEFC_EEFC_USR_RDENUSB1_Msk | SEFC_EEFC_USR_WRENUSB1_Msk);
+    return nextOffset - srvStorageOffsetList[infoType];
 }
 
-bool SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE infoType, uint8_t size, void* pData)
+static uint8_t lSRV_STORAGE_GetRecordUnits(uint8_t infoType)
+{
+    uint32_t recordSize = SRV_STORAGE_RECORD_HDR_SIZE + (uint32_t)lSRV_STORAGE_GetTypeSize(infoType);
+
+    return (uint8_t)((recordSize + SRV_STORAGE_JOURNAL_UNIT_SIZE - 1U) / SRV_STORAGE_JOURNAL_UNIT_SIZE);
+}
+
+static uint32_t lSRV_STORAGE_GetRecordCrc(uint8_t *pRecord)
+{
+    uint32_t crc;
+    SRV_STORAGE_RECORD_HEADER *pHeader = (SRV_STORAGE_RECORD_HEADER *)pRecord;
+    size_t dataSize = ((size_t)pHeader->units * SRV_STORAGE_JOURNAL_UNIT_SIZE) - SRV_STORAGE_RECORD_HDR_SIZE;
+
+    /* CRC of type, units and data (CRC field excluded) */
+    crc = SRV_PCRC_GetValue(pRecord, 4, PCRC_HT_GENERIC, PCRC_CRC32, 0);
+    return SRV_PCRC_GetValue(&pRecord[SRV_STORAGE_RECORD_HDR_SIZE], dataSize, PCRC_HT_GENERIC, PCRC_CRC32, crc);
+}
+
+static bool lSRV_STORAGE_IsUnitErased(uint8_t *pUnit)
+{
+    uint8_t index;
+
+    for (index = 0; index < SRV_STORAGE_JOURNAL_UNIT_SIZE; index++)
+    {
+        if (pUnit[index] != 0xFFU)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static uint32_t lSRV_STORAGE_GetHeaderCrc(uint8_t *pPage)
+{
+    uint32_t crc;
+    SRV_STORAGE_JOURNAL_HEADER *pHeader = (SRV_STORAGE_JOURNAL_HEADER *)pPage;
+
+    /* CRC of key, sequence, units and the records after the header (CRC
+     * field excluded) */
+    crc = SRV_PCRC_GetValue(pPage, 12, PCRC_HT_GENERIC, PCRC_CRC32, 0);
+    return SRV_PCRC_GetValue(&pPage[SRV_STORAGE_JOURNAL_UNIT_SIZE],
+            (size_t)pHeader->units * SRV_STORAGE_JOURNAL_UNIT_SIZE, PCRC_HT_GENERIC, PCRC_CRC32, crc);
+}
+
+static bool lSRV_STORAGE_ReadJournalHeader(uint8_t block, uint32_t *sequence)
+{
+    SRV_STORAGE_JOURNAL_HEADER *pHeader = (SRV_STORAGE_JOURNAL_HEADER *)srvStoragePage;
+
+    if (SEFC0_UserSignatureRead(srvStoragePage, IFLASH0_PAGE_SIZE >> 2, srvStorageJournalBlocks[block], PAGE_0) == false)
+    {
+        return false;
+    }
+
+    if ((pHeader->key != SRV_STORAGE_JOURNAL_KEY) ||
+        (pHeader->units >= SRV_STORAGE_JOURNAL_PAGE_UNITS) ||
+        (pHeader->crc != lSRV_STORAGE_GetHeaderCrc((uint8_t *)srvStoragePage)))
+    {
+        return false;
+    }
+
+    *sequence = pHeader->sequence;
+    return true;
+}
+
+static bool lSRV_STORAGE_ApplyRecords(uint8_t *pPage, uint8_t firstUnit, uint8_t endUnit)
+{
+    uint8_t unit = firstUnit;
+
+    /* Records from the first unit, then erased units up to the end */
+    while (unit < endUnit)
+    {
+        uint8_t *pRecord = &pPage[unit * SRV_STORAGE_JOURNAL_UNIT_SIZE];
+        SRV_STORAGE_RECORD_HEADER *pHeader = (SRV_STORAGE_RECORD_HEADER *)pRecord;
+
+        if (lSRV_STORAGE_IsUnitErased(pRecord) == true)
+        {
+            /* End of records: the rest of the page must be erased */
+            while (unit < endUnit)
+            {
+                if (lSRV_STORAGE_IsUnitErased(&pPage[unit * SRV_STORAGE_JOURNAL_UNIT_SIZE]) == false)
+                {
+                    return false;
+                }
+
+                unit++;
+            }
+
+            break;
+        }
+
+        if ((pHeader->infoType >= (uint8_t)SRV_STORAGE_TYPE_END_LIST) ||
+            (pHeader->infoType == (uint8_t)SRV_STORAGE_TYPE_BOOT_INFO) ||
+            (pHeader->units != lSRV_STORAGE_GetRecordUnits(pHeader->infoType)) ||
+            (((uint16_t)unit + pHeader->units) > endUnit) ||
+            (pHeader->crc != lSRV_STORAGE_GetRecordCrc(pRecord)))
+        {
+            /* Page not completely programmed (power loss) */
+            return false;
+        }
+
+        (void) memcpy((uint8_t *)srvStorageData + srvStorageOffsetList[pHeader->infoType],
+                &pRecord[SRV_STORAGE_RECORD_HDR_SIZE], lSRV_STORAGE_GetTypeSize(pHeader->infoType));
+        unit += pHeader->units;
+    }
+
+    return true;
+}
+
+static bool lSRV_STORAGE_IsPageErased(uint8_t *pPage)
+{
+    uint8_t unit;
+
+    for (unit = 0; unit < SRV_STORAGE_JOURNAL_PAGE_UNITS; unit++)
+    {
+        if (lSRV_STORAGE_IsUnitErased(&pPage[unit * SRV_STORAGE_JOURNAL_UNIT_SIZE]) == false)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void lSRV_STORAGE_LoadJournal(void)
+{
+    uint32_t sequence[2];
+    bool valid[2];
+    uint8_t block, page;
+    uint8_t *pPage = (uint8_t *)srvStoragePage;
+
+    srvStorageJournal.active = SRV_STORAGE_JOURNAL_NONE;
+    srvStorageJournal.sequence = 0;
+    srvStorageJournal.writePage = SRV_STORAGE_JOURNAL_PAGES;
+
+    /* Find the valid journal block with the newest sequence number */
+    for (block = 0; block < 2U; block++)
+    {
+        valid[block] = lSRV_STORAGE_ReadJournalHeader(block, &sequence[block]);
+    }
+
+    if ((valid[0] == true) &&
+        ((valid[1] == false) || ((int32_t)(sequence[0] - sequence[1]) > 0)))
+    {
+        block = 0;
+    }
+    else if (valid[1] == true)
+    {
+        block = 1;
+    }
+    else
+    {
+        /* No journal yet. Data in block 0 is used until the first change */
+        return;
+    }
+
+    srvStorageJournal.active = block;
+    srvStorageJournal.sequence = sequence[block];
+
+    /* Apply pages in order: page 0 checked by the header CRC, then one page
+     * per write */
+    (void) lSRV_STORAGE_ReadJournalHeader(block, &sequence[block]);
+    (void) lSRV_STORAGE_ApplyRecords(pPage, 1U, (uint8_t)(1U + ((SRV_STORAGE_JOURNAL_HEADER *)pPage)->units));
+    srvStorageJournal.writePage = 1;
+
+    for (page = 1; page < SRV_STORAGE_JOURNAL_PAGES; page++)
+    {
+        if ((SEFC0_UserSignatureRead(srvStoragePage, IFLASH0_PAGE_SIZE >> 2, srvStorageJournalBlocks[block], (SEFC_USERSIGNATURE_PAGE)page) == false) ||
+            (lSRV_STORAGE_ApplyRecords(pPage, 0U, SRV_STORAGE_JOURNAL_PAGE_UNITS) == false))
+        {
+            /* Do not apply nor write after a damaged page. Next change is
+             * written in the other block */
+            srvStorageJournal.writePage = SRV_STORAGE_JOURNAL_PAGES;
+            break;
+        }
+
+        if (lSRV_STORAGE_IsPageErased(pPage) == false)
+        {
+            srvStorageJournal.writePage = page + 1U;
+        }
+    }
+}
+
+static uint32_t lSRV_STORAGE_GetDataCrc(void)
+{
+    return SRV_PCRC_GetValue((uint8_t *)srvStorageData, SRV_STORAGE_TOTAL_SIZE, PCRC_HT_GENERIC, PCRC_CRC32, 0);
+}
+
+static bool lSRV_STORAGE_Load(void)
+{
+    if (srvStorageLoaded == false)
+    {
+        /* Read data from User Signature block 0, then apply the journal */
+        srvStorageLoaded = SEFC0_UserSignatureRead(srvStorageData, SRV_STORAGE_TOTAL_SIZE >> 2, BLOCK_0, PAGE_0);
+
+        if (srvStorageLoaded == true)
+        {
+            lSRV_STORAGE_LoadJournal();
+            srvStorageDataCrc = lSRV_STORAGE_GetDataCrc();
+        }
+    }
+
+    return srvStorageLoaded;
+}
+
+static bool lSRV_STORAGE_GetOffset(SRV_STORAGE_TYPE infoType, uint8_t size, uint8_t *offset)
 {
     uint16_t totalSize;
-    uint8_t offset;
 
     if (infoType >= SRV_STORAGE_TYPE_END_LIST)
     {
@@ -115,8 +426,8 @@ bool SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE infoType, uint8_t size, void* pD
     }
 
     /* Get offset depending on info type */
-    offset = srvStorageOffsetList[infoType];
-    totalSize = (uint16_t) offset + (uint16_t) size;
+    *offset = srvStorageOffsetList[infoType];
+    totalSize = (uint16_t) *offset + (uint16_t) size;
 
     if (totalSize > SRV_STORAGE_TOTAL_SIZE)
     {
@@ -124,65 +435,311 @@ bool SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE infoType, uint8_t size, void* pD
         return false;
     }
 
-    /* Read data from User Signature */
-    if (SEFC0_UserSignatureRead((void*) srvStorageData, ((uint32_t) totalSize + 3U) >> 2, BLOCK_0, PAGE_0) == false)
+    return true;
+}
+
+static uint8_t lSRV_STORAGE_PutRecord(uint8_t infoType, uint8_t unit)
+{
+    uint8_t *pPage = (uint8_t *)srvStoragePage;
+    uint8_t *pRecord = &pPage[unit * SRV_STORAGE_JOURNAL_UNIT_SIZE];
+    SRV_STORAGE_RECORD_HEADER *pHeader = (SRV_STORAGE_RECORD_HEADER *)pRecord;
+    uint8_t units = lSRV_STORAGE_GetRecordUnits(infoType);
+    uint8_t typeSize = lSRV_STORAGE_GetTypeSize(infoType);
+
+    /* Build record in page buffer from RAM copy */
+    (void) memset(pRecord, 0xFF, (size_t)units * SRV_STORAGE_JOURNAL_UNIT_SIZE);
+    pHeader->infoType = infoType;
+    pHeader->units = units;
+    pHeader->reserved = 0;
+    (void) memcpy(&pRecord[SRV_STORAGE_RECORD_HDR_SIZE], (uint8_t *)srvStorageData + srvStorageOffsetList[infoType], typeSize);
+    pHeader->crc = lSRV_STORAGE_GetRecordCrc(pRecord);
+
+    srvStorageDirty &= (uint8_t)~(1U << infoType);
+
+    return unit + units;
+}
+
+static void lSRV_STORAGE_WaitReady(void)
+{
+    /* Wait until the flash command is done. Flash commands are not left in
+     * progress, as the memory driver issues its commands without checking
+     * the flash is ready */
+    while (SEFC0_IsBusy() == true)
+    {
+    }
+}
+
+static bool lSRV_STORAGE_WritePage(uint8_t block, uint8_t page)
+{
+    bool result;
+
+    /* Whole page, programmed once after erase */
+    result = SEFC0_UserSignatureWrite((void *)srvStoragePage, IFLASH0_PAGE_SIZE >> 2, srvStorageJournalBlocks[block], (SEFC_USERSIGNATURE_PAGE)page);
+    lSRV_STORAGE_WaitReady();
+
+    return result;
+}
+
+static bool lSRV_STORAGE_AppendRecords(void)
+{
+    uint8_t dirty = srvStorageDirty & (uint8_t)SRV_STORAGE_JOURNAL_TYPES;
+    uint8_t infoType;
+    uint8_t unit = 0;
+
+    if ((srvStorageJournal.active == SRV_STORAGE_JOURNAL_NONE) ||
+        (srvStorageJournal.writePage >= SRV_STORAGE_JOURNAL_PAGES))
+    {
+        /* No journal or journal block full */
+        return false;
+    }
+
+    /* Every journal type with changes, in the next page */
+    (void) memset(srvStoragePage, 0xFF, sizeof(srvStoragePage));
+    for (infoType = 0; infoType < (uint8_t)SRV_STORAGE_TYPE_END_LIST; infoType++)
     {
-        /* Error reading User Signature */
+        if ((dirty & (1U << infoType)) != 0U)
+        {
+            unit = lSRV_STORAGE_PutRecord(infoType, unit);
+        }
+    }
+
+    if (lSRV_STORAGE_WritePage(srvStorageJournal.active, srvStorageJournal.writePage) == false)
+    {
+        srvStorageDirty |= dirty;
         return false;
     }
 
-    /* Copy data to pointer given as parameter */
-    (void) memcpy(pData, (void*) &srvStorageData[offset], size);
+    srvStorageJournal.writePage++;
+    return true;
+}
+
+static uint8_t lSRV_STORAGE_GetCompactBlock(void)
+{
+    return (srvStorageJournal.active == 0U) ? 1U : 0U;
+}
 
+static bool lSRV_STORAGE_Compact(void)
+{
+    SRV_STORAGE_JOURNAL_HEADER *pHeader = (SRV_STORAGE_JOURNAL_HEADER *)srvStoragePage;
+    uint8_t block = lSRV_STORAGE_GetCompactBlock();
+    uint8_t infoType;
+    uint8_t unit = 1;
+
+    /* Copy latest data of every type to page 0 of the other block, after
+     * the header. The block becomes valid once the page is programmed */
+    SEFC0_UserSignatureErase(srvStorageJournalBlocks[block]);
+    lSRV_STORAGE_WaitReady();
+
+    (void) memset(srvStoragePage, 0xFF, sizeof(srvStoragePage));
+    for (infoType = 0; infoType < (uint8_t)SRV_STORAGE_TYPE_END_LIST; infoType++)
+    {
+        if (infoType != (uint8_t)SRV_STORAGE_TYPE_BOOT_INFO)
+        {
+            unit = lSRV_STORAGE_PutRecord(infoType, unit);
+        }
+    }
+
+    pHeader->key = SRV_STORAGE_JOURNAL_KEY;
+    pHeader->sequence = srvStorageJournal.sequence + 1U;
+    pHeader->units = (uint32_t)unit - 1U;
+    pHeader->crc = lSRV_STORAGE_GetHeaderCrc((uint8_t *)srvStoragePage);
+
+    if (lSRV_STORAGE_WritePage(block, 0) == false)
+    {
+        /* Active block is kept, compact again on next write */
+        srvStorageDirty |= (uint8_t)SRV_STORAGE_JOURNAL_TYPES;
+        srvStorageJournal.writePage = SRV_STORAGE_JOURNAL_PAGES;
+        return false;
+    }
+
+    /* Journal continues in the new block */
+    srvStorageJournal.active = block;
+    srvStorageJournal.sequence++;
+    srvStorageJournal.writePage = 1;
     return true;
 }
 
-bool SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE infoType, uint8_t size, void* pData)
+static bool lSRV_STORAGE_WriteBootInfo(void)
+{
+    /* Erase User Signature block 0 and write it with RAM copy */
+    SEFC0_UserSignatureErase(BLOCK_0);
+    lSRV_STORAGE_WaitReady();
+
+    srvStorageDirty &= (uint8_t)~SRV_STORAGE_BOOT_TYPE;
+    if (SEFC0_UserSignatureWrite((void*) srvStorageData, SRV_STORAGE_TOTAL_SIZE >> 2, BLOCK_0, PAGE_0) == false)
+    {
+        srvStorageDirty |= (uint8_t)SRV_STORAGE_BOOT_TYPE;
+        return false;
+    }
+
+    lSRV_STORAGE_WaitReady();
+    return true;
+}
+
+static bool lSRV_STORAGE_WriteTasks(bool flush)
+{
+    bool result;
+
+    if (srvStorageDirty == 0U)
+    {
+        return true;
+    }
+
+    if (flush == false)
+    {
+        uint32_t elapsed = SYS_TIME_CounterGet() - srvStorageDirtyCount;
+
+        if ((elapsed < SYS_TIME_MSToCount(SRV_STORAGE_WRITE_DELAY_MS)) ||
+            (SEFC0_IsBusy() == true))
+        {
+            /* Not time to write yet, or flash command of the memory driver
+             * in progress */
+            return true;
+        }
+    }
+    else
+    {
+        lSRV_STORAGE_WaitReady();
+    }
+
+    /* One write per call. Each write waits for its flash commands, so
+     * commands of the memory driver are never issued meanwhile */
+    if ((srvStorageDirty & SRV_STORAGE_JOURNAL_TYPES) != 0U)
+    {
+        result = lSRV_STORAGE_AppendRecords();
+        if (result == false)
+        {
+            /* No journal or journal full (or write error) */
+            result = lSRV_STORAGE_Compact();
+        }
+    }
+    else
+    {
+        result = lSRV_STORAGE_WriteBootInfo();
+    }
+
+    if (result == false)
+    {
+        /* Error writing User Signature, retry later */
+        srvStorageDirtyCount = SYS_TIME_CounterGet();
+    }
+
+    return result;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Storage Service Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SRV_STORAGE_Initialize(void)
+{
+    /* Disable User Signature write protection */
+    SEFC0_WriteProtectionSet(0);
+
+    /* Enable write and read User Signature rights: block 0 / area 1 for
+     * configuration and boot information, blocks 1 and 2 / areas 2 and 3
+     * for the configuration journal */
+    SEFC0_UserSignatureRightsSet(SEFC_EEFC_USR_RDENUSB1_Msk | SEFC_EEFC_USR_WRENUSB1_Msk |
+                                 SEFC_EEFC_USR_RDENUSB2_Msk | SEFC_EEFC_USR_WRENUSB2_Msk |
+                                 SEFC_EEFC_USR_RDENUSB3_Msk | SEFC_EEFC_USR_WRENUSB3_Msk);
+
+    /* Load RAM copy of non-volatile data */
+    srvStorageLoaded = false;
+    srvStorageDirty = 0;
+    (void) lSRV_STORAGE_Load();
+}
+
+void SRV_STORAGE_Tasks(void)
+{
+    (void) lSRV_STORAGE_WriteTasks(false);
+}
+
+bool SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE infoType, uint8_t size, void* pData)
 {
-    uint16_t totalSize;
     uint8_t offset;
 
-    if (infoType >= SRV_STORAGE_TYPE_END_LIST)
+    if (lSRV_STORAGE_GetOffset(infoType, size, &offset) == false)
     {
-        /* Invalid type */
         return false;
     }
 
-    /* Get offset depending on info type */
-    offset = srvStorageOffsetList[infoType];
-    totalSize = (uint16_t) offset + (uint16_t) size;
+    if (lSRV_STORAGE_Load() == false)
+    {
+        /* Error reading User Signature */
+        return false;
+    }
 
-    if (totalSize > SRV_STORAGE_TOTAL_SIZE)
+    /* Copy data to pointer given as parameter */
+    (void) memcpy(pData, (void*) ((uint8_t*) srvStorageData + offset), size);
+
+    return true;
+}
+
+bool SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE infoType, uint8_t size, void* pData)
+{
+    uint8_t *pStored;
+    uint8_t offset;
+
+    if (lSRV_STORAGE_GetOffset(infoType, size, &offset) == false)
     {
-        /* Invalid size */
         return false;
     }
 
-    /* Read data from User Signature */
-    if (SEFC0_UserSignatureRead((void*) srvStorageData, SRV_STORAGE_TOTAL_SIZE >> 2, BLOCK_0, PAGE_0) == false)
+    if (lSRV_STORAGE_Load() == false)
     {
         /* Error reading User Signature */
         return false;
     }
 
-    /* Copy new data */
-    (void) memcpy((void*) &srvStorageData[offset], pData, size);
+    pStored = (uint8_t*) srvStorageData + offset;
+    if (memcmp((void*) pStored, pData, size) == 0)
+    {
+        /* Same data already stored (or pending) */
+        return true;
+    }
+
+    /* Copy new data. Written to User Signature from SRV_STORAGE_Tasks */
+    (void) memcpy((void*) pStored, pData, size);
+    srvStorageDataCrc = lSRV_STORAGE_GetDataCrc();
 
-    /* Erase User Signature */
-    SEFC0_UserSignatureErase(BLOCK_0);
+    if (srvStorageDirty == 0U)
+    {
+        srvStorageDirtyCount = SYS_TIME_CounterGet();
+    }
 
-    /* Wait until User Signature is erased */
-    while(SEFC0_IsBusy()){}
+    srvStorageDirty |= (uint8_t)(1U << (uint8_t)infoType);
 
-    /* Write User Signature */
-    if (SEFC0_UserSignatureWrite((void*) srvStorageData, SRV_STORAGE_TOTAL_SIZE >> 2, BLOCK_0, PAGE_0) == false)
+    if (((1U << (uint8_t)infoType) & SRV_STORAGE_WRITE_THROUGH_TYPES) != 0U)
     {
-        /* Error writing User Signature */
+        /* Not lost by a reset that does not go through the reset handler
+         * (watchdog, external reset, brown-out). Written together with the
+         * other pending changes */
+        return SRV_STORAGE_Flush();
+    }
+
+    return true;
+}
+
+bool SRV_STORAGE_Flush(void)
+{
+    if ((srvStorageDirty != 0U) && (srvStorageDataCrc != lSRV_STORAGE_GetDataCrc()))
+    {
+        /* RAM copy corrupted (e.g. flush after a fault): keep the data
+         * already written */
         return false;
     }
 
-    /* Wait until User Signature is written */
-    while(SEFC0_IsBusy()){}
+    /* Write pending changes and wait until User Signature is written */
+    while (srvStorageDirty != 0U)
+    {
+        if (lSRV_STORAGE_WriteTasks(true) == false)
+        {
+            /* Error writing User Signature */
+            return false;
+        }
+    }
 
     return true;
 }
@@ -104,6 +104,7 @@ typedef enum
     SRV_STORAGE_TYPE_MODE_PRIME = 3,
     SRV_STORAGE_TYPE_SECURITY = 4,
     SRV_STORAGE_TYPE_BOOT_INFO = 5,
+    SRV_STORAGE_TYPE_FU_INFO = 6,
     SRV_STORAGE_TYPE_END_LIST
 
 } SRV_STORAGE_TYPE;
@@ -264,6 +265,40 @@ typedef struct {
 	uint8_t bootState;
 } SRV_STORAGE_BOOT_CONFIG;
 
+// *****************************************************************************
+/* Firmware upgrade progress information
+
+  Summary:
+    Structure and key to define the firmware upgrade progress information that
+    needs to be kept in non-volatile storage.
+
+  Description:
+    This data type defines the structure and key to define the information
+    used by the Firmware Upgrade service to resume an upgrade after a reset:
+    the image being received, the CRC of one of its pages and the ranges of
+    pages already written.
+
+  Remarks:
+    Ranges are not sorted. If the received pages do not fit in
+    SRV_STORAGE_FU_INFO_RANGES ranges, only the longest ones are stored.
+*/
+
+#define SRV_STORAGE_FU_INFO_CFG_KEY      0xA55A5AA5
+#define SRV_STORAGE_FU_INFO_RANGES       23U
+
+typedef struct {
+	uint32_t cfgKey;
+	uint32_t imageSize;
+	uint16_t signLength;
+	uint8_t signAlgorithm;
+	uint8_t pageSize;
+	uint16_t numRanges;
+	uint16_t crcPage;
+	uint32_t crcValue;
+	uint16_t rangeStart[SRV_STORAGE_FU_INFO_RANGES];
+	uint16_t rangeLength[SRV_STORAGE_FU_INFO_RANGES];
+} SRV_STORAGE_FU_INFO_CONFIG;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Storage Service Interface Definition
@@ -359,7 +394,10 @@ bool SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE infoType, uint8_t size, void *pD
     pData    - Pointer to configuration information data to write.
 
   Returns:
-    The result of the write operation (true if success, false if error).
+    The result of the write operation (true if success, false if error). For
+    SRV_STORAGE_TYPE_BOOT_INFO and SRV_STORAGE_TYPE_FU_INFO, false if they
+    could not be written in non-volatile memory: the data is kept in RAM and
+    written again from SRV_STORAGE_Tasks.
 
   Example:
     <code>
@@ -369,9 +407,99 @@ bool SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE infoType, uint8_t size, void *pD
     </code>
 
   Remarks:
-    None.
+    Data is stored in a RAM copy and written to non-volatile memory from
+    SRV_STORAGE_Tasks, SRV_STORAGE_WRITE_DELAY_MS after the first change, so
+    that consecutive changes are written together. Writing the data already
+    stored does not access non-volatile memory.
+
+    SRV_STORAGE_TYPE_BOOT_INFO and SRV_STORAGE_TYPE_FU_INFO are written before
+    returning (as with SRV_STORAGE_Flush, with the other pending changes), so
+    that no reset loses them. This function blocks until they are written.
+
+    All types except SRV_STORAGE_TYPE_BOOT_INFO are appended to a journal in
+    User Signature blocks 1 and 2, so a change does not erase flash until the
+    journal block is full. Boot information is written in User Signature
+    block 0, where it is read by the bootloader.
 */
 
 bool SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE infoType, uint8_t size, void *pData);
 
+// *****************************************************************************
+/* Function:
+    void SRV_STORAGE_Tasks(void);
+
+  Summary:
+    Maintains the PRIME non-volatile Storage service state machine.
+
+  Description:
+    This routine writes the pending configuration changes in non-volatile
+    memory when SRV_STORAGE_WRITE_DELAY_MS have elapsed since the first
+    change.
+
+  Precondition:
+    The SRV_STORAGE_Initialize routine must have been called before.
+
+  Parameters:
+    None.
+
+  Returns:
+    None.
+
+  Example:
+    <code>
+    while (true)
+    {
+        SRV_STORAGE_Tasks();
+    }
+    </code>
+
+  Remarks:
+    Each call writes at most one record (or the whole block when it is
+    erased) and waits until the flash is ready again, so that no flash
+    command is in progress when the memory driver issues its own. The write
+    is not started while a flash command of the memory driver is in progress.
+
+    This function is normally not called directly by an application. It is
+    called by the system's tasks routine (SYS_Tasks).
+*/
+
+void SRV_STORAGE_Tasks(void);
+
+// *****************************************************************************
+/* Function:
+    bool SRV_STORAGE_Flush(void);
+
+  Summary:
+    Writes pending configuration changes in non-volatile memory.
+
+  Description:
+    This routine writes the pending configuration changes in non-volatile
+    memory without waiting for SRV_STORAGE_WRITE_DELAY_MS, and waits until
+    the write is finished. Nothing is written if the RAM copy of the
+    configuration does not match the CRC kept with its last change.
+
+  Precondition:
+    The SRV_STORAGE_Initialize routine must have been called before.
+
+  Parameters:
+    None.
+
+  Returns:
+    The result of the write operation (true if success, false if error).
+
+  Example:
+    <code>
+    SRV_STORAGE_Flush();
+    RSTC_Reset(RSTC_PROCESSOR_RESET);
+    </code>
+
+  Remarks:
+    This function blocks until non-volatile memory is written. It must be
+    called before a reset or power down, otherwise pending changes are lost.
+    SRV_RESET_HANDLER_RestartSystem calls it before every reset, fault and
+    watchdog resets included.
+*/
+
+bool SRV_STORAGE_Flush(void);
+
 #endif //SRV_STORAGE_H
@@ -120,7 +120,7 @@ uint64_t SRV_TIME_MANAGEMENT_USToCount(uint32_t timeUs)
     // Get the low part of the current timer counter
     currentUs = (uint32_t)srvTimeMngCurrentTimeUs;
 
-    diffUs = (int32_t)timeUs - (int32_t)currentUs;
+    diffUs = (int32_t)(timeUs - currentUs);
 
     if (diffUs < 0)
     {
@@ -66,7 +66,31 @@ static SRV_USI_OBJ gSrvUSIOBJ[SRV_USI_INSTANCES_NUMBER] = {
 };
 
 /* This is the USI callback object for each USI instance. */
-static SRV_USI_CALLBACK gSrvUSICallbackOBJ[SRV_USI_INSTANCES_NUMBER][11];
+static SRV_USI_CALLBACK gSrvUSICallbackOBJ[SRV_USI_INSTANCES_NUMBER][SRV_USI_CALLBACK_NUMBER];
+
+/* USI protocol descriptors, indexed by protocol identifier */
+#define USI_PROT_DESC_MNGP          {USI_MAX_LENGTH, 0U, USI_PROT_FLAG_VALID | USI_PROT_FLAG_HEADER, PCRC_CRC32}
+
+static const SRV_USI_PROTOCOL_DESC gSrvUSIProtocolDesc[USI_PROTOCOL_NUMBER] = {
+    [SRV_USI_PROT_ID_MNGP_PRIME_GETQRY]    = USI_PROT_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_GETRSP]    = USI_PROT_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_SET]       = USI_PROT_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_RESET]     = USI_PROT_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_REBOOT]    = USI_PROT_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_FU]        = USI_PROT_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_GETQRY_EN] = USI_PROT_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_GETRSP_EN] = USI_PROT_DESC_MNGP,
+    [SRV_USI_PROT_ID_SNIF_PRIME]           = {USI_MAX_LENGTH, 1U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+    [SRV_USI_PROT_ID_PHY_SERIAL_PRIME]     = {USI_MAX_LENGTH, 2U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+    [SRV_USI_PROT_ID_PHY]                  = {USI_MAX_LENGTH, 3U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+    [SRV_USI_PROT_ID_SNIFF_G3]             = {USI_MAX_LENGTH, 4U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+    [SRV_USI_PROT_ID_MAC_G3]               = {USI_MAX_LENGTH, 5U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+    [SRV_USI_PROT_ID_ADP_G3]               = {USI_MAX_XLENGTH, 6U, USI_PROT_FLAG_VALID | USI_PROT_FLAG_XLEN, PCRC_CRC16},
+    [SRV_USI_PROT_ID_COORD_G3]             = {USI_MAX_XLENGTH, 7U, USI_PROT_FLAG_VALID | USI_PROT_FLAG_XLEN, PCRC_CRC16},
+    [SRV_USI_PROT_ID_PHY_MICROPLC]         = {USI_MAX_LENGTH, 8U, USI_PROT_FLAG_VALID, PCRC_CRC8},
+    [SRV_USI_PROT_ID_PRIME_API]            = {USI_MAX_XLENGTH, 9U, USI_PROT_FLAG_VALID | USI_PROT_FLAG_XLEN, PCRC_CRC8},
+    [SRV_USI_PROT_ID_PHY_RF215]            = {USI_MAX_LENGTH, 10U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+};
 
 // *****************************************************************************
 // *****************************************************************************
@@ -74,111 +98,22 @@ static SRV_USI_CALLBACK gSrvUSICallbackOBJ[SRV_USI_INSTANCES_NUMBER][11];
 // *****************************************************************************
 // *****************************************************************************
 
-static SRV_USI_CALLBACK_INDEX lSRV_USI_GetCallbackIndexFromProtocol(SRV_USI_PROTOCOL_ID protocol)
+static const SRV_USI_PROTOCOL_DESC* lSRV_USI_GetProtocolDesc(SRV_USI_PROTOCOL_ID protocol)
 {
-    SRV_USI_CALLBACK_INDEX callbackIndex;
-
-    switch(protocol)
-    {
-        case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY:
-        case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP:
-        case SRV_USI_PROT_ID_MNGP_PRIME_SET:
-        case SRV_USI_PROT_ID_MNGP_PRIME_RESET:
-        case SRV_USI_PROT_ID_MNGP_PRIME_REBOOT:
-        case SRV_USI_PROT_ID_MNGP_PRIME_FU:
-        case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY_EN:
-        case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP_EN:
-            callbackIndex = 0;
-            break;
+    const SRV_USI_PROTOCOL_DESC* protDesc;
 
-        case SRV_USI_PROT_ID_SNIF_PRIME:
-            callbackIndex = 1;
-            break;
-            
-        case SRV_USI_PROT_ID_PHY_SERIAL_PRIME:
-            callbackIndex = 2;
-            break;
-            
-        case SRV_USI_PROT_ID_PHY:
-            callbackIndex = 3;
-            break;
-            
-        case SRV_USI_PROT_ID_SNIFF_G3:
-            callbackIndex = 4;
-            break;
-            
-        case SRV_USI_PROT_ID_MAC_G3:
-            callbackIndex = 5;
-            break;
-            
-        case SRV_USI_PROT_ID_ADP_G3:
-            callbackIndex = 6;
-            break;
-            
-        case SRV_USI_PROT_ID_COORD_G3:
-            callbackIndex = 7;
-            break;
-            
-        case SRV_USI_PROT_ID_PHY_MICROPLC:
-            callbackIndex = 8;
-            break;
-            
-        case SRV_USI_PROT_ID_PRIME_API:
-            callbackIndex = 9;
-            break;
-
-        case SRV_USI_PROT_ID_PHY_RF215:
-            callbackIndex = 10;
-            break;
-
-        case SRV_USI_PROT_ID_INVALID:
-        default:
-            SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_ERROR, USI_BAD_PROTOCOL,
-                                             "USI: Bad protocol to get callback\r\n");
-            callbackIndex = SRV_USI_CALLBACK_INDEX_INVALID;
-            break;
+    if ((uint32_t)protocol >= USI_PROTOCOL_NUMBER)
+    {
+        return NULL;
     }
 
-    return callbackIndex;
-}
-
-static PCRC_CRC_TYPE lSRV_USI_GetCRCTypeFromProtocol(SRV_USI_PROTOCOL_ID protocol)
-{
-    PCRC_CRC_TYPE crcType;
-
-    switch(protocol)
-    {
-        case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY:
-        case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP:
-        case SRV_USI_PROT_ID_MNGP_PRIME_SET:
-        case SRV_USI_PROT_ID_MNGP_PRIME_RESET:
-        case SRV_USI_PROT_ID_MNGP_PRIME_REBOOT:
-        case SRV_USI_PROT_ID_MNGP_PRIME_FU:
-        case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY_EN:
-        case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP_EN:
-            crcType = PCRC_CRC32;
-            break;
-
-        case SRV_USI_PROT_ID_SNIF_PRIME:
-        case SRV_USI_PROT_ID_PHY_SERIAL_PRIME:
-        case SRV_USI_PROT_ID_PHY:
-        case SRV_USI_PROT_ID_PHY_RF215:
-        case SRV_USI_PROT_ID_SNIFF_G3:
-        case SRV_USI_PROT_ID_MAC_G3:
-        case SRV_USI_PROT_ID_ADP_G3:
-        case SRV_USI_PROT_ID_COORD_G3:
-            crcType = PCRC_CRC16;
-            break;
-            
-        case SRV_USI_PROT_ID_PRIME_API:
-        case SRV_USI_PROT_ID_PHY_MICROPLC:
-        case SRV_USI_PROT_ID_INVALID:
-        default:
-            crcType = PCRC_CRC8;
-            break;
+    protDesc = &gSrvUSIProtocolDesc[protocol];
+    if ((protDesc->flags & USI_PROT_FLAG_VALID) == 0U)
+    {
+        return NULL;
     }
 
-    return crcType;    
+    return protDesc;
 }
 
 static SRV_USI_HANDLE lSRV_USI_HandleValidate(SRV_USI_HANDLE handle)
@@ -186,16 +121,18 @@ static SRV_USI_HANDLE lSRV_USI_HandleValidate(SRV_USI_HANDLE handle)
     /* This function returns the same handle if the handle is valid. Returns 
        SRV_USI_HANDLE_INVALID otherwise. */
 
-    uint8_t srvIndex;
+    uintptr_t offset;
+    uintptr_t srvIndex;
 
-    if((handle != SRV_USI_HANDLE_INVALID) && (handle != 0U))
+    /* The handle points to an element of the service object array */
+    if (handle >= (SRV_USI_HANDLE)gSrvUSIOBJ)
     {
-        /* Look for the handle */
-        for (srvIndex = 0; srvIndex < SRV_USI_INSTANCES_NUMBER; srvIndex++)
+        offset = handle - (SRV_USI_HANDLE)gSrvUSIOBJ;
+        srvIndex = offset / sizeof(SRV_USI_OBJ);
+        if ((srvIndex < SRV_USI_INSTANCES_NUMBER) &&
+            (offset == (srvIndex * sizeof(SRV_USI_OBJ))))
         {
-            if (handle == (SRV_USI_HANDLE)(&gSrvUSIOBJ[srvIndex])) {
-                return handle;
-            }
+            return handle;
         }
     }
 
@@ -208,11 +145,13 @@ static void lSRV_USI_Callback_Handle ( uint8_t *pData, uint16_t length, uintptr_
     uint32_t crcGetValue;
     uint32_t crcRcvValue;
     uint16_t lengthWithoutCrc;
+    uint16_t lengthCrc;
     SRV_USI_PROTOCOL_ID protocol;
     uint8_t protocolValue;
     PCRC_CRC_TYPE crcType;
     uint16_t dataLength;
-    SRV_USI_CALLBACK_INDEX cbIndex;
+    const SRV_USI_PROTOCOL_DESC* protDesc;
+    SRV_USI_CALLBACK cbFunc;
     
     /* Check valid context : the driver handle */
     if (lSRV_USI_HandleValidate((SRV_USI_HANDLE)context) == SRV_USI_HANDLE_INVALID)
@@ -224,30 +163,53 @@ static void lSRV_USI_Callback_Handle ( uint8_t *pData, uint16_t length, uintptr_
     
     if (length > 0U) 
     {      
+        /* Check minimum length: header (2 bytes) */
+        if (length < USI_PAYLOAD_OFFSET)
+        {
+            dObj->linkStats.rxBadLength++;
+            return;
+        }
+
         /* New received message */
         /* Extract Protocol */
         protocolValue = USI_TYPE_PROTOCOL(pData[1]);
         protocol = (SRV_USI_PROTOCOL_ID)protocolValue;
+
+        /* Check protocol */
+        protDesc = lSRV_USI_GetProtocolDesc(protocol);
+        if (protDesc == NULL)
+        {
+            /* Discard message */
+            dObj->linkStats.rxUnknownProtocol++;
+            return;
+        }
         
         /* Get CRC type from Protocol */
-        crcType = lSRV_USI_GetCRCTypeFromProtocol(protocol);
+        crcType = protDesc->crcType;
+
+        /* Check minimum length: header (2 bytes) and CRC */
+        lengthCrc = (uint16_t)1U << (uint8_t)crcType;
+        if (length < (USI_PAYLOAD_OFFSET + lengthCrc))
+        {
+            dObj->linkStats.rxBadLength++;
+            return;
+        }
         
         /* Extract data length */
         dataLength = USI_LEN_PROTOCOL(pData[USI_LEN_HI_OFFSET], pData[USI_LEN_LO_OFFSET]);
 
         /* Add extended length */
-        if ((protocol == SRV_USI_PROT_ID_ADP_G3) ||
-            (protocol == SRV_USI_PROT_ID_COORD_G3) ||
-            (protocol == SRV_USI_PROT_ID_PRIME_API))
+        if ((protDesc->flags & USI_PROT_FLAG_XLEN) != 0U)
         {
             dataLength += ((uint16_t) pData[USI_XLEN_OFFSET] & USI_XLEN_MSK) << USI_XLEN_SHIFT_L;
         }
 
         /* Check invalid length : remove Header and CRC bytes */
-        lengthWithoutCrc = length - ((uint16_t)1U << (uint8_t)crcType);
+        lengthWithoutCrc = length - lengthCrc;
         if (dataLength != (lengthWithoutCrc - 2U))
         {
             /* Discard message */
+            dObj->linkStats.rxBadLength++;
             SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_ERROR, USI_BAD_LENGTH, 
                                              "USI: Received bad length, protocol = 0x%02X\r\n", protocolValue);
             return;
@@ -277,32 +239,26 @@ static void lSRV_USI_Callback_Handle ( uint8_t *pData, uint16_t length, uintptr_
         if (crcGetValue != crcRcvValue) 
         {
             /* Discard message */
+            dObj->linkStats.rxBadCrc++;
             SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_ERROR, USI_BAD_CRC,
                                              "USI: Received wrong CRC\r\n");
             return;
         }
     
         /* Launch USI callback */
-        cbIndex = lSRV_USI_GetCallbackIndexFromProtocol(protocol);
-        if (dObj->callback[cbIndex] != NULL)
+        dObj->linkStats.rxFrames++;
+        dObj->protocolStats[protDesc->cbIndex].rxFrames++;
+        cbFunc = dObj->callback[protDesc->cbIndex];
+        if (cbFunc != NULL)
         {
-            switch(protocol)
+            if ((protDesc->flags & USI_PROT_FLAG_HEADER) != 0U)
             {
-                case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY:
-                case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP:
-                case SRV_USI_PROT_ID_MNGP_PRIME_SET:
-                case SRV_USI_PROT_ID_MNGP_PRIME_RESET:
-                case SRV_USI_PROT_ID_MNGP_PRIME_REBOOT:
-                case SRV_USI_PROT_ID_MNGP_PRIME_FU:
-                case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY_EN:
-                case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP_EN:
-                    /* MNGL spec. including header (2 bytes) */
-                    dObj->callback[cbIndex](pData, dataLength + 2U);
-                    break;
-                     
-                default:
-                    dObj->callback[cbIndex](pData + 2U, dataLength);
-                    break;
+                /* MNGL spec. including header (2 bytes) */
+                cbFunc(pData, dataLength + 2U);
+            }
+            else
+            {
+                cbFunc(pData + 2U, dataLength);
             }
         }
     }
@@ -311,31 +267,71 @@ static void lSRV_USI_Callback_Handle ( uint8_t *pData, uint16_t length, uintptr_
 static uint8_t* lSRV_USI_EscapeData( uint8_t *pDstData, uint8_t *pSrcData,
                                       uint16_t length, uint8_t *pEndData )
 {
+    uint8_t *pSlowEnd;
+    uint8_t *pFastData;
+    uint16_t slowWindow = (uint16_t)USI_WORD_SIZE;
+    uint32_t word;
+
     while (length > 0U)
     {
-        if (*pSrcData == USI_ESC_KEY_7D)
+        /* Copy 4 bytes at once while none of them has to be escaped */
+        pFastData = pSrcData;
+        while ((length >= USI_WORD_SIZE) &&
+               ((pEndData - pDstData) > (ptrdiff_t)USI_WORD_SIZE))
         {
-            *pDstData++ = USI_ESC_KEY_7D;
-            *pDstData++ = USI_ESC_KEY_5D;
-        } 
-        else if (*pSrcData == USI_ESC_KEY_7E)
+            (void) memcpy(&word, pSrcData, USI_WORD_SIZE);
+            if (USI_WORD_HAS_ESC_KEY(word) != 0U)
+            {
+                break;
+            }
+
+            (void) memcpy(pDstData, pSrcData, USI_WORD_SIZE);
+            pDstData += USI_WORD_SIZE;
+            pSrcData += USI_WORD_SIZE;
+            length -= (uint16_t)USI_WORD_SIZE;
+        }
+
+        /* Widen the byte by byte window while escape keys keep coming */
+        if (pSrcData != pFastData)
         {
-            *pDstData++ = USI_ESC_KEY_7D;
-            *pDstData++ = USI_ESC_KEY_5E;
-        } 
+            slowWindow = (uint16_t)USI_WORD_SIZE;
+        }
+        else if (slowWindow < USI_SLOW_WINDOW_MAX)
+        {
+            slowWindow <<= 1;
+        }
         else
         {
-            *pDstData++ = *pSrcData;
+            /* Keep maximum window */
         }
 
-        if (pDstData == pEndData)
+        pSlowEnd = pSrcData + ((length < slowWindow) ? length : slowWindow);
+        while (pSrcData < pSlowEnd)
         {
-            /* Escaped Message can't fit in Write buffer */
-            return NULL;
+            if (*pSrcData == USI_ESC_KEY_7D)
+            {
+                *pDstData++ = USI_ESC_KEY_7D;
+                *pDstData++ = USI_ESC_KEY_5D;
+            } 
+            else if (*pSrcData == USI_ESC_KEY_7E)
+            {
+                *pDstData++ = USI_ESC_KEY_7D;
+                *pDstData++ = USI_ESC_KEY_5E;
+            } 
+            else
+            {
+                *pDstData++ = *pSrcData;
+            }
+
+            if (pDstData >= pEndData)
+            {
+                /* Escaped Message can't fit in Write buffer */
+                return NULL;
+            }
+
+            pSrcData++;
+            length--;
         }
-        
-        pSrcData++;
-        length--;
     }
     
     return pDstData;
@@ -343,18 +339,23 @@ static uint8_t* lSRV_USI_EscapeData( uint8_t *pDstData, uint8_t *pSrcData,
 
 static size_t lSRV_USI_BuildMessage( uint8_t *pDstData, size_t maxDstLength, 
                                      SRV_USI_PROTOCOL_ID protocol, 
-                                     uint8_t *pData, uint16_t length )
+                                     const SRV_USI_PROTOCOL_DESC *protDesc,
+                                     const SRV_USI_MSG_SEGMENT *pSegments,
+                                     uint8_t numSegments, uint16_t length )
 {
     ptrdiff_t size;
     uint8_t* pNewData;
     uint8_t* pEndData;
+    uint8_t* pSegData;
     uint8_t valueTmp[4];
-    uint8_t command;
     uint32_t valueTmp32;
+    uint16_t segLength;
+    uint8_t segIndex;
+    bool adjustCommand;
     PCRC_CRC_TYPE crcType;
     
     /* Get CRC type from Protocol */
-    crcType = lSRV_USI_GetCRCTypeFromProtocol(protocol);
+    crcType = protDesc->crcType;
     
     /* Build new message */
     pNewData = pDstData;
@@ -377,19 +378,44 @@ static size_t lSRV_USI_BuildMessage( uint8_t *pDstData, size_t maxDstLength,
         return 0;
     }
 
-    if ((protocol == SRV_USI_PROT_ID_ADP_G3) ||
-        (protocol == SRV_USI_PROT_ID_COORD_G3) ||
-        (protocol == SRV_USI_PROT_ID_PRIME_API))
+    /* The first data byte carries the extended length in these protocols */
+    adjustCommand = ((protDesc->flags & USI_PROT_FLAG_XLEN) != 0U);
+
+    /* Get CRC from USI data and escape it, segment by segment */
+    for (segIndex = 0; segIndex < numSegments; segIndex++)
     {
-        /* Adjust extended length */
-        command = pData[0];
-        pData[0] = USI_LEN_EX_PROTOCOL(length) + USI_CMD_PROTOCOL(command);
+        pSegData = pSegments[segIndex].pData;
+        segLength = (uint16_t)pSegments[segIndex].length;
+
+        if (segLength == 0U)
+        {
+            continue;
+        }
+
+        if (adjustCommand == true)
+        {
+            /* Adjust extended length, without modifying caller data */
+            valueTmp[0] = USI_LEN_EX_PROTOCOL(length) + USI_CMD_PROTOCOL(pSegData[0]);
+            valueTmp32 = SRV_PCRC_GetValue(&valueTmp[0], 1, PCRC_HT_USI, crcType, valueTmp32);
+            pNewData = lSRV_USI_EscapeData(pNewData, &valueTmp[0], 1, pEndData);
+            if (pNewData == NULL)
+            {
+                break;
+            }
+
+            adjustCommand = false;
+            pSegData++;
+            segLength--;
+        }
+
+        valueTmp32 = SRV_PCRC_GetValue(pSegData, segLength, PCRC_HT_USI, crcType, valueTmp32);
+        pNewData = lSRV_USI_EscapeData(pNewData, pSegData, segLength, pEndData);
+        if (pNewData == NULL)
+        {
+            break;
+        }
     }
 
-    /* Get CRC from USI data. */
-    valueTmp32 = SRV_PCRC_GetValue(pData, length, PCRC_HT_USI, crcType, valueTmp32);
-    /* Escape USI data */
-    pNewData = lSRV_USI_EscapeData(pNewData, pData, length, pEndData);
     if (pNewData == NULL)
     {
         /* Error in Escape Data: can't fit in destination buffer */
@@ -397,7 +423,7 @@ static size_t lSRV_USI_BuildMessage( uint8_t *pDstData, size_t maxDstLength,
             "USI: Error in Escape Data in data: can't fit in destination buffer\r\n");
         return 0;
     }
-    
+
     /* Escape CRC value */
     valueTmp[0] = (uint8_t)(valueTmp32 >> 24);
     valueTmp[1] = (uint8_t)(valueTmp32 >> 16);
@@ -465,6 +491,9 @@ SYS_MODULE_OBJ SRV_USI_Initialize(
         dObj->wrBufferSize          = usiInit->wrBufferSize;
         dObj->callback              = gSrvUSICallbackOBJ[index];
         (void) memset(gSrvUSICallbackOBJ[index], 0, sizeof(gSrvUSICallbackOBJ[index]));
+        (void) memset(&dObj->linkStats, 0, sizeof(dObj->linkStats));
+        (void) memset(dObj->protocolStats, 0, sizeof(dObj->protocolStats));
+        dObj->sendBusy              = false;
 
         dObj->devDesc->init(dObj->devIndex, usiInit->deviceInitData);
         
@@ -549,7 +578,7 @@ SRV_USI_STATUS SRV_USI_Status( SRV_USI_HANDLE handle )
 void SRV_USI_CallbackRegister ( SRV_USI_HANDLE handle,
         SRV_USI_PROTOCOL_ID protocol, SRV_USI_CALLBACK callback )
 {
-    SRV_USI_CALLBACK_INDEX callbackIndex;
+    const SRV_USI_PROTOCOL_DESC* protDesc;
     SRV_USI_OBJ* dObj = (SRV_USI_OBJ*)handle;
     SRV_USI_CALLBACK *cb;
 
@@ -560,10 +589,12 @@ void SRV_USI_CallbackRegister ( SRV_USI_HANDLE handle,
     }
 
     /* Get callback index from USI protocol */
-    callbackIndex = lSRV_USI_GetCallbackIndexFromProtocol(protocol);
+    protDesc = lSRV_USI_GetProtocolDesc(protocol);
 
-    if (callbackIndex == SRV_USI_CALLBACK_INDEX_INVALID)
+    if (protDesc == NULL)
     {
+        SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_ERROR, USI_BAD_PROTOCOL,
+                                         "USI: Bad protocol to get callback\r\n");
         return;
     }
 
@@ -574,7 +605,7 @@ void SRV_USI_CallbackRegister ( SRV_USI_HANDLE handle,
     }
     
     /* Register callback to the USI protocol */
-    cb = &(dObj->callback[callbackIndex]);
+    cb = &(dObj->callback[protDesc->cbIndex]);
     *cb = callback;
     
     /* Register reception callback */
@@ -604,18 +635,56 @@ void SRV_USI_Tasks( SYS_MODULE_OBJ object )
 
 size_t SRV_USI_Send_Message( SRV_USI_HANDLE handle,
         SRV_USI_PROTOCOL_ID protocol, uint8_t *data, size_t length )
+{
+    SRV_USI_MSG_SEGMENT segment;
+
+    segment.pData = data;
+    segment.length = length;
+
+    return SRV_USI_Send_Message_Segments(handle, protocol, &segment, 1);
+}
+
+size_t SRV_USI_Send_Message_Segments( SRV_USI_HANDLE handle,
+        SRV_USI_PROTOCOL_ID protocol, const SRV_USI_MSG_SEGMENT *segments,
+        uint8_t numSegments )
 {
     SRV_USI_OBJ* dObj = (SRV_USI_OBJ*)handle;
+    const SRV_USI_PROTOCOL_DESC* protDesc;
+    SRV_USI_PROTOCOL_STATS* protStats;
     size_t writeLength;
+    size_t length;
+    uint8_t segIndex;
 
     /* Validate the driver handle */
     if (lSRV_USI_HandleValidate(handle) == SRV_USI_HANDLE_INVALID)
     {
         return 0;
     }
+
+    dObj->sendBusy = false;
+
+    if (segments == NULL)
+    {
+        return 0;
+    }
+
+    protDesc = lSRV_USI_GetProtocolDesc(protocol);
+    if (protDesc == NULL)
+    {
+        SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_ERROR, USI_BAD_PROTOCOL,
+                                         "USI: Bad protocol to send\r\n");
+        return 0;
+    }
+
+    /* Get total length of the message */
+    length = 0;
+    for (segIndex = 0; segIndex < numSegments; segIndex++)
+    {
+        length += segments[segIndex].length;
+    }
     
     /* Check length */
-    if ((length == 0U) || (length > dObj->wrBufferSize))
+    if ((length == 0U) || (length > dObj->wrBufferSize) || (length > protDesc->maxLength))
     {
         SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_ERROR, USI_INVALID_LENGTH, 
                                          "USI: Invalid length = %u, protocol = 0x%02X\r\n", 
@@ -624,10 +693,95 @@ size_t SRV_USI_Send_Message( SRV_USI_HANDLE handle,
     }
 
     /* Build USI message */
-    writeLength = lSRV_USI_BuildMessage(dObj->pWrBuffer, dObj->wrBufferSize, protocol, data, (uint16_t)length);
-    
-    /* Send message */
-    dObj->devDesc->writeData(dObj->devIndex, dObj->pWrBuffer, writeLength);
+    writeLength = lSRV_USI_BuildMessage(dObj->pWrBuffer, dObj->wrBufferSize, protocol,
+                                        protDesc, segments, numSegments, (uint16_t)length);
+    if (writeLength == 0U)
+    {
+        return 0;
+    }
     
+    /* Send message: the device queues the whole frame or nothing */
+    protStats = &dObj->protocolStats[protDesc->cbIndex];
+    if (dObj->devDesc->writeData(dObj->devIndex, dObj->pWrBuffer, writeLength) != writeLength)
+    {
+        dObj->linkStats.txBusy++;
+        protStats->txBusy++;
+        dObj->sendBusy = true;
+
+        return 0;
+    }
+
+    dObj->linkStats.txFrames++;
+    protStats->txFrames++;
+
     return writeLength;
 }
+
+bool SRV_USI_IsSendBusy( SRV_USI_HANDLE handle )
+{
+    SRV_USI_OBJ* dObj;
+
+    /* Validate the driver handle */
+    if (lSRV_USI_HandleValidate(handle) == SRV_USI_HANDLE_INVALID)
+    {
+        return false;
+    }
+
+    dObj = (SRV_USI_OBJ*)handle;
+
+    return dObj->sendBusy;
+}
+
+bool SRV_USI_GetLinkStats( SRV_USI_HANDLE handle, SRV_USI_LINK_STATS *stats )
+{
+    SRV_USI_OBJ* dObj;
+
+    /* Validate the driver handle */
+    if (lSRV_USI_HandleValidate(handle) == SRV_USI_HANDLE_INVALID)
+    {
+        return false;
+    }
+
+    if (stats == NULL)
+    {
+        return false;
+    }
+
+    dObj = (SRV_USI_OBJ*)handle;
+
+    /* Service counters */
+    *stats = dObj->linkStats;
+
+    /* Transport counters */
+    if (dObj->devDesc->getLinkStats != NULL)
+    {
+        dObj->devDesc->getLinkStats(dObj->devIndex, stats);
+    }
+
+    return true;
+}
+
+bool SRV_USI_GetProtocolStats( SRV_USI_HANDLE handle,
+        SRV_USI_PROTOCOL_ID protocol, SRV_USI_PROTOCOL_STATS *stats )
+{
+    SRV_USI_OBJ* dObj;
+    const SRV_USI_PROTOCOL_DESC* protDesc;
+
+    /* Validate the driver handle */
+    if (lSRV_USI_HandleValidate(handle) == SRV_USI_HANDLE_INVALID)
+    {
+        return false;
+    }
+
+    protDesc = lSRV_USI_GetProtocolDesc(protocol);
+    if ((protDesc == NULL) || (stats == NULL))
+    {
+        return false;
+    }
+
+    dObj = (SRV_USI_OBJ*)handle;
+
+    *stats = dObj->protocolStats[protDesc->cbIndex];
+
+    return true;
+}
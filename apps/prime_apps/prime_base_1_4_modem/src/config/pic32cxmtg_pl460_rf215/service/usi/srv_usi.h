@@ -154,6 +154,116 @@ typedef uintptr_t SRV_USI_HANDLE;
 
 typedef void ( * SRV_USI_CALLBACK ) ( uint8_t *pData, size_t length );
 
+// *****************************************************************************
+/* USI Message Segment
+
+  Summary:
+    Describes one contiguous piece of the data of a message to send.
+
+  Description:
+    A message can be passed to SRV_USI_Send_Message_Segments as a list of
+    segments (for example: header, fixed fields and payload), so that the
+    caller does not need to copy them into a single buffer first. The
+    segments are sent back to back, in the order of the list.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    uint8_t *pData;
+    size_t length;
+} SRV_USI_MSG_SEGMENT;
+
+// *****************************************************************************
+/* USI Link Statistics
+
+  Summary:
+    Counters of the received frames of an USI instance.
+
+  Description:
+    Received frames that are discarded are counted by cause, so that a host
+    can monitor the health of the serial link. Transmitted frames and frames
+    rejected because the device queue is full are counted as well. Counters
+    are cumulative since the USI instance was initialized and wrap around at
+    2^32.
+
+  Remarks:
+    rxOversize, rxBadEscape, rxOverrun, rxFramingError, rxParityError and
+    txQueueHighWater are counted by the USI device (transport). Line errors
+    are only counted by transports that get them from the USART.
+    The rest of counters are counted by the USI service.
+*/
+
+typedef struct
+{
+    /* Frames delivered to a protocol callback */
+    uint32_t rxFrames;
+
+    /* Frames discarded for exceeding the device read buffer */
+    uint32_t rxOversize;
+
+    /* Frames discarded for an invalid escape sequence */
+    uint32_t rxBadEscape;
+
+    /* Received data lost by the device before being decoded */
+    uint32_t rxOverrun;
+
+    /* Characters received with a framing error (wrong stop bit) */
+    uint32_t rxFramingError;
+
+    /* Characters received with a parity error */
+    uint32_t rxParityError;
+
+    /* Frames discarded for a length field not matching the frame size */
+    uint32_t rxBadLength;
+
+    /* Frames discarded for a CRC mismatch */
+    uint32_t rxBadCrc;
+
+    /* Frames discarded for an unknown protocol identifier */
+    uint32_t rxUnknownProtocol;
+
+    /* Frames queued in the device for transmission */
+    uint32_t txFrames;
+
+    /* Frames not sent because the device queue was full (all protocols) */
+    uint32_t txBusy;
+
+    /* Maximum number of bytes waiting in the device transmission queue */
+    uint32_t txQueueHighWater;
+
+} SRV_USI_LINK_STATS;
+
+// *****************************************************************************
+/* USI Protocol Statistics
+
+  Summary:
+    Counters of the frames of an USI protocol.
+
+  Description:
+    Counters are cumulative since the USI instance was initialized and wrap
+    around at 2^32.
+
+  Remarks:
+    Protocols sharing the same USI callback (PRIME Manager protocols) share
+    the counters.
+*/
+
+typedef struct
+{
+    /* Received frames delivered to the protocol callback */
+    uint32_t rxFrames;
+
+    /* Frames queued in the device for transmission */
+    uint32_t txFrames;
+
+    /* Frames not sent because the device queue was full */
+    uint32_t txBusy;
+
+} SRV_USI_PROTOCOL_STATS;
+
 // *****************************************************************************
 /*  USI device descriptor function prototypes
 
@@ -176,7 +286,7 @@ typedef DRV_HANDLE (*SRV_USI_OPEN_FPTR) (uint32_t index);
 
 typedef void (*SRV_USI_REGISTER_READ_CALLBACK_FPTR) (uint32_t index, USI_READ_CALLBACK buf, uintptr_t context);
 
-typedef void (*SRV_USI_WRITE_FPTR) (uint32_t index, void* buf, size_t length);
+typedef size_t (*SRV_USI_WRITE_FPTR) (uint32_t index, void* buf, size_t length);
 
 typedef void (*SRV_USI_TASK_FPTR) (uint32_t index);
 
@@ -184,6 +294,8 @@ typedef SRV_USI_STATUS (*SRV_USI_STATUS_FPTR) (uint32_t index);
 
 typedef void (*SRV_USI_CLOSE) (uint32_t index);
 
+typedef void (*SRV_USI_GET_LINK_STATS_FPTR) (uint32_t index, SRV_USI_LINK_STATS *stats);
+
 // *****************************************************************************
 /*  USI device descriptor
 
@@ -217,6 +329,8 @@ typedef struct
 
     SRV_USI_STATUS_FPTR status;
 
+    SRV_USI_GET_LINK_STATS_FPTR getLinkStats;
+
 } SRV_USI_DEV_DESC;
 
 // *****************************************************************************
@@ -307,6 +421,8 @@ typedef struct
         .readCallbackRegister = (USI_USART_PLIB_READ_CALLBACK_REG)UART2_ReadCallbackRegister,
         .readData = (USI_USART_PLIB_WRRD)UART2_Read,
         .writeData = (USI_USART_PLIB_WRRD)UART2_Write,
+        .writeCountGet = UART2_WriteCountGet,
+        .writeFreeBufferCountGet = UART2_WriteFreeBufferCountGet,
     };
 
     const USI_USART_INIT_DATA srvUsi0InitData = {
@@ -604,22 +720,219 @@ void SRV_USI_Tasks( SYS_MODULE_OBJ object );
     length      - Length of the data to send in bytes
 
   Returns:
-    Number of bytes sent.
+    - Number of bytes queued for transmission (frame length after escaping)
+    - 0 if the message has not been sent: the handle or the length is not
+      valid, or the device queue has no room for the whole frame (see
+      SRV_USI_IsSendBusy)
 
   Example:
     <code>
     uint8_t pData[] = "Message to send through USI";
 
-    SRV_USI_Send_Message(handle, SRV_USI_PROT_ID_PHY, pData, sizeof(pData));
+    if (SRV_USI_Send_Message(handle, SRV_USI_PROT_ID_PHY, pData,
+                             sizeof(pData)) == 0U)
+    {
+        if (SRV_USI_IsSendBusy(handle) == true)
+        {
+            // Queue full: retry later
+        }
+    }
     </code>
 
   Remarks:
-    None.
+    The device queues whole frames: a message is either queued completely or
+    not queued at all, so the host never receives a truncated frame.
   */
 
 size_t SRV_USI_Send_Message( SRV_USI_HANDLE handle,
         SRV_USI_PROTOCOL_ID protocol, uint8_t *data, size_t length );
 
+// *****************************************************************************
+/* Function:
+      size_t SRV_USI_Send_Message_Segments( SRV_USI_HANDLE handle,
+        SRV_USI_PROTOCOL_ID protocol, const SRV_USI_MSG_SEGMENT *segments,
+        uint8_t numSegments )
+
+  Summary:
+    Sends a message made of several data segments through serial interface
+    (USI).
+
+  Description:
+    This function is equivalent to SRV_USI_Send_Message, but the data of the
+    message is given as a list of segments. The CRC is computed across the
+    segments and each of them is escaped directly from the caller memory
+    into the USI write buffer, so the caller does not need to copy the whole
+    message into a buffer of its own first.
+
+  Precondition:
+    SRV_USI_Open must have been called to obtain a valid opened service handle.
+
+  Parameters:
+    handle      - A valid open-instance handle, returned from SRV_USI_Open
+    protocol    - Identifier of the protocol for the message to send
+    segments    - Pointer to the list of data segments to send
+    numSegments - Number of segments in the list
+
+  Returns:
+    - Number of bytes queued for transmission (frame length after escaping)
+    - 0 if the message has not been sent: the handle or the length is not
+      valid, or the device queue has no room for the whole frame (see
+      SRV_USI_IsSendBusy)
+
+  Example:
+    <code>
+    uint8_t header[3] = {0x12, 0x00, 0x01};
+    SRV_USI_MSG_SEGMENT segments[2];
+
+    segments[0].pData = header;
+    segments[0].length = sizeof(header);
+    segments[1].pData = pPayload;
+    segments[1].length = payloadLength;
+
+    SRV_USI_Send_Message_Segments(handle, SRV_USI_PROT_ID_PRIME_API,
+                                  segments, 2);
+    </code>
+
+  Remarks:
+    Data segments are not modified.
+  */
+
+size_t SRV_USI_Send_Message_Segments( SRV_USI_HANDLE handle,
+        SRV_USI_PROTOCOL_ID protocol, const SRV_USI_MSG_SEGMENT *segments,
+        uint8_t numSegments );
+
+// *****************************************************************************
+/* Function:
+      bool SRV_USI_IsSendBusy( SRV_USI_HANDLE handle )
+
+  Summary:
+    Checks whether the last message was not sent because the device queue
+    was full.
+
+  Description:
+    SRV_USI_Send_Message and SRV_USI_Send_Message_Segments return 0 both for
+    invalid parameters and when there is not enough room in the device to
+    queue the whole frame. This function tells the second case apart, so
+    the caller can keep the message and retry later.
+
+  Precondition:
+    SRV_USI_Open must have been called to obtain a valid opened service handle.
+
+  Parameters:
+    handle      - A valid open-instance handle, returned from SRV_USI_Open
+
+  Returns:
+    - true if the last message sent through the handle was not queued
+      because the device queue was full
+    - false otherwise, or if the handle is not valid
+
+  Example:
+    <code>
+    if (SRV_USI_Send_Message(handle, SRV_USI_PROT_ID_PRIME_API, pData,
+                             length) == 0U)
+    {
+        if (SRV_USI_IsSendBusy(handle) == true)
+        {
+            // Keep the message and retry later
+        }
+    }
+    </code>
+
+  Remarks:
+    The caller keeps ownership of the data of a message not sent.
+  */
+
+bool SRV_USI_IsSendBusy( SRV_USI_HANDLE handle );
+
+// *****************************************************************************
+/* Function:
+      bool SRV_USI_GetLinkStats( SRV_USI_HANDLE handle,
+        SRV_USI_LINK_STATS *stats )
+
+  Summary:
+    Gets the received frame counters of an USI instance.
+
+  Description:
+    This function fills the given structure with the number of frames
+    delivered and discarded (by cause) on the serial interface associated to
+    the USI instance.
+
+  Precondition:
+    SRV_USI_Open must have been called to obtain a valid opened service handle.
+
+  Parameters:
+    handle      - A valid open-instance handle, returned from SRV_USI_Open
+    stats       - Pointer to the structure to fill
+
+  Returns:
+    - true if the counters have been copied
+    - false if the handle or the pointer is not valid
+
+  Example:
+    <code>
+    SRV_USI_LINK_STATS linkStats;
+
+    if (SRV_USI_GetLinkStats(handle, &linkStats) == true)
+    {
+        if (linkStats.rxBadCrc > lastBadCrc)
+        {
+            // Noisy serial link
+        }
+    }
+    </code>
+
+  Remarks:
+    None.
+  */
+
+bool SRV_USI_GetLinkStats( SRV_USI_HANDLE handle, SRV_USI_LINK_STATS *stats );
+
+// *****************************************************************************
+/* Function:
+      bool SRV_USI_GetProtocolStats( SRV_USI_HANDLE handle,
+        SRV_USI_PROTOCOL_ID protocol, SRV_USI_PROTOCOL_STATS *stats )
+
+  Summary:
+    Gets the frame counters of an USI protocol.
+
+  Description:
+    This function fills the given structure with the number of frames
+    received, sent and not sent because the device queue was full
+    (see SRV_USI_IsSendBusy) for the given protocol.
+
+  Precondition:
+    SRV_USI_Open must have been called to obtain a valid opened service handle.
+
+  Parameters:
+    handle      - A valid open-instance handle, returned from SRV_USI_Open
+    protocol    - Identifier of the protocol
+    stats       - Pointer to the structure to fill
+
+  Returns:
+    - true if the counters have been copied
+    - false if the handle, the protocol or the pointer is not valid
+
+  Example:
+    <code>
+    SRV_USI_PROTOCOL_STATS snifferStats;
+
+    if (SRV_USI_GetProtocolStats(handle, SRV_USI_PROT_ID_SNIF_PRIME,
+                                 &snifferStats) == true)
+    {
+        if (snifferStats.txBusy > lastSnifferBusy)
+        {
+            // Sniffer frames lost
+        }
+    }
+    </code>
+
+  Remarks:
+    Protocols sharing the same USI callback share the counters.
+  */
+
+bool SRV_USI_GetProtocolStats( SRV_USI_HANDLE handle,
+        SRV_USI_PROTOCOL_ID protocol, SRV_USI_PROTOCOL_STATS *stats );
+
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
 
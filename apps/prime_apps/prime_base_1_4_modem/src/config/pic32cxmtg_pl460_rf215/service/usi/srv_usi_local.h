@@ -50,6 +50,7 @@ Microchip or any third party.
 
 #include "service/usi/srv_usi.h"
 #include "service/usi/srv_usi_definitions.h"
+#include "service/pcrc/srv_pcrc.h"
 #include "osal/osal.h"
 
 // *****************************************************************************
@@ -100,6 +101,21 @@ Microchip or any third party.
 #define USI_LEN_EX2_PROTOCOL(A)     (uint8_t)((((A) & 0x3C00U)) >> 6)
 #define USI_CMD2_PROTOCOL(A)        (uint8_t)((A) & USI_CMD2_MSK)
 
+/* Word-at-a-time (SWAR) detection of USI escape keys in 4 bytes at once.
+   USI_WORD_HAS_ZERO is non-zero if any byte of the 32-bit word is 0x00 */
+#define USI_WORD_SIZE               4U
+#define USI_WORD_HAS_ZERO(W)        (((W) - 0x01010101UL) & ~(W) & 0x80808080UL)
+#define USI_WORD_HAS_7E(W)          USI_WORD_HAS_ZERO((W) ^ 0x7E7E7E7EUL)
+#define USI_WORD_HAS_7D(W)          USI_WORD_HAS_ZERO((W) ^ 0x7D7D7D7DUL)
+#define USI_WORD_HAS_ESC_KEY(W)     (USI_WORD_HAS_7E(W) | USI_WORD_HAS_7D(W))
+
+/* Maximum number of bytes handled one by one after consecutive word checks
+   have found escape keys (densely escaped data) */
+#define USI_SLOW_WINDOW_MAX         64U
+
+/* Reads shorter than this are decoded byte by byte, without word checks */
+#define USI_FAST_MIN_LENGTH         (2U * USI_WORD_SIZE)
+
 // *****************************************************************************
 /* USI Callback Index
 
@@ -130,6 +146,66 @@ typedef uint8_t SRV_USI_CALLBACK_INDEX;
 
 #define SRV_USI_CALLBACK_INDEX_INVALID  (((SRV_USI_CALLBACK_INDEX) -1))
 
+// *****************************************************************************
+/* Number of USI Callback Indexes
+
+ Summary:
+    Number of USI protocol callbacks of each USI instance.
+
+ Description:
+    None.
+
+ Remarks:
+    None.
+*/
+
+#define SRV_USI_CALLBACK_NUMBER         11U
+
+// *****************************************************************************
+/* USI Protocol Descriptor
+
+  Summary:
+    Static properties of an USI protocol.
+
+  Description:
+    The protocol descriptor table is indexed directly by the protocol
+    identifier (6 bits in the USI header), so that the properties of the
+    protocol of each sent or received frame are found without searching.
+
+  Remarks:
+    Entries without USI_PROT_FLAG_VALID correspond to unknown protocols.
+*/
+
+/* Number of entries of the protocol descriptor table */
+#define USI_PROTOCOL_NUMBER             (USI_TYPE_MSK + 1U)
+
+/* Known protocol */
+#define USI_PROT_FLAG_VALID             0x01U
+/* First data byte carries the extended length (bit 10) */
+#define USI_PROT_FLAG_XLEN              0x02U
+/* Callback receives the USI header (2 bytes) with the data */
+#define USI_PROT_FLAG_HEADER            0x04U
+
+/* Maximum data length with normal and extended length */
+#define USI_MAX_LENGTH                  0x03FFU
+#define USI_MAX_XLENGTH                 0x07FFU
+
+typedef struct
+{
+    /* Maximum length of the data */
+    uint16_t                                 maxLength;
+
+    /* Index of the USI callback */
+    SRV_USI_CALLBACK_INDEX                   cbIndex;
+
+    /* USI_PROT_FLAG_x flags */
+    uint8_t                                  flags;
+
+    /* CRC of the frames */
+    PCRC_CRC_TYPE                            crcType;
+
+} SRV_USI_PROTOCOL_DESC;
+
 // *****************************************************************************
 /* USI Service Instance Object
 
@@ -163,6 +239,15 @@ typedef struct
     /* Max size of the write buffer */
     size_t                                   wrBufferSize;
 
+    /* Frame counters (transport fields are kept by the device) */
+    SRV_USI_LINK_STATS                       linkStats;
+
+    /* Frame counters per USI callback */
+    SRV_USI_PROTOCOL_STATS                   protocolStats[SRV_USI_CALLBACK_NUMBER];
+
+    /* Last message not sent because the device queue was full */
+    bool                                     sendBusy;
+
 } SRV_USI_OBJ;
 
 #endif //#ifndef SRV_USI_LOCAL_H
@@ -52,6 +52,7 @@ Microchip or any third party.
 // *****************************************************************************
 // *****************************************************************************
 #include <stddef.h>
+#include <string.h>
 #include "configuration.h"
 #include "driver/driver_common.h"
 #include "system/int/sys_int.h"
@@ -74,6 +75,7 @@ const SRV_USI_DEV_DESC srvUSIUSARTDevDesc =
     .task                       = USI_USART_Tasks,
     .close                      = USI_USART_Close,
     .status                     = USI_USART_Status,
+    .getLinkStats               = USI_USART_GetLinkStats,
 };
 
 static USI_USART_OBJ gUsiUsartOBJ[SRV_USI_USART_CONNECTIONS] = {0};
@@ -86,13 +88,15 @@ static USI_USART_OBJ gUsiUsartOBJ[SRV_USI_USART_CONNECTIONS] = {0};
 // *****************************************************************************
 // *****************************************************************************
 
-static void lUSI_USART_TransferReceivedData(USI_USART_OBJ* dObj, size_t bytesRcv)
+static void lUSI_USART_ProcessBytes(USI_USART_OBJ* dObj, uint8_t *pData,
+                                    size_t length)
 {
     size_t numByte;
+    uint8_t rcvChar;
 
-    for(numByte = 0; numByte < bytesRcv; numByte++)
+    for (numByte = 0; numByte < length; numByte++)
     {
-        uint8_t rcvChar = dObj->usartReadBuffer[numByte];
+        rcvChar = pData[numByte];
 
         switch (dObj->devStatus)
         {
@@ -120,7 +124,10 @@ static void lUSI_USART_TransferReceivedData(USI_USART_OBJ* dObj, size_t bytesRcv
                     }
 
                     /* End of Message */
-                     dObj->cbFunc(dObj->pRdBuffer, dObj->byteCount, dObj->context);
+                    if (dObj->cbFunc != NULL)
+                    {
+                        dObj->cbFunc(dObj->pRdBuffer, dObj->byteCount, dObj->context);
+                    }
 
                     dObj->devStatus = USI_USART_IDLE;
 
@@ -132,17 +139,31 @@ static void lUSI_USART_TransferReceivedData(USI_USART_OBJ* dObj, size_t bytesRcv
                     /* Escape character */
                     dObj->devStatus = USI_USART_ESC;
                 }
-                else
+                else if (dObj->byteCount < dObj->rdBufferSize)
                 {
                     /* Store character */
                     dObj->pRdBuffer[dObj->byteCount++] = rcvChar;
                 }
+                else
+                {
+                    /* ERROR: Message too long, discard it and wait to MSG KEY */
+                    dObj->rxOversize++;
+                    dObj->byteCount = 0;
+                    dObj->devStatus = USI_USART_IDLE;
+                }
 
                 break;
 
             case USI_USART_ESC:
             default:
-                if (rcvChar == USI_ESC_KEY_5E)
+                if (dObj->byteCount >= dObj->rdBufferSize)
+                {
+                    /* ERROR: Message too long, discard it and wait to MSG KEY */
+                    dObj->rxOversize++;
+                    dObj->byteCount = 0;
+                    dObj->devStatus = USI_USART_IDLE;
+                }
+                else if (rcvChar == USI_ESC_KEY_5E)
                 {
                     /* Store character after escape it */
                     dObj->pRdBuffer[dObj->byteCount++] = USI_ESC_KEY_7E;
@@ -157,6 +178,7 @@ static void lUSI_USART_TransferReceivedData(USI_USART_OBJ* dObj, size_t bytesRcv
                 else
                 {
                     /* ERROR: Escape format, discard message */
+                    dObj->rxBadEscape++;
                     dObj->byteCount = 0;
                     dObj->devStatus = USI_USART_IDLE;
                 }
@@ -167,6 +189,96 @@ static void lUSI_USART_TransferReceivedData(USI_USART_OBJ* dObj, size_t bytesRcv
     }
 }
 
+static void lUSI_USART_TransferReceivedData(USI_USART_OBJ* dObj, uint8_t *pData,
+                                            size_t bytesRcv)
+{
+    size_t numByte = 0;
+    size_t slowEnd;
+    size_t fastByte;
+    uint32_t word;
+
+    if (bytesRcv < USI_FAST_MIN_LENGTH)
+    {
+        /* Short read: the word checks would not pay off */
+        lUSI_USART_ProcessBytes(dObj, pData, bytesRcv);
+        return;
+    }
+
+    while (numByte < bytesRcv)
+    {
+        if (dObj->slowLeft == 0U)
+        {
+            fastByte = numByte;
+
+            if (dObj->devStatus == USI_USART_IDLE)
+            {
+                /* Discard 4 bytes at once while there is no MSG KEY */
+                while ((bytesRcv - numByte) >= USI_WORD_SIZE)
+                {
+                    (void) memcpy(&word, &pData[numByte], USI_WORD_SIZE);
+                    if (USI_WORD_HAS_7E(word) != 0U)
+                    {
+                        break;
+                    }
+
+                    numByte += USI_WORD_SIZE;
+                }
+            }
+            else if (dObj->devStatus == USI_USART_RCV)
+            {
+                /* Store 4 bytes at once while there are no escape keys */
+                while (((bytesRcv - numByte) >= USI_WORD_SIZE) &&
+                       ((dObj->byteCount + USI_WORD_SIZE) <= dObj->rdBufferSize))
+                {
+                    (void) memcpy(&word, &pData[numByte], USI_WORD_SIZE);
+                    if (USI_WORD_HAS_ESC_KEY(word) != 0U)
+                    {
+                        break;
+                    }
+
+                    (void) memcpy(&dObj->pRdBuffer[dObj->byteCount], &word, USI_WORD_SIZE);
+                    dObj->byteCount += USI_WORD_SIZE;
+                    numByte += USI_WORD_SIZE;
+                }
+            }
+            else
+            {
+                /* Escape sequence pending: byte by byte */
+            }
+
+            /* Widen the byte by byte window while keys keep coming, so dense
+               escaped data does not pay the word check every 4 bytes */
+            if (numByte != fastByte)
+            {
+                dObj->slowWindow = USI_WORD_SIZE;
+            }
+            else if (dObj->slowWindow < USI_SLOW_WINDOW_MAX)
+            {
+                dObj->slowWindow <<= 1;
+            }
+            else
+            {
+                /* Keep maximum window */
+            }
+
+            /* The window goes on in the next reads if this one ends first:
+               short reads of dense data stay byte by byte */
+            dObj->slowLeft = dObj->slowWindow;
+        }
+
+        slowEnd = bytesRcv;
+        if ((bytesRcv - numByte) > dObj->slowLeft)
+        {
+            slowEnd = numByte + dObj->slowLeft;
+        }
+
+        dObj->slowLeft -= (slowEnd - numByte);
+
+        lUSI_USART_ProcessBytes(dObj, &pData[numByte], slowEnd - numByte);
+        numByte = slowEnd;
+    }
+}
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: USI USART Service Common Interface Implementation
@@ -190,6 +302,11 @@ void USI_USART_Initialize(uint32_t index, const void * const initData)
     dObj->usartReadBuffer = dObjInit->usartReadBuffer;
 
     dObj->byteCount = 0;
+    dObj->slowWindow = USI_WORD_SIZE;
+    dObj->slowLeft = 0;
+    dObj->rxOversize = 0;
+    dObj->rxBadEscape = 0;
+    dObj->txQueueHighWater = 0;
     dObj->cbFunc = NULL;
     dObj->devStatus = USI_USART_IDLE;
     dObj->usiStatus = SRV_USI_STATUS_NOT_CONFIGURED;
@@ -209,27 +326,44 @@ DRV_HANDLE USI_USART_Open(uint32_t index)
     return (DRV_HANDLE)index;
 }
 
-void USI_USART_Write(uint32_t index, void* pData, size_t length)
+size_t USI_USART_Write(uint32_t index, void* pData, size_t length)
 {
     USI_USART_OBJ* dObj = USI_USART_GET_INSTANCE(index);
+    size_t writeLength;
+    size_t pending;
 
     /* Check handler */
     if (dObj == NULL)
     {
-        return;
+        return 0;
     }
 
     if (length == 0U)
     {
-        return;
+        return 0;
     }
 
     if (dObj->usiStatus != SRV_USI_STATUS_CONFIGURED)
     {
-        return;
+        return 0;
     }
 
-    (void) dObj->plib->writeData(pData, length);
+    /* The whole frame is queued or discarded, never truncated. The PLIB
+       interrupt only frees room, so the frame fits after this check */
+    if (dObj->plib->writeFreeBufferCountGet() < length)
+    {
+        return 0;
+    }
+
+    writeLength = dObj->plib->writeData(pData, length);
+
+    pending = dObj->plib->writeCountGet();
+    if (pending > dObj->txQueueHighWater)
+    {
+        dObj->txQueueHighWater = (uint32_t)pending;
+    }
+
+    return writeLength;
 }
 
 void USI_USART_RegisterCallback(uint32_t index, USI_USART_CALLBACK cbFunc,
@@ -303,6 +437,32 @@ void USI_USART_Tasks (uint32_t index)
 
     if (bytesRcv != 0U)
     {
-        lUSI_USART_TransferReceivedData(dObj, bytesRcv);
+        lUSI_USART_TransferReceivedData(dObj, dObj->usartReadBuffer, bytesRcv);
     }
 }
+
+void USI_USART_GetLinkStats(uint32_t index, SRV_USI_LINK_STATS *stats)
+{
+    USI_USART_OBJ* dObj = USI_USART_GET_INSTANCE(index);
+
+    /* Check handler */
+    if (dObj == NULL)
+    {
+        return;
+    }
+
+    stats->rxOversize = dObj->rxOversize;
+    stats->rxBadEscape = dObj->rxBadEscape;
+    stats->txQueueHighWater = dObj->txQueueHighWater;
+}
+
+void USI_USART_DecodeData(USI_USART_OBJ* dObj, uint8_t *pData, size_t length)
+{
+    /* Check handler */
+    if ((dObj == NULL) || (pData == NULL))
+    {
+        return;
+    }
+
+    lUSI_USART_TransferReceivedData(dObj, pData, length);
+}
@@ -85,12 +85,15 @@ typedef void (* USI_USART_PLIB_CALLBACK)( uintptr_t context );
 
 typedef void(* USI_USART_PLIB_READ_CALLBACK_REG)(USI_USART_PLIB_CALLBACK callback, uintptr_t context);
 typedef size_t(* USI_USART_PLIB_WRRD)(void *buffer, const size_t size);
+typedef size_t(* USI_USART_PLIB_COUNT_GET)(void);
 
 typedef struct
 {
     USI_USART_PLIB_READ_CALLBACK_REG readCallbackRegister;
     USI_USART_PLIB_WRRD readData;
     USI_USART_PLIB_WRRD writeData;
+    USI_USART_PLIB_COUNT_GET writeCountGet;
+    USI_USART_PLIB_COUNT_GET writeFreeBufferCountGet;
     IRQn_Type intSource;
 } SRV_USI_USART_INTERFACE;
 
@@ -111,11 +114,17 @@ typedef struct
     size_t                                   rdBufferSize;
     size_t                                   byteCount;
     USI_USART_STATE                          devStatus;
+    size_t                                   slowWindow;
+    size_t                                   slowLeft;
     SRV_USI_STATUS                           usiStatus;
     uintptr_t                                context;
     
     size_t                                   usartBufferSize;
     uint8_t*                                 usartReadBuffer;
+
+    uint32_t                                 rxOversize;
+    uint32_t                                 rxBadEscape;
+    uint32_t                                 txQueueHighWater;
 } USI_USART_OBJ;
 
 // *****************************************************************************
@@ -130,7 +139,7 @@ DRV_HANDLE USI_USART_Open(uint32_t index);
 
 void USI_USART_Tasks (uint32_t index);
 
-void USI_USART_Write(uint32_t index, void* pData, size_t length);
+size_t USI_USART_Write(uint32_t index, void* pData, size_t length);
 
 void USI_USART_RegisterCallback(uint32_t index, USI_USART_CALLBACK cbFunc, uintptr_t context);
 
@@ -138,4 +147,11 @@ void USI_USART_Close(uint32_t index);
 
 SRV_USI_STATUS USI_USART_Status(uint32_t index);
 
+void USI_USART_GetLinkStats(uint32_t index, SRV_USI_LINK_STATS *stats);
+
+/* Decodes USI frames from raw serial data. It is shared with the DMA USART
+   transport (see srv_usi_usart_dma.c), which embeds an USI_USART_OBJ to keep
+   the decoder state */
+void USI_USART_DecodeData(USI_USART_OBJ* dObj, uint8_t *pData, size_t length);
+
 #endif //SRV_USI_USART_H
@@ -0,0 +1,488 @@
+/*******************************************************************************
+  USART DMA wrapper used from USI service Implementation
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    srv_usi_usart_dma.c
+
+  Summary:
+    USART DMA wrapper used from USI service implementation.
+
+  Description:
+    The USART DMA wrapper drives a FLEXCOM USART through its Peripheral DMA
+    Controller (PDC). Reception runs continuously on two DMA buffers used in
+    ping-pong: the PDC switches to the next buffer by hardware and the
+    interrupt only gives back the completed one. The task decodes up to the
+    PDC pointer, so that short frames are not delayed, and detects when the
+    PDC comes back to data not decoded yet. Transmission queues whole escaped
+    frames in a ring buffer which is sent with up to two chained PDC
+    transfers (the second one covers the ring wrap around).
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stddef.h>
+#include <string.h>
+#include "configuration.h"
+#include "driver/driver_common.h"
+#include "system/int/sys_int.h"
+#include "srv_usi_local.h"
+#include "srv_usi_usart_dma.h"
+#include "srv_usi_definitions.h"
+
+#if (SRV_USI_USART_DMA_CONNECTIONS > 0U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+/* This is the service instance object array. */
+const SRV_USI_DEV_DESC srvUSIUSARTDMADevDesc =
+{
+    .init                       = USI_USART_DMA_Initialize,
+    .open                       = USI_USART_DMA_Open,
+    .setReadCallback            = USI_USART_DMA_RegisterCallback,
+    .writeData                  = USI_USART_DMA_Write,
+    .task                       = USI_USART_DMA_Tasks,
+    .close                      = USI_USART_DMA_Close,
+    .status                     = USI_USART_DMA_Status,
+    .getLinkStats               = USI_USART_DMA_GetLinkStats,
+};
+
+static USI_USART_DMA_OBJ gUsiUsartDmaOBJ[SRV_USI_USART_DMA_CONNECTIONS] = {0};
+
+#define USI_USART_DMA_GET_INSTANCE(index)    (((index) >= SRV_USI_USART_DMA_CONNECTIONS)? NULL : &gUsiUsartDmaOBJ[index])
+
+/* USART errors */
+#define USI_USART_DMA_ERROR_MSK    (FLEX_US_CSR_OVRE_Msk | FLEX_US_CSR_FRAME_Msk | FLEX_US_CSR_PARE_Msk)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t lUSI_USART_DMA_GetReceivedCount(USI_USART_DMA_OBJ* dObj)
+{
+    uint32_t halfCount;
+    uint32_t dmaOffset;
+    uint32_t halfSize = (uint32_t)dObj->dmaRdHalfSize;
+
+    /* Take a consistent snapshot of completed halves and PDC pointer */
+    do
+    {
+        halfCount = dObj->rdHalfCount;
+        dmaOffset = dObj->regs->FLEX_RPR - (uint32_t)dObj->pDmaRdBuffer;
+    } while (halfCount != dObj->rdHalfCount);
+
+    if (dmaOffset >= (halfSize << 1))
+    {
+        /* PDC stopped at the end of the second half: same position as the
+           start of the first one */
+        dmaOffset = 0U;
+    }
+
+    if ((dmaOffset / halfSize) != (halfCount & 1U))
+    {
+        /* PDC already switched to the other half, but the end of reception
+           interrupt is still pending */
+        halfCount++;
+    }
+
+    return (halfCount * halfSize) + (dmaOffset % halfSize);
+}
+
+static bool lUSI_USART_DMA_CheckOverrun(USI_USART_DMA_OBJ* dObj, uint32_t rdReceived)
+{
+    uint32_t dmaRdBufferSize = (uint32_t)dObj->dmaRdHalfSize << 1;
+
+    if ((rdReceived - dObj->rdConsumed) <= dmaRdBufferSize)
+    {
+        return false;
+    }
+
+    /* DMA overwrote data not decoded yet: discard current frame and go on
+       from the oldest byte still in the buffer */
+    dObj->rxOverrun++;
+    dObj->rdConsumed = rdReceived - dmaRdBufferSize;
+    dObj->decoder.byteCount = 0;
+    dObj->decoder.devStatus = USI_USART_IDLE;
+
+    return true;
+}
+
+/* This routine is only called from ISR */
+static void lUSI_USART_DMA_TxStart(USI_USART_DMA_OBJ* dObj)
+{
+    uint32_t pending;
+    uint32_t wrIndex;
+    uint32_t firstLength;
+    flexcom_registers_t* regs = dObj->regs;
+
+    /* Previous transfers (current and next) are completed */
+    dObj->wrOutCount += dObj->wrDmaLength;
+    dObj->wrDmaLength = 0U;
+
+    pending = dObj->wrInCount - dObj->wrOutCount;
+    if (pending == 0U)
+    {
+        /* Nothing else to send */
+        regs->FLEX_US_IDR = FLEX_US_IDR_TXBUFE_Msk;
+        return;
+    }
+
+    /* First transfer up to the end of the ring, second one from its start */
+    wrIndex = dObj->wrOutCount % (uint32_t)dObj->dmaWrBufferSize;
+    firstLength = (uint32_t)dObj->dmaWrBufferSize - wrIndex;
+    if (firstLength > pending)
+    {
+        firstLength = pending;
+    }
+
+    regs->FLEX_TPR = (uint32_t)&dObj->pDmaWrBuffer[wrIndex];
+    regs->FLEX_TCR = firstLength;
+    if (pending > firstLength)
+    {
+        regs->FLEX_TNPR = (uint32_t)dObj->pDmaWrBuffer;
+        regs->FLEX_TNCR = pending - firstLength;
+    }
+
+    dObj->wrDmaLength = pending;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: USI USART DMA Service Common Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void USI_USART_DMA_Initialize(uint32_t index, const void * const initData)
+{
+    USI_USART_DMA_OBJ* dObj = USI_USART_DMA_GET_INSTANCE(index);
+    const USI_USART_DMA_INIT_DATA * const dObjInit = (const USI_USART_DMA_INIT_DATA * const)initData;
+    flexcom_registers_t* regs;
+
+    if (dObj == NULL)
+    {
+        return;
+    }
+
+    /* Frame decoder */
+    (void) memset(&dObj->decoder, 0, sizeof(dObj->decoder));
+    dObj->decoder.pRdBuffer = dObjInit->pRdBuffer;
+    dObj->decoder.rdBufferSize = dObjInit->rdBufferSize;
+    dObj->decoder.devStatus = USI_USART_IDLE;
+    dObj->decoder.slowWindow = USI_WORD_SIZE;
+    dObj->decoder.slowLeft = 0;
+    dObj->decoder.usiStatus = SRV_USI_STATUS_NOT_CONFIGURED;
+
+    dObj->regs = dObjInit->regs;
+    dObj->pDmaRdBuffer = dObjInit->pDmaRdBuffer;
+    dObj->dmaRdHalfSize = dObjInit->dmaRdBufferSize >> 1;
+    dObj->rdHalfCount = 0;
+    dObj->rdConsumed = 0;
+    dObj->pDmaWrBuffer = dObjInit->pDmaWrBuffer;
+    dObj->dmaWrBufferSize = dObjInit->dmaWrBufferSize;
+    dObj->wrInCount = 0;
+    dObj->wrOutCount = 0;
+    dObj->wrDmaLength = 0;
+    dObj->rxOverrun = 0;
+    dObj->txQueueHighWater = 0;
+    dObj->rxUsartOverrun = 0;
+    dObj->rxFramingError = 0;
+    dObj->rxParityError = 0;
+
+    regs = dObj->regs;
+
+    /* Take the USART interrupts over from the PLIB */
+    regs->FLEX_US_IDR = 0xFFFFFFFFU;
+    regs->FLEX_PTCR = FLEX_PTCR_RXTDIS_Msk | FLEX_PTCR_TXTDIS_Msk;
+    regs->FLEX_US_CR = FLEX_US_CR_RSTSTA_Msk;
+
+    /* Reception: first half as current transfer, second half as next */
+    regs->FLEX_RPR = (uint32_t)dObj->pDmaRdBuffer;
+    regs->FLEX_RCR = (uint32_t)dObj->dmaRdHalfSize;
+    regs->FLEX_RNPR = (uint32_t)&dObj->pDmaRdBuffer[dObj->dmaRdHalfSize];
+    regs->FLEX_RNCR = (uint32_t)dObj->dmaRdHalfSize;
+
+    /* Transmission: idle */
+    regs->FLEX_TCR = 0U;
+    regs->FLEX_TNCR = 0U;
+
+    /* Interrupts: end of reception half and USART errors. No idle line
+       time-out: the task decodes the half being filled up to the PDC
+       pointer, so a partial frame does not wait for the half to end */
+    regs->FLEX_US_IER = FLEX_US_IER_ENDRX_Msk | FLEX_US_IER_OVRE_Msk |
+                        FLEX_US_IER_FRAME_Msk | FLEX_US_IER_PARE_Msk;
+    regs->FLEX_PTCR = FLEX_PTCR_RXTEN_Msk | FLEX_PTCR_TXTEN_Msk;
+}
+
+DRV_HANDLE USI_USART_DMA_Open(uint32_t index)
+{
+    USI_USART_DMA_OBJ* dObj = USI_USART_DMA_GET_INSTANCE(index);
+
+    if (dObj == NULL)
+    {
+        return DRV_HANDLE_INVALID;
+    }
+
+    dObj->decoder.usiStatus = SRV_USI_STATUS_CONFIGURED;
+
+    return (DRV_HANDLE)index;
+}
+
+size_t USI_USART_DMA_Write(uint32_t index, void* pData, size_t length)
+{
+    USI_USART_DMA_OBJ* dObj = USI_USART_DMA_GET_INSTANCE(index);
+    uint8_t* pSrc = (uint8_t*)pData;
+    uint32_t wrIndex;
+    uint32_t firstLength;
+    uint32_t pending;
+
+    /* Check handler */
+    if (dObj == NULL)
+    {
+        return 0;
+    }
+
+    if (length == 0U)
+    {
+        return 0;
+    }
+
+    if (dObj->decoder.usiStatus != SRV_USI_STATUS_CONFIGURED)
+    {
+        return 0;
+    }
+
+    /* The whole frame is queued or discarded, never truncated */
+    if (length > (dObj->dmaWrBufferSize - (dObj->wrInCount - dObj->wrOutCount)))
+    {
+        return 0;
+    }
+
+    /* Copy frame to the ring, wrapping around at its end */
+    wrIndex = dObj->wrInCount % (uint32_t)dObj->dmaWrBufferSize;
+    firstLength = (uint32_t)dObj->dmaWrBufferSize - wrIndex;
+    if (firstLength > length)
+    {
+        firstLength = (uint32_t)length;
+    }
+
+    (void) memcpy(&dObj->pDmaWrBuffer[wrIndex], pSrc, firstLength);
+    (void) memcpy(dObj->pDmaWrBuffer, &pSrc[firstLength], length - firstLength);
+    dObj->wrInCount += (uint32_t)length;
+
+    pending = dObj->wrInCount - dObj->wrOutCount;
+    if (pending > dObj->txQueueHighWater)
+    {
+        dObj->txQueueHighWater = pending;
+    }
+
+    /* The ISR programs the PDC as soon as the transmitter is idle */
+    dObj->regs->FLEX_US_IER = FLEX_US_IER_TXBUFE_Msk;
+
+    return length;
+}
+
+void USI_USART_DMA_RegisterCallback(uint32_t index, USI_USART_CALLBACK cbFunc,
+        uintptr_t context)
+{
+    USI_USART_DMA_OBJ* dObj = USI_USART_DMA_GET_INSTANCE(index);
+
+    /* Check handler */
+    if (dObj == NULL)
+    {
+        return;
+    }
+
+    if (dObj->decoder.usiStatus != SRV_USI_STATUS_CONFIGURED)
+    {
+        return;
+    }
+
+    /* Set callback function */
+    dObj->decoder.cbFunc = cbFunc;
+
+    /* Set context related to cbFunc */
+    dObj->decoder.context = context;
+}
+
+void USI_USART_DMA_Close(uint32_t index)
+{
+    USI_USART_DMA_OBJ* dObj = USI_USART_DMA_GET_INSTANCE(index);
+
+    /* Check handler */
+    if (dObj == NULL)
+    {
+        return;
+    }
+
+    dObj->decoder.usiStatus = SRV_USI_STATUS_NOT_CONFIGURED;
+}
+
+SRV_USI_STATUS USI_USART_DMA_Status(uint32_t index)
+{
+    USI_USART_DMA_OBJ* dObj = USI_USART_DMA_GET_INSTANCE(index);
+
+    /* Check handler */
+    if (dObj == NULL)
+    {
+        return SRV_USI_STATUS_ERROR;
+    }
+
+    return dObj->decoder.usiStatus;
+}
+
+void USI_USART_DMA_GetLinkStats(uint32_t index, SRV_USI_LINK_STATS *stats)
+{
+    USI_USART_DMA_OBJ* dObj = USI_USART_DMA_GET_INSTANCE(index);
+
+    /* Check handler */
+    if (dObj == NULL)
+    {
+        return;
+    }
+
+    stats->rxOversize = dObj->decoder.rxOversize;
+    stats->rxBadEscape = dObj->decoder.rxBadEscape;
+    /* Overruns of the DMA buffer (task) and of the USART (ISR) */
+    stats->rxOverrun = dObj->rxOverrun + dObj->rxUsartOverrun;
+    stats->rxFramingError = dObj->rxFramingError;
+    stats->rxParityError = dObj->rxParityError;
+    stats->txQueueHighWater = dObj->txQueueHighWater;
+}
+
+void USI_USART_DMA_Tasks (uint32_t index)
+{
+    USI_USART_DMA_OBJ* dObj = USI_USART_DMA_GET_INSTANCE(index);
+    uint32_t rdReceived;
+    uint32_t rdIndex;
+    uint32_t rdLength;
+    uint32_t dmaRdBufferSize;
+
+    /* Check handler */
+    if (dObj == NULL)
+    {
+        return;
+    }
+
+    if (dObj->decoder.usiStatus != SRV_USI_STATUS_CONFIGURED)
+    {
+        return;
+    }
+
+    rdReceived = lUSI_USART_DMA_GetReceivedCount(dObj);
+    (void) lUSI_USART_DMA_CheckOverrun(dObj, rdReceived);
+
+    /* Decode data directly from the DMA buffer, in up to two chunks */
+    dmaRdBufferSize = (uint32_t)dObj->dmaRdHalfSize << 1;
+    while (dObj->rdConsumed != rdReceived)
+    {
+        rdIndex = dObj->rdConsumed % dmaRdBufferSize;
+        rdLength = dmaRdBufferSize - rdIndex;
+        if (rdLength > (rdReceived - dObj->rdConsumed))
+        {
+            rdLength = rdReceived - dObj->rdConsumed;
+        }
+
+        USI_USART_DecodeData(&dObj->decoder, &dObj->pDmaRdBuffer[rdIndex], rdLength);
+
+        /* The PDC goes on while the chunk is decoded and the callbacks run:
+           check that it has not come back to the bytes just decoded. If
+           so, the frames of the chunk may have been damaged (the service
+           drops them by CRC) and the next task goes on from the new data */
+        if (lUSI_USART_DMA_CheckOverrun(dObj, lUSI_USART_DMA_GetReceivedCount(dObj)) == true)
+        {
+            return;
+        }
+
+        dObj->rdConsumed += rdLength;
+    }
+}
+
+void USI_USART_DMA_InterruptHandler(uint32_t index)
+{
+    USI_USART_DMA_OBJ* dObj = USI_USART_DMA_GET_INSTANCE(index);
+    flexcom_registers_t* regs;
+    uint32_t status;
+    uint32_t halfIndex;
+
+    if (dObj == NULL)
+    {
+        return;
+    }
+
+    regs = dObj->regs;
+    status = regs->FLEX_US_CSR & regs->FLEX_US_IMR;
+
+    if ((status & FLEX_US_CSR_ENDRX_Msk) != 0U)
+    {
+        /* PDC moved to the next half: give the completed one back as next
+           transfer (this clears ENDRX) */
+        halfIndex = dObj->rdHalfCount & 1U;
+        dObj->rdHalfCount++;
+        regs->FLEX_RNPR = (uint32_t)&dObj->pDmaRdBuffer[halfIndex * dObj->dmaRdHalfSize];
+        regs->FLEX_RNCR = (uint32_t)dObj->dmaRdHalfSize;
+    }
+
+    if ((status & USI_USART_DMA_ERROR_MSK) != 0U)
+    {
+        /* Byte(s) lost or damaged in the USART: the frame decoder detects
+           the damage */
+        if ((status & FLEX_US_CSR_OVRE_Msk) != 0U)
+        {
+            dObj->rxUsartOverrun++;
+        }
+
+        if ((status & FLEX_US_CSR_FRAME_Msk) != 0U)
+        {
+            dObj->rxFramingError++;
+        }
+
+        if ((status & FLEX_US_CSR_PARE_Msk) != 0U)
+        {
+            dObj->rxParityError++;
+        }
+
+        regs->FLEX_US_CR = FLEX_US_CR_RSTSTA_Msk;
+    }
+
+    if ((status & FLEX_US_CSR_TXBUFE_Msk) != 0U)
+    {
+        lUSI_USART_DMA_TxStart(dObj);
+    }
+}
+
+#endif /* SRV_USI_USART_DMA_CONNECTIONS > 0U */
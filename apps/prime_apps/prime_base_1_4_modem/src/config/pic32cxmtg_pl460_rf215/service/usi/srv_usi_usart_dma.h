@@ -0,0 +1,159 @@
+/*******************************************************************************
+  USART DMA wrapper used from USI service Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    srv_usi_usart_dma.h
+
+  Summary
+    USART DMA wrapper used from USI service interface.
+
+  Description
+    The USART DMA wrapper drives a FLEXCOM USART through its Peripheral DMA
+    Controller (PDC), so that serial data is moved without an interrupt per
+    byte. Reception uses two DMA buffers in ping-pong, decoded by the task up
+    to the PDC pointer. Transmission queues whole frames in a ring
+    buffer which is sent with chained PDC transfers.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+// DOM-IGNORE-END
+
+#ifndef SRV_USI_USART_DMA_H    // Guards against multiple inclusion
+#define SRV_USI_USART_DMA_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "device.h"
+#include "system/system.h"
+#include "service/usi/srv_usi.h"
+#include "service/usi/srv_usi_usart.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+extern const SRV_USI_DEV_DESC srvUSIUSARTDMADevDesc;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    /* FLEXCOM peripheral, already initialized in USART mode by its PLIB */
+    flexcom_registers_t*                     regs;
+    /* Buffer to store the decoded USI frame */
+    uint8_t*                                 pRdBuffer;
+    size_t                                   rdBufferSize;
+    /* DMA reception buffer, split in two halves used in ping-pong */
+    uint8_t*                                 pDmaRdBuffer;
+    size_t                                   dmaRdBufferSize;
+    /* DMA transmission ring buffer */
+    uint8_t*                                 pDmaWrBuffer;
+    size_t                                   dmaWrBufferSize;
+} USI_USART_DMA_INIT_DATA;
+
+typedef struct
+{
+    /* USI frame decoder (shared with USART wrapper) */
+    USI_USART_OBJ                            decoder;
+
+    flexcom_registers_t*                     regs;
+
+    uint8_t*                                 pDmaRdBuffer;
+    size_t                                   dmaRdHalfSize;
+    /* Number of DMA reception halves completed (updated from ISR) */
+    volatile uint32_t                        rdHalfCount;
+    /* Number of bytes of the DMA reception buffer already decoded */
+    uint32_t                                 rdConsumed;
+
+    uint8_t*                                 pDmaWrBuffer;
+    size_t                                   dmaWrBufferSize;
+    /* Bytes queued to transmit (free-running, updated from task) */
+    volatile uint32_t                        wrInCount;
+    /* Bytes already transmitted (free-running, updated from ISR) */
+    volatile uint32_t                        wrOutCount;
+    /* Bytes programmed in the PDC transmitter (updated from ISR) */
+    volatile uint32_t                        wrDmaLength;
+
+    /* Statistics. Each counter is updated either from the task or from the
+       ISR, never from both, so that no increment is lost */
+    uint32_t                                 rxOverrun;
+    uint32_t                                 txQueueHighWater;
+    volatile uint32_t                        rxUsartOverrun;
+    volatile uint32_t                        rxFramingError;
+    volatile uint32_t                        rxParityError;
+} USI_USART_DMA_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SRV_USI Common Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void USI_USART_DMA_Initialize(uint32_t index, const void * const initData);
+
+DRV_HANDLE USI_USART_DMA_Open(uint32_t index);
+
+void USI_USART_DMA_Tasks (uint32_t index);
+
+size_t USI_USART_DMA_Write(uint32_t index, void* pData, size_t length);
+
+void USI_USART_DMA_RegisterCallback(uint32_t index, USI_USART_CALLBACK cbFunc, uintptr_t context);
+
+void USI_USART_DMA_Close(uint32_t index);
+
+SRV_USI_STATUS USI_USART_DMA_Status(uint32_t index);
+
+void USI_USART_DMA_GetLinkStats(uint32_t index, SRV_USI_LINK_STATS *stats);
+
+/* FLEXCOM interrupt handler of the USART DMA wrapper. When this wrapper is
+   used, the FLEXCOMx_InterruptHandler of the USART PLIB has to be replaced in
+   interrupts.c by a handler calling this function */
+void USI_USART_DMA_InterruptHandler(uint32_t index);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+// DOM-IGNORE-END
+
+#endif //SRV_USI_USART_DMA_H
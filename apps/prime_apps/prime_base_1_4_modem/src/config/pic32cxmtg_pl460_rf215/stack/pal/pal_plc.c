@@ -73,10 +73,24 @@ Microchip or any third party.
 /* It doesn't affect to relative time between RX and TX (compensated) */
 #define PAL_PLC_TIMER_SYNC_OFFSET    6U
 
-/* Maximum and minimum relative frequency between PL360 and host timers (F_host/F_360 [uQ1.24]) */
-/* It is used to detect wrong timer reads */
-#define SYNC_TIMER_REL_FREQ_MAX  0x01000D1BU /* +200 PPM */
-#define SYNC_TIMER_REL_FREQ_MIN  0x00FFF2E5U /* -200 PPM */
+/* Relative frequency between PL360 and host timers (F_host/F_360 [uQ2.30]) */
+#define SYNC_TIMER_REL_FREQ_ONE  0x40000000U
+/* Maximum and minimum relative frequency. It is used to detect wrong timer reads */
+#define SYNC_TIMER_REL_FREQ_MAX  0x400346DCU /* +200 PPM */
+#define SYNC_TIMER_REL_FREQ_MIN  0x3FFCB924U /* -200 PPM */
+
+/* Minimum and maximum interval in us between timer synchronizations */
+#define SYNC_DELAY_MIN           50000U
+#define SYNC_DELAY_MAX           10000000U
+
+/* Prediction error in us at synchronization to lengthen / shorten interval.
+ * The frequency is measured between two reads (last interval), not filtered
+ * (PLL or Kalman): over 50 ms or more the read jitter (1 us) is below the
+ * drift to track, and a filter would lag behind temperature changes. With
+ * +/-50 ppm plus random walk the timestamp error stays within 8 us and
+ * half the reads of fixed intervals (host test palPlc_TimerSyncDrift*) */
+#define SYNC_ERROR_LOW           1
+#define SYNC_ERROR_HIGH          3
 
 /* Time in us of chirp */
 #define PHY_CHIRP_TIME                 (2048U)
@@ -90,6 +104,9 @@ Microchip or any third party.
 #define PHY_HEADER_TIME                (4480U)
 #define PHY_HEADER_B_BC_TIME           (2240U * 4U)
 
+/* Period in ms to poll the status of a signal capture */
+#define PAL_PLC_CAPTURE_POLL_MS        (5U)
+
 #define DIV_ROUND(a, b)                (((a) + (b >> 1)) / (b))
 #define MAX(a, b)                      (((a) > (b)) ?  (a) : (b))
 #define MIN(a, b)                      (((a) < (b)) ?  (a) : (b))
@@ -135,6 +152,14 @@ static const uint8_t palPlcSymbolSize[14] = {
     12, 24, 36, 0, 6, 12, 18, 0, 0, 0, 0, 0, 6, 12
 };
 
+/* Reciprocal of the symbol size, ceil(2^32 / size): the number of symbols
+ * is ((bytes + size - 1) * inverse) >> 32, exact for any 16-bit length plus
+ * the flushing byte */
+static const uint32_t palPlcSymbolSizeInv[14] = {
+    357913942UL, 178956971UL, 119304648UL, 0UL, 715827883UL, 357913942UL,
+    238609295UL, 0UL, 0UL, 0UL, 0UL, 0UL, 715827883UL, 357913942UL
+};
+
 static const uint32_t palPlcTimeChirpHeader[4] = {
     PHY_CHIRP_TIME + PHY_HEADER_TIME,
     0,
@@ -147,6 +172,81 @@ static const uint32_t palPlcTimeChirpHeader[4] = {
 // Section: File Scope Functions
 // *****************************************************************************
 // *****************************************************************************
+static bool lPAL_PLC_GetPayloadSymbols(uint16_t length, PAL_SCHEME scheme, PAL_FRAME frameType, uint16_t *pSymbols)
+{
+    /* 32-bit: the flushing byte does not wrap the maximum length */
+    uint32_t frameLen;
+    uint16_t symbols;
+    uint8_t symbolSize;
+
+    if (((uint8_t)scheme >= sizeof(palPlcSymbolSize)) || ((frameType != PAL_FRAME_TYPE_A) &&
+            (frameType != PAL_FRAME_TYPE_B) && (frameType != PAL_FRAME_TYPE_BC)))
+    {
+        return false;
+    }
+
+    symbolSize = palPlcSymbolSize[scheme];
+    if (symbolSize == 0U)
+    {
+        return false;
+    }
+
+    frameLen = length;
+
+    if (frameType == PAL_FRAME_TYPE_A)
+    {
+        /* There are 7 bytes inside the header */
+        if (frameLen < 7U)
+        {
+            frameLen = 0;
+        }
+        else
+        {
+            frameLen -= 7U;
+        }
+    }
+
+    if (scheme >= PAL_SCHEME_DBPSK_C)
+    {
+        /* Increase a byte for flushing */
+        frameLen++;
+    }
+
+    /* Round up to whole symbols */
+    symbols = (uint16_t)((((uint64_t)frameLen + symbolSize - 1U) *
+            palPlcSymbolSizeInv[scheme]) >> 32);
+
+    /* adjust ROB scheme */
+    if (((uint8_t)(scheme) & 0x08U) > 0U)
+    {
+        symbols <<= 2;
+    }
+
+    *pSymbols = symbols;
+
+    return true;
+}
+
+static uint16_t lPAL_PLC_GetSnifferPayloadSymbols(uint16_t length, PAL_SCHEME scheme, PAL_FRAME frameType,
+    DRV_PLC_PHY_ID pibId)
+{
+    uint16_t symbols;
+
+    if (lPAL_PLC_GetPayloadSymbols(length, scheme, frameType, &symbols) == false)
+    {
+        /* Not covered by the symbol table: ask PLC transceiver */
+        palPlcData.plcPIB.id = pibId;
+        palPlcData.plcPIB.length = 2;
+        palPlcData.plcPIB.pData = (uint8_t *)&symbols;
+        if (DRV_PLC_PHY_PIBGet(palPlcData.drvPhyHandle, &palPlcData.plcPIB) == false)
+        {
+            symbols = 0;
+        }
+    }
+
+    return symbols;
+}
+
 static void lPAL_PLC_SysTimeCB( uintptr_t context )
 {
     palPlcData.syncUpdate = true;
@@ -246,6 +346,66 @@ static uint32_t lPAL_PLC_TimerSyncRead(uint32_t *pTimePlc)
     return timeHost;
 }
 
+static void lPAL_PLC_TimerSyncSetRelFreq(uint32_t relFreq)
+{
+    /* Inverse relative frequency F_360/F_host [uQ2.30], so that conversion
+     * from host to PLC time does not need any division */
+    palPlcData.syncTimerRelFreq = relFreq;
+    palPlcData.syncTimerRelFreqInv = (uint32_t)DIV_ROUND(1ULL << 60, (uint64_t)relFreq);
+}
+
+static void lPAL_PLC_TimerSyncProgram(void)
+{
+    /* Program next interrupt */
+    palPlcData.syncHandle = SRV_TIME_MANAGEMENT_CbRegisterUS(
+            lPAL_PLC_SysTimeCB, 0, palPlcData.syncDelay, SYS_TIME_SINGLE);
+    if (palPlcData.syncHandle != SYS_TIME_HANDLE_INVALID)
+    {
+        palPlcData.syncUpdate = false;
+    }
+    else
+    {
+        /* Retry synchronization from tasks */
+        palPlcData.syncUpdate = true;
+    }
+}
+
+static uint32_t lPAL_PLC_GetHostTime(uint32_t timePlc)
+{
+    int32_t delayPlc;
+    int64_t delayHost;
+
+    /* Compute PLC delay time since last synchronization (timer wrap safe) */
+    delayPlc = (int32_t)(timePlc - palPlcData.timeRefPlc);
+
+/* MISRA C-2012 deviation block start */
+/* MISRA C-2012 Rule 10.1 deviated once. Deviation record ID - H3_MISRAC_2012_R_10_1_DR_1 */
+    /* Convert PLC delay to Host delay (frequency deviation) */
+    delayHost = (((int64_t)delayPlc * (int64_t)palPlcData.syncTimerRelFreq) + (1L << 29)) >> 30;
+/* MISRA C-2012 deviation block end */
+
+    /* Compute Host time */
+    return palPlcData.timeRefHost + (uint32_t)delayHost;
+}
+
+static uint32_t lPAL_PLC_GetPlcTime(uint32_t timeHost)
+{
+    int32_t delayHost;
+    int64_t delayPlc;
+
+    /* Compute Host delay time since last synchronization (timer wrap safe) */
+    delayHost = (int32_t)(timeHost - palPlcData.timeRefHost);
+
+/* MISRA C-2012 deviation block start */
+/* MISRA C-2012 Rule 10.1 deviated once. Deviation record ID - H3_MISRAC_2012_R_10_1_DR_1 */
+    /* Convert Host delay to PLC delay (frequency deviation) */
+    delayPlc = (((int64_t)delayHost * (int64_t)palPlcData.syncTimerRelFreqInv) + (1L << 29)) >> 30;
+/* MISRA C-2012 deviation block end */
+
+    /* Compute PLC time */
+    return palPlcData.timeRefPlc + (uint32_t)delayPlc;
+}
+
 __STATIC_INLINE void lPAL_PLC_TimerSyncInitialize(void)
 {
     if (!palPlcData.syncEnable)
@@ -257,23 +417,13 @@ __STATIC_INLINE void lPAL_PLC_TimerSyncInitialize(void)
         /* Get initial timer references */
         palPlcData.timeRefHost = lPAL_PLC_TimerSyncRead(&palPlcData.timeRefPlc);
 
-        /* Initialize relative frequency F_host/F_plc to 1 [uQ1.24] */
-        palPlcData.syncTimerRelFreq = 1UL << 24;
+        /* Initialize relative frequency F_host/F_plc to 1 */
+        lPAL_PLC_TimerSyncSetRelFreq(SYNC_TIMER_REL_FREQ_ONE);
 
         /* Program first interrupt after 50 ms (5 us deviation with 100 PPM) */
-        palPlcData.syncDelay = 50000;
+        palPlcData.syncDelay = SYNC_DELAY_MIN;
         (void)SYS_TIME_TimerDestroy(palPlcData.syncHandle);
-        palPlcData.syncHandle = SRV_TIME_MANAGEMENT_CbRegisterUS(
-                lPAL_PLC_SysTimeCB, 0, palPlcData.syncDelay, SYS_TIME_SINGLE);
-        if (palPlcData.syncHandle != SYS_TIME_HANDLE_INVALID)
-        {
-            palPlcData.syncUpdate = false;
-        }
-        else
-        {
-            palPlcData.syncDelay = 0;
-            palPlcData.syncUpdate = true;
-        }
+        lPAL_PLC_TimerSyncProgram();
     }
 }
 
@@ -283,7 +433,7 @@ __STATIC_INLINE void lPAL_PLC_TimerSyncUpdate(void)
     uint32_t delayHost;
     uint32_t delayPlc;
     uint32_t syncTimerRelFreq;
-    uint64_t delayAux;
+    int32_t syncError;
 
     /* Get current Host and PLC timers */
     timeHost = lPAL_PLC_TimerSyncRead(&timePlcSync);
@@ -292,124 +442,407 @@ __STATIC_INLINE void lPAL_PLC_TimerSyncUpdate(void)
     delayHost = timeHost - palPlcData.timeRefHost;
     delayPlc = timePlcSync - palPlcData.timeRefPlc;
 
-    /* Compute relative frequency F_host/F_plc [uQ1.24] */
-    delayAux = DIV_ROUND((uint64_t)delayHost << 24, (uint64_t)(delayPlc));
-    syncTimerRelFreq = (uint32_t)(delayAux);
+    if (delayHost < (SYNC_DELAY_MIN >> 1))
+    {
+        /* Interval too short to measure frequency (timer programming failed):
+         * keep references and program timer again */
+        lPAL_PLC_TimerSyncProgram();
+        return;
+    }
+
+    /* Compute relative frequency F_host/F_plc [uQ2.30] measured in the interval */
+    syncTimerRelFreq = 0;
+    if (delayPlc != 0U)
+    {
+        syncTimerRelFreq = (uint32_t)DIV_ROUND((uint64_t)delayHost << 30, (uint64_t)(delayPlc));
+    }
 
     /* Check if relative frequency is consistent, otherwise timer read is wrong */
-    if ((syncTimerRelFreq >= SYNC_TIMER_REL_FREQ_MIN) && (syncTimerRelFreq <= SYNC_TIMER_REL_FREQ_MAX))
+    if ((syncTimerRelFreq < SYNC_TIMER_REL_FREQ_MIN) || (syncTimerRelFreq > SYNC_TIMER_REL_FREQ_MAX))
     {
-        /* Update relative frequency and references */
-        palPlcData.syncTimerRelFreq = syncTimerRelFreq;
-        palPlcData.timeRefHost = timeHost;
-        palPlcData.timeRefPlc = timePlcSync;
+        SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_ERROR,
+                (SRV_LOG_REPORT_CODE)PAL_PLC_TIMER_SYNC_ERROR,
+                "PRIME_PAL_PLC: PLC timer synchronization error\r\n");
+        lPAL_PLC_TimerSyncInitialize();
+        return;
+    }
 
-        switch (palPlcData.syncDelay)
-        {
-            case 0:
-                /* Next sync after 50 ms (5 us deviation with 100 PPM) */
-                palPlcData.syncDelay = 50000;
-                break;
+    /* Error of the Host time predicted with the current estimation */
+    syncError = (int32_t)(timeHost - lPAL_PLC_GetHostTime(timePlcSync));
 
-            case 50000:
-                /* Next sync after 250 ms (5 us deviation with 20 PPM) */
-                palPlcData.syncDelay = 250000;
-                break;
+    /* Adapt interval to the prediction error: lengthen it while the
+     * frequency estimation is accurate, shorten it quickly when frequency
+     * drifts (e.g. temperature change) */
+    if ((syncError <= SYNC_ERROR_LOW) && (syncError >= -SYNC_ERROR_LOW))
+    {
+        palPlcData.syncDelay = MIN(palPlcData.syncDelay << 1, SYNC_DELAY_MAX);
+    }
+    else if ((syncError > SYNC_ERROR_HIGH) || (syncError < -SYNC_ERROR_HIGH))
+    {
+        palPlcData.syncDelay = MAX(palPlcData.syncDelay >> 2, SYNC_DELAY_MIN);
+    }
+    else
+    {
+        /* Keep interval */
+    }
 
-            case 250000:
-                /* Next sync after 1 second (5 us deviation with 5 PPM) */
-                palPlcData.syncDelay = 1000000;
-                break;
+    /* Update relative frequency and references. The frequency measured in
+     * the interval is the estimation for the next one */
+    lPAL_PLC_TimerSyncSetRelFreq(syncTimerRelFreq);
+    palPlcData.timeRefHost = timeHost;
+    palPlcData.timeRefPlc = timePlcSync;
 
-            default:
-                /* Next sync after 5 seconds (5 us deviation with 1 PPM) */
-                palPlcData.syncDelay = 5000000;
-                break;
-        }
+    lPAL_PLC_TimerSyncProgram();
+}
+
+static void lPAL_PLC_SetTxRxChannel(DRV_PLC_PHY_CHANNEL channel);
+
+static void lPAL_PLC_SetTxRxChannelEnd(DRV_PLC_PHY_CHANNEL channel)
+{
+    /* Initialize synchronization of PL360-Host timers when channel updated */
+    lPAL_PLC_TimerSyncInitialize();
+
+    SRV_PSNIFFER_SetPLCChannel((uint8_t)channel);
+}
+
+static void lPAL_PLC_CouplingCfgCb(DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs,
+    bool result, uintptr_t context)
+{
+    PAL_PLC_CHANNEL_DATA *pChange = &palPlcData.channelChange;
+
+    /* Avoid warning */
+    (void)pibObjs;
+    (void)numPibs;
+    (void)result;
+    (void)context;
+
+    pChange->busy = false;
+    lPAL_PLC_SetTxRxChannelEnd(pChange->channel);
+
+    if (pChange->nextPending)
+    {
+        /* Channel requested while this one was being set */
+        pChange->nextPending = false;
+        lPAL_PLC_SetTxRxChannel(pChange->nextChannel);
+    }
+}
+
+static void lPAL_PLC_ChannelCfgCb(DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs,
+    bool result, uintptr_t context)
+{
+    PAL_PLC_CHANNEL_DATA *pChange = &palPlcData.channelChange;
+
+    /* Avoid warning */
+    (void)pibObjs;
+    (void)numPibs;
+    (void)result;
+    (void)context;
+
+    /* Set coupling configuration */
+    if (SRV_PCOUP_SetChannelConfigRequest(palPlcData.drvPhyHandle, pChange->channel,
+            lPAL_PLC_CouplingCfgCb, 0) == false)
+    {
+        (void)SRV_PCOUP_SetChannelConfig(palPlcData.drvPhyHandle, pChange->channel);
+        lPAL_PLC_CouplingCfgCb(NULL, 0, false, 0);
+    }
+}
+
+static void lPAL_PLC_SetTxRxChannel(DRV_PLC_PHY_CHANNEL channel)
+{
+    PAL_PLC_CHANNEL_DATA *pChange = &palPlcData.channelChange;
+
+    if (pChange->busy)
+    {
+        /* Applied when the channel in progress is set */
+        pChange->nextChannel = channel;
+        pChange->nextPending = true;
+        return;
+    }
+
+    /* Set channel and coupling configuration from the PLC driver tasks,
+     * without waiting for the write guard times */
+    pChange->channel = channel;
+    pChange->channelCfg = (uint8_t)channel;
+    pChange->pib.id = PLC_ID_CHANNEL_CFG;
+    pChange->pib.length = 1;
+    pChange->pib.pData = &pChange->channelCfg;
+    if (DRV_PLC_PHY_PIBSetRequest(palPlcData.drvPhyHandle, &pChange->pib, 1,
+            lPAL_PLC_ChannelCfgCb, 0))
+    {
+        pChange->busy = true;
+        return;
+    }
 
-        /* Program next interrupt */
-        palPlcData.syncHandle = SRV_TIME_MANAGEMENT_CbRegisterUS(
-                lPAL_PLC_SysTimeCB, 0, palPlcData.syncDelay, SYS_TIME_SINGLE);
-        if (palPlcData.syncHandle != SYS_TIME_HANDLE_INVALID)
+    /* No room for the request: set it now */
+    (void)DRV_PLC_PHY_PIBSet(palPlcData.drvPhyHandle, &pChange->pib);
+    (void)SRV_PCOUP_SetChannelConfig(palPlcData.drvPhyHandle, channel);
+    lPAL_PLC_SetTxRxChannelEnd(channel);
+}
+
+static PAL_PLC_TX_DATA *lPAL_PLC_GetFreeTxData(uint8_t buffId)
+{
+    uint8_t index;
+
+    /* Buffer requested by MAC, if free */
+    if ((buffId < PAL_PLC_TX_BUFFERS_NUMBER) && (palPlcData.txData[buffId].state == PAL_PLC_TX_FREE))
+    {
+        palPlcData.txData[buffId].txObj.bufferId = (DRV_PLC_PHY_BUFFER_ID)buffId;
+        return &palPlcData.txData[buffId];
+    }
+
+    /* Otherwise, any free buffer */
+    for (index = 0; index < PAL_PLC_TX_BUFFERS_NUMBER; index++)
+    {
+        if (palPlcData.txData[index].state == PAL_PLC_TX_FREE)
         {
-            palPlcData.syncUpdate = false;
+            palPlcData.txData[index].txObj.bufferId = (DRV_PLC_PHY_BUFFER_ID)index;
+            return &palPlcData.txData[index];
         }
-        else
+    }
+
+    return NULL;
+}
+
+static PAL_PLC_TX_DATA *lPAL_PLC_GetBusyTxData(uint8_t buffId)
+{
+    uint8_t index;
+
+    for (index = 0; index < PAL_PLC_TX_BUFFERS_NUMBER; index++)
+    {
+        if ((palPlcData.txData[index].state == PAL_PLC_TX_BUSY) &&
+                (palPlcData.txData[index].buffId == buffId))
         {
-            palPlcData.syncDelay = 0;
+            return &palPlcData.txData[index];
         }
     }
-    else
+
+    return NULL;
+}
+
+static void lPAL_PLC_TxConfirm(uint8_t buffId, PAL_FRAME frameType, PAL_TX_RESULT result)
+{
+    if (palPlcData.plcCallbacks.dataConfirm != NULL)
     {
-        SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_ERROR,
-                (SRV_LOG_REPORT_CODE)PAL_PLC_TIMER_SYNC_ERROR,
-                "PRIME_PAL_PLC: PLC timer synchronization error\r\n");
-        lPAL_PLC_TimerSyncInitialize();
+        PAL_MSG_CONFIRM_DATA dataCfm;
+
+        dataCfm.txTime = 0;
+        dataCfm.rmsCalc = 0;
+        dataCfm.pch = lPAL_PLC_GetPCH(palPlcData.channel);
+        dataCfm.frameType = frameType;
+        dataCfm.bufId = buffId;
+        dataCfm.result = result;
+
+        palPlcData.plcCallbacks.dataConfirm(&dataCfm);
     }
 }
 
-static uint32_t lPAL_PLC_GetHostTime(uint32_t timePlc)
+static void lPAL_PLC_TxTasks(void)
 {
-    int64_t delayAux;
-    int64_t delayPlc;
-    int64_t delayHost;
-    int64_t timeHost;
+    uint8_t index;
+
+    /* Confirmations not reported by the PLC driver: requests received with
+     * both buffers in use */
+    for (index = 0; index < PAL_PLC_TX_BUFFERS_NUMBER; index++)
+    {
+        PAL_PLC_TX_BUSY_CFM *pBusyCfm = &palPlcData.txBusyCfm[index];
 
-    /* Compute PLC delay time since last sinchronization */
-    delayPlc = (int64_t)(timePlc) - (int64_t)(palPlcData.timeRefPlc);
+        if (pBusyCfm->pending)
+        {
+            pBusyCfm->pending = false;
+            lPAL_PLC_TxConfirm(pBusyCfm->buffId, pBusyCfm->frameType, PAL_TX_RESULT_BUSY_TX);
+        }
+    }
+}
 
-    /* Convert PLC delay to Host delay (frequency deviation) */
-    delayAux = delayPlc * (int64_t)palPlcData.syncTimerRelFreq;
+static void lPAL_PLC_SignalCapturePibCb(DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs,
+    bool result, uintptr_t context)
+{
+    PAL_PLC_CAPTURE_DATA *pCapture = &palPlcData.capture;
 
-/* MISRA C-2012 deviation block start */
-/* MISRA C-2012 Rule 10.1 deviated once. Deviation record ID - H3_MISRAC_2012_R_10_1_DR_1 */
-    delayHost = (delayAux + (1L << 23)) >> 24;
-/* MISRA C-2012 deviation block end */
+    /* Avoid warning */
+    (void)pibObjs;
+    (void)numPibs;
 
-    /* Compute Host time */
-    timeHost = (int64_t)palPlcData.timeRefHost + delayHost;
+    /* Discard responses to requests of an aborted capture */
+    if ((context != (uintptr_t)pCapture->id) || (pCapture->pibPending == 0U))
+    {
+        return;
+    }
 
-    return (uint32_t)(timeHost);
+    pCapture->pibPending--;
+    if (result == false)
+    {
+        pCapture->pibResult = false;
+    }
 }
 
-static uint32_t lPAL_PLC_GetPlcTime(uint32_t timeHost)
+static bool lPAL_PLC_SignalCapturePib(uint16_t id, void *pData, uint16_t length, bool set)
 {
-    int64_t delayPlc;
-    int64_t delayHost;
-    int64_t timePlc;
+    PAL_PLC_CAPTURE_DATA *pCapture = &palPlcData.capture;
+    DRV_PLC_PHY_PIB_OBJ *pibObj = &pCapture->pib[pCapture->pibPending];
+    bool result;
 
-    /* Compute Host delay time since last synchronization */
-    delayHost = (int64_t)(timeHost) - (int64_t)(palPlcData.timeRefHost);
+    pibObj->id = id;
+    pibObj->length = length;
+    pibObj->pData = (uint8_t *)pData;
 
-/* MISRA C-2012 deviation block start */
-/* MISRA C-2012 Rule 10.1 deviated twice. Deviation record ID - H3_MISRAC_2012_R_10_1_DR_1 */
-/* Convert Host delay to PLC delay (frequency deviation) */
-    delayPlc = delayHost << 24;
-    delayPlc = DIV_ROUND(delayPlc, (int64_t)(palPlcData.syncTimerRelFreq));
-/* MISRA C-2012 deviation block end */
+    if (set)
+    {
+        result = DRV_PLC_PHY_PIBSetRequest(palPlcData.drvPhyHandle, pibObj, 1,
+                lPAL_PLC_SignalCapturePibCb, (uintptr_t)pCapture->id);
+    }
+    else
+    {
+        result = DRV_PLC_PHY_PIBGetRequest(palPlcData.drvPhyHandle, pibObj, 1,
+                lPAL_PLC_SignalCapturePibCb, (uintptr_t)pCapture->id);
+    }
 
-    /* Compute PLC time */
-    timePlc = (int64_t)(palPlcData.timeRefPlc) + delayPlc;
+    if (result)
+    {
+        pCapture->pibPending++;
+    }
 
-    return (uint32_t)(timePlc);
+    return result;
 }
 
-static void lPAL_PLC_SetTxRxChannel(DRV_PLC_PHY_CHANNEL channel)
+static void lPAL_PLC_SignalCaptureEnd(uint16_t length)
 {
-    /* Set channel configuration */
-    palPlcData.plcPIB.id = PLC_ID_CHANNEL_CFG;
-    palPlcData.plcPIB.length = 1;
-    palPlcData.plcPIB.pData = &channel;
-    (void)DRV_PLC_PHY_PIBSet(palPlcData.drvPhyHandle, &palPlcData.plcPIB);
+    PAL_PLC_CAPTURE_DATA *pCapture = &palPlcData.capture;
 
-    /* Set coupling configuration */
-    (void)SRV_PCOUP_SetChannelConfig(palPlcData.drvPhyHandle, channel);
+    /* No PIB request of the capture is pending in the driver at this point,
+     * so the caller buffer is not accessed any more */
+    pCapture->state = PAL_PLC_CAPTURE_IDLE;
+    pCapture->id++;
 
-    /* Initialize synchronization of PL360-Host timers when channel updated */
-    lPAL_PLC_TimerSyncInitialize();
+    if (pCapture->callback != NULL)
+    {
+        pCapture->callback(pCapture->pData, length, pCapture->context);
+    }
+}
 
-    SRV_PSNIFFER_SetPLCChannel((uint8_t)channel);
+static void lPAL_PLC_SignalCaptureTasks(void)
+{
+    PAL_PLC_CAPTURE_DATA *pCapture = &palPlcData.capture;
+
+    if (pCapture->state == PAL_PLC_CAPTURE_IDLE)
+    {
+        return;
+    }
+
+    if (palPlcData.status != PAL_PLC_STATUS_READY)
+    {
+        /* PLC device reset or in error: abort capture */
+        pCapture->pibResult = false;
+    }
+
+    if (pCapture->pibPending > 0U)
+    {
+        /* Wait for PIB responses, also to abort: the driver keeps pointers
+         * to the capture PIB objects and the caller buffer until then. It
+         * completes pending requests with error if the PLC device is
+         * restarted or does not answer */
+        return;
+    }
+
+    if (pCapture->pibResult == false)
+    {
+        lPAL_PLC_SignalCaptureEnd(0);
+        return;
+    }
+
+    switch (pCapture->state)
+    {
+        case PAL_PLC_CAPTURE_WAIT_PREVIOUS:
+        case PAL_PLC_CAPTURE_RUNNING:
+        {
+            if ((pCapture->state == PAL_PLC_CAPTURE_WAIT_PREVIOUS) &&
+                    (pCapture->status.status != (uint8_t)SIGNAL_CAPTURE_RUNNING))
+            {
+                /* No previous capture running: start the new one */
+                pCapture->state = PAL_PLC_CAPTURE_START;
+                break;
+            }
+
+            if ((pCapture->state == PAL_PLC_CAPTURE_RUNNING) &&
+                    (pCapture->status.status == (uint8_t)SIGNAL_CAPTURE_READY))
+            {
+                /* Capture finished: read fragments */
+                pCapture->fragment = 0;
+                pCapture->length = 0;
+                pCapture->state = PAL_PLC_CAPTURE_READ_DATA;
+                break;
+            }
+
+            /* Poll status again once the poll period has elapsed */
+            if ((SYS_TIME_CounterGet() - pCapture->pollTime) < SYS_TIME_MSToCount(PAL_PLC_CAPTURE_POLL_MS))
+            {
+                break;
+            }
+
+            if (lPAL_PLC_SignalCapturePib(PLC_ID_SIGNAL_CAPTURE_STATUS, &pCapture->status,
+                    (uint16_t)sizeof(pCapture->status), false))
+            {
+                /* If the PIB queue is full, retry in next task */
+                pCapture->pollTime = SYS_TIME_CounterGet();
+            }
+
+            break;
+        }
 
+        case PAL_PLC_CAPTURE_START:
+        {
+            if (lPAL_PLC_SignalCapturePib(PLC_ID_SIGNAL_CAPTURE_START, pCapture->parameters,
+                    (uint16_t)sizeof(pCapture->parameters), true))
+            {
+                /* Status is read as soon as the capture is started */
+                pCapture->status.status = (uint8_t)SIGNAL_CAPTURE_IDLE;
+                pCapture->pollTime = SYS_TIME_CounterGet() - SYS_TIME_MSToCount(PAL_PLC_CAPTURE_POLL_MS);
+                pCapture->state = PAL_PLC_CAPTURE_RUNNING;
+            }
+
+            break;
+        }
+
+        case PAL_PLC_CAPTURE_READ_DATA:
+        {
+            if (pCapture->fragmentPending)
+            {
+                /* Previous fragment stored in the caller buffer */
+                pCapture->fragmentPending = false;
+                pCapture->length += SIGNAL_CAPTURE_FRAG_SIZE;
+                pCapture->fragment++;
+            }
+
+            if ((pCapture->fragment >= pCapture->status.numFrags) ||
+                    (((uint32_t)pCapture->length + SIGNAL_CAPTURE_FRAG_SIZE) > pCapture->maxLength))
+            {
+                /* All fragments read or caller buffer full (only whole
+                   fragments are reported) */
+                lPAL_PLC_SignalCaptureEnd(pCapture->length);
+                break;
+            }
+
+            /* Select fragment and read it to the caller buffer. If the PIB
+               queue is full, both requests are repeated in next task */
+            if (lPAL_PLC_SignalCapturePib(PLC_ID_SIGNAL_CAPTURE_FRAGMENT, &pCapture->fragment, 1, true))
+            {
+                if (lPAL_PLC_SignalCapturePib(PLC_ID_SIGNAL_CAPTURE_DATA, &pCapture->pData[pCapture->length],
+                        SIGNAL_CAPTURE_FRAG_SIZE, false))
+                {
+                    pCapture->fragmentPending = true;
+                }
+            }
+
+            break;
+        }
+
+        case PAL_PLC_CAPTURE_IDLE:
+        default:
+        {
+            /* Do nothing */
+            break;
+        }
+    }
 }
 
 // *****************************************************************************
@@ -419,6 +852,10 @@ static void lPAL_PLC_SetTxRxChannel(DRV_PLC_PHY_CHANNEL channel)
 // *****************************************************************************
 static void lPAL_PLC_PLC_DataCfmCb(DRV_PLC_PHY_TRANSMISSION_CFM_OBJ *pCfmObj, uintptr_t context)
 {
+    PAL_PLC_TX_DATA *pTxData = NULL;
+    DRV_PLC_PHY_TRANSMISSION_OBJ *pTxObj = &palPlcData.phyTxObj;
+    uint8_t bufId = (uint8_t)pCfmObj->bufferId;
+
     /* Avoid warning */
     (void)context;
 
@@ -433,16 +870,49 @@ static void lPAL_PLC_PLC_DataCfmCb(DRV_PLC_PHY_TRANSMISSION_CFM_OBJ *pCfmObj, ui
         return;
     }
 
+    /* Route confirmation to the transmission of its buffer */
+    if ((bufId < PAL_PLC_TX_BUFFERS_NUMBER) && (palPlcData.txData[bufId].state == PAL_PLC_TX_BUSY))
+    {
+        pTxData = &palPlcData.txData[bufId];
+        pTxObj = &pTxData->txObj;
+        bufId = pTxData->buffId;
+    }
+
+    pCfmObj->timeIni = lPAL_PLC_GetHostTime(pCfmObj->timeIni);
+
+    if ((palPlcData.snifferCallback) != NULL)
+    {
+        size_t dataLength;
+        uint16_t payloadSymbols;
+
+        payloadSymbols = lPAL_PLC_GetSnifferPayloadSymbols(pTxObj->dataLength,
+                (PAL_SCHEME)pTxObj->scheme, (PAL_FRAME)pTxObj->frameType,
+                PLC_ID_TX_PAY_SYMBOLS);
+        SRV_PSNIFFER_SetTxPayloadSymbols(payloadSymbols);
+
+        dataLength = SRV_PSNIFFER_SerialCfmMessage(palPlcData.snifferData, pCfmObj);
+
+        if (dataLength != 0U)
+        {
+            palPlcData.snifferCallback(palPlcData.snifferData, dataLength);
+        }
+    }
+
+    /* Release buffer before reporting, so that MAC can use it again */
+    if (pTxData != NULL)
+    {
+        pTxData->state = PAL_PLC_TX_FREE;
+    }
+
     if (palPlcData.plcCallbacks.dataConfirm != NULL)
     {
         PAL_MSG_CONFIRM_DATA dataCfm;
 
-        dataCfm.txTime = lPAL_PLC_GetHostTime(pCfmObj->timeIni);
-        pCfmObj->timeIni = dataCfm.txTime;  /* For sniffer */
+        dataCfm.txTime = pCfmObj->timeIni;
         dataCfm.rmsCalc = (uint16_t)pCfmObj->rmsCalc;
         dataCfm.pch = lPAL_PLC_GetPCH(palPlcData.channel);
         dataCfm.frameType = (PAL_FRAME)pCfmObj->frameType;
-        dataCfm.bufId = (uint8_t)pCfmObj->bufferId;
+        dataCfm.bufId = bufId;
 
         switch (pCfmObj->result)
         {
@@ -457,29 +927,6 @@ static void lPAL_PLC_PLC_DataCfmCb(DRV_PLC_PHY_TRANSMISSION_CFM_OBJ *pCfmObj, ui
 
         palPlcData.plcCallbacks.dataConfirm(&dataCfm);
     }
-
-    if ((palPlcData.snifferCallback) != NULL)
-    {
-        size_t dataLength;
-        uint16_t paySymbols;
-        uint16_t payloadSymbols;
-
-        palPlcData.plcPIB.id = PLC_ID_TX_PAY_SYMBOLS;
-        palPlcData.plcPIB.length = 2;
-        palPlcData.plcPIB.pData = (uint8_t *)&paySymbols;
-        (void)DRV_PLC_PHY_PIBGet(palPlcData.drvPhyHandle, &palPlcData.plcPIB);
-
-        payloadSymbols = (uint16_t)palPlcData.plcPIB.pData[0] | ((uint16_t)palPlcData.plcPIB.pData[1] << 8);
-        SRV_PSNIFFER_SetTxPayloadSymbols(payloadSymbols);
-
-        dataLength = SRV_PSNIFFER_SerialCfmMessage(palPlcData.snifferData, pCfmObj);
-
-        if (dataLength != 0U)
-        {
-            palPlcData.snifferCallback(palPlcData.snifferData, dataLength);
-        }
-    }
-
 }
 
 static void lPAL_PLC_PLC_DataIndCb(DRV_PLC_PHY_RECEPTION_OBJ *pIndObj, uintptr_t context)
@@ -535,11 +982,8 @@ static void lPAL_PLC_PLC_DataIndCb(DRV_PLC_PHY_RECEPTION_OBJ *pIndObj, uintptr_t
         size_t length;
         uint16_t paySymbols;
 
-        palPlcData.plcPIB.id = PLC_ID_RX_PAY_SYMBOLS;
-        palPlcData.plcPIB.length = 2;
-        palPlcData.plcPIB.pData = (uint8_t *)&paySymbols;
-        (void)DRV_PLC_PHY_PIBGet(palPlcData.drvPhyHandle, &palPlcData.plcPIB);
-
+        paySymbols = lPAL_PLC_GetSnifferPayloadSymbols(pIndObj->dataLength, (PAL_SCHEME)pIndObj->scheme,
+                (PAL_FRAME)pIndObj->frameType, PLC_ID_RX_PAY_SYMBOLS);
         SRV_PSNIFFER_SetRxPayloadSymbols(paySymbols);
 
         length = SRV_PSNIFFER_SerialRxMessage(palPlcData.snifferData, pIndObj);
@@ -585,6 +1029,9 @@ static void lPAL_PLC_PLC_ExceptionCb(DRV_PLC_PHY_EXCEPTION exception, uintptr_t
     /* Set Error Status */
     palPlcData.status = PAL_PLC_STATUS_ERROR;
 
+    /* Transmissions in progress are lost: the PLC driver confirms them with
+     * NO_TX from its tasks, routed to their buffers as usual */
+
     if (exception == DRV_PLC_PHY_EXCEPTION_CRITICAL_ERROR)
     {
         palPlcData.statsErrorCritical++;
@@ -652,6 +1099,14 @@ SYS_MODULE_OBJ PAL_PLC_Initialize(void)
     palPlcData.palAttenuation = 0;
     palPlcData.syncEnable = false;
     palPlcData.syncHandle = SYS_TIME_HANDLE_INVALID;
+    palPlcData.txData[0].state = PAL_PLC_TX_FREE;
+    palPlcData.txData[1].state = PAL_PLC_TX_FREE;
+    palPlcData.txBusyCfm[0].pending = false;
+    palPlcData.txBusyCfm[1].pending = false;
+    palPlcData.capture.state = PAL_PLC_CAPTURE_IDLE;
+    palPlcData.capture.pibPending = 0;
+    palPlcData.channelChange.busy = false;
+    palPlcData.channelChange.nextPending = false;
 
     /* Read Default Channel */
     palPlcData.channel = SRV_PCOUP_GetDefaultChannel();
@@ -739,7 +1194,11 @@ void PAL_PLC_Tasks(void)
 
         case PAL_PLC_STATUS_DETECT_IMPEDANCE:
         {
-            if (palPlcData.detectImpedanceResult != DRV_PLC_PHY_TX_RESULT_PROCESS)
+            if (palPlcData.channelChange.busy)
+            {
+                /* Channel for impedance detection not set yet */
+            }
+            else if (palPlcData.detectImpedanceResult != DRV_PLC_PHY_TX_RESULT_PROCESS)
             {
                 if (palPlcData.detectImpedanceResult == DRV_PLC_PHY_TX_RESULT_SUCCESS)
                 {
@@ -781,9 +1240,17 @@ void PAL_PLC_Tasks(void)
             /* Apply PLC coupling configuration for the default channel */
             palPlcData.channel = SRV_PCOUP_GetDefaultChannel();
             lPAL_PLC_SetTxRxChannel(palPlcData.channel);
+            palPlcData.status = PAL_PLC_STATUS_WAIT_DEFAULT;
+            break;
+        }
 
-            /* Set PAL status to ready */
-            palPlcData.status = PAL_PLC_STATUS_READY;
+        case PAL_PLC_STATUS_WAIT_DEFAULT:
+        {
+            if (palPlcData.channelChange.busy == false)
+            {
+                /* Set PAL status to ready */
+                palPlcData.status = PAL_PLC_STATUS_READY;
+            }
             break;
         }
 
@@ -831,6 +1298,12 @@ void PAL_PLC_Tasks(void)
             break;
         }
     }
+
+    /* Pending transmission confirmations, if any */
+    lPAL_PLC_TxTasks();
+
+    /* Signal capture in progress, if any */
+    lPAL_PLC_SignalCaptureTasks();
 }
 
 void PAL_PLC_DataConfirmCallbackRegister(PAL_DATA_CONFIRM_CB callback)
@@ -845,35 +1318,85 @@ void PAL_PLC_DataIndicationCallbackRegister(PAL_DATA_INDICATION_CB callback)
 
 uint8_t PAL_PLC_DataRequest(PAL_MSG_REQUEST_DATA *pMessageData)
 {
+    PAL_PLC_TX_DATA *pTxData;
+    DRV_PLC_PHY_TRANSMISSION_OBJ *pTxObj;
+
     if (palPlcData.status != PAL_PLC_STATUS_READY)
     {
         return ((uint8_t)PAL_TX_RESULT_PHY_ERROR);
     }
 
+    if (pMessageData->timeMode == PAL_TX_MODE_CANCEL)
+    {
+        /* Cancel transmission in the buffer used for the MAC buffer, if not
+         * confirmed yet. The cancelled transmission is confirmed as usual */
+        pTxData = lPAL_PLC_GetBusyTxData(pMessageData->buffId);
+        if (pTxData == NULL)
+        {
+            return ((uint8_t)PAL_TX_RESULT_PROCESS);
+        }
+
+        palPlcData.phyTxObj = pTxData->txObj;
+        palPlcData.phyTxObj.mode = TX_MODE_CANCEL;
+        DRV_PLC_PHY_TxRequest(palPlcData.drvPhyHandle, &palPlcData.phyTxObj);
+
+        return ((uint8_t)PAL_TX_RESULT_PROCESS);
+    }
+
+    /* Transmit in the buffer requested by MAC or in the other one if busy, so
+     * that the next frame can be programmed while the current one is sent */
+    pTxData = lPAL_PLC_GetFreeTxData(pMessageData->buffId);
+    if (pTxData == NULL)
+    {
+        uint8_t index;
+
+        /* Both buffers in use: confirm from tasks */
+        for (index = 0; index < PAL_PLC_TX_BUFFERS_NUMBER; index++)
+        {
+            PAL_PLC_TX_BUSY_CFM *pBusyCfm = &palPlcData.txBusyCfm[index];
+
+            if (pBusyCfm->pending == false)
+            {
+                pBusyCfm->pending = true;
+                pBusyCfm->buffId = pMessageData->buffId;
+                pBusyCfm->frameType = pMessageData->frameType;
+                return ((uint8_t)PAL_TX_RESULT_PROCESS);
+            }
+        }
+
+        /* No room for more pending confirmations */
+        return ((uint8_t)PAL_TX_RESULT_BUSY_TX);
+    }
+
+    pTxObj = &pTxData->txObj;
+
     /* Adapt Timer mode */
     if (pMessageData->timeMode == PAL_TX_MODE_ABSOLUTE)
     {
-        palPlcData.phyTxObj.timeIni = lPAL_PLC_GetPlcTime(pMessageData->timeDelay);
+        pTxObj->timeIni = lPAL_PLC_GetPlcTime(pMessageData->timeDelay);
     }
     else
     {
-        palPlcData.phyTxObj.timeIni = pMessageData->timeDelay;
+        pTxObj->timeIni = pMessageData->timeDelay;
     }
 
-    palPlcData.phyTxObj.dataLength = pMessageData->dataLength;
-    palPlcData.phyTxObj.mode = (uint8_t)(pMessageData->timeMode);
-    palPlcData.phyTxObj.attenuation = palPlcData.palAttenuation + pMessageData->attLevel;
-    palPlcData.phyTxObj.csma.disableRx = pMessageData->disableRx;
-    palPlcData.phyTxObj.csma.senseCount = pMessageData->numSenses;
-    palPlcData.phyTxObj.csma.senseDelayMs = pMessageData->senseDelayMs;
-    palPlcData.phyTxObj.bufferId = (DRV_PLC_PHY_BUFFER_ID)(pMessageData->buffId);
-    palPlcData.phyTxObj.scheme = (DRV_PLC_PHY_SCH)pMessageData->scheme;
-    palPlcData.phyTxObj.frameType = (DRV_PLC_PHY_FRAME_TYPE)pMessageData->frameType;
-    palPlcData.phyTxObj.pTransmitData = pMessageData->pData;
+    pTxObj->dataLength = pMessageData->dataLength;
+    pTxObj->mode = (uint8_t)(pMessageData->timeMode);
+    pTxObj->attenuation = palPlcData.palAttenuation + pMessageData->attLevel;
+    pTxObj->csma.disableRx = pMessageData->disableRx;
+    pTxObj->csma.senseCount = pMessageData->numSenses;
+    pTxObj->csma.senseDelayMs = pMessageData->senseDelayMs;
+    pTxObj->scheme = (DRV_PLC_PHY_SCH)pMessageData->scheme;
+    pTxObj->frameType = (DRV_PLC_PHY_FRAME_TYPE)pMessageData->frameType;
+    pTxObj->pTransmitData = pMessageData->pData;
 
-    SRV_PSNIFFER_SetTxMessage(&palPlcData.phyTxObj);
+    /* Buffer in use until confirmed (the driver may confirm from TxRequest) */
+    pTxData->buffId = pMessageData->buffId;
+    pTxData->state = PAL_PLC_TX_BUSY;
 
-    DRV_PLC_PHY_TxRequest(palPlcData.drvPhyHandle, &palPlcData.phyTxObj);
+    SRV_PSNIFFER_SetTxMessage(pTxObj);
+
+    DRV_PLC_PHY_TxRequest(palPlcData.drvPhyHandle, pTxObj);
 
     return ((uint8_t)PAL_TX_RESULT_PROCESS);
 }
@@ -1348,6 +1871,12 @@ uint16_t PAL_PLC_GetSignalCapture(uint8_t *pData, PAL_FRAME frameType, uint32_t
     uint8_t index;
     SYS_TIME_HANDLE timer = SYS_TIME_HANDLE_INVALID;
 
+    if (palPlcData.capture.state != PAL_PLC_CAPTURE_IDLE)
+    {
+        /* Non-blocking capture in progress */
+        return 0;
+    }
+
     palPlcData.plcPIB.id = PLC_ID_SIGNAL_CAPTURE_STATUS;
     palPlcData.plcPIB.length = (uint16_t)sizeof(signalCapture);
     palPlcData.plcPIB.pData = (uint8_t *)&signalCapture;
@@ -1438,52 +1967,69 @@ uint16_t PAL_PLC_GetSignalCapture(uint8_t *pData, PAL_FRAME frameType, uint32_t
     }
 }
 
-uint8_t PAL_PLC_GetMsgDuration(uint16_t length, PAL_SCHEME scheme, PAL_FRAME frameType, uint32_t *pDuration)
+bool PAL_PLC_SignalCaptureRequest(uint8_t *pData, uint16_t maxLength, PAL_FRAME frameType, uint32_t timeStart,
+    uint32_t duration, PAL_PLC_SIGNAL_CAPTURE_CB callback, uintptr_t context)
 {
-    uint32_t frameDuration;
-    uint16_t frameLen;
-    uint8_t symbolSize = 0;
+    PAL_PLC_CAPTURE_DATA *pCapture = &palPlcData.capture;
+    uint8_t *pParameters;
 
-    if (length == 0U)
+    if ((pData == NULL) || (callback == NULL) || (palPlcData.status != PAL_PLC_STATUS_READY) ||
+            (pCapture->state != PAL_PLC_CAPTURE_IDLE))
     {
-        *pDuration = 0;
-        return((uint8_t)PAL_CFG_INVALID_INPUT);
+        return false;
     }
 
-    frameLen = length;
-
-    if (frameType == PAL_FRAME_TYPE_A)
+    pCapture->pData = pData;
+    pCapture->maxLength = maxLength;
+    pCapture->callback = callback;
+    pCapture->context = context;
+    pCapture->pibPending = 0;
+    pCapture->pibResult = true;
+    pCapture->fragmentPending = false;
+
+    /* Capture parameters, sent when previous capture (if any) finishes */
+    pParameters = pCapture->parameters;
+    *pParameters++ = (uint8_t)(frameType);
+    *pParameters++ = (uint8_t)(timeStart >> 24U);
+    *pParameters++ = (uint8_t)(timeStart >> 16U);
+    *pParameters++ = (uint8_t)(timeStart >> 8U);
+    *pParameters++ = (uint8_t)(timeStart);
+    *pParameters++ = (uint8_t)(duration >> 24U);
+    *pParameters++ = (uint8_t)(duration >> 16U);
+    *pParameters++ = (uint8_t)(duration >> 8U);
+    *pParameters = (uint8_t)(duration);
+
+    /* Check status of previous capture */
+    if (lPAL_PLC_SignalCapturePib(PLC_ID_SIGNAL_CAPTURE_STATUS, &pCapture->status,
+            (uint16_t)sizeof(pCapture->status), false) == false)
     {
-        /* There are 7 bytes inside the header */
-        if (frameLen < 7U)
-        {
-            frameLen = 0;
-        }
-        else
-        {
-            frameLen -= 7U;
-        }
+        return false;
     }
 
-    symbolSize = palPlcSymbolSize[scheme];
-    if (scheme >= PAL_SCHEME_DBPSK_C)
-    {
-        /* Increase a byte for flushing */
-        frameLen++;
-    }
+    pCapture->pollTime = SYS_TIME_CounterGet();
+    pCapture->state = PAL_PLC_CAPTURE_WAIT_PREVIOUS;
+
+    return true;
+}
 
-    /* Update tx frame duration */
-    frameDuration =  (uint32_t)((uint32_t)(frameLen) / symbolSize);
-    if ((frameLen % symbolSize) > 0U) {
-        frameDuration++;
+uint8_t PAL_PLC_GetMsgDuration(uint16_t length, PAL_SCHEME scheme, PAL_FRAME frameType, uint32_t *pDuration)
+{
+    uint32_t frameDuration;
+    uint16_t symbols;
+
+    if (length == 0U)
+    {
+        *pDuration = 0;
+        return((uint8_t)PAL_CFG_INVALID_INPUT);
     }
 
-    /* adjust ROB scheme */
-    if (((uint8_t)(scheme) & 0x08U) > 0U) {
-        frameDuration <<= 2;
+    if (lPAL_PLC_GetPayloadSymbols(length, scheme, frameType, &symbols) == false)
+    {
+        *pDuration = 0;
+        return((uint8_t)PAL_CFG_INVALID_INPUT);
     }
 
-    frameDuration *= PHY_SYMBOL_TIME;
+    frameDuration = (uint32_t)symbols * PHY_SYMBOL_TIME;
     /* Adjust chirp and header for PHY frame */
     frameDuration += palPlcTimeChirpHeader[frameType];
 
@@ -82,6 +82,8 @@ uint8_t PAL_PLC_SetChannel(uint16_t pch);
 uint8_t PAL_PLC_GetConfiguration(uint16_t id, void *pValue, uint16_t length);
 uint8_t PAL_PLC_SetConfiguration(uint16_t id, void *pValue, uint16_t length);
 uint16_t PAL_PLC_GetSignalCapture(uint8_t *pData, PAL_FRAME frameType, uint32_t timeStart, uint32_t duration);
+bool PAL_PLC_SignalCaptureRequest(uint8_t *pData, uint16_t maxLength, PAL_FRAME frameType, uint32_t timeStart,
+    uint32_t duration, PAL_PLC_SIGNAL_CAPTURE_CB callback, uintptr_t context);
 uint8_t PAL_PLC_GetMsgDuration(uint16_t length, PAL_SCHEME scheme, PAL_FRAME frameType, uint32_t *pDuration);
 void PAL_PLC_USISnifferCallbackRegister(SRV_USI_HANDLE usiHandler, PAL_USI_SNIFFER_CB callback);
 
@@ -53,6 +53,15 @@ Microchip or any third party.
 #include "driver/driver_common.h"
 #include "driver/plc/phy/drv_plc_phy_comm.h"
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Number of PLC transmission buffers (TX_BUFFER_0 and TX_BUFFER_1) */
+#define PAL_PLC_TX_BUFFERS_NUMBER    2U
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Data Types
@@ -80,6 +89,7 @@ typedef enum {
     PAL_PLC_STATUS_INVALID_OBJECT = SYS_STATUS_ERROR_EXTENDED - 1,
     PAL_PLC_STATUS_DETECT_IMPEDANCE = SYS_STATUS_ERROR_EXTENDED - 2,
     PAL_PLC_STATUS_SET_DEFAULT = SYS_STATUS_ERROR_EXTENDED - 3,
+    PAL_PLC_STATUS_WAIT_DEFAULT = SYS_STATUS_ERROR_EXTENDED - 4,
 } PAL_PLC_STATUS;
 
 /* PAL PLC PHY receiver data structure
@@ -130,6 +140,185 @@ typedef struct
     uint8_t impPercent;
 }  PAL_PLC_RX_PHY_PARAMS;
 
+// *****************************************************************************
+/* PAL PLC Transmission State
+
+  Summary:
+    Identifies the state of a PLC transmission buffer.
+
+  Description:
+    None.
+
+  Remarks:
+    None.
+*/
+typedef enum {
+    PAL_PLC_TX_FREE,
+    PAL_PLC_TX_BUSY,
+} PAL_PLC_TX_STATE;
+
+// *****************************************************************************
+/* PAL PLC Transmission Data
+
+  Summary:
+    Holds the transmission in progress in a PLC transmission buffer.
+
+  Description:
+    There is one for each transmission buffer of the PLC device. The MAC
+    buffer identifier is kept to report it in the confirmation, as the frame
+    is transmitted in any free buffer.
+
+  Remarks:
+    None.
+*/
+typedef struct
+{
+    DRV_PLC_PHY_TRANSMISSION_OBJ txObj;
+
+    PAL_PLC_TX_STATE state;
+
+    uint8_t buffId;
+
+} PAL_PLC_TX_DATA;
+
+// *****************************************************************************
+/* PAL PLC Busy Transmission Confirmation
+
+  Summary:
+    Holds a BUSY_TX confirmation pending to be reported.
+
+  Description:
+    A request received while both transmission buffers are in use is
+    confirmed with BUSY_TX from PAL_PLC_Tasks. There is one for each
+    transmission buffer of the PLC device.
+
+  Remarks:
+    None.
+*/
+typedef struct
+{
+    PAL_FRAME frameType;
+
+    uint8_t buffId;
+
+    bool pending;
+
+} PAL_PLC_TX_BUSY_CFM;
+
+// *****************************************************************************
+/* PAL PLC Signal Capture Callback
+
+  Summary:
+    Callback reporting the end of a signal capture.
+
+  Description:
+    Called from PAL_PLC_Tasks when a capture requested with
+    PAL_PLC_SignalCaptureRequest finishes. Length is the number of bytes
+    stored in the caller buffer (0 if the capture failed).
+
+  Remarks:
+    A failed capture is only reported once the PIB requests it queued in
+    the PLC driver have completed, so the buffer can be released then.
+*/
+typedef void (*PAL_PLC_SIGNAL_CAPTURE_CB)(uint8_t *pData, uint16_t length, uintptr_t context);
+
+// *****************************************************************************
+/* PAL PLC Signal Capture State
+
+  Summary:
+    Identifies the state of the signal capture in progress.
+
+  Description:
+    None.
+
+  Remarks:
+    None.
+*/
+typedef enum {
+    PAL_PLC_CAPTURE_IDLE,
+    PAL_PLC_CAPTURE_WAIT_PREVIOUS,
+    PAL_PLC_CAPTURE_START,
+    PAL_PLC_CAPTURE_RUNNING,
+    PAL_PLC_CAPTURE_READ_DATA,
+} PAL_PLC_CAPTURE_STATE;
+
+// *****************************************************************************
+/* PAL PLC Signal Capture Data
+
+  Summary:
+    Holds the data of the signal capture in progress.
+
+  Description:
+    PIB objects and buffers are kept here as they are accessed by the PLC
+    driver after the requests are queued.
+
+  Remarks:
+    None.
+*/
+typedef struct
+{
+    PAL_PLC_SIGNAL_CAPTURE_CB callback;
+
+    uintptr_t context;
+
+    uint8_t *pData;
+
+    uint16_t maxLength;
+
+    uint16_t length;
+
+    uint32_t pollTime;
+
+    DRV_PLC_PHY_PIB_OBJ pib[2];
+
+    DRV_PLC_PHY_SIGNAL_CAPTURE status;
+
+    PAL_PLC_CAPTURE_STATE state;
+
+    uint8_t parameters[9];
+
+    uint8_t fragment;
+
+    bool fragmentPending;
+
+    uint8_t pibPending;
+
+    bool pibResult;
+
+    uint8_t id;
+
+} PAL_PLC_CAPTURE_DATA;
+
+// *****************************************************************************
+/* PAL PLC Channel Change Data
+
+  Summary:
+    Holds the data of the channel change in progress.
+
+  Description:
+    The channel and the coupling parameters are set through PIB requests
+    of the PLC driver, one after the other. A channel requested while
+    another one is being set is applied when it is done.
+
+  Remarks:
+    None.
+*/
+typedef struct
+{
+    DRV_PLC_PHY_PIB_OBJ pib;
+
+    DRV_PLC_PHY_CHANNEL channel;
+
+    DRV_PLC_PHY_CHANNEL nextChannel;
+
+    uint8_t channelCfg;
+
+    bool busy;
+
+    bool nextPending;
+
+} PAL_PLC_CHANNEL_DATA;
+
 // *****************************************************************************
 /* PAL PLC Data
 
@@ -154,6 +343,8 @@ typedef struct
 
     uint32_t syncTimerRelFreq;
 
+    uint32_t syncTimerRelFreqInv;
+
     uint32_t syncIntId;
 
     uint32_t syncDelay;
@@ -170,6 +361,10 @@ typedef struct
 
     DRV_PLC_PHY_TRANSMISSION_OBJ phyTxObj;
 
+    PAL_PLC_TX_DATA txData[PAL_PLC_TX_BUFFERS_NUMBER];
+
+    PAL_PLC_TX_BUSY_CFM txBusyCfm[PAL_PLC_TX_BUFFERS_NUMBER];
+
     PAL_PLC_RX_PHY_PARAMS rxParameters;
 
     DRV_PLC_PHY_CHANNEL channel;
@@ -216,6 +411,10 @@ typedef struct
 
     uint8_t snifferData[PAL_SNIFFER_DATA_MAX_SIZE];
 
+    PAL_PLC_CAPTURE_DATA capture;
+
+    PAL_PLC_CHANNEL_DATA channelChange;
+
 } PAL_PLC_DATA;
 
 #endif // #ifndef PAL_PLC_LOCAL_H
@@ -51,6 +51,12 @@
 #include "configuration.h"
 #include "sys_time_local.h"
 
+/* The wheel must span the maximum timer period (counter period) plus the
+ * maximum time between updates (half counter period) */
+#if ((SYS_TIME_WHEEL_TICK_SHIFT + (SYS_TIME_WHEEL_LEVELS * SYS_TIME_WHEEL_SLOT_BITS)) < (SYS_TIME_HW_COUNTER_WIDTH + 1))
+#error "SYS_TIME_WHEEL_TICK_SHIFT is too small for the timer wheel"
+#endif
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Global Data
@@ -157,28 +163,29 @@ static void SYS_TIME_HwTimerCompareUpdate(void)
 {
     uint64_t nextHwCounterValue = 0;
     uint64_t currHwCounterValue;
+    uint64_t pendingCount;
     SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmrActive = counterObj->tmrActive;
 
     counterObj->hwTimerPreviousValue = counterObj->hwTimerCurrentValue;
 
-    if (tmrActive != NULL)
+    /* wheelCounter64 corresponds to hwTimerCurrentValue */
+    if (counterObj->wheelNextEvent > counterObj->wheelCounter64)
     {
-        if (tmrActive->relativeTimePending > SYS_TIME_HW_COUNTER_HALF_PERIOD)
-        {
-            nextHwCounterValue = (uint64_t)counterObj->hwTimerCurrentValue + SYS_TIME_HW_COUNTER_HALF_PERIOD;
-        }
-        else
-        {
-            /* Use a non-volatile intermediate to prevent dual volatile access in single statement */
-            uint32_t relativeTimePending = tmrActive->relativeTimePending;
-            nextHwCounterValue = (uint64_t)counterObj->hwTimerCurrentValue + relativeTimePending;
-        }
+        pendingCount = counterObj->wheelNextEvent - counterObj->wheelCounter64;
     }
     else
+    {
+        pendingCount = 0;
+    }
+
+    if (pendingCount > SYS_TIME_HW_COUNTER_HALF_PERIOD)
     {
         nextHwCounterValue = (uint64_t)counterObj->hwTimerCurrentValue + SYS_TIME_HW_COUNTER_HALF_PERIOD;
     }
+    else
+    {
+        nextHwCounterValue = (uint64_t)counterObj->hwTimerCurrentValue + pendingCount;
+    }
 
     currHwCounterValue = counterObj->timePlib->timerCounterGet();
 
@@ -207,116 +214,234 @@ static void SYS_TIME_HwTimerCompareUpdate(void)
     counterObj->timePlib->timerCompareSet(counterObj->hwTimerCompareValue);
 }
 
-static bool SYS_TIME_RemoveFromList(SYS_TIME_TIMER_OBJ* delTimer)
+static uint32_t SYS_TIME_WheelFirstSlot(uint64_t bitmap, uint32_t from)
 {
-    SYS_TIME_COUNTER_OBJ* counter = (SYS_TIME_COUNTER_OBJ *)&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmr = counter->tmrActive;
-    SYS_TIME_TIMER_OBJ* prevTmr = NULL;
-    bool isHeadTimerUpdated = false;
+    uint64_t mask;
 
-    tmr = counter->tmrActive;
+    if (from >= SYS_TIME_WHEEL_SLOTS)
+    {
+        return SYS_TIME_WHEEL_SLOTS;
+    }
 
-    /* Find the timer to be deleted from the linked list */
-    while ((tmr != NULL) && (tmr != delTimer))
+    mask = bitmap & (UINT64_MAX << from);
+    if (mask == 0U)
     {
-        prevTmr = tmr;
-        tmr = tmr->tmrNext;
+        return SYS_TIME_WHEEL_SLOTS;
     }
 
-    /* Could not find the timer in the list? return */
-    if (tmr == NULL)
+    return (uint32_t)__builtin_ctzll(mask);
+}
+
+static uint64_t SYS_TIME_WheelInsert(SYS_TIME_TIMER_OBJ* tmr)
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    uint64_t wheelTick = counterObj->wheelTick;
+    uint64_t tick = tmr->expiry >> SYS_TIME_WHEEL_TICK_SHIFT;
+    uint32_t level;
+    uint32_t slot;
+    uint32_t shift;
+
+    /* Already expired: next wheel update */
+    if (tick < wheelTick)
     {
-        return isHeadTimerUpdated;
+        tick = wheelTick;
     }
 
-    /* Add the deleted timer pending time to the next timer in the list */
-    if (delTimer->tmrNext != NULL)
+    /* Lowest level whose current turn contains the expiry tick. The last
+     * level wraps around. */
+    for (level = 0; level < (SYS_TIME_WHEEL_LEVELS - 1U); level++)
     {
-        /* Use a non-volatile intermediate to prevent dual volatile access in single statement */
-        uint32_t relativeTimePending = delTimer->relativeTimePending;
-        delTimer->tmrNext->relativeTimePending += relativeTimePending;
+        shift = (level + 1U) * SYS_TIME_WHEEL_SLOT_BITS;
+        if ((tick >> shift) == (wheelTick >> shift))
+        {
+            break;
+        }
     }
 
-    /* If the deleted timer was at the head of the list */
-    if (prevTmr == NULL)
+    shift = level * SYS_TIME_WHEEL_SLOT_BITS;
+    slot = (uint32_t)(tick >> shift) & SYS_TIME_WHEEL_SLOT_MASK;
+
+    tmr->tmrPrev = NULL;
+    tmr->tmrNext = counterObj->wheel[level][slot];
+    if (tmr->tmrNext != NULL)
     {
-        counter->tmrActive = counter->tmrActive->tmrNext;
-        isHeadTimerUpdated = true;
+        tmr->tmrNext->tmrPrev = tmr;
+    }
+    counterObj->wheel[level][slot] = tmr;
+    counterObj->wheelBitmap[level] |= (1ULL << slot);
+    tmr->wheelLevel = (uint8_t)level;
+    tmr->wheelSlot = (uint8_t)slot;
+    counterObj->wheelCount++;
+
+    /* Time of the wheel event due to this timer */
+    if (level == 0U)
+    {
+        return tmr->expiry;
     }
     else
     {
-        /* If the deleted timer was not the head of the list */
-        prevTmr->tmrNext = delTimer->tmrNext;
+        return ((tick >> shift) << shift) << SYS_TIME_WHEEL_TICK_SHIFT;
     }
-
-    delTimer->tmrNext = NULL;
-
-    return isHeadTimerUpdated;
 }
 
-static bool SYS_TIME_AddToList(SYS_TIME_TIMER_OBJ* newTimer)
+static void SYS_TIME_WheelRemove(SYS_TIME_TIMER_OBJ* tmr)
 {
-    uint64_t total_time = 0;
-    SYS_TIME_COUNTER_OBJ* counter = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmr = counter->tmrActive;
-    SYS_TIME_TIMER_OBJ* prevTmr = NULL;
-    uint32_t newTimerTime;
-    bool isHeadTimerUpdated = false;
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    uint32_t level = tmr->wheelLevel;
+    uint32_t slot = tmr->wheelSlot;
 
-    if (newTimer == NULL)
+    if (level == SYS_TIME_WHEEL_NONE)
     {
-        return isHeadTimerUpdated;
+        return;
     }
 
-    newTimerTime = newTimer->relativeTimePending;
-
-    if (tmr == NULL)
+    if (tmr->tmrPrev == NULL)
     {
-        /* Add the new timer to the top of the list */
-        newTimer->relativeTimePending = newTimerTime;
-        counter->tmrActive = newTimer;
-        isHeadTimerUpdated = true;
+        counterObj->wheel[level][slot] = tmr->tmrNext;
+        if (tmr->tmrNext == NULL)
+        {
+            counterObj->wheelBitmap[level] &= ~(1ULL << slot);
+        }
     }
     else
     {
-        /* Find appropriate location to insert the new timer */
-        while (tmr != NULL)
+        tmr->tmrPrev->tmrNext = tmr->tmrNext;
+    }
+
+    if (tmr->tmrNext != NULL)
+    {
+        tmr->tmrNext->tmrPrev = tmr->tmrPrev;
+    }
+
+    tmr->tmrNext = NULL;
+    tmr->tmrPrev = NULL;
+    tmr->wheelLevel = SYS_TIME_WHEEL_NONE;
+    counterObj->wheelCount--;
+}
+
+static uint64_t SYS_TIME_WheelNextTick(uint32_t* eventLevel)
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    uint64_t wheelTick = counterObj->wheelTick;
+    uint64_t nextTick = SYS_TIME_WHEEL_NO_EVENT;
+    uint64_t tick;
+    uint32_t level = SYS_TIME_WHEEL_LEVELS;
+    uint32_t shift;
+    uint32_t current;
+    uint32_t slot;
+
+    /* Higher levels first, so that cascades go before expiries at the same tick */
+    while (level > 0U)
+    {
+        level--;
+
+        if (counterObj->wheelBitmap[level] == 0U)
         {
-            if ((total_time + tmr->relativeTimePending) > newTimerTime)
-            {
-                break;
-            }
-            total_time += tmr->relativeTimePending;
-            prevTmr = tmr;
-            tmr = tmr->tmrNext;
+            continue;
         }
 
-        /* The new timer must be inserted to the head of the list */
-        if (prevTmr == NULL)
+        shift = level * SYS_TIME_WHEEL_SLOT_BITS;
+        current = (uint32_t)(wheelTick >> shift) & SYS_TIME_WHEEL_SLOT_MASK;
+        tick = (wheelTick >> (shift + SYS_TIME_WHEEL_SLOT_BITS)) << (shift + SYS_TIME_WHEEL_SLOT_BITS);
+
+        /* Level 0 current slot holds the timers of the current tick. In upper
+         * levels the current slot has already been cascaded. */
+        slot = SYS_TIME_WheelFirstSlot(counterObj->wheelBitmap[level], (level == 0U) ? current : (current + 1U));
+        if (slot == SYS_TIME_WHEEL_SLOTS)
         {
-            /* head = newTimer*/
-            counter->tmrActive = newTimer;
-            /* head->next = previous head */
-            newTimer->tmrNext = tmr;
-            isHeadTimerUpdated = true;
+            /* Only the last level wraps around */
+            slot = SYS_TIME_WheelFirstSlot(counterObj->wheelBitmap[level], 0);
+            tick += (1ULL << (shift + SYS_TIME_WHEEL_SLOT_BITS));
         }
-        else
+
+        tick += ((uint64_t)slot << shift);
+        if (tick < nextTick)
+        {
+            nextTick = tick;
+            *eventLevel = level;
+        }
+    }
+
+    return nextTick;
+}
+
+static SYS_TIME_TIMER_OBJ* SYS_TIME_WheelFirstTimer(uint32_t slot, uint64_t now)
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    SYS_TIME_TIMER_OBJ* tmr = counterObj->wheel[0][slot];
+    SYS_TIME_TIMER_OBJ* first = NULL;
+
+    /* Earliest timer of the slot expired at "now". Newest timers are at the
+     * head, so the oldest one is taken for equal expiry times. */
+    while (tmr != NULL)
+    {
+        if ((tmr->expiry <= now) && ((first == NULL) || (tmr->expiry <= first->expiry)))
         {
-            newTimer->tmrNext = prevTmr->tmrNext;
-            prevTmr->tmrNext = newTimer;
+            first = tmr;
         }
+        tmr = tmr->tmrNext;
+    }
+
+    return first;
+}
 
-        /* Update the relative times */
-        newTimer->relativeTimePending = newTimerTime - (uint32_t)total_time;
-        if (newTimer->tmrNext != NULL)
+static void SYS_TIME_WheelCascade(uint32_t level, uint32_t slot)
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    SYS_TIME_TIMER_OBJ* tmr = counterObj->wheel[level][slot];
+    SYS_TIME_TIMER_OBJ* tmrNext;
+
+    counterObj->wheel[level][slot] = NULL;
+    counterObj->wheelBitmap[level] &= ~(1ULL << slot);
+
+    while (tmr != NULL)
+    {
+        tmrNext = tmr->tmrNext;
+        counterObj->wheelCount--;
+        (void) SYS_TIME_WheelInsert(tmr);
+        tmr = tmrNext;
+    }
+}
+
+static void SYS_TIME_WheelNextEventUpdate(void)
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    SYS_TIME_TIMER_OBJ* tmr;
+    uint64_t nextTick;
+    uint32_t level = 0;
+
+    nextTick = SYS_TIME_WheelNextTick(&level);
+
+    if (nextTick == SYS_TIME_WHEEL_NO_EVENT)
+    {
+        counterObj->wheelNextEvent = SYS_TIME_WHEEL_NO_EVENT;
+    }
+    else if (level == 0U)
+    {
+        /* Exact expiry of the first timer in the slot */
+        counterObj->wheelNextEvent = SYS_TIME_WHEEL_NO_EVENT;
+        tmr = counterObj->wheel[0][nextTick & SYS_TIME_WHEEL_SLOT_MASK];
+        while (tmr != NULL)
         {
-            /* Subtract the new timers time from the next timer in the list */
-            /* Use a non-volatile intermediate to prevent dual volatile access in single statement */
-            newTimerTime = newTimer->relativeTimePending;
-            newTimer->tmrNext->relativeTimePending -= newTimerTime;
+            if (tmr->expiry < counterObj->wheelNextEvent)
+            {
+                counterObj->wheelNextEvent = tmr->expiry;
+            }
+            tmr = tmr->tmrNext;
         }
     }
-    return isHeadTimerUpdated;
+    else
+    {
+        /* Start of the slot to cascade */
+        counterObj->wheelNextEvent = nextTick << SYS_TIME_WHEEL_TICK_SHIFT;
+    }
+}
+
+static void SYS_TIME_FreeListPush(SYS_TIME_TIMER_OBJ* tmr)
+{
+    tmr->tmrNext = gSystemCounterObj.tmrFree;
+    gSystemCounterObj.tmrFree = tmr;
+    gSystemCounterObj.timersInUse--;
 }
 
 static uint32_t SYS_TIME_GetElapsedCount(uint32_t hwTimerCurrentValue)
@@ -343,201 +468,197 @@ static uint32_t SYS_TIME_GetElapsedCount(uint32_t hwTimerCurrentValue)
 static uint32_t SYS_TIME_GetTotalElapsedCount(SYS_TIME_TIMER_OBJ* tmr)
 {
     SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmrActive = counterObj->tmrActive;
-    uint32_t pendingCount = 0;
+    uint64_t now;
+    uint64_t pendingCount;
     uint32_t elapsedCount = 0;
-    uint32_t hwTimerCurrentValue;
 
-    if (tmr->active == false)
+    if ((tmr->active == true) && (tmr->wheelLevel != SYS_TIME_WHEEL_NONE))
     {
-        elapsedCount = 0;
-    }
-    else
-    {
-        /* Add time from all timers in the front */
-        while ((tmrActive != NULL) && (tmrActive != tmr))
-        {
-            pendingCount += tmrActive->relativeTimePending;
-            tmrActive = tmrActive->tmrNext;
-        }
-        /* Add the pending time of the requested timer */
-        pendingCount += tmrActive->relativeTimePending;
-        hwTimerCurrentValue = counterObj->timePlib->timerCounterGet();
-        elapsedCount = SYS_TIME_GetElapsedCount(hwTimerCurrentValue);
+        now = counterObj->wheelCounter64 +
+            SYS_TIME_GetElapsedCount(counterObj->timePlib->timerCounterGet());
 
-        if (pendingCount >= elapsedCount)
+        if (tmr->expiry > now)
         {
-            pendingCount -= elapsedCount;
+            pendingCount = tmr->expiry - now;
         }
         else
         {
             pendingCount = 0;
         }
 
-        if (tmrActive->requestedTime >= pendingCount)
-        {
-            elapsedCount = tmrActive->requestedTime - pendingCount;
-        }
-        else
+        if (tmr->requestedTime >= pendingCount)
         {
-            elapsedCount = 0;
+            elapsedCount = tmr->requestedTime - (uint32_t)pendingCount;
         }
     }
 
     return elapsedCount;
 }
 
-static void SYS_TIME_UpdateTimerList(uint32_t elapsedCount)
-{
-    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmr = NULL;
-
-    tmr = counterObj->tmrActive;
-
-    while ((tmr != NULL) && (elapsedCount > 0U))
-    {
-        if (tmr->relativeTimePending >= elapsedCount)
-        {
-            tmr->relativeTimePending -= elapsedCount;
-            elapsedCount = 0;
-        }
-        else
-        {
-            /* The timer has probably expired */
-            elapsedCount -= tmr->relativeTimePending;
-            tmr->relativeTimePending = 0;
-        }
-        tmr = tmr->tmrNext;
-    }
-
-    counterObj->hwTimerPreviousValue = counterObj->hwTimerCurrentValue;
-}
-
 static void SYS_TIME_TimerAdd(SYS_TIME_TIMER_OBJ* newTimer)
 {
     SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
     uint32_t elapsedCount = 0;
-    bool isHeadTimerUpdated = false;
+    uint64_t eventTime;
     bool interruptState;
 
+    if (counterObj->interruptNestingCount != 0U)
+    {
+        /* From a timer callback: wheel and compare updated when it returns */
+        newTimer->expiry = counterObj->wheelCounter64 + newTimer->relativeTimePending;
+        (void) SYS_TIME_WheelInsert(newTimer);
+        return;
+    }
+
     counterObj->hwTimerCurrentValue = counterObj->timePlib->timerCounterGet();
 
     elapsedCount = SYS_TIME_GetElapsedCount(counterObj->hwTimerCurrentValue);
-
-    SYS_TIME_UpdateTimerList(elapsedCount);
+    counterObj->hwTimerPreviousValue = counterObj->hwTimerCurrentValue;
 
     interruptState = SYS_INT_Disable();
     counterObj->swCounter64 = counterObj->swCounter64 + elapsedCount;
+    counterObj->wheelCounter64 = counterObj->wheelCounter64 + elapsedCount;
     SYS_INT_Restore(interruptState);
 
-    isHeadTimerUpdated = SYS_TIME_AddToList(newTimer);
+    newTimer->expiry = counterObj->wheelCounter64 + newTimer->relativeTimePending;
+    eventTime = SYS_TIME_WheelInsert(newTimer);
 
-    if (isHeadTimerUpdated == true)
+    if (eventTime < counterObj->wheelNextEvent)
     {
+        counterObj->wheelNextEvent = eventTime;
         interruptState = SYS_INT_Disable();
         SYS_TIME_HwTimerCompareUpdate();
         SYS_INT_Restore(interruptState);
     }
 }
 
-static void SYS_TIME_ClientNotify(void)
+static void SYS_TIME_TimerExpire(SYS_TIME_TIMER_OBJ* tmr, uint64_t now)
 {
     SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmrActive = counterObj->tmrActive;
+    SYS_TIME_CALLBACK callback = tmr->callback;
+    uintptr_t context = tmr->context;
+    uint64_t expiry = tmr->expiry;
+    uint32_t lateCount = (uint32_t)(now - expiry);
+
+    SYS_TIME_WheelRemove(tmr);
 
-    while (tmrActive != NULL)
+    counterObj->expiredCount++;
+    counterObj->lateSum += lateCount;
+    if (lateCount > counterObj->lateMax)
     {
-        if(tmrActive->relativeTimePending == 0U)
-        {
-            tmrActive->tmrElapsedFlag = true;
-            tmrActive->tmrElapsed = true;
+        counterObj->lateMax = lateCount;
+    }
 
-            if ((tmrActive->type == SYS_TIME_SINGLE) && (tmrActive->callback != NULL))
-            {
-                /* Destroy single shot timer for which the callback is registered */
-                (void) SYS_TIME_TimerDestroy(tmrActive->tmrHandle);
-            }
-            else
-            {
-                /* For periodic timers and delay timers, just remove from the list */
-                /* Removing from list does not clear active flag */
-                (void) SYS_TIME_RemoveFromList(tmrActive);
-                if (tmrActive->type == SYS_TIME_SINGLE)
-                {
-                    /* Delay timers become inactive after expiry. */
-                    tmrActive->active = false;
-                }
-            }
+    tmr->tmrElapsedFlag = true;
+    tmr->tmrElapsed = true;
 
-            if(tmrActive->callback != NULL)
-            {
-                tmrActive->callback(tmrActive->context);
-            }
+    if (tmr->type == SYS_TIME_SINGLE)
+    {
+        tmr->relativeTimePending = 0;
 
-            tmrActive = counterObj->tmrActive;
+        if (callback != NULL)
+        {
+            /* Destroy single shot timer for which the callback is registered */
+            (void) SYS_TIME_TimerDestroy(tmr->tmrHandle);
         }
         else
         {
-            break;
+            /* Delay timers become inactive after expiry. */
+            tmr->active = false;
+        }
+    }
+
+    if (callback != NULL)
+    {
+        callback(context);
+    }
+
+    /* tmrElapsed is cleared anytime a timer is stopped, started, reloaded
+     * or destroyed.
+     * If timer is stopped from CB, there is no need to add it back to wheel
+     * If timer is started from CB, it is already added to wheel by start routine
+     * If timer is reloaded from CB, it is already added to wheel by reload routine
+     * If timer is destroyed from CB, there is no need to add it back to wheel
+     * Note: tmrElapsedFlag is cleared when the application reads the status
+     * by calling the SYS_TIME_TimerPeriodHasExpired API.
+     */
+    if (tmr->tmrElapsed == true)
+    {
+        tmr->tmrElapsed = false;
+
+        if (tmr->type == SYS_TIME_PERIODIC)
+        {
+            /* Next period from the previous expiry, skipping missed periods */
+            tmr->expiry = expiry + tmr->requestedTime;
+            if (tmr->expiry <= now)
+            {
+                tmr->expiry = now + tmr->requestedTime;
+            }
+            (void) SYS_TIME_WheelInsert(tmr);
         }
     }
 }
 
-static void SYS_TIME_UpdateTime(uint32_t elapsedCounts)
+static void SYS_TIME_UpdateTime(void)
 {
-    uint8_t i;
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+    SYS_TIME_TIMER_OBJ* tmr;
+    uint64_t now = counterObj->wheelCounter64;
+    uint64_t nowTick = now >> SYS_TIME_WHEEL_TICK_SHIFT;
+    uint64_t nextTick;
+    uint32_t level = 0;
 
-    SYS_TIME_UpdateTimerList(elapsedCounts);
+    while (true)
+    {
+        nextTick = SYS_TIME_WheelNextTick(&level);
+        if (nextTick > nowTick)
+        {
+            /* Nothing else before "now" */
+            counterObj->wheelTick = nowTick;
+            break;
+        }
 
-    SYS_TIME_ClientNotify();
+        counterObj->wheelTick = nextTick;
 
-    /* Add the removed timers back into the linked list if the timer type is periodic. */
-    for ( i = 0U; i < (uint32_t)SYS_TIME_MAX_TIMERS; i++)
-    {
-        /* tmrElapsed is cleared anytime a timer is stopped, started, reloaded
-         * or destroyed.
-         * If timer is stopped from CB, there is no need to add it back to list
-         * If timer is started from CB, it is already added to list by start routine
-         * If timer is reloaded from CB, it is already added to list by reload routine
-         * If timer is destroyed from CB, there is no need to add it back to list
-         * Note: tmrElapsedFlag is cleared when the application reads the status
-         * by calling the SYS_TIME_TimerPeriodHasExpired API.
-         */
-        if (timers[i].tmrElapsed == true)
+        if (level != 0U)
         {
-            timers[i].tmrElapsed = false;
+            /* Move timers of the slot to lower levels */
+            SYS_TIME_WheelCascade(level, (uint32_t)(nextTick >> (level * SYS_TIME_WHEEL_SLOT_BITS)) & SYS_TIME_WHEEL_SLOT_MASK);
+            continue;
+        }
 
-            if (timers[i].type == SYS_TIME_PERIODIC)
-            {
-                /* Reload the relative pending time with the requested time */
-                timers[i].relativeTimePending = timers[i].requestedTime;
-               (void) SYS_TIME_AddToList(&timers[i]);
-            }
+        tmr = SYS_TIME_WheelFirstTimer((uint32_t)nextTick & SYS_TIME_WHEEL_SLOT_MASK, now);
+        if (tmr == NULL)
+        {
+            /* Timers of the current tick not expired yet */
+            break;
         }
+
+        SYS_TIME_TimerExpire(tmr, now);
     }
+
+    SYS_TIME_WheelNextEventUpdate();
 }
 
 static void SYS_TIME_PLIBCallback(uint32_t status, uintptr_t context)
 {
     SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ *)&gSystemCounterObj;
-    SYS_TIME_TIMER_OBJ* tmrActive = counterObj->tmrActive;
     uint32_t elapsedCount = 0;
     bool interruptState;
 
     counterObj->hwTimerCurrentValue = counterObj->timePlib->timerCounterGet();
 
     elapsedCount = SYS_TIME_GetElapsedCount(counterObj->hwTimerCurrentValue);
+    counterObj->hwTimerPreviousValue = counterObj->hwTimerCurrentValue;
 
     counterObj->swCounter64 = counterObj->swCounter64 + elapsedCount;
+    counterObj->wheelCounter64 = counterObj->wheelCounter64 + elapsedCount;
 
-    if (tmrActive != NULL)
-    {
-        counterObj->interruptNestingCount++;
+    counterObj->interruptNestingCount++;
 
-        SYS_TIME_UpdateTime(elapsedCount);
+    SYS_TIME_UpdateTime();
 
-        counterObj->interruptNestingCount--;
-    }
+    counterObj->interruptNestingCount--;
 
     interruptState = SYS_INT_Disable();
     SYS_TIME_HwTimerCompareUpdate();
@@ -562,30 +683,41 @@ static SYS_TIME_HANDLE SYS_TIME_TimerObjectCreate(
     }
     if((gSystemCounterObj.status == SYS_STATUS_READY) && (period > 0U) && (period >= count))
     {
-        for(tmr = timers; tmr < &timers[SYS_TIME_MAX_TIMERS]; tmr++)
+        tmr = gSystemCounterObj.tmrFree;
+        if (tmr != NULL)
         {
-            if(tmr->inUse == false)
+            gSystemCounterObj.tmrFree = tmr->tmrNext;
+            tmrObjIndex = (uint32_t)(tmr - timers);
+
+            tmr->inUse = true;
+            tmr->active = false;
+            tmr->tmrElapsedFlag = false;
+            tmr->tmrElapsed = false;
+            tmr->type = type;
+            tmr->requestedTime = period;
+            tmr->callback = callBack;
+            tmr->context = context;
+            tmr->relativeTimePending = period - count;
+            tmr->tmrNext = NULL;
+            tmr->tmrPrev = NULL;
+            tmr->wheelLevel = SYS_TIME_WHEEL_NONE;
+
+            /* Assign a handle to this request. The timer handle must be unique. */
+            tmr->tmrHandle = (SYS_TIME_HANDLE) SYS_TIME_MAKE_HANDLE(gSysTimeTokenCount, (uint16_t)tmrObjIndex);
+            /* Update the token number. */
+            gSysTimeTokenCount = SYS_TIME_UPDATE_TOKEN(gSysTimeTokenCount);
+
+            tmrHandle = tmr->tmrHandle;
+
+            gSystemCounterObj.timersInUse++;
+            if (gSystemCounterObj.timersInUse > gSystemCounterObj.timersHighWater)
             {
-                tmr->inUse = true;
-                tmr->active = false;
-                tmr->tmrElapsedFlag = false;
-                tmr->tmrElapsed = false;
-                tmr->type = type;
-                tmr->requestedTime = period;
-                tmr->callback = callBack;
-                tmr->context = context;
-                tmr->relativeTimePending = period - count;
-
-                /* Assign a handle to this request. The timer handle must be unique. */
-                tmr->tmrHandle = (SYS_TIME_HANDLE) SYS_TIME_MAKE_HANDLE(gSysTimeTokenCount, (uint16_t)tmrObjIndex);
-                /* Update the token number. */
-                gSysTimeTokenCount = SYS_TIME_UPDATE_TOKEN(gSysTimeTokenCount);
-
-                tmrHandle = tmr->tmrHandle;
-
-                break;
+                gSystemCounterObj.timersHighWater = gSystemCounterObj.timersInUse;
             }
-            tmrObjIndex++;
+        }
+        else
+        {
+            gSystemCounterObj.createErrors++;
         }
     }
 
@@ -615,7 +747,12 @@ static void SYS_TIME_CounterInit(SYS_MODULE_INIT* init)
     counterObj->hwTimerCompareValue = SYS_TIME_HW_COUNTER_HALF_PERIOD;
 
     counterObj->swCounter64 = 0;
-    counterObj->tmrActive = NULL;
+    counterObj->wheelCounter64 = 0;
+    counterObj->wheelTick = 0;
+    counterObj->wheelNextEvent = SYS_TIME_WHEEL_NO_EVENT;
+    counterObj->wheelCount = 0;
+    (void) memset(counterObj->wheel, 0, sizeof(counterObj->wheel));
+    (void) memset(counterObj->wheelBitmap, 0, sizeof(counterObj->wheelBitmap));
     counterObj->interruptNestingCount = 0;
 
     counterObj->timePlib->timerCallbackSet(SYS_TIME_PLIBCallback, 0);
@@ -638,6 +775,8 @@ static void SYS_TIME_CounterInit(SYS_MODULE_INIT* init)
 
 SYS_MODULE_OBJ SYS_TIME_Initialize( const SYS_MODULE_INDEX index, const SYS_MODULE_INIT * const init )
 {
+    uint32_t tmrIndex;
+
     if(init == NULL || index != (uint32_t)SYS_TIME_INDEX_0)
     {
         return SYS_MODULE_OBJ_INVALID;
@@ -651,6 +790,21 @@ SYS_MODULE_OBJ SYS_TIME_Initialize( const SYS_MODULE_INDEX index, const SYS_MODU
     SYS_TIME_CounterInit((SYS_MODULE_INIT *)init);
     (void) memset(timers, 0, sizeof(timers));
 
+    /* All timer objects free */
+    gSystemCounterObj.tmrFree = NULL;
+    for (tmrIndex = (uint32_t)SYS_TIME_MAX_TIMERS; tmrIndex > 0U; tmrIndex--)
+    {
+        timers[tmrIndex - 1U].wheelLevel = SYS_TIME_WHEEL_NONE;
+        timers[tmrIndex - 1U].tmrNext = gSystemCounterObj.tmrFree;
+        gSystemCounterObj.tmrFree = &timers[tmrIndex - 1U];
+    }
+    gSystemCounterObj.timersInUse = 0;
+    gSystemCounterObj.timersHighWater = 0;
+    gSystemCounterObj.createErrors = 0;
+    gSystemCounterObj.expiredCount = 0;
+    gSystemCounterObj.lateMax = 0;
+    gSystemCounterObj.lateSum = 0;
+
     gSystemCounterObj.status = SYS_STATUS_READY;
 
     return (SYS_MODULE_OBJ)&gSystemCounterObj;
@@ -811,8 +965,8 @@ SYS_TIME_RESULT SYS_TIME_TimerReload(
 
     if((tmr != NULL) && (period > 0U) && (period >= count))
     {
-        /* Temporarily remove the timer from the list. Update and then add it back */
-        (void) SYS_TIME_RemoveFromList(tmr);
+        /* Temporarily remove the timer from the wheel. Update and then add it back */
+        SYS_TIME_WheelRemove(tmr);
         tmr->tmrElapsedFlag = false;
         tmr->tmrElapsed = false;
         tmr->type = type;
@@ -820,14 +974,7 @@ SYS_TIME_RESULT SYS_TIME_TimerReload(
         tmr->relativeTimePending = period - count;
         tmr->callback = callBack;
         tmr->context = context;
-        if (gSystemCounterObj.interruptNestingCount == 0U)
-        {
-            (void) SYS_TIME_TimerAdd(tmr);
-        }
-        else
-        {
-            (void) SYS_TIME_AddToList(tmr);
-        }
+        SYS_TIME_TimerAdd(tmr);
         tmr->active = true;
         result = SYS_TIME_SUCCESS;
     }
@@ -852,12 +999,13 @@ SYS_TIME_RESULT SYS_TIME_TimerDestroy(SYS_TIME_HANDLE handle)
     {
         if(tmr->active == true)
         {
-            (void) SYS_TIME_RemoveFromList(tmr);
+            SYS_TIME_WheelRemove(tmr);
             tmr->active = false;
         }
         tmr->tmrElapsedFlag = false;
         tmr->tmrElapsed = false;
         tmr->inUse = false;
+        SYS_TIME_FreeListPush(tmr);
         result = SYS_TIME_SUCCESS;
     }
 
@@ -889,14 +1037,7 @@ SYS_TIME_RESULT SYS_TIME_TimerStart(SYS_TIME_HANDLE handle)
             {
                 tmr->relativeTimePending = tmr->requestedTime;
             }
-            if (gSystemCounterObj.interruptNestingCount == 0U)
-            {
-                SYS_TIME_TimerAdd(tmr);
-            }
-            else
-            {
-                (void) SYS_TIME_AddToList(tmr);
-            }
+            SYS_TIME_TimerAdd(tmr);
             tmr->tmrElapsedFlag = false;
             tmr->tmrElapsed = false;
             tmr->active = true;
@@ -924,7 +1065,7 @@ SYS_TIME_RESULT SYS_TIME_TimerStop(SYS_TIME_HANDLE handle)
     {
         if (tmr->active == true)
         {
-            (void) SYS_TIME_RemoveFromList(tmr);
+            SYS_TIME_WheelRemove(tmr);
             tmr->tmrElapsedFlag = false;
             tmr->tmrElapsed = false;
             tmr->active = false;
@@ -1093,3 +1234,36 @@ SYS_TIME_HANDLE SYS_TIME_CallbackRegisterMS ( SYS_TIME_CALLBACK callback, uintpt
 
     return handle;
 }
+
+// *****************************************************************************
+// *****************************************************************************
+// Section:  SYS TIME Statistics Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+void SYS_TIME_StatisticsGet ( SYS_TIME_STATISTICS* stats )
+{
+    SYS_TIME_COUNTER_OBJ* counterObj = (SYS_TIME_COUNTER_OBJ* )&gSystemCounterObj;
+
+    if ((stats == NULL) || (SYS_TIME_ResourceLock() == false))
+    {
+        return;
+    }
+
+    stats->timersCapacity = (uint16_t)SYS_TIME_MAX_TIMERS;
+    stats->timersInUse = counterObj->timersInUse;
+    stats->timersHighWater = counterObj->timersHighWater;
+    stats->createErrors = counterObj->createErrors;
+    stats->expiredCount = counterObj->expiredCount;
+    stats->lateMaxUS = SYS_TIME_CountToUS(counterObj->lateMax);
+
+    if (counterObj->expiredCount == 0U)
+    {
+        stats->lateMeanUS = 0;
+    }
+    else
+    {
+        stats->lateMeanUS = SYS_TIME_CountToUS((uint32_t)(counterObj->lateSum / counterObj->expiredCount));
+    }
+
+    SYS_TIME_ResourceUnlock();
+}
@@ -79,6 +79,33 @@
 #define SYS_TIME_HANDLE_TOKEN_MAX              (0xFFFFU)
 #define SYS_TIME_INDEX_MASK                    (0x0000FFFFUL)
 
+// *****************************************************************************
+/* Timer Wheel Macros
+
+  Summary:
+    Timer wheel geometry.
+
+  Description:
+    Active timers are kept in a hierarchical timing wheel. The wheel tick is
+    (1 << SYS_TIME_WHEEL_TICK_SHIFT) hardware counts. Each level has
+    SYS_TIME_WHEEL_SLOTS slots, and a slot of level n spans a whole turn of
+    level n-1. Timers are placed in the lowest level whose next turn contains
+    their expiry tick, and moved down (cascaded) when the wheel reaches their
+    slot. The hardware compare is programmed to the exact expiry of the next
+    timer in level 0, or to the start of the next slot to cascade.
+
+  Remarks:
+    The wheel must span the maximum timer period plus the maximum time
+    between wheel updates (half the hardware counter period).
+*/
+
+#define SYS_TIME_WHEEL_LEVELS                  (4U)
+#define SYS_TIME_WHEEL_SLOT_BITS               (6U)
+#define SYS_TIME_WHEEL_SLOTS                   (1UL << SYS_TIME_WHEEL_SLOT_BITS)
+#define SYS_TIME_WHEEL_SLOT_MASK               (SYS_TIME_WHEEL_SLOTS - 1U)
+#define SYS_TIME_WHEEL_NONE                    (0xFFU)
+#define SYS_TIME_WHEEL_NO_EVENT                (UINT64_MAX)
+
 // *****************************************************************************
 /* SYS TIME OBJECT INSTANCE structure
 
@@ -97,13 +124,17 @@ typedef struct SYS_TIME_TIMER_OBJ_T{
       bool                          active;    /* TRUE if soft timer enabled */
       SYS_TIME_CALLBACK_TYPE        type;    /* periodic or not */
       uint32_t                      requestedTime;    /* time requested */
-      volatile uint32_t             relativeTimePending;    /* time to wait, relative incase of timers in the list */
+      volatile uint32_t             relativeTimePending;    /* time to wait, to wait when the timer is started */
       SYS_TIME_CALLBACK             callback;    /* set to TRUE at timeout */
       uintptr_t                     context; /* context */
       volatile bool                 tmrElapsedFlag;   /* Set on every timer expiry. Cleared after user reads the status. */
       volatile bool                 tmrElapsed;    /* Set on every timer expiry. Cleared after timer is added back to the list */
-      struct SYS_TIME_TIMER_OBJ_T*   tmrNext; /* Next timer */
+      uint64_t                      expiry;    /* absolute expiry time (counts), while in the wheel */
+      struct SYS_TIME_TIMER_OBJ_T*   tmrNext; /* Next timer in the wheel slot or free list */
+      struct SYS_TIME_TIMER_OBJ_T*   tmrPrev; /* Previous timer in the wheel slot */
       SYS_TIME_HANDLE               tmrHandle; /* Unique handle for object */
+      uint8_t                       wheelLevel;    /* wheel level, SYS_TIME_WHEEL_NONE if not in the wheel */
+      uint8_t                       wheelSlot;    /* wheel slot in the level */
 } SYS_TIME_TIMER_OBJ;
 
 
@@ -120,7 +151,24 @@ typedef struct{
     volatile uint64_t               swCounter64;           /* Software 64-bit counter */
     uint8_t                         interruptNestingCount;
     bool                            hwTimerIntStatus;
-    SYS_TIME_TIMER_OBJ*             tmrActive;
+    /* Timer wheel: slot lists and bitmap of non-empty slots per level */
+    SYS_TIME_TIMER_OBJ*             wheel[SYS_TIME_WHEEL_LEVELS][SYS_TIME_WHEEL_SLOTS];
+    uint64_t                        wheelBitmap[SYS_TIME_WHEEL_LEVELS];
+    /* Monotonic 64-bit counter (not modified by SYS_TIME_CounterSet) */
+    uint64_t                        wheelCounter64;
+    /* Wheel position, in wheel ticks */
+    uint64_t                        wheelTick;
+    /* Next wheel event (counts), as programmed in the hardware compare */
+    uint64_t                        wheelNextEvent;
+    uint16_t                        wheelCount;
+    SYS_TIME_TIMER_OBJ*             tmrFree;
+    /* Statistics */
+    uint16_t                        timersInUse;
+    uint16_t                        timersHighWater;
+    uint32_t                        createErrors;
+    uint32_t                        expiredCount;
+    uint32_t                        lateMax;
+    uint64_t                        lateSum;
     /* Mutex to protect access to the shared resources */
     OSAL_MUTEX_DECLARE(timerMutex);
 
@@ -218,6 +218,47 @@ typedef enum
 typedef void ( * SYS_TIME_CALLBACK ) ( uintptr_t context );
 
 
+// *****************************************************************************
+/* System Time Statistics
+
+  Summary:
+    Usage and accuracy statistics of the time system service.
+
+  Description:
+    This data type contains the usage of the software timer pool and the
+    delay between the expiry time of the timers and the time their expiry is
+    processed (late-fire), since the service was initialized.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    // Number of software timer objects (SYS_TIME_MAX_TIMERS)
+    uint16_t timersCapacity;
+
+    // Number of software timer objects currently in use
+    uint16_t timersInUse;
+
+    // Maximum number of software timer objects used at the same time
+    uint16_t timersHighWater;
+
+    // Number of timer creations failed because all objects were in use
+    uint32_t createErrors;
+
+    // Number of timer expirations
+    uint32_t expiredCount;
+
+    // Maximum late-fire time, in microseconds
+    uint32_t lateMaxUS;
+
+    // Mean late-fire time, in microseconds
+    uint32_t lateMeanUS;
+
+} SYS_TIME_STATISTICS;
+
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: System Interface Functions
@@ -1409,6 +1450,53 @@ SYS_TIME_RESULT SYS_TIME_TimerStop ( SYS_TIME_HANDLE handle );
 bool SYS_TIME_TimerPeriodHasExpired ( SYS_TIME_HANDLE handle );
 
 
+
+// *****************************************************************************
+// *****************************************************************************
+// Section:  SYS TIME Statistics Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+       void SYS_TIME_StatisticsGet ( SYS_TIME_STATISTICS* stats )
+
+   Summary:
+       Gets the statistics of the time system service.
+
+   Description:
+       This function gets the usage of the software timer objects and the
+       late-fire time of the expired timers.
+
+   Precondition:
+       The SYS_TIME_Initialize function must have been called before calling
+       this function.
+
+   Parameters:
+       stats    - Pointer to store the statistics
+
+   Returns:
+       None.
+
+  Example:
+       <code>
+       SYS_TIME_STATISTICS stats;
+
+       SYS_TIME_StatisticsGet(&stats);
+       if (stats.timersHighWater == stats.timersCapacity)
+       {
+           // Increase SYS_TIME_MAX_TIMERS
+       }
+       </code>
+
+  Remarks:
+       The late-fire time is measured from the expiry time to the time the
+       timer interrupt reads the hardware counter, so it includes the timer
+       callbacks executed before in the same interrupt.
+*/
+
+void SYS_TIME_StatisticsGet ( SYS_TIME_STATISTICS* stats );
+
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
 
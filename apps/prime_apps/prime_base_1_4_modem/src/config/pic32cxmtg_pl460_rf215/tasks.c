@@ -94,6 +94,9 @@ DRV_MEMORY_Tasks(sysObj.drvMemory0);
     /* Maintain Firwmare Upgrade */
     SRV_FU_Tasks();
     
+    /* Maintain PRIME Storage */
+    SRV_STORAGE_Tasks();
+    
     /* Maintain PRIME */
     PRIME_Tasks(sysObj.primeStack);
     
@@ -36,7 +36,23 @@
     This enumeration lists the message communication commands.
 
  Remarks:
-    None.
+    Messages to the host are serialized in a pool of TX buffers and sent
+    through the USI. When the pool and the serial queue are full:
+    - Data indications (CL Null and 4-32 data) wait in the PRIME stack
+      callback until there is room, about the time of one frame in the serial
+      line. They are only dropped if no room appears in 100 ms (serial link
+      down).
+    - Event indications (establish, release, join, leave and base management)
+      are dropped.
+    - Confirms and responses use a buffer that indications cannot take, and
+      are dropped only if it is in use too.
+
+    APP_MODEM_STATS_RESPONSE_CMD carries (counters in big endian):
+    RX queue size (1 byte), RX queue high water (1), RX commands dropped with
+    queue full (4), RX commands too big (4), TX pool size (1), TX pool peak
+    use (1), TX pool exhausted (4), TX messages dropped with pool full (4),
+    data indications that waited (4), longest wait in us (4) and data
+    indications dropped with the link down (4).
 */
 typedef enum 
 {
@@ -170,6 +186,10 @@ typedef enum
     APP_MODEM_CL_NULL_MLME_MP_DEMOTE_REQUEST_CMD                = 0x71,
     APP_MODEM_CL_NULL_MLME_MP_DEMOTE_CONFIRM_CMD                = 0x72,
     APP_MODEM_CL_NULL_MLME_MP_DEMOTE_INDICATION_CMD             = 0x73,
+
+    /* Modem application queue statistics commands */
+    APP_MODEM_STATS_REQUEST_CMD                                 = 0x74,
+    APP_MODEM_STATS_RESPONSE_CMD                                = 0x75,
             
     APP_MODEM_API_ERROR_CMD
 } APP_MODEM_PRIME_API_CMD;
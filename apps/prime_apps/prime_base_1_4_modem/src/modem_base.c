@@ -23,12 +23,36 @@
 #include "definitions.h"
 #include "modem.h"
 
-#define MAX_NUM_MSG_RCV    (1)
+/* Number of received commands that can be queued (must be a power of 2) */
+#define MAX_NUM_MSG_RCV    (8)
 
-#define MAX_LENGTH_BUFF    CL_432_MAX_LENGTH_DATA
+/* Maximum number of queued commands processed per APP_Modem_Tasks call */
+#define MAX_NUM_MSG_PROCESS    (4)
+
+#if ((MAX_NUM_MSG_RCV & (MAX_NUM_MSG_RCV - 1)) != 0)
+#error "MAX_NUM_MSG_RCV must be a power of 2"
+#endif
+
+/* Number of buffers used to tx serialization */
+#define MAX_NUM_MSG_SEND    (4)
+
+/* Number of buffers kept for confirms and responses, which the host waits
+ * for. Unsolicited indications cannot take them */
+#define MAX_NUM_MSG_SEND_RESERVED    (1)
+
+#if (MAX_NUM_MSG_SEND_RESERVED >= MAX_NUM_MSG_SEND)
+#error "MAX_NUM_MSG_SEND_RESERVED must be lower than MAX_NUM_MSG_SEND"
+#endif
 
-/* Buffer used to tx serialization */
-static uint8_t appSerialBuf[MAX_LENGTH_BUFF];
+/* Time between retries while a data indication waits for room in the serial
+ * queue (us) */
+#define APP_MODEM_TX_RETRY_US    (100U)
+
+/* Time without room in the serial queue after which the serial link is
+ * considered down and the data indication is dropped (ms) */
+#define APP_MODEM_TX_LINK_DOWN_MS    (100U)
+
+#define MAX_LENGTH_BUFF    CL_432_MAX_LENGTH_DATA
 
 const PRIME_API *gPrimeApi;
 
@@ -45,8 +69,62 @@ typedef struct APP_MODEM_MSG_RCV_tag
 
 static APP_MODEM_MSG_RCV sAppModemMsgRecv[MAX_NUM_MSG_RCV];
 
-static uint8_t outputMsgRecvIndex;
-static uint8_t inputMsgRecvIndex;
+/* Single-producer (USI callback) / single-consumer (APP_Modem_Tasks) ring.
+ * Counters are free-running: the slot index is the counter modulo
+ * MAX_NUM_MSG_RCV and the number of queued commands is their difference. */
+static volatile uint32_t outputMsgRecvCount;
+static volatile uint32_t inputMsgRecvCount;
+
+/* Reception queue statistics */
+typedef struct APP_MODEM_RX_QUEUE_STATS_tag
+{
+    uint32_t dropFull;
+    uint32_t dropTooBig;
+    uint8_t highWater;
+} APP_MODEM_RX_QUEUE_STATS;
+
+static APP_MODEM_RX_QUEUE_STATS sAppModemRxQueueStats;
+
+/* Pool of buffers used to tx serialization */
+typedef struct APP_MODEM_MSG_SEND_tag
+{
+    uint16_t len;
+    bool inUse;
+    uint8_t dataBuf[MAX_LENGTH_BUFF];
+} APP_MODEM_MSG_SEND;
+
+static APP_MODEM_MSG_SEND sAppModemMsgSend[MAX_NUM_MSG_SEND];
+
+/* Kind of message to serialize in a TX buffer */
+typedef enum
+{
+    /* Confirm or response to a host request */
+    APP_MODEM_TX_RESPONSE,
+    /* Received data, waits for room in the serial queue when the pool runs
+     * out */
+    APP_MODEM_TX_DATA,
+    /* Unsolicited event indication, dropped when the pool runs out */
+    APP_MODEM_TX_INDICATION,
+} APP_MODEM_TX_TYPE;
+
+/* FIFO of filled buffers waiting to be sent through the USI */
+static uint8_t sAppModemMsgSendFifo[MAX_NUM_MSG_SEND];
+static uint8_t sAppModemMsgSendFifoFirst;
+static uint8_t sAppModemMsgSendFifoNum;
+
+/* Transmission pool statistics */
+typedef struct APP_MODEM_TX_POOL_STATS_tag
+{
+    uint32_t exhausted;
+    uint32_t dropFull;
+    uint32_t waitFull;
+    uint32_t waitMaxUs;
+    uint32_t dropLinkDown;
+    uint8_t inUse;
+    uint8_t peakInUse;
+} APP_MODEM_TX_POOL_STATS;
+
+static APP_MODEM_TX_POOL_STATS sAppModemTxPoolStats;
 
 /* Data transmission indication variable */
 static uint8_t sRxdataIndication;
@@ -55,28 +133,228 @@ static uint8_t sTxdataIndication;
 
 static void APP_Modem_SetCallbacks(void);
 
+static void APP_Modem_TxBufferRelease(void)
+{
+    uint8_t index;
+
+    /* Return the first buffer of the FIFO to the pool */
+    index = sAppModemMsgSendFifo[sAppModemMsgSendFifoFirst];
+    sAppModemMsgSend[index].inUse = false;
+    sAppModemTxPoolStats.inUse--;
+
+    if (++sAppModemMsgSendFifoFirst == MAX_NUM_MSG_SEND)
+    {
+        sAppModemMsgSendFifoFirst = 0;
+    }
+
+    sAppModemMsgSendFifoNum--;
+}
+
+static void APP_Modem_TxBufferFlush(void)
+{
+    APP_MODEM_MSG_SEND *msgSend;
+    size_t sendResult;
+
+    /* Send pending buffers in order and return them to the pool */
+    while (sAppModemMsgSendFifoNum > 0U)
+    {
+        msgSend = &sAppModemMsgSend[sAppModemMsgSendFifo[sAppModemMsgSendFifoFirst]];
+
+        sendResult = SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API,
+                                          msgSend->dataBuf, msgSend->len);
+
+        if ((sendResult == 0U) && (SRV_USI_IsSendBusy(gUsiHandle) == true))
+        {
+            /* Serial queue full: keep this and next buffers for the next
+             * call, so that no message is lost or reordered */
+            break;
+        }
+
+        APP_Modem_TxBufferRelease();
+    }
+}
+
+static uint8_t APP_Modem_TxBufferFindFree(void)
+{
+    uint8_t index;
+
+    for (index = 0; index < MAX_NUM_MSG_SEND; index++)
+    {
+        if (sAppModemMsgSend[index].inUse == false)
+        {
+            break;
+        }
+    }
+
+    return index;
+}
+
+static bool APP_Modem_TxBufferWait(uint8_t maxInUse)
+{
+    uint32_t startCount;
+    uint32_t retryCount;
+    uint32_t elapsedCount;
+
+    /* Wait until the USART has sent enough of the serial queue to take the
+     * oldest pending buffer. The stack callback is delayed by about the time
+     * of a frame in the serial line, so received data is not lost */
+    sAppModemTxPoolStats.waitFull++;
+    startCount = SYS_TIME_CounterGet();
+    retryCount = startCount;
+
+    do
+    {
+        if ((SYS_TIME_CounterGet() - retryCount) >= SYS_TIME_USToCount(APP_MODEM_TX_RETRY_US))
+        {
+            retryCount = SYS_TIME_CounterGet();
+            APP_Modem_TxBufferFlush();
+        }
+
+        elapsedCount = SYS_TIME_CounterGet() - startCount;
+    } while ((sAppModemTxPoolStats.inUse >= maxInUse) &&
+             (elapsedCount < SYS_TIME_MSToCount(APP_MODEM_TX_LINK_DOWN_MS)));
+
+    if (SYS_TIME_CountToUS(elapsedCount) > sAppModemTxPoolStats.waitMaxUs)
+    {
+        sAppModemTxPoolStats.waitMaxUs = SYS_TIME_CountToUS(elapsedCount);
+    }
+
+    return (sAppModemTxPoolStats.inUse < maxInUse);
+}
+
+static uint8_t *APP_Modem_TxBufferGet(APP_MODEM_TX_TYPE type)
+{
+    uint8_t index;
+    uint8_t maxInUse = MAX_NUM_MSG_SEND;
+
+    if (type != APP_MODEM_TX_RESPONSE)
+    {
+        maxInUse -= MAX_NUM_MSG_SEND_RESERVED;
+    }
+
+    if (sAppModemTxPoolStats.inUse >= maxInUse)
+    {
+        /* Pool exhausted: send pending buffers now to release them */
+        sAppModemTxPoolStats.exhausted++;
+        APP_Modem_TxBufferFlush();
+
+        if ((sAppModemTxPoolStats.inUse >= maxInUse) && (type == APP_MODEM_TX_DATA))
+        {
+            /* Serial queue full too: received data waits for the USART */
+            if (APP_Modem_TxBufferWait(maxInUse) == false)
+            {
+                /* Serial link down */
+                sAppModemTxPoolStats.dropLinkDown++;
+                return NULL;
+            }
+        }
+        else if (sAppModemTxPoolStats.inUse >= maxInUse)
+        {
+            /* Serial queue full too: the caller drops the event indication
+             * or response instead of waiting for the USART in the stack
+             * callback */
+            sAppModemTxPoolStats.dropFull++;
+            return NULL;
+        }
+    }
+
+    index = APP_Modem_TxBufferFindFree();
+    sAppModemMsgSend[index].inUse = true;
+
+    sAppModemTxPoolStats.inUse++;
+    if (sAppModemTxPoolStats.inUse > sAppModemTxPoolStats.peakInUse)
+    {
+        sAppModemTxPoolStats.peakInUse = sAppModemTxPoolStats.inUse;
+    }
+
+    return sAppModemMsgSend[index].dataBuf;
+}
+
+static void APP_Modem_TxBufferPut(uint8_t *serialBuf, uint16_t serialLen)
+{
+    uint8_t index;
+    uint8_t fifoIndex;
+
+    for (index = 0; index < MAX_NUM_MSG_SEND; index++)
+    {
+        if (sAppModemMsgSend[index].dataBuf == serialBuf)
+        {
+            break;
+        }
+    }
+
+    if (index == MAX_NUM_MSG_SEND)
+    {
+        /* Not a buffer from the pool */
+        return;
+    }
+
+    sAppModemMsgSend[index].len = serialLen;
+
+    /* Append to the FIFO, the buffer is sent from APP_Modem_Tasks */
+    fifoIndex = sAppModemMsgSendFifoFirst + sAppModemMsgSendFifoNum;
+    if (fifoIndex >= MAX_NUM_MSG_SEND)
+    {
+        fifoIndex -= MAX_NUM_MSG_SEND;
+    }
+
+    sAppModemMsgSendFifo[fifoIndex] = index;
+    sAppModemMsgSendFifoNum++;
+}
+
+static bool APP_Modem_TxSendDirect(uint8_t *header, uint16_t headerLen,
+        uint8_t *data, uint16_t dataLen, uint8_t *trailer, uint16_t trailerLen)
+{
+    SRV_USI_MSG_SEGMENT segments[3];
+
+    /* Older messages wait in the FIFO: keep the order */
+    if (sAppModemMsgSendFifoNum > 0U)
+    {
+        return false;
+    }
+
+    /* Encode the payload from the stack buffer, without copying it into a
+     * TX serialization buffer */
+    segments[0].pData = header;
+    segments[0].length = headerLen;
+    segments[1].pData = data;
+    segments[1].length = dataLen;
+    segments[2].pData = trailer;
+    segments[2].length = trailerLen;
+
+    return (SRV_USI_Send_Message_Segments(gUsiHandle, SRV_USI_PROT_ID_PRIME_API,
+                                          segments, 3) > 0U);
+}
+
 static void APP_Modem_EstablishIndication(uint16_t conHandle, uint8_t *eui48,
         uint8_t type, uint8_t *data, uint16_t dataLen, uint8_t cfbytes,
         uint8_t ae)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_INDICATION);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_ESTABLISH_INDICATION_CMD;
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle);
-    memcpy(&appSerialBuf[serialLen], eui48, 6);
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_ESTABLISH_INDICATION_CMD;
+    serialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
+    serialBuf[serialLen++] = (uint8_t)(conHandle);
+    memcpy(&serialBuf[serialLen], eui48, 6);
     serialLen += 6;
-    appSerialBuf[serialLen++] = type;
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen);
-    memcpy(&appSerialBuf[serialLen], data, dataLen);
+    serialBuf[serialLen++] = type;
+    serialBuf[serialLen++] = (uint8_t)(dataLen >> 8);
+    serialBuf[serialLen++] = (uint8_t)(dataLen);
+    memcpy(&serialBuf[serialLen], data, dataLen);
     serialLen += dataLen;
-    appSerialBuf[serialLen++] = cfbytes;
-    appSerialBuf[serialLen++] = ae;
+    serialBuf[serialLen++] = cfbytes;
+    serialBuf[serialLen++] = ae;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_EstablishConfirm(uint16_t conHandle,
@@ -84,53 +362,74 @@ static void APP_Modem_EstablishConfirm(uint16_t conHandle,
             uint8_t *data, uint16_t dataLen, uint8_t ae)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_ESTABLISH_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle);
-    appSerialBuf[serialLen++] = result;
-    memcpy(&appSerialBuf[serialLen], eui48, 6);
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
+
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_ESTABLISH_CONFIRM_CMD;
+    serialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
+    serialBuf[serialLen++] = (uint8_t)(conHandle);
+    serialBuf[serialLen++] = result;
+    memcpy(&serialBuf[serialLen], eui48, 6);
     serialLen += 6;
-    appSerialBuf[serialLen++] = type;
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen);
-    memcpy(&appSerialBuf[serialLen], data, dataLen);
+    serialBuf[serialLen++] = type;
+    serialBuf[serialLen++] = (uint8_t)(dataLen >> 8);
+    serialBuf[serialLen++] = (uint8_t)(dataLen);
+    memcpy(&serialBuf[serialLen], data, dataLen);
     serialLen += dataLen;
-    appSerialBuf[serialLen++] = ae;
+    serialBuf[serialLen++] = ae;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_ReleaseIndication(uint16_t conHandle,
                         MAC_RELEASE_INDICATION_REASON reason)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_INDICATION);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_RELEASE_INDICATION_CMD;
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle);
-    appSerialBuf[serialLen++] = reason;
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_RELEASE_INDICATION_CMD;
+    serialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
+    serialBuf[serialLen++] = (uint8_t)(conHandle);
+    serialBuf[serialLen++] = reason;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_ReleaseConfirm(uint16_t conHandle,
                                      MAC_RELEASE_CONFIRM_RESULT result)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_RELEASE_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle);
-    appSerialBuf[serialLen++] = result;
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_RELEASE_CONFIRM_CMD;
+    serialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
+    serialBuf[serialLen++] = (uint8_t)(conHandle);
+    serialBuf[serialLen++] = result;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_JoinIndication(uint16_t conHandle,
@@ -138,117 +437,169 @@ static void APP_Modem_JoinIndication(uint16_t conHandle,
         uint8_t ae)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_INDICATION);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_JOIN_INDICATION_CMD;
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle);
-    memcpy(&appSerialBuf[serialLen], eui48, 6);
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_JOIN_INDICATION_CMD;
+    serialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
+    serialBuf[serialLen++] = (uint8_t)(conHandle);
+    memcpy(&serialBuf[serialLen], eui48, 6);
     serialLen += 6;
-    appSerialBuf[serialLen++] = conType;
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen);
-    memcpy(&appSerialBuf[serialLen], data, dataLen);
+    serialBuf[serialLen++] = conType;
+    serialBuf[serialLen++] = (uint8_t)(dataLen >> 8);
+    serialBuf[serialLen++] = (uint8_t)(dataLen);
+    memcpy(&serialBuf[serialLen], data, dataLen);
     serialLen += dataLen;
-    appSerialBuf[serialLen++] = ae;
+    serialBuf[serialLen++] = ae;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_JoinConfirm(uint16_t conHandle,
         MAC_JOIN_CONFIRM_RESULT result, uint8_t ae)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_JOIN_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle);
-    appSerialBuf[serialLen++] = result;
-    appSerialBuf[serialLen++] = ae;
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_JOIN_CONFIRM_CMD;
+    serialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
+    serialBuf[serialLen++] = (uint8_t)(conHandle);
+    serialBuf[serialLen++] = result;
+    serialBuf[serialLen++] = ae;
+
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_LeaveConfirm(uint16_t conHandle,
                                    MAC_LEAVE_CONFIRM_RESULT result)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_LEAVE_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle);
-    appSerialBuf[serialLen++] = result;
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_LEAVE_CONFIRM_CMD;
+    serialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
+    serialBuf[serialLen++] = (uint8_t)(conHandle);
+    serialBuf[serialLen++] = result;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_LeaveIndication(uint16_t conHandle, uint8_t *eui48)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_INDICATION);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_LEAVE_INDICATION_CMD;
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle);
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_LEAVE_INDICATION_CMD;
+    serialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
+    serialBuf[serialLen++] = (uint8_t)(conHandle);
     if(eui48 != NULL)
     {
-        memcpy(&appSerialBuf[serialLen], eui48, 6);
+        memcpy(&serialBuf[serialLen], eui48, 6);
     }
     else
     {
-        memset(&appSerialBuf[serialLen], 0xff, 6);
+        memset(&serialBuf[serialLen], 0xff, 6);
     }
 
     serialLen += 6;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_DataConfirm(uint16_t conHandle, uint8_t *dataBuf,
             MAC_DATA_CONFIRM_RESULT result)
 {
     uint8_t serialLen = 0U;
+    uint8_t *serialBuf;
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_DATA_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle);
-    appSerialBuf[serialLen++] = (uint8_t)((uint32_t)dataBuf >> 24);
-    appSerialBuf[serialLen++] = (uint8_t)((uint32_t)dataBuf >> 16);
-    appSerialBuf[serialLen++] = (uint8_t)((uint32_t)dataBuf >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)((uint32_t)dataBuf);
-    appSerialBuf[serialLen++] = result;
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_DATA_CONFIRM_CMD;
+    serialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
+    serialBuf[serialLen++] = (uint8_t)(conHandle);
+    serialBuf[serialLen++] = (uint8_t)((uint32_t)dataBuf >> 24);
+    serialBuf[serialLen++] = (uint8_t)((uint32_t)dataBuf >> 16);
+    serialBuf[serialLen++] = (uint8_t)((uint32_t)dataBuf >> 8);
+    serialBuf[serialLen++] = (uint8_t)((uint32_t)dataBuf);
+    serialBuf[serialLen++] = result;
+
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_DataIndication(uint16_t conHandle,
         uint8_t *data, uint16_t dataLen, uint32_t timeRef)
 {
+    uint8_t header[5];
+    uint8_t trailer[4];
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    header[0] = APP_MODEM_CL_NULL_DATA_INDICATION_CMD;
+    header[1] = (uint8_t)(conHandle >> 8);
+    header[2] = (uint8_t)(conHandle);
+    header[3] = (uint8_t)(dataLen >> 8);
+    header[4] = (uint8_t)(dataLen);
+    trailer[0] = (uint8_t)(timeRef >> 24);
+    trailer[1] = (uint8_t)(timeRef >> 16);
+    trailer[2] = (uint8_t)(timeRef >> 8);
+    trailer[3] = (uint8_t)(timeRef);
+
+    if (APP_Modem_TxSendDirect(header, sizeof(header), data, dataLen,
+                               trailer, sizeof(trailer)) == false)
+    {
+        /* Get a free TX serialization buffer */
+        serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_DATA);
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_DATA_INDICATION_CMD;
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(conHandle);
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen);
-    memcpy(&appSerialBuf[serialLen], data, dataLen);
-    serialLen += dataLen;
-    appSerialBuf[serialLen++] = (uint8_t)(timeRef >> 24);
-    appSerialBuf[serialLen++] = (uint8_t)(timeRef >> 16);
-    appSerialBuf[serialLen++] = (uint8_t)(timeRef >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(timeRef);
-
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+        if (serialBuf != NULL)
+        {
+            memcpy(&serialBuf[serialLen], header, sizeof(header));
+            serialLen += sizeof(header);
+            memcpy(&serialBuf[serialLen], data, dataLen);
+            serialLen += dataLen;
+            memcpy(&serialBuf[serialLen], trailer, sizeof(trailer));
+            serialLen += sizeof(trailer);
+
+            /* Queue packet for transmission */
+            APP_Modem_TxBufferPut(serialBuf, serialLen);
+        }
+    }
 
     /* Rx data indication */
     sRxdataIndication = true;
@@ -257,57 +608,86 @@ static void APP_Modem_DataIndication(uint16_t conHandle,
 static void APP_Modem_PLME_ResetConfirm(PLME_RESULT result, uint16_t pch)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_PLME_RESET_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = result;
-    appSerialBuf[serialLen++] = (uint8_t)(pch >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)pch;
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_PLME_RESET_CONFIRM_CMD;
+    serialBuf[serialLen++] = result;
+    serialBuf[serialLen++] = (uint8_t)(pch >> 8);
+    serialBuf[serialLen++] = (uint8_t)pch;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_PLME_SleepConfirm(PLME_RESULT result, uint16_t pch)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_PLME_SLEEP_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = result;
-    appSerialBuf[serialLen++] = (uint8_t)(pch >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)pch;
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_PLME_SLEEP_CONFIRM_CMD;
+    serialBuf[serialLen++] = result;
+    serialBuf[serialLen++] = (uint8_t)(pch >> 8);
+    serialBuf[serialLen++] = (uint8_t)pch;
+
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_PLME_ResumeConfirm(PLME_RESULT result, uint16_t pch)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_PLME_RESUME_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = result;
-    appSerialBuf[serialLen++] = (uint8_t)(pch >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)pch;
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_PLME_RESUME_CONFIRM_CMD;
+    serialBuf[serialLen++] = result;
+    serialBuf[serialLen++] = (uint8_t)(pch >> 8);
+    serialBuf[serialLen++] = (uint8_t)pch;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_PLME_GetConfirm(PLME_RESULT status,
         uint16_t pibAttrib, void *pibValue, uint8_t pibSize, uint16_t pch)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
     uint16_t temp16;
     uint32_t temp32;
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_PLME_GET_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = status;
-    appSerialBuf[serialLen++] = (uint8_t)(pibAttrib >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(pibAttrib);
-    appSerialBuf[serialLen++] = pibSize;
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
+
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_PLME_GET_CONFIRM_CMD;
+    serialBuf[serialLen++] = status;
+    serialBuf[serialLen++] = (uint8_t)(pibAttrib >> 8);
+    serialBuf[serialLen++] = (uint8_t)(pibAttrib);
+    serialBuf[serialLen++] = pibSize;
 
     /* Check size */
     switch (pibSize)
@@ -316,75 +696,96 @@ static void APP_Modem_PLME_GetConfirm(PLME_RESULT status,
             /* Extract value */
             temp16 = *((uint16_t *)pibValue);
             /* Copy value into buffer with MSB in MSB */
-            appSerialBuf[serialLen++] = (uint8_t)(temp16 >> 8);
-            appSerialBuf[serialLen++] = (uint8_t)temp16;
+            serialBuf[serialLen++] = (uint8_t)(temp16 >> 8);
+            serialBuf[serialLen++] = (uint8_t)temp16;
             break;
 
         case 4:
             temp32 = *((uint32_t *)pibValue);
             /* Copy value into buffer with MSB in MSB */
-            appSerialBuf[serialLen++] = (uint8_t)(temp32 >> 24);
-            appSerialBuf[serialLen++] = (uint8_t)(temp32 >> 16);
-            appSerialBuf[serialLen++] = (uint8_t)(temp32 >> 8);
-            appSerialBuf[serialLen++] = (uint8_t)temp32;
+            serialBuf[serialLen++] = (uint8_t)(temp32 >> 24);
+            serialBuf[serialLen++] = (uint8_t)(temp32 >> 16);
+            serialBuf[serialLen++] = (uint8_t)(temp32 >> 8);
+            serialBuf[serialLen++] = (uint8_t)temp32;
             break;
 
         default:
             /* Copy value into buffer */
-            memcpy(&appSerialBuf[serialLen], (uint8_t *)pibValue, pibSize);
+            memcpy(&serialBuf[serialLen], (uint8_t *)pibValue, pibSize);
             /* Increase pointer */
             serialLen += pibSize;
     }
 
-    appSerialBuf[serialLen++] = (uint8_t)(pch >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)pch;
+    serialBuf[serialLen++] = (uint8_t)(pch >> 8);
+    serialBuf[serialLen++] = (uint8_t)pch;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_PLME_SetConfirm(PLME_RESULT result, uint16_t pch)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_PLME_SET_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = result;
-    appSerialBuf[serialLen++] = (uint8_t)(pch >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)pch;
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_PLME_SET_CONFIRM_CMD;
+    serialBuf[serialLen++] = result;
+    serialBuf[serialLen++] = (uint8_t)(pch >> 8);
+    serialBuf[serialLen++] = (uint8_t)pch;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_MLME_PromoteConfirm(MLME_RESULT result)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_PROMOTE_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = result;
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_PROMOTE_CONFIRM_CMD;
+    serialBuf[serialLen++] = result;
+
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_MLME_MP_PromoteConfirm(MLME_RESULT result)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_MP_PROMOTE_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = result;
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_MP_PROMOTE_CONFIRM_CMD;
+    serialBuf[serialLen++] = result;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_MLME_ResetConfirm(MLME_RESULT result)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
 
     /* Check result */
     if (result == MLME_RESULT_DONE)
@@ -393,26 +794,40 @@ static void APP_Modem_MLME_ResetConfirm(MLME_RESULT result)
         APP_Modem_SetCallbacks();
     }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_RESET_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = result;
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
+
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_RESET_CONFIRM_CMD;
+    serialBuf[serialLen++] = result;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_MLME_GetConfirm(MLME_RESULT status, uint16_t pibAttrib,
                                       void *pibValue, uint8_t pibSize)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
     uint16_t temp16;
     uint32_t temp32;
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_GET_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = status;
-    appSerialBuf[serialLen++] = (uint8_t)(pibAttrib >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(pibAttrib);
-    appSerialBuf[serialLen++] = pibSize;
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
+
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_GET_CONFIRM_CMD;
+    serialBuf[serialLen++] = status;
+    serialBuf[serialLen++] = (uint8_t)(pibAttrib >> 8);
+    serialBuf[serialLen++] = (uint8_t)(pibAttrib);
+    serialBuf[serialLen++] = pibSize;
 
     /* Check size */
     switch (pibSize)
@@ -421,84 +836,111 @@ static void APP_Modem_MLME_GetConfirm(MLME_RESULT status, uint16_t pibAttrib,
             /* Extract value */
             temp16 = *((uint16_t *)pibValue);
             /* Copy value into buffer with MSB in MSB */
-            appSerialBuf[serialLen++] = (uint8_t)(temp16 >> 8);
-            appSerialBuf[serialLen++] = (uint8_t)temp16;
+            serialBuf[serialLen++] = (uint8_t)(temp16 >> 8);
+            serialBuf[serialLen++] = (uint8_t)temp16;
             break;
 
         case 4:
             temp32 = *((uint32_t *)pibValue);
             /* Copy value into buffer with MSB in MSB */
-            appSerialBuf[serialLen++] = (uint8_t)(temp32 >> 24);
-            appSerialBuf[serialLen++] = (uint8_t)(temp32 >> 16);
-            appSerialBuf[serialLen++] = (uint8_t)(temp32 >> 8);
-            appSerialBuf[serialLen++] = (uint8_t)temp32;
+            serialBuf[serialLen++] = (uint8_t)(temp32 >> 24);
+            serialBuf[serialLen++] = (uint8_t)(temp32 >> 16);
+            serialBuf[serialLen++] = (uint8_t)(temp32 >> 8);
+            serialBuf[serialLen++] = (uint8_t)temp32;
             break;
 
         default:
             /* Copy value into buffer */
-            memcpy(&appSerialBuf[serialLen], (uint8_t *)pibValue, pibSize);
+            memcpy(&serialBuf[serialLen], (uint8_t *)pibValue, pibSize);
             /* Increase pointer */
             serialLen += pibSize;
     }
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_MLME_ListGetConfirm(MLME_RESULT status, uint16_t pibAttrib,
                                           uint8_t *pibBuff, uint16_t pibLen)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_LIST_GET_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = status;
-    appSerialBuf[serialLen++] = (uint8_t)(pibAttrib >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(pibAttrib);
-    appSerialBuf[serialLen++] = (uint8_t)(pibLen >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(pibLen);
-    memcpy(&appSerialBuf[serialLen], (uint8_t *)pibBuff, pibLen);
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
+
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_LIST_GET_CONFIRM_CMD;
+    serialBuf[serialLen++] = status;
+    serialBuf[serialLen++] = (uint8_t)(pibAttrib >> 8);
+    serialBuf[serialLen++] = (uint8_t)(pibAttrib);
+    serialBuf[serialLen++] = (uint8_t)(pibLen >> 8);
+    serialBuf[serialLen++] = (uint8_t)(pibLen);
+    memcpy(&serialBuf[serialLen], (uint8_t *)pibBuff, pibLen);
     serialLen += pibLen;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_MLME_SetConfirm(MLME_RESULT result)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_SET_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = result;
+    serialBuf[serialLen++] = APP_MODEM_CL_NULL_MLME_SET_CONFIRM_CMD;
+    serialBuf[serialLen++] = result;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_CL432_DlDataIndication(uint8_t dstLsap, uint8_t srcLsap,
         uint16_t dstAddress, uint16_t srcAddress, uint8_t *data,
         uint16_t lsduLen, uint8_t linkClass)
 {
+    uint8_t header[9];
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    header[0] = APP_MODEM_CL_432_DL_DATA_INDICATION_CMD;
+    header[1] = dstLsap;
+    header[2] = srcLsap;
+    header[3] = (uint8_t)(dstAddress >> 8);
+    header[4] = (uint8_t)(dstAddress);
+    header[5] = (uint8_t)(srcAddress >> 8);
+    header[6] = (uint8_t)(srcAddress);
+    header[7] = (uint8_t)(lsduLen >> 8);
+    header[8] = (uint8_t)(lsduLen);
+
+    if (APP_Modem_TxSendDirect(header, sizeof(header), data, lsduLen,
+                               &linkClass, 1U) == false)
+    {
+        /* Get a free TX serialization buffer */
+        serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_DATA);
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_432_DL_DATA_INDICATION_CMD;
-    appSerialBuf[serialLen++] = dstLsap;
-    appSerialBuf[serialLen++] = srcLsap;
-    appSerialBuf[serialLen++] = (uint8_t)(dstAddress >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(dstAddress);
-    appSerialBuf[serialLen++] = (uint8_t)(srcAddress >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(srcAddress);
-    appSerialBuf[serialLen++] = (uint8_t)(lsduLen >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(lsduLen);
-    memcpy(&appSerialBuf[serialLen], data, lsduLen);
-    serialLen += lsduLen;
-    appSerialBuf[serialLen++] = linkClass;
-
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+        if (serialBuf != NULL)
+        {
+            memcpy(&serialBuf[serialLen], header, sizeof(header));
+            serialLen += sizeof(header);
+            memcpy(&serialBuf[serialLen], data, lsduLen);
+            serialLen += lsduLen;
+            serialBuf[serialLen++] = linkClass;
+
+            /* Queue packet for transmission */
+            APP_Modem_TxBufferPut(serialBuf, serialLen);
+        }
+    }
 
     /* Rx data indication */
     sRxdataIndication = true;
@@ -508,106 +950,148 @@ static void APP_Modem_CL432_DlDataConfirm(uint8_t dstLsap, uint8_t srcLsap,
         uint16_t dstAddress, DL_432_TX_STATUS txStatus)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_432_DL_DATA_CONFIRM_CMD;
-    appSerialBuf[serialLen++] = dstLsap;
-    appSerialBuf[serialLen++] = srcLsap;
-    appSerialBuf[serialLen++] = (uint8_t)(dstAddress >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(dstAddress);
-    appSerialBuf[serialLen++] = (uint8_t)txStatus;
+    serialBuf[serialLen++] = APP_MODEM_CL_432_DL_DATA_CONFIRM_CMD;
+    serialBuf[serialLen++] = dstLsap;
+    serialBuf[serialLen++] = srcLsap;
+    serialBuf[serialLen++] = (uint8_t)(dstAddress >> 8);
+    serialBuf[serialLen++] = (uint8_t)(dstAddress);
+    serialBuf[serialLen++] = (uint8_t)txStatus;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_CL432_JoinIndication(uint8_t *deviceId,
         uint8_t deviceIdLen, uint16_t dstAddress, uint8_t *mac, uint8_t ae)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
     uint8_t temp;
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_432_DL_JOIN_INDICATION_CMD;
-    appSerialBuf[serialLen++] = deviceIdLen;
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_INDICATION);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
+
+    serialBuf[serialLen++] = APP_MODEM_CL_432_DL_JOIN_INDICATION_CMD;
+    serialBuf[serialLen++] = deviceIdLen;
     for (temp = 0; temp < deviceIdLen; temp++)
     {
-        appSerialBuf[serialLen++] = *deviceId++;
+        serialBuf[serialLen++] = *deviceId++;
     }
 
-    appSerialBuf[serialLen++] = (uint8_t)(dstAddress >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(dstAddress);
+    serialBuf[serialLen++] = (uint8_t)(dstAddress >> 8);
+    serialBuf[serialLen++] = (uint8_t)(dstAddress);
     for (temp = 0; temp < 8; temp++)
     {
-        appSerialBuf[serialLen++] = *mac++;
+        serialBuf[serialLen++] = *mac++;
     }
 
-    appSerialBuf[serialLen++] = ae;
+    serialBuf[serialLen++] = ae;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_CL432_LeaveIndication(uint16_t dstAddress)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_INDICATION);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_CL_432_DL_LEAVE_INDICATION_CMD;
-    appSerialBuf[serialLen++] = (uint8_t)(dstAddress >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(dstAddress);
+    serialBuf[serialLen++] = APP_MODEM_CL_432_DL_LEAVE_INDICATION_CMD;
+    serialBuf[serialLen++] = (uint8_t)(dstAddress >> 8);
+    serialBuf[serialLen++] = (uint8_t)(dstAddress);
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_FupAck(uint8_t cmd, BMNG_FUP_ACK ackCode,
         uint16_t extraInfo)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_FUP_ACK_CMD;
-    appSerialBuf[serialLen++] = cmd;
-    appSerialBuf[serialLen++] = ackCode;
-    appSerialBuf[serialLen++] = (uint8_t)(extraInfo >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(extraInfo);
+    serialBuf[serialLen++] = APP_MODEM_BMNG_FUP_ACK_CMD;
+    serialBuf[serialLen++] = cmd;
+    serialBuf[serialLen++] = ackCode;
+    serialBuf[serialLen++] = (uint8_t)(extraInfo >> 8);
+    serialBuf[serialLen++] = (uint8_t)(extraInfo);
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_FupStatusIndication(BMNG_FUP_NODE_STATE fupNodeState,
         uint16_t pages, uint8_t *eui48)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_INDICATION);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_FUP_STATUS_INDICATION_CMD;
-    appSerialBuf[serialLen++] = fupNodeState;
-    appSerialBuf[serialLen++] = (uint8_t)(pages >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(pages);
-    memcpy(&appSerialBuf[serialLen], eui48, 6);
+    serialBuf[serialLen++] = APP_MODEM_BMNG_FUP_STATUS_INDICATION_CMD;
+    serialBuf[serialLen++] = fupNodeState;
+    serialBuf[serialLen++] = (uint8_t)(pages >> 8);
+    serialBuf[serialLen++] = (uint8_t)(pages);
+    memcpy(&serialBuf[serialLen], eui48, 6);
     serialLen += 6;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_FupErrorIndication(BMNG_FUP_ERROR errorCode,
                                               uint8_t *eui48)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
 
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_FUP_STATUS_ERROR_INDICATION_CMD;
-    appSerialBuf[serialLen++] = errorCode;
-    memcpy(&appSerialBuf[serialLen], eui48, 6);
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_INDICATION);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
+
+    serialBuf[serialLen++] = APP_MODEM_BMNG_FUP_STATUS_ERROR_INDICATION_CMD;
+    serialBuf[serialLen++] = errorCode;
+    memcpy(&serialBuf[serialLen], eui48, 6);
     serialLen += 6;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_FupVersionIndication(uint8_t *eui48,
@@ -615,197 +1099,326 @@ static void APP_Modem_BMNG_FupVersionIndication(uint8_t *eui48,
 		uint8_t versionlLen, char *version)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_FUP_VERSION_INDICATION_CMD;
-    memcpy(&appSerialBuf[serialLen], eui48, 6);
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_INDICATION);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
+
+    serialBuf[serialLen++] = APP_MODEM_BMNG_FUP_VERSION_INDICATION_CMD;
+    memcpy(&serialBuf[serialLen], eui48, 6);
     serialLen += 6;
-    appSerialBuf[serialLen++] = vendorLen;
-    memcpy(&appSerialBuf[serialLen], vendor, vendorLen);
+    serialBuf[serialLen++] = vendorLen;
+    memcpy(&serialBuf[serialLen], vendor, vendorLen);
     serialLen += vendorLen;
-    appSerialBuf[serialLen++] = modelLen;
-    memcpy(&appSerialBuf[serialLen], model, modelLen);
+    serialBuf[serialLen++] = modelLen;
+    memcpy(&serialBuf[serialLen], model, modelLen);
     serialLen += modelLen;
-    appSerialBuf[serialLen++] = versionlLen;
-    memcpy(&appSerialBuf[serialLen], version, versionlLen);
+    serialBuf[serialLen++] = versionlLen;
+    memcpy(&serialBuf[serialLen], version, versionlLen);
     serialLen += versionlLen;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_FupKillIndication(uint8_t *eui48)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_INDICATION);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_FUP_KILL_INDICATION_CMD;
-    memcpy(&appSerialBuf[serialLen], eui48, 6);
+    serialBuf[serialLen++] = APP_MODEM_BMNG_FUP_KILL_INDICATION_CMD;
+    memcpy(&serialBuf[serialLen], eui48, 6);
     serialLen += 6;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_NetEventIndication(BMNG_NET_EVENT_INFO *netEvent)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_NETWORK_EVENT_CMD;
-    appSerialBuf[serialLen++] = netEvent->netEvent;
-    memcpy(&appSerialBuf[serialLen], netEvent->eui48, 6);
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_INDICATION);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
+
+    serialBuf[serialLen++] = APP_MODEM_BMNG_NETWORK_EVENT_CMD;
+    serialBuf[serialLen++] = netEvent->netEvent;
+    memcpy(&serialBuf[serialLen], netEvent->eui48, 6);
     serialLen += 6;
-    appSerialBuf[serialLen++] = netEvent->sid;
-    appSerialBuf[serialLen++] = (uint8_t)(netEvent->lnid >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(netEvent->lnid);
-    appSerialBuf[serialLen++] = netEvent->lsid;
-    appSerialBuf[serialLen++] = netEvent->alvRxCnt;
-    appSerialBuf[serialLen++] = netEvent->alvTxCnt;
-    appSerialBuf[serialLen++] = netEvent->alvTime;
-    appSerialBuf[serialLen++] = (uint8_t)(netEvent->pch >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(netEvent->pch);
-    appSerialBuf[serialLen++] = (uint8_t)(netEvent->pchLsid >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(netEvent->pchLsid);
-
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    serialBuf[serialLen++] = netEvent->sid;
+    serialBuf[serialLen++] = (uint8_t)(netEvent->lnid >> 8);
+    serialBuf[serialLen++] = (uint8_t)(netEvent->lnid);
+    serialBuf[serialLen++] = netEvent->lsid;
+    serialBuf[serialLen++] = netEvent->alvRxCnt;
+    serialBuf[serialLen++] = netEvent->alvTxCnt;
+    serialBuf[serialLen++] = netEvent->alvTime;
+    serialBuf[serialLen++] = (uint8_t)(netEvent->pch >> 8);
+    serialBuf[serialLen++] = (uint8_t)(netEvent->pch);
+    serialBuf[serialLen++] = (uint8_t)(netEvent->pchLsid >> 8);
+    serialBuf[serialLen++] = (uint8_t)(netEvent->pchLsid);
+
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_PprofAck(uint8_t cmd, BMNG_PPROF_ACK ackCode)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_PPROF_ACK_CMD;
-    appSerialBuf[serialLen++] = cmd;
-    appSerialBuf[serialLen++] = ackCode;
+    serialBuf[serialLen++] = APP_MODEM_BMNG_PPROF_ACK_CMD;
+    serialBuf[serialLen++] = cmd;
+    serialBuf[serialLen++] = ackCode;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_PprofGetResponse(uint8_t *eui48, uint16_t dataLen,
                                             uint8_t *data)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_PPROF_GET_RESPONSE_CMD;
-    memcpy(&appSerialBuf[serialLen], eui48, 6);
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
+
+    serialBuf[serialLen++] = APP_MODEM_BMNG_PPROF_GET_RESPONSE_CMD;
+    memcpy(&serialBuf[serialLen], eui48, 6);
     serialLen += 6;
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen);
-    memcpy(&appSerialBuf[serialLen], data, dataLen);
+    serialBuf[serialLen++] = (uint8_t)(dataLen >> 8);
+    serialBuf[serialLen++] = (uint8_t)(dataLen);
+    memcpy(&serialBuf[serialLen], data, dataLen);
     serialLen += dataLen;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_PprofGetEnhancedResponse(uint8_t *eui48,
             uint16_t dataLen, uint8_t *data)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_PPROF_GET_ENHANCED_RESPONSE_CMD;
-    memcpy(&appSerialBuf[serialLen], eui48, 6);
+    serialBuf[serialLen++] = APP_MODEM_BMNG_PPROF_GET_ENHANCED_RESPONSE_CMD;
+    memcpy(&serialBuf[serialLen], eui48, 6);
     serialLen += 6;
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(dataLen);
-    memcpy(&appSerialBuf[serialLen], data, dataLen);
+    serialBuf[serialLen++] = (uint8_t)(dataLen >> 8);
+    serialBuf[serialLen++] = (uint8_t)(dataLen);
+    memcpy(&serialBuf[serialLen], data, dataLen);
     serialLen += dataLen;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_PprofGetZCResponse(uint8_t *eui48, uint8_t zcStatus,
                                               uint32_t zcTime)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_PPROF_GET_ZC_RESPONSE_CMD;
-    memcpy(&appSerialBuf[serialLen], eui48, 6);
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
+
+    serialBuf[serialLen++] = APP_MODEM_BMNG_PPROF_GET_ZC_RESPONSE_CMD;
+    memcpy(&serialBuf[serialLen], eui48, 6);
     serialLen += 6;
-    appSerialBuf[serialLen++] = zcStatus;
-    appSerialBuf[serialLen++] = (uint8_t)(zcTime >> 24);
-    appSerialBuf[serialLen++] = (uint8_t)(zcTime >> 16);
-    appSerialBuf[serialLen++] = (uint8_t)(zcTime >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(zcTime);
+    serialBuf[serialLen++] = zcStatus;
+    serialBuf[serialLen++] = (uint8_t)(zcTime >> 24);
+    serialBuf[serialLen++] = (uint8_t)(zcTime >> 16);
+    serialBuf[serialLen++] = (uint8_t)(zcTime >> 8);
+    serialBuf[serialLen++] = (uint8_t)(zcTime);
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-            serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_PprofDiffZCResponse(uint8_t *eui48,
             uint32_t timeFreq, uint32_t timeDiff)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_PPROF_ZC_DIFF_RESPONSE_CMD;
-    memcpy(&appSerialBuf[serialLen], eui48, 6);
+    serialBuf[serialLen++] = APP_MODEM_BMNG_PPROF_ZC_DIFF_RESPONSE_CMD;
+    memcpy(&serialBuf[serialLen], eui48, 6);
     serialLen += 6;
-    appSerialBuf[serialLen++] = (uint8_t)(timeFreq >> 24);
-    appSerialBuf[serialLen++] = (uint8_t)(timeFreq >> 16);
-    appSerialBuf[serialLen++] = (uint8_t)(timeFreq >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(timeFreq);
-    appSerialBuf[serialLen++] = (uint8_t)(timeDiff >> 24);
-    appSerialBuf[serialLen++] = (uint8_t)(timeDiff >> 16);
-    appSerialBuf[serialLen++] = (uint8_t)(timeDiff >> 8);
-    appSerialBuf[serialLen++] = (uint8_t)(timeDiff);
+    serialBuf[serialLen++] = (uint8_t)(timeFreq >> 24);
+    serialBuf[serialLen++] = (uint8_t)(timeFreq >> 16);
+    serialBuf[serialLen++] = (uint8_t)(timeFreq >> 8);
+    serialBuf[serialLen++] = (uint8_t)(timeFreq);
+    serialBuf[serialLen++] = (uint8_t)(timeDiff >> 24);
+    serialBuf[serialLen++] = (uint8_t)(timeDiff >> 16);
+    serialBuf[serialLen++] = (uint8_t)(timeDiff >> 8);
+    serialBuf[serialLen++] = (uint8_t)(timeDiff);
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
 static void APP_Modem_BMNG_WhitelistAck(uint8_t cmd, BMNG_WHITELIST_ACK ackCode)
 {
     uint16_t serialLen = 0U;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
+    {
+        return;
+    }
 
-    appSerialBuf[serialLen++] = APP_MODEM_BMNG_WHITELIST_ACK_CMD;
-    appSerialBuf[serialLen++] = cmd;
-    appSerialBuf[serialLen++] = ackCode;
+    serialBuf[serialLen++] = APP_MODEM_BMNG_WHITELIST_ACK_CMD;
+    serialBuf[serialLen++] = cmd;
+    serialBuf[serialLen++] = ackCode;
 
-    /* Send packet */
-    SRV_USI_Send_Message(gUsiHandle, SRV_USI_PROT_ID_PRIME_API, appSerialBuf,
-                         serialLen);
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
 }
 
-static void APP_Modem_USI_PRIME_ApiHandler(uint8_t *rxMsg, size_t inputLen)
+static void APP_Modem_StatsResponse(void)
 {
-    if (!sAppModemMsgRecv[inputMsgRecvIndex].len)
+    uint16_t serialLen = 0;
+    uint8_t *serialBuf;
+
+    /* Get a free TX serialization buffer */
+    serialBuf = APP_Modem_TxBufferGet(APP_MODEM_TX_RESPONSE);
+    if (serialBuf == NULL)
     {
-        if (inputLen < MAX_LENGTH_BUFF)
-        {
-            memcpy(sAppModemMsgRecv[inputMsgRecvIndex].dataBuf, rxMsg, inputLen);
-            sAppModemMsgRecv[inputMsgRecvIndex].len = inputLen;
+        return;
+    }
 
-            if (++inputMsgRecvIndex == MAX_NUM_MSG_RCV)
-            {
-                inputMsgRecvIndex = 0;
-            }
+    /* Reception queue statistics */
+    serialBuf[serialLen++] = APP_MODEM_STATS_RESPONSE_CMD;
+    serialBuf[serialLen++] = MAX_NUM_MSG_RCV;
+    serialBuf[serialLen++] = sAppModemRxQueueStats.highWater;
+    serialBuf[serialLen++] = (uint8_t)(sAppModemRxQueueStats.dropFull >> 24);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemRxQueueStats.dropFull >> 16);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemRxQueueStats.dropFull >> 8);
+    serialBuf[serialLen++] = (uint8_t)sAppModemRxQueueStats.dropFull;
+    serialBuf[serialLen++] = (uint8_t)(sAppModemRxQueueStats.dropTooBig >> 24);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemRxQueueStats.dropTooBig >> 16);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemRxQueueStats.dropTooBig >> 8);
+    serialBuf[serialLen++] = (uint8_t)sAppModemRxQueueStats.dropTooBig;
+
+    /* Transmission pool statistics */
+    serialBuf[serialLen++] = MAX_NUM_MSG_SEND;
+    serialBuf[serialLen++] = sAppModemTxPoolStats.peakInUse;
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.exhausted >> 24);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.exhausted >> 16);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.exhausted >> 8);
+    serialBuf[serialLen++] = (uint8_t)sAppModemTxPoolStats.exhausted;
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.dropFull >> 24);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.dropFull >> 16);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.dropFull >> 8);
+    serialBuf[serialLen++] = (uint8_t)sAppModemTxPoolStats.dropFull;
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.waitFull >> 24);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.waitFull >> 16);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.waitFull >> 8);
+    serialBuf[serialLen++] = (uint8_t)sAppModemTxPoolStats.waitFull;
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.waitMaxUs >> 24);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.waitMaxUs >> 16);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.waitMaxUs >> 8);
+    serialBuf[serialLen++] = (uint8_t)sAppModemTxPoolStats.waitMaxUs;
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.dropLinkDown >> 24);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.dropLinkDown >> 16);
+    serialBuf[serialLen++] = (uint8_t)(sAppModemTxPoolStats.dropLinkDown >> 8);
+    serialBuf[serialLen++] = (uint8_t)sAppModemTxPoolStats.dropLinkDown;
+
+    /* Queue packet for transmission */
+    APP_Modem_TxBufferPut(serialBuf, serialLen);
+}
 
-            return;
-        }
-        else
-        {
-            /* ERROR ,Message too big */
-            SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_WARNING,
-                    APP_MODEM_ERR_MSG_TOO_BIG, "ERROR: Message too big\r\n");
-        }
+static void APP_Modem_USI_PRIME_ApiHandler(uint8_t *rxMsg, size_t inputLen)
+{
+    uint32_t inputCount;
+    uint32_t numMsgQueued;
+    APP_MODEM_MSG_RCV *msgRecv;
+
+    if (inputLen == 0U)
+    {
+        /* Nothing to queue */
+        return;
     }
-    else
+
+    inputCount = inputMsgRecvCount;
+    numMsgQueued = inputCount - outputMsgRecvCount;
+
+    if (numMsgQueued >= MAX_NUM_MSG_RCV)
     {
         /* Error, RX queue is full */
+        sAppModemRxQueueStats.dropFull++;
         SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_WARNING,
                        APP_MODEM_ERR_QUEUE_FULL, "ERROR: RX queue full\r\n");
+        return;
+    }
+
+    if (inputLen >= MAX_LENGTH_BUFF)
+    {
+        /* ERROR ,Message too big */
+        sAppModemRxQueueStats.dropTooBig++;
+        SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_WARNING,
+                APP_MODEM_ERR_MSG_TOO_BIG, "ERROR: Message too big\r\n");
+        return;
     }
 
-    return;
+    /* Fill the slot before publishing it to the consumer */
+    msgRecv = &sAppModemMsgRecv[inputCount & (MAX_NUM_MSG_RCV - 1U)];
+    memcpy(msgRecv->dataBuf, rxMsg, inputLen);
+    msgRecv->len = (uint16_t)inputLen;
+    inputMsgRecvCount = inputCount + 1U;
+
+    numMsgQueued++;
+    if (numMsgQueued > sAppModemRxQueueStats.highWater)
+    {
+        sAppModemRxQueueStats.highWater = (uint8_t)numMsgQueued;
+    }
 }
 
 static void APP_Modem_SetCallbacks(void)
@@ -1620,10 +2233,18 @@ static void APP_Modem_BMNG_WhitelistRemoveRequestCmd(uint8_t *recvMsg)
 void APP_Modem_Initialize(void)
 {
     /* Initialize the reception queue */
-    inputMsgRecvIndex = 0;
-    outputMsgRecvIndex = 0;
+    inputMsgRecvCount = 0;
+    outputMsgRecvCount = 0;
 
     (void) memset(sAppModemMsgRecv, 0, sizeof(sAppModemMsgRecv));
+    (void) memset(&sAppModemRxQueueStats, 0, sizeof(sAppModemRxQueueStats));
+
+    /* Initialize the transmission pool */
+    sAppModemMsgSendFifoFirst = 0;
+    sAppModemMsgSendFifoNum = 0;
+
+    (void) memset(sAppModemMsgSend, 0, sizeof(sAppModemMsgSend));
+    (void) memset(&sAppModemTxPoolStats, 0, sizeof(sAppModemTxPoolStats));
 
     /* Initialize TxRx data indicators */
     sRxdataIndication = false;
@@ -1660,14 +2281,22 @@ void APP_Modem_Tasks(void)
             break;
 
         case APP_MODEM_STATE_TASKS:
-            /* Check data reception */
-            while(sAppModemMsgRecv[outputMsgRecvIndex].len)
+        {
+            uint8_t numMsgProcessed = 0;
+
+            /* Send messages queued by stack callbacks */
+            APP_Modem_TxBufferFlush();
+
+            /* Check data reception, limiting the work done per call */
+            while ((outputMsgRecvCount != inputMsgRecvCount) &&
+                   (numMsgProcessed < MAX_NUM_MSG_PROCESS))
             {
                 APP_MODEM_PRIME_API_CMD apiCmd;
                 uint8_t *recvBuf;
 
                 /* Extract command */
-                recvBuf = sAppModemMsgRecv[outputMsgRecvIndex].dataBuf;
+                recvBuf = sAppModemMsgRecv[outputMsgRecvCount &
+                                           (MAX_NUM_MSG_RCV - 1U)].dataBuf;
                 apiCmd = (APP_MODEM_PRIME_API_CMD)*recvBuf++;
                 switch (apiCmd)
                 {
@@ -1849,20 +2478,26 @@ void APP_Modem_Tasks(void)
                         APP_Modem_BMNG_WhitelistRemoveRequestCmd(recvBuf);
                         break;
 
+                    case APP_MODEM_STATS_REQUEST_CMD:
+                        APP_Modem_StatsResponse();
+                        break;
+
                     default:
                         SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_INFO,
                             APP_MODEM_ERR_UNKNOWN_CMD, "ERROR: unknown command\r\n" );
                         break;
                 }
 
-                sAppModemMsgRecv[outputMsgRecvIndex].len = 0;
-                if (++outputMsgRecvIndex == MAX_NUM_MSG_RCV)
-                {
-                    outputMsgRecvIndex = 0;
-                }
+                /* Release the slot to the producer */
+                outputMsgRecvCount++;
+                numMsgProcessed++;
             }
 
+            /* Send messages queued while processing commands */
+            APP_Modem_TxBufferFlush();
+
             break;
+        }
 
         default:
             break;
@@ -0,0 +1,812 @@
+/*******************************************************************************
+  PRIME Services Host Benchmark
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    host_bench.c
+
+  Summary:
+    Host benchmark of the PRIME services.
+
+  Description:
+    Time per byte of the CRC and USI data paths, time per frame of the USI
+    protocol dispatch and time per operation of the queue, storage and time
+    management services, on the PLIB models.
+    Host numbers: they compare versions of the services, they are not the
+    times in the device.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "definitions.h"
+#include "host_mock.h"
+#include "service/firmware_upgrade/srv_firmware_upgrade.h"
+#include "service/log_report/srv_log_report.h"
+#include "service/pcrc/srv_pcrc.h"
+#include "service/queue/srv_queue.h"
+#include "service/storage/srv_storage.h"
+#include "service/time_management/srv_time_management.h"
+#include "service/usi/srv_usi.h"
+#include "service/usi/srv_usi_local.h"
+#include "service/usi/srv_usi_usart.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Minimum time of each measurement */
+#define BENCH_MIN_TIME_NS        200000000ULL
+
+#define BENCH_CRC_SIZE           1024U
+#define BENCH_CRC_LENGTHS        4U
+#define BENCH_USI_PAYLOAD_SIZE   256U
+#define BENCH_USI_RX_CHUNK       64U
+#define BENCH_USI_HEADER_SIZE    5U
+#define BENCH_USI_TRAILER_SIZE   4U
+/* Short frames of every protocol, in random order, for the dispatch */
+#define BENCH_USI_DISPATCH_PROTOCOLS 11U
+#define BENCH_USI_DISPATCH_FRAMES    64U
+#define BENCH_USI_DISPATCH_PAYLOAD   4U
+#define BENCH_QUEUE_ELEMENTS     512U
+#define BENCH_QUEUE_DEPTHS       4U
+#define BENCH_LOG_BUFFER_SIZE    48U
+
+/* Upgrade of an image of 64 kB in pages of 192 bytes */
+#define BENCH_FU_IMAGE_SIZE      65536U
+#define BENCH_FU_PAGE_SIZE       192U
+#define BENCH_FU_LOOP_US         50U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static const SYS_TIME_PLIB_INTERFACE benchTimePlibAPI = {
+    .timerCallbackSet = (SYS_TIME_PLIB_CALLBACK_REGISTER)TC0_CH0_TimerCallbackRegister,
+    .timerStart = (SYS_TIME_PLIB_START)TC0_CH0_TimerStart,
+    .timerStop = (SYS_TIME_PLIB_STOP)TC0_CH0_TimerStop ,
+    .timerFrequencyGet = (SYS_TIME_PLIB_FREQUENCY_GET)TC0_CH0_TimerFrequencyGet,
+    .timerPeriodSet = (SYS_TIME_PLIB_PERIOD_SET)TC0_CH0_TimerPeriodSet,
+    .timerCompareSet = (SYS_TIME_PLIB_COMPARE_SET)TC0_CH0_TimerCompareSet,
+    .timerCounterGet = (SYS_TIME_PLIB_COUNTER_GET)TC0_CH0_TimerCounterGet,
+};
+
+static const SYS_TIME_INIT benchTimeInitData =
+{
+    .timePlib = &benchTimePlibAPI,
+    .hwTimerIntNum = TC0_CH0_IRQn,
+};
+
+/* Same USI initialization as the application (initialization.c) */
+static uint8_t benchUsiReadBuffer[SRV_USI0_RD_BUF_SIZE];
+static uint8_t benchUsiWriteBuffer[SRV_USI0_WR_BUF_SIZE];
+static uint8_t benchUsiUsartReadBuffer[128];
+
+static const SRV_USI_USART_INTERFACE benchUsiPlib = {
+    .readCallbackRegister = (USI_USART_PLIB_READ_CALLBACK_REG)FLEXCOM7_USART_ReadCallbackRegister,
+    .readData = (USI_USART_PLIB_WRRD)FLEXCOM7_USART_Read,
+    .writeData = (USI_USART_PLIB_WRRD)FLEXCOM7_USART_Write,
+    .writeCountGet = FLEXCOM7_USART_WriteCountGet,
+    .writeFreeBufferCountGet = FLEXCOM7_USART_WriteFreeBufferCountGet,
+    .intSource = FLEXCOM7_IRQn,
+};
+
+static const USI_USART_INIT_DATA benchUsiInitData = {
+    .plib = (void*)&benchUsiPlib,
+    .pRdBuffer = (void*)benchUsiReadBuffer,
+    .rdBufferSize = SRV_USI0_RD_BUF_SIZE,
+    .usartReadBuffer = (void *)benchUsiUsartReadBuffer,
+    .usartBufferSize = 128
+};
+
+static const SRV_USI_INIT benchUsiInit =
+{
+    .deviceInitData = (const void * const)&benchUsiInitData,
+    .consDevDesc = &srvUSIUSARTDevDesc,
+    .deviceIndex = 0,
+    .pWrBuffer = benchUsiWriteBuffer,
+    .wrBufferSize = SRV_USI0_WR_BUF_SIZE
+};
+
+static SRV_USI_HANDLE benchUsiHandle;
+static uint8_t benchCrcData[BENCH_CRC_SIZE];
+static size_t benchCrcLength;
+
+/* Lengths of the CRC measurements: short USI frames up to long PLC frames
+   and USI transfers */
+static const size_t benchCrcLengths[BENCH_CRC_LENGTHS] = {16U, 64U, 512U, BENCH_CRC_SIZE};
+
+static uint8_t benchUsiPayload[BENCH_USI_PAYLOAD_SIZE];
+static uint8_t benchUsiFrame[2U * (SRV_USI0_WR_BUF_SIZE + 8U)];
+static size_t benchUsiFrameLength;
+static uint8_t benchUsiHeader[BENCH_USI_HEADER_SIZE];
+static uint8_t benchUsiTrailer[BENCH_USI_TRAILER_SIZE];
+static uint8_t benchUsiMessage[BENCH_USI_HEADER_SIZE + BENCH_USI_PAYLOAD_SIZE + BENCH_USI_TRAILER_SIZE];
+static uint32_t benchUsiRxCount;
+
+/* One protocol of each callback */
+static const SRV_USI_PROTOCOL_ID benchUsiProtocols[BENCH_USI_DISPATCH_PROTOCOLS] = {
+    SRV_USI_PROT_ID_MNGP_PRIME_GETQRY, SRV_USI_PROT_ID_SNIF_PRIME, SRV_USI_PROT_ID_PHY_SERIAL_PRIME,
+    SRV_USI_PROT_ID_PHY, SRV_USI_PROT_ID_SNIFF_G3, SRV_USI_PROT_ID_MAC_G3, SRV_USI_PROT_ID_ADP_G3,
+    SRV_USI_PROT_ID_COORD_G3, SRV_USI_PROT_ID_PHY_MICROPLC, SRV_USI_PROT_ID_PRIME_API,
+    SRV_USI_PROT_ID_PHY_RF215
+};
+
+static SRV_USI_PROTOCOL_ID benchUsiDispatch[BENCH_USI_DISPATCH_FRAMES];
+
+/* Same entries as the protocol descriptor table of the service */
+#define BENCH_USI_DESC_MNGP     {USI_MAX_LENGTH, 0U, USI_PROT_FLAG_VALID | USI_PROT_FLAG_HEADER, PCRC_CRC32}
+
+static const SRV_USI_PROTOCOL_DESC benchUsiProtocolDesc[USI_PROTOCOL_NUMBER] = {
+    [SRV_USI_PROT_ID_MNGP_PRIME_GETQRY]    = BENCH_USI_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_GETRSP]    = BENCH_USI_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_SET]       = BENCH_USI_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_RESET]     = BENCH_USI_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_REBOOT]    = BENCH_USI_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_FU]        = BENCH_USI_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_GETQRY_EN] = BENCH_USI_DESC_MNGP,
+    [SRV_USI_PROT_ID_MNGP_PRIME_GETRSP_EN] = BENCH_USI_DESC_MNGP,
+    [SRV_USI_PROT_ID_SNIF_PRIME]           = {USI_MAX_LENGTH, 1U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+    [SRV_USI_PROT_ID_PHY_SERIAL_PRIME]     = {USI_MAX_LENGTH, 2U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+    [SRV_USI_PROT_ID_PHY]                  = {USI_MAX_LENGTH, 3U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+    [SRV_USI_PROT_ID_SNIFF_G3]             = {USI_MAX_LENGTH, 4U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+    [SRV_USI_PROT_ID_MAC_G3]               = {USI_MAX_LENGTH, 5U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+    [SRV_USI_PROT_ID_ADP_G3]               = {USI_MAX_XLENGTH, 6U, USI_PROT_FLAG_VALID | USI_PROT_FLAG_XLEN, PCRC_CRC16},
+    [SRV_USI_PROT_ID_COORD_G3]             = {USI_MAX_XLENGTH, 7U, USI_PROT_FLAG_VALID | USI_PROT_FLAG_XLEN, PCRC_CRC16},
+    [SRV_USI_PROT_ID_PHY_MICROPLC]         = {USI_MAX_LENGTH, 8U, USI_PROT_FLAG_VALID, PCRC_CRC8},
+    [SRV_USI_PROT_ID_PRIME_API]            = {USI_MAX_XLENGTH, 9U, USI_PROT_FLAG_VALID | USI_PROT_FLAG_XLEN, PCRC_CRC8},
+    [SRV_USI_PROT_ID_PHY_RF215]            = {USI_MAX_LENGTH, 10U, USI_PROT_FLAG_VALID, PCRC_CRC16},
+};
+
+static SRV_QUEUE benchQueue;
+static SRV_QUEUE_ELEMENT benchElements[BENCH_QUEUE_ELEMENTS];
+static uint32_t benchQueueDepth;
+static uint32_t benchIndex;
+
+/* Depths of the queue measurements: MAC buffers up to node lists */
+static const uint32_t benchQueueDepths[BENCH_QUEUE_DEPTHS] = {8U, 32U, 128U, BENCH_QUEUE_ELEMENTS};
+
+static uint8_t benchLogBuffer[BENCH_LOG_BUFFER_SIZE];
+
+static uint8_t benchFuImage[BENCH_FU_IMAGE_SIZE];
+static bool benchFuDone;
+
+static volatile uint32_t benchSink;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Measured operations
+// *****************************************************************************
+// *****************************************************************************
+
+static void lBENCH_Crc8(void)
+{
+    benchSink += SRV_PCRC_GetValue(benchCrcData, benchCrcLength, PCRC_HT_GENERIC, PCRC_CRC8, 0);
+}
+
+static void lBENCH_Crc16(void)
+{
+    benchSink += SRV_PCRC_GetValue(benchCrcData, benchCrcLength, PCRC_HT_GENERIC, PCRC_CRC16, 0);
+}
+
+static void lBENCH_Crc32(void)
+{
+    benchSink += SRV_PCRC_GetValue(benchCrcData, benchCrcLength, PCRC_HT_GENERIC, PCRC_CRC32, 0);
+}
+
+static void lBENCH_UsiSend(void)
+{
+    /* Frame encoded in the write buffer and taken from the line */
+    (void) SRV_USI_Send_Message(benchUsiHandle, SRV_USI_PROT_ID_PHY, benchUsiPayload, BENCH_USI_PAYLOAD_SIZE);
+    benchSink += (uint32_t)HOST_FLEXCOM7_Transmit(benchUsiFrame, sizeof(benchUsiFrame));
+}
+
+static void lBENCH_UsiSendCopy(void)
+{
+    size_t length = 0;
+
+    /* Modem indication copied into a serialization buffer first */
+    (void) memcpy(&benchUsiMessage[length], benchUsiHeader, BENCH_USI_HEADER_SIZE);
+    length += BENCH_USI_HEADER_SIZE;
+    (void) memcpy(&benchUsiMessage[length], benchUsiPayload, BENCH_USI_PAYLOAD_SIZE);
+    length += BENCH_USI_PAYLOAD_SIZE;
+    (void) memcpy(&benchUsiMessage[length], benchUsiTrailer, BENCH_USI_TRAILER_SIZE);
+    length += BENCH_USI_TRAILER_SIZE;
+
+    (void) SRV_USI_Send_Message(benchUsiHandle, SRV_USI_PROT_ID_PRIME_API, benchUsiMessage, length);
+    benchSink += (uint32_t)HOST_FLEXCOM7_Transmit(benchUsiFrame, sizeof(benchUsiFrame));
+}
+
+static void lBENCH_UsiSendSegments(void)
+{
+    SRV_USI_MSG_SEGMENT segments[3];
+
+    /* Modem indication encoded from the stack buffer */
+    segments[0].pData = benchUsiHeader;
+    segments[0].length = BENCH_USI_HEADER_SIZE;
+    segments[1].pData = benchUsiPayload;
+    segments[1].length = BENCH_USI_PAYLOAD_SIZE;
+    segments[2].pData = benchUsiTrailer;
+    segments[2].length = BENCH_USI_TRAILER_SIZE;
+
+    (void) SRV_USI_Send_Message_Segments(benchUsiHandle, SRV_USI_PROT_ID_PRIME_API, segments, 3);
+    benchSink += (uint32_t)HOST_FLEXCOM7_Transmit(benchUsiFrame, sizeof(benchUsiFrame));
+}
+
+static void lBENCH_UsiCallback(uint8_t *pData, size_t length)
+{
+    benchUsiRxCount++;
+}
+
+static void lBENCH_UsiReceive(void)
+{
+    size_t offset, chunk;
+
+    /* Line data decoded from the receive ring by the service task */
+    for (offset = 0; offset < benchUsiFrameLength; offset += chunk)
+    {
+        chunk = benchUsiFrameLength - offset;
+        if (chunk > BENCH_USI_RX_CHUNK)
+        {
+            chunk = BENCH_USI_RX_CHUNK;
+        }
+
+        (void) HOST_FLEXCOM7_Receive(&benchUsiFrame[offset], chunk);
+        SRV_USI_Tasks(SRV_USI_INDEX_0);
+    }
+}
+
+/* Protocol lookups of the service before the descriptor table */
+static SRV_USI_CALLBACK_INDEX lBENCH_SwitchCallbackIndex(SRV_USI_PROTOCOL_ID protocol)
+{
+    SRV_USI_CALLBACK_INDEX callbackIndex;
+
+    switch(protocol)
+    {
+        case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY:
+        case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP:
+        case SRV_USI_PROT_ID_MNGP_PRIME_SET:
+        case SRV_USI_PROT_ID_MNGP_PRIME_RESET:
+        case SRV_USI_PROT_ID_MNGP_PRIME_REBOOT:
+        case SRV_USI_PROT_ID_MNGP_PRIME_FU:
+        case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY_EN:
+        case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP_EN:
+            callbackIndex = 0;
+            break;
+
+        case SRV_USI_PROT_ID_SNIF_PRIME:
+            callbackIndex = 1;
+            break;
+
+        case SRV_USI_PROT_ID_PHY_SERIAL_PRIME:
+            callbackIndex = 2;
+            break;
+
+        case SRV_USI_PROT_ID_PHY:
+            callbackIndex = 3;
+            break;
+
+        case SRV_USI_PROT_ID_SNIFF_G3:
+            callbackIndex = 4;
+            break;
+
+        case SRV_USI_PROT_ID_MAC_G3:
+            callbackIndex = 5;
+            break;
+
+        case SRV_USI_PROT_ID_ADP_G3:
+            callbackIndex = 6;
+            break;
+
+        case SRV_USI_PROT_ID_COORD_G3:
+            callbackIndex = 7;
+            break;
+
+        case SRV_USI_PROT_ID_PHY_MICROPLC:
+            callbackIndex = 8;
+            break;
+
+        case SRV_USI_PROT_ID_PRIME_API:
+            callbackIndex = 9;
+            break;
+
+        case SRV_USI_PROT_ID_PHY_RF215:
+            callbackIndex = 10;
+            break;
+
+        case SRV_USI_PROT_ID_INVALID:
+        default:
+            callbackIndex = SRV_USI_CALLBACK_INDEX_INVALID;
+            break;
+    }
+
+    return callbackIndex;
+}
+
+static PCRC_CRC_TYPE lBENCH_SwitchCrcType(SRV_USI_PROTOCOL_ID protocol)
+{
+    PCRC_CRC_TYPE crcType;
+
+    switch(protocol)
+    {
+        case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY:
+        case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP:
+        case SRV_USI_PROT_ID_MNGP_PRIME_SET:
+        case SRV_USI_PROT_ID_MNGP_PRIME_RESET:
+        case SRV_USI_PROT_ID_MNGP_PRIME_REBOOT:
+        case SRV_USI_PROT_ID_MNGP_PRIME_FU:
+        case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY_EN:
+        case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP_EN:
+            crcType = PCRC_CRC32;
+            break;
+
+        case SRV_USI_PROT_ID_SNIF_PRIME:
+        case SRV_USI_PROT_ID_PHY_SERIAL_PRIME:
+        case SRV_USI_PROT_ID_PHY:
+        case SRV_USI_PROT_ID_PHY_RF215:
+        case SRV_USI_PROT_ID_SNIFF_G3:
+        case SRV_USI_PROT_ID_MAC_G3:
+        case SRV_USI_PROT_ID_ADP_G3:
+        case SRV_USI_PROT_ID_COORD_G3:
+            crcType = PCRC_CRC16;
+            break;
+
+        case SRV_USI_PROT_ID_PRIME_API:
+        case SRV_USI_PROT_ID_PHY_MICROPLC:
+        case SRV_USI_PROT_ID_INVALID:
+        default:
+            crcType = PCRC_CRC8;
+            break;
+    }
+
+    return crcType;
+}
+
+static void lBENCH_DispatchSwitch(void)
+{
+    SRV_USI_PROTOCOL_ID protocol;
+    SRV_USI_CALLBACK_INDEX cbIndex;
+    uint32_t frame, sum = 0;
+
+    /* Per received frame: callback, CRC, extended length and header */
+    for (frame = 0; frame < BENCH_USI_DISPATCH_FRAMES; frame++)
+    {
+        protocol = benchUsiDispatch[frame];
+        cbIndex = lBENCH_SwitchCallbackIndex(protocol);
+        if (cbIndex == SRV_USI_CALLBACK_INDEX_INVALID)
+        {
+            continue;
+        }
+
+        sum += (uint32_t)cbIndex + (uint32_t)lBENCH_SwitchCrcType(protocol);
+        if ((protocol == SRV_USI_PROT_ID_ADP_G3) ||
+            (protocol == SRV_USI_PROT_ID_COORD_G3) ||
+            (protocol == SRV_USI_PROT_ID_PRIME_API))
+        {
+            sum += 16U;
+        }
+
+        switch(protocol)
+        {
+            case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY:
+            case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP:
+            case SRV_USI_PROT_ID_MNGP_PRIME_SET:
+            case SRV_USI_PROT_ID_MNGP_PRIME_RESET:
+            case SRV_USI_PROT_ID_MNGP_PRIME_REBOOT:
+            case SRV_USI_PROT_ID_MNGP_PRIME_FU:
+            case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY_EN:
+            case SRV_USI_PROT_ID_MNGP_PRIME_GETRSP_EN:
+                sum += 32U;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    benchSink += sum;
+}
+
+static void lBENCH_DispatchTable(void)
+{
+    const SRV_USI_PROTOCOL_DESC *protDesc;
+    uint32_t frame, sum = 0;
+
+    /* Same decisions from the descriptor of the protocol */
+    for (frame = 0; frame < BENCH_USI_DISPATCH_FRAMES; frame++)
+    {
+        if ((uint32_t)benchUsiDispatch[frame] >= USI_PROTOCOL_NUMBER)
+        {
+            continue;
+        }
+
+        protDesc = &benchUsiProtocolDesc[benchUsiDispatch[frame]];
+        if ((protDesc->flags & USI_PROT_FLAG_VALID) == 0U)
+        {
+            continue;
+        }
+
+        sum += (uint32_t)protDesc->cbIndex + (uint32_t)protDesc->crcType;
+        if ((protDesc->flags & USI_PROT_FLAG_XLEN) != 0U)
+        {
+            sum += 16U;
+        }
+
+        if ((protDesc->flags & USI_PROT_FLAG_HEADER) != 0U)
+        {
+            sum += 32U;
+        }
+    }
+
+    benchSink += sum;
+}
+
+static void lBENCH_QueuePriority(void)
+{
+    SRV_QUEUE_ELEMENT *element;
+
+    /* Queue kept full: each append finds its place among the others */
+    element = SRV_QUEUE_Read_Or_Remove(&benchQueue, SRV_QUEUE_MODE_REMOVE, SRV_QUEUE_POSITION_HEAD);
+    benchIndex = (benchIndex * 1103515245U) + 12345U;
+    SRV_QUEUE_Append_With_Priority(&benchQueue, (benchIndex >> 16) % SRV_QUEUE_PRIORITY_LEVELS, element);
+}
+
+static void lBENCH_QueueUnlink(void)
+{
+    SRV_QUEUE_ELEMENT *element;
+
+    /* Queue kept full: any element removed, as a timed out MAC buffer */
+    benchIndex = (benchIndex * 1103515245U) + 12345U;
+    element = &benchElements[(benchIndex >> 16) % benchQueueDepth];
+    SRV_QUEUE_Remove_Element(&benchQueue, element);
+    SRV_QUEUE_Append_With_Priority(&benchQueue, (benchIndex >> 8) % SRV_QUEUE_PRIORITY_LEVELS, element);
+}
+
+static void lBENCH_QueueSingle(void)
+{
+    SRV_QUEUE_ELEMENT *element;
+
+    element = SRV_QUEUE_Read_Or_Remove(&benchQueue, SRV_QUEUE_MODE_REMOVE, SRV_QUEUE_POSITION_HEAD);
+    SRV_QUEUE_Append(&benchQueue, element);
+}
+
+static void lBENCH_StorageSet(void)
+{
+    SRV_STORAGE_MAC_CONFIG config;
+
+    (void) memset(&config, (int)benchIndex++, sizeof(config));
+    (void) SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE_MAC_INFO, (uint8_t)sizeof(config), &config);
+}
+
+static void lBENCH_StorageGet(void)
+{
+    SRV_STORAGE_MAC_CONFIG config;
+
+    (void) SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE_MAC_INFO, (uint8_t)sizeof(config), &config);
+    benchSink += config.cfgKey;
+}
+
+static void lBENCH_TimeGet(void)
+{
+    benchSink += (uint32_t)SRV_TIME_MANAGEMENT_GetTimeUS64();
+}
+
+static void lBENCH_LogMessage(void)
+{
+    HOST_DEBUG_Clear();
+    SRV_LOG_REPORT_Message(SRV_LOG_REPORT_INFO, "Node %u: %s\r\n", benchIndex++, "registered");
+}
+
+static void lBENCH_LogBuffer(void)
+{
+    HOST_DEBUG_Clear();
+    SRV_LOG_REPORT_Buffer(SRV_LOG_REPORT_INFO, benchLogBuffer, BENCH_LOG_BUFFER_SIZE, "Frame: ");
+}
+
+static void lBENCH_FuMemCallback(SRV_FU_MEM_TRANSFER_CMD command, SRV_FU_MEM_TRANSFER_RESULT result)
+{
+    benchFuDone = true;
+}
+
+static void lBENCH_FuCrcCallback(uint32_t crc)
+{
+    benchSink += crc;
+    benchFuDone = true;
+}
+
+static void lBENCH_FuWait(void)
+{
+    while (benchFuDone == false)
+    {
+        HOST_TIME_AdvanceUS(BENCH_FU_LOOP_US);
+        DRV_MEMORY_Tasks((SYS_MODULE_OBJ)0);
+        SRV_FU_Tasks();
+        SRV_STORAGE_Tasks();
+    }
+
+    benchFuDone = false;
+}
+
+static void lBENCH_FuUpgrade(void)
+{
+    SRV_FU_INFO info = {BENCH_FU_IMAGE_SIZE, 0, SRV_FU_SIGNATURE_ALGO_NO_SIGNATURE, BENCH_FU_PAGE_SIZE};
+    uint32_t address, size;
+
+    /* Pages received in order, then the image CRC. Host models included */
+    SRV_FU_Start(&info);
+    lBENCH_FuWait();
+    for (address = 0; address < BENCH_FU_IMAGE_SIZE; address += size)
+    {
+        size = BENCH_FU_IMAGE_SIZE - address;
+        if (size > BENCH_FU_PAGE_SIZE)
+        {
+            size = BENCH_FU_PAGE_SIZE;
+        }
+
+        SRV_FU_DataWrite(address, &benchFuImage[address], (uint16_t)size);
+        lBENCH_FuWait();
+    }
+
+    SRV_FU_CalculateCrc();
+    lBENCH_FuWait();
+    SRV_FU_End(SRV_FU_RESULT_CANCEL);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Measurement
+// *****************************************************************************
+// *****************************************************************************
+
+static uint64_t lBENCH_Now(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/* Runs the operation for at least BENCH_MIN_TIME_NS and prints the time per
+   unit (byte or operation) */
+static void lBENCH_Run(const char *name, void (*operation)(void), size_t units, const char *unit)
+{
+    uint64_t start, elapsed;
+    uint64_t calls = 0;
+    uint32_t batch = 1;
+    uint32_t index;
+
+    /* Warm up */
+    operation();
+
+    start = lBENCH_Now();
+    do
+    {
+        for (index = 0; index < batch; index++)
+        {
+            operation();
+        }
+
+        calls += batch;
+        batch <<= (batch < 0x10000U) ? 1U : 0U;
+        elapsed = lBENCH_Now() - start;
+    } while (elapsed < BENCH_MIN_TIME_NS);
+
+    printf("%-32s %10.2f ns/%s\n", name, (double)elapsed / ((double)calls * (double)units), unit);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(void)
+{
+    char name[40];
+    uint32_t index;
+    uint32_t rxCount;
+
+    TC0_CH0_TimerInitialize();
+    (void)SYS_TIME_Initialize(SYS_TIME_INDEX_0, (SYS_MODULE_INIT *)&benchTimeInitData);
+
+    srand(1);
+    for (index = 0; index < BENCH_CRC_SIZE; index++)
+    {
+        benchCrcData[index] = (uint8_t)rand();
+    }
+
+    for (index = 0; index < BENCH_CRC_LENGTHS; index++)
+    {
+        benchCrcLength = benchCrcLengths[index];
+        (void) snprintf(name, sizeof(name), "pcrc CRC8 (%u bytes)", (uint32_t)benchCrcLength);
+        lBENCH_Run(name, lBENCH_Crc8, benchCrcLength, "byte");
+        (void) snprintf(name, sizeof(name), "pcrc CRC16 (%u bytes)", (uint32_t)benchCrcLength);
+        lBENCH_Run(name, lBENCH_Crc16, benchCrcLength, "byte");
+        (void) snprintf(name, sizeof(name), "pcrc CRC32 (%u bytes)", (uint32_t)benchCrcLength);
+        lBENCH_Run(name, lBENCH_Crc32, benchCrcLength, "byte");
+    }
+
+    /* USI: PHY frames (CRC16) of random payload */
+    FLEXCOM7_USART_Initialize();
+    HOST_FLEXCOM7_Reset();
+    (void) SRV_USI_Initialize(SRV_USI_INDEX_0, (SYS_MODULE_INIT *)&benchUsiInit);
+    benchUsiHandle = SRV_USI_Open(SRV_USI_INDEX_0);
+    SRV_USI_CallbackRegister(benchUsiHandle, SRV_USI_PROT_ID_PHY, lBENCH_UsiCallback);
+
+    for (index = 0; index < BENCH_USI_PAYLOAD_SIZE; index++)
+    {
+        benchUsiPayload[index] = (uint8_t)rand();
+    }
+
+    lBENCH_Run("usi send (payload)", lBENCH_UsiSend, BENCH_USI_PAYLOAD_SIZE, "byte");
+
+    /* Modem data indication: copy into a serialization buffer or segments */
+    for (index = 0; index < BENCH_USI_HEADER_SIZE; index++)
+    {
+        benchUsiHeader[index] = (uint8_t)rand();
+    }
+
+    for (index = 0; index < BENCH_USI_TRAILER_SIZE; index++)
+    {
+        benchUsiTrailer[index] = (uint8_t)rand();
+    }
+
+    lBENCH_Run("usi send indication (copy)", lBENCH_UsiSendCopy, BENCH_USI_PAYLOAD_SIZE, "byte");
+    lBENCH_Run("usi send indication (segments)", lBENCH_UsiSendSegments, BENCH_USI_PAYLOAD_SIZE, "byte");
+    printf("%-32s %10u bytes copy, %u bytes segments\n", "usi send indication staging RAM",
+           (uint32_t)sizeof(benchUsiMessage), (uint32_t)(BENCH_USI_HEADER_SIZE + BENCH_USI_TRAILER_SIZE));
+
+    (void) SRV_USI_Send_Message(benchUsiHandle, SRV_USI_PROT_ID_PHY, benchUsiPayload, BENCH_USI_PAYLOAD_SIZE);
+    benchUsiFrameLength = HOST_FLEXCOM7_Transmit(benchUsiFrame, sizeof(benchUsiFrame));
+    rxCount = benchUsiRxCount;
+    lBENCH_UsiReceive();
+    if (benchUsiRxCount != (rxCount + 1U))
+    {
+        printf("usi receive: frame not decoded\n");
+        return 1;
+    }
+
+    lBENCH_Run("usi receive (line data)", lBENCH_UsiReceive, benchUsiFrameLength, "byte");
+
+    /* Dense escapes: every payload byte escaped, and delimiters only */
+    (void) memset(benchUsiPayload, 0x7E, BENCH_USI_PAYLOAD_SIZE);
+    (void) SRV_USI_Send_Message(benchUsiHandle, SRV_USI_PROT_ID_PHY, benchUsiPayload, BENCH_USI_PAYLOAD_SIZE);
+    benchUsiFrameLength = HOST_FLEXCOM7_Transmit(benchUsiFrame, sizeof(benchUsiFrame));
+    lBENCH_Run("usi receive (escaped 0x7E)", lBENCH_UsiReceive, benchUsiFrameLength, "byte");
+
+    (void) memset(benchUsiFrame, 0x7E, benchUsiFrameLength);
+    lBENCH_Run("usi receive (all 0x7E)", lBENCH_UsiReceive, benchUsiFrameLength, "byte");
+
+    /* Dispatch of short frames of every protocol, in random order: lookups
+       alone (switch before the descriptor table, and table), and frames
+       received through the service */
+    for (index = 0; index < BENCH_USI_DISPATCH_PROTOCOLS; index++)
+    {
+        SRV_USI_CallbackRegister(benchUsiHandle, benchUsiProtocols[index], lBENCH_UsiCallback);
+    }
+
+    benchUsiFrameLength = 0;
+    for (index = 0; index < BENCH_USI_DISPATCH_FRAMES; index++)
+    {
+        benchUsiDispatch[index] = benchUsiProtocols[(uint32_t)rand() % BENCH_USI_DISPATCH_PROTOCOLS];
+        (void) SRV_USI_Send_Message(benchUsiHandle, benchUsiDispatch[index], benchUsiPayload,
+                                    BENCH_USI_DISPATCH_PAYLOAD);
+        benchUsiFrameLength += HOST_FLEXCOM7_Transmit(&benchUsiFrame[benchUsiFrameLength],
+                                                      sizeof(benchUsiFrame) - benchUsiFrameLength);
+    }
+
+    lBENCH_Run("usi dispatch (switch)", lBENCH_DispatchSwitch, BENCH_USI_DISPATCH_FRAMES, "frame");
+    lBENCH_Run("usi dispatch (table)", lBENCH_DispatchTable, BENCH_USI_DISPATCH_FRAMES, "frame");
+
+    rxCount = benchUsiRxCount;
+    lBENCH_UsiReceive();
+    if (benchUsiRxCount != (rxCount + BENCH_USI_DISPATCH_FRAMES))
+    {
+        printf("usi receive: short frames not decoded\n");
+        return 1;
+    }
+
+    lBENCH_Run("usi receive (short frames)", lBENCH_UsiReceive, BENCH_USI_DISPATCH_FRAMES, "frame");
+
+    /* Queues of the MAC, kept full */
+    for (index = 0; index < BENCH_QUEUE_DEPTHS; index++)
+    {
+        uint32_t element;
+
+        benchQueueDepth = benchQueueDepths[index];
+        SRV_QUEUE_Init(&benchQueue, (uint16_t)benchQueueDepth, SRV_QUEUE_TYPE_PRIORITY);
+        for (element = 0; element < benchQueueDepth; element++)
+        {
+            SRV_QUEUE_Append_With_Priority(&benchQueue, element % SRV_QUEUE_PRIORITY_LEVELS, &benchElements[element]);
+        }
+
+        (void) snprintf(name, sizeof(name), "queue priority append (%u)", benchQueueDepth);
+        lBENCH_Run(name, lBENCH_QueuePriority, 1, "op");
+        (void) snprintf(name, sizeof(name), "queue priority unlink (%u)", benchQueueDepth);
+        lBENCH_Run(name, lBENCH_QueueUnlink, 1, "op");
+
+        SRV_QUEUE_Init(&benchQueue, (uint16_t)benchQueueDepth, SRV_QUEUE_TYPE_SINGLE);
+        for (element = 0; element < benchQueueDepth; element++)
+        {
+            SRV_QUEUE_Append(&benchQueue, &benchElements[element]);
+        }
+
+        (void) snprintf(name, sizeof(name), "queue single append (%u)", benchQueueDepth);
+        lBENCH_Run(name, lBENCH_QueueSingle, 1, "op");
+    }
+
+    /* Storage: data kept in RAM until the write delay */
+    SRV_STORAGE_Initialize();
+    lBENCH_Run("storage set", lBENCH_StorageSet, 1, "op");
+    lBENCH_Run("storage get", lBENCH_StorageGet, 1, "op");
+
+    lBENCH_Run("time management get time", lBENCH_TimeGet, 1, "op");
+
+    /* Log report: message and buffer in hex */
+    for (index = 0; index < BENCH_LOG_BUFFER_SIZE; index++)
+    {
+        benchLogBuffer[index] = (uint8_t)rand();
+    }
+
+    lBENCH_Run("log report message", lBENCH_LogMessage, 1, "op");
+    lBENCH_Run("log report buffer (hex)", lBENCH_LogBuffer, BENCH_LOG_BUFFER_SIZE, "byte");
+
+    /* Firmware upgrade over the memory driver model */
+    for (index = 0; index < BENCH_FU_IMAGE_SIZE; index++)
+    {
+        benchFuImage[index] = (uint8_t)rand();
+    }
+
+    HOST_MEMORY_Reset(0xFFU);
+    SRV_FU_Initialize();
+    SRV_FU_RegisterCallbackMemTransfer(lBENCH_FuMemCallback);
+    SRV_FU_RegisterCallbackCrc(lBENCH_FuCrcCallback);
+    for (index = 0; index < 5U; index++)
+    {
+        DRV_MEMORY_Tasks((SYS_MODULE_OBJ)0);
+        SRV_FU_Tasks();
+    }
+
+    lBENCH_Run("fu upgrade (image)", lBENCH_FuUpgrade, BENCH_FU_IMAGE_SIZE, "byte");
+
+    return 0;
+}
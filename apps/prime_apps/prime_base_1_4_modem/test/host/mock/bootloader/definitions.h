@@ -0,0 +1,110 @@
+/*******************************************************************************
+  Host Bootloader Definitions
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    definitions.h
+
+  Summary:
+    Project system definitions of the PRIME service bootloader for the host build.
+
+  Description:
+    Includes the SEFC0 flash controller model and models of the Cortex-M core
+    registers and intrinsics used by the bootloader. The jump to the
+    application ends the boot (see HOST_JumpToApplication).
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+#ifndef DEFINITIONS_H
+#define DEFINITIONS_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "device.h"
+#include "peripheral/sefc/plib_sefc0.h"
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Cortex-M core
+// *****************************************************************************
+// *****************************************************************************
+
+#define SCB_VTOR_TBLOFF_Msk     (0x1FFFFFFUL << 7U)
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+} SysTick_Type;
+
+typedef struct
+{
+    volatile uint32_t ICER[8];
+    volatile uint32_t ICPR[8];
+} NVIC_Type;
+
+typedef struct
+{
+    volatile uint32_t VTOR;
+} SCB_Type;
+
+extern SysTick_Type hostSysTick;
+extern NVIC_Type hostNvic;
+extern SCB_Type hostScb;
+
+#define SysTick    (&hostSysTick)
+#define NVIC       (&hostNvic)
+#define SCB        (&hostScb)
+
+static inline void NVIC_SetPriorityGrouping(uint32_t priorityGroup) { (void)priorityGroup; }
+static inline void __disable_irq(void) {}
+static inline void __enable_irq(void) {}
+static inline void __DSB(void) {}
+static inline void __ISB(void) {}
+
+/* The stack of the application is set just before the jump */
+#define __set_MSP(topOfMainStack)    HOST_JumpToApplication()
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SEFC0 PLIB
+// *****************************************************************************
+// *****************************************************************************
+
+/* Only in the PLIB of the bootloader configuration */
+bool SEFC0_UserSignatureUnitWrite(uint32_t *data, uint32_t offset, SEFC_USERSIGNATURE_BLOCK block, SEFC_USERSIGNATURE_PAGE page);
+
+#endif /* DEFINITIONS_H */
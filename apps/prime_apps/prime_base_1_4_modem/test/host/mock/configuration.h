@@ -0,0 +1,145 @@
+/*******************************************************************************
+  Host System Configuration Header
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    configuration.h
+
+  Summary:
+    Build-time configuration of the services in the host build.
+
+  Description:
+    Options of config/pic32cxmtg_pl460_rf215/configuration.h used by the
+    services under test, with the same values. Memory addresses point to the
+    host models of the flash (see host_mock.h).
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+#ifndef CONFIGURATION_H
+#define CONFIGURATION_H
+
+#include "device.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: System Service Configuration
+// *****************************************************************************
+// *****************************************************************************
+/* TIME System Service Configuration Options */
+#define SYS_TIME_INDEX_0                            (0)
+#ifndef SYS_TIME_MAX_TIMERS
+#define SYS_TIME_MAX_TIMERS                         (48)
+#endif
+#define SYS_TIME_HW_COUNTER_WIDTH                   (32)
+#define SYS_TIME_HW_COUNTER_PERIOD                  (4294967295U)
+#define SYS_TIME_HW_COUNTER_HALF_PERIOD             (SYS_TIME_HW_COUNTER_PERIOD>>1)
+#define SYS_TIME_CPU_CLOCK_FREQUENCY                (200000000)
+#define SYS_TIME_COMPARE_UPDATE_EXECUTION_CYCLES    (232)
+#define SYS_TIME_WHEEL_TICK_SHIFT                   (9U)
+
+#define SYS_CONSOLE_PRINT_BUFFER_SIZE               (200U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Driver Configuration
+// *****************************************************************************
+// *****************************************************************************
+/* Memory Driver Global Configuration Options */
+#define DRV_MEMORY_INSTANCES_NUMBER          (1U)
+
+/* PCRC Service Configuration Options */
+#define SRV_PCRC_SLICING_ENABLE
+
+/* Queue Service Configuration Options */
+#define SRV_QUEUE_PRIORITY_LEVELS             8U
+#define SRV_QUEUE_INFO_NUMBER                 32U
+
+/* Storage Service Configuration Options */
+#define SRV_STORAGE_WRITE_DELAY_MS            1000U
+
+/* Firmware Upgrade Service Configuration Options */
+#define SRV_FU_CHECKPOINT_PAGES               64U
+
+/* USI Service Common Configuration Options */
+#define SRV_USI_INSTANCES_NUMBER              1U
+#define SRV_USI_USART_CONNECTIONS             1U
+#define SRV_USI_CDC_CONNECTIONS               0U
+/* Set to 1U by the DMA test build (see Makefile) */
+#ifndef SRV_USI_USART_DMA_CONNECTIONS
+#define SRV_USI_USART_DMA_CONNECTIONS         0U
+#endif
+#define SRV_USI_MSG_POOL_SIZE                 5U
+
+/* PLC PHY Driver Configuration Options */
+#define DRV_PLC_SECURE                        false
+#define DRV_PLC_EXT_INT_PIO_PORT              PIO_PORT_A
+#define DRV_PLC_EXT_INT_SRC                   PIOA_IRQn
+#define DRV_PLC_EXT_INT_PIO                   SYS_PORT_PIN_PA2
+#define DRV_PLC_EXT_INT_PIN                   SYS_PORT_PIN_PA2
+#define DRV_PLC_RESET_PIN                     SYS_PORT_PIN_PD15
+#define DRV_PLC_LDO_EN_PIN                    SYS_PORT_PIN_PD19
+#define DRV_PLC_TX_ENABLE_PIN                 SYS_PORT_PIN_PA1
+#define DRV_PLC_THMON_PIN                     SYS_PORT_PIN_PB15
+#define DRV_PLC_CSR_INDEX                     0
+#define DRV_PLC_SPI_CLK                       8000000
+
+/* PLC Driver Identification */
+#define DRV_PLC_PHY_INSTANCES_NUMBER          1U
+#define DRV_PLC_PHY_INDEX                     0U
+#define DRV_PLC_PHY_CLIENTS_NUMBER_IDX        1U
+#define DRV_PLC_PHY_PROFILE                   4U
+#define DRV_PLC_PHY_NUM_CARRIERS              97U
+#define DRV_PLC_PHY_HOST_PRODUCT              0x3600U
+#define DRV_PLC_PHY_HOST_VERSION              0x36000300UL
+#define DRV_PLC_PHY_HOST_PHY                  0x36000003UL
+#define DRV_PLC_PHY_HOST_DESC                 "PIC32CX2051MTG128"
+#define DRV_PLC_PHY_HOST_MODEL                3U
+#define DRV_PLC_PHY_HOST_BAND                 DRV_PLC_PHY_PROFILE
+/* Received frames kept until reported. DRV_PLC_PHY_Tasks stores at most one
+   frame before and one after the data indications, so 2 is the maximum */
+#define DRV_PLC_PHY_RX_RING_SIZE              2U
+#define DRV_PLC_PHY_PIB_QUEUE_SIZE            4U
+
+/* Memory Driver Instance 0 Configuration */
+#define DRV_MEMORY_INDEX_0                   0
+#define DRV_MEMORY_CLIENTS_NUMBER_IDX0       1
+#define DRV_MEMORY_BUF_Q_SIZE_IDX0    1
+extern uint8_t *hostMemoryMedia;
+#define DRV_MEMORY_DEVICE_START_ADDRESS      ((uintptr_t)hostMemoryMedia)
+#define DRV_MEMORY_DEVICE_MEDIA_SIZE         384UL
+#define DRV_MEMORY_DEVICE_MEDIA_SIZE_BYTES   (DRV_MEMORY_DEVICE_MEDIA_SIZE * 1024U)
+#define DRV_MEMORY_DEVICE_PROGRAM_SIZE       512U
+#define DRV_MEMORY_DEVICE_ERASE_SIZE         8192U
+
+/* USI Service Instance 0 Configuration Options */
+#define SRV_USI_INDEX_0                       0
+#define SRV_USI0_RD_BUF_SIZE                  1024
+#define SRV_USI0_WR_BUF_SIZE                  1024
+
+#endif // CONFIGURATION_H
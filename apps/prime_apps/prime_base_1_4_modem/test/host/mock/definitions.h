@@ -0,0 +1,67 @@
+/*******************************************************************************
+  Host System Definitions
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    definitions.h
+
+  Summary:
+    Project system definitions for the host build.
+
+  Description:
+    Includes the peripheral libraries, drivers and system services used by the
+    services under test. The peripheral libraries are host models (see
+    host_mock.h) behind the interface headers of the project.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+#ifndef DEFINITIONS_H
+#define DEFINITIONS_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "peripheral/tc/plib_tc0.h"
+#include "peripheral/sefc/plib_sefc0.h"
+#include "peripheral/supc/plib_supc.h"
+#include "peripheral/trng/plib_trng.h"
+#include "peripheral/flexcom/usart/plib_flexcom7_usart.h"
+#include "system/int/sys_int.h"
+#include "system/time/sys_time.h"
+#include "driver/memory/drv_memory.h"
+#include "service/usi/srv_usi.h"
+#include "service/log_report/srv_log_report.h"
+#include "stack/prime/prime_api/prime_api.h"
+
+#endif /* DEFINITIONS_H */
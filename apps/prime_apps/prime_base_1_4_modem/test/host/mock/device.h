@@ -0,0 +1,97 @@
+/*******************************************************************************
+  Host Device Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    device.h
+
+  Summary:
+    Device definitions used by the services in the host build.
+
+  Description:
+    Replaces the device pack header (CMSIS core included), which does not
+    build for the host. Only the peripheral register definitions used by the
+    services under test are taken from the device pack.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+#ifndef DEVICE_H
+#define DEVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Register access qualifiers and constants of the device pack */
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+#define _UINT8_(x)   ((uint8_t)(x))
+#define _UINT16_(x)  ((uint16_t)(x))
+#define _UINT32_(x)  ((uint32_t)(x))
+
+#define __STATIC_INLINE    static inline
+
+/* Interrupt sources used by the services under test */
+typedef enum
+{
+    FLEXCOM7_IRQn   = 16,
+    PIOA_IRQn       = 17,
+    TC0_CH0_IRQn    = 31,
+} IRQn_Type;
+
+#include "component/adc.h"
+#include "component/flexcom.h"
+#include "component/pmc.h"
+#include "component/pio.h"
+#include "component/sefc.h"
+#include "component/tc.h"
+
+#define IFLASH0_SIZE                   _UINT32_(0x00100000)
+#define IFLASH0_PAGE_SIZE              _UINT32_(       512)
+#define IFLASH0_ADDR                   _UINT32_(0x01000000)
+
+/* Cortex-M core: interrupts are masked while BASEPRI is not 0 (see
+   mock/sys_int.c) */
+#define __NVIC_PRIO_BITS        4
+uint32_t HOST_INT_GetBasePri(void);
+void HOST_INT_SetBasePri(uint32_t basePri);
+static inline uint32_t __get_BASEPRI(void) { return HOST_INT_GetBasePri(); }
+static inline void __set_BASEPRI(uint32_t basePri) { HOST_INT_SetBasePri(basePri); }
+
+/* PIO controller of the PLC external interrupt (see mock/drv_plc_hal.c) */
+extern pio_registers_t hostPioRegs;
+#define PIO0_REGS                      (&hostPioRegs)
+
+/* No data cache in the host */
+#define CACHE_ALIGN
+#define CACHE_LINE_SIZE    (4U)
+#define CACHE_ALIGNED_SIZE_GET(size)     ((size) + ((((size) % (CACHE_LINE_SIZE))!= 0U)? ((CACHE_LINE_SIZE) - ((size) % (CACHE_LINE_SIZE))) : (0U)))
+
+#endif //DEVICE_H
@@ -0,0 +1,437 @@
+/*******************************************************************************
+  Memory Driver Host Model
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_memory.c
+
+  Summary:
+    Host model of the memory driver on the FU region of the internal flash.
+
+  Description:
+    The media is kept across boots. Erase and write commands take time, block
+    by block, and the block in progress is damaged by a power cut. One command
+    is queued at a time (DRV_MEMORY_BUF_Q_SIZE_IDX0), and its transfer handler
+    is called by DRV_MEMORY_Tasks, as in the driver.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "configuration.h"
+#include "driver/memory/drv_memory.h"
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Modelled part of the media: the FU region */
+#define DRV_MEMORY_HOST_SIZE           0x60000U
+
+/* Command times in TC0 counts per block. Assumed values (sector erase 50 ms,
+   page write 1.5 ms), not taken from the datasheet */
+#define DRV_MEMORY_HOST_ERASE_COUNTS   ((HOST_TIME_FREQUENCY / 1000U) * 50U)
+#define DRV_MEMORY_HOST_WRITE_COUNTS   ((HOST_TIME_FREQUENCY / 1000U) * 3U / 2U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    DRV_MEMORY_HOST_CMD_NONE,
+    DRV_MEMORY_HOST_CMD_ERASE,
+    DRV_MEMORY_HOST_CMD_WRITE,
+    DRV_MEMORY_HOST_CMD_READ
+} DRV_MEMORY_HOST_CMD;
+
+typedef struct
+{
+    DRV_MEMORY_HOST_CMD type;
+    DRV_MEMORY_COMMAND_HANDLE handle;
+    uint8_t *buffer;
+    uint32_t blockStart;
+    uint32_t nBlock;
+    uint32_t blockSize;
+    uint32_t blocksDone;
+    uint64_t start;
+    uint32_t blockCounts;
+    bool error;
+} DRV_MEMORY_HOST_COMMAND;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+uint8_t *hostMemoryMedia;
+
+static HOST_MEMORY_STATS *drvMemoryStats;
+
+/* Page write that fails (number of the write since reset, 0 for none) */
+static uint32_t drvMemoryFailWrite;
+
+static DRV_MEMORY_HOST_COMMAND drvMemoryCmd;
+static DRV_MEMORY_COMMAND_HANDLE drvMemoryNextHandle = 1;
+static DRV_MEMORY_TRANSFER_HANDLER drvMemoryHandler;
+static uintptr_t drvMemoryContext;
+
+static SYS_MEDIA_REGION_GEOMETRY drvMemoryRegions[3] = {
+    { 1U, DRV_MEMORY_HOST_SIZE },
+    { DRV_MEMORY_DEVICE_PROGRAM_SIZE, DRV_MEMORY_HOST_SIZE / DRV_MEMORY_DEVICE_PROGRAM_SIZE },
+    { DRV_MEMORY_DEVICE_ERASE_SIZE, DRV_MEMORY_HOST_SIZE / DRV_MEMORY_DEVICE_ERASE_SIZE }
+};
+
+static SYS_MEDIA_GEOMETRY drvMemoryGeometry = {
+    SYS_MEDIA_SUPPORTS_BYTE_WRITES, 1U, 1U, 1U, drvMemoryRegions
+};
+
+__attribute__((constructor)) static void lDRV_MEMORY_HostInit(void)
+{
+    hostMemoryMedia = HOST_NvmAlloc(DRV_MEMORY_HOST_SIZE);
+    drvMemoryStats = HOST_NvmAlloc(sizeof(HOST_MEMORY_STATS));
+    HOST_MEMORY_Reset(0xFFU);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lDRV_MEMORY_BlockDone(void)
+{
+    DRV_MEMORY_HOST_COMMAND *cmd = &drvMemoryCmd;
+    uint32_t offset = (cmd->blockStart + cmd->blocksDone) * cmd->blockSize;
+    uint8_t *pSource = &cmd->buffer[cmd->blocksDone * cmd->blockSize];
+    bool programmed = false;
+    uint32_t index;
+
+    switch (cmd->type)
+    {
+        case DRV_MEMORY_HOST_CMD_ERASE:
+            (void)memset(&hostMemoryMedia[offset], 0xFF, cmd->blockSize);
+            drvMemoryStats->erases++;
+            break;
+
+        case DRV_MEMORY_HOST_CMD_WRITE:
+            if ((drvMemoryStats->writes + 1U) == drvMemoryFailWrite)
+            {
+                /* Program stopped in the middle of the page */
+                cmd->error = true;
+                for (index = 0; index < (cmd->blockSize / 2U); index++)
+                {
+                    hostMemoryMedia[offset + index] &= pSource[index];
+                }
+
+                drvMemoryStats->writes++;
+                break;
+            }
+
+            for (index = 0; index < cmd->blockSize; index++)
+            {
+                if ((pSource[index] != 0xFFU) && (hostMemoryMedia[offset + index] != 0xFFU))
+                {
+                    programmed = true;
+                }
+
+                hostMemoryMedia[offset + index] &= pSource[index];
+            }
+
+            drvMemoryStats->writes++;
+            if (programmed == true)
+            {
+                drvMemoryStats->doublePrograms++;
+            }
+            break;
+
+        case DRV_MEMORY_HOST_CMD_READ:
+        default:
+            (void)memcpy(pSource, &hostMemoryMedia[offset], cmd->blockSize);
+            break;
+    }
+
+    cmd->blocksDone++;
+}
+
+static void lDRV_MEMORY_Queue
+(
+    DRV_MEMORY_HOST_CMD type,
+    DRV_MEMORY_COMMAND_HANDLE *commandHandle,
+    void *buffer,
+    uint32_t blockStart,
+    uint32_t nBlock
+)
+{
+    DRV_MEMORY_HOST_COMMAND *cmd = &drvMemoryCmd;
+    uint32_t table;
+
+    *commandHandle = DRV_MEMORY_COMMAND_HANDLE_INVALID;
+
+    if (cmd->type != DRV_MEMORY_HOST_CMD_NONE)
+    {
+        /* Buffer queue full */
+        return;
+    }
+
+    table = (type == DRV_MEMORY_HOST_CMD_ERASE) ? SYS_MEDIA_GEOMETRY_TABLE_ERASE_ENTRY :
+            ((type == DRV_MEMORY_HOST_CMD_WRITE) ? SYS_MEDIA_GEOMETRY_TABLE_WRITE_ENTRY : SYS_MEDIA_GEOMETRY_TABLE_READ_ENTRY);
+
+    if ((nBlock == 0U) || (blockStart >= drvMemoryRegions[table].numBlocks) ||
+        (nBlock > (drvMemoryRegions[table].numBlocks - blockStart)))
+    {
+        drvMemoryStats->errors++;
+        return;
+    }
+
+    cmd->type = type;
+    cmd->handle = drvMemoryNextHandle++;
+    cmd->buffer = buffer;
+    cmd->blockStart = blockStart;
+    cmd->nBlock = nBlock;
+    cmd->blockSize = drvMemoryRegions[table].blockSize;
+    cmd->blocksDone = 0;
+    cmd->error = false;
+    cmd->start = HOST_TIME_Get();
+    cmd->blockCounts = (type == DRV_MEMORY_HOST_CMD_ERASE) ? DRV_MEMORY_HOST_ERASE_COUNTS :
+                       ((type == DRV_MEMORY_HOST_CMD_WRITE) ? DRV_MEMORY_HOST_WRITE_COUNTS : 0U);
+
+    *commandHandle = cmd->handle;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Memory Driver Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+DRV_HANDLE DRV_MEMORY_Open( const SYS_MODULE_INDEX drvIndex, const DRV_IO_INTENT ioIntent )
+{
+    (void)ioIntent;
+
+    if (drvIndex != (SYS_MODULE_INDEX)DRV_MEMORY_INDEX_0)
+    {
+        return DRV_HANDLE_INVALID;
+    }
+
+    return (DRV_HANDLE)1;
+}
+
+void DRV_MEMORY_Close( const DRV_HANDLE handle )
+{
+    (void)handle;
+}
+
+void DRV_MEMORY_TransferHandlerSet
+(
+    const DRV_HANDLE handle,
+    const void * transferHandler,
+    const uintptr_t context
+)
+{
+    (void)handle;
+    drvMemoryHandler = (DRV_MEMORY_TRANSFER_HANDLER)transferHandler;
+    drvMemoryContext = context;
+}
+
+SYS_MEDIA_GEOMETRY * DRV_MEMORY_GeometryGet( const DRV_HANDLE handle )
+{
+    (void)handle;
+    return &drvMemoryGeometry;
+}
+
+void DRV_MEMORY_AsyncErase
+(
+    const DRV_HANDLE handle,
+    DRV_MEMORY_COMMAND_HANDLE *commandHandle,
+    uint32_t blockStart,
+    uint32_t nBlock
+)
+{
+    (void)handle;
+    lDRV_MEMORY_Queue(DRV_MEMORY_HOST_CMD_ERASE, commandHandle, NULL, blockStart, nBlock);
+}
+
+void DRV_MEMORY_AsyncWrite
+(
+    const DRV_HANDLE handle,
+    DRV_MEMORY_COMMAND_HANDLE *commandHandle,
+    void *sourceBuffer,
+    uint32_t blockStart,
+    uint32_t nBlock
+)
+{
+    (void)handle;
+    lDRV_MEMORY_Queue(DRV_MEMORY_HOST_CMD_WRITE, commandHandle, sourceBuffer, blockStart, nBlock);
+}
+
+void DRV_MEMORY_AsyncRead
+(
+    const DRV_HANDLE handle,
+    DRV_MEMORY_COMMAND_HANDLE *commandHandle,
+    void *targetBuffer,
+    uint32_t blockStart,
+    uint32_t nBlock
+)
+{
+    (void)handle;
+    lDRV_MEMORY_Queue(DRV_MEMORY_HOST_CMD_READ, commandHandle, targetBuffer, blockStart, nBlock);
+}
+
+void DRV_MEMORY_Tasks( SYS_MODULE_OBJ object )
+{
+    DRV_MEMORY_COMMAND_HANDLE handle = drvMemoryCmd.handle;
+
+    (void)object;
+
+    HOST_MEMORY_Tasks();
+
+    if ((drvMemoryCmd.type == DRV_MEMORY_HOST_CMD_NONE) ||
+        (drvMemoryCmd.blocksDone < drvMemoryCmd.nBlock))
+    {
+        return;
+    }
+
+    /* Command done: the buffer queue is free before the handler is called */
+    drvMemoryCmd.type = DRV_MEMORY_HOST_CMD_NONE;
+    if (drvMemoryHandler != NULL)
+    {
+        drvMemoryHandler((drvMemoryCmd.error == true) ? (SYS_MEDIA_BLOCK_EVENT)DRV_MEMORY_EVENT_COMMAND_ERROR :
+                         (SYS_MEDIA_BLOCK_EVENT)DRV_MEMORY_EVENT_COMMAND_COMPLETE, handle, drvMemoryContext);
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Host Models Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void HOST_MEMORY_Reset(uint8_t value)
+{
+    (void)memset(hostMemoryMedia, value, DRV_MEMORY_HOST_SIZE);
+    (void)memset(drvMemoryStats, 0, sizeof(HOST_MEMORY_STATS));
+    drvMemoryCmd.type = DRV_MEMORY_HOST_CMD_NONE;
+    drvMemoryFailWrite = 0;
+}
+
+void HOST_MEMORY_FailWrite(uint32_t write)
+{
+    drvMemoryFailWrite = write;
+}
+
+void HOST_MEMORY_GetStats(HOST_MEMORY_STATS *stats)
+{
+    *stats = *drvMemoryStats;
+}
+
+void HOST_MEMORY_Tasks(void)
+{
+    DRV_MEMORY_HOST_COMMAND *cmd = &drvMemoryCmd;
+    uint64_t elapsed;
+
+    if (cmd->type == DRV_MEMORY_HOST_CMD_NONE)
+    {
+        return;
+    }
+
+    elapsed = HOST_TIME_Get() - cmd->start;
+    while ((cmd->blocksDone < cmd->nBlock) &&
+           (elapsed >= ((uint64_t)cmd->blockCounts * (cmd->blocksDone + 1U))))
+    {
+        lDRV_MEMORY_BlockDone();
+    }
+}
+
+bool HOST_MEMORY_IsFlashBusy(void)
+{
+    HOST_MEMORY_Tasks();
+
+    return ((drvMemoryCmd.type == DRV_MEMORY_HOST_CMD_ERASE) || (drvMemoryCmd.type == DRV_MEMORY_HOST_CMD_WRITE)) &&
+           (drvMemoryCmd.blocksDone < drvMemoryCmd.nBlock);
+}
+
+void HOST_MEMORY_PowerCut(void)
+{
+    DRV_MEMORY_HOST_COMMAND *cmd = &drvMemoryCmd;
+    uint32_t offset, index;
+    uint8_t *pSource;
+    int damage;
+
+    HOST_MEMORY_Tasks();
+
+    if (((cmd->type == DRV_MEMORY_HOST_CMD_ERASE) || (cmd->type == DRV_MEMORY_HOST_CMD_WRITE)) &&
+        (cmd->blocksDone < cmd->nBlock))
+    {
+        /* Block in progress: each byte keeps its old value, gets the new one
+         * or is in between */
+        offset = (cmd->blockStart + cmd->blocksDone) * cmd->blockSize;
+        pSource = &cmd->buffer[cmd->blocksDone * cmd->blockSize];
+        for (index = 0; index < cmd->blockSize; index++)
+        {
+            damage = rand() % 3;
+            if (cmd->type == DRV_MEMORY_HOST_CMD_ERASE)
+            {
+                if (damage == 0)
+                {
+                    hostMemoryMedia[offset + index] = 0xFFU;
+                }
+                else if (damage == 1)
+                {
+                    hostMemoryMedia[offset + index] |= (uint8_t)rand();
+                }
+            }
+            else
+            {
+                if (damage == 0)
+                {
+                    hostMemoryMedia[offset + index] &= pSource[index];
+                }
+                else if (damage == 1)
+                {
+                    hostMemoryMedia[offset + index] &= (uint8_t)(pSource[index] | (uint8_t)rand());
+                }
+            }
+        }
+    }
+
+    cmd->type = DRV_MEMORY_HOST_CMD_NONE;
+}
@@ -0,0 +1,360 @@
+/*******************************************************************************
+  FLEXCOM USART PDC Host Model
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    flexcom_pdc.c
+
+  Summary:
+    Host model of a FLEXCOM USART with its PDC, for the USI DMA transport.
+
+  Description:
+    The line runs one character per HOST_PDC_Tick. Register writes of the
+    service are applied by the model before it reads them back, and the
+    interrupt handler is called while an enabled status flag is set.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Bit periods of a character (start, 8 data, stop) */
+#define FLEXCOM_HOST_CHAR_BITS      10U
+
+/* Interrupt handler calls per event before the model reports a storm */
+#define FLEXCOM_HOST_IRQ_LIMIT      8U
+
+#define FLEXCOM_HOST_PDC_POINTER(address)    ((uint8_t *)(uintptr_t)(address))
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+flexcom_registers_t hostFlexcomRegs;
+
+static void (*flexcomHandler)(uint32_t index);
+static uint32_t flexcomIndex;
+static bool flexcomIrqMasked;
+
+/* Status and interrupt mask */
+static uint32_t flexcomImr;
+static bool flexcomEndRx;
+static bool flexcomOverrun;
+/* Line errors (FRAME, PARE) of the received characters until RSTSTA, and
+   errors of the next character */
+static uint32_t flexcomRxErrors;
+static uint32_t flexcomLineError;
+
+/* Counters seen by the model after the last register update */
+static uint32_t flexcomRcr;
+static uint32_t flexcomRncr;
+
+/* Receiver time-out */
+static uint32_t flexcomTimeoutChars;
+static bool flexcomTimeoutArmed;
+static bool flexcomTimeoutWaitChar;
+static bool flexcomTimeout;
+static uint32_t flexcomIdleChars;
+
+static uint32_t flexcomLostBytes;
+static uint32_t flexcomInterrupts;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lFLEXCOM_HostApply(void)
+{
+    flexcom_registers_t *regs = &hostFlexcomRegs;
+    uint32_t csr = 0U;
+
+    if (regs->FLEX_US_IDR != 0U)
+    {
+        flexcomImr &= ~regs->FLEX_US_IDR;
+        regs->FLEX_US_IDR = 0U;
+    }
+
+    if (regs->FLEX_US_IER != 0U)
+    {
+        flexcomImr |= regs->FLEX_US_IER;
+        regs->FLEX_US_IER = 0U;
+    }
+
+    if ((regs->FLEX_US_CR & FLEX_US_CR_RSTSTA_Msk) != 0U)
+    {
+        flexcomOverrun = false;
+        flexcomRxErrors = 0U;
+    }
+
+    if ((regs->FLEX_US_CR & FLEX_US_CR_STTTO_Msk) != 0U)
+    {
+        flexcomTimeoutArmed = true;
+        flexcomTimeoutWaitChar = true;
+        flexcomTimeout = false;
+        flexcomIdleChars = 0U;
+    }
+
+    regs->FLEX_US_CR = 0U;
+
+    if (regs->FLEX_US_RTOR != 0U)
+    {
+        flexcomTimeoutChars = (regs->FLEX_US_RTOR + FLEXCOM_HOST_CHAR_BITS - 1U) / FLEXCOM_HOST_CHAR_BITS;
+    }
+
+    /* Writing a receive counter clears ENDRX */
+    if ((regs->FLEX_RCR != flexcomRcr) || (regs->FLEX_RNCR != flexcomRncr))
+    {
+        flexcomEndRx = false;
+    }
+
+    flexcomRcr = regs->FLEX_RCR;
+    flexcomRncr = regs->FLEX_RNCR;
+
+    if (flexcomEndRx == true)
+    {
+        csr |= FLEX_US_CSR_ENDRX_Msk;
+    }
+
+    if (flexcomTimeout == true)
+    {
+        csr |= FLEX_US_CSR_TIMEOUT_Msk;
+    }
+
+    if (flexcomOverrun == true)
+    {
+        csr |= FLEX_US_CSR_OVRE_Msk;
+    }
+
+    csr |= flexcomRxErrors;
+
+    if ((regs->FLEX_TCR == 0U) && (regs->FLEX_TNCR == 0U))
+    {
+        csr |= FLEX_US_CSR_TXBUFE_Msk;
+    }
+
+    /* Read-only registers of the device, written by the model */
+    *(uint32_t *)(uintptr_t)&regs->FLEX_US_CSR = csr;
+    *(uint32_t *)(uintptr_t)&regs->FLEX_US_IMR = flexcomImr;
+}
+
+static void lFLEXCOM_HostReceive(uint8_t rxChar)
+{
+    flexcom_registers_t *regs = &hostFlexcomRegs;
+
+    /* The character is stored as received, with the error flagged */
+    flexcomRxErrors |= flexcomLineError;
+    flexcomLineError = 0U;
+
+    if ((regs->FLEX_RCR == 0U) && (regs->FLEX_RNCR != 0U))
+    {
+        regs->FLEX_RPR = regs->FLEX_RNPR;
+        regs->FLEX_RCR = regs->FLEX_RNCR;
+        regs->FLEX_RNCR = 0U;
+    }
+
+    if (regs->FLEX_RCR == 0U)
+    {
+        /* PDC receiver stopped: character lost */
+        flexcomLostBytes++;
+        flexcomOverrun = true;
+    }
+    else
+    {
+        *FLEXCOM_HOST_PDC_POINTER(regs->FLEX_RPR) = rxChar;
+        regs->FLEX_RPR++;
+        regs->FLEX_RCR--;
+        if (regs->FLEX_RCR == 0U)
+        {
+            flexcomEndRx = true;
+            if (regs->FLEX_RNCR != 0U)
+            {
+                regs->FLEX_RPR = regs->FLEX_RNPR;
+                regs->FLEX_RCR = regs->FLEX_RNCR;
+                regs->FLEX_RNCR = 0U;
+            }
+        }
+    }
+
+    flexcomRcr = regs->FLEX_RCR;
+    flexcomRncr = regs->FLEX_RNCR;
+
+    /* Time-out counts from the first character after STTTO */
+    flexcomTimeoutWaitChar = false;
+    flexcomIdleChars = 0U;
+}
+
+static int lFLEXCOM_HostTransmit(void)
+{
+    flexcom_registers_t *regs = &hostFlexcomRegs;
+    int txChar;
+
+    if (regs->FLEX_TCR == 0U)
+    {
+        return -1;
+    }
+
+    txChar = *FLEXCOM_HOST_PDC_POINTER(regs->FLEX_TPR);
+    regs->FLEX_TPR++;
+    regs->FLEX_TCR--;
+    if ((regs->FLEX_TCR == 0U) && (regs->FLEX_TNCR != 0U))
+    {
+        regs->FLEX_TPR = regs->FLEX_TNPR;
+        regs->FLEX_TCR = regs->FLEX_TNCR;
+        regs->FLEX_TNCR = 0U;
+    }
+
+    return txChar;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Host Models Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void *HOST_PDC_Alloc(size_t size)
+{
+    void *pData;
+
+    /* PDC pointer registers are 32-bit wide */
+    pData = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+    if (pData == MAP_FAILED)
+    {
+        perror("HOST_PDC_Alloc");
+        exit(EXIT_FAILURE);
+    }
+
+    return pData;
+}
+
+void HOST_PDC_Initialize(void (*handler)(uint32_t index), uint32_t index, uint32_t rxTimeout)
+{
+    flexcomHandler = handler;
+    flexcomIndex = index;
+    flexcomIrqMasked = false;
+    flexcomImr = 0U;
+    flexcomEndRx = false;
+    flexcomOverrun = false;
+    flexcomRxErrors = 0U;
+    flexcomLineError = 0U;
+    flexcomRcr = hostFlexcomRegs.FLEX_RCR;
+    flexcomRncr = hostFlexcomRegs.FLEX_RNCR;
+    flexcomTimeoutChars = (rxTimeout + FLEXCOM_HOST_CHAR_BITS - 1U) / FLEXCOM_HOST_CHAR_BITS;
+    flexcomTimeoutArmed = false;
+    flexcomTimeoutWaitChar = false;
+    flexcomTimeout = false;
+    flexcomIdleChars = 0U;
+    flexcomLostBytes = 0U;
+    flexcomInterrupts = 0U;
+}
+
+void HOST_PDC_Interrupts(void)
+{
+    uint32_t calls = 0U;
+
+    lFLEXCOM_HostApply();
+    while ((flexcomIrqMasked == false) && ((hostFlexcomRegs.FLEX_US_CSR & flexcomImr) != 0U))
+    {
+        if (++calls > FLEXCOM_HOST_IRQ_LIMIT)
+        {
+            fprintf(stderr, "HOST_PDC_Interrupts: interrupt not cleared (CSR 0x%08X)\n",
+                    (unsigned int)(hostFlexcomRegs.FLEX_US_CSR & flexcomImr));
+            exit(EXIT_FAILURE);
+        }
+
+        flexcomInterrupts++;
+        flexcomHandler(flexcomIndex);
+        lFLEXCOM_HostApply();
+    }
+}
+
+void HOST_PDC_MaskInterrupts(bool mask)
+{
+    flexcomIrqMasked = mask;
+    HOST_PDC_Interrupts();
+}
+
+int HOST_PDC_Tick(int rxChar)
+{
+    int txChar;
+
+    lFLEXCOM_HostApply();
+
+    if (rxChar >= 0)
+    {
+        lFLEXCOM_HostReceive((uint8_t)rxChar);
+    }
+    else if ((flexcomTimeoutArmed == true) && (flexcomTimeoutWaitChar == false) &&
+             (flexcomTimeout == false))
+    {
+        if (++flexcomIdleChars >= flexcomTimeoutChars)
+        {
+            flexcomTimeout = true;
+        }
+    }
+
+    txChar = lFLEXCOM_HostTransmit();
+
+    HOST_PDC_Interrupts();
+    return txChar;
+}
+
+void HOST_PDC_SetLineError(uint32_t error)
+{
+    flexcomLineError = error & (FLEX_US_CSR_FRAME_Msk | FLEX_US_CSR_PARE_Msk);
+}
+
+uint32_t HOST_PDC_GetLostBytes(void)
+{
+    return flexcomLostBytes;
+}
+
+uint32_t HOST_PDC_GetInterrupts(void)
+{
+    return flexcomInterrupts;
+}
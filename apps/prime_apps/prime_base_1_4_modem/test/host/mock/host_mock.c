@@ -0,0 +1,160 @@
+/*******************************************************************************
+  Host Models Implementation
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    host_mock.c
+
+  Summary:
+    Memory kept across boots and power cuts of the host models.
+
+  Description:
+    Each boot of the device runs in a child process, so the RAM of the
+    services is lost as in a reset. Flash, User Signature, backup registers and
+    virtual time are allocated in memory shared with the parent process.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Enough for the FU region and the User Signature */
+#define HOST_NVM_SIZE    (4UL * 1024UL * 1024UL)
+
+typedef struct
+{
+    size_t used;
+    uint8_t data[];
+} HOST_NVM;
+
+static HOST_NVM *hostNvm;
+
+static uint64_t hostCutAt = HOST_BOOT_NO_CUT;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Host Models Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void *HOST_NvmAlloc(size_t size)
+{
+    void *pData;
+
+    if (hostNvm == NULL)
+    {
+        hostNvm = mmap(NULL, HOST_NVM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (hostNvm == MAP_FAILED)
+        {
+            perror("HOST_NvmAlloc");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    size = (size + 15U) & ~(size_t)15U;
+    if ((hostNvm->used + size) > (HOST_NVM_SIZE - sizeof(HOST_NVM)))
+    {
+        fprintf(stderr, "HOST_NvmAlloc: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    pData = &hostNvm->data[hostNvm->used];
+    hostNvm->used += size;
+    return pData;
+}
+
+int HOST_Boot(HOST_BOOT_FUNC boot, uintptr_t context, uint64_t cutAt)
+{
+    pid_t pid;
+    int status;
+    unsigned int seed = (unsigned int)rand();
+
+    (void)fflush(stdout);
+    pid = fork();
+    if (pid < 0)
+    {
+        perror("HOST_Boot");
+        exit(EXIT_FAILURE);
+    }
+
+    if (pid == 0)
+    {
+        srand(seed);
+        hostCutAt = cutAt;
+        status = boot(context);
+
+        /* Reset at the end of the boot: flash commands in progress are cut */
+        HOST_SEFC0_PowerCut();
+        HOST_MEMORY_PowerCut();
+        (void)fflush(stdout);
+        _exit(status);
+    }
+
+    if ((waitpid(pid, &status, 0) != pid) || (WIFEXITED(status) == 0))
+    {
+        fprintf(stderr, "HOST_Boot: boot process crashed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return WEXITSTATUS(status);
+}
+
+void HOST_JumpToApplication(void)
+{
+    (void)fflush(stdout);
+    _exit(HOST_BOOT_APPLICATION);
+}
+
+void HOST_BootTimeCheck(uint64_t next)
+{
+    if (next >= hostCutAt)
+    {
+        HOST_TIME_Set(hostCutAt);
+        HOST_SEFC0_PowerCut();
+        HOST_MEMORY_PowerCut();
+        (void)fflush(stdout);
+        _exit(HOST_BOOT_POWER_CUT);
+    }
+}
@@ -0,0 +1,404 @@
+/*******************************************************************************
+  Host Models Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    host_mock.h
+
+  Summary:
+    Control interface of the host models of the peripherals.
+
+  Description:
+    The services under test run on the host over models of the peripheral
+    libraries (TC0, SEFC0, SUPC, TRNG, FLEXCOM7 USART), the memory driver, the
+    FLEXCOM PDC and the PL460 PLC transceiver. This file defines the interface
+    used by the tests to drive the models: virtual time, interrupts, serial
+    line, flash contents, power cuts, PLC frames and the counters of the
+    operations.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+#ifndef HOST_MOCK_H
+#define HOST_MOCK_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "device.h"
+#include "system/int/sys_int.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Frequency of the TC0 counter used by SYS_TIME (same as the device) */
+#define HOST_TIME_FREQUENCY          1562500U
+
+/* Exit status of a boot ended by a power cut (see HOST_Boot) */
+#define HOST_BOOT_POWER_CUT          100
+
+/* Exit status of a boot ended by the jump to the application */
+#define HOST_BOOT_APPLICATION        101
+
+/* No power cut programmed */
+#define HOST_BOOT_NO_CUT             UINT64_MAX
+
+/* Size of the User Signature model, indexed by SEFC_USERSIGNATURE_BLOCK
+   (BLOCK_0 is 1) and page */
+#define HOST_SEFC0_US_BLOCKS         7U
+#define HOST_SEFC0_US_PAGES          8U
+
+/* Bytes of each transmitted frame kept in the PL460 transmission log */
+#define HOST_PL460_TX_DATA_SIZE      32U
+
+/* Transmissions kept in the PL460 transmission log */
+#define HOST_PL460_TX_LOG_SIZE       64U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Counters of the SEFC0 operations */
+typedef struct
+{
+    /* User Signature block erases */
+    uint32_t erases;
+    /* User Signature page programs */
+    uint32_t writes;
+    /* Main flash erases of 16 pages */
+    uint32_t flashErases;
+    /* Main flash page programs */
+    uint32_t flashWrites;
+    /* 128-bit ECC units programmed again without an erase */
+    uint32_t eccRewrites;
+    /* Commands issued while the flash was busy */
+    uint32_t busyCommands;
+    /* Accesses without read or write rights */
+    uint32_t rightsErrors;
+} HOST_SEFC0_STATS;
+
+/* Counters of the memory driver operations */
+typedef struct
+{
+    /* Erased sectors */
+    uint32_t erases;
+    /* Programmed pages */
+    uint32_t writes;
+    /* Pages programmed over bytes not erased */
+    uint32_t doublePrograms;
+    /* Commands out of the media */
+    uint32_t errors;
+} HOST_MEMORY_STATS;
+
+/* Counters of the PL460 model */
+typedef struct
+{
+    /* SPI transfers and bytes, including the 4-byte headers */
+    uint32_t spiTransfers;
+    uint32_t spiBytes;
+    /* External interrupts served */
+    uint32_t interrupts;
+    /* Transmission requests (TX0_PAR/TX1_PAR writes), cancels included */
+    uint32_t txRequests;
+    /* Reads of the timer alone (PLC_ID_TIME_REF_ID) */
+    uint32_t timeReads;
+    /* PIB reads and writes (REG_INFO commands) */
+    uint32_t pibReads;
+    uint32_t pibWrites;
+    /* Transmission requests or PIB accesses while a PIB write completes */
+    uint32_t guardViolations;
+    /* Frames received from the line */
+    uint32_t rxFrames;
+    /* Received frames overwritten in the PL460 before they were read */
+    uint32_t rxOverwritten;
+    /* Firmware uploads */
+    uint32_t boots;
+} HOST_PL460_STATS;
+
+/* Frame of the PL460 transmission log, added when confirmed */
+typedef struct
+{
+    /* Time of the start and the end of the frame in the line (TC0 counts) */
+    uint64_t start;
+    uint64_t end;
+    /* Start time in the PL460 timer (us) */
+    uint32_t timeIni;
+    uint16_t dataLength;
+    uint8_t bufferId;
+    /* DRV_PLC_PHY_TX_RESULT */
+    uint8_t result;
+    uint8_t data[HOST_PL460_TX_DATA_SIZE];
+} HOST_PL460_TX;
+
+typedef int (*HOST_BOOT_FUNC)(uintptr_t context);
+
+/* Handler of the interrupt of a model */
+typedef void (*HOST_INT_HANDLER)(void);
+
+/* Event of a model, run when the virtual time reaches it */
+typedef void (*HOST_TIME_EVENT)(void);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Virtual time and power cuts
+// *****************************************************************************
+// *****************************************************************************
+
+/* Advances the TC0 counter, running the SYS_TIME interrupts on the way */
+void HOST_TIME_AdvanceCounts(uint32_t counts);
+
+void HOST_TIME_AdvanceUS(uint32_t us);
+
+/* Virtual time in TC0 counts since the first boot */
+uint64_t HOST_TIME_Get(void);
+
+void HOST_TIME_Set(uint64_t counts);
+
+/* Runs event when the virtual time reaches at (TC0 counts), whatever the
+   interrupt masks: it is a change in a device. Setting an event again moves
+   it */
+void HOST_TIME_EventSet(HOST_TIME_EVENT event, uint64_t at);
+
+void HOST_TIME_EventCancel(HOST_TIME_EVENT event);
+
+/* CPU time of each read of the TC0 counter, so that busy waits on SYS_TIME
+   end (0 by default) */
+void HOST_TIME_SetReadCost(uint32_t counts);
+
+/* Memory kept across boots: flash, User Signature, backup registers and
+   virtual time */
+void *HOST_NvmAlloc(size_t size);
+
+/* Runs a boot of the device in a child process, so RAM is lost at the end.
+   When the virtual time reaches cutAt, the flash operations in progress are
+   damaged and the boot ends with HOST_BOOT_POWER_CUT. Otherwise, returns the
+   value returned by boot */
+int HOST_Boot(HOST_BOOT_FUNC boot, uintptr_t context, uint64_t cutAt);
+
+/* Called by the time model before moving the counter to next. If the power
+   cut time is reached, the counter stops there and the boot ends */
+void HOST_BootTimeCheck(uint64_t next);
+
+/* Jump of the bootloader to the application: the boot ends with
+   HOST_BOOT_APPLICATION */
+void HOST_JumpToApplication(void) __attribute__((noreturn));
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interrupts
+// *****************************************************************************
+// *****************************************************************************
+
+/* The interrupt of source can be taken now: interrupts, the source and
+   BASEPRI are not masking it */
+bool HOST_INT_IsEnabled(INT_SOURCE source);
+
+/* Interrupt of source pending while masked: handler runs as soon as it is
+   unmasked, as in the NVIC */
+void HOST_INT_Pend(INT_SOURCE source, HOST_INT_HANDLER handler);
+
+uint32_t HOST_INT_GetBasePri(void);
+
+void HOST_INT_SetBasePri(uint32_t basePri);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SEFC0 flash controller
+// *****************************************************************************
+// *****************************************************************************
+
+/* Erases the User Signature and the main flash and clears the counters */
+void HOST_SEFC0_Reset(void);
+
+/* Main flash, kept across boots. It is mapped at IFLASH0_ADDR, as the
+   bootloader reads it through pointers. Call it before the first boot */
+uint8_t *HOST_SEFC0_FlashMap(void);
+
+/* The next 128-bit unit writes end with a flash error and do not program
+   anything */
+void HOST_SEFC0_SetUnitWriteFaults(uint32_t number);
+
+void HOST_SEFC0_GetStats(HOST_SEFC0_STATS *stats);
+
+/* Ends the command in progress: completed if its time is over, damaged
+   otherwise */
+void HOST_SEFC0_PowerCut(void);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Memory driver (FU region of the internal flash)
+// *****************************************************************************
+// *****************************************************************************
+
+/* Fills the media and clears the counters */
+void HOST_MEMORY_Reset(uint8_t value);
+
+void HOST_MEMORY_GetStats(HOST_MEMORY_STATS *stats);
+
+/* The given page write (counted from the reset as in writes of
+   HOST_MEMORY_STATS) programs half of the page and ends with error */
+void HOST_MEMORY_FailWrite(uint32_t write);
+
+/* Ends the command in progress if its time is over (driver task) */
+void HOST_MEMORY_Tasks(void);
+
+/* A write or erase is in progress in the flash */
+bool HOST_MEMORY_IsFlashBusy(void);
+
+/* Ends the command in progress: blocks done are kept, the block in progress
+   is damaged */
+void HOST_MEMORY_PowerCut(void);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: FLEXCOM7 USART (ring buffer PLIB)
+// *****************************************************************************
+// *****************************************************************************
+
+void HOST_FLEXCOM7_Reset(void);
+
+/* Data received from the line. Returns the bytes stored in the receive ring,
+   the rest are lost as in an overrun */
+size_t HOST_FLEXCOM7_Receive(const uint8_t *data, size_t length);
+
+/* Data sent to the line. Returns the bytes taken from the transmit ring, or
+   the bytes already sent at line rate if a baud rate is set */
+size_t HOST_FLEXCOM7_Transmit(uint8_t *data, size_t length);
+
+/* Sends the transmit ring at baudRate (8N1) in virtual time. 0 (default after
+   reset) leaves the line to HOST_FLEXCOM7_Transmit */
+void HOST_FLEXCOM7_SetBaudRate(uint32_t baudRate);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: FLEXCOM USART with PDC (DMA transport)
+// *****************************************************************************
+// *****************************************************************************
+
+extern flexcom_registers_t hostFlexcomRegs;
+
+/* Memory reachable by the 32-bit PDC pointers */
+void *HOST_PDC_Alloc(size_t size);
+
+/* Resets the model. handler is the FLEXCOM interrupt handler, rxTimeout the
+   receiver time-out in characters */
+void HOST_PDC_Initialize(void (*handler)(uint32_t index), uint32_t index, uint32_t rxTimeout);
+
+/* Runs the pending interrupts, after the registers are written */
+void HOST_PDC_Interrupts(void);
+
+/* Interrupt latency: while masked, the handler is not called */
+void HOST_PDC_MaskInterrupts(bool mask);
+
+/* One character time of the line: receives rxChar (-1: idle line) and
+   returns the character sent (-1: none) */
+int HOST_PDC_Tick(int rxChar);
+
+/* Line error (FLEX_US_CSR_FRAME_Msk and/or FLEX_US_CSR_PARE_Msk) of the
+   next character received */
+void HOST_PDC_SetLineError(uint32_t error);
+
+/* Bytes received with the PDC receiver stopped */
+uint32_t HOST_PDC_GetLostBytes(void);
+
+/* Calls to the interrupt handler */
+uint32_t HOST_PDC_GetInterrupts(void);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: PL460 PLC transceiver (HAL and boot of the PLC PHY driver)
+// *****************************************************************************
+// *****************************************************************************
+
+/* PL460 timer (us), driven by the virtual time */
+uint32_t HOST_PL460_GetTime(void);
+
+/* Frame received from the line, ending now. Its data is signaled at once and
+   its parameters some time later, as in the device. A frame not read yet is
+   overwritten */
+void HOST_PL460_Receive(const uint8_t *data, uint16_t length);
+
+/* PL460 timer value at the start of the last received frame */
+uint32_t HOST_PL460_GetRxStart(void);
+
+/* Frequency offset of the PL460 clock to the host clock from now on (ppm) */
+void HOST_PL460_SetClockPpm(double ppm);
+
+/* Reset of the device (e.g. watchdog): the firmware must be uploaded again */
+void HOST_PL460_Reset(void);
+
+/* Firmware uploaded and running (called by the boot model) */
+void HOST_PL460_Boot(void);
+
+/* Result of the next signal captures */
+void HOST_PL460_SetCapture(uint8_t numFrags, uint32_t durationUS);
+
+/* Content of a PIB in the device. Returns false for unknown PIBs */
+bool HOST_PL460_GetPib(uint16_t id, void *pData, uint16_t length);
+
+/* Value of a PIB in the device (e.g. computed by its firmware) */
+bool HOST_PL460_SetPib(uint16_t id, const void *pData, uint16_t length);
+
+/* Reads of a PIB get no response, so the driver times out (PLC_ID_END_ID:
+   all PIBs respond) */
+void HOST_PL460_SetPibNoResponse(uint16_t id);
+
+void HOST_PL460_GetStats(HOST_PL460_STATS *stats);
+
+/* Transmission log, in order of confirmation */
+uint32_t HOST_PL460_GetTxCount(void);
+
+const HOST_PL460_TX *HOST_PL460_GetTx(uint32_t index);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: TRNG, SUPC and debug output
+// *****************************************************************************
+// *****************************************************************************
+
+void HOST_TRNG_Seed(uint32_t seed);
+
+void HOST_DEBUG_Clear(void);
+
+/* Messages since the last clear, concatenated */
+const char *HOST_DEBUG_GetOutput(void);
+
+uint32_t HOST_DEBUG_GetCount(void);
+
+#endif // HOST_MOCK_H
@@ -0,0 +1,124 @@
+/*******************************************************************************
+  PLC Boot Host Model
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_plc_boot.c
+
+  Summary:
+    Host model of the upload of the PL460 firmware.
+
+  Description:
+    The firmware is not uploaded byte by byte: the boot takes the time of the
+    upload and then starts the PL460 model. A hard restart uploads the
+    firmware again, a soft restart keeps it running.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include "configuration.h"
+#include "driver/plc/common/drv_plc_boot.h"
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Upload of the firmware (about 60 kB at 8 MHz) and start-up of the PL460 */
+#define PLC_BOOT_HOST_COUNTS   ((HOST_TIME_FREQUENCY / 1000U) * 100U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static DRV_PLC_BOOT_STATUS plcBootStatus;
+static uint64_t plcBootEnd;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lPLC_BOOT_Start(void)
+{
+    HOST_PL460_Reset();
+    plcBootEnd = HOST_TIME_Get() + PLC_BOOT_HOST_COUNTS;
+    plcBootStatus = DRV_PLC_BOOT_STATUS_PROCESING;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void DRV_PLC_BOOT_Start(DRV_PLC_BOOT_INFO *pBootInfo, DRV_PLC_HAL_INTERFACE *pHal)
+{
+    (void)pBootInfo;
+    (void)pHal;
+
+    lPLC_BOOT_Start();
+}
+
+void DRV_PLC_BOOT_Tasks(void)
+{
+    if ((plcBootStatus == DRV_PLC_BOOT_STATUS_PROCESING) && (HOST_TIME_Get() >= plcBootEnd))
+    {
+        HOST_PL460_Boot();
+        plcBootStatus = DRV_PLC_BOOT_STATUS_READY;
+    }
+}
+
+DRV_PLC_BOOT_STATUS DRV_PLC_BOOT_Status(void)
+{
+    return plcBootStatus;
+}
+
+void DRV_PLC_BOOT_Restart(DRV_PLC_BOOT_RESTART_MODE mode)
+{
+    if (mode == DRV_PLC_BOOT_RESTART_SOFT)
+    {
+        /* Firmware still running */
+        HOST_TIME_AdvanceUS(200U);
+    }
+    else
+    {
+        lPLC_BOOT_Start();
+    }
+}
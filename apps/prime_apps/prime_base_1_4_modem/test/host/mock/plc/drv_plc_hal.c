@@ -0,0 +1,1029 @@
+/*******************************************************************************
+  PL460 PLC Transceiver Host Model
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_plc_hal.c
+
+  Summary:
+    Host model of the PL460 behind the HAL of the PLC PHY driver.
+
+  Description:
+    The model answers the SPI commands of the driver as the PHY firmware of the
+    PL460 does: status, transmission parameters and confirmations, reception
+    parameters and data, and register (PIB) accesses. Events are signaled in
+    the flags of every transfer and with the external interrupt, which is held
+    while disabled in the HAL or masked in the core.
+
+    Transmissions take the time of a frame in the line and are confirmed when
+    they end. A buffer can be cancelled and a frame overlapping the other
+    buffer is rejected with BUSY_TX. Received frames are kept in a single
+    buffer of the device, as in the firmware, so a frame not read before the
+    next one is lost. Each SPI transfer takes 1 us per byte (8 MHz clock). PIB
+    writes start the guard time of the driver, and transmissions or PIB
+    accesses during that time are counted as violations.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "configuration.h"
+#include "driver/plc/phy/drv_plc_phy.h"
+#include "driver/plc/phy/drv_plc_phy_local_comm.h"
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Times of the PHY firmware in us. Assumed values, not taken from the
+   datasheet */
+#define PL460_HOST_RX_PAR_US           100U
+#define PL460_HOST_REG_RSP_US          50U
+#define PL460_HOST_CANCEL_US           20U
+
+/* Frame time in us: chirp and header of a type A frame, and DBPSK symbols of
+   12 bytes */
+#define PL460_HOST_FRAME_HEADER_US     6528U
+#define PL460_HOST_SYMBOL_US           2240U
+#define PL460_HOST_SYMBOL_BYTES        12U
+
+/* Transmission parameters before the data in TXn_PAR_ID */
+#define PL460_HOST_TX_PAR_SIZE         12U
+
+/* Default signal capture */
+#define PL460_HOST_CAPTURE_FRAGS       4U
+#define PL460_HOST_CAPTURE_US          20000U
+
+/* Zero crossing period in us (50 Hz) */
+#define PL460_HOST_ZC_PERIOD_US        20000U
+
+/* PIB storage: PHY parameters (REG) and register areas */
+#define PL460_HOST_REG_PIBS            ((uint32_t)PLC_ID_END_ID - (uint32_t)PLC_ID_PRODID)
+#define PL460_HOST_REG_PIB_SIZE        512U
+#define PL460_HOST_AREA_SIZE           0x1000U
+
+#define PL460_HOST_TIME_NONE           UINT64_MAX
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    /* Frame programmed or in the line, until confirmed */
+    bool busy;
+    uint64_t start;
+    uint64_t end;
+    uint32_t timeIni;
+    uint16_t dataLength;
+    uint8_t frameType;
+    uint8_t data[HOST_PL460_TX_DATA_SIZE];
+    /* Confirmation pending to be signaled (cancel or error) */
+    uint64_t cfmAt;
+    uint8_t cfmResult;
+} PL460_HOST_TX_BUFFER;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* PIO controller of the external interrupt pin */
+pio_registers_t hostPioRegs;
+
+static HOST_PL460_STATS pl460Stats;
+static HOST_PL460_TX pl460TxLog[HOST_PL460_TX_LOG_SIZE];
+static uint32_t pl460TxLogCount;
+
+/* Device state: firmware running and event flags */
+static bool pl460Booted;
+static uint16_t pl460Flags;
+
+/* External interrupt: enabled in the HAL, held while disabled */
+static bool pl460ExtIntEnabled;
+static bool pl460ExtIntHeld;
+
+/* SPI time not advanced yet, in 1/16 TC0 counts */
+static uint32_t pl460SpiCarry;
+
+/* Transmission */
+static PL460_HOST_TX_BUFFER pl460Tx[2];
+static uint8_t pl460TxCfm[2][PLC_CMF_PKT_SIZE];
+
+/* Reception: last frame, parameters signaled at rxParAt */
+static uint8_t pl460RxData[PLC_DATA_PKT_SIZE];
+static uint8_t pl460RxPar[PLC_RX_PAR_SIZE];
+static uint16_t pl460RxLength;
+static uint64_t pl460RxParAt = PL460_HOST_TIME_NONE;
+
+/* Register access: response signaled at regRspAt */
+static uint8_t pl460RegRsp[PLC_REG_PKT_SIZE];
+static uint16_t pl460RegRspLength;
+static uint64_t pl460RegRspAt = PL460_HOST_TIME_NONE;
+
+/* End of the guard time of the last PIB write */
+static uint64_t pl460GuardEnd;
+
+/* PIBs */
+static uint8_t pl460Reg[PL460_HOST_REG_PIBS][PL460_HOST_REG_PIB_SIZE];
+static uint8_t pl460Adc[PL460_HOST_AREA_SIZE];
+static uint8_t pl460Dac[PL460_HOST_AREA_SIZE];
+static uint8_t pl460Fuses[PL460_HOST_AREA_SIZE];
+
+/* PL460 clock: frequency offset to the host clock since clockRef (ppm), and
+   drift accumulated until then (us) */
+static double pl460ClockPpm;
+static double pl460ClockDriftUs;
+static uint64_t pl460ClockRef;
+
+/* Timer value at the start of the last received frame */
+static uint32_t pl460RxStart;
+
+/* PIB whose reads get no response (PLC_ID_END_ID: none) */
+static uint16_t pl460PibNoResponse = (uint16_t)PLC_ID_END_ID;
+
+/* Signal capture */
+static uint8_t pl460CaptureFrags = PL460_HOST_CAPTURE_FRAGS;
+static uint32_t pl460CaptureUS = PL460_HOST_CAPTURE_US;
+static uint64_t pl460CaptureEnd = PL460_HOST_TIME_NONE;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint64_t lPL460_USToCounts(uint32_t us)
+{
+    return (((uint64_t)us * 25U) + 15U) / 16U;
+}
+
+static double lPL460_ClockDrift(uint64_t counts)
+{
+    return pl460ClockDriftUs +
+           (((double)(int64_t)(counts - pl460ClockRef) * 16.0 * pl460ClockPpm) / 25.0e6);
+}
+
+static uint32_t lPL460_Time(uint64_t counts)
+{
+    uint32_t time = (uint32_t)((counts * 16U) / 25U);
+
+    if ((pl460ClockPpm != 0.0) || (pl460ClockDriftUs != 0.0))
+    {
+        /* Delays of the model events are kept in host time */
+        time += (uint32_t)(int64_t)lPL460_ClockDrift(counts);
+    }
+
+    return time;
+}
+
+static void lPL460_PutLE32(uint8_t *pDst, uint32_t value)
+{
+    pDst[0] = (uint8_t)value;
+    pDst[1] = (uint8_t)(value >> 8);
+    pDst[2] = (uint8_t)(value >> 16);
+    pDst[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t lPL460_GetLE32(const uint8_t *pSrc)
+{
+    return (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8) |
+           ((uint32_t)pSrc[2] << 16) | ((uint32_t)pSrc[3] << 24);
+}
+
+static void lPL460_ExtIntHandler(void)
+{
+    pl460Stats.interrupts++;
+    DRV_PLC_PHY_ExternalInterruptHandler((PIO_PIN)DRV_PLC_EXT_INT_PIN, 0);
+}
+
+static void lPL460_Interrupt(void)
+{
+    if (pl460ExtIntEnabled == false)
+    {
+        /* Served when enabled in the HAL */
+        pl460ExtIntHeld = true;
+    }
+    else if (HOST_INT_IsEnabled(DRV_PLC_EXT_INT_SRC) == false)
+    {
+        HOST_INT_Pend(DRV_PLC_EXT_INT_SRC, lPL460_ExtIntHandler);
+    }
+    else
+    {
+        lPL460_ExtIntHandler();
+    }
+}
+
+static void lPL460_Signal(uint16_t flag)
+{
+    pl460Flags |= flag;
+    lPL460_Interrupt();
+}
+
+static uint32_t lPL460_GuardUS(uint16_t id)
+{
+    /* Same guard times as the driver */
+    switch (id)
+    {
+        case PLC_ID_CHANNEL_CFG:
+            return 5500U;
+
+        case PLC_ID_PREDIST_COEF_TABLE_HI:
+        case PLC_ID_PREDIST_COEF_TABLE_LO:
+        case PLC_ID_PREDIST_COEF_TABLE_HI_2:
+        case PLC_ID_PREDIST_COEF_TABLE_LO_2:
+            return 1000U;
+
+        case PLC_ID_PREDIST_COEF_TABLE_VLO:
+        case PLC_ID_PREDIST_COEF_TABLE_VLO_2:
+            return 2000U;
+
+        default:
+            return 50U;
+    }
+}
+
+static void lPL460_Event(void);
+
+static void lPL460_Schedule(void)
+{
+    uint64_t next = PL460_HOST_TIME_NONE;
+    uint8_t idx;
+
+    for (idx = 0; idx < 2U; idx++)
+    {
+        if ((pl460Tx[idx].cfmAt < next))
+        {
+            next = pl460Tx[idx].cfmAt;
+        }
+
+        if ((pl460Tx[idx].busy == true) && (pl460Tx[idx].end < next))
+        {
+            next = pl460Tx[idx].end;
+        }
+    }
+
+    if (pl460RxParAt < next)
+    {
+        next = pl460RxParAt;
+    }
+
+    if (pl460RegRspAt < next)
+    {
+        next = pl460RegRspAt;
+    }
+
+    if (pl460CaptureEnd < next)
+    {
+        next = pl460CaptureEnd;
+    }
+
+    if (next == PL460_HOST_TIME_NONE)
+    {
+        HOST_TIME_EventCancel(lPL460_Event);
+    }
+    else
+    {
+        HOST_TIME_EventSet(lPL460_Event, next);
+    }
+}
+
+static void lPL460_TxConfirm(uint8_t idx, uint8_t result)
+{
+    PL460_HOST_TX_BUFFER *tx = &pl460Tx[idx];
+    HOST_PL460_TX *log;
+    uint8_t *pCfm = pl460TxCfm[idx];
+
+    /* rmsCalc, timeIni, frameType, result, bufferId */
+    (void) memset(pCfm, 0, PLC_CMF_PKT_SIZE);
+    lPL460_PutLE32(pCfm, (result == (uint8_t)DRV_PLC_PHY_TX_RESULT_SUCCESS) ? 1234U : 0U);
+    lPL460_PutLE32(&pCfm[4], tx->timeIni);
+    pCfm[8] = tx->frameType;
+    pCfm[9] = result;
+    pCfm[10] = idx;
+
+    if (pl460TxLogCount < HOST_PL460_TX_LOG_SIZE)
+    {
+        log = &pl460TxLog[pl460TxLogCount];
+        log->start = tx->start;
+        log->end = tx->end;
+        log->timeIni = tx->timeIni;
+        log->dataLength = tx->dataLength;
+        log->bufferId = idx;
+        log->result = result;
+        (void) memcpy(log->data, tx->data, sizeof(log->data));
+    }
+
+    pl460TxLogCount++;
+
+    tx->busy = false;
+    tx->cfmAt = PL460_HOST_TIME_NONE;
+    lPL460_Signal((idx == 0U) ? DRV_PLC_PHY_EV_FLAG_TX0_CFM_MASK : DRV_PLC_PHY_EV_FLAG_TX1_CFM_MASK);
+}
+
+static void lPL460_Event(void)
+{
+    uint64_t now = HOST_TIME_Get();
+    uint8_t idx;
+
+    /* Confirmations in order of time */
+    for (idx = 0; idx < 2U; idx++)
+    {
+        if (pl460Tx[idx].cfmAt <= now)
+        {
+            lPL460_TxConfirm(idx, pl460Tx[idx].cfmResult);
+        }
+        else if ((pl460Tx[idx].busy == true) && (pl460Tx[idx].end <= now))
+        {
+            lPL460_TxConfirm(idx, (uint8_t)DRV_PLC_PHY_TX_RESULT_SUCCESS);
+        }
+        else
+        {
+            /* Not done yet */
+        }
+    }
+
+    if (pl460RxParAt <= now)
+    {
+        pl460RxParAt = PL460_HOST_TIME_NONE;
+        lPL460_Signal(DRV_PLC_PHY_EV_FLAG_RX_PAR_MASK);
+    }
+
+    if (pl460RegRspAt <= now)
+    {
+        pl460RegRspAt = PL460_HOST_TIME_NONE;
+        lPL460_Signal(DRV_PLC_PHY_EV_FLAG_REG_MASK);
+    }
+
+    if (pl460CaptureEnd <= now)
+    {
+        uint8_t *pStatus = pl460Reg[PLC_ID_SIGNAL_CAPTURE_STATUS - PLC_ID_PRODID];
+
+        pl460CaptureEnd = PL460_HOST_TIME_NONE;
+        pStatus[0] = pl460CaptureFrags;
+        pStatus[1] = (uint8_t)SIGNAL_CAPTURE_READY;
+    }
+
+    lPL460_Schedule();
+}
+
+static void lPL460_TxRequest(uint8_t idx, const uint8_t *pData, uint16_t length)
+{
+    PL460_HOST_TX_BUFFER *tx = &pl460Tx[idx];
+    PL460_HOST_TX_BUFFER *other = &pl460Tx[idx ^ 1U];
+    uint64_t now = HOST_TIME_Get();
+    uint32_t nowPlc = lPL460_Time(now);
+    uint32_t timeIni = lPL460_GetLE32(pData);
+    uint16_t dataLength = (uint16_t)pData[4] | ((uint16_t)pData[5] << 8);
+    uint8_t mode = pData[10];
+    int32_t delay;
+    uint32_t duration;
+
+    pl460Stats.txRequests++;
+
+    if ((mode & TX_MODE_CANCEL) != 0U)
+    {
+        if (tx->busy == true)
+        {
+            /* Confirmed as cancelled, even if already in the line */
+            tx->cfmAt = now + lPL460_USToCounts(PL460_HOST_CANCEL_US);
+            tx->cfmResult = (uint8_t)DRV_PLC_PHY_TX_RESULT_CANCELLED;
+            lPL460_Schedule();
+        }
+
+        return;
+    }
+
+    if ((tx->busy == true) || (tx->cfmAt != PL460_HOST_TIME_NONE))
+    {
+        /* Buffer in use: the driver only programs confirmed buffers */
+        return;
+    }
+
+    if ((mode & TX_MODE_RELATIVE) != 0U)
+    {
+        timeIni += nowPlc;
+    }
+
+    delay = (int32_t)(timeIni - nowPlc);
+    duration = PL460_HOST_FRAME_HEADER_US +
+               (((uint32_t)dataLength + PL460_HOST_SYMBOL_BYTES - 1U) / PL460_HOST_SYMBOL_BYTES) *
+               PL460_HOST_SYMBOL_US;
+
+    tx->busy = true;
+    tx->timeIni = timeIni;
+    tx->start = now + lPL460_USToCounts((delay > 0) ? (uint32_t)delay : 0U);
+    tx->end = tx->start + lPL460_USToCounts(duration);
+    tx->dataLength = dataLength;
+    tx->frameType = pData[9];
+    (void) memset(tx->data, 0, sizeof(tx->data));
+    (void) memcpy(tx->data, &pData[PL460_HOST_TX_PAR_SIZE], (dataLength < sizeof(tx->data)) ? dataLength : sizeof(tx->data));
+    tx->cfmAt = PL460_HOST_TIME_NONE;
+
+    if (delay < 0)
+    {
+        /* Absolute time in the past */
+        tx->cfmAt = now;
+        tx->cfmResult = (uint8_t)DRV_PLC_PHY_TX_RESULT_TIMEOUT;
+    }
+    else if ((other->busy == true) && (other->cfmAt == PL460_HOST_TIME_NONE) &&
+             (tx->start < other->end) && (other->start < tx->end))
+    {
+        /* Overlaps the frame of the other buffer */
+        tx->cfmAt = now;
+        tx->cfmResult = (uint8_t)DRV_PLC_PHY_TX_RESULT_BUSY_TX;
+    }
+    else
+    {
+        /* Confirmed at the end of the frame */
+    }
+
+    lPL460_Schedule();
+}
+
+static uint8_t *lPL460_Pib(uint32_t address, uint16_t length)
+{
+    uint32_t offset = address & DRV_PLC_PHY_REG_OFFSET_MASK;
+
+    if ((address & DRV_PLC_PHY_REG_BASE) != 0U)
+    {
+        if ((offset >= PL460_HOST_REG_PIBS) || (length > PL460_HOST_REG_PIB_SIZE))
+        {
+            return NULL;
+        }
+
+        return pl460Reg[offset];
+    }
+
+    if ((offset + length) > PL460_HOST_AREA_SIZE)
+    {
+        return NULL;
+    }
+
+    switch (address & ~(uint32_t)DRV_PLC_PHY_REG_OFFSET_MASK)
+    {
+        case DRV_PLC_PHY_REG_ADC_BASE:
+            return &pl460Adc[offset];
+
+        case DRV_PLC_PHY_REG_DAC_BASE:
+            return &pl460Dac[offset];
+
+        case DRV_PLC_PHY_FUSES_BASE:
+            return &pl460Fuses[offset];
+
+        default:
+            return NULL;
+    }
+}
+
+static void lPL460_RegRead(uint32_t address, uint16_t length)
+{
+    uint16_t id = (uint16_t)(PLC_ID_PRODID + (address & DRV_PLC_PHY_REG_OFFSET_MASK));
+    uint8_t *pib = lPL460_Pib(address, length);
+    uint32_t now = lPL460_Time(HOST_TIME_Get());
+
+    pl460Stats.pibReads++;
+
+    if ((pib == NULL) || (((address & DRV_PLC_PHY_REG_BASE) != 0U) && (id == pl460PibNoResponse)))
+    {
+        /* No response: the driver times out */
+        return;
+    }
+
+    if ((address & DRV_PLC_PHY_REG_BASE) != 0U)
+    {
+        if (id == (uint16_t)PLC_ID_ZC_TIME)
+        {
+            lPL460_PutLE32(pib, now - (now % PL460_HOST_ZC_PERIOD_US));
+        }
+        else if (id == (uint16_t)PLC_ID_SIGNAL_CAPTURE_DATA)
+        {
+            uint8_t fragment = pl460Reg[PLC_ID_SIGNAL_CAPTURE_FRAGMENT - PLC_ID_PRODID][0];
+            uint16_t idx;
+
+            /* Known pattern, different in each fragment */
+            for (idx = 0; idx < length; idx++)
+            {
+                pib[idx] = (uint8_t)((fragment * 31U) + idx);
+            }
+        }
+        else
+        {
+            /* Stored value */
+        }
+    }
+
+    (void) memcpy(pl460RegRsp, pib, length);
+    pl460RegRspLength = length;
+    pl460RegRspAt = HOST_TIME_Get() + lPL460_USToCounts(PL460_HOST_REG_RSP_US);
+    lPL460_Schedule();
+}
+
+static void lPL460_RegWrite(uint32_t address, const uint8_t *pData, uint16_t length)
+{
+    uint16_t id = (uint16_t)(PLC_ID_PRODID + (address & DRV_PLC_PHY_REG_OFFSET_MASK));
+    uint8_t *pib = lPL460_Pib(address, length);
+
+    pl460Stats.pibWrites++;
+
+    if (pib == NULL)
+    {
+        return;
+    }
+
+    (void) memcpy(pib, pData, length);
+
+    if ((address & DRV_PLC_PHY_REG_BASE) != 0U)
+    {
+        pl460GuardEnd = HOST_TIME_Get() + lPL460_USToCounts(lPL460_GuardUS(id));
+
+        if (id == (uint16_t)PLC_ID_SIGNAL_CAPTURE_START)
+        {
+            uint8_t *pStatus = pl460Reg[PLC_ID_SIGNAL_CAPTURE_STATUS - PLC_ID_PRODID];
+
+            pStatus[0] = 0;
+            pStatus[1] = (uint8_t)SIGNAL_CAPTURE_RUNNING;
+            pl460CaptureEnd = HOST_TIME_Get() + lPL460_USToCounts(pl460CaptureUS);
+            lPL460_Schedule();
+        }
+    }
+    else
+    {
+        pl460GuardEnd = HOST_TIME_Get() + lPL460_USToCounts(50U);
+    }
+}
+
+static void lPL460_RegCommand(const uint8_t *pData, uint16_t length)
+{
+    uint32_t address;
+    uint16_t cmdLength;
+    uint16_t pibLength;
+
+    if (length < 6U)
+    {
+        return;
+    }
+
+    address = ((uint32_t)pData[0] << 24) | ((uint32_t)pData[1] << 16) |
+              ((uint32_t)pData[2] << 8) | (uint32_t)pData[3];
+    cmdLength = ((uint16_t)pData[4] << 8) | (uint16_t)pData[5];
+    pibLength = cmdLength & DRV_PLC_PHY_REG_LEN_MASK;
+
+    if ((cmdLength & (1U << 10)) != 0U)
+    {
+        if ((6U + pibLength) <= length)
+        {
+            lPL460_RegWrite(address, &pData[6], pibLength);
+        }
+    }
+    else
+    {
+        lPL460_RegRead(address, pibLength);
+    }
+}
+
+static void lPL460_Read(uint16_t memId, uint8_t *pData, uint16_t length)
+{
+    uint8_t status[PLC_STATUS_LENGTH];
+    const uint8_t *pSrc = NULL;
+    uint16_t size = 0;
+
+    switch (memId)
+    {
+        case STATUS_ID:
+            if (length == 4U)
+            {
+                /* Timer alone (PLC_ID_TIME_REF_ID) */
+                pl460Stats.timeReads++;
+            }
+
+            lPL460_PutLE32(status, lPL460_Time(HOST_TIME_Get()));
+            status[4] = (uint8_t)pl460RxLength;
+            status[5] = (uint8_t)(pl460RxLength >> 8);
+            status[6] = (uint8_t)pl460RegRspLength;
+            status[7] = (uint8_t)(pl460RegRspLength >> 8);
+            pSrc = status;
+            size = PLC_STATUS_LENGTH;
+            break;
+
+        case TX0_CFM_ID:
+        case TX1_CFM_ID:
+        {
+            uint8_t idx = (memId == (uint16_t)TX0_CFM_ID) ? 0U : 1U;
+
+            pSrc = pl460TxCfm[idx];
+            size = PLC_CMF_PKT_SIZE;
+            pl460Flags &= ~((idx == 0U) ? DRV_PLC_PHY_EV_FLAG_TX0_CFM_MASK : DRV_PLC_PHY_EV_FLAG_TX1_CFM_MASK);
+            break;
+        }
+
+        case RX_PAR_ID:
+            pSrc = pl460RxPar;
+            size = PLC_RX_PAR_SIZE;
+            pl460Flags &= ~DRV_PLC_PHY_EV_FLAG_RX_PAR_MASK;
+            break;
+
+        case RX_DAT_ID:
+            pSrc = pl460RxData;
+            size = PLC_DATA_PKT_SIZE;
+            pl460Flags &= ~DRV_PLC_PHY_EV_FLAG_RX_DAT_MASK;
+            break;
+
+        case REG_INFO_ID:
+            pSrc = pl460RegRsp;
+            size = PLC_REG_PKT_SIZE;
+            pl460Flags &= ~DRV_PLC_PHY_EV_FLAG_REG_MASK;
+            pl460RegRspLength = 0;
+            break;
+
+        default:
+            break;
+    }
+
+    (void) memset(pData, 0, length);
+    if (pSrc != NULL)
+    {
+        (void) memcpy(pData, pSrc, (length < size) ? length : size);
+    }
+}
+
+static void lPL460_Write(uint16_t memId, const uint8_t *pData, uint16_t length)
+{
+    if (HOST_TIME_Get() < pl460GuardEnd)
+    {
+        /* Device still applying the last PIB write */
+        pl460Stats.guardViolations++;
+    }
+
+    switch (memId)
+    {
+        case TX0_PAR_ID:
+            lPL460_TxRequest(0, pData, length);
+            break;
+
+        case TX1_PAR_ID:
+            lPL460_TxRequest(1, pData, length);
+            break;
+
+        case REG_INFO_ID:
+            lPL460_RegCommand(pData, length);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void lPL460_SpiTime(uint32_t bytes)
+{
+    uint32_t sixteenths;
+
+    /* 1 us per byte is 25/16 TC0 counts */
+    sixteenths = (bytes * 25U) + pl460SpiCarry;
+    pl460SpiCarry = sixteenths % 16U;
+
+    pl460Stats.spiTransfers++;
+    pl460Stats.spiBytes += bytes;
+
+    HOST_TIME_AdvanceCounts(sixteenths / 16U);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: HAL Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+static void lPL460_HalInit(DRV_PLC_PLIB_INTERFACE *plcPlib)
+{
+    (void)plcPlib;
+
+    pl460ExtIntEnabled = false;
+    SYS_INT_SourceEnable(DRV_PLC_EXT_INT_SRC);
+}
+
+static void lPL460_HalSetup(bool set16Bits)
+{
+    (void)set16Bits;
+}
+
+static void lPL460_HalReset(void)
+{
+    HOST_TIME_AdvanceUS(1550U);
+}
+
+static bool lPL460_HalGetThermalMonitor(void)
+{
+    return false;
+}
+
+static void lPL460_HalSetTxEnable(bool enable)
+{
+    (void)enable;
+}
+
+static void lPL460_HalEnableExtInt(bool enable)
+{
+    pl460ExtIntEnabled = enable;
+
+    if ((enable == true) && (pl460ExtIntHeld == true))
+    {
+        pl460ExtIntHeld = false;
+        lPL460_Interrupt();
+    }
+}
+
+static bool lPL460_HalGetPinLevel(SYS_PORT_PIN pin)
+{
+    (void)pin;
+    return true;
+}
+
+static void lPL460_HalDelay(uint32_t delay)
+{
+    HOST_TIME_AdvanceUS(delay);
+}
+
+static void lPL460_HalSendBootCmd(uint16_t cmd, uint32_t addr, uint32_t dataLength, void *pDataWr, void *pDataRd)
+{
+    (void)cmd;
+    (void)addr;
+    (void)pDataWr;
+
+    if (pDataRd != NULL)
+    {
+        (void) memset(pDataRd, 0, dataLength);
+    }
+}
+
+static void lPL460_HalSendWrRdCmd(void *pCmd, void *pInfo)
+{
+    DRV_PLC_HAL_CMD *halCmd = pCmd;
+    DRV_PLC_HAL_INFO *halInfo = pInfo;
+
+    if (pl460Booted == false)
+    {
+        /* Bootloader answers: the firmware is not running */
+        halInfo->key = DRV_PLC_HAL_KEY_BOOT;
+        halInfo->flags = 0;
+        if (halCmd->cmd == DRV_PLC_HAL_CMD_RD)
+        {
+            (void) memset(halCmd->pData, 0, halCmd->length);
+        }
+    }
+    else
+    {
+        if (halCmd->cmd == DRV_PLC_HAL_CMD_WR)
+        {
+            lPL460_Write(halCmd->memId, halCmd->pData, halCmd->length);
+        }
+        else
+        {
+            lPL460_Read(halCmd->memId, halCmd->pData, halCmd->length);
+        }
+
+        /* Flags of the events after the command, as in the device */
+        halInfo->key = DRV_PLC_HAL_KEY_CORTEX;
+        halInfo->flags = pl460Flags;
+    }
+
+    lPL460_SpiTime(4U + halCmd->length);
+}
+
+static DRV_PLC_PLIB_INTERFACE pl460Plib = {
+    .spiClockFrequency = DRV_PLC_SPI_CLK,
+    .ldoPin = DRV_PLC_LDO_EN_PIN,
+    .resetPin = DRV_PLC_RESET_PIN,
+    .extIntPin = DRV_PLC_EXT_INT_PIN,
+    .extIntPio = DRV_PLC_EXT_INT_PIO,
+    .txEnablePin = DRV_PLC_TX_ENABLE_PIN,
+    .thMonPin = DRV_PLC_THMON_PIN,
+};
+
+static DRV_PLC_HAL_INTERFACE pl460Hal = {
+    .plcPlib = &pl460Plib,
+    .init = lPL460_HalInit,
+    .setup = lPL460_HalSetup,
+    .reset = lPL460_HalReset,
+    .getThermalMonitor = lPL460_HalGetThermalMonitor,
+    .setTxEnable = lPL460_HalSetTxEnable,
+    .enableExtInt = lPL460_HalEnableExtInt,
+    .getPinLevel = lPL460_HalGetPinLevel,
+    .delay = lPL460_HalDelay,
+    .sendBootCmd = lPL460_HalSendBootCmd,
+    .sendWrRdCmd = lPL460_HalSendWrRdCmd,
+};
+
+/* PLC driver initialization data (initialization.c in the application) */
+DRV_PLC_PHY_INIT drvPlcPhyInitData = {
+    .plcHal = &pl460Hal,
+    .numClients = DRV_PLC_PHY_CLIENTS_NUMBER_IDX,
+    .plcProfile = DRV_PLC_PHY_PROFILE,
+    .binStartAddress = 0,
+    .binEndAddress = 0,
+    .secure = DRV_PLC_SECURE,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Host Models Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+/* Firmware upload done (see mock/drv_plc_boot.c): device state is cleared */
+void HOST_PL460_Boot(void)
+{
+    pl460Booted = true;
+    pl460Flags = 0;
+    pl460ExtIntHeld = false;
+    (void) memset(pl460Tx, 0, sizeof(pl460Tx));
+    pl460Tx[0].cfmAt = PL460_HOST_TIME_NONE;
+    pl460Tx[1].cfmAt = PL460_HOST_TIME_NONE;
+    pl460RxLength = 0;
+    pl460RxParAt = PL460_HOST_TIME_NONE;
+    pl460RegRspLength = 0;
+    pl460RegRspAt = PL460_HOST_TIME_NONE;
+    pl460CaptureEnd = PL460_HOST_TIME_NONE;
+    pl460GuardEnd = 0;
+    (void) memset(pl460Reg, 0, sizeof(pl460Reg));
+    pl460Stats.boots++;
+    lPL460_Schedule();
+}
+
+void HOST_PL460_Reset(void)
+{
+    pl460Booted = false;
+    pl460Flags = 0;
+    pl460Tx[0].busy = false;
+    pl460Tx[1].busy = false;
+    pl460Tx[0].cfmAt = PL460_HOST_TIME_NONE;
+    pl460Tx[1].cfmAt = PL460_HOST_TIME_NONE;
+    pl460RxParAt = PL460_HOST_TIME_NONE;
+    pl460RegRspAt = PL460_HOST_TIME_NONE;
+    pl460CaptureEnd = PL460_HOST_TIME_NONE;
+    lPL460_Schedule();
+}
+
+uint32_t HOST_PL460_GetTime(void)
+{
+    return lPL460_Time(HOST_TIME_Get());
+}
+
+void HOST_PL460_Receive(const uint8_t *data, uint16_t length)
+{
+    uint8_t *pPar = pl460RxPar;
+    uint32_t duration;
+
+    if (pl460Booted == false)
+    {
+        return;
+    }
+
+    if (length > PLC_DATA_PKT_SIZE)
+    {
+        length = PLC_DATA_PKT_SIZE;
+    }
+
+    pl460Stats.rxFrames++;
+
+    if ((pl460Flags & (DRV_PLC_PHY_EV_FLAG_RX_DAT_MASK | DRV_PLC_PHY_EV_FLAG_RX_PAR_MASK)) != 0U)
+    {
+        /* Previous frame not read yet */
+        pl460Stats.rxOverwritten++;
+    }
+
+    (void) memcpy(pl460RxData, data, length);
+    pl460RxLength = length;
+
+    /* Parameters: type A frame in DBPSK_C, good quality */
+    duration = PL460_HOST_FRAME_HEADER_US +
+               (((uint32_t)length + PL460_HOST_SYMBOL_BYTES - 1U) / PL460_HOST_SYMBOL_BYTES) *
+               PL460_HOST_SYMBOL_US;
+    (void) memset(pl460RxPar, 0, sizeof(pl460RxPar));
+    pl460RxStart = HOST_PL460_GetTime() - duration;
+    lPL460_PutLE32(&pPar[8], pl460RxStart);
+    pPar[PLC_RX_PAR_DATA_LEN_OFFSET] = (uint8_t)length;
+    pPar[PLC_RX_PAR_DATA_LEN_OFFSET + 1U] = (uint8_t)(length >> 8);
+    pPar[18] = (uint8_t)SCHEME_DBPSK_C;
+    pPar[19] = (uint8_t)FRAME_TYPE_A;
+    pPar[21] = 80U;
+    pPar[22] = 100U;
+    pPar[23] = 90U;
+
+    /* Data now, parameters later. Parameters of the previous frame are not
+       signaled any more */
+    pl460Flags &= ~DRV_PLC_PHY_EV_FLAG_RX_PAR_MASK;
+    pl460RxParAt = HOST_TIME_Get() + lPL460_USToCounts(PL460_HOST_RX_PAR_US);
+    lPL460_Schedule();
+    lPL460_Signal(DRV_PLC_PHY_EV_FLAG_RX_DAT_MASK);
+}
+
+uint32_t HOST_PL460_GetRxStart(void)
+{
+    return pl460RxStart;
+}
+
+void HOST_PL460_SetClockPpm(double ppm)
+{
+    uint64_t now = HOST_TIME_Get();
+
+    pl460ClockDriftUs = lPL460_ClockDrift(now);
+    pl460ClockRef = now;
+    pl460ClockPpm = ppm;
+}
+
+void HOST_PL460_SetCapture(uint8_t numFrags, uint32_t durationUS)
+{
+    pl460CaptureFrags = numFrags;
+    pl460CaptureUS = durationUS;
+}
+
+bool HOST_PL460_GetPib(uint16_t id, void *pData, uint16_t length)
+{
+    uint32_t offset = (uint32_t)id - (uint32_t)PLC_ID_PRODID;
+
+    if ((id < (uint16_t)PLC_ID_PRODID) || (offset >= PL460_HOST_REG_PIBS) ||
+        (length > PL460_HOST_REG_PIB_SIZE))
+    {
+        return false;
+    }
+
+    (void) memcpy(pData, pl460Reg[offset], length);
+    return true;
+}
+
+bool HOST_PL460_SetPib(uint16_t id, const void *pData, uint16_t length)
+{
+    uint32_t offset = (uint32_t)id - (uint32_t)PLC_ID_PRODID;
+
+    if ((id < (uint16_t)PLC_ID_PRODID) || (offset >= PL460_HOST_REG_PIBS) ||
+        (length > PL460_HOST_REG_PIB_SIZE))
+    {
+        return false;
+    }
+
+    (void) memcpy(pl460Reg[offset], pData, length);
+    return true;
+}
+
+void HOST_PL460_SetPibNoResponse(uint16_t id)
+{
+    pl460PibNoResponse = id;
+}
+
+void HOST_PL460_GetStats(HOST_PL460_STATS *stats)
+{
+    *stats = pl460Stats;
+}
+
+uint32_t HOST_PL460_GetTxCount(void)
+{
+    return pl460TxLogCount;
+}
+
+const HOST_PL460_TX *HOST_PL460_GetTx(uint32_t index)
+{
+    if (index >= HOST_PL460_TX_LOG_SIZE)
+    {
+        return NULL;
+    }
+
+    return &pl460TxLog[index];
+}
@@ -0,0 +1,92 @@
+/*******************************************************************************
+  PVDD Monitor Host Model
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    srv_pvddmon.c
+
+  Summary:
+    Host model of the PVDD monitor service.
+
+  Description:
+    PVDD is always in the window: the monitor only records the callback and
+    the comparison mode requested by the PAL.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include "configuration.h"
+#include "service/pvddmon/srv_pvddmon.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static SRV_PVDDMON_CALLBACK pvddmonCallback;
+static uintptr_t pvddmonContext;
+static SRV_PVDDMON_CMP_MODE pvddmonMode;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SRV_PVDDMON_Initialize(void)
+{
+    pvddmonCallback = NULL;
+}
+
+void SRV_PVDDMON_Start(SRV_PVDDMON_CMP_MODE cmpMode)
+{
+    pvddmonMode = cmpMode;
+}
+
+void SRV_PVDDMON_Restart(SRV_PVDDMON_CMP_MODE cmpMode)
+{
+    pvddmonMode = cmpMode;
+}
+
+void SRV_PVDDMON_CallbackRegister(SRV_PVDDMON_CALLBACK callback, uintptr_t context)
+{
+    pvddmonCallback = callback;
+    pvddmonContext = context;
+}
+
+bool SRV_PVDDMON_CheckWindow(void)
+{
+    return true;
+}
@@ -0,0 +1,292 @@
+/*******************************************************************************
+  FLEXCOM7 USART Host Model
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plib_flexcom7_usart.c
+
+  Summary:
+    Host model of the FLEXCOM7 USART ring buffer PLIB.
+
+  Description:
+    Same ring buffer sizes as the PLIB. The line side is driven by the tests
+    (HOST_FLEXCOM7_Receive and HOST_FLEXCOM7_Transmit) instead of the
+    interrupt handler, or at line rate in virtual time once a baud rate is
+    set (HOST_FLEXCOM7_SetBaudRate).
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include "peripheral/flexcom/usart/plib_flexcom7_usart.h"
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define FLEXCOM7_USART_READ_BUFFER_SIZE             1024U
+#define FLEXCOM7_USART_WRITE_BUFFER_SIZE            2048U
+
+/* Bytes sent at line rate kept until read by HOST_FLEXCOM7_Transmit */
+#define FLEXCOM7_HOST_LINE_BUFFER_SIZE              65536U
+
+/* Start, 8 data and stop bits */
+#define FLEXCOM7_HOST_BITS_PER_CHAR                 10U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint8_t FLEXCOM7_USART_ReadBuffer[FLEXCOM7_USART_READ_BUFFER_SIZE];
+static uint8_t FLEXCOM7_USART_WriteBuffer[FLEXCOM7_USART_WRITE_BUFFER_SIZE];
+
+static size_t flexcom7RdInIndex;
+static size_t flexcom7RdOutIndex;
+static size_t flexcom7WrInIndex;
+static size_t flexcom7WrOutIndex;
+
+static uint8_t flexcom7LineBuffer[FLEXCOM7_HOST_LINE_BUFFER_SIZE];
+static size_t flexcom7LineInIndex;
+static size_t flexcom7LineOutIndex;
+static uint32_t flexcom7CharCounts;
+static bool flexcom7LineBusy;
+
+static FLEXCOM_USART_RING_BUFFER_CALLBACK flexcom7RdCallback;
+static uintptr_t flexcom7RdContext;
+static FLEXCOM_USART_RING_BUFFER_CALLBACK flexcom7WrCallback;
+static uintptr_t flexcom7WrContext;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lFLEXCOM7_HOST_CharSent(void)
+{
+    if (flexcom7WrOutIndex == flexcom7WrInIndex)
+    {
+        flexcom7LineBusy = false;
+        return;
+    }
+
+    /* Move one character from the transmit ring to the line. The line
+       buffer keeps the newest bytes if the test does not read it */
+    flexcom7LineBuffer[flexcom7LineInIndex] = FLEXCOM7_USART_WriteBuffer[flexcom7WrOutIndex];
+    flexcom7LineInIndex = (flexcom7LineInIndex + 1U) % FLEXCOM7_HOST_LINE_BUFFER_SIZE;
+    flexcom7WrOutIndex = (flexcom7WrOutIndex + 1U) % FLEXCOM7_USART_WRITE_BUFFER_SIZE;
+
+    HOST_TIME_EventSet(lFLEXCOM7_HOST_CharSent, HOST_TIME_Get() + flexcom7CharCounts);
+
+    if (flexcom7WrCallback != NULL)
+    {
+        flexcom7WrCallback(FLEXCOM_USART_EVENT_WRITE_THRESHOLD_REACHED, flexcom7WrContext);
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: FLEXCOM7 USART PLIB Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void FLEXCOM7_USART_Initialize( void )
+{
+    HOST_FLEXCOM7_Reset();
+}
+
+size_t FLEXCOM7_USART_WriteCountGet(void)
+{
+    return (flexcom7WrInIndex + FLEXCOM7_USART_WRITE_BUFFER_SIZE - flexcom7WrOutIndex) % FLEXCOM7_USART_WRITE_BUFFER_SIZE;
+}
+
+size_t FLEXCOM7_USART_Write(uint8_t* pWrBuffer, const size_t size )
+{
+    size_t nBytesWritten = 0;
+
+    while ((nBytesWritten < size) && (FLEXCOM7_USART_WriteFreeBufferCountGet() > 0U))
+    {
+        FLEXCOM7_USART_WriteBuffer[flexcom7WrInIndex] = pWrBuffer[nBytesWritten++];
+        flexcom7WrInIndex = (flexcom7WrInIndex + 1U) % FLEXCOM7_USART_WRITE_BUFFER_SIZE;
+    }
+
+    if ((nBytesWritten > 0U) && (flexcom7CharCounts > 0U) && (flexcom7LineBusy == false))
+    {
+        /* First character goes out after one character time */
+        flexcom7LineBusy = true;
+        HOST_TIME_EventSet(lFLEXCOM7_HOST_CharSent, HOST_TIME_Get() + flexcom7CharCounts);
+    }
+
+    return nBytesWritten;
+}
+
+size_t FLEXCOM7_USART_WriteFreeBufferCountGet(void)
+{
+    return (FLEXCOM7_USART_WRITE_BUFFER_SIZE - 1U) - FLEXCOM7_USART_WriteCountGet();
+}
+
+size_t FLEXCOM7_USART_WriteBufferSizeGet(void)
+{
+    return (FLEXCOM7_USART_WRITE_BUFFER_SIZE - 1U);
+}
+
+bool FLEXCOM7_USART_TransmitComplete(void)
+{
+    return (FLEXCOM7_USART_WriteCountGet() == 0U);
+}
+
+void FLEXCOM7_USART_WriteCallbackRegister( FLEXCOM_USART_RING_BUFFER_CALLBACK callback, uintptr_t context)
+{
+    flexcom7WrCallback = callback;
+    flexcom7WrContext = context;
+}
+
+size_t FLEXCOM7_USART_Read(uint8_t* pRdBuffer, const size_t size)
+{
+    size_t nBytesRead = 0;
+
+    while ((nBytesRead < size) && (flexcom7RdOutIndex != flexcom7RdInIndex))
+    {
+        pRdBuffer[nBytesRead++] = FLEXCOM7_USART_ReadBuffer[flexcom7RdOutIndex];
+        flexcom7RdOutIndex = (flexcom7RdOutIndex + 1U) % FLEXCOM7_USART_READ_BUFFER_SIZE;
+    }
+
+    return nBytesRead;
+}
+
+size_t FLEXCOM7_USART_ReadCountGet(void)
+{
+    return (flexcom7RdInIndex + FLEXCOM7_USART_READ_BUFFER_SIZE - flexcom7RdOutIndex) % FLEXCOM7_USART_READ_BUFFER_SIZE;
+}
+
+size_t FLEXCOM7_USART_ReadFreeBufferCountGet(void)
+{
+    return (FLEXCOM7_USART_READ_BUFFER_SIZE - 1U) - FLEXCOM7_USART_ReadCountGet();
+}
+
+size_t FLEXCOM7_USART_ReadBufferSizeGet(void)
+{
+    return (FLEXCOM7_USART_READ_BUFFER_SIZE - 1U);
+}
+
+void FLEXCOM7_USART_ReadCallbackRegister( FLEXCOM_USART_RING_BUFFER_CALLBACK callback, uintptr_t context)
+{
+    flexcom7RdCallback = callback;
+    flexcom7RdContext = context;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Host Models Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void HOST_FLEXCOM7_Reset(void)
+{
+    flexcom7RdInIndex = 0;
+    flexcom7RdOutIndex = 0;
+    flexcom7WrInIndex = 0;
+    flexcom7WrOutIndex = 0;
+    flexcom7LineInIndex = 0;
+    flexcom7LineOutIndex = 0;
+    flexcom7CharCounts = 0;
+    flexcom7LineBusy = false;
+    HOST_TIME_EventCancel(lFLEXCOM7_HOST_CharSent);
+}
+
+void HOST_FLEXCOM7_SetBaudRate(uint32_t baudRate)
+{
+    if (baudRate == 0U)
+    {
+        flexcom7CharCounts = 0;
+        flexcom7LineBusy = false;
+        HOST_TIME_EventCancel(lFLEXCOM7_HOST_CharSent);
+    }
+    else
+    {
+        flexcom7CharCounts = ((HOST_TIME_FREQUENCY * FLEXCOM7_HOST_BITS_PER_CHAR) + baudRate - 1U) / baudRate;
+    }
+}
+
+size_t HOST_FLEXCOM7_Receive(const uint8_t *data, size_t length)
+{
+    size_t nBytes = 0;
+
+    while ((nBytes < length) && (FLEXCOM7_USART_ReadFreeBufferCountGet() > 0U))
+    {
+        FLEXCOM7_USART_ReadBuffer[flexcom7RdInIndex] = data[nBytes++];
+        flexcom7RdInIndex = (flexcom7RdInIndex + 1U) % FLEXCOM7_USART_READ_BUFFER_SIZE;
+    }
+
+    if ((nBytes > 0U) && (flexcom7RdCallback != NULL))
+    {
+        flexcom7RdCallback(FLEXCOM_USART_EVENT_READ_THRESHOLD_REACHED, flexcom7RdContext);
+    }
+
+    return nBytes;
+}
+
+size_t HOST_FLEXCOM7_Transmit(uint8_t *data, size_t length)
+{
+    size_t nBytes = 0;
+
+    if (flexcom7CharCounts > 0U)
+    {
+        /* Line rate: bytes already sent by the character events */
+        while ((nBytes < length) && (flexcom7LineOutIndex != flexcom7LineInIndex))
+        {
+            data[nBytes++] = flexcom7LineBuffer[flexcom7LineOutIndex];
+            flexcom7LineOutIndex = (flexcom7LineOutIndex + 1U) % FLEXCOM7_HOST_LINE_BUFFER_SIZE;
+        }
+
+        return nBytes;
+    }
+
+    while ((nBytes < length) && (flexcom7WrOutIndex != flexcom7WrInIndex))
+    {
+        data[nBytes++] = FLEXCOM7_USART_WriteBuffer[flexcom7WrOutIndex];
+        flexcom7WrOutIndex = (flexcom7WrOutIndex + 1U) % FLEXCOM7_USART_WRITE_BUFFER_SIZE;
+    }
+
+    if ((nBytes > 0U) && (flexcom7WrCallback != NULL))
+    {
+        flexcom7WrCallback(FLEXCOM_USART_EVENT_WRITE_THRESHOLD_REACHED, flexcom7WrContext);
+    }
+
+    return nBytes;
+}
@@ -0,0 +1,536 @@
+/*******************************************************************************
+  SEFC0 User Signature Host Model
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plib_sefc0.c
+
+  Summary:
+    Host model of the SEFC0 flash controller: User Signature and main flash.
+
+  Description:
+    The User Signature and the main flash are kept across boots. Erase and
+    write commands take time and are damaged by a power cut. Flash
+    programming rules are checked and counted (see HOST_SEFC0_STATS).
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "peripheral/sefc/plib_sefc0.h"
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Command times in TC0 counts. Assumed values (erase 50 ms, write 1.5 ms),
+   not taken from the datasheet */
+#define SEFC0_HOST_ERASE_COUNTS     ((HOST_TIME_FREQUENCY / 1000U) * 50U)
+#define SEFC0_HOST_WRITE_COUNTS     ((HOST_TIME_FREQUENCY / 1000U) * 3U / 2U)
+
+/* Time of each status poll in TC0 counts */
+#define SEFC0_HOST_POLL_COUNTS      2U
+
+/* Size of the 128-bit ECC unit */
+#define SEFC0_HOST_ECC_UNIT_SIZE    16U
+
+/* Main flash erase command: 16 pages */
+#define SEFC0_HOST_ERASE_PAGES      16U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    SEFC0_HOST_OP_NONE,
+    SEFC0_HOST_OP_ERASE,
+    SEFC0_HOST_OP_WRITE,
+    SEFC0_HOST_OP_FLASH_ERASE,
+    SEFC0_HOST_OP_FLASH_WRITE
+} SEFC0_HOST_OP;
+
+typedef struct
+{
+    uint8_t data[HOST_SEFC0_US_BLOCKS][HOST_SEFC0_US_PAGES][IFLASH0_PAGE_SIZE];
+    HOST_SEFC0_STATS stats;
+} SEFC0_HOST_NVM;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static SEFC0_HOST_NVM *sefc0Nvm;
+
+/* Main flash, shared with the boot processes */
+static uint8_t *sefc0Flash;
+
+static uint32_t sefc0Rights;
+static uint32_t sefc0WriteProtection;
+
+/* Command in progress */
+static SEFC0_HOST_OP sefc0Op;
+static uint64_t sefc0OpEnd;
+static uint32_t sefc0OpBlock;
+static uint32_t sefc0OpPage;
+static uint32_t sefc0OpAddress;
+static uint32_t sefc0OpLength;
+static uint8_t sefc0Latch[IFLASH0_PAGE_SIZE];
+
+/* ECC units written in the latch buffer, programmed even if all their bytes
+   are 0xFF */
+static bool sefc0LatchUnits[IFLASH0_PAGE_SIZE / SEFC0_HOST_ECC_UNIT_SIZE];
+
+/* Error flags of the status register since the last PLIB command */
+static uint32_t sefc0Status;
+
+/* 128-bit unit writes that end with a flash error */
+static uint32_t sefc0UnitFaults;
+
+__attribute__((constructor)) static void lSEFC0_HostInit(void)
+{
+    sefc0Nvm = HOST_NvmAlloc(sizeof(SEFC0_HOST_NVM));
+    HOST_SEFC0_Reset();
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static bool lSEFC0_IsErase(void)
+{
+    return ((sefc0Op == SEFC0_HOST_OP_ERASE) || (sefc0Op == SEFC0_HOST_OP_FLASH_ERASE));
+}
+
+static uint8_t *lSEFC0_OpTarget(uint32_t *length)
+{
+    switch (sefc0Op)
+    {
+        case SEFC0_HOST_OP_ERASE:
+            *length = HOST_SEFC0_US_PAGES * IFLASH0_PAGE_SIZE;
+            return &sefc0Nvm->data[sefc0OpBlock][0][0];
+
+        case SEFC0_HOST_OP_FLASH_ERASE:
+            *length = SEFC0_HOST_ERASE_PAGES * IFLASH0_PAGE_SIZE;
+            return &sefc0Flash[sefc0OpAddress];
+
+        case SEFC0_HOST_OP_FLASH_WRITE:
+            *length = IFLASH0_PAGE_SIZE;
+            return &sefc0Flash[sefc0OpAddress];
+
+        default:
+            *length = sefc0OpLength;
+            return &sefc0Nvm->data[sefc0OpBlock][sefc0OpPage][0];
+    }
+}
+
+/* Latch buffer written by the PLIB from the start of the page */
+static void lSEFC0_LatchLoad(const uint8_t *data, uint32_t length)
+{
+    uint32_t unit;
+
+    /* The latch buffer is 0xFF after each write command */
+    (void)memset(sefc0Latch, 0xFF, sizeof(sefc0Latch));
+    (void)memset(sefc0LatchUnits, 0, sizeof(sefc0LatchUnits));
+    (void)memcpy(sefc0Latch, data, length);
+
+    for (unit = 0; (unit * SEFC0_HOST_ECC_UNIT_SIZE) < length; unit++)
+    {
+        sefc0LatchUnits[unit] = true;
+    }
+}
+
+/* Counts the 128-bit ECC units of the latch programmed over programmed
+   ones */
+static void lSEFC0_CheckEcc(const uint8_t *pFlash, uint32_t length)
+{
+    uint32_t unit, index;
+    bool flashData;
+
+    for (unit = 0; unit < length; unit += SEFC0_HOST_ECC_UNIT_SIZE)
+    {
+        flashData = false;
+        for (index = unit; index < (unit + SEFC0_HOST_ECC_UNIT_SIZE); index++)
+        {
+            flashData = flashData || (pFlash[index] != 0xFFU);
+        }
+
+        if ((sefc0LatchUnits[unit / SEFC0_HOST_ECC_UNIT_SIZE] == true) && (flashData == true))
+        {
+            sefc0Nvm->stats.eccRewrites++;
+        }
+    }
+}
+
+static void lSEFC0_OpComplete(void)
+{
+    uint32_t length, index;
+    uint8_t *pTarget = lSEFC0_OpTarget(&length);
+
+    if (lSEFC0_IsErase() == true)
+    {
+        (void)memset(pTarget, 0xFF, length);
+    }
+    else if (sefc0Op != SEFC0_HOST_OP_NONE)
+    {
+        for (index = 0; index < length; index++)
+        {
+            pTarget[index] &= sefc0Latch[index];
+        }
+    }
+
+    sefc0Op = SEFC0_HOST_OP_NONE;
+}
+
+static void lSEFC0_OpBegin(SEFC0_HOST_OP op)
+{
+    if ((sefc0Op != SEFC0_HOST_OP_NONE) || (HOST_MEMORY_IsFlashBusy() == true))
+    {
+        /* The controller does not queue commands: the previous one is
+         * aborted. The model lets it end and counts the error */
+        sefc0Nvm->stats.busyCommands++;
+        if (sefc0Op != SEFC0_HOST_OP_NONE)
+        {
+            lSEFC0_OpComplete();
+        }
+    }
+
+    sefc0Op = op;
+    sefc0Status = 0;
+    sefc0OpEnd = HOST_TIME_Get() + ((lSEFC0_IsErase() == true) ? SEFC0_HOST_ERASE_COUNTS : SEFC0_HOST_WRITE_COUNTS);
+}
+
+static bool lSEFC0_OpStart(SEFC0_HOST_OP op, uint32_t block, uint32_t page)
+{
+    if ((block == 0U) || (block >= HOST_SEFC0_US_BLOCKS) || (page >= HOST_SEFC0_US_PAGES) ||
+        ((sefc0Rights & (SEFC_EEFC_USR_WRENUSB0_Msk << block)) == 0U))
+    {
+        sefc0Nvm->stats.rightsErrors++;
+        return false;
+    }
+
+    lSEFC0_OpBegin(op);
+    sefc0OpBlock = block;
+    sefc0OpPage = page;
+    return true;
+}
+
+static void lSEFC0_UserSignatureProgram(uint32_t block, uint32_t page, uint32_t length)
+{
+    if (lSEFC0_OpStart(SEFC0_HOST_OP_WRITE, block, page) == false)
+    {
+        return;
+    }
+
+    sefc0OpLength = length;
+    sefc0Nvm->stats.writes++;
+
+    /* Each ECC unit can only be programmed once after erase */
+    lSEFC0_CheckEcc(&sefc0Nvm->data[block][page][0], sefc0OpLength);
+}
+
+static bool lSEFC0_FlashOffset(uint32_t address, uint32_t *offset)
+{
+    if ((sefc0Flash == NULL) || (address < IFLASH0_ADDR) || (address >= (IFLASH0_ADDR + IFLASH0_SIZE)))
+    {
+        sefc0Nvm->stats.rightsErrors++;
+        return false;
+    }
+
+    *offset = address - IFLASH0_ADDR;
+    return true;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SEFC0 PLIB Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SEFC0_UserSignatureRightsSet(uint32_t userSignatureRights)
+{
+    sefc0Rights = userSignatureRights;
+}
+
+uint32_t SEFC0_UserSignatureRightsGet(void)
+{
+    return sefc0Rights;
+}
+
+bool SEFC0_UserSignatureRead(uint32_t *data, uint32_t length, SEFC_USERSIGNATURE_BLOCK block, SEFC_USERSIGNATURE_PAGE page)
+{
+    if (((uint32_t)block == 0U) || ((uint32_t)block >= HOST_SEFC0_US_BLOCKS) ||
+        ((uint32_t)page >= HOST_SEFC0_US_PAGES) || (length > (IFLASH0_PAGE_SIZE >> 2)) ||
+        ((sefc0Rights & (SEFC_EEFC_USR_RDENUSB0_Msk << (uint32_t)block)) == 0U))
+    {
+        sefc0Nvm->stats.rightsErrors++;
+        return false;
+    }
+
+    if ((sefc0Op != SEFC0_HOST_OP_NONE) || (HOST_MEMORY_IsFlashBusy() == true))
+    {
+        sefc0Nvm->stats.busyCommands++;
+    }
+
+    (void)memcpy(data, &sefc0Nvm->data[block][page][0], length << 2);
+    return true;
+}
+
+bool SEFC0_UserSignatureWrite(void *data, uint32_t length, SEFC_USERSIGNATURE_BLOCK block, SEFC_USERSIGNATURE_PAGE page)
+{
+    if (length > (IFLASH0_PAGE_SIZE >> 2))
+    {
+        return false;
+    }
+
+    /* The latch buffer is written in 64-bit words (length in 32-bit words),
+     * from the start of the page */
+    lSEFC0_LatchLoad(data, (length >> 1) << 3);
+    lSEFC0_UserSignatureProgram((uint32_t)block, (uint32_t)page, (length >> 1) << 3);
+
+    return true;
+}
+
+bool SEFC0_UserSignatureUnitWrite(uint32_t *data, uint32_t offset, SEFC_USERSIGNATURE_BLOCK block, SEFC_USERSIGNATURE_PAGE page)
+{
+    if (((offset & (SEFC0_HOST_ECC_UNIT_SIZE - 1U)) != 0U) || (offset >= IFLASH0_PAGE_SIZE))
+    {
+        return false;
+    }
+
+    /* Only this unit is loaded in the latch buffer */
+    (void)memset(sefc0Latch, 0xFF, sizeof(sefc0Latch));
+    (void)memset(sefc0LatchUnits, 0, sizeof(sefc0LatchUnits));
+    (void)memcpy(&sefc0Latch[offset], data, SEFC0_HOST_ECC_UNIT_SIZE);
+    sefc0LatchUnits[offset / SEFC0_HOST_ECC_UNIT_SIZE] = true;
+
+    if (sefc0UnitFaults > 0U)
+    {
+        /* Nothing programmed */
+        sefc0UnitFaults--;
+        sefc0Status = SEFC_EEFC_FSR_FLERR_Msk;
+        return true;
+    }
+
+    lSEFC0_UserSignatureProgram((uint32_t)block, (uint32_t)page, IFLASH0_PAGE_SIZE);
+    return true;
+}
+
+void SEFC0_UserSignatureErase(SEFC_USERSIGNATURE_BLOCK block)
+{
+    if (lSEFC0_OpStart(SEFC0_HOST_OP_ERASE, (uint32_t)block, 0U) == true)
+    {
+        sefc0Nvm->stats.erases++;
+    }
+}
+
+bool SEFC0_PageErase(uint32_t address)
+{
+    uint32_t offset;
+
+    if (lSEFC0_FlashOffset(address, &offset) == false)
+    {
+        return false;
+    }
+
+    /* 16 pages, from the first one of the group */
+    lSEFC0_OpBegin(SEFC0_HOST_OP_FLASH_ERASE);
+    sefc0OpAddress = offset & ~((SEFC0_HOST_ERASE_PAGES * IFLASH0_PAGE_SIZE) - 1U);
+    sefc0Nvm->stats.flashErases++;
+    return true;
+}
+
+bool SEFC0_PageWrite(uint32_t *data, uint32_t address)
+{
+    uint32_t offset;
+
+    if (lSEFC0_FlashOffset(address, &offset) == false)
+    {
+        return false;
+    }
+
+    lSEFC0_LatchLoad((const uint8_t *)data, IFLASH0_PAGE_SIZE);
+    lSEFC0_OpBegin(SEFC0_HOST_OP_FLASH_WRITE);
+    sefc0OpAddress = offset & ~(IFLASH0_PAGE_SIZE - 1U);
+    sefc0Nvm->stats.flashWrites++;
+    lSEFC0_CheckEcc(&sefc0Flash[sefc0OpAddress], IFLASH0_PAGE_SIZE);
+    return true;
+}
+
+void SEFC0_RegionUnlock(uint32_t address)
+{
+    /* Lock bits not modeled */
+    (void)address;
+}
+
+bool SEFC0_IsBusy(void)
+{
+    /* Status polls take time, so busy waits end */
+    HOST_TIME_AdvanceCounts(SEFC0_HOST_POLL_COUNTS);
+    HOST_MEMORY_Tasks();
+
+    if ((sefc0Op != SEFC0_HOST_OP_NONE) && (HOST_TIME_Get() >= sefc0OpEnd))
+    {
+        lSEFC0_OpComplete();
+    }
+
+    return (sefc0Op != SEFC0_HOST_OP_NONE) || (HOST_MEMORY_IsFlashBusy() == true);
+}
+
+SEFC_ERROR SEFC0_ErrorGet(void)
+{
+    return (SEFC_ERROR)sefc0Status;
+}
+
+void SEFC0_WriteProtectionSet(uint32_t mode)
+{
+    sefc0WriteProtection = mode;
+}
+
+uint32_t SEFC0_WriteProtectionGet(void)
+{
+    return sefc0WriteProtection;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Host Models Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void HOST_SEFC0_Reset(void)
+{
+    (void)memset(sefc0Nvm, 0xFF, sizeof(sefc0Nvm->data));
+    if (sefc0Flash != NULL)
+    {
+        (void)memset(sefc0Flash, 0xFF, IFLASH0_SIZE);
+    }
+
+    (void)memset(&sefc0Nvm->stats, 0, sizeof(sefc0Nvm->stats));
+    sefc0Op = SEFC0_HOST_OP_NONE;
+    sefc0Status = 0;
+    sefc0UnitFaults = 0;
+}
+
+uint8_t *HOST_SEFC0_FlashMap(void)
+{
+    void *pFlash;
+
+    if (sefc0Flash == NULL)
+    {
+        pFlash = mmap((void *)(uintptr_t)IFLASH0_ADDR, IFLASH0_SIZE, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (pFlash != (void *)(uintptr_t)IFLASH0_ADDR)
+        {
+            perror("HOST_SEFC0_FlashMap");
+            exit(EXIT_FAILURE);
+        }
+
+        sefc0Flash = pFlash;
+        (void)memset(sefc0Flash, 0xFF, IFLASH0_SIZE);
+    }
+
+    return sefc0Flash;
+}
+
+void HOST_SEFC0_SetUnitWriteFaults(uint32_t number)
+{
+    sefc0UnitFaults = number;
+}
+
+void HOST_SEFC0_GetStats(HOST_SEFC0_STATS *stats)
+{
+    *stats = sefc0Nvm->stats;
+}
+
+void HOST_SEFC0_PowerCut(void)
+{
+    uint32_t length, index;
+    uint8_t *pTarget;
+    int damage;
+
+    if (sefc0Op == SEFC0_HOST_OP_NONE)
+    {
+        return;
+    }
+
+    if (HOST_TIME_Get() >= sefc0OpEnd)
+    {
+        lSEFC0_OpComplete();
+        return;
+    }
+
+    /* Each byte keeps its old value, gets the new one or is in between */
+    pTarget = lSEFC0_OpTarget(&length);
+    for (index = 0; index < length; index++)
+    {
+        damage = rand() % 3;
+        if (lSEFC0_IsErase() == true)
+        {
+            if (damage == 0)
+            {
+                pTarget[index] = 0xFFU;
+            }
+            else if (damage == 1)
+            {
+                pTarget[index] |= (uint8_t)rand();
+            }
+        }
+        else
+        {
+            if (damage == 0)
+            {
+                pTarget[index] &= sefc0Latch[index];
+            }
+            else if (damage == 1)
+            {
+                pTarget[index] &= (uint8_t)(sefc0Latch[index] | (uint8_t)rand());
+            }
+        }
+    }
+
+    sefc0Op = SEFC0_HOST_OP_NONE;
+}
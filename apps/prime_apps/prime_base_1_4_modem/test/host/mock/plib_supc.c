@@ -0,0 +1,80 @@
+/*******************************************************************************
+  SUPC Host Model
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plib_supc.c
+
+  Summary:
+    Host model of the general purpose backup registers of the SUPC.
+
+  Description:
+    The backup registers keep their value across boots (see HOST_Boot).
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include "peripheral/supc/plib_supc.h"
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SUPC_HOST_GPBR_NUMBER    24U
+
+static uint32_t *supcGpbr;
+
+__attribute__((constructor)) static void lSUPC_HostInit(void)
+{
+    supcGpbr = HOST_NvmAlloc(SUPC_HOST_GPBR_NUMBER * sizeof(uint32_t));
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SUPC PLIB Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+uint32_t SUPC_GPBRRead(GPBR_REGS_INDEX reg)
+{
+    return supcGpbr[(uint32_t)reg % SUPC_HOST_GPBR_NUMBER];
+}
+
+void SUPC_GPBRWrite(GPBR_REGS_INDEX reg, uint32_t data)
+{
+    supcGpbr[(uint32_t)reg % SUPC_HOST_GPBR_NUMBER] = data;
+}
@@ -0,0 +1,350 @@
+/*******************************************************************************
+  TC0 Host Model
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plib_tc0.c
+
+  Summary:
+    Host model of the TC0 channel 0 timer used by SYS_TIME.
+
+  Description:
+    32-bit counter at HOST_TIME_FREQUENCY driven by the virtual time of the
+    tests, with the compare interrupt that runs the SYS_TIME timers. The
+    interrupt is held while the TC0 source or the global interrupts are
+    disabled. The time model also runs the events of the other device models
+    (see HOST_TIME_EventSet).
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include "peripheral/tc/plib_tc0.h"
+#include "system/int/sys_int.h"
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TC0_HOST_EVENTS    4U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    HOST_TIME_EVENT event;
+    uint64_t at;
+} TC0_HOST_EVENT;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Virtual time kept across boots, as a free running counter */
+static uint64_t *hostTimeNow;
+
+/* Virtual time of the last start: the software trigger resets the counter */
+static uint64_t tc0StartTime;
+static uint32_t tc0Compare;
+static bool tc0Started;
+static bool tc0Pending;
+static bool tc0InInterrupt;
+static TC_TIMER_CALLBACK tc0Callback;
+static uintptr_t tc0Context;
+
+/* CPU time spent in each counter read */
+static uint32_t tc0ReadCost;
+
+/* Programmed events of the device models */
+static TC0_HOST_EVENT tc0Events[TC0_HOST_EVENTS];
+
+__attribute__((constructor)) static void lTC0_HostInit(void)
+{
+    hostTimeNow = HOST_NvmAlloc(sizeof(uint64_t));
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lTC0_Interrupt(void)
+{
+    if (tc0InInterrupt == true)
+    {
+        /* Served in next time advance */
+        tc0Pending = true;
+        return;
+    }
+
+    if (HOST_INT_IsEnabled(TC0_CH0_IRQn) == false)
+    {
+        /* Served when enabled again */
+        tc0Pending = true;
+        HOST_INT_Pend(TC0_CH0_IRQn, lTC0_Interrupt);
+        return;
+    }
+
+    tc0Pending = false;
+    if (tc0Callback != NULL)
+    {
+        tc0InInterrupt = true;
+        tc0Callback(TC_TIMER_COMPARE_MATCH, tc0Context);
+        tc0InInterrupt = false;
+    }
+}
+
+static uint64_t lTC0_NextEventTime(void)
+{
+    uint64_t at = UINT64_MAX;
+    uint32_t index;
+
+    for (index = 0; index < TC0_HOST_EVENTS; index++)
+    {
+        if ((tc0Events[index].event != NULL) && (tc0Events[index].at < at))
+        {
+            at = tc0Events[index].at;
+        }
+    }
+
+    return at;
+}
+
+static void lTC0_RunEvents(void)
+{
+    HOST_TIME_EVENT event;
+    uint32_t index;
+    bool run = true;
+
+    /* Until no event is due, as an event can program another one */
+    while (run == true)
+    {
+        run = false;
+        for (index = 0; index < TC0_HOST_EVENTS; index++)
+        {
+            event = tc0Events[index].event;
+            if ((event != NULL) && (tc0Events[index].at <= *hostTimeNow))
+            {
+                tc0Events[index].event = NULL;
+                event();
+                run = true;
+            }
+        }
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: TC0 PLIB Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void TC0_CH0_TimerInitialize (void)
+{
+    tc0Started = false;
+    tc0Pending = false;
+    tc0Callback = NULL;
+}
+
+void TC0_CH0_TimerStart (void)
+{
+    tc0StartTime = *hostTimeNow;
+    tc0Started = true;
+}
+
+void TC0_CH0_TimerStop (void)
+{
+    tc0Started = false;
+}
+
+void TC0_CH0_TimerPeriodSet (uint32_t period)
+{
+    /* Free running 32-bit counter */
+    (void)period;
+}
+
+void TC0_CH0_TimerCompareSet (uint32_t compare)
+{
+    tc0Compare = compare;
+}
+
+uint32_t TC0_CH0_TimerFrequencyGet (void)
+{
+    return HOST_TIME_FREQUENCY;
+}
+
+uint32_t TC0_CH0_TimerPeriodGet (void)
+{
+    return 0xFFFFFFFFU;
+}
+
+uint32_t TC0_CH0_TimerCounterGet (void)
+{
+    uint32_t counter = (uint32_t)(*hostTimeNow - tc0StartTime);
+
+    if (tc0ReadCost != 0U)
+    {
+        HOST_TIME_AdvanceCounts(tc0ReadCost);
+    }
+
+    return counter;
+}
+
+void TC0_CH0_TimerCallbackRegister(TC_TIMER_CALLBACK callback, uintptr_t context)
+{
+    tc0Callback = callback;
+    tc0Context = context;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Host Models Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void HOST_TIME_AdvanceCounts(uint32_t counts)
+{
+    uint64_t end = *hostTimeNow + counts;
+    uint64_t next;
+    uint64_t compareAt;
+    uint32_t distance;
+
+    if (tc0Pending == true)
+    {
+        lTC0_Interrupt();
+    }
+
+    lTC0_RunEvents();
+
+    while (*hostTimeNow < end)
+    {
+        next = lTC0_NextEventTime();
+        if (next > end)
+        {
+            next = end;
+        }
+
+        compareAt = UINT64_MAX;
+        if (tc0Started == true)
+        {
+            distance = tc0Compare - (uint32_t)(*hostTimeNow - tc0StartTime);
+            compareAt = *hostTimeNow + ((distance == 0U) ? 0x100000000ULL : distance);
+            if (compareAt < next)
+            {
+                next = compareAt;
+            }
+        }
+
+        HOST_BootTimeCheck(next);
+        *hostTimeNow = next;
+
+        lTC0_RunEvents();
+        if (next == compareAt)
+        {
+            lTC0_Interrupt();
+        }
+    }
+}
+
+void HOST_TIME_AdvanceUS(uint32_t us)
+{
+    HOST_TIME_AdvanceCounts((uint32_t)(((uint64_t)us * HOST_TIME_FREQUENCY) / 1000000U));
+}
+
+uint64_t HOST_TIME_Get(void)
+{
+    return *hostTimeNow;
+}
+
+void HOST_TIME_Set(uint64_t counts)
+{
+    *hostTimeNow = counts;
+}
+
+void HOST_TIME_SetReadCost(uint32_t counts)
+{
+    tc0ReadCost = counts;
+}
+
+void HOST_TIME_EventSet(HOST_TIME_EVENT event, uint64_t at)
+{
+    uint32_t index;
+    uint32_t free = TC0_HOST_EVENTS;
+
+    for (index = 0; index < TC0_HOST_EVENTS; index++)
+    {
+        if (tc0Events[index].event == event)
+        {
+            break;
+        }
+
+        if ((tc0Events[index].event == NULL) && (free == TC0_HOST_EVENTS))
+        {
+            free = index;
+        }
+    }
+
+    if (index == TC0_HOST_EVENTS)
+    {
+        index = free;
+    }
+
+    if (index < TC0_HOST_EVENTS)
+    {
+        tc0Events[index].event = event;
+        tc0Events[index].at = at;
+    }
+}
+
+void HOST_TIME_EventCancel(HOST_TIME_EVENT event)
+{
+    uint32_t index;
+
+    for (index = 0; index < TC0_HOST_EVENTS; index++)
+    {
+        if (tc0Events[index].event == event)
+        {
+            tc0Events[index].event = NULL;
+        }
+    }
+}
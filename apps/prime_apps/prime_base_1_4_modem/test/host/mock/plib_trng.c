@@ -0,0 +1,94 @@
+/*******************************************************************************
+  TRNG Host Model
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plib_trng.c
+
+  Summary:
+    Host model of the True Random Number Generator.
+
+  Description:
+    Deterministic xorshift generator, so test failures can be reproduced from
+    the seed.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include "peripheral/trng/plib_trng.h"
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t trngState = 0x12345678U;
+static bool trngEnabled;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: TRNG PLIB Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void TRNG_Initialize(void)
+{
+    trngEnabled = true;
+}
+
+uint32_t TRNG_ReadData( void )
+{
+    trngState ^= trngState << 13;
+    trngState ^= trngState >> 17;
+    trngState ^= trngState << 5;
+    return trngState;
+}
+
+void TRNG_Enable( void )
+{
+    trngEnabled = true;
+}
+
+void TRNG_Disable( void )
+{
+    trngEnabled = false;
+}
+
+void HOST_TRNG_Seed(uint32_t seed)
+{
+    /* Zero is a fixed point of the generator */
+    trngState = (seed == 0U) ? 0x12345678U : seed;
+}
@@ -0,0 +1,142 @@
+/*******************************************************************************
+  Debug System Service Host Implementation
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    sys_debug.c
+
+  Summary:
+    Debug system service for the host build.
+
+  Description:
+    Keeps the messages up to the global error level in a buffer checked by the
+    tests, instead of sending them to the console.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "system/debug/sys_debug.h"
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_DEBUG_HOST_OUTPUT_SIZE    4096U
+
+static SYS_ERROR_LEVEL gblErrLvl = SYS_ERROR_DEBUG;
+static char sysDebugOutput[SYS_DEBUG_HOST_OUTPUT_SIZE];
+static size_t sysDebugLength;
+static uint32_t sysDebugCount;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lSYS_DEBUG_Append(const char *text)
+{
+    size_t length = strlen(text);
+
+    if (length > (SYS_DEBUG_HOST_OUTPUT_SIZE - 1U - sysDebugLength))
+    {
+        length = SYS_DEBUG_HOST_OUTPUT_SIZE - 1U - sysDebugLength;
+    }
+
+    memcpy(&sysDebugOutput[sysDebugLength], text, length);
+    sysDebugLength += length;
+    sysDebugOutput[sysDebugLength] = '\0';
+    sysDebugCount++;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_DEBUG_ErrorLevelSet(SYS_ERROR_LEVEL level)
+{
+    gblErrLvl = level;
+}
+
+SYS_ERROR_LEVEL SYS_DEBUG_ErrorLevelGet(void)
+{
+    return gblErrLvl;
+}
+
+void SYS_DEBUG_Message(SYS_ERROR_LEVEL level, const char *message)
+{
+    if (level <= gblErrLvl)
+    {
+        lSYS_DEBUG_Append(message);
+    }
+}
+
+void SYS_DEBUG_Print(SYS_ERROR_LEVEL level, const char *format, ...)
+{
+    char text[SYS_CONSOLE_PRINT_BUFFER_SIZE];
+    va_list args;
+
+    if (level <= gblErrLvl)
+    {
+        va_start(args, format);
+        (void)vsnprintf(text, sizeof(text), format, args);
+        va_end(args);
+        lSYS_DEBUG_Append(text);
+    }
+}
+
+void HOST_DEBUG_Clear(void)
+{
+    sysDebugLength = 0;
+    sysDebugOutput[0] = '\0';
+    sysDebugCount = 0;
+}
+
+const char *HOST_DEBUG_GetOutput(void)
+{
+    return sysDebugOutput;
+}
+
+uint32_t HOST_DEBUG_GetCount(void)
+{
+    return sysDebugCount;
+}
@@ -0,0 +1,175 @@
+/*******************************************************************************
+  Interrupt System Service Host Implementation
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    sys_int.c
+
+  Summary:
+    Interrupt system service for the host build.
+
+  Description:
+    Records the global and source interrupt masks and the BASEPRI register.
+    The interrupts of the host models are held while masked and run as soon
+    as they are unmasked, as pending interrupts of the NVIC.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include "system/int/sys_int.h"
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYS_INT_HOST_SOURCES    64U
+
+static bool sysIntEnabled = true;
+static bool sysIntSourceDisabled[SYS_INT_HOST_SOURCES];
+static uint32_t sysIntBasePri;
+
+/* Handlers of the pending interrupts */
+static HOST_INT_HANDLER sysIntPending[SYS_INT_HOST_SOURCES];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void lSYS_INT_RunPending(void)
+{
+    HOST_INT_HANDLER handler;
+    uint32_t source;
+
+    /* Once per source: a handler pending again is run on next unmask */
+    for (source = 0; source < SYS_INT_HOST_SOURCES; source++)
+    {
+        handler = sysIntPending[source];
+        if ((handler != NULL) && (HOST_INT_IsEnabled((INT_SOURCE)source) == true))
+        {
+            sysIntPending[source] = NULL;
+            handler();
+        }
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_INT_Enable( void )
+{
+    sysIntEnabled = true;
+    lSYS_INT_RunPending();
+}
+
+bool SYS_INT_Disable( void )
+{
+    bool processorStatus = sysIntEnabled;
+
+    sysIntEnabled = false;
+    return processorStatus;
+}
+
+bool SYS_INT_IsEnabled( void )
+{
+    return sysIntEnabled;
+}
+
+void SYS_INT_Restore( bool state )
+{
+    sysIntEnabled = state;
+    lSYS_INT_RunPending();
+}
+
+void SYS_INT_SourceEnable( INT_SOURCE source )
+{
+    sysIntSourceDisabled[(uint32_t)source % SYS_INT_HOST_SOURCES] = false;
+    lSYS_INT_RunPending();
+}
+
+bool SYS_INT_SourceDisable( INT_SOURCE source )
+{
+    bool intSrcStatus = SYS_INT_SourceIsEnabled(source);
+
+    sysIntSourceDisabled[(uint32_t)source % SYS_INT_HOST_SOURCES] = true;
+    return intSrcStatus;
+}
+
+bool SYS_INT_SourceIsEnabled( INT_SOURCE source )
+{
+    return !sysIntSourceDisabled[(uint32_t)source % SYS_INT_HOST_SOURCES];
+}
+
+void SYS_INT_SourceRestore( INT_SOURCE source, bool status )
+{
+    sysIntSourceDisabled[(uint32_t)source % SYS_INT_HOST_SOURCES] = !status;
+    lSYS_INT_RunPending();
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Host Models Interface Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+uint32_t HOST_INT_GetBasePri(void)
+{
+    return sysIntBasePri;
+}
+
+void HOST_INT_SetBasePri(uint32_t basePri)
+{
+    sysIntBasePri = basePri;
+    lSYS_INT_RunPending();
+}
+
+bool HOST_INT_IsEnabled(INT_SOURCE source)
+{
+    /* All the interrupts of the models have the same priority, masked by
+       any BASEPRI value */
+    return (sysIntEnabled == true) && (sysIntBasePri == 0U) &&
+           (SYS_INT_SourceIsEnabled(source) == true);
+}
+
+void HOST_INT_Pend(INT_SOURCE source, HOST_INT_HANDLER handler)
+{
+    sysIntPending[(uint32_t)source % SYS_INT_HOST_SOURCES] = handler;
+}
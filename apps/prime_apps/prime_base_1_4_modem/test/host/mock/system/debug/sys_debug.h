@@ -0,0 +1,79 @@
+/*******************************************************************************
+  Host Debug System Service Header
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    sys_debug.h
+
+  Summary:
+    Debug system service interface for the host build.
+
+  Description:
+    Same message levels and macros as system/debug/sys_debug.h. Messages are
+    kept by the host model to be checked by the tests (see host_mock.h).
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+#ifndef SYS_DEBUG_H
+#define SYS_DEBUG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system/system.h"
+#include "configuration.h"
+
+/* Errors that have the potential to cause a system crash. */
+#define SYS_ERROR_FATAL 0
+
+/* Errors that have the potential to cause incorrect behavior. */
+#define SYS_ERROR_ERROR 1
+
+/* Warnings about potentially unexpected behavior or side effects. */
+#define SYS_ERROR_WARNING 2
+
+/* Information helpful to understanding potential errors and warnings. */
+#define SYS_ERROR_INFO 3
+
+/* Verbose information helpful during debugging and testing. */
+#define SYS_ERROR_DEBUG 4
+
+typedef uint32_t SYS_ERROR_LEVEL;
+
+void SYS_DEBUG_ErrorLevelSet(SYS_ERROR_LEVEL level);
+
+SYS_ERROR_LEVEL SYS_DEBUG_ErrorLevelGet(void);
+
+void SYS_DEBUG_Message(SYS_ERROR_LEVEL level, const char *message);
+
+void SYS_DEBUG_Print(SYS_ERROR_LEVEL level, const char *format, ...);
+
+#define SYS_DEBUG_MESSAGE(level, message)    SYS_DEBUG_Message(level, message)
+#define SYS_DEBUG_PRINT(level, fmt, ...)     SYS_DEBUG_Print(level, fmt, ##__VA_ARGS__)
+
+#endif // SYS_DEBUG_H
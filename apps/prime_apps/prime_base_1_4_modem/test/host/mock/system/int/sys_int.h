@@ -0,0 +1,68 @@
+/*******************************************************************************
+  Host Interrupt System Service Header
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    sys_int.h
+
+  Summary:
+    Interrupt system service interface for the host build.
+
+  Description:
+    Same interface as system/int/sys_int.h. Interrupts of the host models are
+    called from the test thread, so the global and source masks are only
+    recorded to check that critical sections are balanced.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+#ifndef SYS_INT_H    // Guards against multiple inclusion
+#define SYS_INT_H
+
+#include <stdbool.h>
+#include "device.h"
+
+typedef IRQn_Type INT_SOURCE;
+
+void SYS_INT_Enable( void );
+
+bool SYS_INT_Disable( void );
+
+bool SYS_INT_IsEnabled( void );
+
+void SYS_INT_Restore( bool state );
+
+void SYS_INT_SourceEnable( INT_SOURCE source );
+
+bool SYS_INT_SourceDisable( INT_SOURCE source );
+
+bool SYS_INT_SourceIsEnabled( INT_SOURCE source );
+
+void SYS_INT_SourceRestore( INT_SOURCE source, bool status );
+
+#endif // SYS_INT_H
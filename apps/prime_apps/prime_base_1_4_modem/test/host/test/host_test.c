@@ -0,0 +1,187 @@
+/*******************************************************************************
+  Host Test Runner
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    host_test.c
+
+  Summary:
+    Runs the test cases of the host build.
+
+  Description:
+    Each test case runs in a child process. Its exit status is the number of
+    failed checks. An argument selects the test cases whose name contains it.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "definitions.h"
+#include "test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_CASES_MAX    128U
+
+typedef struct
+{
+    const char *name;
+    void (*run)(void);
+} TEST_ENTRY;
+
+static TEST_ENTRY testCases[TEST_CASES_MAX];
+static uint32_t testCasesNumber;
+static uint32_t testFailures;
+
+static const SYS_TIME_PLIB_INTERFACE testTimePlibAPI = {
+    .timerCallbackSet = (SYS_TIME_PLIB_CALLBACK_REGISTER)TC0_CH0_TimerCallbackRegister,
+    .timerStart = (SYS_TIME_PLIB_START)TC0_CH0_TimerStart,
+    .timerStop = (SYS_TIME_PLIB_STOP)TC0_CH0_TimerStop ,
+    .timerFrequencyGet = (SYS_TIME_PLIB_FREQUENCY_GET)TC0_CH0_TimerFrequencyGet,
+    .timerPeriodSet = (SYS_TIME_PLIB_PERIOD_SET)TC0_CH0_TimerPeriodSet,
+    .timerCompareSet = (SYS_TIME_PLIB_COMPARE_SET)TC0_CH0_TimerCompareSet,
+    .timerCounterGet = (SYS_TIME_PLIB_COUNTER_GET)TC0_CH0_TimerCounterGet,
+};
+
+static const SYS_TIME_INIT testTimeInitData =
+{
+    .timePlib = &testTimePlibAPI,
+    .hwTimerIntNum = TC0_CH0_IRQn,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test framework interface implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void TEST_Register(const char *name, void (*run)(void))
+{
+    if (testCasesNumber >= TEST_CASES_MAX)
+    {
+        /* A test case that cannot be registered would never run */
+        fprintf(stderr, "too many test cases: %s does not fit in %u entries\n",
+                name, TEST_CASES_MAX);
+        exit(EXIT_FAILURE);
+    }
+
+    testCases[testCasesNumber].name = name;
+    testCases[testCasesNumber].run = run;
+    testCasesNumber++;
+}
+
+void TEST_Fail(const char *file, int line, const char *cond)
+{
+    testFailures++;
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, cond);
+}
+
+void TEST_FailEqual(const char *file, int line, const char *actual,
+                    unsigned long long expected, unsigned long long value)
+{
+    testFailures++;
+    fprintf(stderr, "%s:%d: check failed: %s is %llu (0x%llX), expected %llu (0x%llX)\n",
+            file, line, actual, value, value, expected, expected);
+}
+
+uint32_t TEST_GetFailures(void)
+{
+    return testFailures;
+}
+
+void TEST_TimeInitialize(void)
+{
+    TC0_CH0_TimerInitialize();
+    (void)SYS_TIME_Initialize(SYS_TIME_INDEX_0, (SYS_MODULE_INIT *)&testTimeInitData);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main
+// *****************************************************************************
+// *****************************************************************************
+
+int main(int argc, char **argv)
+{
+    uint32_t index;
+    uint32_t failedCases = 0;
+    uint32_t runCases = 0;
+    pid_t pid;
+    int status;
+
+    for (index = 0; index < testCasesNumber; index++)
+    {
+        if ((argc > 1) && (strstr(testCases[index].name, argv[1]) == NULL))
+        {
+            continue;
+        }
+
+        /* Same models state for every test case */
+        HOST_TIME_Set(0);
+        HOST_SEFC0_Reset();
+        HOST_MEMORY_Reset(0xFFU);
+        srand(index + 1U);
+
+        (void)fflush(stdout);
+        pid = fork();
+        if (pid == 0)
+        {
+            testCases[index].run();
+            (void)fflush(stdout);
+            _exit((testFailures > 255U) ? 255 : (int)testFailures);
+        }
+
+        runCases++;
+        if ((pid < 0) || (waitpid(pid, &status, 0) != pid) ||
+            (WIFEXITED(status) == 0) || (WEXITSTATUS(status) != 0))
+        {
+            failedCases++;
+            printf("FAIL %s\n", testCases[index].name);
+        }
+        else
+        {
+            printf("PASS %s\n", testCases[index].name);
+        }
+    }
+
+    printf("%u test cases, %u failed\n", (unsigned int)runCases, (unsigned int)failedCases);
+    return (failedCases == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
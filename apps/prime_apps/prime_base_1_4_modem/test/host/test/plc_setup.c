@@ -0,0 +1,147 @@
+/*******************************************************************************
+  PLC Test Setup
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plc_setup.c
+
+  Summary:
+    Set-up of the PLC PHY driver on the PL460 model for the host tests.
+
+  Description:
+    Opens the driver as the application does and runs its tasks in virtual
+    time. Shared by the tests of the driver, the PAL and the modem.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include "definitions.h"
+#include "stack/pal/pal_types.h"
+#include "stack/pal/pal_local.h"
+#include "stack/pal/pal_plc.h"
+#include "test.h"
+#include "plc_setup.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static SYS_MODULE_OBJ testPlcPhyObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: PLC set-up
+// *****************************************************************************
+// *****************************************************************************
+
+DRV_HANDLE TEST_PLC_PhyOpen(void)
+{
+    DRV_HANDLE handle;
+    uint32_t index;
+
+    TEST_TimeInitialize();
+    HOST_TIME_SetReadCost(TEST_PLC_READ_COST);
+
+    testPlcPhyObj = DRV_PLC_PHY_Initialize(DRV_PLC_PHY_INDEX, (SYS_MODULE_INIT *)&drvPlcPhyInitData);
+    TEST_ASSERT(testPlcPhyObj != SYS_MODULE_OBJ_INVALID);
+    handle = DRV_PLC_PHY_Open(DRV_PLC_PHY_INDEX, NULL);
+    TEST_ASSERT(handle != DRV_HANDLE_INVALID);
+
+    for (index = 0; (index < 1000U) && (DRV_PLC_PHY_Status(DRV_PLC_PHY_INDEX) != SYS_STATUS_READY); index++)
+    {
+        DRV_PLC_PHY_Tasks(testPlcPhyObj);
+        HOST_TIME_AdvanceUS(1000U);
+    }
+
+    TEST_ASSERT_EQUAL(SYS_STATUS_READY, DRV_PLC_PHY_Status(DRV_PLC_PHY_INDEX));
+    return handle;
+}
+
+void TEST_PLC_PhyRunUntil(const uint32_t *count, uint32_t value, uint32_t timeMs)
+{
+    uint32_t index;
+
+    for (index = 0; (index < (timeMs * 10U)) && (*count < value); index++)
+    {
+        DRV_PLC_PHY_Tasks(testPlcPhyObj);
+        HOST_TIME_AdvanceUS(100U);
+    }
+}
+
+void TEST_PLC_PalOpen(void)
+{
+    uint32_t index;
+
+    TEST_TimeInitialize();
+    HOST_TIME_SetReadCost(TEST_PLC_READ_COST);
+
+    testPlcPhyObj = PAL_PLC_Initialize();
+    TEST_ASSERT(testPlcPhyObj != SYS_MODULE_OBJ_INVALID);
+
+    for (index = 0; (index < 10000U) && (PAL_PLC_Status() != SYS_STATUS_READY); index++)
+    {
+        DRV_PLC_PHY_Tasks(testPlcPhyObj);
+        PAL_PLC_Tasks();
+        HOST_TIME_AdvanceUS(100U);
+    }
+
+    TEST_ASSERT_EQUAL(SYS_STATUS_READY, PAL_PLC_Status());
+}
+
+void TEST_PLC_PalRunUntil(const uint32_t *count, uint32_t value, uint32_t timeMs)
+{
+    uint32_t index;
+
+    for (index = 0; (index < (timeMs * 10U)) && (*count < value); index++)
+    {
+        DRV_PLC_PHY_Tasks(testPlcPhyObj);
+        PAL_PLC_Tasks();
+        HOST_TIME_AdvanceUS(100U);
+    }
+}
+
+void TEST_PLC_Fill(uint8_t *pData, size_t length)
+{
+    uint8_t seed = (uint8_t)rand();
+    size_t index;
+
+    for (index = 0; index < length; index++)
+    {
+        pData[index] = (uint8_t)(seed + (index * 7U));
+    }
+}
@@ -0,0 +1,97 @@
+/*******************************************************************************
+  PLC Test Setup
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plc_setup.h
+
+  Summary:
+    Set-up of the PLC PHY driver on the PL460 model for the host tests.
+
+  Description:
+    Opens the driver as the application does and runs its tasks in virtual
+    time. Shared by the tests of the driver, the PAL and the modem.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+#ifndef PLC_SETUP_H
+#define PLC_SETUP_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include "driver/plc/phy/drv_plc_phy.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Largest PLC frame */
+#define TEST_PLC_FRAME_SIZE          512U
+
+/* Cost of a SYS_TIME counter read (in TC0 counts), so that the busy waits of
+   the driver end */
+#define TEST_PLC_READ_COST           2U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: PLC set-up interface
+// *****************************************************************************
+// *****************************************************************************
+
+/* Initialization data of the driver (PL460 model) */
+extern DRV_PLC_PHY_INIT drvPlcPhyInitData;
+
+/* Initializes SYS_TIME and the driver, and waits for the boot of the
+   PL460 */
+DRV_HANDLE TEST_PLC_PhyOpen(void);
+
+/* Runs the driver tasks every 100 us until a counter reaches a value or the
+   time (ms) elapses */
+void TEST_PLC_PhyRunUntil(const uint32_t *count, uint32_t value, uint32_t timeMs);
+
+/* Initializes SYS_TIME and the PAL PLC, and waits until it is ready */
+void TEST_PLC_PalOpen(void);
+
+/* Runs the driver and PAL tasks every 100 us until a counter reaches a value
+   or the time (ms) elapses */
+void TEST_PLC_PalRunUntil(const uint32_t *count, uint32_t value, uint32_t timeMs);
+
+/* Payload of a PLC frame, different in every call */
+void TEST_PLC_Fill(uint8_t *pData, size_t length);
+
+#endif // PLC_SETUP_H
@@ -0,0 +1,111 @@
+/*******************************************************************************
+  Host Test Framework
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test.h
+
+  Summary:
+    Minimal test framework of the host build.
+
+  Description:
+    Each test case runs in its own process, so it starts with the services
+    and the models in their reset state.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+#ifndef TEST_H
+#define TEST_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "host_mock.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Defines and registers a test case */
+#define TEST_CASE(name)                                                     \
+    static void name(void);                                                 \
+    __attribute__((constructor)) static void name##_Register(void)          \
+    {                                                                       \
+        TEST_Register(#name, name);                                         \
+    }                                                                       \
+    static void name(void)
+
+/* Checks a condition, the test case goes on if it fails */
+#define TEST_ASSERT(cond)                                                   \
+    do                                                                      \
+    {                                                                       \
+        if (!(cond))                                                        \
+        {                                                                   \
+            TEST_Fail(__FILE__, __LINE__, #cond);                           \
+        }                                                                   \
+    } while (0)
+
+#define TEST_ASSERT_EQUAL(expected, actual)                                 \
+    do                                                                      \
+    {                                                                       \
+        unsigned long long testExpected = (unsigned long long)(expected);   \
+        unsigned long long testActual = (unsigned long long)(actual);       \
+        if (testExpected != testActual)                                     \
+        {                                                                   \
+            TEST_FailEqual(__FILE__, __LINE__, #actual, testExpected,       \
+                           testActual);                                     \
+        }                                                                   \
+    } while (0)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test framework interface
+// *****************************************************************************
+// *****************************************************************************
+
+void TEST_Register(const char *name, void (*run)(void));
+void TEST_Fail(const char *file, int line, const char *cond);
+void TEST_FailEqual(const char *file, int line, const char *actual,
+                    unsigned long long expected, unsigned long long value);
+
+/* Failures of the current test case */
+uint32_t TEST_GetFailures(void);
+
+/* TC0 and SYS_TIME initialization, as in initialization.c */
+void TEST_TimeInitialize(void);
+
+#endif // TEST_H
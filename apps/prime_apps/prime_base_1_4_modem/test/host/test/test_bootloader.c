@@ -0,0 +1,383 @@
+/*******************************************************************************
+  Service Bootloader Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_bootloader.c
+
+  Summary:
+    Host tests of the image swap of the PRIME service bootloader.
+
+  Description:
+    Built with the bootloader of prime_service_bootloader on the SEFC0 model.
+    Swaps are interrupted by power cuts at random times: the application and
+    FU regions must end swapped and the swap command cleared.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "app_bootloader.h"
+#include "test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Application region and FU region of prime_base_1_4_modem */
+#define TEST_BOOT_APP_ADDRESS    BOOT_FLASH_APP_FIRMWARE_START_ADDRESS
+#define TEST_BOOT_FU_ADDRESS     0x010A0000UL
+#define TEST_BOOT_REGION_SIZE    0x00060000UL
+
+/* 25 blocks of 16 pages, the last one not complete */
+#define TEST_BOOT_IMAGE_SIZE     200000UL
+#define TEST_BOOT_BLOCKS         ((TEST_BOOT_IMAGE_SIZE + BOOT_FLASH_16PAGE_SIZE - 1U) / BOOT_FLASH_16PAGE_SIZE)
+
+/* Other data in the User Signature page of the boot configuration */
+#define TEST_BOOT_OTHER_DATA     0x5AU
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint8_t testAppImage[TEST_BOOT_BLOCKS * BOOT_FLASH_16PAGE_SIZE];
+static uint8_t testFuImage[TEST_BOOT_BLOCKS * BOOT_FLASH_16PAGE_SIZE];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Helpers
+// *****************************************************************************
+// *****************************************************************************
+
+static void lTEST_PutUint32(uint8_t *pData, uint32_t value)
+{
+    pData[0] = (uint8_t)value;
+    pData[1] = (uint8_t)(value >> 8);
+    pData[2] = (uint8_t)(value >> 16);
+    pData[3] = (uint8_t)(value >> 24);
+}
+
+static void lTEST_WriteConfig(uint32_t imageSize)
+{
+    uint32_t page[BOOT_FLASH_PAGE_SIZE / sizeof(uint32_t)];
+    uint8_t *pPage = (uint8_t *)page;
+
+    (void) memset(page, 0xFF, sizeof(page));
+    (void) memset(pPage, TEST_BOOT_OTHER_DATA, BOOT_CONFIG_OFFSET_USER_SIGN);
+    lTEST_PutUint32(&pPage[BOOT_CONFIG_OFFSET_USER_SIGN], BOOT_CONFIG_KEY);
+    lTEST_PutUint32(&pPage[BOOT_CONFIG_OFFSET_USER_SIGN + 4U], imageSize);
+    lTEST_PutUint32(&pPage[BOOT_CONFIG_OFFSET_USER_SIGN + 8U], TEST_BOOT_FU_ADDRESS);
+    lTEST_PutUint32(&pPage[BOOT_CONFIG_OFFSET_USER_SIGN + 12U], TEST_BOOT_APP_ADDRESS);
+    pPage[BOOT_CONFIG_OFFSET_USER_SIGN + 16U] = 0;
+    pPage[BOOT_CONFIG_OFFSET_USER_SIGN + 17U] = 0;
+
+    /* Written by the application before the reset */
+    SEFC0_UserSignatureRightsSet(SEFC_EEFC_USR_RDENUSB1_Msk | SEFC_EEFC_USR_WRENUSB1_Msk);
+    SEFC0_UserSignatureErase((SEFC_USERSIGNATURE_BLOCK)BOOT_USER_SIGNATURE_BLOCK);
+    while (SEFC0_IsBusy() == true)
+    {
+    }
+
+    (void) SEFC0_UserSignatureWrite(page, BOOT_FLASH_PAGE_SIZE / sizeof(uint32_t),
+                                    (SEFC_USERSIGNATURE_BLOCK)BOOT_USER_SIGNATURE_BLOCK,
+                                    (SEFC_USERSIGNATURE_PAGE)BOOT_USER_SIGNATURE_PAGE);
+    while (SEFC0_IsBusy() == true)
+    {
+    }
+}
+
+/* Two images with samePercent of their blocks equal, in their regions */
+static uint32_t lTEST_Prepare(uint32_t samePercent)
+{
+    uint8_t *pFlash = HOST_SEFC0_FlashMap();
+    uint32_t index, block;
+    uint32_t changed = 0;
+
+    HOST_SEFC0_Reset();
+
+    (void) memset(testAppImage, 0xFF, sizeof(testAppImage));
+    (void) memset(testFuImage, 0xFF, sizeof(testFuImage));
+    for (index = 0; index < TEST_BOOT_IMAGE_SIZE; index++)
+    {
+        testAppImage[index] = (uint8_t)rand();
+        testFuImage[index] = (uint8_t)rand();
+    }
+
+    for (block = 0; block < TEST_BOOT_BLOCKS; block++)
+    {
+        if (((uint32_t)rand() % 100U) < samePercent)
+        {
+            (void) memcpy(&testFuImage[block * BOOT_FLASH_16PAGE_SIZE],
+                          &testAppImage[block * BOOT_FLASH_16PAGE_SIZE], BOOT_FLASH_16PAGE_SIZE);
+        }
+        else
+        {
+            changed++;
+        }
+    }
+
+    (void) memcpy(&pFlash[TEST_BOOT_APP_ADDRESS - IFLASH0_ADDR], testAppImage, sizeof(testAppImage));
+    (void) memcpy(&pFlash[TEST_BOOT_FU_ADDRESS - IFLASH0_ADDR], testFuImage, sizeof(testFuImage));
+    lTEST_WriteConfig(TEST_BOOT_IMAGE_SIZE);
+
+    return changed;
+}
+
+static void lTEST_CheckSwapped(bool otherDataKept)
+{
+    uint32_t page[BOOT_FLASH_PAGE_SIZE / sizeof(uint32_t)];
+    uint8_t *pPage = (uint8_t *)page;
+    uint32_t index;
+
+    TEST_ASSERT(memcmp((uint8_t *)TEST_BOOT_APP_ADDRESS, testFuImage, sizeof(testFuImage)) == 0);
+    TEST_ASSERT(memcmp((uint8_t *)TEST_BOOT_FU_ADDRESS, testAppImage, sizeof(testAppImage)) == 0);
+
+    /* Swap command cleared and key kept. The page is erased to clear the
+       command, so other data is only kept if there is no cut meanwhile. */
+    (void) SEFC0_UserSignatureRead(page, BOOT_FLASH_PAGE_SIZE / sizeof(uint32_t),
+                                   (SEFC_USERSIGNATURE_BLOCK)BOOT_USER_SIGNATURE_BLOCK,
+                                   (SEFC_USERSIGNATURE_PAGE)BOOT_USER_SIGNATURE_PAGE);
+    for (index = 0; (index < BOOT_CONFIG_OFFSET_USER_SIGN) && (otherDataKept == true); index++)
+    {
+        TEST_ASSERT_EQUAL(TEST_BOOT_OTHER_DATA, pPage[index]);
+    }
+
+    TEST_ASSERT_EQUAL((uint8_t)BOOT_CONFIG_KEY, pPage[BOOT_CONFIG_OFFSET_USER_SIGN]);
+    for (index = 4; index < 16U; index++)
+    {
+        TEST_ASSERT_EQUAL(0U, pPage[BOOT_CONFIG_OFFSET_USER_SIGN + index]);
+    }
+}
+
+/* Swap command still in the boot configuration */
+static bool lTEST_ConfigKept(uint32_t imageSize)
+{
+    uint32_t page[BOOT_FLASH_PAGE_SIZE / sizeof(uint32_t)];
+    uint8_t expected[16];
+
+    lTEST_PutUint32(&expected[0], BOOT_CONFIG_KEY);
+    lTEST_PutUint32(&expected[4], imageSize);
+    lTEST_PutUint32(&expected[8], TEST_BOOT_FU_ADDRESS);
+    lTEST_PutUint32(&expected[12], TEST_BOOT_APP_ADDRESS);
+
+    (void) SEFC0_UserSignatureRead(page, BOOT_FLASH_PAGE_SIZE / sizeof(uint32_t),
+                                   (SEFC_USERSIGNATURE_BLOCK)BOOT_USER_SIGNATURE_BLOCK,
+                                   (SEFC_USERSIGNATURE_PAGE)BOOT_USER_SIGNATURE_PAGE);
+
+    return (memcmp(&((uint8_t *)page)[BOOT_CONFIG_OFFSET_USER_SIGN], expected, sizeof(expected)) == 0);
+}
+
+static int lTEST_Boot(uintptr_t context)
+{
+    /* Ends with the jump to the application */
+    APP_BOOTLOADER_Initialize();
+    APP_BOOTLOADER_Tasks();
+    APP_BOOTLOADER_Tasks();
+
+    return 0;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(bootloader_SkipsUnchangedBlocks)
+{
+    HOST_SEFC0_STATS stats;
+    uint32_t changed;
+
+    changed = lTEST_Prepare(50);
+    TEST_ASSERT_EQUAL(HOST_BOOT_APPLICATION, HOST_Boot(lTEST_Boot, 0, HOST_BOOT_NO_CUT));
+    lTEST_CheckSwapped(true);
+
+    /* Buffer, FU and application blocks of the changed blocks only */
+    HOST_SEFC0_GetStats(&stats);
+    TEST_ASSERT(changed > 0U);
+    TEST_ASSERT_EQUAL(3U * changed, stats.flashErases);
+    TEST_ASSERT(stats.flashWrites <= (3U * changed * BOOT_FLASH_PAGES_NUMBER));
+    TEST_ASSERT_EQUAL(0U, stats.eccRewrites);
+    TEST_ASSERT_EQUAL(0U, stats.busyCommands);
+    TEST_ASSERT_EQUAL(0U, stats.rightsErrors);
+
+    /* Nothing else to do in the next boot */
+    TEST_ASSERT_EQUAL(HOST_BOOT_APPLICATION, HOST_Boot(lTEST_Boot, 0, HOST_BOOT_NO_CUT));
+    lTEST_CheckSwapped(true);
+    HOST_SEFC0_GetStats(&stats);
+    TEST_ASSERT_EQUAL(3U * changed, stats.flashErases);
+}
+
+TEST_CASE(bootloader_SwapWithPowerCuts)
+{
+    HOST_SEFC0_STATS stats;
+    uint64_t swapTime, startTime;
+    uint32_t trial, boots, cuts, result;
+    uint32_t totalCuts = 0;
+    uint32_t totalBoots = 0;
+
+    /* Time of a swap without cuts */
+    (void) lTEST_Prepare(30);
+    startTime = HOST_TIME_Get();
+    TEST_ASSERT_EQUAL(HOST_BOOT_APPLICATION, HOST_Boot(lTEST_Boot, 0, HOST_BOOT_NO_CUT));
+    swapTime = HOST_TIME_Get() - startTime;
+    lTEST_CheckSwapped(true);
+
+    for (trial = 0; (trial < 20U) && (TEST_GetFailures() == 0U); trial++)
+    {
+        (void) lTEST_Prepare(30);
+        boots = 0;
+        cuts = 0;
+
+        do
+        {
+            boots++;
+            if (cuts < 3U)
+            {
+                result = (uint32_t)HOST_Boot(lTEST_Boot, 0, HOST_TIME_Get() + ((uint64_t)rand() % swapTime));
+            }
+            else
+            {
+                result = (uint32_t)HOST_Boot(lTEST_Boot, 0, HOST_BOOT_NO_CUT);
+            }
+
+            if (result == HOST_BOOT_POWER_CUT)
+            {
+                cuts++;
+            }
+        } while ((result == HOST_BOOT_POWER_CUT) && (boots < 10U));
+
+        TEST_ASSERT_EQUAL(HOST_BOOT_APPLICATION, result);
+        lTEST_CheckSwapped(false);
+
+        /* Each 128-bit ECC unit programmed once per erase, also the journal
+           records */
+        HOST_SEFC0_GetStats(&stats);
+        TEST_ASSERT_EQUAL(0U, stats.eccRewrites);
+        TEST_ASSERT_EQUAL(0U, stats.busyCommands);
+        TEST_ASSERT_EQUAL(0U, stats.rightsErrors);
+
+        totalBoots += boots;
+        totalCuts += cuts;
+    }
+
+    printf("  %u swaps of %u blocks, %u boots, %u power cuts\n",
+           trial, (uint32_t)TEST_BOOT_BLOCKS, totalBoots, totalCuts);
+    TEST_ASSERT(totalCuts > trial);
+}
+
+TEST_CASE(bootloader_JournalWriteErrors)
+{
+    static const uint32_t faults[2] = {1U, 1000U};
+    HOST_SEFC0_STATS stats;
+    uint64_t swapTime, startTime;
+    uint32_t trial, boots, result;
+    uint32_t resumed = 0;
+    uint32_t lost = 0;
+
+    for (trial = 0; (trial < 20U) && (TEST_GetFailures() == 0U); trial++)
+    {
+        /* Time of a swap with the same journal errors, without cuts */
+        (void) lTEST_Prepare(0);
+        HOST_SEFC0_SetUnitWriteFaults(faults[trial % 2U]);
+        startTime = HOST_TIME_Get();
+        TEST_ASSERT_EQUAL(HOST_BOOT_APPLICATION, HOST_Boot(lTEST_Boot, 0, HOST_BOOT_NO_CUT));
+        swapTime = HOST_TIME_Get() - startTime;
+        lTEST_CheckSwapped(true);
+
+        HOST_SEFC0_GetStats(&stats);
+        TEST_ASSERT(stats.erases > 2U);
+        TEST_ASSERT_EQUAL(0U, stats.eccRewrites);
+        TEST_ASSERT_EQUAL(0U, stats.rightsErrors);
+
+        /* Steps not in the journal are kept in the boot configuration: the
+           swap goes on after a cut */
+        (void) lTEST_Prepare(0);
+        HOST_SEFC0_SetUnitWriteFaults(faults[trial % 2U]);
+        result = (uint32_t)HOST_Boot(lTEST_Boot, 0, HOST_TIME_Get() + (swapTime / 4U) +
+                                     ((uint64_t)rand() % ((swapTime * 3U) / 4U)));
+        TEST_ASSERT_EQUAL(HOST_BOOT_POWER_CUT, result);
+
+        if (lTEST_ConfigKept(TEST_BOOT_IMAGE_SIZE) == false)
+        {
+            /* Cut while the user signature was erased and written again:
+               the swap command is lost, as before the journal */
+            lost++;
+            continue;
+        }
+
+        boots = 0;
+        do
+        {
+            boots++;
+            result = (uint32_t)HOST_Boot(lTEST_Boot, 0, HOST_BOOT_NO_CUT);
+        } while ((result == HOST_BOOT_POWER_CUT) && (boots < 10U));
+
+        TEST_ASSERT_EQUAL(HOST_BOOT_APPLICATION, result);
+        lTEST_CheckSwapped(false);
+        resumed++;
+
+        HOST_SEFC0_GetStats(&stats);
+        TEST_ASSERT_EQUAL(0U, stats.eccRewrites);
+        TEST_ASSERT_EQUAL(0U, stats.busyCommands);
+        TEST_ASSERT_EQUAL(0U, stats.rightsErrors);
+    }
+
+    printf("  %u swaps with journal write errors and a cut: %u resumed, "
+           "%u cut in the user signature rewrite\n", trial, resumed, lost);
+    TEST_ASSERT(resumed > (trial / 2U));
+}
+
+TEST_CASE(bootloader_NoSwapCommand)
+{
+    HOST_SEFC0_STATS stats;
+
+    (void) lTEST_Prepare(0);
+    lTEST_WriteConfig(0);
+
+    TEST_ASSERT_EQUAL(HOST_BOOT_APPLICATION, HOST_Boot(lTEST_Boot, 0, HOST_BOOT_NO_CUT));
+    TEST_ASSERT(memcmp((uint8_t *)TEST_BOOT_APP_ADDRESS, testAppImage, sizeof(testAppImage)) == 0);
+    TEST_ASSERT(memcmp((uint8_t *)TEST_BOOT_FU_ADDRESS, testFuImage, sizeof(testFuImage)) == 0);
+
+    HOST_SEFC0_GetStats(&stats);
+    TEST_ASSERT_EQUAL(0U, stats.flashErases);
+    TEST_ASSERT_EQUAL(0U, stats.flashWrites);
+}
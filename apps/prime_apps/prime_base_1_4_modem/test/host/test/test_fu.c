@@ -0,0 +1,505 @@
+/*******************************************************************************
+  Firmware Upgrade Service Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_fu.c
+
+  Summary:
+    Host tests of the firmware upgrade service over the memory driver model.
+
+  Description:
+    A node stack model receives the image pages and writes them with the
+    service. Boots can be ended by power cuts: the upgrade is resumed from
+    the checkpoints and the pages already written are not programmed again.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "service/firmware_upgrade/srv_firmware_upgrade.h"
+#include "service/pcrc/srv_pcrc.h"
+#include "service/storage/srv_storage.h"
+#include "test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Image of the simulations: almost the whole FU region, last page shorter.
+   Pages cross the sector boundaries */
+#define TEST_FU_IMAGE_SIZE       393209U
+#define TEST_FU_PAGE_SIZE        200U
+#define TEST_FU_PAGES            ((TEST_FU_IMAGE_SIZE + TEST_FU_PAGE_SIZE - 1U) / TEST_FU_PAGE_SIZE)
+
+/* Main loop period and time between received pages */
+#define TEST_FU_LOOP_US          50U
+#define TEST_FU_PAGE_US          10000U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Test state kept across boots */
+typedef struct
+{
+    uint32_t pagesSent;
+    uint32_t programmedPages;
+    uint32_t resumedPages;
+    uint32_t crcErrors;
+    uint32_t crcLoops;
+    uint32_t writeErrors;
+
+} TEST_FU_STATE;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint8_t testFuImage[TEST_FU_IMAGE_SIZE];
+static uint32_t testFuImageCrc;
+
+static bool testMemDone;
+static uint32_t testMemCount;
+static SRV_FU_MEM_TRANSFER_RESULT testMemResult;
+static bool testCrcDone;
+static uint32_t testCrcValue;
+static uint32_t testFuResults;
+static SRV_FU_RESULT testFuResult;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Node stack model
+// *****************************************************************************
+// *****************************************************************************
+
+static void lTEST_MemCallback(SRV_FU_MEM_TRANSFER_CMD command, SRV_FU_MEM_TRANSFER_RESULT result)
+{
+    testMemDone = true;
+    testMemCount++;
+    testMemResult = result;
+}
+
+static void lTEST_CrcCallback(uint32_t crc)
+{
+    testCrcDone = true;
+    testCrcValue = crc;
+}
+
+static void lTEST_ResultCallback(SRV_FU_RESULT fuResult)
+{
+    testFuResults++;
+    testFuResult = fuResult;
+}
+
+static void lTEST_Loop(void)
+{
+    HOST_TIME_AdvanceUS(TEST_FU_LOOP_US);
+    DRV_MEMORY_Tasks((SYS_MODULE_OBJ)0);
+    SRV_FU_Tasks();
+    SRV_STORAGE_Tasks();
+}
+
+static void lTEST_WaitMem(void)
+{
+    while (testMemDone == false)
+    {
+        lTEST_Loop();
+    }
+}
+
+static void lTEST_FuInitialize(void)
+{
+    uint32_t loop;
+
+    TEST_TimeInitialize();
+    SRV_FU_Initialize();
+    SRV_STORAGE_Initialize();
+    SRV_FU_RegisterCallbackMemTransfer(lTEST_MemCallback);
+    SRV_FU_RegisterCallbackCrc(lTEST_CrcCallback);
+    SRV_FU_RegisterCallbackFuResult(lTEST_ResultCallback);
+
+    /* Memory driver opened by the service task */
+    for (loop = 0; loop < 5U; loop++)
+    {
+        lTEST_Loop();
+    }
+}
+
+static void lTEST_MakeImage(void)
+{
+    uint32_t index;
+
+    for (index = 0; index < TEST_FU_IMAGE_SIZE; index++)
+    {
+        testFuImage[index] = (uint8_t)rand();
+    }
+
+    testFuImageCrc = SRV_PCRC_GetValue(testFuImage, TEST_FU_IMAGE_SIZE, PCRC_HT_GENERIC, PCRC_CRC32, 0);
+}
+
+/* Receives the missing pages until the image CRC is right. lossPercent of
+   the pages are lost, and they are sent again in the next pass with the
+   pages not written in memory. The bitmap of received pages is kept by the
+   stack model (SRV_FU_GetBitmap returns 0), set when a page is reported */
+static void lTEST_Upgrade(TEST_FU_STATE *state, uint32_t lossPercent)
+{
+    static uint8_t bitmap[(TEST_FU_PAGES + 7U) / 8U];
+    SRV_FU_INFO info = {TEST_FU_IMAGE_SIZE, 0, SRV_FU_SIGNATURE_ALGO_NO_SIGNATURE, TEST_FU_PAGE_SIZE};
+    HOST_MEMORY_STATS stats;
+    uint32_t page, missing, numRx, size, writes;
+    uint64_t rxTime;
+
+    for (;;)
+    {
+        testMemDone = false;
+        SRV_FU_Start(&info);
+        lTEST_WaitMem();
+
+        numRx = 0;
+        (void) memset(bitmap, 0, sizeof(bitmap));
+        TEST_ASSERT_EQUAL(0U, SRV_FU_GetBitmap(bitmap, &numRx));
+
+        do
+        {
+            for (page = 0; page < TEST_FU_PAGES; page++)
+            {
+                if ((bitmap[page >> 3] & (1U << (page & 7U))) != 0U)
+                {
+                    continue;
+                }
+
+                rxTime = HOST_TIME_Get() + ((uint64_t)TEST_FU_PAGE_US * HOST_TIME_FREQUENCY / 1000000U);
+                while (HOST_TIME_Get() < rxTime)
+                {
+                    lTEST_Loop();
+                }
+
+                state->pagesSent++;
+                if (((uint32_t)rand() % 100U) < lossPercent)
+                {
+                    continue;
+                }
+
+                size = (page == (TEST_FU_PAGES - 1U)) ? (TEST_FU_IMAGE_SIZE - (page * TEST_FU_PAGE_SIZE)) : TEST_FU_PAGE_SIZE;
+                HOST_MEMORY_GetStats(&stats);
+                writes = stats.writes;
+                testMemDone = false;
+                SRV_FU_DataWrite(page * TEST_FU_PAGE_SIZE, &testFuImage[page * TEST_FU_PAGE_SIZE], (uint16_t)size);
+                lTEST_WaitMem();
+
+                if (testMemResult == SRV_FU_MEM_TRANSFER_OK)
+                {
+                    /* Reported when programmed, not when buffered */
+                    TEST_ASSERT(memcmp(&hostMemoryMedia[page * TEST_FU_PAGE_SIZE], &testFuImage[page * TEST_FU_PAGE_SIZE], size) == 0);
+                    bitmap[page >> 3] |= (uint8_t)(1U << (page & 7U));
+                    numRx++;
+
+                    /* Pages kept from a checkpoint are not programmed again */
+                    HOST_MEMORY_GetStats(&stats);
+                    if (stats.writes == writes)
+                    {
+                        state->resumedPages++;
+                    }
+                    else
+                    {
+                        state->programmedPages++;
+                    }
+                }
+                else
+                {
+                    state->writeErrors++;
+                }
+            }
+
+            missing = TEST_FU_PAGES - numRx;
+        } while (missing > 0U);
+
+        testCrcDone = false;
+        SRV_FU_CalculateCrc();
+        while (testCrcDone == false)
+        {
+            lTEST_Loop();
+            state->crcLoops++;
+        }
+
+        if (testCrcValue == testFuImageCrc)
+        {
+            SRV_FU_End(SRV_FU_RESULT_SUCCESS);
+            return;
+        }
+
+        state->crcErrors++;
+        SRV_FU_End(SRV_FU_RESULT_CRC_ERROR);
+    }
+}
+
+static int lTEST_UpgradeBoot(uintptr_t context)
+{
+    lTEST_FuInitialize();
+    lTEST_Upgrade((TEST_FU_STATE *)context, 0);
+
+    /* Checkpoint cleared in User Signature */
+    TEST_ASSERT(SRV_STORAGE_Flush() == true);
+
+    return (int)TEST_GetFailures();
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(fu_FullUpgradeWithLosses)
+{
+    TEST_FU_STATE state = {0};
+    HOST_MEMORY_STATS stats;
+
+    /* Old image in the FU region */
+    HOST_MEMORY_Reset(0x00U);
+    lTEST_MakeImage();
+    lTEST_FuInitialize();
+
+    lTEST_Upgrade(&state, 5U);
+
+    TEST_ASSERT(memcmp(hostMemoryMedia, testFuImage, TEST_FU_IMAGE_SIZE) == 0);
+    TEST_ASSERT_EQUAL(0U, state.crcErrors);
+    TEST_ASSERT_EQUAL(1U, testFuResults);
+    TEST_ASSERT_EQUAL(SRV_FU_RESULT_SUCCESS, testFuResult);
+    TEST_ASSERT_EQUAL(0U, state.writeErrors);
+    TEST_ASSERT_EQUAL(TEST_FU_PAGES, state.programmedPages);
+
+    /* CRC built while the pages are written, the image is not read back */
+    TEST_ASSERT(state.crcLoops <= 2U);
+
+    /* Sectors erased once, pages programmed once */
+    TEST_ASSERT(memcmp(hostMemoryMedia, testFuImage, TEST_FU_IMAGE_SIZE) == 0);
+    HOST_MEMORY_GetStats(&stats);
+    TEST_ASSERT_EQUAL((TEST_FU_IMAGE_SIZE + 8191U) / 8192U, stats.erases);
+    TEST_ASSERT_EQUAL(0U, stats.doublePrograms);
+    TEST_ASSERT_EQUAL(0U, stats.errors);
+
+    /* Pages received twice are reported, not written again */
+    testMemDone = false;
+    SRV_FU_DataWrite(0, testFuImage, TEST_FU_PAGE_SIZE);
+    lTEST_WaitMem();
+    TEST_ASSERT_EQUAL(SRV_FU_MEM_TRANSFER_OK, testMemResult);
+    HOST_MEMORY_GetStats(&stats);
+    TEST_ASSERT_EQUAL(0U, stats.doublePrograms);
+
+    /* Out of the FU region */
+    testMemDone = false;
+    SRV_FU_DataWrite(DRV_MEMORY_DEVICE_MEDIA_SIZE_BYTES - 16U, testFuImage, 32U);
+    TEST_ASSERT(testMemDone == true);
+    TEST_ASSERT_EQUAL(SRV_FU_MEM_TRANSFER_ERROR, testMemResult);
+}
+
+TEST_CASE(fu_WriteErrorPagesReceivedAgain)
+{
+    TEST_FU_STATE state = {0};
+    HOST_MEMORY_STATS stats;
+
+    HOST_MEMORY_Reset(0x00U);
+    lTEST_MakeImage();
+    lTEST_FuInitialize();
+
+    /* A page write in the second sector fails */
+    HOST_MEMORY_FailWrite(90U);
+
+    lTEST_Upgrade(&state, 0);
+
+    TEST_ASSERT(memcmp(hostMemoryMedia, testFuImage, TEST_FU_IMAGE_SIZE) == 0);
+    TEST_ASSERT_EQUAL(SRV_FU_RESULT_SUCCESS, testFuResult);
+
+    /* The failed page is reported in its own write callback and sent again */
+    TEST_ASSERT_EQUAL(1U, state.writeErrors);
+
+    /* Its sector is erased again before it is written, so the pages of the
+       sector already reported are lost: the CRC fails once and the image is
+       received again */
+    TEST_ASSERT_EQUAL(1U, state.crcErrors);
+    TEST_ASSERT_EQUAL((2U * TEST_FU_PAGES) + 1U, state.pagesSent);
+
+    HOST_MEMORY_GetStats(&stats);
+    TEST_ASSERT_EQUAL((2U * ((TEST_FU_IMAGE_SIZE + 8191U) / 8192U)) + 1U, stats.erases);
+    TEST_ASSERT_EQUAL(0U, stats.doublePrograms);
+    TEST_ASSERT_EQUAL(0U, stats.errors);
+}
+
+TEST_CASE(fu_TwoPagesInFlight)
+{
+    SRV_FU_INFO info = {TEST_FU_IMAGE_SIZE, 0, SRV_FU_SIGNATURE_ALGO_NO_SIGNATURE, TEST_FU_PAGE_SIZE};
+    uint32_t loop;
+
+    HOST_MEMORY_Reset(0x00U);
+    lTEST_MakeImage();
+    lTEST_FuInitialize();
+
+    testMemDone = false;
+    SRV_FU_Start(&info);
+    lTEST_WaitMem();
+
+    /* Second page accepted while the first one is written */
+    testMemCount = 0;
+    SRV_FU_DataWrite(0, testFuImage, TEST_FU_PAGE_SIZE);
+    SRV_FU_DataWrite(TEST_FU_PAGE_SIZE, &testFuImage[TEST_FU_PAGE_SIZE], TEST_FU_PAGE_SIZE);
+    TEST_ASSERT_EQUAL(0U, testMemCount);
+
+    /* No buffer for a third one */
+    SRV_FU_DataWrite(2U * TEST_FU_PAGE_SIZE, &testFuImage[2U * TEST_FU_PAGE_SIZE], TEST_FU_PAGE_SIZE);
+    TEST_ASSERT_EQUAL(1U, testMemCount);
+    TEST_ASSERT_EQUAL(SRV_FU_MEM_TRANSFER_ERROR, testMemResult);
+
+    /* Each page reported in order once it is in memory */
+    for (loop = 0; (loop < 1000U) && (testMemCount < 2U); loop++)
+    {
+        lTEST_Loop();
+    }
+
+    TEST_ASSERT_EQUAL(2U, testMemCount);
+
+    TEST_ASSERT_EQUAL(SRV_FU_MEM_TRANSFER_OK, testMemResult);
+    TEST_ASSERT(memcmp(hostMemoryMedia, testFuImage, TEST_FU_PAGE_SIZE) == 0);
+
+    for (loop = 0; (loop < 1000U) && (testMemCount < 3U); loop++)
+    {
+        lTEST_Loop();
+    }
+
+    TEST_ASSERT_EQUAL(3U, testMemCount);
+
+    TEST_ASSERT_EQUAL(SRV_FU_MEM_TRANSFER_OK, testMemResult);
+    TEST_ASSERT(memcmp(hostMemoryMedia, testFuImage, 2U * TEST_FU_PAGE_SIZE) == 0);
+
+    SRV_FU_End(SRV_FU_RESULT_CRC_ERROR);
+}
+
+TEST_CASE(fu_ResumeAfterPowerCuts)
+{
+    TEST_FU_STATE *state = HOST_NvmAlloc(sizeof(TEST_FU_STATE));
+    HOST_MEMORY_STATS memStats;
+    HOST_SEFC0_STATS sefcStats;
+    uint64_t cutAt;
+    uint32_t upgrade, cuts, totalCuts = 0;
+    int result;
+
+    /* Each upgrade over the image of the previous one */
+    HOST_MEMORY_Reset(0x00U);
+
+    for (upgrade = 0; (upgrade < 10U) && (TEST_GetFailures() == 0U); upgrade++)
+    {
+        lTEST_MakeImage();
+
+        for (cuts = 0; ; cuts++)
+        {
+            /* Power cuts 1 to 21 s after the boot, at any flash operation */
+            cutAt = HOST_BOOT_NO_CUT;
+            if (cuts < 2U)
+            {
+                cutAt = HOST_TIME_Get() + HOST_TIME_FREQUENCY +
+                        ((uint64_t)((uint32_t)rand() % 20000U) * HOST_TIME_FREQUENCY / 1000U);
+            }
+
+            result = HOST_Boot(lTEST_UpgradeBoot, (uintptr_t)state, cutAt);
+            if (result != HOST_BOOT_POWER_CUT)
+            {
+                TEST_ASSERT_EQUAL(0, result);
+                break;
+            }
+        }
+
+        totalCuts += cuts;
+        TEST_ASSERT(memcmp(hostMemoryMedia, testFuImage, TEST_FU_IMAGE_SIZE) == 0);
+    }
+
+    printf("  %u upgrades of %u pages, %u power cuts: %u pages programmed, %u resumed, %u CRC errors\n",
+           upgrade, TEST_FU_PAGES, totalCuts, state->programmedPages, state->resumedPages, state->crcErrors);
+
+    /* Pages written before the checkpoints are not programmed again: each
+       cut only loses the pages of the sectors not in the checkpoint */
+    TEST_ASSERT(state->resumedPages > 0U);
+    TEST_ASSERT(state->programmedPages <= ((upgrade * TEST_FU_PAGES) + (totalCuts * 2U * ((8192U / TEST_FU_PAGE_SIZE) + 2U))));
+    TEST_ASSERT_EQUAL(0U, state->crcErrors);
+
+    /* Erased sectors not in a checkpoint are erased again on resume, so no
+       page is programmed over old data */
+    HOST_MEMORY_GetStats(&memStats);
+    TEST_ASSERT_EQUAL(0U, memStats.doublePrograms);
+    TEST_ASSERT_EQUAL(0U, memStats.errors);
+
+    HOST_SEFC0_GetStats(&sefcStats);
+    TEST_ASSERT_EQUAL(0U, sefcStats.eccRewrites);
+    TEST_ASSERT_EQUAL(0U, sefcStats.busyCommands);
+    TEST_ASSERT_EQUAL(0U, sefcStats.rightsErrors);
+}
+
+TEST_CASE(fu_ResumeOtherImageDropsCheckpoint)
+{
+    TEST_FU_STATE *state = HOST_NvmAlloc(sizeof(TEST_FU_STATE));
+    HOST_MEMORY_STATS stats;
+    int result;
+
+    HOST_MEMORY_Reset(0x00U);
+    (void) memset(state, 0, sizeof(TEST_FU_STATE));
+
+    /* Upgrade cut after 5 s, with a checkpoint of the image */
+    lTEST_MakeImage();
+    result = HOST_Boot(lTEST_UpgradeBoot, (uintptr_t)state, HOST_TIME_Get() + (5U * HOST_TIME_FREQUENCY));
+    TEST_ASSERT_EQUAL(HOST_BOOT_POWER_CUT, result);
+    TEST_ASSERT(state->programmedPages > 0U);
+
+    /* Another image of the same size and signature: the first page differs
+       from the memory, so no page of the checkpoint is kept */
+    lTEST_MakeImage();
+    result = HOST_Boot(lTEST_UpgradeBoot, (uintptr_t)state, HOST_BOOT_NO_CUT);
+    TEST_ASSERT_EQUAL(0, result);
+
+    TEST_ASSERT(memcmp(hostMemoryMedia, testFuImage, TEST_FU_IMAGE_SIZE) == 0);
+    TEST_ASSERT_EQUAL(0U, state->resumedPages);
+    TEST_ASSERT_EQUAL(0U, state->crcErrors);
+
+    HOST_MEMORY_GetStats(&stats);
+    TEST_ASSERT_EQUAL(0U, stats.doublePrograms);
+    TEST_ASSERT_EQUAL(0U, stats.errors);
+}
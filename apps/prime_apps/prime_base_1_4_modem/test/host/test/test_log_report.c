@@ -0,0 +1,108 @@
+/*******************************************************************************
+  Log Report Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_log_report.c
+
+  Summary:
+    Host tests of the log report service.
+
+  Description:
+    The output of the service is read from the SYS_DEBUG model.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "service/log_report/srv_log_report.h"
+#include "test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(log_Messages)
+{
+    HOST_DEBUG_Clear();
+    SRV_LOG_REPORT_Message(SRV_LOG_REPORT_INFO, "Node %u: %s\r\n", 12U, "registered");
+    SRV_LOG_REPORT_Message_With_Code(SRV_LOG_REPORT_ERROR, 45, "Error %d\r\n", -3);
+
+    TEST_ASSERT(strcmp(HOST_DEBUG_GetOutput(), "Node 12: registered\r\nError -3\r\n") == 0);
+    TEST_ASSERT_EQUAL(2U, HOST_DEBUG_GetCount());
+}
+
+TEST_CASE(log_BufferInHex)
+{
+    uint8_t buffer[37];
+    char expected[128] = "Frame: ";
+    uint32_t index;
+
+    for (index = 0; index < sizeof(buffer); index++)
+    {
+        buffer[index] = (uint8_t)((index * 7U) + 0xF0U);
+        (void) sprintf(&expected[7U + (index << 1)], "%02x", buffer[index]);
+    }
+
+    (void) strcat(expected, "\r\n");
+
+    HOST_DEBUG_Clear();
+    SRV_LOG_REPORT_Buffer(SRV_LOG_REPORT_DEBUG, buffer, sizeof(buffer), "Frame: ");
+    TEST_ASSERT(strcmp(HOST_DEBUG_GetOutput(), expected) == 0);
+
+    /* Empty buffer: information and end of line only */
+    HOST_DEBUG_Clear();
+    SRV_LOG_REPORT_Buffer(SRV_LOG_REPORT_DEBUG, buffer, 0, "Empty");
+    TEST_ASSERT(strcmp(HOST_DEBUG_GetOutput(), "Empty\r\n") == 0);
+}
+
+TEST_CASE(log_LevelFilter)
+{
+    uint8_t buffer[4] = {1, 2, 3, 4};
+
+    SYS_DEBUG_ErrorLevelSet(SYS_ERROR_WARNING);
+    HOST_DEBUG_Clear();
+
+    SRV_LOG_REPORT_Message(SRV_LOG_REPORT_INFO, "info\r\n");
+    SRV_LOG_REPORT_Message(SRV_LOG_REPORT_DEBUG, "debug\r\n");
+    SRV_LOG_REPORT_Buffer(SRV_LOG_REPORT_DEBUG, buffer, sizeof(buffer), "buffer ");
+    SRV_LOG_REPORT_Message(SRV_LOG_REPORT_WARNING, "warning\r\n");
+    SRV_LOG_REPORT_Buffer(SRV_LOG_REPORT_ERROR, buffer, sizeof(buffer), "error ");
+
+    TEST_ASSERT(strcmp(HOST_DEBUG_GetOutput(), "warning\r\nerror 01020304\r\n") == 0);
+}
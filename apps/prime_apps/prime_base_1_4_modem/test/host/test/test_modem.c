@@ -0,0 +1,754 @@
+/*******************************************************************************
+  Modem Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_modem.c
+
+  Summary:
+    Host tests of the modem application of the Base Node.
+
+  Description:
+    Serialization of the PRIME primitives between the USI (FLEXCOM7 model) and
+    a PRIME API double that records the requests and gives access to the
+    callbacks set by the modem. Bursts of indications faster than the serial
+    line check that the callbacks drop the messages that do not fit instead of
+    waiting for the USART, and that the sent ones keep their order. Commands
+    replayed back-to-back at line rate check the depth of the reception queue,
+    the commands processed per superloop pass and the statistics response.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "service/usi/srv_usi.h"
+#include "service/usi/srv_usi_usart.h"
+#include "modem.h"
+#include "test.h"
+#include "usi_frame.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Payloads of the tests: the frames fit in the USART buffers */
+#define TEST_MODEM_DATA_SIZE    100U
+
+/* Burst of indications faster than the serial line */
+#define TEST_MODEM_BURST_NUM        200U
+#define TEST_MODEM_BURST_SIZE       200U
+#define TEST_MODEM_BURST_TASKS      8U
+#define TEST_MODEM_BAUD_RATE        921600U
+#define TEST_MODEM_BURST_GAP_US     300U
+
+/* Line capture of the whole burst */
+#define TEST_MODEM_LINE_SIZE        65536U
+
+/* Replay of back-to-back commands at line rate, with the superloop stalled
+ * every few passes (PRIME stack busy) */
+#define TEST_MODEM_REPLAY_NUM       1000U
+#define TEST_MODEM_REPLAY_SIZE      8U
+#define TEST_MODEM_PASS_US          200U
+#define TEST_MODEM_STALL_US         2500U
+#define TEST_MODEM_STALL_PASSES     50U
+
+/* Commands processed per APP_Modem_Tasks call and queue depth (modem_base.c) */
+#define TEST_MODEM_PROCESS_NUM      4U
+#define TEST_MODEM_QUEUE_NUM        8U
+
+/* Statistics response (big-endian counters) */
+#define TEST_MODEM_STATS_SIZE       33U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Same initialization as the application (initialization.c) */
+static uint8_t testUsiReadBuffer[SRV_USI0_RD_BUF_SIZE];
+static uint8_t testUsiWriteBuffer[SRV_USI0_WR_BUF_SIZE];
+static uint8_t testUsiUsartReadBuffer[128];
+
+static const SRV_USI_USART_INTERFACE testUsiPlib = {
+    .readCallbackRegister = (USI_USART_PLIB_READ_CALLBACK_REG)FLEXCOM7_USART_ReadCallbackRegister,
+    .readData = (USI_USART_PLIB_WRRD)FLEXCOM7_USART_Read,
+    .writeData = (USI_USART_PLIB_WRRD)FLEXCOM7_USART_Write,
+    .writeCountGet = FLEXCOM7_USART_WriteCountGet,
+    .writeFreeBufferCountGet = FLEXCOM7_USART_WriteFreeBufferCountGet,
+    .intSource = FLEXCOM7_IRQn,
+};
+
+static const USI_USART_INIT_DATA testUsiInitData = {
+    .plib = (void*)&testUsiPlib,
+    .pRdBuffer = (void*)testUsiReadBuffer,
+    .rdBufferSize = SRV_USI0_RD_BUF_SIZE,
+    .usartReadBuffer = (void *)testUsiUsartReadBuffer,
+    .usartBufferSize = 128
+};
+
+static const SRV_USI_INIT testUsiInit =
+{
+    .deviceInitData = (const void * const)&testUsiInitData,
+    .consDevDesc = &srvUSIUSARTDevDesc,
+    .deviceIndex = 0,
+    .pWrBuffer = testUsiWriteBuffer,
+    .wrBufferSize = SRV_USI0_WR_BUF_SIZE
+};
+
+/* Callbacks set by the modem */
+static MAC_CALLBACKS testMacCallbacks;
+static CL_432_CALLBACKS testCl432Callbacks;
+static BMNG_CALLBACKS testBmngCallbacks;
+
+/* Last MAC data request */
+static uint8_t testReqData[TEST_MODEM_DATA_SIZE];
+static uint16_t testReqLength;
+static uint16_t testReqConHandle;
+static uint8_t testReqPrio;
+static uint32_t testReqTimeRef;
+static uint32_t testReqCount;
+static uint32_t testReqOutOfOrder;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: PRIME API double
+// *****************************************************************************
+// *****************************************************************************
+
+static SYS_STATUS lTEST_Status(void)
+{
+    return SYS_STATUS_READY;
+}
+
+static void lTEST_MacSetCallbacks(MAC_CALLBACKS *primeMacCbs)
+{
+    testMacCallbacks = *primeMacCbs;
+}
+
+static void lTEST_Cl432SetCallbacks(CL_432_CALLBACKS *cl432cbs)
+{
+    testCl432Callbacks = *cl432cbs;
+}
+
+static void lTEST_BmngSetCallbacks(BMNG_CALLBACKS *bmngCallbacks)
+{
+    testBmngCallbacks = *bmngCallbacks;
+}
+
+static void lTEST_MacDataRequest(uint16_t conHandle, uint8_t *data, uint16_t dataLen,
+    uint8_t prio, uint32_t timeRef)
+{
+    testReqConHandle = conHandle;
+    (void) memcpy(testReqData, data, dataLen);
+    testReqLength = dataLen;
+    testReqPrio = prio;
+    testReqTimeRef = timeRef;
+    if (conHandle != (uint16_t)testReqCount)
+    {
+        testReqOutOfOrder++;
+    }
+
+    testReqCount++;
+}
+
+/* Only the primitives used by the tests */
+static const PRIME_API testPrimeApi = {
+    .Status = lTEST_Status,
+    .MacSetCallbacks = lTEST_MacSetCallbacks,
+    .MacDataRequest = lTEST_MacDataRequest,
+    .Cl432SetCallbacks = lTEST_Cl432SetCallbacks,
+    .BmngSetCallbacks = lTEST_BmngSetCallbacks,
+};
+
+void PRIME_API_GetPrimeAPI(const PRIME_API **pPrimeApi)
+{
+    *pPrimeApi = &testPrimeApi;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Helpers
+// *****************************************************************************
+// *****************************************************************************
+
+static void lTEST_ModemOpen(void)
+{
+    TEST_TimeInitialize();
+    FLEXCOM7_USART_Initialize();
+    HOST_FLEXCOM7_Reset();
+    TEST_ASSERT_EQUAL(SRV_USI_INDEX_0, SRV_USI_Initialize(SRV_USI_INDEX_0, (SYS_MODULE_INIT *)&testUsiInit));
+
+    APP_Modem_Initialize();
+    APP_Modem_Tasks();
+    TEST_ASSERT(testMacCallbacks.mac_data_ind != NULL);
+    TEST_ASSERT(testCl432Callbacks.cl_432_dl_data_ind != NULL);
+    TEST_ASSERT(testBmngCallbacks.fup_ack != NULL);
+}
+
+static void lTEST_Run(void)
+{
+    uint32_t index;
+
+    for (index = 0; index < 4U; index++)
+    {
+        SRV_USI_Tasks(SRV_USI_INDEX_0);
+        APP_Modem_Tasks();
+    }
+}
+
+static size_t lTEST_DataIndication(uint8_t *pMsg, uint16_t conHandle, const uint8_t *pData,
+                                   uint16_t length, uint32_t timeRef)
+{
+    size_t msgLength = 0;
+
+    pMsg[msgLength++] = APP_MODEM_CL_NULL_DATA_INDICATION_CMD;
+    pMsg[msgLength++] = (uint8_t)(conHandle >> 8);
+    pMsg[msgLength++] = (uint8_t)conHandle;
+    pMsg[msgLength++] = (uint8_t)(length >> 8);
+    pMsg[msgLength++] = (uint8_t)length;
+    (void) memcpy(&pMsg[msgLength], pData, length);
+    msgLength += length;
+    pMsg[msgLength++] = (uint8_t)(timeRef >> 24);
+    pMsg[msgLength++] = (uint8_t)(timeRef >> 16);
+    pMsg[msgLength++] = (uint8_t)(timeRef >> 8);
+    pMsg[msgLength++] = (uint8_t)timeRef;
+    return msgLength;
+}
+
+static size_t lTEST_ReleaseConfirm(uint8_t *pMsg, uint16_t conHandle, uint8_t result)
+{
+    size_t msgLength = 0;
+
+    pMsg[msgLength++] = APP_MODEM_CL_NULL_RELEASE_CONFIRM_CMD;
+    pMsg[msgLength++] = (uint8_t)(conHandle >> 8);
+    pMsg[msgLength++] = (uint8_t)conHandle;
+    pMsg[msgLength++] = result;
+    return msgLength;
+}
+
+static size_t lTEST_DataRequest(uint8_t *pMsg, uint16_t conHandle, const uint8_t *pData,
+                                uint16_t length, uint8_t prio, uint32_t timeRef)
+{
+    size_t msgLength = 0;
+
+    pMsg[msgLength++] = APP_MODEM_CL_NULL_DATA_REQUEST_CMD;
+    pMsg[msgLength++] = (uint8_t)(conHandle >> 8);
+    pMsg[msgLength++] = (uint8_t)conHandle;
+    pMsg[msgLength++] = (uint8_t)(length >> 8);
+    pMsg[msgLength++] = (uint8_t)length;
+    (void) memcpy(&pMsg[msgLength], pData, length);
+    msgLength += length;
+    pMsg[msgLength++] = prio;
+    pMsg[msgLength++] = (uint8_t)(timeRef >> 24);
+    pMsg[msgLength++] = (uint8_t)(timeRef >> 16);
+    pMsg[msgLength++] = (uint8_t)(timeRef >> 8);
+    pMsg[msgLength++] = (uint8_t)timeRef;
+    return msgLength;
+}
+
+/* Frames of short data requests with consecutive connection handles */
+static size_t lTEST_DataRequestFrames(uint8_t *pFrames, uint16_t firstHandle, uint32_t number)
+{
+    uint8_t data[TEST_MODEM_REPLAY_SIZE];
+    uint8_t msg[TEST_MODEM_REPLAY_SIZE + 16U];
+    size_t msgLength, framesLength = 0;
+    uint32_t index;
+
+    for (index = 0; index < number; index++)
+    {
+        (void) memset(data, (int)index, sizeof(data));
+        msgLength = lTEST_DataRequest(msg, (uint16_t)(firstHandle + index), data,
+                                      TEST_MODEM_REPLAY_SIZE, 0, index);
+        framesLength += TEST_USI_Encode(&pFrames[framesLength], SRV_USI_PROT_ID_PRIME_API,
+                                        msg, msgLength);
+    }
+
+    return framesLength;
+}
+
+static uint32_t lTEST_GetUint32(const uint8_t *pData)
+{
+    return ((uint32_t)pData[0] << 24) | ((uint32_t)pData[1] << 16) |
+           ((uint32_t)pData[2] << 8) | (uint32_t)pData[3];
+}
+
+/* Frames sent by the modem: escaped data has no frame delimiter */
+static uint32_t lTEST_CountFrames(const uint8_t *pLine, size_t length)
+{
+    uint32_t delimiters = 0;
+    size_t index;
+
+    for (index = 0; index < length; index++)
+    {
+        if (pLine[index] == 0x7EU)
+        {
+            delimiters++;
+        }
+    }
+
+    return delimiters / 2U;
+}
+
+/* Requests the statistics of the modem queues, the line must be empty */
+static void lTEST_Stats(uint8_t *pStats)
+{
+    static uint8_t frame[TEST_USI_FRAME_SIZE];
+    static uint8_t line[TEST_USI_FRAME_SIZE];
+    uint8_t request = APP_MODEM_STATS_REQUEST_CMD;
+    uint8_t raw[TEST_MODEM_STATS_SIZE + 3U];
+    size_t frameLength, lineLength, index, rawLength;
+
+    frameLength = TEST_USI_Encode(frame, SRV_USI_PROT_ID_PRIME_API, &request, 1U);
+    TEST_ASSERT_EQUAL(frameLength, HOST_FLEXCOM7_Receive(frame, frameLength));
+    lTEST_Run();
+
+    /* Unescape header, response and CRC */
+    lineLength = HOST_FLEXCOM7_Transmit(line, sizeof(line));
+    TEST_ASSERT(lineLength > 2U);
+    rawLength = 0;
+    for (index = 1; (index < (lineLength - 1U)) && (rawLength < sizeof(raw)); index++)
+    {
+        if (line[index] == 0x7DU)
+        {
+            raw[rawLength++] = line[++index] ^ 0x20U;
+        }
+        else
+        {
+            raw[rawLength++] = line[index];
+        }
+    }
+
+    TEST_ASSERT_EQUAL(sizeof(raw), rawLength);
+    (void) memcpy(pStats, &raw[2], TEST_MODEM_STATS_SIZE);
+
+    /* Same frame as the reference encoder: header and CRC are right */
+    frameLength = TEST_USI_Encode(frame, SRV_USI_PROT_ID_PRIME_API, pStats, TEST_MODEM_STATS_SIZE);
+    TEST_ASSERT_EQUAL(frameLength, lineLength);
+    TEST_ASSERT(memcmp(frame, line, lineLength) == 0);
+    TEST_ASSERT_EQUAL(APP_MODEM_STATS_RESPONSE_CMD, pStats[0]);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(modem_IndicationToUsi)
+{
+    static uint8_t data[TEST_MODEM_DATA_SIZE];
+    static uint8_t msg[TEST_MODEM_DATA_SIZE + 16U];
+    static uint8_t expected[TEST_USI_FRAME_SIZE];
+    static uint8_t line[TEST_USI_FRAME_SIZE];
+    size_t msgLength, expectedLength;
+    uint16_t length;
+    uint32_t index;
+
+    lTEST_ModemOpen();
+
+    for (index = 0; index < 100U; index++)
+    {
+        length = (uint16_t)(1U + ((uint32_t)rand() % TEST_MODEM_DATA_SIZE));
+        TEST_USI_Fill(data, length);
+        testMacCallbacks.mac_data_ind((uint16_t)index, data, length, index * 1000U);
+        lTEST_Run();
+
+        msgLength = lTEST_DataIndication(msg, (uint16_t)index, data, length, index * 1000U);
+        expectedLength = TEST_USI_Encode(expected, SRV_USI_PROT_ID_PRIME_API, msg, msgLength);
+        TEST_ASSERT_EQUAL(expectedLength, HOST_FLEXCOM7_Transmit(line, sizeof(line)));
+        TEST_ASSERT(memcmp(expected, line, expectedLength) == 0);
+    }
+}
+
+TEST_CASE(modem_UsiCommandToApi)
+{
+    static uint8_t data[TEST_MODEM_DATA_SIZE];
+    static uint8_t msg[TEST_MODEM_DATA_SIZE + 16U];
+    static uint8_t frame[TEST_USI_FRAME_SIZE];
+    size_t msgLength, frameLength;
+    uint16_t length;
+    uint32_t index;
+
+    lTEST_ModemOpen();
+
+    for (index = 0; index < 100U; index++)
+    {
+        length = (uint16_t)(1U + ((uint32_t)rand() % TEST_MODEM_DATA_SIZE));
+        TEST_USI_Fill(data, length);
+
+        msgLength = lTEST_DataRequest(msg, (uint16_t)index, data, length,
+                                      (uint8_t)(index % 4U), 0x12345600U + index);
+
+        frameLength = TEST_USI_Encode(frame, SRV_USI_PROT_ID_PRIME_API, msg, msgLength);
+        TEST_ASSERT_EQUAL(frameLength, HOST_FLEXCOM7_Receive(frame, frameLength));
+        lTEST_Run();
+
+        TEST_ASSERT_EQUAL(index + 1U, testReqCount);
+        TEST_ASSERT_EQUAL(index, testReqConHandle);
+        TEST_ASSERT_EQUAL(length, testReqLength);
+        TEST_ASSERT_EQUAL(index % 4U, testReqPrio);
+        TEST_ASSERT_EQUAL(0x12345600U + index, testReqTimeRef);
+        TEST_ASSERT(memcmp(testReqData, data, length) == 0);
+    }
+}
+
+TEST_CASE(modem_BurstAtLineRate)
+{
+    static uint8_t data[TEST_MODEM_BURST_SIZE];
+    static uint8_t msg[TEST_MODEM_BURST_SIZE + 16U];
+    static uint8_t expected[TEST_USI_FRAME_SIZE];
+    static uint8_t line[TEST_MODEM_LINE_SIZE];
+    size_t msgLength, expectedLength, lineLength, lineOffset;
+    uint64_t start, latency, maxLatency, frameCounts;
+    uint32_t index, loop, delivered;
+
+    lTEST_ModemOpen();
+    HOST_TIME_SetReadCost(2U);
+    HOST_FLEXCOM7_SetBaudRate(TEST_MODEM_BAUD_RATE);
+
+    /* Back-to-back indications, with the superloop running only every few
+     * of them: the pool and the USART ring fill up */
+    maxLatency = 0;
+    expectedLength = 0;
+    for (index = 0; index < TEST_MODEM_BURST_NUM; index++)
+    {
+        for (loop = 0; loop < TEST_MODEM_BURST_SIZE; loop++)
+        {
+            data[loop] = (uint8_t)(index + loop);
+        }
+
+        start = HOST_TIME_Get();
+        testMacCallbacks.mac_data_ind((uint16_t)index, data, TEST_MODEM_BURST_SIZE, index);
+        latency = HOST_TIME_Get() - start;
+        if (latency > maxLatency)
+        {
+            maxLatency = latency;
+        }
+
+        if ((index % TEST_MODEM_BURST_TASKS) == (TEST_MODEM_BURST_TASKS - 1U))
+        {
+            lTEST_Run();
+        }
+    }
+
+    /* Drain at line rate */
+    for (loop = 0; loop < 1000U; loop++)
+    {
+        lTEST_Run();
+        HOST_TIME_AdvanceUS(1000U);
+    }
+
+    lineLength = HOST_FLEXCOM7_Transmit(line, sizeof(line));
+
+    /* Every indication, in order and not corrupted */
+    lineOffset = 0;
+    delivered = 0;
+    for (index = 0; index < TEST_MODEM_BURST_NUM; index++)
+    {
+        for (loop = 0; loop < TEST_MODEM_BURST_SIZE; loop++)
+        {
+            data[loop] = (uint8_t)(index + loop);
+        }
+
+        msgLength = lTEST_DataIndication(msg, (uint16_t)index, data, TEST_MODEM_BURST_SIZE, index);
+        expectedLength = TEST_USI_Encode(expected, SRV_USI_PROT_ID_PRIME_API, msg, msgLength);
+        if ((lineOffset + expectedLength <= lineLength) &&
+            (memcmp(expected, &line[lineOffset], expectedLength) == 0))
+        {
+            lineOffset += expectedLength;
+            delivered++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(lineLength, lineOffset);
+    TEST_ASSERT_EQUAL(TEST_MODEM_BURST_NUM, delivered);
+
+    /* Waiting for room in the serial queue delays a callback by about the
+     * time of one frame in the line */
+    frameCounts = ((uint64_t)expectedLength * 10U * HOST_TIME_FREQUENCY) / TEST_MODEM_BAUD_RATE;
+    printf("  %u indications of %u bytes at %u baud: %u sent\n",
+           (unsigned int)TEST_MODEM_BURST_NUM, (unsigned int)TEST_MODEM_BURST_SIZE,
+           (unsigned int)TEST_MODEM_BAUD_RATE, (unsigned int)delivered);
+    printf("  max callback time %u us (frame %u us)\n",
+           (unsigned int)((maxLatency * 1000000U) / HOST_TIME_FREQUENCY),
+           (unsigned int)((frameCounts * 1000000U) / HOST_TIME_FREQUENCY));
+    TEST_ASSERT(maxLatency > (frameCounts / 2U));
+    TEST_ASSERT(maxLatency < (2U * frameCounts));
+}
+
+TEST_CASE(modem_ConfirmsSurviveBurst)
+{
+    static uint8_t data[TEST_MODEM_BURST_SIZE];
+    static uint8_t line[TEST_MODEM_LINE_SIZE];
+    uint8_t msg[8];
+    uint8_t expected[32];
+    size_t msgLength, expectedLength, lineLength, lineOffset;
+    uint32_t index, loop, confirms;
+    bool pending;
+
+    lTEST_ModemOpen();
+    HOST_TIME_SetReadCost(2U);
+    HOST_FLEXCOM7_SetBaudRate(TEST_MODEM_BAUD_RATE);
+
+    /* Indications several times faster than the line. The host sends a new
+     * request when it gets the confirm of the previous one */
+    confirms = 0;
+    pending = false;
+    lineLength = 0;
+    lineOffset = 0;
+    expectedLength = 0;
+    for (index = 0; index < TEST_MODEM_BURST_NUM; index++)
+    {
+        (void) memset(data, (int)index, sizeof(data));
+        testMacCallbacks.mac_data_ind((uint16_t)index, data, TEST_MODEM_BURST_SIZE, index);
+        HOST_TIME_AdvanceUS(TEST_MODEM_BURST_GAP_US);
+
+        if ((index % TEST_MODEM_BURST_TASKS) == (TEST_MODEM_BURST_TASKS - 1U))
+        {
+            if (pending == false)
+            {
+                testMacCallbacks.mac_release_cfm((uint16_t)(0x1000U + confirms),
+                                                 (MAC_RELEASE_CONFIRM_RESULT)0);
+                msgLength = lTEST_ReleaseConfirm(msg, (uint16_t)(0x1000U + confirms), 0);
+                expectedLength = TEST_USI_Encode(expected, SRV_USI_PROT_ID_PRIME_API, msg, msgLength);
+                pending = true;
+            }
+
+            lTEST_Run();
+            lineLength += HOST_FLEXCOM7_Transmit(&line[lineLength], sizeof(line) - lineLength);
+        }
+
+        /* Look for the confirm in the line */
+        while ((pending == true) && (lineOffset + expectedLength <= lineLength))
+        {
+            if (memcmp(expected, &line[lineOffset], expectedLength) == 0)
+            {
+                lineOffset += expectedLength;
+                confirms++;
+                pending = false;
+            }
+            else
+            {
+                lineOffset++;
+            }
+        }
+    }
+
+    for (loop = 0; loop < 1000U; loop++)
+    {
+        lTEST_Run();
+        HOST_TIME_AdvanceUS(1000U);
+    }
+
+    lineLength += HOST_FLEXCOM7_Transmit(&line[lineLength], sizeof(line) - lineLength);
+    while ((pending == true) && (lineOffset + expectedLength <= lineLength))
+    {
+        if (memcmp(expected, &line[lineOffset], expectedLength) == 0)
+        {
+            confirms++;
+            pending = false;
+        }
+
+        lineOffset++;
+    }
+
+    /* No indication or confirm was dropped: the host never waited for a
+     * confirm in vain */
+    printf("  %u indications and %u confirms: %u frames sent\n",
+           (unsigned int)TEST_MODEM_BURST_NUM, (unsigned int)confirms,
+           (unsigned int)lTEST_CountFrames(line, lineLength));
+    TEST_ASSERT(pending == false);
+    TEST_ASSERT(confirms > 1U);
+    TEST_ASSERT_EQUAL(TEST_MODEM_BURST_NUM + confirms, lTEST_CountFrames(line, lineLength));
+}
+
+TEST_CASE(modem_ReplayCommandsAtLineRate)
+{
+    static uint8_t frames[TEST_MODEM_REPLAY_NUM * 2U * (TEST_MODEM_REPLAY_SIZE + 16U)];
+    uint8_t stats[TEST_MODEM_STATS_SIZE];
+    size_t framesLength, framesOffset, lineBytes;
+    uint64_t elapsedUs;
+    uint32_t pass;
+
+    lTEST_ModemOpen();
+    framesLength = lTEST_DataRequestFrames(frames, 0, TEST_MODEM_REPLAY_NUM);
+
+    /* The host sends the commands back-to-back: the bytes received in each
+     * superloop pass are the ones of its duration at the line rate */
+    elapsedUs = 0;
+    framesOffset = 0;
+    for (pass = 0; (pass < 100000U) && (testReqCount < TEST_MODEM_REPLAY_NUM); pass++)
+    {
+        elapsedUs += ((pass % TEST_MODEM_STALL_PASSES) == 0U) ? TEST_MODEM_STALL_US : TEST_MODEM_PASS_US;
+        lineBytes = (size_t)((elapsedUs * TEST_MODEM_BAUD_RATE) / 10000000U);
+        if (lineBytes > framesLength)
+        {
+            lineBytes = framesLength;
+        }
+
+        if (lineBytes > framesOffset)
+        {
+            framesOffset += HOST_FLEXCOM7_Receive(&frames[framesOffset], lineBytes - framesOffset);
+        }
+
+        SRV_USI_Tasks(SRV_USI_INDEX_0);
+        APP_Modem_Tasks();
+    }
+
+    /* Every command, in order */
+    TEST_ASSERT_EQUAL(framesLength, framesOffset);
+    TEST_ASSERT_EQUAL(TEST_MODEM_REPLAY_NUM, testReqCount);
+    TEST_ASSERT_EQUAL(0U, testReqOutOfOrder);
+
+    /* The stalls are absorbed by the queue, without drops */
+    lTEST_Stats(stats);
+    printf("  %u commands at %u baud: queue high water %u of %u\n",
+           (unsigned int)TEST_MODEM_REPLAY_NUM, (unsigned int)TEST_MODEM_BAUD_RATE,
+           (unsigned int)stats[2], (unsigned int)stats[1]);
+    TEST_ASSERT_EQUAL(TEST_MODEM_QUEUE_NUM, stats[1]);
+    TEST_ASSERT(stats[2] > TEST_MODEM_PROCESS_NUM);
+    TEST_ASSERT(stats[2] <= TEST_MODEM_QUEUE_NUM);
+    TEST_ASSERT_EQUAL(0U, lTEST_GetUint32(&stats[3]));
+    TEST_ASSERT_EQUAL(0U, lTEST_GetUint32(&stats[7]));
+}
+
+TEST_CASE(modem_ProcessBudgetPerPass)
+{
+    static uint8_t frames[TEST_MODEM_QUEUE_NUM * 2U * (TEST_MODEM_REPLAY_SIZE + 16U)];
+    size_t framesLength;
+    uint32_t pass;
+
+    lTEST_ModemOpen();
+
+    /* Fill the queue without running the modem */
+    framesLength = lTEST_DataRequestFrames(frames, 0, TEST_MODEM_QUEUE_NUM);
+    TEST_ASSERT_EQUAL(framesLength, HOST_FLEXCOM7_Receive(frames, framesLength));
+    for (pass = 0; pass < 4U; pass++)
+    {
+        SRV_USI_Tasks(SRV_USI_INDEX_0);
+    }
+
+    TEST_ASSERT_EQUAL(0U, testReqCount);
+
+    /* At most MAX_NUM_MSG_PROCESS commands per pass */
+    for (pass = 1; pass <= (TEST_MODEM_QUEUE_NUM / TEST_MODEM_PROCESS_NUM); pass++)
+    {
+        APP_Modem_Tasks();
+        TEST_ASSERT_EQUAL(pass * TEST_MODEM_PROCESS_NUM, testReqCount);
+    }
+
+    APP_Modem_Tasks();
+    TEST_ASSERT_EQUAL(TEST_MODEM_QUEUE_NUM, testReqCount);
+    TEST_ASSERT_EQUAL(0U, testReqOutOfOrder);
+}
+
+TEST_CASE(modem_StatsRequest)
+{
+    static uint8_t frames[(TEST_MODEM_QUEUE_NUM + 1U) * 2U * (TEST_MODEM_REPLAY_SIZE + 16U)];
+    static uint8_t data[TEST_MODEM_BURST_SIZE];
+    static uint8_t line[TEST_MODEM_LINE_SIZE];
+    uint8_t stats[TEST_MODEM_STATS_SIZE];
+    uint8_t eui48[6] = {0};
+    size_t framesLength, lineLength;
+    uint32_t index, sent;
+
+    lTEST_ModemOpen();
+    HOST_TIME_SetReadCost(2U);
+
+    /* Nothing queued or dropped yet: only the buffer of the response used */
+    lTEST_Stats(stats);
+    TEST_ASSERT_EQUAL(TEST_MODEM_QUEUE_NUM, stats[1]);
+    TEST_ASSERT_EQUAL(1U, stats[2]);
+    TEST_ASSERT_EQUAL(0U, lTEST_GetUint32(&stats[3]));
+    TEST_ASSERT_EQUAL(0U, lTEST_GetUint32(&stats[7]));
+    TEST_ASSERT_EQUAL(1U, stats[12]);
+    TEST_ASSERT_EQUAL(0U, lTEST_GetUint32(&stats[13]));
+    TEST_ASSERT_EQUAL(0U, lTEST_GetUint32(&stats[17]));
+    TEST_ASSERT_EQUAL(0U, lTEST_GetUint32(&stats[21]));
+    TEST_ASSERT_EQUAL(0U, lTEST_GetUint32(&stats[29]));
+
+    /* One command more than the queue depth before the modem runs */
+    framesLength = lTEST_DataRequestFrames(frames, 0, TEST_MODEM_QUEUE_NUM + 1U);
+    TEST_ASSERT_EQUAL(framesLength, HOST_FLEXCOM7_Receive(frames, framesLength));
+    for (index = 0; index < 4U; index++)
+    {
+        SRV_USI_Tasks(SRV_USI_INDEX_0);
+    }
+
+    lTEST_Run();
+    TEST_ASSERT_EQUAL(TEST_MODEM_QUEUE_NUM, testReqCount);
+
+    /* Event indications while the USART does not send: the pool and the
+     * serial queue fill up and the last ones are dropped */
+    for (index = 0; index < 20U; index++)
+    {
+        (void) memset(data, (int)index, sizeof(data));
+        testMacCallbacks.mac_establish_ind((uint16_t)index, eui48, 0, data, TEST_MODEM_BURST_SIZE, 0, 0);
+    }
+
+    /* A data indication waits for room, and is only dropped when the link
+     * is considered down */
+    testMacCallbacks.mac_data_ind(0, data, TEST_MODEM_BURST_SIZE, 0);
+
+    lineLength = 0;
+    for (index = 0; index < 10U; index++)
+    {
+        lTEST_Run();
+        lineLength += HOST_FLEXCOM7_Transmit(&line[lineLength], sizeof(line) - lineLength);
+    }
+
+    sent = lTEST_CountFrames(line, lineLength);
+    TEST_ASSERT(sent < 20U);
+
+    lTEST_Stats(stats);
+    TEST_ASSERT_EQUAL(TEST_MODEM_QUEUE_NUM, stats[2]);
+    TEST_ASSERT_EQUAL(1U, lTEST_GetUint32(&stats[3]));
+    TEST_ASSERT_EQUAL(0U, lTEST_GetUint32(&stats[7]));
+    TEST_ASSERT_EQUAL(4U, stats[11]);
+    /* Indications leave the buffer reserved for confirms and responses */
+    TEST_ASSERT_EQUAL(3U, stats[12]);
+    TEST_ASSERT(lTEST_GetUint32(&stats[13]) > 0U);
+    TEST_ASSERT_EQUAL(20U - sent, lTEST_GetUint32(&stats[17]));
+    TEST_ASSERT_EQUAL(1U, lTEST_GetUint32(&stats[21]));
+    TEST_ASSERT(lTEST_GetUint32(&stats[25]) >= 100000U);
+    TEST_ASSERT(lTEST_GetUint32(&stats[25]) < 110000U);
+    TEST_ASSERT_EQUAL(1U, lTEST_GetUint32(&stats[29]));
+}
@@ -0,0 +1,1016 @@
+/*******************************************************************************
+  PAL PLC Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_pal_plc.c
+
+  Summary:
+    Host tests of the PLC PHY Abstraction Layer.
+
+  Description:
+    Start-up, transmission and reception of the PAL PLC on the PLC PHY driver
+    and the PL460 model. Frame durations and sniffer payload symbols are
+    checked against a reference model of the PRIME PHY. Timestamps of the
+    timer synchronization are checked with a drifting PL460 oscillator.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "stack/pal/pal_types.h"
+#include "stack/pal/pal_local.h"
+#include "stack/pal/pal_plc.h"
+#include "service/pcoup/srv_pcoup.h"
+#include "service/time_management/srv_time_management.h"
+#include "test.h"
+#include "plc_setup.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Signal capture: 8 fragments in 40 ms in the PL460 model */
+#define TEST_PAL_CAPTURE_FRAGS       8U
+#define TEST_PAL_CAPTURE_US          40000U
+#define TEST_PAL_CAPTURE_SIZE        (TEST_PAL_CAPTURE_FRAGS * SIGNAL_CAPTURE_FRAG_SIZE)
+
+/* Confirmations kept in order of arrival */
+#define TEST_PAL_CFM_LOG             8U
+
+/* Full load: 60-byte frames (5 symbols) of the PL460 model air time, as
+   many as fit twice in the transmission log */
+#define TEST_PAL_LOAD_FRAMES         30U
+#define TEST_PAL_LOAD_LENGTH         60U
+#define TEST_PAL_LOAD_AIR_US         (6528U + (5U * 2240U))
+/* MAC time to prepare a frame once a buffer is free */
+#define TEST_PAL_LOAD_PREPARE_US     1200U
+/* Margin for the request to reach the PL460 before the frame starts */
+#define TEST_PAL_LOAD_PROGRAM_US     500U
+/* Superloop period, random up to this value */
+#define TEST_PAL_LOAD_LOOP_US        3000U
+/* Spacing between consecutive frames scheduled in advance */
+#define TEST_PAL_LOAD_SPACING_US     100U
+
+/* Timer synchronization: virtual hour with the PL460 clock at +/-50 ppm plus
+ * a random walk (ppm per square root of second), a superloop pass every
+ * 10 ms and a received frame every second */
+#define TEST_PAL_SYNC_HOUR_STEPS     360000U
+#define TEST_PAL_SYNC_STEP_US        10000U
+#define TEST_PAL_SYNC_RX_STEPS       100U
+#define TEST_PAL_SYNC_PPM            50.0
+#define TEST_PAL_SYNC_WALK_PPM       0.01
+/* Spread of the timestamp error (us): the prediction error that the PAL
+ * keeps without shortening the interval (3 us) on either side, plus the
+ * 1 us resolution of the timers */
+#define TEST_PAL_SYNC_SPREAD_US      8
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static PAL_MSG_CONFIRM_DATA testCfm;
+static PAL_MSG_CONFIRM_DATA testCfmLog[TEST_PAL_CFM_LOG];
+static uint32_t testCfmCount;
+
+static uint8_t testRxData[TEST_PLC_FRAME_SIZE];
+static PAL_MSG_INDICATION_DATA testInd;
+static uint32_t testIndCount;
+
+static uint8_t testSniffer[TEST_PLC_FRAME_SIZE + 64U];
+static uint32_t testSnifferCount;
+
+static uint8_t testCapture[TEST_PAL_CAPTURE_SIZE];
+static uint16_t testCaptureLength;
+static uint32_t testCaptureCount;
+static uint64_t testCaptureTime;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Helpers
+// *****************************************************************************
+// *****************************************************************************
+
+static void lTEST_DataCfm(PAL_MSG_CONFIRM_DATA *pData)
+{
+    testCfm = *pData;
+    if (testCfmCount < TEST_PAL_CFM_LOG)
+    {
+        testCfmLog[testCfmCount] = *pData;
+    }
+
+    testCfmCount++;
+}
+
+static void lTEST_DataInd(PAL_MSG_INDICATION_DATA *pData)
+{
+    testInd = *pData;
+    (void) memcpy(testRxData, pData->pData, pData->dataLength);
+    testIndCount++;
+}
+
+static void lTEST_Sniffer(uint8_t *pData, uint16_t length)
+{
+    (void) memcpy(testSniffer, pData, length);
+    testSnifferCount++;
+}
+
+/* Reference model of the payload symbols: 96 carriers of 1, 2 or 3 bits,
+   coding rate 1/2 with a flushing byte for the coded schemes, each symbol
+   repeated 4 times in the robust ones. Type A headers carry 7 bytes */
+static bool lTEST_RefSymbols(uint16_t length, uint8_t scheme, uint8_t frameType, uint32_t *pSymbols)
+{
+    uint32_t bits, bytes;
+    bool coded, robust;
+
+    switch (scheme)
+    {
+        case PAL_SCHEME_DBPSK:   bits = 1U; coded = false; robust = false; break;
+        case PAL_SCHEME_DQPSK:   bits = 2U; coded = false; robust = false; break;
+        case PAL_SCHEME_D8PSK:   bits = 3U; coded = false; robust = false; break;
+        case PAL_SCHEME_DBPSK_C: bits = 1U; coded = true;  robust = false; break;
+        case PAL_SCHEME_DQPSK_C: bits = 2U; coded = true;  robust = false; break;
+        case PAL_SCHEME_D8PSK_C: bits = 3U; coded = true;  robust = false; break;
+        case PAL_SCHEME_R_DBPSK: bits = 1U; coded = true;  robust = true;  break;
+        case PAL_SCHEME_R_DQPSK: bits = 2U; coded = true;  robust = true;  break;
+        default: return false;
+    }
+
+    if ((frameType != PAL_FRAME_TYPE_A) && (frameType != PAL_FRAME_TYPE_B) &&
+        (frameType != PAL_FRAME_TYPE_BC))
+    {
+        return false;
+    }
+
+    bytes = length;
+    if (frameType == PAL_FRAME_TYPE_A)
+    {
+        bytes = (bytes > 7U) ? (bytes - 7U) : 0U;
+    }
+
+    if (coded == true)
+    {
+        bytes++;
+        bits *= 96U / 2U;
+    }
+    else
+    {
+        bits *= 96U;
+    }
+
+    *pSymbols = ((bytes * 8U) + bits - 1U) / bits;
+    if (robust == true)
+    {
+        *pSymbols *= 4U;
+    }
+
+    return true;
+}
+
+static uint32_t lTEST_ElapsedUS(uint64_t start)
+{
+    return (uint32_t)(((HOST_TIME_Get() - start) * 1000000U) / HOST_TIME_FREQUENCY);
+}
+
+static void lTEST_Capture(uint8_t *pData, uint16_t length, uintptr_t context)
+{
+    TEST_ASSERT(pData == testCapture);
+    TEST_ASSERT_EQUAL(0x5AU, context);
+    testCaptureLength = length;
+    testCaptureTime = HOST_TIME_Get();
+    testCaptureCount++;
+}
+
+/* Runs the tasks until the capture is reported. Returns the longest task */
+static uint32_t lTEST_CaptureRun(uint32_t timeMs)
+{
+    uint32_t taskUS, taskMaxUS = 0;
+    uint32_t index;
+    uint64_t start;
+
+    for (index = 0; (index < (timeMs * 10U)) && (testCaptureCount == 0U); index++)
+    {
+        start = HOST_TIME_Get();
+        DRV_PLC_PHY_Tasks(DRV_PLC_PHY_INDEX);
+        PAL_PLC_Tasks();
+        taskUS = lTEST_ElapsedUS(start);
+        if (taskUS > taskMaxUS)
+        {
+            taskMaxUS = taskUS;
+        }
+
+        HOST_TIME_AdvanceUS(100U);
+    }
+
+    return taskMaxUS;
+}
+
+/* Fragment data of the PL460 model */
+static bool lTEST_CaptureCheck(const uint8_t *pData, uint16_t length)
+{
+    uint16_t idx;
+
+    for (idx = 0; idx < length; idx++)
+    {
+        uint32_t fragment = idx / SIGNAL_CAPTURE_FRAG_SIZE;
+
+        if (pData[idx] != (uint8_t)((fragment * 31U) + (idx % SIGNAL_CAPTURE_FRAG_SIZE)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void lTEST_Open(void)
+{
+    TEST_PLC_PalOpen();
+    PAL_PLC_DataConfirmCallbackRegister(lTEST_DataCfm);
+    PAL_PLC_DataIndicationCallbackRegister(lTEST_DataInd);
+}
+
+static void lTEST_Request(PAL_MSG_REQUEST_DATA *pRequest, uint8_t *pData, uint16_t length, uint8_t buffId)
+{
+    (void) memset(pRequest, 0, sizeof(*pRequest));
+    pRequest->pData = pData;
+    pRequest->dataLength = length;
+    (void)PAL_PLC_GetChannel(&pRequest->pch);
+    pRequest->buffId = buffId;
+    pRequest->scheme = PAL_SCHEME_DBPSK_C;
+    pRequest->frameType = PAL_FRAME_TYPE_A;
+    pRequest->timeMode = PAL_TX_MODE_RELATIVE;
+    pRequest->timeDelay = 1000U;
+}
+
+/* Keeps up to depth frames requested, each one after the previous in the
+   line. Returns the mean gap between frames in the line (us) */
+static uint32_t lTEST_TxLoad(uint8_t depth, uint32_t *maxGapUS)
+{
+    static uint8_t data[TEST_PAL_LOAD_LENGTH];
+    PAL_MSG_REQUEST_DATA request;
+    const HOST_PL460_TX *prev;
+    const HOST_PL460_TX *tx;
+    uint32_t first = HOST_PL460_GetTxCount();
+    uint32_t requested = 0;
+    uint32_t nextStart = 0;
+    uint32_t now, gapUS, gapSum = 0;
+    uint32_t index;
+
+    testCfmCount = 0;
+    *maxGapUS = 0;
+    TEST_PLC_Fill(data, sizeof(data));
+
+    while (testCfmCount < TEST_PAL_LOAD_FRAMES)
+    {
+        DRV_PLC_PHY_Tasks(DRV_PLC_PHY_INDEX);
+        PAL_PLC_Tasks();
+
+        while ((requested < TEST_PAL_LOAD_FRAMES) && ((requested - testCfmCount) < depth))
+        {
+            /* Not before the frame is prepared and programmed, nor before the
+             * previous one ends */
+            HOST_TIME_AdvanceUS(TEST_PAL_LOAD_PREPARE_US);
+            (void)PAL_PLC_GetTimer(&now);
+            now += TEST_PAL_LOAD_PROGRAM_US;
+            if ((requested == testCfmCount) || ((int32_t)(nextStart - now) < 0))
+            {
+                nextStart = now;
+            }
+
+            lTEST_Request(&request, data, sizeof(data), (uint8_t)(requested & 1U));
+            request.timeMode = PAL_TX_MODE_ABSOLUTE;
+            request.timeDelay = nextStart;
+            TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+            nextStart += TEST_PAL_LOAD_AIR_US + TEST_PAL_LOAD_SPACING_US;
+            requested++;
+        }
+
+        HOST_TIME_AdvanceUS(100U + ((uint32_t)rand() % TEST_PAL_LOAD_LOOP_US));
+    }
+
+    for (index = 0; index < TEST_PAL_LOAD_FRAMES; index++)
+    {
+        tx = HOST_PL460_GetTx(first + index);
+        TEST_ASSERT_EQUAL(DRV_PLC_PHY_TX_RESULT_SUCCESS, tx->result);
+        if (index > 0U)
+        {
+            prev = HOST_PL460_GetTx(first + index - 1U);
+            TEST_ASSERT(tx->start >= prev->end);
+            gapUS = (uint32_t)(((tx->start - prev->end) * 1000000U) / HOST_TIME_FREQUENCY);
+            gapSum += gapUS;
+            if (gapUS > *maxGapUS)
+            {
+                *maxGapUS = gapUS;
+            }
+        }
+    }
+
+    return gapSum / (TEST_PAL_LOAD_FRAMES - 1U);
+}
+
+/* Normal deviate, sum of 12 uniform ones */
+static double lTEST_Gauss(void)
+{
+    double sum = -6.0;
+    uint32_t index;
+
+    for (index = 0; index < 12U; index++)
+    {
+        sum += (double)rand() / (double)RAND_MAX;
+    }
+
+    return sum;
+}
+
+/* Timer synchronization before the adaptive interval: fixed ladder of
+ * intervals (50 ms, 250 ms, 1 s, then 5 s), frequency measured in the last
+ * one */
+typedef struct
+{
+    uint32_t refHost;
+    uint32_t refPlc;
+    double relFreq;
+    uint64_t nextSync;
+    uint32_t syncs;
+} TEST_PAL_SYNC_BASELINE;
+
+static void lTEST_BaselineSync(TEST_PAL_SYNC_BASELINE *pSync, bool init)
+{
+    static const uint32_t ladderUS[3] = {50000U, 250000U, 1000000U};
+    uint64_t now = HOST_TIME_Get();
+    uint32_t plc = HOST_PL460_GetTime();
+    /* Same host time as the PAL, read at the same instant as the PL460 timer */
+    uint32_t host = SRV_TIME_MANAGEMENT_GetTimeUS();
+
+    if (init == true)
+    {
+        pSync->relFreq = 1.0;
+        pSync->syncs = 0;
+    }
+    else
+    {
+        pSync->relFreq = (double)(host - pSync->refHost) / (double)(plc - pSync->refPlc);
+    }
+
+    pSync->refHost = host;
+    pSync->refPlc = plc;
+    pSync->nextSync = now + (((uint64_t)((pSync->syncs < 3U) ? ladderUS[pSync->syncs] : 5000000U) *
+                              HOST_TIME_FREQUENCY) / 1000000U);
+    pSync->syncs++;
+}
+
+static uint32_t lTEST_BaselineHostTime(const TEST_PAL_SYNC_BASELINE *pSync, uint32_t timePlc)
+{
+    double delay = (double)(int32_t)(timePlc - pSync->refPlc) * pSync->relFreq;
+
+    return pSync->refHost + (uint32_t)(int32_t)((delay >= 0.0) ? (delay + 0.5) : (delay - 0.5));
+}
+
+/* Timestamp error (us) in a virtual hour. The PAL adds a constant offset
+   for the delay between timer reads on the device, so the spread of the
+   error is what measures the tracking of the oscillator */
+typedef struct
+{
+    int32_t minUS;
+    int32_t maxUS;
+    uint32_t reads;
+} TEST_PAL_SYNC_ERROR;
+
+static void lTEST_SyncError(TEST_PAL_SYNC_ERROR *pError, int32_t errorUS)
+{
+    if (errorUS < pError->minUS)
+    {
+        pError->minUS = errorUS;
+    }
+
+    if (errorUS > pError->maxUS)
+    {
+        pError->maxUS = errorUS;
+    }
+}
+
+/* Runs a virtual hour: returns the timestamp error and timer reads of the
+   PAL and of the baseline */
+static void lTEST_SyncHour(double ppm, TEST_PAL_SYNC_ERROR *pPal, TEST_PAL_SYNC_ERROR *pBase)
+{
+    static uint8_t data[20];
+    TEST_PAL_SYNC_BASELINE baseline;
+    HOST_PL460_STATS stats;
+    uint32_t step, readsStart, frames = 0;
+    uint32_t hostNow, plcNow, trueHost;
+    int32_t plcDelay;
+
+    lTEST_Open();
+    TEST_PLC_Fill(data, sizeof(data));
+    HOST_PL460_SetClockPpm(ppm);
+
+    /* Both start from the synchronization at the channel setting */
+    lTEST_BaselineSync(&baseline, true);
+    HOST_PL460_GetStats(&stats);
+    readsStart = stats.timeReads;
+
+    pPal->minUS = INT32_MAX;
+    pPal->maxUS = INT32_MIN;
+    *pBase = *pPal;
+    for (step = 1; step <= TEST_PAL_SYNC_HOUR_STEPS; step++)
+    {
+        ppm += TEST_PAL_SYNC_WALK_PPM * 0.1 * lTEST_Gauss();
+        HOST_PL460_SetClockPpm(ppm);
+        HOST_TIME_AdvanceUS(TEST_PAL_SYNC_STEP_US);
+        DRV_PLC_PHY_Tasks(DRV_PLC_PHY_INDEX);
+        PAL_PLC_Tasks();
+
+        if (HOST_TIME_Get() >= baseline.nextSync)
+        {
+            lTEST_BaselineSync(&baseline, false);
+        }
+
+        if ((step % TEST_PAL_SYNC_RX_STEPS) != 0U)
+        {
+            continue;
+        }
+
+        /* Host time of the start of the frame, from the PL460 timer */
+        plcNow = HOST_PL460_GetTime();
+        hostNow = SRV_TIME_MANAGEMENT_GetTimeUS();
+        HOST_PL460_Receive(data, sizeof(data));
+        plcDelay = (int32_t)(HOST_PL460_GetRxStart() - plcNow);
+        trueHost = hostNow + (uint32_t)(int32_t)(((double)plcDelay / (1.0 + (ppm * 1.0e-6))) - 0.5);
+
+        TEST_PLC_PalRunUntil(&testIndCount, ++frames, 10U);
+        TEST_ASSERT_EQUAL(frames, testIndCount);
+
+        lTEST_SyncError(pPal, (int32_t)(testInd.rxTime - trueHost));
+        lTEST_SyncError(pBase, (int32_t)(lTEST_BaselineHostTime(&baseline,
+                        HOST_PL460_GetRxStart()) - trueHost));
+    }
+
+    HOST_PL460_GetStats(&stats);
+    pPal->reads = stats.timeReads - readsStart;
+    pBase->reads = baseline.syncs - 1U;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(palPlc_StartUp)
+{
+    HOST_PL460_STATS stats;
+    const HOST_PL460_TX *tx;
+
+    lTEST_Open();
+
+    /* Impedance detection frame sent before the default channel is set */
+    HOST_PL460_GetStats(&stats);
+    TEST_ASSERT(HOST_PL460_GetTxCount() >= 1U);
+    tx = HOST_PL460_GetTx(0);
+    TEST_ASSERT_EQUAL(DRV_PLC_PHY_TX_RESULT_SUCCESS, tx->result);
+    TEST_ASSERT_EQUAL(8U, tx->dataLength);
+    TEST_ASSERT_EQUAL(1U, stats.boots);
+}
+
+TEST_CASE(palPlc_TransmitReceive)
+{
+    static uint8_t data[TEST_PLC_FRAME_SIZE];
+    PAL_MSG_REQUEST_DATA request;
+    uint32_t txCount;
+    uint16_t length;
+    uint32_t index;
+
+    lTEST_Open();
+    txCount = HOST_PL460_GetTxCount();
+
+    for (index = 0; index < 10U; index++)
+    {
+        length = (uint16_t)(10U + ((uint32_t)rand() % 200U));
+        TEST_PLC_Fill(data, length);
+        lTEST_Request(&request, data, length, 0);
+        TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+        TEST_PLC_PalRunUntil(&testCfmCount, index + 1U, 200U);
+
+        TEST_ASSERT_EQUAL(index + 1U, testCfmCount);
+        TEST_ASSERT_EQUAL(PAL_TX_RESULT_SUCCESS, testCfm.result);
+        TEST_ASSERT_EQUAL(0U, testCfm.bufId);
+        TEST_ASSERT_EQUAL(length, HOST_PL460_GetTx(txCount + index)->dataLength);
+        TEST_ASSERT(memcmp(HOST_PL460_GetTx(txCount + index)->data, data, 10U) == 0);
+
+        HOST_PL460_Receive(data, length);
+        TEST_PLC_PalRunUntil(&testIndCount, index + 1U, 10U);
+
+        TEST_ASSERT_EQUAL(index + 1U, testIndCount);
+        TEST_ASSERT_EQUAL(length, testInd.dataLength);
+        TEST_ASSERT_EQUAL(request.pch, testInd.pch);
+        TEST_ASSERT(memcmp(testRxData, data, length) == 0);
+    }
+}
+
+TEST_CASE(palPlc_ChannelChangeBlocking)
+{
+    static uint8_t data[TEST_PLC_FRAME_SIZE];
+    SRV_PLC_PCOUP_CHANNEL_DATA *pCoup;
+    PAL_MSG_REQUEST_DATA request;
+    DRV_PLC_PHY_PIB_OBJ pibObj;
+    HOST_PL460_STATS stats;
+    uint8_t gain[sizeof(pCoup->gainHigh)];
+    uint8_t channel = (uint8_t)CHN5;
+    uint32_t blockingUS, setUS, txUS, taskUS, taskMaxUS, index;
+    uint64_t start;
+
+    lTEST_Open();
+
+    /* Blocking channel change, as done when the PIB queue is full */
+    pibObj.id = PLC_ID_CHANNEL_CFG;
+    pibObj.length = 1;
+    pibObj.pData = &channel;
+    start = HOST_TIME_Get();
+    TEST_ASSERT(DRV_PLC_PHY_PIBSet(DRV_PLC_PHY_INDEX, &pibObj));
+    TEST_ASSERT(SRV_PCOUP_SetChannelConfig(DRV_PLC_PHY_INDEX, CHN5));
+    blockingUS = lTEST_ElapsedUS(start);
+
+    /* Channel change through PIB requests, with a transmission requested
+       during the guard time of the channel */
+    start = HOST_TIME_Get();
+    TEST_ASSERT_EQUAL(PAL_CFG_SUCCESS, PAL_PLC_SetChannel(0x01U << ((uint8_t)CHN2 - 1U)));
+    setUS = lTEST_ElapsedUS(start);
+
+    DRV_PLC_PHY_Tasks(DRV_PLC_PHY_INDEX);
+    TEST_PLC_Fill(data, 40U);
+    lTEST_Request(&request, data, 40U, 0);
+    start = HOST_TIME_Get();
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    txUS = lTEST_ElapsedUS(start);
+
+    taskMaxUS = 0;
+    for (index = 0; index < 400U; index++)
+    {
+        start = HOST_TIME_Get();
+        DRV_PLC_PHY_Tasks(DRV_PLC_PHY_INDEX);
+        PAL_PLC_Tasks();
+        taskUS = lTEST_ElapsedUS(start);
+        if (taskUS > taskMaxUS)
+        {
+            taskMaxUS = taskUS;
+        }
+
+        HOST_TIME_AdvanceUS(100U);
+    }
+
+    printf("  channel change: %u us blocking, queued %u us + tasks up to %u us, transmission request %u us\n",
+           blockingUS, setUS, taskMaxUS, txUS);
+
+    /* Channel and coupling of the new channel set, frame sent on it after
+       the guard time */
+    TEST_ASSERT(HOST_PL460_GetPib(PLC_ID_CHANNEL_CFG, &channel, 1U));
+    TEST_ASSERT_EQUAL(CHN2, channel);
+    pCoup = SRV_PCOUP_GetChannelConfig(CHN2);
+    TEST_ASSERT(HOST_PL460_GetPib(PLC_ID_GAIN_TABLE_HI, gain, (uint16_t)sizeof(gain)));
+    TEST_ASSERT(memcmp(gain, pCoup->gainHigh, sizeof(gain)) == 0);
+    TEST_ASSERT_EQUAL(1U, testCfmCount);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_SUCCESS, testCfm.result);
+    HOST_PL460_GetStats(&stats);
+    TEST_ASSERT_EQUAL(0U, stats.guardViolations);
+
+    TEST_ASSERT(blockingUS > 5500U);
+    TEST_ASSERT(setUS < 500U);
+    TEST_ASSERT(txUS < 500U);
+    TEST_ASSERT(taskMaxUS < 500U);
+}
+
+TEST_CASE(palPlc_SignalCapture)
+{
+    static uint8_t blocking[TEST_PAL_CAPTURE_SIZE];
+    uint32_t captureUS, taskMaxUS;
+    uint64_t start;
+
+    lTEST_Open();
+    HOST_PL460_SetCapture(TEST_PAL_CAPTURE_FRAGS, TEST_PAL_CAPTURE_US);
+
+    (void) memset(testCapture, 0, sizeof(testCapture));
+    start = HOST_TIME_Get();
+    TEST_ASSERT(PAL_PLC_SignalCaptureRequest(testCapture, (uint16_t)sizeof(testCapture), PAL_FRAME_TYPE_A,
+                                             0, TEST_PAL_CAPTURE_US, lTEST_Capture, 0x5AU));
+    TEST_ASSERT(lTEST_ElapsedUS(start) < 500U);
+
+    /* One capture at a time; the blocking capture is refused meanwhile */
+    TEST_ASSERT(PAL_PLC_SignalCaptureRequest(testCapture, (uint16_t)sizeof(testCapture), PAL_FRAME_TYPE_A,
+                                             0, TEST_PAL_CAPTURE_US, lTEST_Capture, 0x5AU) == false);
+    TEST_ASSERT_EQUAL(0U, PAL_PLC_GetSignalCapture(blocking, PAL_FRAME_TYPE_A, 0, TEST_PAL_CAPTURE_US));
+
+    taskMaxUS = lTEST_CaptureRun(200U);
+    captureUS = (uint32_t)(((testCaptureTime - start) * 1000000U) / HOST_TIME_FREQUENCY);
+    printf("  signal capture of %u bytes in %u us (capture %u us), tasks up to %u us\n",
+           TEST_PAL_CAPTURE_SIZE, captureUS, TEST_PAL_CAPTURE_US, taskMaxUS);
+
+    /* Whole capture read while the superloop keeps running */
+    TEST_ASSERT_EQUAL(1U, testCaptureCount);
+    TEST_ASSERT_EQUAL(TEST_PAL_CAPTURE_SIZE, testCaptureLength);
+    TEST_ASSERT(lTEST_CaptureCheck(testCapture, testCaptureLength));
+    TEST_ASSERT(captureUS >= TEST_PAL_CAPTURE_US);
+    TEST_ASSERT(taskMaxUS < 500U);
+
+    /* A new capture can be requested once reported */
+    testCaptureCount = 0;
+    (void) memset(testCapture, 0, sizeof(testCapture));
+    TEST_ASSERT(PAL_PLC_SignalCaptureRequest(testCapture, (uint16_t)sizeof(testCapture), PAL_FRAME_TYPE_A,
+                                             0, TEST_PAL_CAPTURE_US, lTEST_Capture, 0x5AU));
+    (void) lTEST_CaptureRun(200U);
+    TEST_ASSERT_EQUAL(1U, testCaptureCount);
+    TEST_ASSERT(lTEST_CaptureCheck(testCapture, testCaptureLength));
+}
+
+TEST_CASE(palPlc_SignalCaptureWholeFragments)
+{
+    lTEST_Open();
+    HOST_PL460_SetCapture(TEST_PAL_CAPTURE_FRAGS, TEST_PAL_CAPTURE_US);
+
+    /* Room for two fragments and a half: the rest is not written */
+    (void) memset(testCapture, 0xEE, sizeof(testCapture));
+    TEST_ASSERT(PAL_PLC_SignalCaptureRequest(testCapture, 600U, PAL_FRAME_TYPE_A,
+                                             0, TEST_PAL_CAPTURE_US, lTEST_Capture, 0x5AU));
+    (void) lTEST_CaptureRun(200U);
+
+    TEST_ASSERT_EQUAL(1U, testCaptureCount);
+    TEST_ASSERT_EQUAL(2U * SIGNAL_CAPTURE_FRAG_SIZE, testCaptureLength);
+    TEST_ASSERT(lTEST_CaptureCheck(testCapture, testCaptureLength));
+    TEST_ASSERT_EQUAL(0xEEU, testCapture[testCaptureLength]);
+    TEST_ASSERT_EQUAL(0xEEU, testCapture[sizeof(testCapture) - 1U]);
+}
+
+TEST_CASE(palPlc_SignalCaptureWaitsPrevious)
+{
+    DRV_PLC_PHY_PIB_OBJ pibObj;
+    uint8_t parameters[9] = {0};
+    uint64_t previousEnd;
+
+    lTEST_Open();
+    HOST_PL460_SetCapture(TEST_PAL_CAPTURE_FRAGS, TEST_PAL_CAPTURE_US);
+
+    /* Capture started by another client, 12 ms before the request */
+    pibObj.id = PLC_ID_SIGNAL_CAPTURE_START;
+    pibObj.length = (uint16_t)sizeof(parameters);
+    pibObj.pData = parameters;
+    TEST_ASSERT(DRV_PLC_PHY_PIBSet(DRV_PLC_PHY_INDEX, &pibObj));
+    previousEnd = HOST_TIME_Get() + (((uint64_t)TEST_PAL_CAPTURE_US * HOST_TIME_FREQUENCY) / 1000000U);
+    HOST_TIME_AdvanceUS(12000U);
+
+    TEST_ASSERT(PAL_PLC_SignalCaptureRequest(testCapture, (uint16_t)sizeof(testCapture), PAL_FRAME_TYPE_A,
+                                             0, TEST_PAL_CAPTURE_US, lTEST_Capture, 0x5AU));
+    (void) lTEST_CaptureRun(300U);
+
+    /* Started once the previous one finished */
+    TEST_ASSERT_EQUAL(1U, testCaptureCount);
+    TEST_ASSERT_EQUAL(TEST_PAL_CAPTURE_SIZE, testCaptureLength);
+    TEST_ASSERT(testCaptureTime >= (previousEnd + (((uint64_t)TEST_PAL_CAPTURE_US * HOST_TIME_FREQUENCY) / 1000000U)));
+}
+
+TEST_CASE(palPlc_SignalCaptureAbortedByReset)
+{
+    lTEST_Open();
+    HOST_PL460_SetCapture(TEST_PAL_CAPTURE_FRAGS, TEST_PAL_CAPTURE_US);
+
+    (void) memset(testCapture, 0xEE, sizeof(testCapture));
+    TEST_ASSERT(PAL_PLC_SignalCaptureRequest(testCapture, (uint16_t)sizeof(testCapture), PAL_FRAME_TYPE_A,
+                                             0, TEST_PAL_CAPTURE_US, lTEST_Capture, 0x5AU));
+    (void) lTEST_CaptureRun(10U);
+    TEST_ASSERT_EQUAL(0U, testCaptureCount);
+
+    /* PL460 restarted while capturing: reported empty */
+    HOST_PL460_Reset();
+    (void) lTEST_CaptureRun(500U);
+    TEST_ASSERT_EQUAL(1U, testCaptureCount);
+    TEST_ASSERT_EQUAL(0U, testCaptureLength);
+    TEST_ASSERT_EQUAL(0xEEU, testCapture[0]);
+
+    /* PAL back to ready after the firmware upload */
+    TEST_PLC_PalRunUntil(&testCfmCount, 1U, 500U);
+    TEST_ASSERT_EQUAL(SYS_STATUS_READY, PAL_PLC_Status());
+}
+
+TEST_CASE(palPlc_TxBufferRemapped)
+{
+    static uint8_t data[2][TEST_PLC_FRAME_SIZE];
+    PAL_MSG_REQUEST_DATA request;
+    uint32_t txCount;
+
+    lTEST_Open();
+    txCount = HOST_PL460_GetTxCount();
+
+    /* Both frames with MAC buffer 0: the second one takes the free TX1 */
+    TEST_PLC_Fill(data[0], 40U);
+    lTEST_Request(&request, data[0], 40U, 0);
+    request.timeDelay = 1000U;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    TEST_PLC_Fill(data[1], 40U);
+    lTEST_Request(&request, data[1], 40U, 0);
+    request.timeDelay = 30000U;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    TEST_PLC_PalRunUntil(&testCfmCount, 2U, 100U);
+
+    TEST_ASSERT_EQUAL(2U, testCfmCount);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_SUCCESS, testCfmLog[0].result);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_SUCCESS, testCfmLog[1].result);
+    TEST_ASSERT_EQUAL(0U, testCfmLog[0].bufId);
+    TEST_ASSERT_EQUAL(0U, testCfmLog[1].bufId);
+    TEST_ASSERT_EQUAL(0U, HOST_PL460_GetTx(txCount)->bufferId);
+    TEST_ASSERT_EQUAL(1U, HOST_PL460_GetTx(txCount + 1U)->bufferId);
+    TEST_ASSERT(memcmp(HOST_PL460_GetTx(txCount)->data, data[0], 32U) == 0);
+    TEST_ASSERT(memcmp(HOST_PL460_GetTx(txCount + 1U)->data, data[1], 32U) == 0);
+
+    /* MAC buffer 1 goes to TX1 when free */
+    lTEST_Request(&request, data[1], 40U, 1);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    TEST_PLC_PalRunUntil(&testCfmCount, 3U, 100U);
+    TEST_ASSERT_EQUAL(3U, testCfmCount);
+    TEST_ASSERT_EQUAL(1U, testCfmLog[2].bufId);
+    TEST_ASSERT_EQUAL(1U, HOST_PL460_GetTx(txCount + 2U)->bufferId);
+}
+
+TEST_CASE(palPlc_TxCancel)
+{
+    static uint8_t data[TEST_PLC_FRAME_SIZE];
+    PAL_MSG_REQUEST_DATA request;
+    uint32_t txCount;
+
+    lTEST_Open();
+    txCount = HOST_PL460_GetTxCount();
+    TEST_PLC_Fill(data, 40U);
+
+    lTEST_Request(&request, data, 40U, 0);
+    request.timeDelay = 50000U;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    lTEST_Request(&request, data, 40U, 1);
+    request.timeDelay = 5000U;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    TEST_PLC_PalRunUntil(&testCfmCount, 1U, 2U);
+    TEST_ASSERT_EQUAL(0U, testCfmCount);
+
+    /* Nothing programmed for MAC buffer 5: nothing confirmed */
+    lTEST_Request(&request, NULL, 0, 5);
+    request.timeMode = PAL_TX_MODE_CANCEL;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+
+    /* Only the frame of MAC buffer 0 is cancelled */
+    lTEST_Request(&request, NULL, 0, 0);
+    request.timeMode = PAL_TX_MODE_CANCEL;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    TEST_PLC_PalRunUntil(&testCfmCount, 2U, 100U);
+
+    TEST_ASSERT_EQUAL(2U, testCfmCount);
+    TEST_ASSERT_EQUAL(0U, testCfmLog[0].bufId);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_CANCELLED, testCfmLog[0].result);
+    TEST_ASSERT_EQUAL(1U, testCfmLog[1].bufId);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_SUCCESS, testCfmLog[1].result);
+    TEST_ASSERT_EQUAL(2U, HOST_PL460_GetTxCount() - txCount);
+
+    /* The cancelled buffer can be used again */
+    lTEST_Request(&request, data, 40U, 0);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    TEST_PLC_PalRunUntil(&testCfmCount, 3U, 100U);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_SUCCESS, testCfmLog[2].result);
+}
+
+TEST_CASE(palPlc_TxBusyConfirmDeferred)
+{
+    static uint8_t data[TEST_PLC_FRAME_SIZE];
+    PAL_MSG_REQUEST_DATA request;
+    uint32_t txCount;
+
+    lTEST_Open();
+    txCount = HOST_PL460_GetTxCount();
+    TEST_PLC_Fill(data, 40U);
+
+    lTEST_Request(&request, data, 40U, 0);
+    request.timeDelay = 20000U;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    lTEST_Request(&request, data, 40U, 1);
+    request.timeDelay = 60000U;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+
+    /* Both buffers in use: BUSY_TX confirmed from the tasks, not from the
+     * request, up to one per buffer; then refused */
+    lTEST_Request(&request, data, 40U, 2);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    lTEST_Request(&request, data, 40U, 3);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    lTEST_Request(&request, data, 40U, 4);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_BUSY_TX, PAL_PLC_DataRequest(&request));
+    TEST_ASSERT_EQUAL(0U, testCfmCount);
+
+    PAL_PLC_Tasks();
+    TEST_ASSERT_EQUAL(2U, testCfmCount);
+    TEST_ASSERT_EQUAL(2U, testCfmLog[0].bufId);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_BUSY_TX, testCfmLog[0].result);
+    TEST_ASSERT_EQUAL(3U, testCfmLog[1].bufId);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_BUSY_TX, testCfmLog[1].result);
+
+    /* The frames in the buffers are not affected */
+    TEST_PLC_PalRunUntil(&testCfmCount, 4U, 200U);
+    TEST_ASSERT_EQUAL(4U, testCfmCount);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_SUCCESS, testCfmLog[2].result);
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_SUCCESS, testCfmLog[3].result);
+    TEST_ASSERT_EQUAL(2U, HOST_PL460_GetTxCount() - txCount);
+}
+
+TEST_CASE(palPlc_TxConfirmOrder)
+{
+    static uint8_t data[TEST_PLC_FRAME_SIZE];
+    PAL_MSG_REQUEST_DATA request;
+    uint32_t now;
+
+    lTEST_Open();
+    TEST_PLC_Fill(data, 40U);
+    (void)PAL_PLC_GetTimer(&now);
+
+    /* TX0 programmed first, for the later time */
+    lTEST_Request(&request, data, 40U, 0);
+    request.timeMode = PAL_TX_MODE_ABSOLUTE;
+    request.timeDelay = now + 40000U;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    lTEST_Request(&request, data, 40U, 1);
+    request.timeMode = PAL_TX_MODE_ABSOLUTE;
+    request.timeDelay = now + 5000U;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+
+    /* Both confirmations handled in the same tasks call */
+    HOST_TIME_AdvanceUS(80000U);
+    TEST_PLC_PalRunUntil(&testCfmCount, 2U, 10U);
+
+    TEST_ASSERT_EQUAL(2U, testCfmCount);
+    TEST_ASSERT_EQUAL(1U, testCfmLog[0].bufId);
+    TEST_ASSERT_EQUAL(0U, testCfmLog[1].bufId);
+    TEST_ASSERT(testCfmLog[0].txTime < testCfmLog[1].txTime);
+    TEST_ASSERT((testCfmLog[0].txTime - (now + 5000U)) < 100U);
+    TEST_ASSERT((testCfmLog[1].txTime - (now + 40000U)) < 100U);
+}
+
+TEST_CASE(palPlc_TxFullLoad)
+{
+    uint32_t singleGapUS, singleMaxUS;
+    uint32_t queuedGapUS, queuedMaxUS;
+
+    lTEST_Open();
+
+    /* Next frame requested once the previous one is confirmed */
+    singleGapUS = lTEST_TxLoad(1U, &singleMaxUS);
+    /* Next frame requested while the previous one is in the line */
+    queuedGapUS = lTEST_TxLoad(2U, &queuedMaxUS);
+
+    printf("  inter-frame gap of %u-us frames: %u us mean (%u us max) with one buffer, "
+           "%u us mean (%u us max) with two\n", TEST_PAL_LOAD_AIR_US,
+           singleGapUS, singleMaxUS, queuedGapUS, queuedMaxUS);
+
+    TEST_ASSERT(singleGapUS >= TEST_PAL_LOAD_PREPARE_US);
+    TEST_ASSERT(queuedMaxUS <= (TEST_PAL_LOAD_SPACING_US + 10U));
+}
+
+TEST_CASE(palPlc_PayloadSymbols)
+{
+    /* Chirp and header of type A, B and BC frames (us) */
+    static const uint32_t chirpHeader[4] = {
+        2048U + 4480U, 0U, (2048U * 4U) + (2240U * 4U), (2048U * 5U) + (2240U * 6U)
+    };
+    uint32_t duration, symbols, checked = 0;
+    uint32_t scheme, frameType, length;
+    uint8_t result;
+
+    /* Every scheme and frame type, including the ones out of the table */
+    for (scheme = 0; scheme < 0x24U; scheme++)
+    {
+        for (frameType = 0; frameType < 6U; frameType++)
+        {
+            for (length = 0; length <= 0xFFFFU; length++)
+            {
+                result = PAL_PLC_GetMsgDuration((uint16_t)length, (PAL_SCHEME)scheme,
+                                                (PAL_FRAME)frameType, &duration);
+                if ((length == 0U) ||
+                    (lTEST_RefSymbols((uint16_t)length, (uint8_t)scheme, (uint8_t)frameType, &symbols) == false))
+                {
+                    TEST_ASSERT_EQUAL(PAL_CFG_INVALID_INPUT, result);
+                    TEST_ASSERT_EQUAL(0U, duration);
+                    continue;
+                }
+
+                TEST_ASSERT_EQUAL(PAL_CFG_SUCCESS, result);
+                TEST_ASSERT_EQUAL((symbols * 2240U) + chirpHeader[frameType], duration);
+                checked++;
+            }
+        }
+    }
+
+    /* 8 schemes, 3 frame types */
+    TEST_ASSERT_EQUAL(8U * 3U * 0xFFFFU, checked);
+}
+
+TEST_CASE(palPlc_SnifferPayloadSymbols)
+{
+    static uint8_t data[TEST_PLC_FRAME_SIZE];
+    PAL_MSG_REQUEST_DATA request;
+    uint16_t pibSymbols = 57U;
+    uint32_t symbols;
+
+    lTEST_Open();
+    PAL_PLC_USISnifferCallbackRegister(0, lTEST_Sniffer);
+    TEST_PLC_Fill(data, 100U);
+
+    /* Scheme in the table */
+    lTEST_Request(&request, data, 100U, 0);
+    request.scheme = PAL_SCHEME_DQPSK_C;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    TEST_PLC_PalRunUntil(&testCfmCount, 1U, 200U);
+    TEST_ASSERT_EQUAL(1U, testSnifferCount);
+    TEST_ASSERT(lTEST_RefSymbols(100U, PAL_SCHEME_DQPSK_C, PAL_FRAME_TYPE_A, &symbols) == true);
+    TEST_ASSERT_EQUAL(PAL_SCHEME_DQPSK_C, testSniffer[3]);
+    TEST_ASSERT_EQUAL(symbols, testSniffer[4]);
+
+    /* Received frames (DBPSK_C, type A) */
+    HOST_PL460_Receive(data, 100U);
+    TEST_PLC_PalRunUntil(&testIndCount, 1U, 10U);
+    TEST_ASSERT_EQUAL(2U, testSnifferCount);
+    TEST_ASSERT(lTEST_RefSymbols(100U, PAL_SCHEME_DBPSK_C, PAL_FRAME_TYPE_A, &symbols) == true);
+    TEST_ASSERT_EQUAL(symbols, testSniffer[4]);
+
+    /* Scheme out of the table: computed by the PLC transceiver */
+    TEST_ASSERT(HOST_PL460_SetPib(PLC_ID_TX_PAY_SYMBOLS, &pibSymbols, 2U) == true);
+    lTEST_Request(&request, data, 100U, 0);
+    request.scheme = (PAL_SCHEME)0x03;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    TEST_PLC_PalRunUntil(&testCfmCount, 2U, 200U);
+    TEST_ASSERT_EQUAL(3U, testSnifferCount);
+    TEST_ASSERT_EQUAL(0x03U, testSniffer[3]);
+    TEST_ASSERT_EQUAL(pibSymbols, testSniffer[4]);
+
+    /* PLC transceiver not answering */
+    HOST_PL460_SetPibNoResponse(PLC_ID_TX_PAY_SYMBOLS);
+    lTEST_Request(&request, data, 100U, 0);
+    request.scheme = (PAL_SCHEME)0x03;
+    TEST_ASSERT_EQUAL(PAL_TX_RESULT_PROCESS, PAL_PLC_DataRequest(&request));
+    TEST_PLC_PalRunUntil(&testCfmCount, 3U, 200U);
+    TEST_ASSERT_EQUAL(4U, testSnifferCount);
+    TEST_ASSERT_EQUAL(0U, testSniffer[4]);
+}
+
+static void lTEST_SyncDrift(double ppm)
+{
+    TEST_PAL_SYNC_ERROR pal, base;
+
+    lTEST_SyncHour(ppm, &pal, &base);
+    printf("  %+.0f ppm, walk %.2f ppm/rt(s), 1 h: adaptive %u reads, error %d..%d us; "
+           "fixed interval %u reads, error %d..%d us\n", ppm, TEST_PAL_SYNC_WALK_PPM,
+           pal.reads, pal.minUS, pal.maxUS, base.reads, base.minUS, base.maxUS);
+
+    /* Tracks the oscillator within the prediction error that shortens the
+       interval, with fewer reads than the fixed intervals */
+    TEST_ASSERT((pal.maxUS - pal.minUS) <= TEST_PAL_SYNC_SPREAD_US);
+    TEST_ASSERT(pal.reads < base.reads);
+}
+
+TEST_CASE(palPlc_TimerSyncDriftFast)
+{
+    lTEST_SyncDrift(TEST_PAL_SYNC_PPM);
+}
+
+TEST_CASE(palPlc_TimerSyncDriftSlow)
+{
+    lTEST_SyncDrift(-TEST_PAL_SYNC_PPM);
+}
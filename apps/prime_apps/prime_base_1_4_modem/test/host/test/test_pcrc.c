@@ -0,0 +1,220 @@
+/*******************************************************************************
+  PCRC Service Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_pcrc.c
+
+  Summary:
+    Tests of the PRIME CRC service.
+
+  Description:
+    The table driven (and sliced) CRCs are checked against bitwise
+    implementations of the same polynomials, over random lengths, alignments
+    and initial values.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "service/pcrc/srv_pcrc.h"
+#include "test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Bitwise references
+// *****************************************************************************
+// *****************************************************************************
+
+static uint8_t lTEST_Crc8(const uint8_t *pData, size_t length, uint8_t crc)
+{
+    uint32_t bit;
+
+    while (length-- > 0U)
+    {
+        crc ^= *pData++;
+        for (bit = 0; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x80U) != 0U) ? (uint8_t)((crc << 1) ^ 0x07U) : (uint8_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/* Data bits are shifted in at the bottom of the register (augmented form) */
+static uint16_t lTEST_Crc16(const uint8_t *pData, size_t length, uint16_t crc)
+{
+    uint32_t bit;
+    bool top;
+
+    while (length-- > 0U)
+    {
+        for (bit = 0; bit < 8U; bit++)
+        {
+            top = ((crc & 0x8000U) != 0U);
+            crc = (uint16_t)((crc << 1) | ((*pData >> (7U - bit)) & 1U));
+            if (top == true)
+            {
+                crc ^= 0x1021U;
+            }
+        }
+
+        pData++;
+    }
+
+    return crc;
+}
+
+static uint32_t lTEST_Crc32(const uint8_t *pData, size_t length, uint32_t crc)
+{
+    uint32_t bit;
+
+    while (length-- > 0U)
+    {
+        crc ^= (uint32_t)*pData++ << 24;
+        for (bit = 0; bit < 8U; bit++)
+        {
+            crc = ((crc & 0x80000000UL) != 0U) ? ((crc << 1) ^ 0x04C11DB7UL) : (crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static void lTEST_Fill(uint8_t *pData, size_t length)
+{
+    size_t index;
+
+    for (index = 0; index < length; index++)
+    {
+        pData[index] = (uint8_t)rand();
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(pcrc_GenericMatchesBitwise)
+{
+    static uint8_t data[1100];
+    uint32_t iteration, offset, init;
+    size_t length;
+
+    for (iteration = 0; iteration < 2000U; iteration++)
+    {
+        offset = (uint32_t)rand() % 8U;
+        length = (iteration < 64U) ? iteration : ((size_t)rand() % 1024U);
+        init = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        lTEST_Fill(data, sizeof(data));
+
+        TEST_ASSERT_EQUAL(lTEST_Crc8(&data[offset], length, (uint8_t)init),
+                          SRV_PCRC_GetValue(&data[offset], length, PCRC_HT_GENERIC, PCRC_CRC8, (uint8_t)init));
+        TEST_ASSERT_EQUAL(lTEST_Crc16(&data[offset], length, (uint16_t)init),
+                          SRV_PCRC_GetValue(&data[offset], length, PCRC_HT_GENERIC, PCRC_CRC16, (uint16_t)init));
+        TEST_ASSERT_EQUAL(lTEST_Crc32(&data[offset], length, init),
+                          SRV_PCRC_GetValue(&data[offset], length, PCRC_HT_GENERIC, PCRC_CRC32, init));
+
+        if (TEST_GetFailures() > 0U)
+        {
+            break;
+        }
+    }
+}
+
+TEST_CASE(pcrc_CheckValues)
+{
+    uint8_t check[] = "123456789";
+
+    /* CRC-8/SMBUS check value */
+    TEST_ASSERT_EQUAL(0xF4U, SRV_PCRC_GetValue(check, 9, PCRC_HT_GENERIC, PCRC_CRC8, 0));
+
+    /* CRC-32/MPEG-2 check value (initial value all ones, no final XOR) */
+    TEST_ASSERT_EQUAL(0x0376E6E7UL, SRV_PCRC_GetValue(check, 9, PCRC_HT_GENERIC, PCRC_CRC32, 0xFFFFFFFFUL));
+}
+
+TEST_CASE(pcrc_ChainedEqualsWhole)
+{
+    static uint8_t data[600];
+    uint32_t iteration, crc;
+    size_t split;
+
+    for (iteration = 0; iteration < 500U; iteration++)
+    {
+        lTEST_Fill(data, sizeof(data));
+        split = (size_t)rand() % sizeof(data);
+
+        crc = SRV_PCRC_GetValue(data, split, PCRC_HT_GENERIC, PCRC_CRC32, 0);
+        crc = SRV_PCRC_GetValue(&data[split], sizeof(data) - split, PCRC_HT_GENERIC, PCRC_CRC32, crc);
+        TEST_ASSERT_EQUAL(SRV_PCRC_GetValue(data, sizeof(data), PCRC_HT_GENERIC, PCRC_CRC32, 0), crc);
+
+        crc = SRV_PCRC_GetValue(data, split, PCRC_HT_USI, PCRC_CRC16, 0);
+        crc = SRV_PCRC_GetValue(&data[split], sizeof(data) - split, PCRC_HT_USI, PCRC_CRC16, crc);
+        TEST_ASSERT_EQUAL(SRV_PCRC_GetValue(data, sizeof(data), PCRC_HT_USI, PCRC_CRC16, 0), crc);
+    }
+}
+
+TEST_CASE(pcrc_UsiCrc8IsXor)
+{
+    uint8_t data[37];
+    uint8_t xor = 0x5AU;
+    size_t index;
+
+    lTEST_Fill(data, sizeof(data));
+    for (index = 0; index < sizeof(data); index++)
+    {
+        xor ^= data[index];
+    }
+
+    TEST_ASSERT_EQUAL(xor, SRV_PCRC_GetValue(data, sizeof(data), PCRC_HT_USI, PCRC_CRC8, 0x5AU));
+}
+
+TEST_CASE(pcrc_PrimeGenericUsesSna)
+{
+    uint8_t sna[PCRC_SNA_SIZE] = {0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC};
+    uint8_t data[64];
+
+    lTEST_Fill(data, sizeof(data));
+    SRV_PCRC_ConfigureSNA(sna);
+
+    TEST_ASSERT_EQUAL(lTEST_Crc32(data, sizeof(data), lTEST_Crc32(sna, sizeof(sna), 0)),
+                      SRV_PCRC_GetValue(data, sizeof(data), PCRC_HT_PRIME_GENERIC, PCRC_CRC32, 0));
+    TEST_ASSERT_EQUAL(lTEST_Crc8(data, sizeof(data), lTEST_Crc8(sna, sizeof(sna), 0)),
+                      SRV_PCRC_GetValue(data, sizeof(data), PCRC_HT_PRIME_GENERIC, PCRC_CRC8, 0));
+    TEST_ASSERT_EQUAL(PCRC_INVALID, SRV_PCRC_GetValue(data, sizeof(data), PCRC_HT_GENERIC, (PCRC_CRC_TYPE)7, 0));
+}
@@ -0,0 +1,358 @@
+/*******************************************************************************
+  PLC PHY Driver Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_plc_phy.c
+
+  Summary:
+    Host tests of the PLC PHY driver.
+
+  Description:
+    Boot, transmission, reception and PIB accesses of the driver on the PL460
+    model.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "driver/plc/phy/drv_plc_phy.h"
+#include "test.h"
+#include "plc_setup.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Back-to-back receptions: frames of 4 to 24 bytes (one or two symbols) */
+#define TEST_PLC_BURST_FRAMES        300U
+#define TEST_PLC_BURST_MIN_LENGTH    4U
+#define TEST_PLC_BURST_LENGTHS       21U
+
+/* Air time of the frames in the PL460 model: header and symbols of 12 bytes */
+#define TEST_PLC_BURST_HEADER_US     6528U
+#define TEST_PLC_BURST_SYMBOL_US     2240U
+#define TEST_PLC_BURST_SYMBOL_BYTES  12U
+
+/* Time spent by the upper layer in each data indication */
+#define TEST_PLC_BURST_CALLBACK_US   1500U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static DRV_PLC_PHY_TRANSMISSION_CFM_OBJ testCfm;
+static uint32_t testCfmCount;
+
+static uint8_t testRxData[TEST_PLC_FRAME_SIZE];
+static DRV_PLC_PHY_RECEPTION_OBJ testInd;
+static uint32_t testIndCount;
+
+static uint32_t testBurstSent;
+static uint32_t testBurstNext;
+static uint32_t testBurstErrors;
+
+static bool testPibResult;
+static uint32_t testPibCount;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Helpers
+// *****************************************************************************
+// *****************************************************************************
+
+static void lTEST_TxCfm(DRV_PLC_PHY_TRANSMISSION_CFM_OBJ *cfmObj, uintptr_t context)
+{
+    testCfm = *cfmObj;
+    testCfmCount++;
+}
+
+static void lTEST_DataInd(DRV_PLC_PHY_RECEPTION_OBJ *indObj, uintptr_t context)
+{
+    testInd = *indObj;
+    (void) memcpy(testRxData, indObj->pReceivedData, indObj->dataLength);
+    testIndCount++;
+}
+
+static void lTEST_Pib(DRV_PLC_PHY_PIB_OBJ *pibObjs, uint8_t numPibs, bool result, uintptr_t context)
+{
+    testPibResult = result;
+    testPibCount++;
+}
+
+static DRV_HANDLE lTEST_Open(void)
+{
+    DRV_HANDLE handle = TEST_PLC_PhyOpen();
+
+    DRV_PLC_PHY_TxCfmCallbackRegister(handle, lTEST_TxCfm, 0);
+    DRV_PLC_PHY_DataIndCallbackRegister(handle, lTEST_DataInd, 0);
+    return handle;
+}
+
+static uint16_t lTEST_BurstLength(uint32_t number)
+{
+    return (uint16_t)(TEST_PLC_BURST_MIN_LENGTH + (number % TEST_PLC_BURST_LENGTHS));
+}
+
+static uint32_t lTEST_BurstAirTime(uint32_t number)
+{
+    uint32_t symbols;
+
+    symbols = ((uint32_t)lTEST_BurstLength(number) + TEST_PLC_BURST_SYMBOL_BYTES - 1U) /
+              TEST_PLC_BURST_SYMBOL_BYTES;
+    return TEST_PLC_BURST_HEADER_US + (symbols * TEST_PLC_BURST_SYMBOL_US);
+}
+
+static void lTEST_BurstFrame(uint32_t number, uint8_t *pData)
+{
+    uint16_t length = lTEST_BurstLength(number);
+    uint16_t index;
+
+    (void) memcpy(pData, &number, sizeof(number));
+    for (index = (uint16_t)sizeof(number); index < length; index++)
+    {
+        pData[index] = (uint8_t)(number + index);
+    }
+}
+
+/* End of a frame in the line: next one starts right after it */
+static void lTEST_BurstReceive(void)
+{
+    uint8_t data[TEST_PLC_BURST_MIN_LENGTH + TEST_PLC_BURST_LENGTHS];
+
+    lTEST_BurstFrame(testBurstSent, data);
+    HOST_PL460_Receive(data, lTEST_BurstLength(testBurstSent));
+
+    if (++testBurstSent < TEST_PLC_BURST_FRAMES)
+    {
+        HOST_TIME_EventSet(lTEST_BurstReceive, HOST_TIME_Get() +
+                           (((uint64_t)lTEST_BurstAirTime(testBurstSent) * HOST_TIME_FREQUENCY) / 1000000U));
+    }
+}
+
+static void lTEST_BurstInd(DRV_PLC_PHY_RECEPTION_OBJ *indObj, uintptr_t context)
+{
+    uint8_t data[TEST_PLC_BURST_MIN_LENGTH + TEST_PLC_BURST_LENGTHS];
+    uint32_t number;
+
+    /* In order, with the data and parameters of the same frame */
+    (void) memcpy(&number, indObj->pReceivedData, sizeof(number));
+    lTEST_BurstFrame(number, data);
+    if ((number < testBurstNext) || (number >= testBurstSent) ||
+        (indObj->dataLength != lTEST_BurstLength(number)) ||
+        (memcmp(indObj->pReceivedData, data, indObj->dataLength) != 0))
+    {
+        testBurstErrors++;
+    }
+
+    testBurstNext = number + 1U;
+    testIndCount++;
+    HOST_TIME_AdvanceUS(TEST_PLC_BURST_CALLBACK_US);
+}
+
+/* Receives a burst of frames with a superloop of up to loopUS between calls
+   to the driver tasks. Returns the frames lost */
+static uint32_t lTEST_Burst(uint32_t loopUS)
+{
+    HOST_PL460_STATS stats;
+    DRV_HANDLE handle;
+    uint32_t lost, overrun;
+
+    handle = lTEST_Open();
+    DRV_PLC_PHY_DataIndCallbackRegister(handle, lTEST_BurstInd, 0);
+    testBurstSent = 0;
+    testBurstNext = 0;
+    testBurstErrors = 0;
+    testIndCount = 0;
+
+    HOST_TIME_EventSet(lTEST_BurstReceive, HOST_TIME_Get() +
+                       (((uint64_t)lTEST_BurstAirTime(0) * HOST_TIME_FREQUENCY) / 1000000U));
+    while (testBurstSent < TEST_PLC_BURST_FRAMES)
+    {
+        DRV_PLC_PHY_Tasks((SYS_MODULE_OBJ)DRV_PLC_PHY_INDEX);
+        HOST_TIME_AdvanceUS((loopUS / 2U) + ((uint32_t)rand() % ((loopUS / 2U) + 1U)));
+    }
+
+    TEST_PLC_PhyRunUntil(&testIndCount, TEST_PLC_BURST_FRAMES, 10U);
+
+    HOST_PL460_GetStats(&stats);
+    overrun = DRV_PLC_PHY_RxOverrunCountGet(handle);
+    lost = TEST_PLC_BURST_FRAMES - testIndCount;
+    printf("  superloop up to %5u us: %3u of %u frames lost (%u overwritten in the PL460, %u discarded by the driver)\n",
+           loopUS, lost, TEST_PLC_BURST_FRAMES, stats.rxOverwritten, overrun);
+
+    /* Frames are lost, never mixed or reordered, and losses are seen */
+    TEST_ASSERT_EQUAL(0U, testBurstErrors);
+    TEST_ASSERT((lost == 0U) || ((stats.rxOverwritten + overrun) > 0U));
+    return lost;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(plcPhy_TransmitConfirm)
+{
+    static uint8_t data[TEST_PLC_FRAME_SIZE];
+    DRV_PLC_PHY_TRANSMISSION_OBJ txObj;
+    HOST_PL460_STATS stats;
+    const HOST_PL460_TX *tx;
+    DRV_HANDLE handle;
+    uint32_t index;
+
+    handle = lTEST_Open();
+
+    for (index = 0; index < 10U; index++)
+    {
+        (void) memset(&txObj, 0, sizeof(txObj));
+        TEST_PLC_Fill(data, 40U + index);
+        txObj.pTransmitData = data;
+        txObj.dataLength = (uint16_t)(40U + index);
+        txObj.timeIni = 1000U;
+        txObj.mode = TX_MODE_RELATIVE;
+        txObj.bufferId = (DRV_PLC_PHY_BUFFER_ID)(index % 2U);
+        txObj.scheme = SCHEME_DBPSK_C;
+        txObj.frameType = FRAME_TYPE_A;
+
+        DRV_PLC_PHY_TxRequest(handle, &txObj);
+        TEST_PLC_PhyRunUntil(&testCfmCount, index + 1U, 100U);
+
+        TEST_ASSERT_EQUAL(index + 1U, testCfmCount);
+        TEST_ASSERT_EQUAL(DRV_PLC_PHY_TX_RESULT_SUCCESS, testCfm.result);
+        TEST_ASSERT_EQUAL(index % 2U, testCfm.bufferId);
+
+        /* Frame in the line as requested */
+        tx = HOST_PL460_GetTx(index);
+        TEST_ASSERT_EQUAL(40U + index, tx->dataLength);
+        TEST_ASSERT_EQUAL(tx->timeIni, testCfm.timeIni);
+        TEST_ASSERT(memcmp(tx->data, data, HOST_PL460_TX_DATA_SIZE) == 0);
+    }
+
+    HOST_PL460_GetStats(&stats);
+    TEST_ASSERT_EQUAL(1U, stats.boots);
+    TEST_ASSERT_EQUAL(0U, stats.guardViolations);
+}
+
+TEST_CASE(plcPhy_ReceiveIndication)
+{
+    static uint8_t data[TEST_PLC_FRAME_SIZE];
+    uint16_t length;
+    uint32_t index;
+
+    (void)lTEST_Open();
+
+    for (index = 0; index < 50U; index++)
+    {
+        length = (uint16_t)(1U + ((uint32_t)rand() % 300U));
+        TEST_PLC_Fill(data, length);
+        HOST_PL460_Receive(data, length);
+        TEST_PLC_PhyRunUntil(&testIndCount, index + 1U, 10U);
+
+        TEST_ASSERT_EQUAL(index + 1U, testIndCount);
+        TEST_ASSERT_EQUAL(length, testInd.dataLength);
+        TEST_ASSERT_EQUAL(SCHEME_DBPSK_C, testInd.scheme);
+        TEST_ASSERT(memcmp(testRxData, data, length) == 0);
+    }
+}
+
+TEST_CASE(plcPhy_BackToBackReception)
+{
+    /* No loss while the superloop and the upper layer return to the driver
+       within the air time of the shortest frame (8768 us) */
+    TEST_ASSERT_EQUAL(0U, lTEST_Burst(7000U));
+}
+
+TEST_CASE(plcPhy_BackToBackReceptionStalls)
+{
+    /* The PL460 keeps the last frame only: longer stalls lose frames */
+    TEST_ASSERT(lTEST_Burst(20000U) > 0U);
+}
+
+TEST_CASE(plcPhy_PibGetSet)
+{
+    DRV_PLC_PHY_PIB_OBJ pibObj;
+    DRV_PLC_PHY_PIB_OBJ pibObjs[2];
+    uint8_t value[16];
+    uint8_t values[2][8];
+    uint8_t read[16];
+    DRV_HANDLE handle;
+
+    handle = lTEST_Open();
+
+    /* Blocking accesses */
+    TEST_PLC_Fill(value, sizeof(value));
+    pibObj.id = PLC_ID_GAIN_TABLE_HI;
+    pibObj.length = (uint16_t)sizeof(value);
+    pibObj.pData = value;
+    TEST_ASSERT(DRV_PLC_PHY_PIBSet(handle, &pibObj));
+    TEST_ASSERT(HOST_PL460_GetPib(PLC_ID_GAIN_TABLE_HI, read, (uint16_t)sizeof(read)));
+    TEST_ASSERT(memcmp(read, value, sizeof(value)) == 0);
+
+    (void) memset(read, 0, sizeof(read));
+    pibObj.pData = read;
+    TEST_ASSERT(DRV_PLC_PHY_PIBGet(handle, &pibObj));
+    TEST_ASSERT(memcmp(read, value, sizeof(value)) == 0);
+
+    /* Requests: done from the tasks */
+    (void) memset(values, 0x5A, sizeof(values));
+    pibObjs[0].id = PLC_ID_GAIN_TABLE_LO;
+    pibObjs[0].length = 8U;
+    pibObjs[0].pData = values[0];
+    pibObjs[1].id = PLC_ID_GAIN_TABLE_VLO;
+    pibObjs[1].length = 8U;
+    pibObjs[1].pData = values[1];
+    TEST_ASSERT(DRV_PLC_PHY_PIBSetRequest(handle, pibObjs, 2U, lTEST_Pib, 0));
+    TEST_PLC_PhyRunUntil(&testPibCount, 1U, 10U);
+    TEST_ASSERT_EQUAL(1U, testPibCount);
+    TEST_ASSERT(testPibResult);
+    TEST_ASSERT(HOST_PL460_GetPib(PLC_ID_GAIN_TABLE_VLO, read, 8U));
+    TEST_ASSERT(memcmp(read, values[1], 8U) == 0);
+
+    (void) memset(values, 0, sizeof(values));
+    TEST_ASSERT(DRV_PLC_PHY_PIBGetRequest(handle, pibObjs, 2U, lTEST_Pib, 0));
+    TEST_PLC_PhyRunUntil(&testPibCount, 2U, 10U);
+    TEST_ASSERT_EQUAL(2U, testPibCount);
+    TEST_ASSERT(testPibResult);
+    TEST_ASSERT_EQUAL(0x5AU, values[0][7]);
+    TEST_ASSERT_EQUAL(0x5AU, values[1][0]);
+}
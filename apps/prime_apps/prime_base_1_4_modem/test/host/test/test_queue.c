@@ -0,0 +1,376 @@
+/*******************************************************************************
+  Queue Service Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_queue.c
+
+  Summary:
+    Host tests of the queue service.
+
+  Description:
+    Random operations are checked against an array model of the queue order.
+    Priority appends keep the order of the original linear search, also after
+    direct insertions and removals of elements in other queues.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "configuration.h"
+#include "service/queue/srv_queue.h"
+#include "test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_QUEUE_ELEMENTS    40U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Reference model
+// *****************************************************************************
+// *****************************************************************************
+
+typedef struct
+{
+    SRV_QUEUE_ELEMENT *order[TEST_QUEUE_ELEMENTS];
+    uint16_t size;
+    uint16_t capacity;
+} TEST_QUEUE_MODEL;
+
+static SRV_QUEUE_ELEMENT testElements[TEST_QUEUE_ELEMENTS];
+
+static int32_t lTEST_ModelFind(TEST_QUEUE_MODEL *model, SRV_QUEUE_ELEMENT *element)
+{
+    uint16_t index;
+
+    for (index = 0; index < model->size; index++)
+    {
+        if (model->order[index] == element)
+        {
+            return (int32_t)index;
+        }
+    }
+
+    return -1;
+}
+
+static void lTEST_ModelInsert(TEST_QUEUE_MODEL *model, uint16_t position,
+                              SRV_QUEUE_ELEMENT *element)
+{
+    if (model->size >= model->capacity)
+    {
+        return;
+    }
+
+    (void) memmove(&model->order[position + 1U], &model->order[position],
+                   (model->size - position) * sizeof(model->order[0]));
+    model->order[position] = element;
+    model->size++;
+}
+
+static void lTEST_ModelRemove(TEST_QUEUE_MODEL *model, uint16_t position)
+{
+    model->size--;
+    (void) memmove(&model->order[position], &model->order[position + 1U],
+                   (model->size - position) * sizeof(model->order[0]));
+}
+
+/* Linear search from the tail of the original implementation */
+static uint16_t lTEST_ModelPriorityPosition(TEST_QUEUE_MODEL *model, uint32_t priority)
+{
+    uint16_t position = model->size;
+
+    while (position > 0U)
+    {
+        if (priority >= model->order[position - 1U]->priority)
+        {
+            break;
+        }
+
+        position--;
+    }
+
+    return position;
+}
+
+static void lTEST_Check(SRV_QUEUE *queue, TEST_QUEUE_MODEL *model)
+{
+    SRV_QUEUE_ELEMENT *element;
+    uint16_t index;
+
+    TEST_ASSERT_EQUAL(model->size, queue->size);
+    if (model->size == 0U)
+    {
+        return;
+    }
+
+    TEST_ASSERT(queue->head == model->order[0]);
+    TEST_ASSERT(queue->tail == model->order[model->size - 1U]);
+    TEST_ASSERT(queue->head->prev == NULL);
+    TEST_ASSERT(queue->tail->next == NULL);
+
+    element = queue->head;
+    for (index = 0; index < model->size; index++)
+    {
+        TEST_ASSERT(element == model->order[index]);
+        TEST_ASSERT(SRV_QUEUE_Read_Element(queue, index) == model->order[index]);
+        if ((element == NULL) || (TEST_GetFailures() > 0U))
+        {
+            return;
+        }
+
+        if (element->next != NULL)
+        {
+            TEST_ASSERT(element->next->prev == element);
+        }
+
+        element = element->next;
+    }
+
+    TEST_ASSERT(SRV_QUEUE_Read_Element(queue, model->size) == NULL);
+}
+
+static void lTEST_RandomOperations(SRV_QUEUE_TYPE type, uint32_t iterations)
+{
+    static SRV_QUEUE queue;
+    static SRV_QUEUE otherQueue;
+    TEST_QUEUE_MODEL model;
+    SRV_QUEUE_ELEMENT *element;
+    SRV_QUEUE_ELEMENT *current;
+    SRV_QUEUE_ELEMENT *other;
+    uint32_t iteration, priority;
+    int32_t found;
+    uint16_t position;
+
+    (void) memset(&model, 0, sizeof(model));
+    model.capacity = 1U + ((uint16_t)rand() % (TEST_QUEUE_ELEMENTS - 8U));
+    SRV_QUEUE_Init(&queue, model.capacity, type);
+    SRV_QUEUE_Init(&otherQueue, 8U, type);
+
+    /* Elements of the other queue must never be removed from this one */
+    for (position = 0; position < 4U; position++)
+    {
+        other = &testElements[TEST_QUEUE_ELEMENTS - 1U - position];
+        other->priority = position;
+        SRV_QUEUE_Append(&otherQueue, other);
+    }
+
+    for (iteration = 0; iteration < iterations; iteration++)
+    {
+        element = &testElements[(uint32_t)rand() % (TEST_QUEUE_ELEMENTS - 4U)];
+        found = lTEST_ModelFind(&model, element);
+
+        switch (rand() % 8)
+        {
+            case 0:
+            case 1:
+                if (found >= 0)
+                {
+                    break;
+                }
+
+                /* Priorities above the constant time levels too */
+                priority = (uint32_t)rand() % (SRV_QUEUE_PRIORITY_LEVELS + 2U);
+                if (type == SRV_QUEUE_TYPE_PRIORITY)
+                {
+                    SRV_QUEUE_Append_With_Priority(&queue, priority, element);
+                    element->priority = priority;
+                    lTEST_ModelInsert(&model, lTEST_ModelPriorityPosition(&model, priority), element);
+                }
+                else
+                {
+                    SRV_QUEUE_Append(&queue, element);
+                    lTEST_ModelInsert(&model, model.size, element);
+                }
+                break;
+
+            case 2:
+                if ((found >= 0) || (model.size == 0U))
+                {
+                    break;
+                }
+
+                position = (uint16_t)rand() % model.size;
+                current = model.order[position];
+                if ((rand() & 1) != 0)
+                {
+                    SRV_QUEUE_Insert_Before(&queue, current, element);
+                }
+                else
+                {
+                    SRV_QUEUE_Insert_After(&queue, current, element);
+                    position++;
+                }
+
+                lTEST_ModelInsert(&model, position, element);
+                break;
+
+            case 3:
+                SRV_QUEUE_Remove_Element(&queue, element);
+                if (found >= 0)
+                {
+                    lTEST_ModelRemove(&model, (uint16_t)found);
+                }
+                break;
+
+            case 4:
+                /* Elements of another queue are ignored */
+                other = &testElements[TEST_QUEUE_ELEMENTS - 1U - ((uint32_t)rand() % 4U)];
+                SRV_QUEUE_Remove_Element(&queue, other);
+                TEST_ASSERT_EQUAL(4U, otherQueue.size);
+                break;
+
+            case 5:
+            case 6:
+                if ((rand() & 1) != 0)
+                {
+                    current = SRV_QUEUE_Read_Or_Remove(&queue, SRV_QUEUE_MODE_REMOVE, SRV_QUEUE_POSITION_HEAD);
+                    TEST_ASSERT(current == ((model.size > 0U) ? model.order[0] : NULL));
+                    position = 0;
+                }
+                else
+                {
+                    current = SRV_QUEUE_Read_Or_Remove(&queue, SRV_QUEUE_MODE_REMOVE, SRV_QUEUE_POSITION_TAIL);
+                    TEST_ASSERT(current == ((model.size > 0U) ? model.order[model.size - 1U] : NULL));
+                    position = model.size - 1U;
+                }
+
+                if (model.size > 0U)
+                {
+                    lTEST_ModelRemove(&model, position);
+                }
+                break;
+
+            default:
+                if ((rand() % 16) == 0)
+                {
+                    SRV_QUEUE_Flush(&queue);
+                    model.size = 0;
+                }
+                break;
+        }
+
+        lTEST_Check(&queue, &model);
+        if (TEST_GetFailures() > 0U)
+        {
+            printf("  iteration %u\n", iteration);
+            return;
+        }
+    }
+
+    lTEST_Check(&otherQueue, &(TEST_QUEUE_MODEL){
+        {&testElements[TEST_QUEUE_ELEMENTS - 1U], &testElements[TEST_QUEUE_ELEMENTS - 2U],
+         &testElements[TEST_QUEUE_ELEMENTS - 3U], &testElements[TEST_QUEUE_ELEMENTS - 4U]}, 4U, 8U});
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(queue_PriorityMatchesModel)
+{
+    uint32_t run;
+
+    TEST_TimeInitialize();
+    for (run = 0; (run < 50U) && (TEST_GetFailures() == 0U); run++)
+    {
+        lTEST_RandomOperations(SRV_QUEUE_TYPE_PRIORITY, 2000U);
+    }
+}
+
+TEST_CASE(queue_SingleMatchesModel)
+{
+    uint32_t run;
+
+    TEST_TimeInitialize();
+    for (run = 0; (run < 50U) && (TEST_GetFailures() == 0U); run++)
+    {
+        lTEST_RandomOperations(SRV_QUEUE_TYPE_SINGLE, 2000U);
+    }
+}
+
+TEST_CASE(queue_FullQueueIgnoresAppend)
+{
+    static SRV_QUEUE queue;
+
+    TEST_TimeInitialize();
+    SRV_QUEUE_Init(&queue, 2U, SRV_QUEUE_TYPE_PRIORITY);
+    SRV_QUEUE_Append_With_Priority(&queue, 3U, &testElements[0]);
+    SRV_QUEUE_Append_With_Priority(&queue, 1U, &testElements[1]);
+    SRV_QUEUE_Append_With_Priority(&queue, 0U, &testElements[2]);
+    SRV_QUEUE_Insert_Before(&queue, &testElements[1], &testElements[3]);
+    SRV_QUEUE_Insert_After(&queue, &testElements[1], &testElements[4]);
+
+    TEST_ASSERT_EQUAL(2U, queue.size);
+    TEST_ASSERT(queue.head == &testElements[1]);
+    TEST_ASSERT(queue.tail == &testElements[0]);
+
+    /* Single queues cannot be appended with priority */
+    SRV_QUEUE_Init(&queue, 2U, SRV_QUEUE_TYPE_SINGLE);
+    SRV_QUEUE_Append_With_Priority(&queue, 3U, &testElements[0]);
+    TEST_ASSERT_EQUAL(0U, queue.size);
+}
+
+TEST_CASE(queue_Statistics)
+{
+    static SRV_QUEUE queue;
+    SRV_QUEUE_STATISTICS stats;
+    uint32_t index;
+
+    TEST_TimeInitialize();
+    SRV_QUEUE_Init(&queue, 8U, SRV_QUEUE_TYPE_SINGLE);
+    for (index = 0; index < 4U; index++)
+    {
+        SRV_QUEUE_Append(&queue, &testElements[index]);
+    }
+
+    /* Each element waits 10 ms */
+    HOST_TIME_AdvanceUS(10000U);
+    SRV_QUEUE_Flush(&queue);
+
+    TEST_ASSERT(SRV_QUEUE_Get_Statistics(&queue, &stats) == true);
+    TEST_ASSERT_EQUAL(4U, stats.maxSize);
+    TEST_ASSERT_EQUAL(4U, stats.appended);
+    TEST_ASSERT_EQUAL(4U, stats.removed);
+    TEST_ASSERT((stats.meanDwellUs >= 9999U) && (stats.meanDwellUs <= 10001U));
+}
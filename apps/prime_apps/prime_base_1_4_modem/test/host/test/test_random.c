@@ -0,0 +1,113 @@
+/*******************************************************************************
+  Random Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_random.c
+
+  Summary:
+    Host tests of the random service.
+
+  Description:
+    Ranges of the values given by the service on the TRNG model.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "definitions.h"
+#include "service/random/srv_random.h"
+#include "test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(random_ValuesInRange)
+{
+    uint32_t index, value, minValue, maxValue;
+    bool minSeen = false;
+    bool maxSeen = false;
+
+    HOST_TRNG_Seed((uint32_t)rand());
+
+    for (index = 0; index < 100000U; index++)
+    {
+        value = SRV_RANDOM_Get16bitsInRange(100, 107);
+        TEST_ASSERT((value >= 100U) && (value <= 107U));
+        minSeen |= (value == 100U);
+        maxSeen |= (value == 107U);
+
+        /* Limits in any order */
+        value = SRV_RANDOM_Get16bitsInRange(0xFFFF, 0xFFF0);
+        TEST_ASSERT(value >= 0xFFF0U);
+
+        minValue = (uint32_t)rand();
+        maxValue = minValue + ((uint32_t)rand() % 1000U);
+        value = SRV_RANDOM_Get32bitsInRange(maxValue, minValue);
+        TEST_ASSERT((value >= minValue) && (value <= maxValue));
+
+        TEST_ASSERT_EQUAL(5U, SRV_RANDOM_Get32bitsInRange(5, 5));
+    }
+
+    TEST_ASSERT(minSeen && maxSeen);
+}
+
+TEST_CASE(random_128bitsFromTrng)
+{
+    uint8_t value[16];
+    uint8_t expected[16];
+    uint32_t word, index;
+
+    HOST_TRNG_Seed(0x2468ACE1U);
+    for (index = 0; index < 4U; index++)
+    {
+        word = TRNG_ReadData();
+        expected[(index << 2)] = (uint8_t)(word >> 24);
+        expected[(index << 2) + 1U] = (uint8_t)(word >> 16);
+        expected[(index << 2) + 2U] = (uint8_t)(word >> 8);
+        expected[(index << 2) + 3U] = (uint8_t)word;
+    }
+
+    HOST_TRNG_Seed(0x2468ACE1U);
+    SRV_RANDOM_Get128bits(value);
+    TEST_ASSERT(memcmp(value, expected, sizeof(value)) == 0);
+
+    /* Following values differ */
+    SRV_RANDOM_Get128bits(expected);
+    TEST_ASSERT(memcmp(value, expected, sizeof(value)) != 0);
+}
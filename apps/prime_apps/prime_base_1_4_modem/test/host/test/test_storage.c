@@ -0,0 +1,413 @@
+/*******************************************************************************
+  Storage Service Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_storage.c
+
+  Summary:
+    Host tests of the storage service over the SEFC0 User Signature model.
+
+  Description:
+    Updates run in boots that can be ended by a power cut at a random
+    time. The next boot checks that no acknowledged data was lost and that
+    the data being written is either the old or the new one.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "service/storage/srv_storage.h"
+#include "test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+#define TEST_STORAGE_MAX_SIZE    sizeof(SRV_STORAGE_FU_INFO_CONFIG)
+
+/* No update in progress */
+#define TEST_STORAGE_NO_TYPE     0xFFU
+
+/* Power cut windows: a few writes of journal pages, and erase of a block
+   plus write of a page (see the SEFC0 model timings) */
+#define TEST_STORAGE_CUT_WRITE   (HOST_TIME_FREQUENCY / 200U)
+#define TEST_STORAGE_CUT_ERASE   (HOST_TIME_FREQUENCY / 15U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Test state kept across boots */
+typedef struct
+{
+    uint8_t acked[SRV_STORAGE_TYPE_END_LIST][TEST_STORAGE_MAX_SIZE];
+    uint8_t pending[TEST_STORAGE_MAX_SIZE];
+    uint8_t pendingType;
+    uint32_t keptNew;
+    uint32_t keptOld;
+
+} TEST_STORAGE_STATE;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Size used by the stack for each type */
+static const uint8_t testStorageSizes[SRV_STORAGE_TYPE_END_LIST] = {
+    sizeof(SRV_STORAGE_MAC_CONFIG),
+    sizeof(SRV_STORAGE_PHY_CONFIG),
+    sizeof(SRV_STORAGE_BN_INFO_CONFIG),
+    sizeof(SRV_STORAGE_PRIME_MODE_INFO_CONFIG),
+    sizeof(SRV_STORAGE_SEC_CONFIG),
+    sizeof(SRV_STORAGE_BOOT_CONFIG),
+    sizeof(SRV_STORAGE_FU_INFO_CONFIG)
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Boots
+// *****************************************************************************
+// *****************************************************************************
+
+static void lTEST_CheckData(TEST_STORAGE_STATE *state)
+{
+    uint8_t data[TEST_STORAGE_MAX_SIZE];
+    uint8_t size;
+    uint8_t infoType;
+
+    for (infoType = 0; infoType < (uint8_t)SRV_STORAGE_TYPE_END_LIST; infoType++)
+    {
+        size = testStorageSizes[infoType];
+        TEST_ASSERT(SRV_STORAGE_GetConfigInfo((SRV_STORAGE_TYPE)infoType, size, data) == true);
+
+        if (infoType != state->pendingType)
+        {
+            /* Acknowledged data is never lost */
+            TEST_ASSERT(memcmp(state->acked[infoType], data, size) == 0);
+        }
+        else if (memcmp(state->pending, data, size) == 0)
+        {
+            state->keptNew++;
+            (void) memcpy(state->acked[infoType], data, size);
+        }
+        else if (infoType == (uint8_t)SRV_STORAGE_TYPE_BOOT_INFO)
+        {
+            /* Block 0 is erased to write the boot information: a cut meanwhile
+               damages it. The journal types in it are read from the journal */
+            state->keptOld++;
+            (void) memcpy(state->acked[infoType], data, size);
+        }
+        else
+        {
+            /* Journal types roll back to the old data */
+            state->keptOld++;
+            TEST_ASSERT(memcmp(state->acked[infoType], data, size) == 0);
+        }
+    }
+
+    state->pendingType = TEST_STORAGE_NO_TYPE;
+}
+
+static void lTEST_Update(TEST_STORAGE_STATE *state)
+{
+    uint8_t infoType;
+    uint8_t size;
+    uint32_t index;
+
+    /* Update a few bytes of a type, boot information less often */
+    infoType = (uint8_t)((uint32_t)rand() % ((uint32_t)SRV_STORAGE_TYPE_END_LIST - 1U));
+    if (infoType >= (uint8_t)SRV_STORAGE_TYPE_BOOT_INFO)
+    {
+        infoType++;
+    }
+
+    if ((rand() % 10) == 0)
+    {
+        infoType = (uint8_t)SRV_STORAGE_TYPE_BOOT_INFO;
+    }
+
+    size = testStorageSizes[infoType];
+    (void) memcpy(state->pending, state->acked[infoType], size);
+    for (index = 0; index < 4U; index++)
+    {
+        state->pending[(uint32_t)rand() % size] = (uint8_t)rand();
+    }
+
+    state->pendingType = infoType;
+    TEST_ASSERT(SRV_STORAGE_SetConfigInfo((SRV_STORAGE_TYPE)infoType, size, state->pending) == true);
+    TEST_ASSERT(SRV_STORAGE_Flush() == true);
+
+    /* Written: acknowledged */
+    (void) memcpy(state->acked[infoType], state->pending, size);
+    state->pendingType = TEST_STORAGE_NO_TYPE;
+}
+
+static int lTEST_UpdateBoot(uintptr_t context)
+{
+    TEST_STORAGE_STATE *state = (TEST_STORAGE_STATE *)context;
+    uint32_t updates;
+
+    TEST_TimeInitialize();
+    SRV_STORAGE_Initialize();
+
+    lTEST_CheckData(state);
+
+    /* Several updates per boot, so the journal state in RAM is used too */
+    updates = 1U + ((uint32_t)rand() % 3U);
+    while ((updates-- > 0U) && (TEST_GetFailures() == 0U))
+    {
+        lTEST_Update(state);
+    }
+
+    return (int)TEST_GetFailures();
+}
+
+static int lTEST_FirstBoot(uintptr_t context)
+{
+    TEST_STORAGE_STATE *state = (TEST_STORAGE_STATE *)context;
+    uint8_t infoType;
+    uint32_t index;
+
+    TEST_TimeInitialize();
+    SRV_STORAGE_Initialize();
+
+    /* Every type written once, so the journal holds all of them */
+    for (infoType = 0; infoType < (uint8_t)SRV_STORAGE_TYPE_END_LIST; infoType++)
+    {
+        for (index = 0; index < testStorageSizes[infoType]; index++)
+        {
+            state->acked[infoType][index] = (uint8_t)rand();
+        }
+
+        TEST_ASSERT(SRV_STORAGE_SetConfigInfo((SRV_STORAGE_TYPE)infoType, testStorageSizes[infoType], state->acked[infoType]) == true);
+    }
+
+    TEST_ASSERT(SRV_STORAGE_Flush() == true);
+    state->pendingType = TEST_STORAGE_NO_TYPE;
+
+    return (int)TEST_GetFailures();
+}
+
+static int lTEST_CheckBoot(uintptr_t context)
+{
+    TEST_TimeInitialize();
+    SRV_STORAGE_Initialize();
+    lTEST_CheckData((TEST_STORAGE_STATE *)context);
+
+    return (int)TEST_GetFailures();
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(storage_PowerCutsKeepAcknowledgedData)
+{
+    TEST_STORAGE_STATE *state = HOST_NvmAlloc(sizeof(TEST_STORAGE_STATE));
+    HOST_SEFC0_STATS stats;
+    uint64_t cutAt;
+    uint32_t boot, window, cuts = 0;
+    int result;
+
+    TEST_ASSERT_EQUAL(0, HOST_Boot(lTEST_FirstBoot, (uintptr_t)state, HOST_BOOT_NO_CUT));
+
+    for (boot = 0; (boot < 1000U) && (TEST_GetFailures() == 0U); boot++)
+    {
+        cutAt = HOST_BOOT_NO_CUT;
+        if ((rand() % 2) == 0)
+        {
+            window = ((rand() % 4) == 0) ? TEST_STORAGE_CUT_ERASE : TEST_STORAGE_CUT_WRITE;
+            cutAt = HOST_TIME_Get() + ((uint32_t)rand() % window);
+        }
+
+        result = HOST_Boot(lTEST_UpdateBoot, (uintptr_t)state, cutAt);
+        if (result == HOST_BOOT_POWER_CUT)
+        {
+            cuts++;
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(0, result);
+        }
+    }
+
+    TEST_ASSERT_EQUAL(0, HOST_Boot(lTEST_CheckBoot, (uintptr_t)state, HOST_BOOT_NO_CUT));
+
+    /* Cuts in the middle of writes. A write is acknowledged as soon as it
+       ends, so the data being written is mostly rolled back */
+    printf("  %u boots, %u power cuts: new data kept %u, old data kept %u\n",
+           boot, cuts, state->keptNew, state->keptOld);
+    TEST_ASSERT(cuts > 100U);
+    TEST_ASSERT(state->keptOld > 0U);
+
+    /* Each 128-bit ECC unit programmed once per erase, commands only issued
+       with the flash ready and the right blocks enabled */
+    HOST_SEFC0_GetStats(&stats);
+    TEST_ASSERT_EQUAL(0U, stats.eccRewrites);
+    TEST_ASSERT_EQUAL(0U, stats.busyCommands);
+    TEST_ASSERT_EQUAL(0U, stats.rightsErrors);
+    TEST_ASSERT(stats.erases > 0U);
+}
+
+TEST_CASE(storage_TasksWriteAfterDelay)
+{
+    SRV_STORAGE_MAC_CONFIG macConfig = {SRV_STORAGE_MAC_CFG_KEY, {1, 2, 3, 4, 5, 6}};
+    SRV_STORAGE_PRIME_MODE_INFO_CONFIG modeConfig = {SRV_STORAGE_PRIME_MODE_INFO_CFG_KEY, 4, 1};
+    SRV_STORAGE_MAC_CONFIG readConfig;
+    SRV_STORAGE_PRIME_MODE_INFO_CONFIG readMode;
+    HOST_SEFC0_STATS stats;
+    uint32_t step;
+
+    TEST_TimeInitialize();
+    SRV_STORAGE_Initialize();
+    TEST_ASSERT(SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE_MAC_INFO, sizeof(macConfig), &macConfig) == true);
+    TEST_ASSERT(SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE_MODE_PRIME, sizeof(modeConfig), &modeConfig) == true);
+
+    /* Changes are kept in RAM during the write delay */
+    for (step = 0; step < 9U; step++)
+    {
+        HOST_TIME_AdvanceUS(100000U);
+        SRV_STORAGE_Tasks();
+    }
+
+    HOST_SEFC0_GetStats(&stats);
+    TEST_ASSERT_EQUAL(0U, stats.erases);
+    TEST_ASSERT_EQUAL(0U, stats.writes);
+    TEST_ASSERT(SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE_MAC_INFO, sizeof(readConfig), &readConfig) == true);
+    TEST_ASSERT(memcmp(&macConfig, &readConfig, sizeof(macConfig)) == 0);
+    TEST_ASSERT(SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE_MODE_PRIME, sizeof(readMode), &readMode) == true);
+    TEST_ASSERT(memcmp(&modeConfig, &readMode, sizeof(modeConfig)) == 0);
+
+    /* First write of the journal: compaction of both changes to a new
+       block, header and records in a single page program */
+    for (step = 0; step < 20U; step++)
+    {
+        HOST_TIME_AdvanceUS(10000U);
+        SRV_STORAGE_Tasks();
+    }
+
+    HOST_SEFC0_GetStats(&stats);
+    TEST_ASSERT_EQUAL(1U, stats.erases);
+    TEST_ASSERT_EQUAL(1U, stats.writes);
+    TEST_ASSERT_EQUAL(0U, stats.busyCommands);
+    TEST_ASSERT_EQUAL(0U, stats.rightsErrors);
+
+    /* Same data again: nothing to write */
+    TEST_ASSERT(SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE_MAC_INFO, sizeof(macConfig), &macConfig) == true);
+    TEST_ASSERT(SRV_STORAGE_Flush() == true);
+    HOST_SEFC0_GetStats(&stats);
+    TEST_ASSERT_EQUAL(1U, stats.erases);
+
+    /* Invalid type and size */
+    TEST_ASSERT(SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE_END_LIST, 1, &macConfig) == false);
+    TEST_ASSERT(SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE_FU_INFO, 200, &readConfig) == false);
+
+    /* Data read again from User Signature */
+    SRV_STORAGE_Initialize();
+    TEST_ASSERT(SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE_MAC_INFO, sizeof(readConfig), &readConfig) == true);
+    TEST_ASSERT(memcmp(&macConfig, &readConfig, sizeof(macConfig)) == 0);
+}
+
+TEST_CASE(storage_FlushWritesPendingData)
+{
+    SRV_STORAGE_MAC_CONFIG macConfig = {SRV_STORAGE_MAC_CFG_KEY, {6, 5, 4, 3, 2, 1}};
+    SRV_STORAGE_MAC_CONFIG readConfig;
+    HOST_SEFC0_STATS stats;
+
+    TEST_TimeInitialize();
+    SRV_STORAGE_Initialize();
+
+    /* Configuration set just before a reset */
+    TEST_ASSERT(SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE_MAC_INFO, sizeof(macConfig), &macConfig) == true);
+    HOST_SEFC0_GetStats(&stats);
+    TEST_ASSERT_EQUAL(0U, stats.writes);
+
+    TEST_ASSERT(SRV_STORAGE_Flush() == true);
+    HOST_SEFC0_GetStats(&stats);
+    TEST_ASSERT_EQUAL(1U, stats.erases);
+    TEST_ASSERT_EQUAL(1U, stats.writes);
+
+    SRV_STORAGE_Initialize();
+    TEST_ASSERT(SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE_MAC_INFO, sizeof(readConfig), &readConfig) == true);
+    TEST_ASSERT(memcmp(&macConfig, &readConfig, sizeof(macConfig)) == 0);
+}
+
+TEST_CASE(storage_BootAndUpgradeInfoWrittenAtOnce)
+{
+    SRV_STORAGE_BOOT_CONFIG bootConfig = {SRV_STORAGE_BOOT_CFG_KEY, 0x20000U, 0x1000000U, 0x1080000U, 0, 1};
+    SRV_STORAGE_MAC_CONFIG macConfig = {SRV_STORAGE_MAC_CFG_KEY, {1, 1, 2, 2, 3, 3}};
+    SRV_STORAGE_FU_INFO_CONFIG fuConfig;
+    SRV_STORAGE_BOOT_CONFIG readBoot;
+    SRV_STORAGE_MAC_CONFIG readMac;
+    SRV_STORAGE_FU_INFO_CONFIG readFu;
+    HOST_SEFC0_STATS stats;
+
+    TEST_TimeInitialize();
+    SRV_STORAGE_Initialize();
+
+    /* A pending change is written with the boot information, without
+       waiting for the write delay or a flush */
+    TEST_ASSERT(SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE_MAC_INFO, sizeof(macConfig), &macConfig) == true);
+    TEST_ASSERT(SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE_BOOT_INFO, sizeof(bootConfig), &bootConfig) == true);
+    HOST_SEFC0_GetStats(&stats);
+    TEST_ASSERT_EQUAL(2U, stats.erases);
+    TEST_ASSERT_EQUAL(2U, stats.writes);
+
+    (void) memset(&fuConfig, 0x5A, sizeof(fuConfig));
+    TEST_ASSERT(SRV_STORAGE_SetConfigInfo(SRV_STORAGE_TYPE_FU_INFO, sizeof(fuConfig), &fuConfig) == true);
+    HOST_SEFC0_GetStats(&stats);
+    TEST_ASSERT_EQUAL(2U, stats.erases);
+    TEST_ASSERT_EQUAL(3U, stats.writes);
+
+    /* Read after a reset that does not flush (watchdog, brown-out) */
+    SRV_STORAGE_Initialize();
+    TEST_ASSERT(SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE_BOOT_INFO, sizeof(readBoot), &readBoot) == true);
+    TEST_ASSERT(memcmp(&bootConfig, &readBoot, sizeof(bootConfig)) == 0);
+    TEST_ASSERT(SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE_MAC_INFO, sizeof(readMac), &readMac) == true);
+    TEST_ASSERT(memcmp(&macConfig, &readMac, sizeof(macConfig)) == 0);
+    TEST_ASSERT(SRV_STORAGE_GetConfigInfo(SRV_STORAGE_TYPE_FU_INFO, sizeof(readFu), &readFu) == true);
+    TEST_ASSERT(memcmp(&fuConfig, &readFu, sizeof(fuConfig)) == 0);
+}
@@ -0,0 +1,484 @@
+/*******************************************************************************
+  SYS_TIME Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_sys_time.c
+
+  Summary:
+    Host tests of the timer wheel of the time system service.
+
+  Description:
+    Timers are checked against the TC0 counter of the model: expiries in
+    every level of the wheel, across the wrap around of the 32-bit counter,
+    timers reloaded, stopped and destroyed from their callbacks, and 25, 100
+    and 500 timers added and cancelled while others expire. Built with a pool
+    of SYS_TIME_MAX_TIMERS objects large enough for the last case.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <time.h>
+#include "definitions.h"
+#include "test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Compare margin of SYS_TIME (SYS_TIME_COMPARE_UPDATE_EXECUTION_CYCLES plus
+   2 counts): closer expiries are signaled that late */
+#define TEST_TIME_MARGIN             3U
+
+/* Expiries of the cascade test, in every level of the wheel */
+#define TEST_TIME_CASCADE_TIMERS     16U
+
+/* Events of the callbacks test */
+#define TEST_TIME_EVENTS             32U
+
+/* Load test: timers, time and callback duration */
+#define TEST_TIME_LOAD_MAX           500U
+#define TEST_TIME_LOAD_MS            60000U
+#define TEST_TIME_LOAD_CALLBACK_US   2U
+/* Interrupt latency: TC0 counter read time, in counts */
+#define TEST_TIME_LOAD_READ_COST     2U
+/* Late-fire time allowed: a few callbacks due at the same time */
+#define TEST_TIME_LOAD_LATE_US       50U
+/* Main loop step, random up to this value */
+#define TEST_TIME_LOAD_STEP_US       2000U
+
+/* Contexts of the callbacks test */
+#define TEST_TIME_RELOADED           1U
+#define TEST_TIME_SELF_DESTROYED     2U
+#define TEST_TIME_KILLER             3U
+#define TEST_TIME_KILLED             4U
+#define TEST_TIME_CREATED            5U
+#define TEST_TIME_STOPPED            6U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Timer of the load test, in the pool or not */
+typedef struct
+{
+    uint64_t expected;
+    uint32_t period;
+    uint32_t generation;
+    SYS_TIME_HANDLE handle;
+    bool active;
+} TEST_TIME_LOAD_TIMER;
+
+/* Callback of the callbacks test */
+typedef struct
+{
+    uintptr_t context;
+    uint64_t time;
+} TEST_TIME_EVENT;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Delays (counts) of the cascade test. With 512-count ticks, each level of
+   the wheel spans 2^15, 2^21, 2^27 and 2^33 counts */
+static const uint32_t testCascadeDelays[TEST_TIME_CASCADE_TIMERS] = {
+    1U, 100U, 511U, 512U, 513U, 32767U, 32768U, 32769U,
+    2097151U, 2097157U, 134217805U, 1000000007U, 0x7FFFFFFFU, 0x80000001U,
+    0xC0000003U, 0xFFFFFFF0U
+};
+
+static uint64_t testCascadeFired[TEST_TIME_CASCADE_TIMERS];
+
+static TEST_TIME_EVENT testEvents[TEST_TIME_EVENTS];
+static uint32_t testEventsCount;
+static uint32_t testReloadedCount;
+static SYS_TIME_HANDLE testReloaded;
+static SYS_TIME_HANDLE testSelfDestroyed;
+static SYS_TIME_HANDLE testKilled;
+static SYS_TIME_HANDLE testStopped;
+
+static TEST_TIME_LOAD_TIMER testLoad[TEST_TIME_LOAD_MAX];
+static uint32_t testLoadExpired;
+static uint32_t testLoadErrors;
+static uint64_t testLoadLateMax;
+static uint64_t testLoadLateSum;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint64_t lTEST_HostNs(void)
+{
+    struct timespec now;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t lTEST_CountsToUS(uint64_t counts)
+{
+    return (uint32_t)((counts * 1000000U) / HOST_TIME_FREQUENCY);
+}
+
+static void lTEST_CascadeCallback(uintptr_t context)
+{
+    testCascadeFired[context] = HOST_TIME_Get();
+}
+
+/* Single shot timers in every level of the wheel, all started at the same
+   count, expire at their exact count */
+static void lTEST_Cascade(void)
+{
+    SYS_TIME_HANDLE handle;
+    uint64_t start = HOST_TIME_Get();
+    uint64_t expected;
+    uint32_t index;
+
+    for (index = 0; index < TEST_TIME_CASCADE_TIMERS; index++)
+    {
+        testCascadeFired[index] = 0;
+        handle = SYS_TIME_TimerCreate(0, testCascadeDelays[index], lTEST_CascadeCallback, index, SYS_TIME_SINGLE);
+        TEST_ASSERT(handle != SYS_TIME_HANDLE_INVALID);
+        TEST_ASSERT_EQUAL(SYS_TIME_SUCCESS, SYS_TIME_TimerStart(handle));
+    }
+
+    /* Counter reads take no time: all of them started at "start" */
+    TEST_ASSERT_EQUAL(start, HOST_TIME_Get());
+
+    for (index = 0; index < 5U; index++)
+    {
+        HOST_TIME_AdvanceCounts(0x40000000U);
+    }
+
+    for (index = 0; index < TEST_TIME_CASCADE_TIMERS; index++)
+    {
+        expected = start + testCascadeDelays[index];
+        TEST_ASSERT(testCascadeFired[index] >= expected);
+        TEST_ASSERT(testCascadeFired[index] <= (expected + TEST_TIME_MARGIN));
+    }
+}
+
+static void lTEST_EventCallback(uintptr_t context)
+{
+    if (testEventsCount < TEST_TIME_EVENTS)
+    {
+        testEvents[testEventsCount].context = context;
+        testEvents[testEventsCount].time = HOST_TIME_Get();
+    }
+
+    testEventsCount++;
+
+    switch (context)
+    {
+        case TEST_TIME_RELOADED:
+            /* Third expiry: 25 ms period from now on */
+            testReloadedCount++;
+            if (testReloadedCount == 3U)
+            {
+                TEST_ASSERT_EQUAL(SYS_TIME_SUCCESS, SYS_TIME_TimerReload(testReloaded, 0, SYS_TIME_MSToCount(25),
+                                                                      lTEST_EventCallback, TEST_TIME_RELOADED,
+                                                                      SYS_TIME_PERIODIC));
+            }
+            break;
+
+        case TEST_TIME_SELF_DESTROYED:
+            /* Its object is taken by the timer created right after */
+            TEST_ASSERT_EQUAL(SYS_TIME_SUCCESS, SYS_TIME_TimerDestroy(testSelfDestroyed));
+            TEST_ASSERT(SYS_TIME_CallbackRegisterMS(lTEST_EventCallback, TEST_TIME_CREATED, 4,
+                                                    SYS_TIME_SINGLE) != SYS_TIME_HANDLE_INVALID);
+            break;
+
+        case TEST_TIME_KILLER:
+            TEST_ASSERT_EQUAL(SYS_TIME_SUCCESS, SYS_TIME_TimerDestroy(testKilled));
+            break;
+
+        case TEST_TIME_STOPPED:
+            TEST_ASSERT_EQUAL(SYS_TIME_SUCCESS, SYS_TIME_TimerStop(testStopped));
+            break;
+
+        default:
+            break;
+    }
+}
+
+static bool lTEST_EventAt(uint32_t index, uintptr_t context, uint64_t start, uint32_t ms)
+{
+    uint64_t expected = start + ((uint64_t)ms * HOST_TIME_FREQUENCY) / 1000U;
+
+    return (testEvents[index].context == context) && (testEvents[index].time >= (expected - 1U)) &&
+           (testEvents[index].time <= (expected + TEST_TIME_MARGIN + 1U));
+}
+
+static void lTEST_LoadCallback(uintptr_t context)
+{
+    TEST_TIME_LOAD_TIMER *timer = &testLoad[context & 0xFFFFU];
+    uint64_t now = HOST_TIME_Get();
+
+    /* Never for a cancelled timer nor before its time */
+    if ((timer->active == false) || (timer->generation != (context >> 16)) || (now < timer->expected))
+    {
+        testLoadErrors++;
+        return;
+    }
+
+    testLoadExpired++;
+    testLoadLateSum += now - timer->expected;
+    if ((now - timer->expected) > testLoadLateMax)
+    {
+        testLoadLateMax = now - timer->expected;
+    }
+
+    if (timer->period == 0U)
+    {
+        timer->active = false;
+    }
+    else
+    {
+        /* Next period from the previous expiry: no drift */
+        timer->expected += timer->period;
+    }
+
+    /* Work done in the callback delays the next ones */
+    HOST_TIME_AdvanceUS(TEST_TIME_LOAD_CALLBACK_US);
+}
+
+static void lTEST_LoadAdd(uint32_t index, uint32_t period, uint32_t delay)
+{
+    TEST_TIME_LOAD_TIMER *timer = &testLoad[index];
+
+    timer->generation++;
+    timer->period = period;
+    timer->expected = HOST_TIME_Get() + ((period == 0U) ? delay : period);
+    timer->active = true;
+    timer->handle = SYS_TIME_TimerCreate(0, (period == 0U) ? delay : period, lTEST_LoadCallback,
+                                         (uintptr_t)(index | (timer->generation << 16)),
+                                         (period == 0U) ? SYS_TIME_SINGLE : SYS_TIME_PERIODIC);
+    TEST_ASSERT(timer->handle != SYS_TIME_HANDLE_INVALID);
+    TEST_ASSERT_EQUAL(SYS_TIME_SUCCESS, SYS_TIME_TimerStart(timer->handle));
+}
+
+/* Half of the timers periodic (1 ms to 1 s), half single shot (100 us to 2 s)
+   cancelled and added again at random. Checks that no cancelled timer
+   expires, that periodic timers do not drift and that the statistics match
+   the late-fire times seen by the callbacks */
+static void lTEST_Load(uint32_t timers)
+{
+    SYS_TIME_STATISTICS stats;
+    uint64_t hostNs, addNs = 0, cancelNs = 0;
+    uint64_t end;
+    uint32_t adds = 0, cancels = 0;
+    uint32_t index;
+
+    TEST_TimeInitialize();
+    HOST_TIME_SetReadCost(TEST_TIME_LOAD_READ_COST);
+    (void) memset(testLoad, 0, sizeof(testLoad));
+    testLoadExpired = 0;
+    testLoadErrors = 0;
+    testLoadLateMax = 0;
+    testLoadLateSum = 0;
+
+    for (index = 0; index < timers; index++)
+    {
+        if (index < (timers / 2U))
+        {
+            lTEST_LoadAdd(index, SYS_TIME_USToCount(1000U + ((uint32_t)rand() % 999000U)), 0);
+        }
+        else
+        {
+            lTEST_LoadAdd(index, 0, SYS_TIME_USToCount(100U + ((uint32_t)rand() % 1999900U)));
+        }
+    }
+
+    end = HOST_TIME_Get() + (((uint64_t)TEST_TIME_LOAD_MS * HOST_TIME_FREQUENCY) / 1000U);
+    while (HOST_TIME_Get() < end)
+    {
+        HOST_TIME_AdvanceUS(1U + ((uint32_t)rand() % TEST_TIME_LOAD_STEP_US));
+
+        /* One single shot timer: cancelled if pending, then added again */
+        index = (timers / 2U) + ((uint32_t)rand() % (timers - (timers / 2U)));
+        if (testLoad[index].active == true)
+        {
+            hostNs = lTEST_HostNs();
+            TEST_ASSERT_EQUAL(SYS_TIME_SUCCESS, SYS_TIME_TimerDestroy(testLoad[index].handle));
+            cancelNs += lTEST_HostNs() - hostNs;
+            cancels++;
+            testLoad[index].active = false;
+        }
+
+        hostNs = lTEST_HostNs();
+        lTEST_LoadAdd(index, 0, SYS_TIME_USToCount(100U + ((uint32_t)rand() % 1999900U)));
+        addNs += lTEST_HostNs() - hostNs;
+        adds++;
+    }
+
+    SYS_TIME_StatisticsGet(&stats);
+    printf("  %u timers: add %u ns, cancel %u ns (host), %u expired, late %u us max, %u us mean\n",
+           timers, (uint32_t)(addNs / adds), (uint32_t)(cancelNs / cancels), testLoadExpired,
+           lTEST_CountsToUS(testLoadLateMax), lTEST_CountsToUS(testLoadLateSum / testLoadExpired));
+
+    TEST_ASSERT_EQUAL(0U, testLoadErrors);
+    TEST_ASSERT_EQUAL(0U, stats.createErrors);
+    TEST_ASSERT_EQUAL(testLoadExpired, stats.expiredCount);
+    TEST_ASSERT(stats.timersHighWater >= timers);
+    TEST_ASSERT(stats.timersInUse <= timers);
+
+    /* Late by the callbacks run before in the same interrupt, not by drift */
+    TEST_ASSERT(lTEST_CountsToUS(testLoadLateMax) < TEST_TIME_LOAD_LATE_US);
+    TEST_ASSERT(stats.lateMaxUS <= (lTEST_CountsToUS(testLoadLateMax) + 1U));
+
+    /* All pending timers still to expire */
+    for (index = 0; index < timers; index++)
+    {
+        if (testLoad[index].active == true)
+        {
+            TEST_ASSERT(testLoad[index].expected >= (HOST_TIME_Get() - SYS_TIME_USToCount(TEST_TIME_LOAD_LATE_US)));
+        }
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(sysTime_WheelCascade)
+{
+    TEST_TimeInitialize();
+    lTEST_Cascade();
+
+    /* And again from a wheel position other than 0 */
+    HOST_TIME_AdvanceCounts(123456789U);
+    lTEST_Cascade();
+}
+
+TEST_CASE(sysTime_WheelCounterWrap)
+{
+    SYS_TIME_STATISTICS stats;
+
+    /* TC0 counter 20000 counts before its wrap around */
+    TEST_TimeInitialize();
+    HOST_TIME_AdvanceCounts(0xFFFFFFFFU - 20000U);
+    TEST_ASSERT_EQUAL(0xFFFFFFFFU - 20000U, TC0_CH0_TimerCounterGet());
+
+    lTEST_Cascade();
+
+    SYS_TIME_StatisticsGet(&stats);
+    TEST_ASSERT_EQUAL(TEST_TIME_CASCADE_TIMERS, stats.expiredCount);
+    TEST_ASSERT_EQUAL(0U, stats.timersInUse);
+    TEST_ASSERT(stats.lateMaxUS <= 2U);
+}
+
+TEST_CASE(sysTime_WheelCallbacks)
+{
+    SYS_TIME_STATISTICS stats;
+    uint64_t start, restart;
+    uint32_t index;
+
+    TEST_TimeInitialize();
+    testEventsCount = 0;
+    testReloadedCount = 0;
+    start = HOST_TIME_Get();
+
+    testReloaded = SYS_TIME_CallbackRegisterMS(lTEST_EventCallback, TEST_TIME_RELOADED, 10, SYS_TIME_PERIODIC);
+    testSelfDestroyed = SYS_TIME_CallbackRegisterMS(lTEST_EventCallback, TEST_TIME_SELF_DESTROYED, 7, SYS_TIME_PERIODIC);
+    TEST_ASSERT(SYS_TIME_CallbackRegisterMS(lTEST_EventCallback, TEST_TIME_KILLER, 12, SYS_TIME_SINGLE) != SYS_TIME_HANDLE_INVALID);
+    testKilled = SYS_TIME_CallbackRegisterMS(lTEST_EventCallback, TEST_TIME_KILLED, 40, SYS_TIME_SINGLE);
+    testStopped = SYS_TIME_CallbackRegisterMS(lTEST_EventCallback, TEST_TIME_STOPPED, 9, SYS_TIME_PERIODIC);
+    TEST_ASSERT(testReloaded != SYS_TIME_HANDLE_INVALID);
+    TEST_ASSERT(testSelfDestroyed != SYS_TIME_HANDLE_INVALID);
+    TEST_ASSERT(testKilled != SYS_TIME_HANDLE_INVALID);
+    TEST_ASSERT(testStopped != SYS_TIME_HANDLE_INVALID);
+
+    /* 50 ms, then the stopped timer started again */
+    for (index = 0; index < 500U; index++)
+    {
+        HOST_TIME_AdvanceUS(100U);
+    }
+
+    restart = HOST_TIME_Get();
+    TEST_ASSERT_EQUAL(SYS_TIME_SUCCESS, SYS_TIME_TimerStart(testStopped));
+
+    /* Up to 100 ms */
+    for (index = 0; index < 500U; index++)
+    {
+        HOST_TIME_AdvanceUS(100U);
+    }
+
+    /* Stopped at 9 ms, created by the self destroyed one at 7 + 4 ms, killer
+     * at 12 ms, reloaded at 30 ms with a 25 ms period, restarted at 50 ms */
+    TEST_ASSERT_EQUAL(10U, testEventsCount);
+    TEST_ASSERT(lTEST_EventAt(0, TEST_TIME_SELF_DESTROYED, start, 7));
+    TEST_ASSERT(lTEST_EventAt(1, TEST_TIME_STOPPED, start, 9));
+    TEST_ASSERT(lTEST_EventAt(2, TEST_TIME_RELOADED, start, 10));
+    TEST_ASSERT(lTEST_EventAt(3, TEST_TIME_CREATED, start, 11));
+    TEST_ASSERT(lTEST_EventAt(4, TEST_TIME_KILLER, start, 12));
+    TEST_ASSERT(lTEST_EventAt(5, TEST_TIME_RELOADED, start, 20));
+    TEST_ASSERT(lTEST_EventAt(6, TEST_TIME_RELOADED, start, 30));
+    TEST_ASSERT(lTEST_EventAt(7, TEST_TIME_RELOADED, start, 55));
+    TEST_ASSERT(lTEST_EventAt(8, TEST_TIME_STOPPED, restart, 9));
+    TEST_ASSERT(lTEST_EventAt(9, TEST_TIME_RELOADED, start, 80));
+
+    /* The reloaded and the stopped timers */
+    SYS_TIME_StatisticsGet(&stats);
+    TEST_ASSERT_EQUAL(2U, stats.timersInUse);
+    TEST_ASSERT_EQUAL(5U, stats.timersHighWater);
+    TEST_ASSERT_EQUAL(SYS_TIME_ERROR, SYS_TIME_TimerDestroy(testKilled));
+}
+
+TEST_CASE(sysTime_WheelLoad25)
+{
+    lTEST_Load(25U);
+}
+
+TEST_CASE(sysTime_WheelLoad100)
+{
+    lTEST_Load(100U);
+}
+
+TEST_CASE(sysTime_WheelLoad500)
+{
+    lTEST_Load(TEST_TIME_LOAD_MAX);
+}
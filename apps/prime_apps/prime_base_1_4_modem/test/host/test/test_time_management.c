@@ -0,0 +1,191 @@
+/*******************************************************************************
+  Time Management Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_time_management.c
+
+  Summary:
+    Host tests of the time management service.
+
+  Description:
+    The time is checked against the TC0 counter of the model, also across
+    its wrap around.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include "definitions.h"
+#include "service/time_management/srv_time_management.h"
+#include "test.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint32_t testSingleCount;
+static uint32_t testPeriodicCount;
+static uint64_t testSingleTime;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint64_t lTEST_CountsToUS(uint64_t counts)
+{
+    return (counts * 1000000U) / HOST_TIME_FREQUENCY;
+}
+
+static void lTEST_SingleCallback(uintptr_t context)
+{
+    testSingleCount++;
+    testSingleTime = HOST_TIME_Get();
+}
+
+static void lTEST_PeriodicCallback(uintptr_t context)
+{
+    testPeriodicCount += (uint32_t)context;
+}
+
+static void lTEST_CheckElapsed(uint64_t startCounts, uint32_t reads)
+{
+    uint64_t timeUs, expectedUs, previousUs;
+    uint32_t index;
+    uint32_t updates = 0;
+
+    previousUs = SRV_TIME_MANAGEMENT_GetTimeUS64();
+
+    for (index = 0; index < reads; index++)
+    {
+        HOST_TIME_AdvanceUS(1U + ((uint32_t)rand() % 20000000U));
+        timeUs = SRV_TIME_MANAGEMENT_GetTimeUS64();
+        expectedUs = lTEST_CountsToUS(HOST_TIME_Get() - startCounts);
+
+        TEST_ASSERT(timeUs >= previousUs);
+        if ((timeUs - previousUs) >= 10000000U)
+        {
+            updates++;
+        }
+
+        /* Reference updated in the first read: same time or 1 us later */
+        TEST_ASSERT((SRV_TIME_MANAGEMENT_GetTimeUS() - (uint32_t)timeUs) <= 1U);
+
+        /* Up to 1 us of error each time the reference is updated */
+        TEST_ASSERT(((timeUs > expectedUs) ? (timeUs - expectedUs) : (expectedUs - timeUs)) <= (updates + 1U));
+        previousUs = SRV_TIME_MANAGEMENT_GetTimeUS64();
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(time_FollowsCounter)
+{
+    uint64_t startCounts;
+
+    TEST_TimeInitialize();
+    startCounts = HOST_TIME_Get();
+    lTEST_CheckElapsed(startCounts, 100);
+}
+
+TEST_CASE(time_ContinuousAcrossCounterWrap)
+{
+    uint64_t startCounts;
+
+    /* Not the first boot: the TC0 counter starts from 0 anyway */
+    HOST_TIME_AdvanceUS(123456789U);
+    TEST_TimeInitialize();
+    startCounts = HOST_TIME_Get();
+
+    /* About 10000 s, the 32-bit TC0 counter wraps every 2748 s */
+    lTEST_CheckElapsed(startCounts, 1000);
+    TEST_ASSERT((HOST_TIME_Get() - startCounts) > (3ULL << 32));
+}
+
+TEST_CASE(time_CountConversions)
+{
+    uint64_t counter;
+    uint32_t timeUs, index;
+
+    TEST_TimeInitialize();
+
+    for (index = 0; index < 1000U; index++)
+    {
+        HOST_TIME_AdvanceUS((uint32_t)rand() % 30000000U);
+        timeUs = SRV_TIME_MANAGEMENT_GetTimeUS();
+        counter = SYS_TIME_Counter64Get();
+
+        /* 1 s later and 1 s before */
+        TEST_ASSERT(SRV_TIME_MANAGEMENT_USToCount(timeUs + 1000000U) - counter <= HOST_TIME_FREQUENCY + 2U);
+        TEST_ASSERT(SRV_TIME_MANAGEMENT_USToCount(timeUs + 1000000U) - counter >= HOST_TIME_FREQUENCY - 2U);
+        TEST_ASSERT(counter - SRV_TIME_MANAGEMENT_USToCount(timeUs - 1000000U) <= HOST_TIME_FREQUENCY + 2U);
+        TEST_ASSERT(counter - SRV_TIME_MANAGEMENT_USToCount(timeUs - 1000000U) >= HOST_TIME_FREQUENCY - 2U);
+        TEST_ASSERT(SRV_TIME_MANAGEMENT_CountToUS(counter + HOST_TIME_FREQUENCY) - timeUs <= 1000002U);
+        TEST_ASSERT(SRV_TIME_MANAGEMENT_CountToUS(counter + HOST_TIME_FREQUENCY) - timeUs >= 999998U);
+        TEST_ASSERT(timeUs - SRV_TIME_MANAGEMENT_CountToUS(counter - HOST_TIME_FREQUENCY) <= 1000002U);
+        TEST_ASSERT(timeUs - SRV_TIME_MANAGEMENT_CountToUS(counter - HOST_TIME_FREQUENCY) >= 999998U);
+    }
+}
+
+TEST_CASE(time_Callbacks)
+{
+    uint64_t startCounts;
+    uint32_t index;
+
+    TEST_TimeInitialize();
+    startCounts = HOST_TIME_Get();
+
+    TEST_ASSERT(SRV_TIME_MANAGEMENT_CbRegisterUS(lTEST_SingleCallback, 0, 500, SYS_TIME_SINGLE) != SYS_TIME_HANDLE_INVALID);
+    TEST_ASSERT(SRV_TIME_MANAGEMENT_CbRegisterMS(lTEST_PeriodicCallback, 3, 10, SYS_TIME_PERIODIC) != SYS_TIME_HANDLE_INVALID);
+
+    /* 105 ms */
+    for (index = 0; index < 2100U; index++)
+    {
+        HOST_TIME_AdvanceUS(50);
+    }
+
+    TEST_ASSERT_EQUAL(1U, testSingleCount);
+    /* Expired in the step where the 500 us are reached */
+    TEST_ASSERT(testSingleTime >= (startCounts + SYS_TIME_USToCount(500)));
+    TEST_ASSERT(testSingleTime < (startCounts + SYS_TIME_USToCount(550)));
+    TEST_ASSERT_EQUAL(10U * 3U, testPeriodicCount);
+}
@@ -0,0 +1,626 @@
+/*******************************************************************************
+  USI Service Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_usi.c
+
+  Summary:
+    Host tests of the USI service over the FLEXCOM7 USART ring buffer PLIB.
+
+  Description:
+    Frames sent by the service are checked against a byte by byte reference
+    encoder, and frames built by the reference encoder are received through
+    the USART receive ring in chunks of random size.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "service/pcrc/srv_pcrc.h"
+#include "service/usi/srv_usi.h"
+#include "service/usi/srv_usi_usart.h"
+#include "test.h"
+#include "usi_frame.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Same initialization as the application (initialization.c) */
+static uint8_t testUsiReadBuffer[SRV_USI0_RD_BUF_SIZE];
+static uint8_t testUsiWriteBuffer[SRV_USI0_WR_BUF_SIZE];
+static uint8_t testUsiUsartReadBuffer[128];
+
+static const SRV_USI_USART_INTERFACE testUsiPlib = {
+    .readCallbackRegister = (USI_USART_PLIB_READ_CALLBACK_REG)FLEXCOM7_USART_ReadCallbackRegister,
+    .readData = (USI_USART_PLIB_WRRD)FLEXCOM7_USART_Read,
+    .writeData = (USI_USART_PLIB_WRRD)FLEXCOM7_USART_Write,
+    .writeCountGet = FLEXCOM7_USART_WriteCountGet,
+    .writeFreeBufferCountGet = FLEXCOM7_USART_WriteFreeBufferCountGet,
+    .intSource = FLEXCOM7_IRQn,
+};
+
+static const USI_USART_INIT_DATA testUsiInitData = {
+    .plib = (void*)&testUsiPlib,
+    .pRdBuffer = (void*)testUsiReadBuffer,
+    .rdBufferSize = SRV_USI0_RD_BUF_SIZE,
+    .usartReadBuffer = (void *)testUsiUsartReadBuffer,
+    .usartBufferSize = 128
+};
+
+static const SRV_USI_INIT testUsiInit =
+{
+    .deviceInitData = (const void * const)&testUsiInitData,
+    .consDevDesc = &srvUSIUSARTDevDesc,
+    .deviceIndex = 0,
+    .pWrBuffer = testUsiWriteBuffer,
+    .wrBufferSize = SRV_USI0_WR_BUF_SIZE
+};
+
+/* Last message received by the callbacks */
+static uint8_t testRxData[SRV_USI0_RD_BUF_SIZE];
+static size_t testRxLength;
+static uint32_t testRxCount;
+
+/* Frames delivered by the USART device and by the byte by byte reference
+   decoder: length (2 bytes) and data of each one */
+#define TEST_USI_DECODE_LOG_SIZE    65536U
+
+typedef struct
+{
+    uint8_t data[TEST_USI_DECODE_LOG_SIZE];
+    size_t length;
+} TEST_USI_DECODE_LOG;
+
+static TEST_USI_DECODE_LOG testDeviceLog;
+static TEST_USI_DECODE_LOG testReferenceLog;
+
+/* Byte by byte reference decoder: the receive state machine of the device */
+static USI_USART_STATE testRefStatus;
+static uint8_t testRefBuffer[SRV_USI0_RD_BUF_SIZE];
+static size_t testRefCount;
+static uint32_t testRefOversize;
+static uint32_t testRefBadEscape;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Helpers
+// *****************************************************************************
+// *****************************************************************************
+
+static void lTEST_Callback(uint8_t *pData, size_t length)
+{
+    (void) memcpy(testRxData, pData, length);
+    testRxLength = length;
+    testRxCount++;
+}
+
+static SRV_USI_HANDLE lTEST_UsiOpen(void)
+{
+    SRV_USI_HANDLE handle;
+    uint32_t index;
+
+    FLEXCOM7_USART_Initialize();
+    HOST_FLEXCOM7_Reset();
+    TEST_ASSERT_EQUAL(SRV_USI_INDEX_0, SRV_USI_Initialize(SRV_USI_INDEX_0, (SYS_MODULE_INIT *)&testUsiInit));
+
+    handle = SRV_USI_Open(SRV_USI_INDEX_0);
+    TEST_ASSERT(handle != SRV_USI_HANDLE_INVALID);
+    TEST_ASSERT_EQUAL(SRV_USI_STATUS_CONFIGURED, SRV_USI_Status(handle));
+
+    for (index = 0; index < TEST_USI_PROTOCOLS_NUMBER; index++)
+    {
+        SRV_USI_CallbackRegister(handle, testUsiProtocols[index], lTEST_Callback);
+    }
+
+    return handle;
+}
+
+/* Feeds the line in chunks of random size, running the service task */
+static void lTEST_Receive(const uint8_t *pFrame, size_t length)
+{
+    size_t chunk;
+    uint32_t task;
+
+    while (length > 0U)
+    {
+        chunk = 1U + ((size_t)rand() % 300U);
+        if (chunk > length)
+        {
+            chunk = length;
+        }
+
+        TEST_ASSERT_EQUAL(chunk, HOST_FLEXCOM7_Receive(pFrame, chunk));
+        pFrame += chunk;
+        length -= chunk;
+
+        for (task = 0; task < 4U; task++)
+        {
+            SRV_USI_Tasks(SRV_USI_INDEX_0);
+        }
+    }
+}
+
+static void lTEST_LogFrame(TEST_USI_DECODE_LOG *pLog, const uint8_t *pData, size_t length)
+{
+    TEST_ASSERT((pLog->length + length + 2U) <= TEST_USI_DECODE_LOG_SIZE);
+    if ((pLog->length + length + 2U) > TEST_USI_DECODE_LOG_SIZE)
+    {
+        return;
+    }
+
+    pLog->data[pLog->length++] = (uint8_t)(length >> 8);
+    pLog->data[pLog->length++] = (uint8_t)length;
+    (void) memcpy(&pLog->data[pLog->length], pData, length);
+    pLog->length += length;
+}
+
+static void lTEST_DeviceCallback(uint8_t *pData, uint16_t length, uintptr_t context)
+{
+    lTEST_LogFrame(&testDeviceLog, pData, length);
+}
+
+static void lTEST_ReferenceDecode(const uint8_t *pData, size_t length)
+{
+    size_t index;
+    uint8_t rcvChar;
+
+    for (index = 0; index < length; index++)
+    {
+        rcvChar = pData[index];
+
+        if (testRefStatus == USI_USART_IDLE)
+        {
+            if (rcvChar == 0x7EU)
+            {
+                testRefCount = 0;
+                testRefStatus = USI_USART_RCV;
+            }
+        }
+        else if (testRefStatus == USI_USART_RCV)
+        {
+            if (rcvChar == 0x7EU)
+            {
+                if (testRefCount > 0U)
+                {
+                    lTEST_LogFrame(&testReferenceLog, testRefBuffer, testRefCount);
+                    testRefCount = 0;
+                    testRefStatus = USI_USART_IDLE;
+                }
+            }
+            else if (rcvChar == 0x7DU)
+            {
+                testRefStatus = USI_USART_ESC;
+            }
+            else if (testRefCount < SRV_USI0_RD_BUF_SIZE)
+            {
+                testRefBuffer[testRefCount++] = rcvChar;
+            }
+            else
+            {
+                testRefOversize++;
+                testRefCount = 0;
+                testRefStatus = USI_USART_IDLE;
+            }
+        }
+        else if (testRefCount >= SRV_USI0_RD_BUF_SIZE)
+        {
+            testRefOversize++;
+            testRefCount = 0;
+            testRefStatus = USI_USART_IDLE;
+        }
+        else if ((rcvChar == 0x5EU) || (rcvChar == 0x5DU))
+        {
+            testRefBuffer[testRefCount++] = rcvChar ^ 0x20U;
+            testRefStatus = USI_USART_RCV;
+        }
+        else
+        {
+            testRefBadEscape++;
+            testRefCount = 0;
+            testRefStatus = USI_USART_IDLE;
+        }
+    }
+}
+
+/* Feeds the line to the USART device in reads of random size, mostly short */
+static void lTEST_DeviceDecode(const uint8_t *pData, size_t length)
+{
+    size_t chunk;
+
+    while (length > 0U)
+    {
+        chunk = 1U + ((size_t)rand() % (((rand() & 1) == 0) ? 8U : 128U));
+        if (chunk > length)
+        {
+            chunk = length;
+        }
+
+        TEST_ASSERT_EQUAL(chunk, HOST_FLEXCOM7_Receive(pData, chunk));
+        USI_USART_Tasks(0);
+        TEST_ASSERT_EQUAL(0U, FLEXCOM7_USART_ReadCountGet());
+        pData += chunk;
+        length -= chunk;
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(usi_SendMatchesReference)
+{
+    static uint8_t payload[SRV_USI0_WR_BUF_SIZE];
+    static uint8_t expected[TEST_USI_FRAME_SIZE];
+    static uint8_t line[TEST_USI_FRAME_SIZE];
+    SRV_USI_MSG_SEGMENT segments[3];
+    SRV_USI_PROTOCOL_ID protocol;
+    SRV_USI_HANDLE handle;
+    size_t length, expectedLength, split1, split2;
+    uint32_t iteration;
+
+    handle = lTEST_UsiOpen();
+
+    for (iteration = 0; (iteration < 1000U) && (TEST_GetFailures() == 0U); iteration++)
+    {
+        protocol = testUsiProtocols[iteration % TEST_USI_PROTOCOLS_NUMBER];
+        /* Fits in the write buffer after escaping every byte */
+        length = 1U + ((size_t)rand() % 500U);
+        TEST_USI_Fill(payload, length);
+        expectedLength = TEST_USI_Encode(expected, protocol, payload, length);
+
+        TEST_ASSERT_EQUAL(expectedLength, SRV_USI_Send_Message(handle, protocol, payload, length));
+        TEST_ASSERT_EQUAL(expectedLength, HOST_FLEXCOM7_Transmit(line, sizeof(line)));
+        TEST_ASSERT(memcmp(expected, line, expectedLength) == 0);
+
+        /* Same frame from segments, empty ones included */
+        split1 = (size_t)rand() % (length + 1U);
+        split2 = split1 + ((size_t)rand() % (length - split1 + 1U));
+        segments[0].pData = payload;
+        segments[0].length = split1;
+        segments[1].pData = &payload[split1];
+        segments[1].length = split2 - split1;
+        segments[2].pData = &payload[split2];
+        segments[2].length = length - split2;
+
+        TEST_ASSERT_EQUAL(expectedLength, SRV_USI_Send_Message_Segments(handle, protocol, segments, 3));
+        TEST_ASSERT_EQUAL(expectedLength, HOST_FLEXCOM7_Transmit(line, sizeof(line)));
+        TEST_ASSERT(memcmp(expected, line, expectedLength) == 0);
+    }
+
+    /* Escaped frame larger than the write buffer */
+    (void) memset(payload, 0x7EU, sizeof(payload));
+    TEST_ASSERT_EQUAL(0U, SRV_USI_Send_Message(handle, SRV_USI_PROT_ID_PHY, payload, 600));
+    TEST_ASSERT_EQUAL(0U, HOST_FLEXCOM7_Transmit(line, sizeof(line)));
+}
+
+TEST_CASE(usi_ReceiveRoundTrip)
+{
+    static uint8_t payload[SRV_USI0_WR_BUF_SIZE];
+    static uint8_t frame[TEST_USI_FRAME_SIZE];
+    SRV_USI_PROTOCOL_STATS protStats;
+    SRV_USI_LINK_STATS linkStats;
+    SRV_USI_PROTOCOL_ID protocol;
+    SRV_USI_HANDLE handle;
+    size_t length, frameLength;
+    uint32_t iteration;
+
+    handle = lTEST_UsiOpen();
+
+    for (iteration = 0; (iteration < 1000U) && (TEST_GetFailures() == 0U); iteration++)
+    {
+        protocol = testUsiProtocols[iteration % TEST_USI_PROTOCOLS_NUMBER];
+        /* Unescaped frame fits in the read buffer */
+        length = 1U + ((size_t)rand() % (SRV_USI0_RD_BUF_SIZE - 8U));
+        TEST_USI_Fill(payload, length);
+        frameLength = TEST_USI_Encode(frame, protocol, payload, length);
+
+        testRxCount = 0;
+        lTEST_Receive(frame, frameLength);
+        TEST_ASSERT_EQUAL(1U, testRxCount);
+
+        if (protocol == SRV_USI_PROT_ID_MNGP_PRIME_GETQRY)
+        {
+            /* Management plane callbacks get the USI header too */
+            TEST_ASSERT_EQUAL(length + 2U, testRxLength);
+            TEST_ASSERT(memcmp(&testRxData[2], payload, length) == 0);
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL(length, testRxLength);
+            TEST_ASSERT(memcmp(testRxData, payload, length) == 0);
+        }
+    }
+
+    TEST_ASSERT(SRV_USI_GetLinkStats(handle, &linkStats) == true);
+    TEST_ASSERT_EQUAL(1000U, linkStats.rxFrames);
+    TEST_ASSERT(SRV_USI_GetProtocolStats(handle, SRV_USI_PROT_ID_PHY, &protStats) == true);
+    TEST_ASSERT_EQUAL(200U, protStats.rxFrames);
+}
+
+TEST_CASE(usi_RejectsBadFrames)
+{
+    static uint8_t payload[SRV_USI0_RD_BUF_SIZE + 16U];
+    static uint8_t frame[2U * TEST_USI_FRAME_SIZE];
+    static const uint8_t badEscape[] = {0x7EU, 0x00U, 0x7DU, 0x00U, 0x7EU};
+    static const uint8_t shortFrame[] = {0x7EU, 0x00U, 0x7EU};
+    SRV_USI_LINK_STATS linkStats;
+    SRV_USI_HANDLE handle;
+    size_t frameLength;
+
+    handle = lTEST_UsiOpen();
+    TEST_USI_Fill(payload, sizeof(payload));
+
+    /* Bad CRC */
+    frameLength = TEST_USI_Encode(frame, SRV_USI_PROT_ID_PHY, payload, 100);
+    frame[frameLength - 2U] = (frame[frameLength - 2U] == 0x00U) ? 0x01U : 0x00U;
+    lTEST_Receive(frame, frameLength);
+
+    /* Length field not matching the data */
+    frameLength = TEST_USI_Encode(frame, SRV_USI_PROT_ID_PHY, payload, 100);
+    frame[1] = (frame[1] == 0x01U) ? 0x02U : 0x01U;
+    lTEST_Receive(frame, frameLength);
+
+    /* Protocol without descriptor */
+    frameLength = TEST_USI_Encode(frame, (SRV_USI_PROTOCOL_ID)0x3F, payload, 100);
+    lTEST_Receive(frame, frameLength);
+
+    /* Escape key followed by a byte that is not 5E or 5D */
+    lTEST_Receive(badEscape, sizeof(badEscape));
+
+    /* Header shorter than 2 bytes */
+    lTEST_Receive(shortFrame, sizeof(shortFrame));
+
+    /* Data larger than the read buffer */
+    frame[0] = 0x7EU;
+    (void) memset(&frame[1], 0x55U, SRV_USI0_RD_BUF_SIZE + 8U);
+    frame[SRV_USI0_RD_BUF_SIZE + 9U] = 0x7EU;
+    lTEST_Receive(frame, SRV_USI0_RD_BUF_SIZE + 10U);
+
+    TEST_ASSERT_EQUAL(0U, testRxCount);
+
+    /* Reception goes on after the errors */
+    frameLength = TEST_USI_Encode(frame, SRV_USI_PROT_ID_PHY, payload, 100);
+    lTEST_Receive(frame, frameLength);
+    TEST_ASSERT_EQUAL(1U, testRxCount);
+
+    TEST_ASSERT(SRV_USI_GetLinkStats(handle, &linkStats) == true);
+    TEST_ASSERT_EQUAL(1U, linkStats.rxFrames);
+    TEST_ASSERT_EQUAL(1U, linkStats.rxBadCrc);
+    TEST_ASSERT_EQUAL(2U, linkStats.rxBadLength);
+    TEST_ASSERT_EQUAL(1U, linkStats.rxUnknownProtocol);
+    TEST_ASSERT_EQUAL(1U, linkStats.rxBadEscape);
+    TEST_ASSERT_EQUAL(1U, linkStats.rxOversize);
+}
+
+TEST_CASE(usi_FuzzedStreamsKeepValidFrames)
+{
+    static uint8_t payload[SRV_USI0_WR_BUF_SIZE];
+    static uint8_t frame[TEST_USI_FRAME_SIZE + 1U];
+    static uint8_t garbage[3U * SRV_USI0_RD_BUF_SIZE];
+    SRV_USI_LINK_STATS linkStats;
+    SRV_USI_HANDLE handle;
+    size_t length, frameLength, index;
+    uint32_t iteration, validFrames = 0;
+
+    handle = lTEST_UsiOpen();
+    testRxCount = 0;
+
+    for (iteration = 0; (iteration < 2000U) && (TEST_GetFailures() == 0U); iteration++)
+    {
+        /* Random bytes, mostly delimiters and escapes, or runs longer than
+           the read buffer without delimiter */
+        length = (size_t)rand() % sizeof(garbage);
+        for (index = 0; index < length; index++)
+        {
+            if ((iteration & 3U) == 3U)
+            {
+                garbage[index] = (index == 0U) ? 0x7EU : (uint8_t)(0x40U + (index & 0x1FU));
+                continue;
+            }
+
+            switch (rand() % 8)
+            {
+                case 0:
+                    garbage[index] = 0x7EU;
+                    break;
+                case 1:
+                case 2:
+                    garbage[index] = 0x7DU;
+                    break;
+                case 3:
+                    garbage[index] = ((iteration & 1U) == 0U) ? 0x5EU : 0x5DU;
+                    break;
+                default:
+                    garbage[index] = (uint8_t)rand();
+                    break;
+            }
+        }
+
+        lTEST_Receive(garbage, length);
+
+        /* A valid frame after a delimiter is always delivered */
+        length = 1U + ((size_t)rand() % (SRV_USI0_RD_BUF_SIZE - 8U));
+        TEST_USI_Fill(payload, length);
+        frame[0] = 0x7EU;
+        frameLength = 1U + TEST_USI_Encode(&frame[1], SRV_USI_PROT_ID_PHY, payload, length);
+        lTEST_Receive(frame, frameLength);
+        validFrames++;
+
+        TEST_ASSERT(testRxCount >= validFrames);
+        TEST_ASSERT_EQUAL(length, testRxLength);
+        TEST_ASSERT(memcmp(testRxData, payload, length) == 0);
+    }
+
+    /* Every frame discarded is counted once */
+    TEST_ASSERT(SRV_USI_GetLinkStats(handle, &linkStats) == true);
+    TEST_ASSERT_EQUAL(testRxCount, linkStats.rxFrames);
+    TEST_ASSERT(linkStats.rxOversize > 0U);
+    TEST_ASSERT(linkStats.rxBadEscape > 0U);
+    TEST_ASSERT((linkStats.rxBadCrc + linkStats.rxBadLength) > 0U);
+}
+
+TEST_CASE(usi_DecodeMatchesBytewise)
+{
+    static uint8_t stream[4U * SRV_USI0_RD_BUF_SIZE];
+    SRV_USI_LINK_STATS linkStats;
+    size_t length, index;
+    uint32_t iteration, density;
+
+    FLEXCOM7_USART_Initialize();
+    HOST_FLEXCOM7_Reset();
+    USI_USART_Initialize(0, &testUsiInitData);
+    TEST_ASSERT(USI_USART_Open(0) != DRV_HANDLE_INVALID);
+    USI_USART_RegisterCallback(0, lTEST_DeviceCallback, 0);
+
+    /* Word at a time decoder against the byte by byte state machine, on
+       streams from escape free to only escapes, in reads of any size */
+    for (iteration = 0; (iteration < 3000U) && (TEST_GetFailures() == 0U); iteration++)
+    {
+        testDeviceLog.length = 0;
+        testReferenceLog.length = 0;
+        density = iteration % 5U;
+
+        length = (size_t)rand() % sizeof(stream);
+        for (index = 0; index < length; index++)
+        {
+            if ((density == 4U) || (((uint32_t)rand() % 64U) < (density * density * 4U)))
+            {
+                /* Keys: delimiters, escapes (valid or not) and 7D 5E runs */
+                switch (rand() % 6)
+                {
+                    case 0:
+                        stream[index] = 0x7EU;
+                        break;
+                    case 1:
+                    case 2:
+                        stream[index] = 0x7DU;
+                        break;
+                    case 3:
+                        stream[index] = 0x5EU;
+                        break;
+                    case 4:
+                        stream[index] = 0x5DU;
+                        break;
+                    default:
+                        stream[index] = (uint8_t)rand();
+                        break;
+                }
+            }
+            else if ((index == 0U) || ((density > 0U) && (((uint32_t)rand() % 512U) == 0U)))
+            {
+                /* Density 0: one delimiter, then runs longer than the read
+                   buffer */
+                stream[index] = 0x7EU;
+            }
+            else
+            {
+                stream[index] = (uint8_t)rand();
+                if ((density == 0U) && ((stream[index] == 0x7EU) || (stream[index] == 0x7DU)))
+                {
+                    stream[index] = 0x00U;
+                }
+            }
+        }
+
+        lTEST_DeviceDecode(stream, length);
+        lTEST_ReferenceDecode(stream, length);
+
+        TEST_ASSERT_EQUAL(testReferenceLog.length, testDeviceLog.length);
+        TEST_ASSERT(memcmp(testReferenceLog.data, testDeviceLog.data, testReferenceLog.length) == 0);
+    }
+
+    USI_USART_GetLinkStats(0, &linkStats);
+    TEST_ASSERT_EQUAL(testRefOversize, linkStats.rxOversize);
+    TEST_ASSERT_EQUAL(testRefBadEscape, linkStats.rxBadEscape);
+    TEST_ASSERT(testRefOversize > 0U);
+    TEST_ASSERT(testRefBadEscape > 0U);
+}
+
+TEST_CASE(usi_SendBusyKeepsWholeFrames)
+{
+    static uint8_t payload[400];
+    static uint8_t expected[TEST_USI_FRAME_SIZE];
+    static uint8_t line[4096];
+    SRV_USI_PROTOCOL_STATS protStats;
+    SRV_USI_LINK_STATS linkStats;
+    SRV_USI_HANDLE handle;
+    size_t frameLength, lineLength, index;
+    uint32_t sent = 0;
+
+    handle = lTEST_UsiOpen();
+    TEST_USI_Fill(payload, sizeof(payload));
+    frameLength = TEST_USI_Encode(expected, SRV_USI_PROT_ID_PHY, payload, sizeof(payload));
+
+    /* Transmit ring full: the frame is refused, not truncated */
+    while (SRV_USI_Send_Message(handle, SRV_USI_PROT_ID_PHY, payload, sizeof(payload)) != 0U)
+    {
+        sent++;
+        TEST_ASSERT(SRV_USI_IsSendBusy(handle) == false);
+    }
+
+    TEST_ASSERT(SRV_USI_IsSendBusy(handle) == true);
+    TEST_ASSERT(sent > 0U);
+
+    lineLength = HOST_FLEXCOM7_Transmit(line, sizeof(line));
+    TEST_ASSERT_EQUAL(sent * frameLength, lineLength);
+    for (index = 0; index < sent; index++)
+    {
+        TEST_ASSERT(memcmp(expected, &line[index * frameLength], frameLength) == 0);
+    }
+
+    TEST_ASSERT(SRV_USI_GetLinkStats(handle, &linkStats) == true);
+    TEST_ASSERT_EQUAL(sent, linkStats.txFrames);
+    TEST_ASSERT_EQUAL(1U, linkStats.txBusy);
+    TEST_ASSERT_EQUAL(sent * frameLength, linkStats.txQueueHighWater);
+    TEST_ASSERT(SRV_USI_GetProtocolStats(handle, SRV_USI_PROT_ID_PHY, &protStats) == true);
+    TEST_ASSERT_EQUAL(sent, protStats.txFrames);
+    TEST_ASSERT_EQUAL(1U, protStats.txBusy);
+
+    /* Room again */
+    TEST_ASSERT_EQUAL(frameLength, SRV_USI_Send_Message(handle, SRV_USI_PROT_ID_PHY, payload, sizeof(payload)));
+    TEST_ASSERT(SRV_USI_IsSendBusy(handle) == false);
+
+    SRV_USI_Close(handle);
+    TEST_ASSERT_EQUAL(SRV_USI_STATUS_NOT_CONFIGURED, SRV_USI_Status(handle));
+    TEST_ASSERT_EQUAL(0U, SRV_USI_Send_Message(handle, SRV_USI_PROT_ID_PHY, payload, sizeof(payload)));
+}
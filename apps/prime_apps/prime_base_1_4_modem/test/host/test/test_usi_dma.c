@@ -0,0 +1,577 @@
+/*******************************************************************************
+  USI Service DMA Transport Host Tests
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    test_usi_dma.c
+
+  Summary:
+    Host tests of the USI service over the FLEXCOM USART PDC transport.
+
+  Description:
+    Built with SRV_USI_USART_DMA_CONNECTIONS set to 1U. The line runs one
+    character per tick of the FLEXCOM PDC model, and the service task runs
+    every few characters: frames must match the reference encoder in both
+    directions, and a slow task must lose whole frames only. Interrupts per
+    frame are checked against the byte interrupts of the ring buffer
+    transport, and line errors are counted by cause.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "service/usi/srv_usi.h"
+#include "service/usi/srv_usi_usart_dma.h"
+#include "test.h"
+#include "usi_frame.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* DMA buffers of the transport */
+#define TEST_DMA_RD_BUFFER_SIZE    256U
+#define TEST_DMA_WR_BUFFER_SIZE    2048U
+
+/* Idle characters at the end of the line before it is considered done */
+#define TEST_DMA_LINE_IDLE         4U
+
+/* Longest interrupt latency, in characters (less than half the reception
+   buffer) */
+#define TEST_DMA_IRQ_LATENCY       20U
+
+/* Characters sent in a row by the line model before giving up */
+#define TEST_DMA_LINE_MAX          (4U * TEST_DMA_WR_BUFFER_SIZE)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Data
+// *****************************************************************************
+// *****************************************************************************
+
+static uint8_t testUsiReadBuffer[SRV_USI0_RD_BUF_SIZE];
+static uint8_t testUsiWriteBuffer[SRV_USI0_WR_BUF_SIZE];
+
+static USI_USART_DMA_INIT_DATA testUsiDmaInitData = {
+    .regs = &hostFlexcomRegs,
+    .pRdBuffer = testUsiReadBuffer,
+    .rdBufferSize = SRV_USI0_RD_BUF_SIZE,
+    .dmaRdBufferSize = TEST_DMA_RD_BUFFER_SIZE,
+    .dmaWrBufferSize = TEST_DMA_WR_BUFFER_SIZE
+};
+
+static const SRV_USI_INIT testUsiInit =
+{
+    .deviceInitData = (const void * const)&testUsiDmaInitData,
+    .consDevDesc = &srvUSIUSARTDMADevDesc,
+    .deviceIndex = 0,
+    .pWrBuffer = testUsiWriteBuffer,
+    .wrBufferSize = SRV_USI0_WR_BUF_SIZE
+};
+
+/* Payloads sent to the service, checked by the callback */
+static uint8_t testPayloads[2][SRV_USI0_RD_BUF_SIZE];
+static size_t testPayloadLengths[2];
+static uint32_t testRxCount;
+static uint32_t testRxErrors;
+
+/* Line data not received yet */
+static const uint8_t *testLineRx;
+static size_t testLineRxLength;
+
+/* Characters received while each frame is processed by its callback, from
+   inside the service task */
+static uint32_t testCallbackTicks;
+static int32_t testLastFrame;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Helpers
+// *****************************************************************************
+// *****************************************************************************
+
+/* Received data must be one of the last two payloads */
+static void lTEST_Callback(uint8_t *pData, size_t length)
+{
+    uint32_t index;
+
+    for (index = 0; index < 2U; index++)
+    {
+        if ((length == testPayloadLengths[index]) &&
+            (memcmp(pData, testPayloads[index], length) == 0))
+        {
+            testRxCount++;
+            return;
+        }
+    }
+
+    testRxErrors++;
+}
+
+/* Management plane callbacks get the USI header too */
+static void lTEST_CallbackHeader(uint8_t *pData, size_t length)
+{
+    lTEST_Callback(&pData[2], length - 2U);
+}
+
+/* One character time of the line */
+static int lTEST_LineTick(void)
+{
+    int rxChar = -1;
+
+    if (testLineRxLength > 0U)
+    {
+        rxChar = *testLineRx++;
+        testLineRxLength--;
+    }
+
+    return HOST_PDC_Tick(rxChar);
+}
+
+/* Numbered frames: payload made of the frame number, received in order */
+static void lTEST_NumberedCallback(uint8_t *pData, size_t length)
+{
+    uint32_t index;
+    uint32_t ticks;
+
+    for (index = 1; index < length; index++)
+    {
+        if (pData[index] != (uint8_t)(pData[0] + index))
+        {
+            testRxErrors++;
+            return;
+        }
+    }
+
+    if ((int32_t)pData[0] <= testLastFrame)
+    {
+        testRxErrors++;
+        return;
+    }
+
+    testLastFrame = (int32_t)pData[0];
+    testRxCount++;
+
+    /* Slow processing: the line goes on meanwhile, with the interrupts
+       served in time */
+    if (testCallbackTicks > 0U)
+    {
+        HOST_PDC_MaskInterrupts(false);
+    }
+
+    for (ticks = 0; ticks < testCallbackTicks; ticks++)
+    {
+        (void) lTEST_LineTick();
+    }
+}
+
+static SRV_USI_HANDLE lTEST_UsiOpen(void)
+{
+    SRV_USI_HANDLE handle;
+    uint32_t index;
+
+    if (testUsiDmaInitData.pDmaRdBuffer == NULL)
+    {
+        testUsiDmaInitData.pDmaRdBuffer = HOST_PDC_Alloc(TEST_DMA_RD_BUFFER_SIZE);
+        testUsiDmaInitData.pDmaWrBuffer = HOST_PDC_Alloc(TEST_DMA_WR_BUFFER_SIZE);
+    }
+
+    (void) memset(&hostFlexcomRegs, 0, sizeof(hostFlexcomRegs));
+    HOST_PDC_Initialize(USI_USART_DMA_InterruptHandler, 0, 0);
+    TEST_ASSERT_EQUAL(SRV_USI_INDEX_0, SRV_USI_Initialize(SRV_USI_INDEX_0, (SYS_MODULE_INIT *)&testUsiInit));
+    HOST_PDC_Interrupts();
+
+    handle = SRV_USI_Open(SRV_USI_INDEX_0);
+    TEST_ASSERT(handle != SRV_USI_HANDLE_INVALID);
+    TEST_ASSERT_EQUAL(SRV_USI_STATUS_CONFIGURED, SRV_USI_Status(handle));
+
+    for (index = 0; index < TEST_USI_PROTOCOLS_NUMBER; index++)
+    {
+        if (testUsiProtocols[index] == SRV_USI_PROT_ID_MNGP_PRIME_GETQRY)
+        {
+            SRV_USI_CallbackRegister(handle, testUsiProtocols[index], lTEST_CallbackHeader);
+        }
+        else
+        {
+            SRV_USI_CallbackRegister(handle, testUsiProtocols[index], lTEST_Callback);
+        }
+    }
+
+    return handle;
+}
+
+/* New payload to receive, the previous one is kept */
+static uint8_t *lTEST_NextPayload(size_t length)
+{
+    (void) memcpy(testPayloads[0], testPayloads[1], testPayloadLengths[1]);
+    testPayloadLengths[0] = testPayloadLengths[1];
+    TEST_USI_Fill(testPayloads[1], length);
+    testPayloadLengths[1] = length;
+
+    return testPayloads[1];
+}
+
+/* Runs the line until the frame is received and the transmitter is idle,
+   with the service task every taskPeriod characters. The interrupt is held
+   now and then, so the task also runs with the handler pending. Returns the
+   characters sent by the device */
+static size_t lTEST_Line(const uint8_t *pRx, size_t rxLength, uint8_t *pTx,
+                         uint32_t taskPeriod)
+{
+    size_t txLength = 0;
+    uint32_t tick = 0;
+    uint32_t idle = 0;
+    uint32_t masked = 0;
+    int txChar;
+
+    testLineRx = pRx;
+    testLineRxLength = rxLength;
+
+    while ((testLineRxLength > 0U) || (idle <= TEST_DMA_LINE_IDLE))
+    {
+        txChar = lTEST_LineTick();
+        if (txChar >= 0)
+        {
+            TEST_ASSERT(txLength < TEST_DMA_LINE_MAX);
+            if (txLength >= TEST_DMA_LINE_MAX)
+            {
+                break;
+            }
+
+            pTx[txLength++] = (uint8_t)txChar;
+            idle = 0;
+        }
+        else if (testLineRxLength == 0U)
+        {
+            idle++;
+        }
+
+        if ((++tick % taskPeriod) == 0U)
+        {
+            SRV_USI_Tasks(SRV_USI_INDEX_0);
+            HOST_PDC_Interrupts();
+        }
+
+        if (masked > 0U)
+        {
+            if (--masked == 0U)
+            {
+                HOST_PDC_MaskInterrupts(false);
+            }
+        }
+        else if ((rand() % 32) == 0)
+        {
+            masked = 1U + ((uint32_t)rand() % TEST_DMA_IRQ_LATENCY);
+            HOST_PDC_MaskInterrupts(true);
+        }
+    }
+
+    HOST_PDC_MaskInterrupts(false);
+
+    SRV_USI_Tasks(SRV_USI_INDEX_0);
+    HOST_PDC_Interrupts();
+
+    return txLength;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Test cases
+// *****************************************************************************
+// *****************************************************************************
+
+TEST_CASE(usiDma_SendMatchesReference)
+{
+    static uint8_t payload[300];
+    static uint8_t expected[3U * TEST_USI_FRAME_SIZE];
+    static uint8_t line[TEST_DMA_LINE_MAX];
+    SRV_USI_LINK_STATS linkStats;
+    SRV_USI_PROTOCOL_ID protocol;
+    SRV_USI_HANDLE handle;
+    size_t length, expectedLength, frameLength;
+    uint32_t iteration, frame;
+
+    handle = lTEST_UsiOpen();
+
+    for (iteration = 0; (iteration < 300U) && (TEST_GetFailures() == 0U); iteration++)
+    {
+        /* Three frames queued at once, wrapping around the transmit ring */
+        expectedLength = 0;
+        for (frame = 0; frame < 3U; frame++)
+        {
+            protocol = testUsiProtocols[(iteration + frame) % TEST_USI_PROTOCOLS_NUMBER];
+            length = 1U + ((size_t)rand() % sizeof(payload));
+            TEST_USI_Fill(payload, length);
+            frameLength = TEST_USI_Encode(&expected[expectedLength], protocol, payload, length);
+            expectedLength += frameLength;
+
+            TEST_ASSERT_EQUAL(frameLength, SRV_USI_Send_Message(handle, protocol, payload, length));
+        }
+
+        HOST_PDC_Interrupts();
+        TEST_ASSERT_EQUAL(expectedLength, lTEST_Line(NULL, 0, line, 8));
+        TEST_ASSERT(memcmp(expected, line, expectedLength) == 0);
+    }
+
+    TEST_ASSERT(SRV_USI_GetLinkStats(handle, &linkStats) == true);
+    TEST_ASSERT_EQUAL(900U, linkStats.txFrames);
+    TEST_ASSERT_EQUAL(0U, linkStats.txBusy);
+    TEST_ASSERT(linkStats.txQueueHighWater <= TEST_DMA_WR_BUFFER_SIZE);
+
+    /* Transmitter interrupt disabled when the ring is empty */
+    TEST_ASSERT_EQUAL(0U, hostFlexcomRegs.FLEX_US_IMR & FLEX_US_IMR_TXBUFE_Msk);
+}
+
+TEST_CASE(usiDma_ReceiveRoundTrip)
+{
+    static uint8_t frame[TEST_USI_FRAME_SIZE];
+    static uint8_t line[TEST_DMA_LINE_MAX];
+    SRV_USI_LINK_STATS linkStats;
+    SRV_USI_PROTOCOL_ID protocol;
+    SRV_USI_HANDLE handle;
+    size_t length, frameLength;
+    uint32_t iteration;
+
+    handle = lTEST_UsiOpen();
+    testRxCount = 0;
+    testRxErrors = 0;
+
+    for (iteration = 0; (iteration < 500U) && (TEST_GetFailures() == 0U); iteration++)
+    {
+        protocol = testUsiProtocols[iteration % TEST_USI_PROTOCOLS_NUMBER];
+        /* Unescaped frame fits in the read buffer */
+        length = 1U + ((size_t)rand() % (SRV_USI0_RD_BUF_SIZE - 8U));
+        frameLength = TEST_USI_Encode(frame, protocol, lTEST_NextPayload(length), length);
+
+        /* Task often enough to keep up with the reception buffer */
+        TEST_ASSERT_EQUAL(0U, lTEST_Line(frame, frameLength, line, 1U + ((uint32_t)rand() % 100U)));
+        TEST_ASSERT_EQUAL(iteration + 1U, testRxCount);
+    }
+
+    TEST_ASSERT_EQUAL(0U, testRxErrors);
+    TEST_ASSERT(SRV_USI_GetLinkStats(handle, &linkStats) == true);
+    TEST_ASSERT_EQUAL(500U, linkStats.rxFrames);
+    TEST_ASSERT_EQUAL(0U, linkStats.rxOverrun);
+    TEST_ASSERT_EQUAL(0U, linkStats.rxBadCrc);
+    TEST_ASSERT_EQUAL(0U, HOST_PDC_GetLostBytes());
+}
+
+TEST_CASE(usiDma_SlowTaskDropsWholeFrames)
+{
+    static uint8_t frame[TEST_USI_FRAME_SIZE];
+    static uint8_t line[TEST_DMA_LINE_MAX];
+    SRV_USI_LINK_STATS linkStats;
+    SRV_USI_HANDLE handle;
+    size_t length, frameLength;
+    uint32_t iteration;
+
+    handle = lTEST_UsiOpen();
+    testRxCount = 0;
+    testRxErrors = 0;
+
+    /* Task slower than the reception buffer: the PDC overwrites data not
+       decoded yet */
+    for (iteration = 0; (iteration < 200U) && (TEST_GetFailures() == 0U); iteration++)
+    {
+        length = 1U + ((size_t)rand() % (SRV_USI0_RD_BUF_SIZE - 8U));
+        frameLength = TEST_USI_Encode(frame, SRV_USI_PROT_ID_PHY, lTEST_NextPayload(length), length);
+        TEST_ASSERT_EQUAL(0U, lTEST_Line(frame, frameLength, line, 100U + ((uint32_t)rand() % 300U)));
+    }
+
+    /* Frames are delivered intact or not at all */
+    TEST_ASSERT_EQUAL(0U, testRxErrors);
+    TEST_ASSERT(testRxCount > 0U);
+    TEST_ASSERT(testRxCount < 200U);
+
+    TEST_ASSERT(SRV_USI_GetLinkStats(handle, &linkStats) == true);
+    TEST_ASSERT_EQUAL(testRxCount, linkStats.rxFrames);
+    TEST_ASSERT(linkStats.rxOverrun > 0U);
+    printf("  %u of 200 frames received, %u overruns\n", testRxCount, linkStats.rxOverrun);
+
+    /* The PDC is never left without a buffer: no byte lost in the USART */
+    TEST_ASSERT_EQUAL(0U, HOST_PDC_GetLostBytes());
+
+    /* Reception goes on with a faster task */
+    testRxCount = 0;
+    length = 100U;
+    frameLength = TEST_USI_Encode(frame, SRV_USI_PROT_ID_PHY, lTEST_NextPayload(length), length);
+    TEST_ASSERT_EQUAL(0U, lTEST_Line(frame, frameLength, line, 16U));
+    TEST_ASSERT_EQUAL(1U, testRxCount);
+    TEST_ASSERT_EQUAL(0U, testRxErrors);
+}
+
+TEST_CASE(usiDma_SlowCallbackDetectsOverrun)
+{
+    static uint8_t stream[50U * (TEST_USI_FRAME_SIZE / 8U)];
+    static uint8_t payload[100];
+    static uint8_t line[TEST_DMA_LINE_MAX];
+    SRV_USI_LINK_STATS linkStats;
+    SRV_USI_HANDLE handle;
+    size_t streamLength = 0;
+    uint32_t frame, index, rxCount;
+
+    handle = lTEST_UsiOpen();
+    SRV_USI_CallbackRegister(handle, SRV_USI_PROT_ID_PHY, lTEST_NumberedCallback);
+    testRxCount = 0;
+    testRxErrors = 0;
+    testLastFrame = -1;
+
+    /* Back to back frames, each one processed for longer than the reception
+       buffer lasts: the PDC comes back to the half being decoded */
+    for (frame = 0; frame < 50U; frame++)
+    {
+        for (index = 0; index < sizeof(payload); index++)
+        {
+            payload[index] = (uint8_t)(frame + index);
+        }
+
+        streamLength += TEST_USI_Encode(&stream[streamLength], SRV_USI_PROT_ID_PHY, payload, sizeof(payload));
+    }
+
+    testCallbackTicks = TEST_DMA_RD_BUFFER_SIZE + 50U;
+    TEST_ASSERT_EQUAL(0U, lTEST_Line(stream, streamLength, line, 16U));
+
+    /* Damaged frames are detected, never delivered */
+    TEST_ASSERT_EQUAL(0U, testRxErrors);
+    TEST_ASSERT(testRxCount > 0U);
+    TEST_ASSERT(testRxCount < 50U);
+    TEST_ASSERT(SRV_USI_GetLinkStats(handle, &linkStats) == true);
+    TEST_ASSERT(linkStats.rxOverrun > 0U);
+    TEST_ASSERT_EQUAL(0U, HOST_PDC_GetLostBytes());
+
+    /* Each frame lost is reported: the PDC is caught coming back to the
+       chunk being decoded, not only at the start of the next task */
+    TEST_ASSERT(linkStats.rxOverrun >= (50U - testRxCount));
+
+    /* Reception goes on with a fast callback */
+    rxCount = testRxCount;
+    testCallbackTicks = 0;
+    testLastFrame = -1;
+    TEST_ASSERT_EQUAL(0U, lTEST_Line(stream, streamLength, line, 16U));
+    TEST_ASSERT_EQUAL(rxCount + 50U, testRxCount);
+    TEST_ASSERT_EQUAL(0U, testRxErrors);
+}
+
+TEST_CASE(usiDma_InterruptsPerFrame)
+{
+    static const size_t lengths[2] = {8U, 200U};
+    static uint8_t frame[TEST_USI_FRAME_SIZE];
+    static uint8_t line[TEST_DMA_LINE_MAX];
+    SRV_USI_PROTOCOL_ID protocol;
+    SRV_USI_HANDLE handle;
+    size_t frameLength = 0, rxBytes;
+    uint32_t size, iteration, interrupts, rxInterrupts, txInterrupts;
+
+    handle = lTEST_UsiOpen();
+    testRxCount = 0;
+    testRxErrors = 0;
+    rxBytes = 0;
+
+    /* The ring buffer transport (byte interrupts) gets one interrupt per
+       character in each direction. The PDC one gets one per half of the
+       reception buffer, and one to start and one to end a transmission */
+    for (size = 0; size < 2U; size++)
+    {
+        rxInterrupts = 0;
+        txInterrupts = 0;
+        for (iteration = 0; (iteration < 100U) && (TEST_GetFailures() == 0U); iteration++)
+        {
+            protocol = testUsiProtocols[iteration % TEST_USI_PROTOCOLS_NUMBER];
+            frameLength = TEST_USI_Encode(frame, protocol, lTEST_NextPayload(lengths[size]), lengths[size]);
+
+            interrupts = HOST_PDC_GetInterrupts();
+            TEST_ASSERT_EQUAL(0U, lTEST_Line(frame, frameLength, line, 8U));
+            rxInterrupts += HOST_PDC_GetInterrupts() - interrupts;
+            rxBytes += frameLength;
+
+            interrupts = HOST_PDC_GetInterrupts();
+            TEST_ASSERT_EQUAL(frameLength, SRV_USI_Send_Message(handle, protocol,
+                              testPayloads[1], lengths[size]));
+            HOST_PDC_Interrupts();
+            TEST_ASSERT_EQUAL(frameLength, lTEST_Line(NULL, 0, line, 8U));
+            txInterrupts += HOST_PDC_GetInterrupts() - interrupts;
+        }
+
+        printf("  %u B frames: %.2f RX and %.2f TX interrupts per frame, "
+               "%u with byte interrupts\n", (unsigned int)frameLength,
+               (double)rxInterrupts / 100.0, (double)txInterrupts / 100.0,
+               (unsigned int)frameLength);
+
+        /* Reception: only the halves completed since the start */
+        TEST_ASSERT(rxInterrupts <= ((rxBytes / (TEST_DMA_RD_BUFFER_SIZE / 2U)) + 1U));
+        TEST_ASSERT(rxInterrupts < (100U * frameLength));
+        TEST_ASSERT_EQUAL(2U * 100U, txInterrupts);
+    }
+
+    TEST_ASSERT_EQUAL(200U, testRxCount);
+    TEST_ASSERT_EQUAL(0U, testRxErrors);
+}
+
+TEST_CASE(usiDma_LineErrorsByCause)
+{
+    static uint8_t frame[TEST_USI_FRAME_SIZE];
+    static uint8_t line[TEST_DMA_LINE_MAX];
+    static const uint32_t errors[3] = {
+        FLEX_US_CSR_FRAME_Msk, FLEX_US_CSR_PARE_Msk, FLEX_US_CSR_FRAME_Msk | FLEX_US_CSR_PARE_Msk
+    };
+    SRV_USI_LINK_STATS linkStats;
+    SRV_USI_HANDLE handle;
+    size_t frameLength;
+    uint32_t index;
+
+    handle = lTEST_UsiOpen();
+    testRxCount = 0;
+    testRxErrors = 0;
+
+    /* Error flagged on the first character of each frame, kept as received:
+       the frames are still intact */
+    for (index = 0; index < 3U; index++)
+    {
+        frameLength = TEST_USI_Encode(frame, SRV_USI_PROT_ID_PHY, lTEST_NextPayload(50U), 50U);
+        HOST_PDC_SetLineError(errors[index]);
+        TEST_ASSERT_EQUAL(0U, lTEST_Line(frame, frameLength, line, 8U));
+    }
+
+    TEST_ASSERT_EQUAL(3U, testRxCount);
+    TEST_ASSERT_EQUAL(0U, testRxErrors);
+    TEST_ASSERT(SRV_USI_GetLinkStats(handle, &linkStats) == true);
+    TEST_ASSERT_EQUAL(2U, linkStats.rxFramingError);
+    TEST_ASSERT_EQUAL(2U, linkStats.rxParityError);
+    TEST_ASSERT_EQUAL(0U, linkStats.rxOverrun);
+}
@@ -0,0 +1,179 @@
+/*******************************************************************************
+  USI Reference Frames
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    usi_frame.c
+
+  Summary:
+    Reference encoder of USI frames for the host tests.
+
+  Description:
+    Builds USI frames byte by byte from the protocol description, independent
+    of the service code, and test payloads rich in escape keys. Shared by the
+    tests of the USART transports.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdlib.h>
+#include <string.h>
+#include "definitions.h"
+#include "service/pcrc/srv_pcrc.h"
+#include "usi_frame.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Protocols of each CRC type and length format */
+const SRV_USI_PROTOCOL_ID testUsiProtocols[TEST_USI_PROTOCOLS_NUMBER] = {
+    SRV_USI_PROT_ID_MNGP_PRIME_GETQRY,
+    SRV_USI_PROT_ID_PHY,
+    SRV_USI_PROT_ID_PHY_MICROPLC,
+    SRV_USI_PROT_ID_ADP_G3,
+    SRV_USI_PROT_ID_PRIME_API,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File scope functions
+// *****************************************************************************
+// *****************************************************************************
+
+static PCRC_CRC_TYPE lTEST_CrcType(SRV_USI_PROTOCOL_ID protocol)
+{
+    switch (protocol)
+    {
+        case SRV_USI_PROT_ID_MNGP_PRIME_GETQRY:
+            return PCRC_CRC32;
+        case SRV_USI_PROT_ID_PHY_MICROPLC:
+        case SRV_USI_PROT_ID_PRIME_API:
+            return PCRC_CRC8;
+        default:
+            return PCRC_CRC16;
+    }
+}
+
+static bool lTEST_IsExtended(SRV_USI_PROTOCOL_ID protocol)
+{
+    return ((protocol == SRV_USI_PROT_ID_ADP_G3) || (protocol == SRV_USI_PROT_ID_PRIME_API));
+}
+
+static size_t lTEST_Escape(uint8_t *pDst, const uint8_t *pSrc, size_t length)
+{
+    size_t dstLength = 0;
+
+    while (length-- > 0U)
+    {
+        if ((*pSrc == 0x7EU) || (*pSrc == 0x7DU))
+        {
+            pDst[dstLength++] = 0x7DU;
+            pDst[dstLength++] = *pSrc ^ 0x20U;
+        }
+        else
+        {
+            pDst[dstLength++] = *pSrc;
+        }
+
+        pSrc++;
+    }
+
+    return dstLength;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Reference encoder
+// *****************************************************************************
+// *****************************************************************************
+
+size_t TEST_USI_Encode(uint8_t *pFrame, SRV_USI_PROTOCOL_ID protocol,
+                       const uint8_t *pData, size_t length)
+{
+    static uint8_t raw[SRV_USI0_WR_BUF_SIZE + 8U];
+    PCRC_CRC_TYPE crcType = lTEST_CrcType(protocol);
+    size_t crcLength = (size_t)1U << (uint32_t)crcType;
+    size_t rawLength, frameLength, index;
+    uint32_t crc;
+
+    raw[0] = (uint8_t)(length >> 2);
+    raw[1] = (uint8_t)((length << 6) & 0xC0U) | (uint8_t)protocol;
+    (void) memcpy(&raw[2], pData, length);
+    if (lTEST_IsExtended(protocol) == true)
+    {
+        raw[2] = (uint8_t)((length & 0x400U) >> 3) | (pData[0] & 0x7FU);
+    }
+
+    rawLength = length + 2U;
+    crc = SRV_PCRC_GetValue(raw, rawLength, PCRC_HT_USI, crcType, 0);
+    for (index = 0; index < crcLength; index++)
+    {
+        raw[rawLength++] = (uint8_t)(crc >> (8U * (crcLength - 1U - index)));
+    }
+
+    pFrame[0] = 0x7EU;
+    frameLength = 1U + lTEST_Escape(&pFrame[1], raw, rawLength);
+    pFrame[frameLength++] = 0x7EU;
+
+    return frameLength;
+}
+
+/* Payload with many escape keys, and the command byte of the extended
+   length protocols below 0x80 */
+void TEST_USI_Fill(uint8_t *pData, size_t length)
+{
+    size_t index;
+
+    for (index = 0; index < length; index++)
+    {
+        switch (rand() % 4)
+        {
+            case 0:
+                pData[index] = 0x7EU;
+                break;
+            case 1:
+                pData[index] = 0x7DU;
+                break;
+            default:
+                pData[index] = (uint8_t)rand();
+                break;
+        }
+    }
+
+    pData[0] &= 0x7FU;
+}
@@ -0,0 +1,86 @@
+/*******************************************************************************
+  USI Reference Frames Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    usi_frame.h
+
+  Summary:
+    Reference encoder of USI frames for the host tests.
+
+  Description:
+    Builds USI frames byte by byte from the protocol description, independent
+    of the service code, and test payloads rich in escape keys. Shared by the
+    tests of the USART transports.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*
+Copyright (C) 2024, Microchip Technology Inc., and its subsidiaries. All rights reserved.
+
+The software and documentation is provided by microchip and its contributors
+"as is" and any express, implied or statutory warranties, including, but not
+limited to, the implied warranties of merchantability, fitness for a particular
+purpose and non-infringement of third party intellectual property rights are
+disclaimed to the fullest extent permitted by law. In no event shall microchip
+or its contributors be liable for any direct, indirect, incidental, special,
+exemplary, or consequential damages (including, but not limited to, procurement
+of substitute goods or services; loss of use, data, or profits; or business
+interruption) however caused and on any theory of liability, whether in contract,
+strict liability, or tort (including negligence or otherwise) arising in any way
+out of the use of the software and documentation, even if advised of the
+possibility of such damage.
+
+Except as expressly permitted hereunder and subject to the applicable license terms
+for any third-party software incorporated in the software and any applicable open
+source software license terms, no license or other rights, whether express or
+implied, are granted under any patent or other intellectual property rights of
+Microchip or any third party.
+*/
+//DOM-IGNORE-END
+
+
+#ifndef USI_FRAME_H
+#define USI_FRAME_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include "service/usi/srv_usi.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macro Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Largest frame of a payload that fits in the write buffer */
+#define TEST_USI_FRAME_SIZE          (2U * (SRV_USI0_WR_BUF_SIZE + 8U))
+
+#define TEST_USI_PROTOCOLS_NUMBER    5U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Reference encoder interface
+// *****************************************************************************
+// *****************************************************************************
+
+/* Protocols of each CRC type and length format */
+extern const SRV_USI_PROTOCOL_ID testUsiProtocols[TEST_USI_PROTOCOLS_NUMBER];
+
+/* Builds the frame of a message, returns its length */
+size_t TEST_USI_Encode(uint8_t *pFrame, SRV_USI_PROTOCOL_ID protocol,
+                       const uint8_t *pData, size_t length);
+
+/* Payload with many escape keys, and the command byte of the extended
+   length protocols below 0x80 */
+void TEST_USI_Fill(uint8_t *pData, size_t length);
+
+#endif // USI_FRAME_H
@@ -53,11 +53,13 @@ static uint8_t *bootConfig;
 /* Temporal buffer to store the flash pages content (in blocks of pages) */
 static uint8_t pageBlock[BOOT_FLASH_16PAGE_SIZE];
 
-/* Counter of page blocks */
-static uint8_t pagesCounter;
+/* Swap journal: tag of the swap command, next free record and last step */
+static uint16_t journalTag;
+static uint16_t journalNext;
+static uint16_t journalStep;
 
-/* Bootloader state */
-static BOOT_STATE bootState;
+/* Swap journal page buffer */
+static uint32_t journalPage[BOOT_FLASH_PAGE_SIZE / sizeof(uint32_t)];
 
 // *****************************************************************************
 /* Application Data
@@ -97,14 +99,152 @@ static void lAPP_BOOTLOADER_UpdateUserSignature(uint8_t pagesCnt,
     bootConfig[16] = pagesCnt;
     bootConfig[17] = (uint8_t) state;
 
-    /* Erase the user signature */
+    /* Erase the user signature (the swap journal is erased too) */
     SEFC0_UserSignatureErase(BOOT_USER_SIGNATURE_BLOCK);
 
+    while (SEFC0_IsBusy()) {
+        ;
+    }
+
     /* Update the user signature */
     (void) SEFC0_UserSignatureWrite((void*) userSignBuf,
             (uint32_t) BOOT_USER_SIGNATURE_SIZE_64,
             (SEFC_USERSIGNATURE_BLOCK) BOOT_USER_SIGNATURE_BLOCK,
             (SEFC_USERSIGNATURE_PAGE) BOOT_USER_SIGNATURE_PAGE);
+
+    while (SEFC0_IsBusy()) {
+        ;
+    }
+}
+
+static uint16_t lAPP_BOOTLOADER_JournalTag(uint32_t imgSize,
+        uint32_t srcAddr,
+        uint32_t dstAddr) {
+    uint32_t tag;
+
+    /* Records of other swap commands are not taken into account */
+    tag = imgSize ^ (srcAddr << 7) ^ (dstAddr << 13);
+    tag ^= tag >> 16;
+
+    return (uint16_t) tag;
+}
+
+static bool lAPP_BOOTLOADER_JournalErased(const uint32_t *record) {
+    uint8_t i;
+
+    for (i = 0; i < BOOT_JOURNAL_RECORD_WORDS; i++) {
+        if (record[i] != 0xFFFFFFFFUL) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void lAPP_BOOTLOADER_JournalRead(void) {
+    uint32_t *record;
+    uint16_t step;
+    uint16_t slot = 0;
+    uint8_t page;
+    uint8_t i;
+
+    journalNext = 0;
+    journalStep = 0;
+
+    for (page = 0; page < BOOT_JOURNAL_PAGES; page++) {
+        (void) SEFC0_UserSignatureRead(journalPage,
+                (uint32_t) (BOOT_FLASH_PAGE_SIZE / sizeof(uint32_t)),
+                (SEFC_USERSIGNATURE_BLOCK) BOOT_USER_SIGNATURE_BLOCK,
+                (SEFC_USERSIGNATURE_PAGE) (BOOT_JOURNAL_FIRST_PAGE + page));
+
+        for (i = 0; i < BOOT_JOURNAL_RECORDS_PER_PAGE; i++) {
+            record = &journalPage[i * BOOT_JOURNAL_RECORD_WORDS];
+            slot++;
+
+            if (lAPP_BOOTLOADER_JournalErased(record) == true) {
+                continue;
+            }
+
+            /* Records are appended after the last programmed one, even if
+             * it was not completely written because of a reset */
+            journalNext = slot;
+
+            /* A record cut by a reset does not have its 4 words right */
+            if ((record[1] != ~record[0]) || (record[2] != record[0]) ||
+                    (record[3] != record[1]) ||
+                    ((uint16_t) (record[0] >> 16) != journalTag)) {
+                continue;
+            }
+
+            step = (uint16_t) record[0];
+            if (step > journalStep) {
+                journalStep = step;
+            }
+        }
+    }
+
+    /* Step kept in the boot configuration when a record was not written */
+    if ((bootConfig[17] != (uint8_t) BOOT_IDLE) &&
+            (bootConfig[17] <= (uint8_t) BOOT_COPIED_BUFF_TO_APP)) {
+        step = ((uint16_t) bootConfig[16] * BOOT_JOURNAL_STEPS_PER_BLOCK) +
+                bootConfig[17];
+        if (step > journalStep) {
+            journalStep = step;
+        }
+    }
+}
+
+static bool lAPP_BOOTLOADER_UserSignatureUnitWrite(uint64_t *data,
+        SEFC_USERSIGNATURE_PAGE page,
+        uint32_t offset) {
+    /* Only the 128-bit ECC unit is programmed, so the rest of the page is
+     * not written again */
+    if (!SEFC0_UserSignatureUnitWrite((uint32_t *) data, offset,
+            (SEFC_USERSIGNATURE_BLOCK) BOOT_USER_SIGNATURE_BLOCK, page)) {
+        return false;
+    }
+
+    while (SEFC0_IsBusy()) {
+        ;
+    }
+
+    if ((SEFC0_ErrorGet() & (SEFC_EEFC_FSR_FCMDE_Msk |
+            SEFC_EEFC_FSR_FLOCKE_Msk | SEFC_EEFC_FSR_FLERR_Msk)) != 0U) {
+        return false;
+    }
+
+    return true;
+}
+
+static void lAPP_BOOTLOADER_JournalWrite(uint16_t step) {
+    uint64_t unit[2];
+    uint32_t record;
+    uint16_t index;
+
+    if (journalNext < BOOT_JOURNAL_RECORDS) {
+        index = journalNext % BOOT_JOURNAL_RECORDS_PER_PAGE;
+
+        /* Record written twice as (value, ~value) */
+        record = ((uint32_t) journalTag << 16) | step;
+        unit[0] = ((uint64_t) ~record << 32) | record;
+        unit[1] = unit[0];
+
+        if (lAPP_BOOTLOADER_UserSignatureUnitWrite(unit,
+                (SEFC_USERSIGNATURE_PAGE) (BOOT_JOURNAL_FIRST_PAGE +
+                (journalNext / BOOT_JOURNAL_RECORDS_PER_PAGE)),
+                (uint32_t) index * BOOT_JOURNAL_RECORD_WORDS *
+                sizeof(uint32_t)) == true) {
+            journalNext++;
+            return;
+        }
+    }
+
+    /* Record not written: keep the step in the boot configuration. The
+     * journal is erased with it and starts again from the first record */
+    lAPP_BOOTLOADER_UpdateUserSignature(
+            (uint8_t) ((step - 1U) / BOOT_JOURNAL_STEPS_PER_BLOCK),
+            (BOOT_STATE) (((step - 1U) % BOOT_JOURNAL_STEPS_PER_BLOCK) + 1U));
+    journalNext = 0;
 }
 
 static bool lAPP_BOOTLOADER_IsSwapCmd(uint32_t imgSize,
@@ -120,11 +260,9 @@ static bool lAPP_BOOTLOADER_IsSwapCmd(uint32_t imgSize,
         return false;
     }
 
-    if ((bootState == BOOT_IDLE) && (pagesCounter > 0)) {
-        return false;
-    }
-
-    if (bootState > BOOT_COPIED_BUFF_TO_APP) {
+    /* Every step of the swap must fit in the journal */
+    if (((imgSize / BOOT_FLASH_16PAGE_SIZE) + 1UL) >
+            (BOOT_JOURNAL_RECORDS / BOOT_JOURNAL_STEPS_PER_BLOCK)) {
         return false;
     }
 
@@ -147,6 +285,19 @@ static uint8_t lAPP_BOOTLOADER_DeletePage(uint32_t addr) {
     return 1;
 }
 
+static uint8_t lAPP_BOOTLOADER_IsErased(uint8_t *page, uint16_t pageSize) {
+    uint32_t *word = (uint32_t *) page;
+    uint16_t i;
+
+    for (i = 0; i < (pageSize >> 2); i++) {
+        if (word[i] != 0xFFFFFFFFUL) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
 static uint8_t lAPP_BOOTLOADER_CopyPage(uint32_t srcAddr, uint32_t dstAddr) {
     uint8_t *page;
     uint8_t i;
@@ -155,12 +306,15 @@ static uint8_t lAPP_BOOTLOADER_CopyPage(uint32_t srcAddr, uint32_t dstAddr) {
     page = &pageBlock[0];
 
     for (i = 0; i < BOOT_FLASH_PAGES_NUMBER; i++) {
-        if (SEFC0_PageWrite((uint32_t *) page, dstAddr) == false) {
-            return 0;
-        }
+        /* Erased pages are not written */
+        if (lAPP_BOOTLOADER_IsErased(page, BOOT_FLASH_PAGE_SIZE) == 0U) {
+            if (SEFC0_PageWrite((uint32_t *) page, dstAddr) == false) {
+                return 0;
+            }
 
-        while (SEFC0_IsBusy()) {
-            ;
+            while (SEFC0_IsBusy()) {
+                ;
+            }
         }
 
         page += BOOT_FLASH_PAGE_SIZE;
@@ -192,29 +346,54 @@ static uint8_t lAPP_BOOTLOADER_SwapFwVersion(uint32_t imgSize,
     uint32_t bufferAddr;
     uint32_t pageOffset = 0;
     uint32_t temp;
-    uint8_t pagesNumber;
-    uint8_t i;
-    uint8_t init;
+    uint16_t pagesNumber;
+    uint16_t i;
+    BOOT_STATE bootState;
 
-    /* Temporary buffer of 8 pages */
+    /* Temporary buffer of 16 pages */
     bufferAddr = BOOT_BUFFER_ADDR;
 
     /* Number of page blocks */
     temp = imgSize / BOOT_FLASH_16PAGE_SIZE;
-    pagesNumber = (uint8_t) temp;
+    pagesNumber = (uint16_t) temp;
     if (imgSize % BOOT_FLASH_16PAGE_SIZE) {
         pagesNumber++;
     }
 
-    /* Start at the last counter position */
-    init = pagesCounter;
-    for (i = init; i < pagesNumber; i++) {
+    /* Start after the last step in the journal */
+    if (journalStep > 0U) {
+        i = (journalStep - 1U) / BOOT_JOURNAL_STEPS_PER_BLOCK;
+        bootState = (BOOT_STATE) (((journalStep - 1U) %
+                BOOT_JOURNAL_STEPS_PER_BLOCK) + 1U);
+    } else {
+        i = 0;
+        bootState = BOOT_IDLE;
+    }
+
+    while (i < pagesNumber) {
         /* Set page offset */
         temp = (uint32_t) i;
         pageOffset = temp * BOOT_FLASH_16PAGE_SIZE;
 
         /* Check state */
-        if ((bootState == BOOT_IDLE) || (bootState == BOOT_COPIED_BUFF_TO_APP)) {
+        if (bootState == BOOT_COPIED_BUFF_TO_APP) {
+            /* Block swapped: go to next block */
+            bootState = BOOT_IDLE;
+            i++;
+            continue;
+        }
+
+        if (bootState == BOOT_IDLE) {
+            /* Blocks with the same content in both images are not swapped.
+             * Blocks already started are never checked again, as their
+             * content is not the original one. */
+            if (memcmp((uint8_t *) (fuBaseAddress + pageOffset),
+                    (uint8_t *) (appBaseAddress + pageOffset),
+                    BOOT_FLASH_16PAGE_SIZE) == 0) {
+                i++;
+                continue;
+            }
+
             /* Delete temporary buffer */
             if (lAPP_BOOTLOADER_DeletePage(bufferAddr) == 0U) {
                 return 0;
@@ -230,15 +409,15 @@ static uint8_t lAPP_BOOTLOADER_SwapFwVersion(uint32_t imgSize,
             /* If not successfully verified, repeat the page writing process */
             if (lAPP_BOOTLOADER_VerifyPage(pageBlock, (uint8_t *) bufferAddr,
                     BOOT_FLASH_16PAGE_SIZE) == 0U) {
-                i--;
                 continue;
             }
 
             /* Set new state */
             bootState = BOOT_COPIED_FU_TO_BUFF;
 
-            /* Update user signature */
-            lAPP_BOOTLOADER_UpdateUserSignature(pagesCounter, bootState);
+            /* Append step to the journal */
+            lAPP_BOOTLOADER_JournalWrite((i * BOOT_JOURNAL_STEPS_PER_BLOCK) +
+                    (uint16_t) bootState);
         }
 
         /* Check state */
@@ -259,15 +438,15 @@ static uint8_t lAPP_BOOTLOADER_SwapFwVersion(uint32_t imgSize,
             if (lAPP_BOOTLOADER_VerifyPage(pageBlock,
                     (uint8_t *) (fuBaseAddress + pageOffset),
                     BOOT_FLASH_16PAGE_SIZE) == 0U) {
-                i--;
                 continue;
             }
 
             /* Set new state */
             bootState = BOOT_COPIED_APP_TO_FU;
 
-            /* Update user signature */
-            lAPP_BOOTLOADER_UpdateUserSignature(pagesCounter, bootState);
+            /* Append step to the journal */
+            lAPP_BOOTLOADER_JournalWrite((i * BOOT_JOURNAL_STEPS_PER_BLOCK) +
+                    (uint16_t) bootState);
         }
 
         /* Check state */
@@ -287,18 +466,15 @@ static uint8_t lAPP_BOOTLOADER_SwapFwVersion(uint32_t imgSize,
             if (lAPP_BOOTLOADER_VerifyPage(pageBlock,
                     (uint8_t *) (appBaseAddress + pageOffset),
                     BOOT_FLASH_16PAGE_SIZE) == 0U) {
-                i--;
                 continue;
             }
 
             /* Set new state */
             bootState = BOOT_COPIED_BUFF_TO_APP;
 
-            /* Increase counter */
-            ++pagesCounter;
-
-            /* Update user signature */
-            lAPP_BOOTLOADER_UpdateUserSignature(pagesCounter, bootState);
+            /* Append step to the journal */
+            lAPP_BOOTLOADER_JournalWrite((i * BOOT_JOURNAL_STEPS_PER_BLOCK) +
+                    (uint16_t) bootState);
         }
     }
 
@@ -406,12 +582,15 @@ void APP_BOOTLOADER_Tasks(void) {
                 destAddr += (uint32_t) (bootConfig[14]) << 16;
                 destAddr += (uint32_t) (bootConfig[13]) << 8;
                 destAddr += (uint32_t) (bootConfig[12]);
-                pagesCounter = bootConfig[16];
-                bootState = bootConfig[17];
 
                 /* Check if swap fw is needed. If not, load defaults. */
                 if (lAPP_BOOTLOADER_IsSwapCmd(imageSize, origAddr,
                         destAddr) == true) {
+                    /* Get swap progress from the journal */
+                    journalTag = lAPP_BOOTLOADER_JournalTag(imageSize,
+                            origAddr, destAddr);
+                    lAPP_BOOTLOADER_JournalRead();
+
                     /* Swap fw */
                     (void) lAPP_BOOTLOADER_SwapFwVersion(imageSize,
                             origAddr,
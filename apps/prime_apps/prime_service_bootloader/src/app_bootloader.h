@@ -76,8 +76,17 @@ extern "C" {
 #define BOOT_USER_SIGNATURE_PAGE                      0    // PAGE_0
 #define BOOT_USER_SIGNATURE_SIZE_8                    BOOT_FLASH_PAGE_SIZE
 #define BOOT_USER_SIGNATURE_SIZE_64                   (BOOT_FLASH_PAGE_SIZE / sizeof(uint64_t))
+
+/* Swap journal (user signature pages following the boot configuration).
+   Each record fills one 128-bit flash ECC unit (4 words) */
+#define BOOT_JOURNAL_FIRST_PAGE                       1    // PAGE_1
+#define BOOT_JOURNAL_PAGES                            7
+#define BOOT_JOURNAL_RECORD_WORDS                     4
+#define BOOT_JOURNAL_RECORDS_PER_PAGE                 (BOOT_FLASH_PAGE_SIZE / (BOOT_JOURNAL_RECORD_WORDS * sizeof(uint32_t)))
+#define BOOT_JOURNAL_RECORDS                          (BOOT_JOURNAL_PAGES * BOOT_JOURNAL_RECORDS_PER_PAGE)
+#define BOOT_JOURNAL_STEPS_PER_BLOCK                  3
     
-/* Bootloader states */
+/* Bootloader states (steps of the swap of each block of pages) */
 typedef enum {
     BOOT_IDLE,
     BOOT_COPIED_FU_TO_BUFF,
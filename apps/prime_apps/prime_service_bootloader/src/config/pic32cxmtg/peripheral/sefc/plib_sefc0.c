@@ -362,6 +362,40 @@ bool SEFC0_UserSignatureWrite(void *data, uint32_t length, SEFC_USERSIGNATURE_BL
     return true;
 }
 
+bool SEFC0_UserSignatureUnitWrite(uint32_t *data, uint32_t offset, SEFC_USERSIGNATURE_BLOCK block, SEFC_USERSIGNATURE_PAGE page)
+{
+    uint64_t *dest = NULL;
+    uint64_t *src = (uint64_t *)data;
+    uint32_t page_number = 0U;
+
+    /* One 128-bit ECC unit, aligned in the page */
+    if (((offset & 0xFU) != 0U) || (offset >= IFLASH0_PAGE_SIZE))
+    {
+        return false;
+    }
+
+    page_number = (((uint32_t)block * 8U) + (uint32_t)page);
+
+    /* Only this unit is loaded in the latch buffer, so the rest of the page is not programmed again */
+    dest = (uint64_t *)(SEFC0_PanelBaseAddr + (page_number * IFLASH0_PAGE_SIZE) + offset);
+
+    /* Writing 8-bit and 16-bit data is not allowed and may lead to unpredictable data corruption */
+    dest[0] = src[0];
+    dest[1] = src[1];
+
+    __DSB();
+    __ISB();
+
+    /* Error flags of previous commands are cleared on read, so SEFC0_ErrorGet only reports this one */
+    (void)SEFC0_REGS->SEFC_EEFC_FSR;
+    sefc_status = 0;
+
+    /* Issue the FLASH write operation*/
+    SEFC0_REGS->SEFC_EEFC_FCR = (SEFC_EEFC_FCR_FCMD_WUS | SEFC_EEFC_FCR_FARG(page_number) | SEFC_EEFC_FCR_FKEY_PASSWD);
+
+    return true;
+}
+
 void SEFC0_UserSignatureErase(SEFC_USERSIGNATURE_BLOCK block)
 {
     SEFC0_REGS->SEFC_EEFC_FCR = (SEFC_EEFC_FCR_FCMD_EUS | SEFC_EEFC_FCR_FARG((uint32_t)((uint32_t)block << 3U)) | SEFC_EEFC_FCR_FKEY_PASSWD);
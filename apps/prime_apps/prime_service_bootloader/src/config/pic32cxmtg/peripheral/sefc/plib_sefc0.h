@@ -102,6 +102,8 @@ bool SEFC0_UserSignatureRead(uint32_t *data, uint32_t length, SEFC_USERSIGNATURE
 
 bool SEFC0_UserSignatureWrite(void *data, uint32_t length, SEFC_USERSIGNATURE_BLOCK block, SEFC_USERSIGNATURE_PAGE page);
 
+bool SEFC0_UserSignatureUnitWrite(uint32_t *data, uint32_t offset, SEFC_USERSIGNATURE_BLOCK block, SEFC_USERSIGNATURE_PAGE page);
+
 void SEFC0_UserSignatureErase(SEFC_USERSIGNATURE_BLOCK block);
 
 void SEFC0_CryptographicKeySend(uint16_t sckArg);